@@ -0,0 +1,90 @@
+# File: XftAotGenerate.cmake
+# Author: Siddharth Mishra (admin@brightprogrammer.in)
+# Copyright: Copyright (c) 2024, All Rights Reserved.
+# Description:
+#
+# This file is a part of CrossFile
+#
+# This file contains CMake build system script to compile precompiled Xft type loaders
+# (.xfb files) ahead of time into C source. The script builds the `xftaot` compiler as a
+# host executable named `XftAotCompiler`, and provides `xft_aot_generate` to add generated
+# sources to any target. Type descriptions (.xf files) can be given with SCHEMA instead of
+# XFB, and are first compiled to xfb using `xftc` (see XftSchemaEmbed.cmake).
+#
+# Usage:
+#
+#   include(XftAotGenerate)
+#   xft_aot_generate(
+#       XFB        ${CMAKE_CURRENT_SOURCE_DIR}/Elf.xfb
+#       PREFIX     elf
+#       OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/Generated/Aot
+#       SOURCES_VAR ELF_AOT_SOURCES
+#   )
+#   add_library(elf_loaders ${ELF_AOT_SOURCES})
+#
+# Generated header is named `<PREFIX>.h` and declares one
+# `int <PREFIX>_load_<type_name> (const uint8_t*, size_t, size_t*, void*, void**)` per type
+# loader, and `void <PREFIX>_free_vectors (void*)` to release elements of loaded vectors.
+# --------------------------------------------------------------------------------------------------
+
+if(TARGET XftAotCompiler)
+    return()
+endif()
+
+set(XFT_AOT_VM_SOURCE_DIR ${CMAKE_SOURCE_DIR}/Source/CrossFile/Xft/Vm)
+
+add_executable(XftAotCompiler
+    ${CMAKE_SOURCE_DIR}/Source/Tools/XftAot.c
+    ${XFT_AOT_VM_SOURCE_DIR}/Aot.c
+    ${XFT_AOT_VM_SOURCE_DIR}/Xfb.c
+    ${XFT_AOT_VM_SOURCE_DIR}/Packed.c
+    ${XFT_AOT_VM_SOURCE_DIR}/Peephole.c
+    ${XFT_AOT_VM_SOURCE_DIR}/Verify.c
+    ${XFT_AOT_VM_SOURCE_DIR}/Insn.c
+    ${XFT_AOT_VM_SOURCE_DIR}/Jit.c
+    ${XFT_AOT_VM_SOURCE_DIR}/Switch.c
+    ${XFT_AOT_VM_SOURCE_DIR}/Check.c
+)
+target_include_directories(XftAotCompiler PRIVATE ${CMAKE_SOURCE_DIR}/Include)
+set_target_properties(XftAotCompiler PROPERTIES OUTPUT_NAME xftaot)
+
+# Compile type loaders in XFB (or in SCHEMA) to <OUTPUT_DIR>/<PREFIX>.c and
+# <OUTPUT_DIR>/<PREFIX>.h, and store both paths in variable named by SOURCES_VAR in
+# caller's scope.
+function(xft_aot_generate)
+    cmake_parse_arguments(XFT_AOT "" "XFB;SCHEMA;PREFIX;OUTPUT_DIR;SOURCES_VAR" "" ${ARGN})
+
+    if(NOT (XFT_AOT_XFB OR XFT_AOT_SCHEMA) OR NOT XFT_AOT_PREFIX OR NOT XFT_AOT_SOURCES_VAR)
+        message(FATAL_ERROR "xft_aot_generate requires XFB or SCHEMA, PREFIX and SOURCES_VAR")
+    endif()
+
+    if(NOT XFT_AOT_OUTPUT_DIR)
+        set(XFT_AOT_OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/Generated/Aot)
+    endif()
+
+    file(MAKE_DIRECTORY ${XFT_AOT_OUTPUT_DIR})
+
+    if(XFT_AOT_SCHEMA)
+        include(XftSchemaEmbed)
+
+        set(XFT_AOT_XFB ${XFT_AOT_OUTPUT_DIR}/${XFT_AOT_PREFIX}.xfb)
+        add_custom_command(
+            OUTPUT ${XFT_AOT_XFB}
+            COMMAND XftSchemaCompiler -o ${XFT_AOT_XFB} ${XFT_AOT_SCHEMA}
+            DEPENDS XftSchemaCompiler ${XFT_AOT_SCHEMA}
+            COMMENT "Compiling ${XFT_AOT_SCHEMA} to xfb..."
+        )
+    endif()
+
+    set(XFT_AOT_SOURCE ${XFT_AOT_OUTPUT_DIR}/${XFT_AOT_PREFIX}.c)
+    set(XFT_AOT_HEADER ${XFT_AOT_OUTPUT_DIR}/${XFT_AOT_PREFIX}.h)
+
+    add_custom_command(
+        OUTPUT ${XFT_AOT_SOURCE} ${XFT_AOT_HEADER}
+        COMMAND XftAotCompiler ${XFT_AOT_XFB} ${XFT_AOT_PREFIX} ${XFT_AOT_SOURCE} ${XFT_AOT_HEADER}
+        DEPENDS XftAotCompiler ${XFT_AOT_XFB}
+        COMMENT "Compiling type loaders in ${XFT_AOT_XFB} ahead of time..."
+    )
+
+    set(${XFT_AOT_SOURCES_VAR} ${XFT_AOT_SOURCE} ${XFT_AOT_HEADER} PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,92 @@
+# File: XftSchemaEmbed.cmake
+# Author: Siddharth Mishra (admin@brightprogrammer.in)
+# Copyright: Copyright (c) 2024, All Rights Reserved.
+# Description:
+#
+# This file is a part of CrossFile
+#
+# This file contains CMake build system script to compile xfile type descriptions (.xf files)
+# bundled with CrossFile to xfb images at build time, and embed them in C source. The script
+# builds the `xftc` compiler as a host executable named `XftSchemaCompiler`, and provides
+# `xft_schema_embed` to generate the source.
+#
+# Usage:
+#
+#   include(XftSchemaEmbed)
+#   xft_schema_embed(
+#       SCHEMAS     Elf ${CMAKE_SOURCE_DIR}/Data/Elf/Elf.xf
+#       OUTPUT      ${CMAKE_CURRENT_BINARY_DIR}/Generated/Schemas/Schemas.c
+#       SOURCES_VAR SCHEMA_SOURCES
+#   )
+#   add_library(xf_xft ... ${SCHEMA_SOURCES})
+#
+# Generated source defines `schema_blobs` and `schema_blob_count` declared in
+# `Source/CrossFile/Xft/Parser/Registry.h`, and must be compiled with `Source` in include path.
+# --------------------------------------------------------------------------------------------------
+
+if(TARGET XftSchemaCompiler)
+    return()
+endif()
+
+find_package(Threads REQUIRED)
+
+set(XFT_SCHEMA_SOURCE_DIR ${CMAKE_SOURCE_DIR}/Source/CrossFile)
+
+# compiler is built from same sources as library, except registry that needs it's output
+file(GLOB_RECURSE XFT_SCHEMA_COMPILER_SRCS
+    ${XFT_SCHEMA_SOURCE_DIR}/Xft/*.c
+    ${XFT_SCHEMA_SOURCE_DIR}/Stream/*.c
+)
+list(FILTER XFT_SCHEMA_COMPILER_SRCS EXCLUDE REGEX ".*/Registry\\.c$")
+
+add_executable(XftSchemaCompiler
+    ${CMAKE_SOURCE_DIR}/Source/Tools/Xftc.c
+    ${XFT_SCHEMA_COMPILER_SRCS}
+)
+target_include_directories(XftSchemaCompiler PRIVATE
+    ${CMAKE_SOURCE_DIR}/Include
+    ${TREE_SITTER_XFILE_INCLUDE_DIR}
+)
+target_link_directories(XftSchemaCompiler PRIVATE ${TREE_SITTER_XFILE_LIBRARY_DIR})
+target_link_libraries(XftSchemaCompiler ${TREE_SITTER_XFILE_LIBRARIES} Threads::Threads m)
+add_dependencies(XftSchemaCompiler ${TREE_SITTER_XFILE_DEPENDENCIES})
+set_target_properties(XftSchemaCompiler PROPERTIES OUTPUT_NAME xftc)
+
+# Compile type descriptions given as pairs of name and path in SCHEMAS to OUTPUT,
+# and store path of OUTPUT in variable named by SOURCES_VAR in caller's scope.
+function(xft_schema_embed)
+    cmake_parse_arguments(XFT_SCHEMA "" "OUTPUT;SOURCES_VAR" "SCHEMAS" ${ARGN})
+
+    if(NOT XFT_SCHEMA_OUTPUT OR NOT XFT_SCHEMA_SOURCES_VAR)
+        message(FATAL_ERROR "xft_schema_embed requires OUTPUT and SOURCES_VAR")
+    endif()
+
+    list(LENGTH XFT_SCHEMA_SCHEMAS XFT_SCHEMA_ARG_COUNT)
+    math(EXPR XFT_SCHEMA_ODD "${XFT_SCHEMA_ARG_COUNT} % 2")
+    if(XFT_SCHEMA_ODD)
+        message(FATAL_ERROR "xft_schema_embed requires SCHEMAS as pairs of name and path")
+    endif()
+
+    set(XFT_SCHEMA_FILES "")
+    set(XFT_SCHEMA_IS_PATH OFF)
+    foreach(XFT_SCHEMA_ARG ${XFT_SCHEMA_SCHEMAS})
+        if(XFT_SCHEMA_IS_PATH)
+            list(APPEND XFT_SCHEMA_FILES ${XFT_SCHEMA_ARG})
+            set(XFT_SCHEMA_IS_PATH OFF)
+        else()
+            set(XFT_SCHEMA_IS_PATH ON)
+        endif()
+    endforeach()
+
+    get_filename_component(XFT_SCHEMA_OUTPUT_DIR ${XFT_SCHEMA_OUTPUT} DIRECTORY)
+    file(MAKE_DIRECTORY ${XFT_SCHEMA_OUTPUT_DIR})
+
+    add_custom_command(
+        OUTPUT ${XFT_SCHEMA_OUTPUT}
+        COMMAND XftSchemaCompiler ${XFT_SCHEMA_OUTPUT} ${XFT_SCHEMA_SCHEMAS}
+        DEPENDS XftSchemaCompiler ${XFT_SCHEMA_FILES}
+        COMMENT "Compiling bundled type descriptions to xfb images..."
+    )
+
+    set(${XFT_SCHEMA_SOURCES_VAR} ${XFT_SCHEMA_OUTPUT} PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,94 @@
+/**
+ * @file AddrIndex.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_ELF_ADDR_INDEX_H
+#define ANVIE_CROSSFILE_ELF_ADDR_INDEX_H
+
+#include <Anvie/Types.h>
+
+/* fwd-declarations */
+typedef struct ElfFile        ElfFile;
+typedef struct ElfSymbolTable ElfSymbolTable;
+
+/**
+ * @b Symbol an address resolved to.
+ * */
+typedef struct ElfAddrMatch {
+    Uint32 symbol; /**< @b Index of symbol in index's table, 0 if no symbol contains address. */
+    Uint64 offset; /**< @b Offset of address from value of symbol. */
+} ElfAddrMatch;
+
+/**
+ * @b Part of address space covered by a single symbol.
+ * */
+typedef struct ElfAddrRange {
+    Uint64 value;  /**< @b Value of symbol, offsets are computed from it. */
+    Uint64 end;    /**< @b One past last address in range. */
+    Uint32 symbol; /**< @b Index of symbol in index's table. */
+} ElfAddrRange;
+
+/**
+ * @b Address to symbol index of an ELF file.
+ *
+ * Symbols are flattened into sorted, non overlapping ranges, so an address inside
+ * nested symbols resolves to the innermost one. Symbols of zero size cover addresses
+ * up to the next symbol. When several symbols cover exactly the same range, a global
+ * default version of symbol is preferred. Symbol values are taken as addresses, which
+ * is what they are in executables and shared objects, but not in relocatable files.
+ *
+ * Single lookups walk @c tree, which keeps range starts in Eytzinger (breadth first)
+ * order, so first levels of every search share same few cache lines and next levels
+ * can be prefetched. Batch lookups sort addresses and walk @c starts alongside.
+ * */
+typedef struct ElfAddrIndex {
+    ElfSymbolTable* table; /**< @b Symbol table ranges refer to, .symtab if file has one. */
+
+    Size          count;  /**< @b Number of ranges. */
+    Uint64*       starts; /**< @b Start of each range, in increasing order. */
+    ElfAddrRange* ranges; /**< @b Ranges, in same order as @c starts. */
+
+    Uint64* tree;  /**< @b Range starts in Eytzinger order, 1 based. */
+    Uint32* ranks; /**< @b Position in @c starts of each entry in @c tree. */
+} ElfAddrIndex;
+
+ElfAddrIndex* elf_addr_index_init (ElfAddrIndex* index, ElfFile* elf);
+ElfAddrIndex* elf_addr_index_deinit (ElfAddrIndex* index);
+Bool          elf_addr_index_lookup (ElfAddrIndex* index, Uint64 addr, ElfAddrMatch* match);
+Bool          elf_addr_index_lookup_batch (
+    ElfAddrIndex* index,
+    const Uint64* addrs,
+    Size          count,
+    ElfAddrMatch* matches
+);
+
+#endif // ANVIE_CROSSFILE_ELF_ADDR_INDEX_H
@@ -0,0 +1,157 @@
+/**
+ * @file Elf.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_ELF_ELF_H
+#define ANVIE_CROSSFILE_ELF_ELF_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Stream.h>
+
+/* set in version index of a symbol when it's not default version of symbol */
+#define ELF_VERSYM_HIDDEN 0x8000
+
+/**
+ * @b Decoded section header, along with a view of section contents.
+ * */
+typedef struct ElfSection {
+    Size         index;   /**< @b Index of section in section header table. */
+    CString      name;    /**< @b Name of section, empty if it has none. */
+    Uint32       type;    /**< @b One of SHT_* values. */
+    Uint64       flags;   /**< @b Combination of SHF_* flags. */
+    Uint64       addr;    /**< @b Virtual address of section in memory image. */
+    Uint64       offset;  /**< @b Offset of section contents in file. */
+    Uint64       size;    /**< @b Size of section contents. */
+    Uint32       link;    /**< @b Index of a related section. */
+    Uint32       info;    /**< @b Extra information, depends on section type. */
+    Uint64       entsize; /**< @b Size of an entry, if section holds a table. */
+    const Uint8* data;    /**< @b Contents in mapped file, @c Null if section has none in file. */
+} ElfSection;
+
+/**
+ * @b Decoded symbol table entry.
+ * */
+typedef struct ElfSymbol {
+    Size    index;   /**< @b Index of symbol in it's table. */
+    CString name;    /**< @b Name of symbol, empty if it has none. */
+    Uint64  value;   /**< @b Value, usually address of symbol. */
+    Uint64  size;    /**< @b Size of object the symbol refers to. */
+    Uint8   type;    /**< @b One of STT_* values. */
+    Uint8   bind;    /**< @b One of STB_* values. */
+    Uint8   other;   /**< @b Symbol visibility. */
+    Uint16  shndx;   /**< @b Index of section symbol is defined in. */
+    Uint16  version; /**< @b Version index, with @c ELF_VERSYM_HIDDEN set if not default. */
+} ElfSymbol;
+
+/**
+ * @b Slot in a by-name index, @c index is one more than index of entry so empty
+ * slots are zero.
+ * */
+typedef struct ElfSlot {
+    Uint32 hash;
+    Uint32 index;
+} ElfSlot;
+
+/**
+ * @b View of a symbol table in mapped file, with an index over names of it's
+ * defined symbols.
+ *
+ * When dynamic symbol table comes with a GNU hash table, that table is used for
+ * lookups directly, and no index is built for it. Like the dynamic loader, lookups
+ * prefer default version of a symbol over it's other versions.
+ * */
+typedef struct ElfSymbolTable {
+    Size         section;      /**< @b Index of table's section, 0 if file has no such table. */
+    const Uint8* symbols;      /**< @b Symbol entries in mapped file. */
+    Size         count;        /**< @b Number of symbol entries. */
+    Size         entsize;      /**< @b Size of one symbol entry. */
+    const Char*  strings;      /**< @b String table holding symbol names. */
+    Size         strings_size; /**< @b Size of string table. */
+    const Uint8* versions;     /**< @b Version index of each symbol, @c Null if unversioned. */
+
+    ElfSlot* slots;      /**< @b Open addressing index of symbols by name. */
+    Size     slot_count; /**< @b Number of slots, always a power of two. */
+
+    /* GNU hash table, all in file byte order */
+    const Uint8* gnu_bloom;        /**< @b Bloom filter words. */
+    const Uint8* gnu_buckets;      /**< @b First symbol index in each bucket. */
+    const Uint8* gnu_chains;       /**< @b Hash values of symbols starting at @c gnu_symoffset. */
+    Uint32       gnu_bucket_count; /**< @b Number of buckets. */
+    Uint32       gnu_symoffset;    /**< @b Index of first symbol covered by hash table. */
+    Uint32       gnu_bloom_size;   /**< @b Number of bloom filter words. */
+    Uint32       gnu_bloom_shift;  /**< @b Shift for second bloom filter bit. */
+} ElfSymbolTable;
+
+/**
+ * @b ELF file opened over a mapped stream.
+ *
+ * Header tables and symbols are never copied. Sections and symbols are decoded
+ * from mapped file when requested, and only the by-name indexes are allocated.
+ * Both 32 and 64 bit files in either byte order are supported.
+ * */
+typedef struct ElfFile {
+    TO_IoStream* stream; /**< @b Mapped stream over whole file. */
+    const Uint8* data;   /**< @b Contents of file. */
+    Size         size;   /**< @b Size of file. */
+
+    Bool   is_64;   /**< @b File is of ELFCLASS64. */
+    Bool   swap;    /**< @b Byte order of file differs from host. */
+    Uint16 type;    /**< @b One of ET_* values. */
+    Uint16 machine; /**< @b One of EM_* values. */
+    Uint64 entry;   /**< @b Entry point address. */
+
+    const Uint8* sections;           /**< @b Section header table in mapped file. */
+    Size         section_count;      /**< @b Number of section headers. */
+    Size         section_entsize;    /**< @b Size of one section header. */
+    const Char*  section_names;      /**< @b Section header string table. */
+    Size         section_names_size; /**< @b Size of section header string table. */
+
+    ElfSlot* section_slots;      /**< @b Open addressing index of sections by name. */
+    Size     section_slot_count; /**< @b Number of slots, always a power of two. */
+
+    ElfSymbolTable symtab; /**< @b Static symbol table (.symtab). */
+    ElfSymbolTable dynsym; /**< @b Dynamic symbol table (.dynsym). */
+} ElfFile;
+
+ElfFile* elf_file_open (ElfFile* elf, CString filename);
+ElfFile* elf_file_close (ElfFile* elf);
+Bool     elf_file_get_section (ElfFile* elf, Size index, ElfSection* section);
+Bool     elf_file_find_section (ElfFile* elf, CString name, ElfSection* section);
+Bool     elf_file_find_symbol (ElfFile* elf, CString name, ElfSymbol* symbol);
+
+Bool elf_symbol_table_get (ElfFile* elf, ElfSymbolTable* table, Size index, ElfSymbol* symbol);
+Bool elf_symbol_table_find (ElfFile* elf, ElfSymbolTable* table, CString name, ElfSymbol* symbol);
+
+#endif // ANVIE_CROSSFILE_ELF_ELF_H
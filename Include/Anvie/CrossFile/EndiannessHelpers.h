@@ -0,0 +1,95 @@
+/**
+ * @file EndiannessHelpers.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_ENDIANNESS_HELPERS_H
+#define ANVIE_CROSSFILE_ENDIANNESS_HELPERS_H
+
+#include <Anvie/Types.h>
+
+/**
+ * Helpers to read big endian values out of raw memory buffers.
+ *
+ * Font files store all values in big endian (network) byte order. These read
+ * one byte at a time, so they work on any host and on unaligned buffers.
+ * */
+
+static inline Uint8 xf_read_be_u8 (const Uint8* data) {
+    return data[0];
+}
+
+static inline Uint16 xf_read_be_u16 (const Uint8* data) {
+    return (Uint16)(((Uint16)data[0] << 8) | (Uint16)data[1]);
+}
+
+static inline Uint32 xf_read_be_u32 (const Uint8* data) {
+    return ((Uint32)data[0] << 24) | ((Uint32)data[1] << 16) | ((Uint32)data[2] << 8) |
+           (Uint32)data[3];
+}
+
+static inline Uint64 xf_read_be_u64 (const Uint8* data) {
+    return ((Uint64)xf_read_be_u32 (data) << 32) | (Uint64)xf_read_be_u32 (data + 4);
+}
+
+/**
+ * @b Read value of given width from @c data and advance @c data past it.
+ *
+ * @c data must be a (non-const) byte pointer lvalue.
+ * */
+#define GET_AND_ADV_U1(data) ((data) += 1, xf_read_be_u8 ((data) - 1))
+#define GET_AND_ADV_U2(data) ((data) += 2, xf_read_be_u16 ((data) - 2))
+#define GET_AND_ADV_U4(data) ((data) += 4, xf_read_be_u32 ((data) - 4))
+#define GET_AND_ADV_U8(data) ((data) += 8, xf_read_be_u64 ((data) - 8))
+
+#define GET_AND_ADV_I1(data) ((Int8)GET_AND_ADV_U1 (data))
+#define GET_AND_ADV_I2(data) ((Int16)GET_AND_ADV_U2 (data))
+#define GET_AND_ADV_I4(data) ((Int32)GET_AND_ADV_U4 (data))
+#define GET_AND_ADV_I8(data) ((Int64)GET_AND_ADV_U8 (data))
+
+/**
+ * @b Fill @c arr[begin, end) with consecutive values read from a local named @c data,
+ * advancing @c data past them.
+ * */
+#define GET_ARR_AND_ADV(arr, begin, end, getter)                                                   \
+    do {                                                                                           \
+        for (Size arr_idx__ = (begin); arr_idx__ < (Size)(end); arr_idx__++) {                     \
+            (arr)[arr_idx__] = getter (data);                                                      \
+        }                                                                                          \
+    } while (0)
+
+#define GET_ARR_AND_ADV_U1(arr, begin, end) GET_ARR_AND_ADV (arr, begin, end, GET_AND_ADV_U1)
+#define GET_ARR_AND_ADV_U2(arr, begin, end) GET_ARR_AND_ADV (arr, begin, end, GET_AND_ADV_U2)
+#define GET_ARR_AND_ADV_U4(arr, begin, end) GET_ARR_AND_ADV (arr, begin, end, GET_AND_ADV_U4)
+#define GET_ARR_AND_ADV_I2(arr, begin, end) GET_ARR_AND_ADV (arr, begin, end, GET_AND_ADV_I2)
+#define GET_ARR_AND_ADV_I4(arr, begin, end) GET_ARR_AND_ADV (arr, begin, end, GET_AND_ADV_I4)
+
+#endif // ANVIE_CROSSFILE_ENDIANNESS_HELPERS_H
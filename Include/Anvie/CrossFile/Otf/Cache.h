@@ -0,0 +1,77 @@
+/**
+ * @file Cache.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_OTF_CACHE_H
+#define ANVIE_CROSSFILE_OTF_CACHE_H
+
+#include <Anvie/Types.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Otf/Shared.h>
+
+#define OTF_FONT_CACHE_DEFAULT_BUDGET (64 * 1024 * 1024)
+
+/**
+ * @b Cache of decoded fonts, keyed by identity of font file on disk
+ * (device, inode, modification time).
+ *
+ * Opening a font already present in cache returns a new reference to the
+ * same @c OtfSharedFile. Concurrent opens of a font not yet in cache are
+ * coalesced : only one thread decodes it while others wait for the result.
+ *
+ * Least recently used fonts are evicted when sum of their estimated decoded
+ * sizes exceeds byte budget. Eviction only drops cache's own reference, so
+ * fonts still in use by someone stay alive till they're released.
+ * */
+typedef struct OtfFontCache OtfFontCache;
+
+typedef struct OtfFontCacheStats {
+    Size hits;          /**< @b Opens served from cache. */
+    Size misses;        /**< @b Opens that had to decode font. */
+    Size coalesced;     /**< @b Opens that waited for another thread decoding same font. */
+    Size evictions;     /**< @b Fonts evicted to stay under budget. */
+    Size entry_count;   /**< @b Number of fonts currently in cache. */
+    Size decoded_bytes; /**< @b Estimated decoded size of all fonts currently in cache. */
+    Size byte_budget;
+} OtfFontCacheStats;
+
+OtfFontCache      *otf_font_cache_create (Size byte_budget);
+void               otf_font_cache_destroy (OtfFontCache *cache);
+OtfSharedFile     *otf_font_cache_open (OtfFontCache *cache, CString filename);
+OtfFontCache      *otf_font_cache_set_budget (OtfFontCache *cache, Size byte_budget);
+OtfFontCacheStats *otf_font_cache_get_stats (OtfFontCache *cache, OtfFontCacheStats *stats);
+
+OtfFontCache  *otf_font_cache_get_global();
+OtfSharedFile *otf_file_open_cached (CString filename);
+
+#endif // ANVIE_CROSSFILE_OTF_CACHE_H
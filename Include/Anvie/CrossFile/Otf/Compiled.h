@@ -0,0 +1,169 @@
+/**
+ * @file Compiled.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_OTF_COMPILED_H
+#define ANVIE_CROSSFILE_OTF_COMPILED_H
+
+#include <Anvie/Types.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Otf/Tables.h>
+
+/* fwd-declarations */
+typedef struct OtfFile OtfFile;
+
+/**
+ * A compiled font is a flat, position independent dump of the parts of a decoded
+ * @c OtfFile that are needed at runtime. Every section is addressed by an offset
+ * relative to beginning of file, so the file can be mmapped and used in place.
+ *
+ * Data is stored in host byte order. A compiled font written on a host with
+ * different byte order is rejected by loader, just like a stale one.
+ *
+ * Layout :
+ *   OtfCompiledHeader
+ *   OtfTableRecord        [header.table_records.count]
+ *   OtfCompiledCmapGroup  [header.cmap_groups.count]   (sorted by start_char_code)
+ *   OtfCompiledMetric     [header.h_metrics.count]     (one per glyph)
+ *   OtfCompiledNameRecord [header.name_records.count]
+ *   Char                  [header.name_strings.count]  (raw name table storage)
+ *
+ * Each section begins at an offset aligned to @c OTF_COMPILED_SECTION_ALIGNMENT.
+ * */
+
+#define OTF_COMPILED_MAGIC             0x434f4658 /* XFOC */
+#define OTF_COMPILED_VERSION           1
+#define OTF_COMPILED_BYTE_ORDER_MARK   0x01020304
+#define OTF_COMPILED_SECTION_ALIGNMENT 8
+
+typedef struct OtfCompiledSection {
+    Uint64 offset; /**< @b Offset from beginning of compiled file. */
+    Uint64 count;  /**< @b Number of elements (not bytes) in this section. */
+} OtfCompiledSection;
+
+/**
+ * @b Compiled cmap is a sorted array of ranges mapping consecutive char codes
+ * to consecutive glyph ids, built from best unicode subtable in font.
+ * */
+typedef struct OtfCompiledCmapGroup {
+    Uint32 start_char_code;
+    Uint32 end_char_code;
+    Uint32 start_glyph_id;
+} OtfCompiledCmapGroup;
+
+/**
+ * @b Horizontal metrics expanded for each glyph, so no special handling
+ * is required for glyphs beyond number of long horizontal metrics.
+ * */
+typedef struct OtfCompiledMetric {
+    Uint16 advance_width;
+    Int16  left_side_bearing;
+} OtfCompiledMetric;
+
+typedef struct OtfCompiledNameRecord {
+    Uint16 platform_id;
+    Uint16 encoding_id;
+    Uint16 language_id;
+    Uint16 name_id;
+    Uint32 string_offset; /**< @b Offset into name strings section. */
+    Uint32 length;        /**< @b Length of string in bytes. */
+} OtfCompiledNameRecord;
+
+typedef struct OtfCompiledHeader {
+    Uint32 magic;
+    Uint16 version;
+    Uint16 header_size;
+    Uint32 byte_order_mark;
+
+    /* source font validation data */
+    Uint32 source_checksum; /**< @b Checksum of table directory in source font file. */
+    Uint64 source_size;
+    Int64  source_mtime_sec;
+    Int64  source_mtime_nsec;
+
+    Uint64 file_size; /**< @b Total size of compiled file. */
+
+    Uint32 sfnt_version;
+    Uint16 num_glyphs;
+    Uint16 units_per_em;
+
+    OtfCompiledSection table_records;
+    OtfCompiledSection cmap_groups;
+    OtfCompiledSection h_metrics;
+    OtfCompiledSection name_records;
+    OtfCompiledSection name_strings;
+} OtfCompiledHeader;
+
+/**
+ * @b Handle to a mmapped compiled font. All pointers point directly into
+ * the mapped file, nothing is copied or relocated.
+ * */
+typedef struct OtfCompiled {
+    Uint8 *data;
+    Size   size;
+
+    const OtfCompiledHeader     *header;
+    const OtfTableRecord        *table_records;
+    const OtfCompiledCmapGroup  *cmap_groups;
+    const OtfCompiledMetric     *h_metrics;
+    const OtfCompiledNameRecord *name_records;
+    const Char                  *name_strings;
+} OtfCompiled;
+
+OtfCompiledCmapGroup *otf_compiled_cmap_groups_create (OtfCmap *cmap, Size *count);
+Uint32                otf_compiled_cmap_groups_find (
+    const OtfCompiledCmapGroup *groups,
+    Size                        count,
+    Uint32                      char_code
+);
+
+OtfFile *otf_compiled_write (OtfFile *otf_file, CString font_path, CString compiled_path);
+
+OtfCompiled *otf_compiled_open (OtfCompiled *compiled, CString compiled_path, CString font_path);
+OtfCompiled *otf_compiled_close (OtfCompiled *compiled);
+
+const OtfTableRecord *
+             otf_compiled_find_table_record (OtfCompiled *compiled, OtfTableTag table_tag);
+Uint32       otf_compiled_get_glyph_id (OtfCompiled *compiled, Uint32 char_code);
+Uint16       otf_compiled_get_advance_width (OtfCompiled *compiled, Uint32 glyph_id);
+Int16        otf_compiled_get_left_side_bearing (OtfCompiled *compiled, Uint32 glyph_id);
+const Char  *otf_compiled_get_name (
+    OtfCompiled *compiled,
+    OtfNameId    name_id,
+    Uint16       platform_id,
+    Uint16       encoding_id,
+    Uint16       language_id,
+    Size        *length
+);
+
+#endif // ANVIE_CROSSFILE_OTF_COMPILED_H
@@ -0,0 +1,88 @@
+/**
+ * @file Edit.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_OTF_EDIT_H
+#define ANVIE_CROSSFILE_OTF_EDIT_H
+
+#include <Anvie/Types.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Otf/Otf.h>
+
+/**
+ * @b Working copy of a single table in an edit session.
+ * */
+typedef struct OtfEditTable {
+    Uint8* data;   /**< @b Current table data, either owned or pointing into session data. */
+    Uint32 length; /**< @b Current length of table data. */
+    Bool   is_owned;
+    Bool   decode_pending; /**< @b Decoded table in @c OtfFile is out of date. */
+    Bool   save_pending;   /**< @b Table on disk is out of date. */
+} OtfEditTable;
+
+/**
+ * @b Edit session over an already opened font file.
+ *
+ * Tables are modified either in place through pointer returned by
+ * @c otf_edit_session_get_table followed by @c otf_edit_session_mark_dirty,
+ * or by replacing them entirely with @c otf_edit_session_replace_table.
+ *
+ * Committing re-decodes only dirty tables (and tables decoded from them) into
+ * the @c OtfFile. Saving writes only dirty tables and their table records back
+ * to font file, in place when new table fits in old one's slot, otherwise by
+ * appending it at end of file and relocating its table record.
+ * */
+typedef struct OtfEditSession {
+    OtfFile*      otf_file;
+    Char*         filename;
+    Uint8*        data;      /**< @b Private copy of font file as it was when session began. */
+    Size          size;      /**< @b Size of @c data. */
+    Size          file_size; /**< @b Current size of font file on disk. */
+    OtfEditTable* tables;    /**< @b One for each record in table directory, in same order. */
+} OtfEditSession;
+
+OtfEditSession*
+    otf_edit_session_init (OtfEditSession* session, OtfFile* otf_file, CString filename);
+OtfEditSession* otf_edit_session_deinit (OtfEditSession* session);
+Uint8*          otf_edit_session_get_table (OtfEditSession* session, OtfTableTag tag, Size* size);
+OtfEditSession* otf_edit_session_mark_dirty (OtfEditSession* session, OtfTableTag tag);
+OtfEditSession* otf_edit_session_replace_table (
+    OtfEditSession* session,
+    OtfTableTag     tag,
+    const Uint8*    data,
+    Size            size
+);
+OtfEditSession* otf_edit_session_commit (OtfEditSession* session);
+OtfEditSession* otf_edit_session_save (OtfEditSession* session);
+
+#endif // ANVIE_CROSSFILE_OTF_EDIT_H
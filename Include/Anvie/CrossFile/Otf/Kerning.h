@@ -0,0 +1,113 @@
+/**
+ * @file Kerning.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_OTF_KERNING_H
+#define ANVIE_CROSSFILE_OTF_KERNING_H
+
+#include <Anvie/Types.h>
+
+/* fwd-declarations */
+typedef struct OtfKern OtfKern;
+typedef struct OtfGpos OtfGpos;
+
+#define OTF_KERNING_PAIR_EMPTY_KEY   ((Uint32)-1)
+#define OTF_KERNING_CLASS_TABLE_NONE ((Uint16)-1)
+
+/**
+ * @b Entry in open addressing hash table of glyph pairs.
+ * Key is @c (left << 16) | right.
+ * */
+typedef struct OtfKerningPair {
+    Uint32 key;
+    Int16  value;
+    Uint16 lookup; /**< @b Last GPOS lookup that contributed to value, used while compiling. */
+} OtfKerningPair;
+
+/**
+ * @b Class pair subtable compiled into a dense matrix.
+ * Class of left glyph is stored per glyph in @c OtfKerning.
+ * */
+typedef struct OtfKerningClassTable {
+    Uint16  order; /**< @b Position of source subtable in application order. */
+    Uint16  class1_count;
+    Uint16  class2_count;
+    Uint16  first_class2_glyph;
+    Uint16  num_class2_glyphs;
+    Uint16 *class2; /**< @b Class of right glyph, indexed by (glyph - first_class2_glyph). */
+    Int16  *matrix; /**< @b class1_count x class2_count kerning values. */
+} OtfKerningClassTable;
+
+/**
+ * @b Kerning data from GPOS or kern table compiled for fast lookups.
+ *
+ * Like a shaping engine, each GPOS lookup applies the first of it's subtables that
+ * matches a pair, and adjustments from all lookups add up.
+ *
+ * Glyph pair entries go in a hash table. For class based subtables, the first
+ * class subtable covering a left glyph owns that glyph within it's lookup, because
+ * a class subtable always applies when its coverage matches. Pair values are
+ * compiled relative to class values : a glyph pair that takes precedence over an
+ * owning class subtable stores the difference between the two. Getting kerning of
+ * a pair is therefore one hash probe plus one matrix access per lookup that has
+ * class subtables.
+ *
+ * Only XAdvance of first glyph (value1) is used. Placement fields and the second
+ * glyph's value record (value2) do not change distance between the two glyphs
+ * in horizontal text and are ignored.
+ * */
+typedef struct OtfKerning {
+    Uint16 num_glyphs;
+
+    Size            pair_count;
+    Size            pair_capacity; /**< @b Always a power of two. */
+    Uint8           hash_shift;
+    OtfKerningPair *pairs;
+
+    Uint16               num_class_tables;
+    OtfKerningClassTable *class_tables;
+
+    /**
+     * @b Number of GPOS lookups with class subtables. Each one gets a row of
+     * @c num_glyphs entries in @c left_class_table and @c left_class.
+     * */
+    Uint16  num_class_lookups;
+    Uint16 *left_class_table; /**< @b Owning class table of each glyph, per lookup. */
+    Uint16 *left_class;       /**< @b Class of each glyph in owning class table, per lookup. */
+} OtfKerning;
+
+OtfKerning *otf_kerning_init (OtfKerning *kerning, OtfGpos *gpos, OtfKern *kern, Uint16 num_glyphs);
+OtfKerning *otf_kerning_deinit (OtfKerning *kerning);
+Int16       otf_kerning_get (OtfKerning *kerning, Uint16 left, Uint16 right);
+OtfKerning *otf_kerning_pprint (OtfKerning *kerning, Uint8 indent_level);
+
+#endif // ANVIE_CROSSFILE_OTF_KERNING_H
@@ -37,9 +37,16 @@
 #include <Anvie/Types.h>
 
 /* crossfile */
+#include <Anvie/CrossFile/Otf/Kerning.h>
 #include <Anvie/CrossFile/Otf/Tables.h>
+#include <Anvie/CrossFile/Stream.h>
 
 typedef struct OtfFile {
+    TO_IoStream* stream;    /**< @b Mapped stream over whole font file. */
+    Uint8*       data;      /**< @b Contents of font file, tables point into this. */
+    Size         size;      /**< @b Size of font file in bytes. */
+    Char*        file_name; /**< @b Path font file was opened from. */
+
     OtfTableDir table_directory;
 
     /* data from table records */
@@ -50,10 +57,19 @@ typedef struct OtfFile {
     OtfName name;
     OtfMaxp maxp;
     OtfLoca loca;
+
+    /* optional tables, zero initialized when not present in font file */
+    OtfKern kern;
+    OtfGpos gpos;
+
+    /* kerning pairs compiled from gpos or kern table */
+    OtfKerning kerning;
 } OtfFile;
 
 OtfFile* otf_file_open (OtfFile* otf_file, CString filename);
 OtfFile* otf_file_close (OtfFile* otf_file);
 OtfFile* otf_file_pprint (OtfFile* otf_file, Uint8 identation_level);
+Int16    otf_file_get_kerning (OtfFile* otf_file, Uint16 left_glyph, Uint16 right_glyph);
+Size     otf_file_get_decoded_size (OtfFile* otf_file);
 
 #endif // ANVIE_CROSSFILE_OTF_OTF_H
@@ -0,0 +1,77 @@
+/**
+ * @file Shared.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_OTF_SHARED_H
+#define ANVIE_CROSSFILE_OTF_SHARED_H
+
+#include <Anvie/Types.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Otf/Tables/Name.h>
+
+/* fwd-declarations */
+typedef struct OtfFile OtfFile;
+
+/**
+ * @b Atomically reference counted, immutable handle to a decoded font.
+ *
+ * Once opened, decoded font data is never modified, so any number of threads
+ * can hold a reference and call lookup methods concurrently without locking.
+ * Lazily built caches (like compiled cmap) are published with a single atomic
+ * compare-and-swap : if two threads race to build one, the loser frees it's copy
+ * and uses the published one.
+ *
+ * The handle is destroyed when last reference is dropped.
+ * */
+typedef struct OtfSharedFile OtfSharedFile;
+
+OtfSharedFile *otf_shared_file_open (CString filename);
+OtfSharedFile *otf_shared_file_ref (OtfSharedFile *shared);
+void           otf_shared_file_unref (OtfSharedFile *shared);
+const OtfFile *otf_shared_file_get_file (OtfSharedFile *shared);
+Size           otf_shared_file_get_ref_count (OtfSharedFile *shared);
+
+Uint32      otf_shared_file_get_glyph_id (OtfSharedFile *shared, Uint32 char_code);
+Uint16      otf_shared_file_get_advance_width (OtfSharedFile *shared, Uint32 glyph_id);
+Int16       otf_shared_file_get_left_side_bearing (OtfSharedFile *shared, Uint32 glyph_id);
+Int16       otf_shared_file_get_kerning (OtfSharedFile *shared, Uint16 left, Uint16 right);
+const Char *otf_shared_file_get_name (
+    OtfSharedFile *shared,
+    OtfNameId      name_id,
+    Uint16         platform_id,
+    Uint16         encoding_id,
+    Uint16         language_id,
+    Size          *length
+);
+
+#endif // ANVIE_CROSSFILE_OTF_SHARED_H
@@ -34,9 +34,11 @@
 #define ANVIE_CROSSGUI_OTF_TABLES_H
 
 #include <Anvie/CrossFile/Otf/Tables/Cmap.h>
+#include <Anvie/CrossFile/Otf/Tables/Gpos.h>
 #include <Anvie/CrossFile/Otf/Tables/Head.h>
 #include <Anvie/CrossFile/Otf/Tables/Hhea.h>
 #include <Anvie/CrossFile/Otf/Tables/Hmtx.h>
+#include <Anvie/CrossFile/Otf/Tables/Kern.h>
 #include <Anvie/CrossFile/Otf/Tables/Loca.h>
 #include <Anvie/CrossFile/Otf/Tables/Maxp.h>
 #include <Anvie/CrossFile/Otf/Tables/Name.h>
@@ -57,7 +59,7 @@ typedef enum OtfTableTag : Uint32 {
     OTF_TABLE_TAG_HMTX = 0x78746d68, /* hmtx */
     OTF_TABLE_TAG_MAXP = 0x7078616d, /* maxp */
     OTF_TABLE_TAG_NAME = 0x656d616e, /* name */
-    OTF_TABLE_TAG_OS_2 = 0x325f534f, /* OS/2 */
+    OTF_TABLE_TAG_OS_2 = 0x322f534f, /* OS/2 */
     OTF_TABLE_TAG_POST = 0x74736f70, /* post */
 
     /* required for font description */
@@ -66,7 +68,11 @@ typedef enum OtfTableTag : Uint32 {
     OTF_TABLE_TAG_GLYF = 0x66796c67, /* glyf */
     OTF_TABLE_TAG_LOCA = 0x61636f6c, /* loca */
     OTF_TABLE_TAG_PREP = 0x70657270, /* prep */
-    OTF_TABLE_TAG_GASP = 0x70736167  /* gasp */
+    OTF_TABLE_TAG_GASP = 0x70736167, /* gasp */
+
+    /* optional tables used for kerning */
+    OTF_TABLE_TAG_KERN = 0x6e72656b, /* kern */
+    OTF_TABLE_TAG_GPOS = 0x534f5047  /* GPOS */
 } OtfTableTag;
 
 /**
@@ -84,7 +90,7 @@ typedef struct OtfTableRecord {
     Uint32      length; /**< @b Length of table. */
 } OtfTableRecord;
 
-#define OTF_TABLE_RECORD_DATA_SIZE (sizeof (OtfTableTag) + sizeof (Uint32) * 3)
+#define OTF_TABLE_RECORD_DATA_SIZE (sizeof (Uint32) * 4)
 
 OtfTableRecord* otf_table_record_init (OtfTableRecord* record, Uint8* data, Size size);
 OtfTableRecord* otf_table_record_pprint (OtfTableRecord* record, Uint8 indent_level);
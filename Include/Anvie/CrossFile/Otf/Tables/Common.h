@@ -176,7 +176,7 @@ typedef struct OtfPlatformEncoding {
     } encoding;
 } OtfPlatformEncoding;
 
-#define OTF_PLATFORM_ENCODING_DATA_SIZE (sizeof (OtfPlatform) + sizeof (Uint16))
+#define OTF_PLATFORM_ENCODING_DATA_SIZE (sizeof (Uint16) * 2)
 
 CString otf_platform_encoding_get_platform_str (OtfPlatformEncoding platform_encoding);
 CString otf_platform_encoding_get_encoding_str (OtfPlatformEncoding platform_encoding);
@@ -0,0 +1,142 @@
+/**
+ * @file Gpos.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_OTF_TABLES_GPOS_H
+#define ANVIE_CROSSFILE_OTF_TABLES_GPOS_H
+
+#include <Anvie/Types.h>
+
+/* REF : https://learn.microsoft.com/en-us/typography/opentype/spec/gpos
+ * REF : https://learn.microsoft.com/en-us/typography/opentype/spec/chapter2 */
+
+/**
+ * @b GPOS lookup types that are understood by the decoder.
+ * Only pair adjustment lookups are decoded, extension lookups
+ * are followed when they wrap a pair adjustment subtable.
+ * */
+typedef enum OtfGposLookupType : Uint16 {
+    OTF_GPOS_LOOKUP_TYPE_PAIR_ADJUSTMENT = 2,
+    OTF_GPOS_LOOKUP_TYPE_EXTENSION       = 9,
+} OtfGposLookupType;
+
+/**
+ * @b Bits of a ValueFormat field. Only x advance of first glyph (value1) is
+ * extracted from value records, rest of the bits are used to compute record size.
+ * */
+typedef enum OtfGposValueFormat : Uint16 {
+    OTF_GPOS_VALUE_FORMAT_X_PLACEMENT        = 1 << 0,
+    OTF_GPOS_VALUE_FORMAT_Y_PLACEMENT        = 1 << 1,
+    OTF_GPOS_VALUE_FORMAT_X_ADVANCE          = 1 << 2,
+    OTF_GPOS_VALUE_FORMAT_Y_ADVANCE          = 1 << 3,
+    OTF_GPOS_VALUE_FORMAT_X_PLACEMENT_DEVICE = 1 << 4,
+    OTF_GPOS_VALUE_FORMAT_Y_PLACEMENT_DEVICE = 1 << 5,
+    OTF_GPOS_VALUE_FORMAT_X_ADVANCE_DEVICE   = 1 << 6,
+    OTF_GPOS_VALUE_FORMAT_Y_ADVANCE_DEVICE   = 1 << 7,
+} OtfGposValueFormat;
+
+/**
+ * @b Both ClassDef formats are normalized to a list of glyph ranges.
+ * Glyphs not present in any range belong to class 0.
+ * */
+typedef struct OtfGposClassRange {
+    Uint16 start_glyph_id;
+    Uint16 end_glyph_id;
+    Uint16 class_value;
+} OtfGposClassRange;
+
+typedef struct OtfGposClassDef {
+    Uint16             num_ranges;
+    OtfGposClassRange *ranges; /**< @b Sorted by start glyph id. */
+} OtfGposClassDef;
+
+typedef struct OtfGposPairValue {
+    Uint16 second_glyph;
+    Int16  x_advance; /**< @b XAdvance of first glyph (value1). */
+} OtfGposPairValue;
+
+typedef struct OtfGposPairSet {
+    Uint16            num_pair_values;
+    OtfGposPairValue *pair_values;
+} OtfGposPairSet;
+
+/**
+ * @b Decoded pair adjustment positioning subtable (lookup type 2).
+ * */
+typedef struct OtfGposPairAdjust {
+    Uint16 pos_format;   /**< @b 1 for glyph pairs, 2 for class pairs. */
+    Uint16 lookup_index; /**< @b Index of lookup in lookup list this subtable belongs to. */
+    Uint16 value_format1;
+    Uint16 value_format2;
+
+    /**
+     * @b Coverage table expanded to an array of glyph ids,
+     * indexed by coverage index.
+     * */
+    Uint16  num_covered_glyphs;
+    Uint16 *covered_glyphs;
+
+    union {
+        struct {
+            Uint16          num_pair_sets; /**< @b One pair set per covered glyph. */
+            OtfGposPairSet *pair_sets;
+        } format1;
+
+        struct {
+            OtfGposClassDef class_def1;
+            OtfGposClassDef class_def2;
+            Uint16          class1_count;
+            Uint16          class2_count;
+            Int16          *x_advances; /**< @b class1_count x class2_count matrix. */
+        } format2;
+    };
+} OtfGposPairAdjust;
+
+/**
+ * @b Only parts of GPOS table relevant for kerning are kept.
+ * Pair adjustment subtables are stored in the order in which they
+ * must be applied (lookup list order, then subtable order).
+ * */
+typedef struct OtfGpos {
+    Uint16             major_version;
+    Uint16             minor_version;
+    Uint16             num_pair_adjustments;
+    OtfGposPairAdjust *pair_adjustments;
+} OtfGpos;
+
+#define OTF_GPOS_DATA_SIZE (sizeof (Uint16) * 5)
+
+OtfGpos *otf_gpos_init (OtfGpos *gpos, Uint8 *data, Size size);
+OtfGpos *otf_gpos_deinit (OtfGpos *gpos);
+OtfGpos *otf_gpos_pprint (OtfGpos *gpos, Uint8 indent_level);
+
+#endif // ANVIE_CROSSFILE_OTF_TABLES_GPOS_H
@@ -105,7 +105,7 @@ typedef struct OtfHead {
 #define OTF_HEAD_DATA_SIZE                                                                         \
     (sizeof (Uint16) * 2 + sizeof (Uint32) * 3 + sizeof (OtfHeadFlags) + sizeof (Uint16) +         \
      sizeof (Uint64) * 2 + sizeof (Int16) * 4 + sizeof (OtfMacStyleFlags) + sizeof (Uint16) +      \
-     sizeof (OtfFontDirectionHint) + sizeof (Int16) * 2)
+     sizeof (Int16) * 3)
 
 OtfHead* otf_head_init (OtfHead* head, Uint8* data, Size size);
 OtfHead* otf_head_pprint (OtfHead* head, Uint8 indent_level);
@@ -0,0 +1,94 @@
+/**
+ * @file Kern.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_OTF_TABLES_KERN_H
+#define ANVIE_CROSSFILE_OTF_TABLES_KERN_H
+
+#include <Anvie/Types.h>
+
+/* REF : https://learn.microsoft.com/en-us/typography/opentype/spec/kern */
+
+/**
+ * @b Coverage bits of a kern subtable.
+ * The high byte of coverage field contains format of subtable.
+ * */
+typedef enum OtfKernCoverage : Uint16 {
+    OTF_KERN_COVERAGE_HORIZONTAL   = 1 << 0,
+    OTF_KERN_COVERAGE_MINIMUM      = 1 << 1,
+    OTF_KERN_COVERAGE_CROSS_STREAM = 1 << 2,
+    OTF_KERN_COVERAGE_OVERRIDE     = 1 << 3,
+} OtfKernCoverage;
+
+#define OTF_KERN_SUBTABLE_FORMAT(coverage) ((coverage) >> 8)
+
+typedef struct OtfKernPair {
+    Uint16 left;  /**< @b Glyph index of left hand glyph in kerning pair. */
+    Uint16 right; /**< @b Glyph index of right hand glyph in kerning pair. */
+    Int16  value; /**< @b Kerning value in font design units. */
+} OtfKernPair;
+
+#define OTF_KERN_PAIR_DATA_SIZE (sizeof (Uint16) * 3)
+
+/**
+ * @b Only format 0 subtables are decoded. Subtables of other formats
+ * are retained with their header fields but have no pairs.
+ * */
+typedef struct OtfKernSubtable {
+    Uint16 version;
+    Uint16 length; /**< @b Can overflow for large format 0 subtables, never trusted for those. */
+    Uint16 coverage;
+
+    /* format 0 */
+    Uint16       num_pairs;
+    Uint16       search_range;
+    Uint16       entry_selector;
+    Uint16       range_shift;
+    OtfKernPair *pairs; /**< @b Sorted by (left, right) as required by spec. */
+} OtfKernSubtable;
+
+#define OTF_KERN_SUBTABLE_HEADER_DATA_SIZE  (sizeof (Uint16) * 3)
+#define OTF_KERN_SUBTABLE_FORMAT0_DATA_SIZE (sizeof (Uint16) * 4)
+
+typedef struct OtfKern {
+    Uint16           version;
+    Uint16           num_tables;
+    OtfKernSubtable *subtables;
+} OtfKern;
+
+#define OTF_KERN_DATA_SIZE (sizeof (Uint16) * 2)
+
+OtfKern *otf_kern_init (OtfKern *kern, Uint8 *data, Size size);
+OtfKern *otf_kern_deinit (OtfKern *kern);
+OtfKern *otf_kern_pprint (OtfKern *kern, Uint8 indent_level);
+
+#endif // ANVIE_CROSSFILE_OTF_TABLES_KERN_H
@@ -47,6 +47,7 @@
 typedef struct IoStream IoStream, TO_IoStream;
 
 PUBLIC TO_IoStream* io_stream_open_file (CString filename, Bool is_writable);
+PUBLIC TO_IoStream* io_stream_open_mapped_file (CString filename);
 PUBLIC void         io_stream_close (TO_IoStream* stream);
 
 PUBLIC IoStream* io_stream_seek (IoStream* io, Int64 off);
@@ -22,7 +22,7 @@ typedef struct GenericBinTree {
 } GenericBinTree;
 
 /* This vector type is only to aid in tree traversals.
- * The following traversal methods return a static vector of this type.
+ * The following traversal methods return a thread local vector of this type.
  * 
  * This is kind-of a hacky way to implement backtracking without stack inside a
  * macro. Since macros don't have their own stack, functions are used to flatten
@@ -34,15 +34,16 @@ typedef struct GenericBinTree {
  *
  * Also, one very important point here is that none of the traversal methods
  * return a `TO_##GenericBinTreeVec` means no transfer-of-ownership of vector
- * must be assumed. The returned vector is actually a static vector that's
- * allocated when first required and is kept in memory throughout the program
- * lifetime once created. In other words, a lazily allocated static vector
- * without transfer-of-ownership.
+ * must be assumed. The returned vector is actually a thread local vector that's
+ * allocated when first required in a thread and is kept in memory till that thread
+ * exits. In other words, a lazily allocated thread local vector without
+ * transfer-of-ownership.
  *
  * Also, since no cloning (init, deinit) methods are provided, none of the items
  * inserted will be owned by this vector.
  *
- * WARN: This solution is not thread-safe!
+ * Traversals in different threads are independent of each other, but a traversal
+ * still overwrites the result of previous traversal in the same thread.
  * */
 ANV_MAKE_VEC (GenericBinTreeVec, generic_bin_tree, GenericBinTree, Null, Null);
 
@@ -0,0 +1,532 @@
+/**
+ * @file AddrIndex.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Elf/AddrIndex.h>
+#include <Anvie/CrossFile/Elf/Elf.h>
+
+/* libc */
+#include <memory.h>
+#include <stdlib.h>
+
+/* vendored ELF definitions */
+#include <Elf/Elf.h>
+
+/* batches are sorted and walked in chunks of this many addresses, so a chunk
+ * and it's sort buffer stay in cache */
+#define ELF_ADDR_INDEX_BATCH_CHUNK (1 << 14)
+
+/**
+ * @b Symbol collected for flattening into ranges.
+ * */
+typedef struct AddrSymbol {
+    Uint64 value;
+    Uint64 end;
+    Uint32 symbol;
+    Uint32 rank; /**< @b Preference among symbols covering same range, lower is better. */
+} AddrSymbol;
+
+/**
+ * @b Address being looked up in a batch, along with it's position in batch.
+ * */
+typedef struct AddrQuery {
+    Uint64 addr;
+    Size   at;
+} AddrQuery;
+
+PRIVATE int         addr_symbol_compare (const void* lhs, const void* rhs);
+PRIVATE AddrSymbol* addr_index_collect (ElfAddrIndex* index, ElfFile* elf, Size* count);
+PRIVATE Bool        addr_index_flatten (ElfAddrIndex* index, AddrSymbol* symbols, Size count);
+PRIVATE void
+    addr_index_emit (ElfAddrIndex* index, Uint64 start, Uint64 end, AddrSymbol* sym);
+PRIVATE Size        addr_index_build_tree (ElfAddrIndex* index, Size pos, Size k);
+PRIVATE Size        addr_index_advance (ElfAddrIndex* index, Size from, Uint64 addr);
+PRIVATE Bool
+    addr_index_match (ElfAddrIndex* index, Size upper, Uint64 addr, ElfAddrMatch* match);
+PRIVATE AddrQuery*  addr_query_sort (AddrQuery* queries, AddrQuery* scratch, Size count);
+
+/**************************************************************************************************/
+/******************************** PUBLIC METHOD DEFINITIONS ***************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Build address to symbol index over static symbol table of given file, or
+ * over dynamic symbol table if file has no static one.
+ *
+ * Index refers to symbol table of @p elf, so it must be destroyed before file is
+ * closed.
+ *
+ * @param index ElfAddrIndex object to be initialized.
+ * @param elf Opened ELF file.
+ *
+ * @return @c index on success.
+ * @return @c Null otherwise.
+ * */
+ElfAddrIndex* elf_addr_index_init (ElfAddrIndex* index, ElfFile* elf) {
+    RETURN_VALUE_IF (!index || !elf, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (index, 0, sizeof (ElfAddrIndex));
+    index->table = elf->symtab.count ? &elf->symtab : &elf->dynsym;
+    RETURN_VALUE_IF (
+        index->table->count > (Uint32)-1,
+        Null,
+        "Symbol table is too large to index (%zu symbols).\n",
+        index->table->count
+    );
+
+    Size        count   = 0;
+    AddrSymbol* symbols = addr_index_collect (index, elf, &count);
+    RETURN_VALUE_IF (!symbols, Null, "Failed to collect symbols.\n");
+
+    Bool flattened = addr_index_flatten (index, symbols, count);
+    FREE (symbols);
+    GOTO_HANDLER_IF (!flattened, INIT_FAILED, "Failed to flatten symbols into ranges.\n");
+
+    index->tree  = ALLOCATE (Uint64, index->count + 1);
+    index->ranks = ALLOCATE (Uint32, index->count + 1);
+    GOTO_HANDLER_IF (!index->tree || !index->ranks, INIT_FAILED, ERR_OUT_OF_MEMORY);
+    addr_index_build_tree (index, 0, 1);
+
+    return index;
+
+INIT_FAILED:
+    elf_addr_index_deinit (index);
+    return Null;
+}
+
+/**
+ * @b Destroy given address index.
+ *
+ * @param index
+ *
+ * @return @c index on success.
+ * @return @c Null otherwise.
+ * */
+ElfAddrIndex* elf_addr_index_deinit (ElfAddrIndex* index) {
+    RETURN_VALUE_IF (!index, Null, ERR_INVALID_ARGUMENTS);
+
+    if (index->starts) {
+        FREE (index->starts);
+    }
+
+    if (index->ranges) {
+        FREE (index->ranges);
+    }
+
+    if (index->tree) {
+        FREE (index->tree);
+    }
+
+    if (index->ranks) {
+        FREE (index->ranks);
+    }
+
+    memset (index, 0, sizeof (ElfAddrIndex));
+
+    return index;
+}
+
+/**
+ * @b Find symbol containing given address.
+ *
+ * @param index
+ * @param addr Address to look up.
+ * @param match Where symbol and offset into it are stored. Symbol is 0 when
+ *        no symbol contains address.
+ *
+ * @return @c True if a symbol contains address.
+ * @return @c False otherwise.
+ * */
+Bool elf_addr_index_lookup (ElfAddrIndex* index, Uint64 addr, ElfAddrMatch* match) {
+    RETURN_VALUE_IF (!index || !match, False, ERR_INVALID_ARGUMENTS);
+
+    /* each line of tree holds 8 starts, so this brings in nodes 3 levels below */
+    Size k = 1;
+    while (k <= index->count) {
+        __builtin_prefetch (index->tree + k * 8);
+        k = 2 * k + (index->tree[k] <= addr);
+    }
+
+    /* undo trailing right turns, leaving first start after addr, 0 if there's none */
+    k >>= __builtin_ffsll (~k);
+
+    return addr_index_match (index, k ? index->ranks[k] : index->count, addr, match);
+}
+
+/**
+ * @b Find symbols containing each of given addresses.
+ *
+ * Addresses are sorted (when not already sorted) and walked in increasing order
+ * along with ranges, skipping ahead with a galloping search, so ranges between
+ * nearby addresses are never searched again. Large batches are processed in
+ * chunks that fit in cache.
+ *
+ * @param index
+ * @param addrs Addresses to look up, in any order.
+ * @param count Number of addresses.
+ * @param matches Where matches are stored, in same order as @p addrs.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+Bool elf_addr_index_lookup_batch (
+    ElfAddrIndex* index,
+    const Uint64* addrs,
+    Size          count,
+    ElfAddrMatch* matches
+) {
+    RETURN_VALUE_IF (!index || (count && (!addrs || !matches)), False, ERR_INVALID_ARGUMENTS);
+
+    if (!count) {
+        return True;
+    }
+
+    Size       chunk   = MIN (count, ELF_ADDR_INDEX_BATCH_CHUNK);
+    AddrQuery* queries = ALLOCATE (AddrQuery, chunk * 2);
+    RETURN_VALUE_IF (!queries, False, ERR_OUT_OF_MEMORY);
+
+    /* addresses outside all ranges are resolved right away, rest are sorted by offset
+     * from first range, which leaves only low bytes to sort on */
+    Uint64 base = index->count ? index->starts[0] : 0;
+    Uint64 end  = index->count ? index->ranges[index->count - 1].end : 0;
+
+    for (Size from = 0; from < count; from += chunk) {
+        Size n = 0;
+        for (Size q = from; q < MIN (from + chunk, count); q++) {
+            if (addrs[q] >= base && addrs[q] < end) {
+                queries[n].addr = addrs[q] - base;
+                queries[n].at   = q;
+                n++;
+            } else {
+                matches[q] = (ElfAddrMatch) {0};
+            }
+        }
+
+        AddrQuery* sorted = addr_query_sort (queries, queries + chunk, n);
+
+        Size upper = 0;
+        for (Size q = 0; q < n; q++) {
+            Uint64 addr = sorted[q].addr + base;
+            upper       = addr_index_advance (index, upper, addr);
+            addr_index_match (index, upper, addr, matches + sorted[q].at);
+        }
+    }
+
+    FREE (queries);
+
+    return True;
+}
+
+/**************************************************************************************************/
+/******************************** PRIVATE METHOD DEFINITIONS **************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Order symbols by start, then outer symbols before inner ones, then by
+ * preference.
+ * */
+PRIVATE int addr_symbol_compare (const void* lhs, const void* rhs) {
+    const AddrSymbol* a = lhs;
+    const AddrSymbol* b = rhs;
+
+    if (a->value != b->value) {
+        return a->value < b->value ? -1 : 1;
+    }
+    if (a->end != b->end) {
+        return a->end > b->end ? -1 : 1;
+    }
+    if (a->rank != b->rank) {
+        return a->rank < b->rank ? -1 : 1;
+    }
+    return a->symbol < b->symbol ? -1 : a->symbol > b->symbol;
+}
+
+/**
+ * @b Collect symbols of index's table that name an address range, sorted in
+ * order ranges are flattened in.
+ *
+ * Undefined, absolute, section, file and TLS symbols are left out, since their
+ * values aren't addresses of code or data.
+ *
+ * @param index
+ * @param elf
+ * @param count Where number of collected symbols is stored.
+ *
+ * @return Collected symbols on success, owned by caller.
+ * @return @c Null otherwise.
+ * */
+PRIVATE AddrSymbol* addr_index_collect (ElfAddrIndex* index, ElfFile* elf, Size* count) {
+    ElfSymbolTable* table   = index->table;
+    AddrSymbol*     symbols = ALLOCATE (AddrSymbol, MAX (table->count, 1));
+    RETURN_VALUE_IF (!symbols, Null, ERR_OUT_OF_MEMORY);
+
+    Size      n = 0;
+    ElfSymbol symbol;
+    for (Size s = 1; s < table->count; s++) {
+        elf_symbol_table_get (elf, table, s, &symbol);
+
+        if (symbol.shndx == SHN_UNDEF || symbol.shndx == SHN_ABS || symbol.type == STT_SECTION ||
+            symbol.type == STT_FILE || symbol.type == STT_TLS) {
+            continue;
+        }
+
+        AddrSymbol* sym = symbols + n++;
+        sym->value      = symbol.value;
+        sym->end        = symbol.value + MIN (symbol.size, (Uint64)-1 - symbol.value);
+        sym->symbol     = s;
+
+        /* global over weak over local, default versions over others */
+        sym->rank = symbol.bind == STB_GLOBAL ? 0 : symbol.bind == STB_WEAK ? 1 : 2;
+        if (symbol.version & ELF_VERSYM_HIDDEN) {
+            sym->rank += 4;
+        }
+    }
+
+    /* zero sized symbols (mostly from assembly) cover everything up to next symbol */
+    qsort (symbols, n, sizeof (AddrSymbol), addr_symbol_compare);
+    for (Size s = 0, next = 0; s < n; s++) {
+        if (symbols[s].end != symbols[s].value) {
+            continue;
+        }
+
+        next = MAX (next, s + 1);
+        while (next < n && symbols[next].value == symbols[s].value) {
+            next++;
+        }
+        symbols[s].end = next < n ? symbols[next].value : symbols[s].value + 1;
+    }
+    qsort (symbols, n, sizeof (AddrSymbol), addr_symbol_compare);
+
+    *count = n;
+    return symbols;
+}
+
+/**
+ * @b Flatten sorted symbols into non overlapping ranges, each covered by the
+ * innermost symbol, that is the one that started last among symbols still open.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool addr_index_flatten (ElfAddrIndex* index, AddrSymbol* symbols, Size count) {
+    /* every symbol adds atmost two ranges, one before it and one when it ends */
+    AddrSymbol** nested = ALLOCATE (AddrSymbol*, MAX (count, 1));
+    index->starts       = ALLOCATE (Uint64, MAX (count * 2, 1));
+    index->ranges       = ALLOCATE (ElfAddrRange, MAX (count * 2, 1));
+    if (!nested || !index->starts || !index->ranges) {
+        if (nested) {
+            FREE (nested);
+        }
+        RETURN_VALUE_IF_REACHED (False, ERR_OUT_OF_MEMORY);
+    }
+
+    Size   depth = 0;
+    Uint64 pos   = 0;
+    for (Size s = 0; s < count; s++) {
+        AddrSymbol* sym = symbols + s;
+
+        /* aliases of a symbol already open add nothing */
+        if (depth && nested[depth - 1]->value == sym->value && nested[depth - 1]->end == sym->end) {
+            continue;
+        }
+
+        while (depth && nested[depth - 1]->end <= sym->value) {
+            AddrSymbol* closed = nested[--depth];
+            addr_index_emit (index, pos, closed->end, closed);
+            pos = MAX (pos, closed->end);
+        }
+
+        if (depth) {
+            addr_index_emit (index, pos, sym->value, nested[depth - 1]);
+        }
+
+        pos             = sym->value;
+        nested[depth++] = sym;
+    }
+
+    while (depth) {
+        AddrSymbol* closed = nested[--depth];
+        addr_index_emit (index, pos, closed->end, closed);
+        pos = MAX (pos, closed->end);
+    }
+
+    FREE (nested);
+
+    return True;
+}
+
+/**
+ * @b Append range @c [start, end) covered by given symbol, extending last range
+ * instead when it belongs to same symbol and ends where this one starts.
+ * */
+PRIVATE void addr_index_emit (ElfAddrIndex* index, Uint64 start, Uint64 end, AddrSymbol* sym) {
+    if (start >= end) {
+        return;
+    }
+
+    ElfAddrRange* last = index->count ? index->ranges + index->count - 1 : Null;
+    if (last && last->symbol == sym->symbol && last->end == start) {
+        last->end = end;
+        return;
+    }
+
+    index->starts[index->count] = start;
+    index->ranges[index->count] = (ElfAddrRange) {
+        .value  = sym->value,
+        .end    = end,
+        .symbol = sym->symbol,
+    };
+    index->count++;
+}
+
+/**
+ * @b Fill subtree of Eytzinger tree rooted at @p k with sorted starts, in order.
+ *
+ * @param index
+ * @param pos Position in sorted starts of first start to place.
+ * @param k Root of subtree.
+ *
+ * @return Position of first start not placed in subtree.
+ * */
+PRIVATE Size addr_index_build_tree (ElfAddrIndex* index, Size pos, Size k) {
+    if (k <= index->count) {
+        pos             = addr_index_build_tree (index, pos, 2 * k);
+        index->tree[k]  = index->starts[pos];
+        index->ranks[k] = pos++;
+        pos             = addr_index_build_tree (index, pos, 2 * k + 1);
+    }
+
+    return pos;
+}
+
+/**
+ * @b Find position of first range starting after given address, given that
+ * ranges before @p from all start at or before it.
+ *
+ * Distance is first bracketed by doubling steps, and then binary searched, so
+ * nearby addresses cost a few comparisons and far ones a logarithmic number.
+ * */
+PRIVATE Size addr_index_advance (ElfAddrIndex* index, Size from, Uint64 addr) {
+    Size lo = from, hi = from;
+    for (Size step = 1; hi < index->count && index->starts[hi] <= addr; step *= 2) {
+        lo  = hi + 1;
+        hi += step;
+    }
+    hi = MIN (hi, index->count);
+
+    while (lo < hi) {
+        Size mid = lo + (hi - lo) / 2;
+        if (index->starts[mid] <= addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * @b Resolve address using range just before first range starting after it.
+ *
+ * @return @c True if range contains address.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool addr_index_match (ElfAddrIndex* index, Size upper, Uint64 addr, ElfAddrMatch* match) {
+    ElfAddrRange* range = upper ? index->ranges + upper - 1 : Null;
+
+    if (!range || addr >= range->end) {
+        match->symbol = 0;
+        match->offset = 0;
+        return False;
+    }
+
+    match->symbol = range->symbol;
+    match->offset = addr - range->value;
+    return True;
+}
+
+/**
+ * @b Sort queries by address with a least significant byte first radix sort.
+ *
+ * Counts of all bytes are taken in a single pass, and passes over bytes that
+ * are same in all addresses are skipped. Input that is already sorted is
+ * returned as is.
+ *
+ * @param queries Queries to sort.
+ * @param scratch Space for as many queries.
+ * @param count Number of queries.
+ *
+ * @return Either @p queries or @p scratch, whichever holds sorted queries.
+ * */
+PRIVATE AddrQuery* addr_query_sort (AddrQuery* queries, AddrQuery* scratch, Size count) {
+    Size q = 1;
+    while (q < count && queries[q - 1].addr <= queries[q].addr) {
+        q++;
+    }
+    if (q >= count) {
+        return queries;
+    }
+
+    Size offsets[sizeof (Uint64)][256] = {0};
+    for (q = 0; q < count; q++) {
+        for (Size byte = 0; byte < sizeof (Uint64); byte++) {
+            offsets[byte][(queries[q].addr >> (byte * 8)) & 0xff]++;
+        }
+    }
+
+    for (Size byte = 0; byte < sizeof (Uint64); byte++) {
+        Size shift = byte * 8;
+        if (offsets[byte][(queries[0].addr >> shift) & 0xff] == count) {
+            continue;
+        }
+
+        for (Size b = 0, sum = 0; b < 256; b++) {
+            Size n           = offsets[byte][b];
+            offsets[byte][b] = sum;
+            sum             += n;
+        }
+
+        for (q = 0; q < count; q++) {
+            scratch[offsets[byte][(queries[q].addr >> shift) & 0xff]++] = queries[q];
+        }
+
+        AddrQuery* sorted = scratch;
+        scratch           = queries;
+        queries           = sorted;
+    }
+
+    return queries;
+}
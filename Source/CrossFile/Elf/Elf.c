@@ -0,0 +1,838 @@
+/**
+ * @file Elf.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Elf/Elf.h>
+
+/* libc */
+#include <memory.h>
+#include <stddef.h>
+
+/* vendored ELF definitions */
+#include <Elf/Elf.h>
+
+/* local includes */
+#include "../Stream/Stream.h"
+
+/**
+ * @b Value of a field of an ELF structure in mapped file, in host byte order.
+ *
+ * Structure definition is picked by class of file, so fields are found at their
+ * right offset for both classes.
+ * */
+#define ELF_GET(elf, ptr, type, field)                                                             \
+    ((elf)->is_64 ? elf_read (                                                                     \
+                        (elf),                                                                     \
+                        (ptr) + offsetof (Elf64_##type, field),                                    \
+                        sizeof (((Elf64_##type*)0)->field)                                         \
+                    ) :                                                                            \
+                    elf_read (                                                                     \
+                        (elf),                                                                     \
+                        (ptr) + offsetof (Elf32_##type, field),                                    \
+                        sizeof (((Elf32_##type*)0)->field)                                         \
+                    ))
+
+PRIVATE Uint64  elf_read (ElfFile* elf, const Uint8* ptr, Size size);
+PRIVATE CString elf_string (const Char* strings, Size strings_size, Uint64 off);
+PRIVATE Uint32  elf_hash (CString name);
+PRIVATE ElfSlot* elf_slots_create (Size count, Size* slot_count);
+PRIVATE void     elf_slots_insert (ElfSlot* slots, Size slot_count, Uint32 hash, Size index);
+PRIVATE Bool     elf_section_decode (ElfFile* elf, Size index, ElfSection* section);
+PRIVATE Bool     elf_section_index (ElfFile* elf);
+PRIVATE Bool
+    elf_symbol_decode (ElfFile* elf, ElfSymbolTable* table, Size index, ElfSymbol* sym);
+PRIVATE Bool     elf_symbol_pick (ElfSymbol* candidate, ElfSymbol* symbol, Bool* found);
+PRIVATE Bool     elf_symbol_table_init (ElfFile* elf, ElfSymbolTable* table, Size section_index);
+PRIVATE void     elf_symbol_table_deinit (ElfSymbolTable* table);
+PRIVATE Bool     elf_gnu_hash_find (ElfFile* elf, const Uint8** data, Size* size);
+PRIVATE Bool
+    elf_gnu_hash_init (ElfFile* elf, ElfSymbolTable* table, const Uint8* data, Size size);
+PRIVATE Bool     elf_gnu_hash_lookup (
+    ElfFile*        elf,
+    ElfSymbolTable* table,
+    CString         name,
+    ElfSymbol*      symbol
+);
+
+/**************************************************************************************************/
+/******************************** PUBLIC METHOD DEFINITIONS ***************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Open an ELF file, and index it's sections and symbols by name.
+ *
+ * @param elf ElfFile object to be initialized.
+ * @param filename Name of file to open.
+ *
+ * @return @c elf on success.
+ * @return @c Null otherwise.
+ * */
+ElfFile* elf_file_open (ElfFile* elf, CString filename) {
+    RETURN_VALUE_IF (!elf || !filename, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (elf, 0, sizeof (ElfFile));
+
+    elf->stream = io_stream_open_mapped_file (filename);
+    RETURN_VALUE_IF (!elf->stream, Null, ERR_FILE_OPEN_FAILED);
+    elf->data = elf->stream->data;
+    elf->size = elf->stream->size;
+
+    const Uint8* ehdr = elf->data;
+    GOTO_HANDLER_IF (
+        elf->size < EI_NIDENT || memcmp (ehdr, ELFMAG, SELFMAG),
+        OPEN_FAILED,
+        "File is not an ELF file.\n"
+    );
+    GOTO_HANDLER_IF (
+        ehdr[EI_CLASS] != ELFCLASS32 && ehdr[EI_CLASS] != ELFCLASS64,
+        OPEN_FAILED,
+        "Unsupported ELF class %u.\n",
+        ehdr[EI_CLASS]
+    );
+    GOTO_HANDLER_IF (
+        ehdr[EI_DATA] != ELFDATA2LSB && ehdr[EI_DATA] != ELFDATA2MSB,
+        OPEN_FAILED,
+        "Unsupported ELF data encoding %u.\n",
+        ehdr[EI_DATA]
+    );
+
+    elf->is_64 = ehdr[EI_CLASS] == ELFCLASS64;
+    elf->swap  = (ehdr[EI_DATA] == ELFDATA2LSB) != HOST_BYTE_ORDER_IS_LSB;
+    GOTO_HANDLER_IF (
+        elf->size < (elf->is_64 ? sizeof (Elf64_Ehdr) : sizeof (Elf32_Ehdr)),
+        OPEN_FAILED,
+        "ELF header is truncated.\n"
+    );
+
+    elf->type    = ELF_GET (elf, ehdr, Ehdr, e_type);
+    elf->machine = ELF_GET (elf, ehdr, Ehdr, e_machine);
+    elf->entry   = ELF_GET (elf, ehdr, Ehdr, e_entry);
+
+    Uint64 shoff     = ELF_GET (elf, ehdr, Ehdr, e_shoff);
+    Size   shentsize = ELF_GET (elf, ehdr, Ehdr, e_shentsize);
+    Size   shnum     = ELF_GET (elf, ehdr, Ehdr, e_shnum);
+    Size   shstrndx  = ELF_GET (elf, ehdr, Ehdr, e_shstrndx);
+
+    if (shoff) {
+        GOTO_HANDLER_IF (
+            shentsize < (elf->is_64 ? sizeof (Elf64_Shdr) : sizeof (Elf32_Shdr)),
+            OPEN_FAILED,
+            "Section header entry size %zu is too small.\n",
+            shentsize
+        );
+        GOTO_HANDLER_IF (
+            shoff > elf->size || elf->size - shoff < shentsize,
+            OPEN_FAILED,
+            "Section header table lies outside file.\n"
+        );
+
+        elf->sections        = elf->data + shoff;
+        elf->section_entsize = shentsize;
+
+        /* with extended numbering, real values are kept in first section header */
+        if (!shnum) {
+            shnum = ELF_GET (elf, elf->sections, Shdr, sh_size);
+        }
+        if (shstrndx == SHN_XINDEX) {
+            shstrndx = ELF_GET (elf, elf->sections, Shdr, sh_link);
+        }
+
+        GOTO_HANDLER_IF (
+            shnum > (elf->size - shoff) / shentsize,
+            OPEN_FAILED,
+            "Section header table lies outside file.\n"
+        );
+        elf->section_count = shnum;
+    }
+
+    /* strings are only ever looked up from table, so it's enough to check it's terminated once */
+    ElfSection section;
+    if (shstrndx != SHN_UNDEF && elf_section_decode (elf, shstrndx, &section) && section.data) {
+        GOTO_HANDLER_IF (
+            section.data[section.size - 1],
+            OPEN_FAILED,
+            "Section header string table is not terminated.\n"
+        );
+        elf->section_names      = (const Char*)section.data;
+        elf->section_names_size = section.size;
+    }
+
+    GOTO_HANDLER_IF (!elf_section_index (elf), OPEN_FAILED, "Failed to index sections.\n");
+
+    /* first table of each kind is the one loaders use */
+    Size symtab = 0, dynsym = 0;
+    for (Size s = 1; s < elf->section_count; s++) {
+        if (!elf_section_decode (elf, s, &section)) {
+            continue;
+        }
+
+        if (section.type == SHT_SYMTAB && !symtab) {
+            symtab = s;
+        } else if (section.type == SHT_DYNSYM && !dynsym) {
+            dynsym = s;
+        }
+    }
+
+    GOTO_HANDLER_IF (
+        !elf_symbol_table_init (elf, &elf->symtab, symtab) ||
+            !elf_symbol_table_init (elf, &elf->dynsym, dynsym),
+        OPEN_FAILED,
+        "Failed to index symbols.\n"
+    );
+
+    return elf;
+
+OPEN_FAILED:
+    elf_file_close (elf);
+    return Null;
+}
+
+/**
+ * @b Close given ELF file, and release everything created for it.
+ *
+ * Views of sections and symbols are invalid after this.
+ *
+ * @param elf
+ *
+ * @return @c elf on success.
+ * @return @c Null otherwise.
+ * */
+ElfFile* elf_file_close (ElfFile* elf) {
+    RETURN_VALUE_IF (!elf, Null, ERR_INVALID_ARGUMENTS);
+
+    elf_symbol_table_deinit (&elf->symtab);
+    elf_symbol_table_deinit (&elf->dynsym);
+
+    if (elf->section_slots) {
+        FREE (elf->section_slots);
+    }
+
+    if (elf->stream) {
+        io_stream_close (elf->stream);
+    }
+
+    memset (elf, 0, sizeof (ElfFile));
+
+    return elf;
+}
+
+/**
+ * @b Decode section header at given index.
+ *
+ * @param elf
+ * @param index Index of section in section header table.
+ * @param section Where decoded section will be stored.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+Bool elf_file_get_section (ElfFile* elf, Size index, ElfSection* section) {
+    RETURN_VALUE_IF (!elf || !section, False, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        index >= elf->section_count,
+        False,
+        "Section index %zu out of range (%zu sections).\n",
+        index,
+        elf->section_count
+    );
+    RETURN_VALUE_IF (
+        !elf_section_decode (elf, index, section),
+        False,
+        "Contents of section %zu lie outside file.\n",
+        index
+    );
+
+    return True;
+}
+
+/**
+ * @b Find a section by name. When more than one section has same name, first
+ * one in section header table is found.
+ *
+ * @param elf
+ * @param name Name of section.
+ * @param section Where decoded section will be stored.
+ *
+ * @return @c True if section is found.
+ * @return @c False otherwise.
+ * */
+Bool elf_file_find_section (ElfFile* elf, CString name, ElfSection* section) {
+    RETURN_VALUE_IF (!elf || !name || !section, False, ERR_INVALID_ARGUMENTS);
+
+    if (!elf->section_slot_count) {
+        return False;
+    }
+
+    Uint32 hash = elf_hash (name);
+    Size   mask = elf->section_slot_count - 1;
+    for (Size i = hash & mask; elf->section_slots[i].index; i = (i + 1) & mask) {
+        ElfSlot* slot = elf->section_slots + i;
+        if (slot->hash == hash && elf_section_decode (elf, slot->index - 1, section) &&
+            !strcmp (section->name, name)) {
+            return True;
+        }
+    }
+
+    return False;
+}
+
+/**
+ * @b Find a defined symbol by name, in static symbol table first and then in
+ * dynamic symbol table.
+ *
+ * @param elf
+ * @param name Name of symbol.
+ * @param symbol Where decoded symbol will be stored.
+ *
+ * @return @c True if symbol is found.
+ * @return @c False otherwise.
+ * */
+Bool elf_file_find_symbol (ElfFile* elf, CString name, ElfSymbol* symbol) {
+    RETURN_VALUE_IF (!elf || !name || !symbol, False, ERR_INVALID_ARGUMENTS);
+
+    return elf_symbol_table_find (elf, &elf->symtab, name, symbol) ||
+           elf_symbol_table_find (elf, &elf->dynsym, name, symbol);
+}
+
+/**
+ * @b Decode symbol at given index in a symbol table of file.
+ *
+ * @param elf
+ * @param table One of @c elf->symtab or @c elf->dynsym.
+ * @param index Index of symbol in table.
+ * @param symbol Where decoded symbol will be stored.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+Bool elf_symbol_table_get (ElfFile* elf, ElfSymbolTable* table, Size index, ElfSymbol* symbol) {
+    RETURN_VALUE_IF (!elf || !table || !symbol, False, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        !elf_symbol_decode (elf, table, index, symbol),
+        False,
+        "Symbol index %zu out of range (%zu symbols).\n",
+        index,
+        table->count
+    );
+
+    return True;
+}
+
+/**
+ * @b Find a defined symbol by name in given symbol table. When more than one
+ * symbol has same name, first one in table is found.
+ *
+ * @param elf
+ * @param table One of @c elf->symtab or @c elf->dynsym.
+ * @param name Name of symbol.
+ * @param symbol Where decoded symbol will be stored.
+ *
+ * @return @c True if symbol is found.
+ * @return @c False otherwise.
+ * */
+Bool elf_symbol_table_find (ElfFile* elf, ElfSymbolTable* table, CString name, ElfSymbol* symbol) {
+    RETURN_VALUE_IF (!elf || !table || !name || !symbol, False, ERR_INVALID_ARGUMENTS);
+
+    if (table->gnu_buckets) {
+        return elf_gnu_hash_lookup (elf, table, name, symbol);
+    }
+
+    if (!table->slot_count) {
+        return False;
+    }
+
+    Uint32    hash  = elf_hash (name);
+    Size      mask  = table->slot_count - 1;
+    Bool      found = False;
+    ElfSymbol candidate;
+    for (Size i = hash & mask; table->slots[i].index; i = (i + 1) & mask) {
+        ElfSlot* slot = table->slots + i;
+        if (slot->hash == hash && elf_symbol_decode (elf, table, slot->index - 1, &candidate) &&
+            !strcmp (candidate.name, name) &&
+            elf_symbol_pick (&candidate, symbol, &found)) {
+            return True;
+        }
+    }
+
+    return found;
+}
+
+/**************************************************************************************************/
+/******************************** PRIVATE METHOD DEFINITIONS **************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Read an unaligned integer of given size from file, in host byte order.
+ * */
+PRIVATE Uint64 elf_read (ElfFile* elf, const Uint8* ptr, Size size) {
+    switch (size) {
+        case 1 : {
+            return *ptr;
+        }
+        case 2 : {
+            Uint16 v;
+            memcpy (&v, ptr, 2);
+            return elf->swap ? __builtin_bswap16 (v) : v;
+        }
+        case 4 : {
+            Uint32 v;
+            memcpy (&v, ptr, 4);
+            return elf->swap ? __builtin_bswap32 (v) : v;
+        }
+        case 8 : {
+            Uint64 v;
+            memcpy (&v, ptr, 8);
+            return elf->swap ? __builtin_bswap64 (v) : v;
+        }
+        default :
+            RETURN_VALUE_IF_REACHED (0, "Invalid field size %zu\n", size);
+    }
+}
+
+/**
+ * @b String at given offset in a string table already checked to be terminated.
+ *
+ * @return String if offset is in table.
+ * @return Empty string otherwise.
+ * */
+PRIVATE CString elf_string (const Char* strings, Size strings_size, Uint64 off) {
+    return off < strings_size ? strings + off : "";
+}
+
+/**
+ * @b FNV-1a hash of a name, for by-name indexes.
+ * */
+PRIVATE Uint32 elf_hash (CString name) {
+    Uint64 hash = 0xcbf29ce484222325;
+    for (CString c = name; *c; c++) {
+        hash = (hash ^ (Uint8)*c) * 0x100000001b3;
+    }
+    return hash ^ (hash >> 32);
+}
+
+/**
+ * @b Create an empty index for given number of entries, with atleast half the
+ * slots always empty so probes stay short.
+ *
+ * @param count Maximum number of entries.
+ * @param slot_count Where number of created slots will be stored.
+ *
+ * @return Slots on success.
+ * @return @c Null otherwise.
+ * */
+PRIVATE ElfSlot* elf_slots_create (Size count, Size* slot_count) {
+    Size capacity = 16;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+
+    ElfSlot* slots = ALLOCATE (ElfSlot, capacity);
+    RETURN_VALUE_IF (!slots, Null, ERR_OUT_OF_MEMORY);
+
+    *slot_count = capacity;
+    return slots;
+}
+
+/**
+ * @b Insert an entry in index. Entries with same hash are found in the order
+ * they're inserted in.
+ * */
+PRIVATE void elf_slots_insert (ElfSlot* slots, Size slot_count, Uint32 hash, Size index) {
+    Size i = hash & (slot_count - 1);
+    while (slots[i].index) {
+        i = (i + 1) & (slot_count - 1);
+    }
+
+    slots[i].hash  = hash;
+    slots[i].index = index + 1;
+}
+
+/**
+ * @b Decode section header at given index, without reporting errors.
+ *
+ * @return @c True on success.
+ * @return @c False if index is out of range or contents lie outside file.
+ * */
+PRIVATE Bool elf_section_decode (ElfFile* elf, Size index, ElfSection* section) {
+    if (index >= elf->section_count) {
+        return False;
+    }
+
+    const Uint8* shdr = elf->sections + index * elf->section_entsize;
+
+    section->index   = index;
+    section->name    = elf_string (
+        elf->section_names,
+        elf->section_names_size,
+        ELF_GET (elf, shdr, Shdr, sh_name)
+    );
+    section->type    = ELF_GET (elf, shdr, Shdr, sh_type);
+    section->flags   = ELF_GET (elf, shdr, Shdr, sh_flags);
+    section->addr    = ELF_GET (elf, shdr, Shdr, sh_addr);
+    section->offset  = ELF_GET (elf, shdr, Shdr, sh_offset);
+    section->size    = ELF_GET (elf, shdr, Shdr, sh_size);
+    section->link    = ELF_GET (elf, shdr, Shdr, sh_link);
+    section->info    = ELF_GET (elf, shdr, Shdr, sh_info);
+    section->entsize = ELF_GET (elf, shdr, Shdr, sh_entsize);
+    section->data    = Null;
+
+    if (section->type != SHT_NOBITS && section->size) {
+        if (section->offset > elf->size || section->size > elf->size - section->offset) {
+            return False;
+        }
+        section->data = elf->data + section->offset;
+    }
+
+    return True;
+}
+
+/**
+ * @b Build index of sections by name.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool elf_section_index (ElfFile* elf) {
+    if (!elf->section_names) {
+        return True;
+    }
+
+    elf->section_slots = elf_slots_create (elf->section_count, &elf->section_slot_count);
+    RETURN_VALUE_IF (!elf->section_slots, False, ERR_OUT_OF_MEMORY);
+
+    for (Size s = 1; s < elf->section_count; s++) {
+        const Uint8* shdr = elf->sections + s * elf->section_entsize;
+        CString      name = elf_string (
+            elf->section_names,
+            elf->section_names_size,
+            ELF_GET (elf, shdr, Shdr, sh_name)
+        );
+
+        if (*name) {
+            elf_slots_insert (elf->section_slots, elf->section_slot_count, elf_hash (name), s);
+        }
+    }
+
+    return True;
+}
+
+/**
+ * @b Decode symbol at given index in table, without reporting errors.
+ *
+ * @return @c True on success.
+ * @return @c False if index is out of range.
+ * */
+PRIVATE Bool elf_symbol_decode (ElfFile* elf, ElfSymbolTable* table, Size index, ElfSymbol* sym) {
+    if (index >= table->count) {
+        return False;
+    }
+
+    const Uint8* entry = table->symbols + index * table->entsize;
+    Uint64       name  = ELF_GET (elf, entry, Sym, st_name);
+    Uint8        info  = ELF_GET (elf, entry, Sym, st_info);
+
+    sym->index = index;
+    sym->name  = elf_string (table->strings, table->strings_size, name);
+    sym->value = ELF_GET (elf, entry, Sym, st_value);
+    sym->size  = ELF_GET (elf, entry, Sym, st_size);
+    sym->type  = ELF64_ST_TYPE (info);
+    sym->bind  = ELF64_ST_BIND (info);
+    sym->other = ELF_GET (elf, entry, Sym, st_other);
+    sym->shndx = ELF_GET (elf, entry, Sym, st_shndx);
+
+    sym->version = VER_NDX_GLOBAL;
+    if (table->versions) {
+        sym->version = elf_read (elf, table->versions + index * sizeof (Uint16), sizeof (Uint16));
+    }
+
+    return True;
+}
+
+/**
+ * @b Keep a symbol matching name being looked up. First match is kept until a
+ * default version of symbol is seen.
+ *
+ * @param candidate Symbol with matching name.
+ * @param symbol Where kept symbol is stored.
+ * @param found Set once a symbol is kept.
+ *
+ * @return @c True if candidate is default version, and lookup can stop.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool elf_symbol_pick (ElfSymbol* candidate, ElfSymbol* symbol, Bool* found) {
+    Bool is_default = !(candidate->version & ELF_VERSYM_HIDDEN);
+
+    if (is_default || !*found) {
+        *symbol = *candidate;
+        *found  = True;
+    }
+
+    return is_default;
+}
+
+/**
+ * @b Set up view of symbol table in given section, and index it's defined
+ * symbols by name. Malformed tables are reported and left empty, so the rest
+ * of file can still be used.
+ *
+ * @param elf
+ * @param table Symbol table to initialize.
+ * @param section_index Index of symbol table section, 0 if file has no such table.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool elf_symbol_table_init (ElfFile* elf, ElfSymbolTable* table, Size section_index) {
+    ElfSection section, strings;
+    Size       min_entsize = elf->is_64 ? sizeof (Elf64_Sym) : sizeof (Elf32_Sym);
+
+    if (!section_index || !elf_section_decode (elf, section_index, &section) || !section.data) {
+        return True;
+    }
+
+    if (!elf_section_decode (elf, section.link, &strings) || !strings.data ||
+        strings.data[strings.size - 1]) {
+        PRINT_ERR ("String table of symbol table \"%s\" is malformed. Ignoring.\n", section.name);
+        return True;
+    }
+
+    if (section.entsize && section.entsize < min_entsize) {
+        PRINT_ERR ("Entry size of symbol table \"%s\" is too small. Ignoring.\n", section.name);
+        return True;
+    }
+
+    table->section      = section_index;
+    table->symbols      = section.data;
+    table->entsize      = section.entsize ? section.entsize : min_entsize;
+    table->count        = section.size / table->entsize;
+    table->strings      = (const Char*)strings.data;
+    table->strings_size = strings.size;
+
+    /* version of each symbol is in a separate table linked to symbol table */
+    for (Size s = 1; s < elf->section_count; s++) {
+        ElfSection versions;
+        if (elf_section_decode (elf, s, &versions) && versions.type == SHT_GNU_versym &&
+            versions.link == section_index && versions.data &&
+            versions.size / sizeof (Uint16) >= table->count) {
+            table->versions = versions.data;
+            break;
+        }
+    }
+
+    /* loader's own hash table makes an index of our own unnecessary */
+    const Uint8* gnu_hash      = Null;
+    Size         gnu_hash_size = 0;
+    if (section.type == SHT_DYNSYM && elf_gnu_hash_find (elf, &gnu_hash, &gnu_hash_size) &&
+        elf_gnu_hash_init (elf, table, gnu_hash, gnu_hash_size)) {
+        return True;
+    }
+
+    table->slots = elf_slots_create (table->count, &table->slot_count);
+    RETURN_VALUE_IF (!table->slots, False, ERR_OUT_OF_MEMORY);
+
+    ElfSymbol symbol;
+    for (Size s = 1; s < table->count; s++) {
+        elf_symbol_decode (elf, table, s, &symbol);
+        if (symbol.shndx != SHN_UNDEF && *symbol.name) {
+            elf_slots_insert (table->slots, table->slot_count, elf_hash (symbol.name), s);
+        }
+    }
+
+    return True;
+}
+
+/**
+ * @b Release index of a symbol table.
+ * */
+PRIVATE void elf_symbol_table_deinit (ElfSymbolTable* table) {
+    if (table->slots) {
+        FREE (table->slots);
+    }
+
+    memset (table, 0, sizeof (ElfSymbolTable));
+}
+
+/**
+ * @b Find GNU hash table of dynamic symbols. Table named by DT_GNU_HASH entry
+ * of dynamic section is preferred, a section of SHT_GNU_HASH type is used
+ * otherwise.
+ *
+ * @param elf
+ * @param data Where start of table will be stored.
+ * @param size Where maximum size of table will be stored.
+ *
+ * @return @c True if table is found.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool elf_gnu_hash_find (ElfFile* elf, const Uint8** data, Size* size) {
+    ElfSection section;
+    Size       dyn_size  = elf->is_64 ? sizeof (Elf64_Dyn) : sizeof (Elf32_Dyn);
+    Uint64     gnu_addr  = 0;
+    Size       gnu_index = 0;
+
+    for (Size s = 1; s < elf->section_count; s++) {
+        if (!elf_section_decode (elf, s, &section) || !section.data) {
+            continue;
+        }
+
+        if (section.type == SHT_GNU_HASH && !gnu_index) {
+            gnu_index = s;
+        }
+
+        if (section.type == SHT_DYNAMIC && !gnu_addr) {
+            for (Size off = 0; off + dyn_size <= section.size; off += dyn_size) {
+                Uint64 tag = ELF_GET (elf, section.data + off, Dyn, d_tag);
+                if (tag == DT_NULL) {
+                    break;
+                }
+                if (tag == DT_GNU_HASH) {
+                    gnu_addr = ELF_GET (elf, section.data + off, Dyn, d_un.d_ptr);
+                    break;
+                }
+            }
+        }
+    }
+
+    /* map address of table to it's place in file */
+    for (Size s = 1; gnu_addr && s < elf->section_count; s++) {
+        if (elf_section_decode (elf, s, &section) && section.data && (section.flags & SHF_ALLOC) &&
+            section.addr <= gnu_addr && gnu_addr - section.addr < section.size) {
+            *data = section.data + (gnu_addr - section.addr);
+            *size = section.size - (gnu_addr - section.addr);
+            return True;
+        }
+    }
+
+    if (gnu_index && elf_section_decode (elf, gnu_index, &section)) {
+        *data = section.data;
+        *size = section.size;
+        return True;
+    }
+
+    return False;
+}
+
+/**
+ * @b Use given GNU hash table for lookups in a dynamic symbol table, after
+ * checking that the whole table lies within @p size bytes.
+ *
+ * @return @c True if table is usable.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool elf_gnu_hash_init (ElfFile* elf, ElfSymbolTable* table, const Uint8* data, Size size) {
+    if (size < 4 * sizeof (Uint32)) {
+        return False;
+    }
+
+    Uint64 bucket_count = elf_read (elf, data, 4);
+    Uint64 symoffset    = elf_read (elf, data + 4, 4);
+    Uint64 bloom_size   = elf_read (elf, data + 8, 4);
+    Uint64 bloom_shift  = elf_read (elf, data + 12, 4);
+    Uint64 word_size    = elf->is_64 ? 8 : 4;
+
+    if (!bucket_count || !bloom_size || bloom_shift >= 32 || symoffset > table->count) {
+        PRINT_ERR ("GNU hash table is malformed. Indexing symbols instead.\n");
+        return False;
+    }
+
+    /* every symbol after symoffset has a chain entry */
+    Uint64 needed = 4 * sizeof (Uint32) + bloom_size * word_size + bucket_count * sizeof (Uint32) +
+                    (table->count - symoffset) * sizeof (Uint32);
+    if (needed > size) {
+        PRINT_ERR ("GNU hash table lies outside it's section. Indexing symbols instead.\n");
+        return False;
+    }
+
+    table->gnu_bloom        = data + 4 * sizeof (Uint32);
+    table->gnu_buckets      = table->gnu_bloom + bloom_size * word_size;
+    table->gnu_chains       = table->gnu_buckets + bucket_count * sizeof (Uint32);
+    table->gnu_bucket_count = bucket_count;
+    table->gnu_symoffset    = symoffset;
+    table->gnu_bloom_size   = bloom_size;
+    table->gnu_bloom_shift  = bloom_shift;
+
+    return True;
+}
+
+/**
+ * @b Find a defined symbol by name using GNU hash table of symbol table.
+ *
+ * Bloom filter rejects most of the absent names without touching buckets, and
+ * chains keep hash values so names are compared only on probable matches.
+ * */
+PRIVATE Bool elf_gnu_hash_lookup (
+    ElfFile*        elf,
+    ElfSymbolTable* table,
+    CString         name,
+    ElfSymbol*      symbol
+) {
+    Uint32 hash = 5381;
+    for (CString c = name; *c; c++) {
+        hash = hash * 33 + (Uint8)*c;
+    }
+
+    Size   bits = elf->is_64 ? 64 : 32;
+    Uint64 word = elf_read (
+        elf,
+        table->gnu_bloom + (hash / bits % table->gnu_bloom_size) * (bits / 8),
+        bits / 8
+    );
+    Uint64 mask = (1ull << (hash % bits)) | (1ull << ((hash >> table->gnu_bloom_shift) % bits));
+    if ((word & mask) != mask) {
+        return False;
+    }
+
+    Size index = elf_read (elf, table->gnu_buckets + (hash % table->gnu_bucket_count) * 4, 4);
+    if (index < table->gnu_symoffset) {
+        return False;
+    }
+
+    /* last entry of a chain has lowest bit set */
+    Bool      found = False;
+    ElfSymbol candidate;
+    for (; index < table->count; index++) {
+        Uint32 chain = elf_read (elf, table->gnu_chains + (index - table->gnu_symoffset) * 4, 4);
+        if ((chain | 1) == (hash | 1) && elf_symbol_decode (elf, table, index, &candidate) &&
+            candidate.shndx != SHN_UNDEF && !strcmp (candidate.name, name) &&
+            elf_symbol_pick (&candidate, symbol, &found)) {
+            return True;
+        }
+        if (chain & 1) {
+            break;
+        }
+    }
+
+    return found;
+}
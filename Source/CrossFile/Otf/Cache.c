@@ -0,0 +1,526 @@
+/**
+ * @file Cache.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Otf/Cache.h>
+#include <Anvie/CrossFile/Otf/Otf.h>
+
+/* libc */
+#include <errno.h>
+#include <memory.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+typedef enum FontCacheEntryState : Uint8 {
+    FONT_CACHE_ENTRY_STATE_LOADING = 0,
+    FONT_CACHE_ENTRY_STATE_READY,
+    FONT_CACHE_ENTRY_STATE_FAILED,
+} FontCacheEntryState;
+
+typedef struct FontCacheKey {
+    Uint64 device;
+    Uint64 inode;
+    Int64  mtime_sec;
+    Int64  mtime_nsec;
+} FontCacheKey;
+
+typedef struct FontCacheEntry {
+    FontCacheKey        key;
+    FontCacheEntryState state;
+    OtfSharedFile*      shared;       /**< @b Cache's own reference, valid once ready. */
+    Size                decoded_size;
+    Size                waiter_count; /**< @b Threads waiting for this entry to be loaded. */
+
+    struct FontCacheEntry* hash_next;
+    struct FontCacheEntry* lru_prev; /**< @b Towards most recently used. */
+    struct FontCacheEntry* lru_next; /**< @b Towards least recently used. */
+} FontCacheEntry;
+
+struct OtfFontCache {
+    pthread_mutex_t lock;
+    pthread_cond_t  load_done; /**< @b Signalled whenever an entry finishes loading. */
+
+    FontCacheEntry** buckets;
+    Size             bucket_count; /**< @b Always a power of two. */
+    Size             entry_count;
+
+    FontCacheEntry* lru_head; /**< @b Most recently used ready entry. */
+    FontCacheEntry* lru_tail; /**< @b Least recently used ready entry. */
+
+    Size byte_budget;
+    Size decoded_bytes;
+
+    Size hits;
+    Size misses;
+    Size coalesced;
+    Size evictions;
+};
+
+#define FONT_CACHE_INITIAL_BUCKET_COUNT 64
+
+/* private method declarations */
+
+static inline Size            font_cache_key_hash (FontCacheKey* key);
+static inline FontCacheEntry* font_cache_find (OtfFontCache* cache, FontCacheKey* key);
+static inline FontCacheEntry* font_cache_insert (OtfFontCache* cache, FontCacheEntry* entry);
+static inline FontCacheEntry* font_cache_remove (OtfFontCache* cache, FontCacheEntry* entry);
+static inline OtfFontCache*   font_cache_grow (OtfFontCache* cache);
+static inline FontCacheEntry* lru_push_front (OtfFontCache* cache, FontCacheEntry* entry);
+static inline FontCacheEntry* lru_unlink (OtfFontCache* cache, FontCacheEntry* entry);
+static inline OtfFontCache*   font_cache_evict (OtfFontCache* cache, FontCacheEntry* keep);
+static inline void            font_cache_entry_destroy (FontCacheEntry* entry);
+static inline void            global_cache_create();
+static inline void            global_cache_destroy();
+
+static OtfFontCache*  global_cache      = Null;
+static pthread_once_t global_cache_once = PTHREAD_ONCE_INIT;
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Create a new font cache.
+ *
+ * @param byte_budget Maximum estimated decoded size of all cached fonts.
+ *
+ * @return New font cache on success.
+ * @return @c Null otherwise.
+ * */
+OtfFontCache* otf_font_cache_create (Size byte_budget) {
+    OtfFontCache* cache = NEW (OtfFontCache);
+    RETURN_VALUE_IF (!cache, Null, ERR_OUT_OF_MEMORY);
+
+    if (!(cache->buckets = ALLOCATE (FontCacheEntry*, FONT_CACHE_INITIAL_BUCKET_COUNT))) {
+        PRINT_ERR (ERR_OUT_OF_MEMORY);
+        FREE (cache);
+        return Null;
+    }
+
+    cache->bucket_count = FONT_CACHE_INITIAL_BUCKET_COUNT;
+    cache->byte_budget  = byte_budget;
+
+    pthread_mutex_init (&cache->lock, Null);
+    pthread_cond_init (&cache->load_done, Null);
+
+    return cache;
+}
+
+/**
+ * @b Destroy given font cache, dropping cache's reference to every font in it.
+ * Must not be called while any thread is still using the cache.
+ *
+ * @param cache
+ * */
+void otf_font_cache_destroy (OtfFontCache* cache) {
+    RETURN_IF (!cache, ERR_INVALID_ARGUMENTS);
+
+    for (Size b = 0; b < cache->bucket_count; b++) {
+        FontCacheEntry* entry = cache->buckets[b];
+        while (entry) {
+            FontCacheEntry* next = entry->hash_next;
+            font_cache_entry_destroy (entry);
+            entry = next;
+        }
+    }
+
+    pthread_cond_destroy (&cache->load_done);
+    pthread_mutex_destroy (&cache->lock);
+
+    FREE (cache->buckets);
+    FREE (cache);
+}
+
+/**
+ * @b Open given font file through cache.
+ *
+ * @param cache
+ * @param filename Path of font file.
+ *
+ * @return New reference to shared font on success. Must be released with
+ *         @c otf_shared_file_unref by caller.
+ * @return @c Null otherwise.
+ * */
+OtfSharedFile* otf_font_cache_open (OtfFontCache* cache, CString filename) {
+    RETURN_VALUE_IF (!cache || !filename, Null, ERR_INVALID_ARGUMENTS);
+
+    struct stat font_stat;
+    RETURN_VALUE_IF (
+        stat (filename, &font_stat) != 0,
+        Null,
+        "Failed to stat font file \"%s\" : %s\n",
+        filename,
+        strerror (errno)
+    );
+
+    FontCacheKey key = {
+        .device     = font_stat.st_dev,
+        .inode      = font_stat.st_ino,
+        .mtime_sec  = font_stat.st_mtim.tv_sec,
+        .mtime_nsec = font_stat.st_mtim.tv_nsec,
+    };
+
+    pthread_mutex_lock (&cache->lock);
+
+    FontCacheEntry* entry = font_cache_find (cache, &key);
+    if (entry) {
+        /* somebody else is decoding this font, wait for it instead of decoding again */
+        if (entry->state == FONT_CACHE_ENTRY_STATE_LOADING) {
+            cache->coalesced++;
+            entry->waiter_count++;
+
+            while (entry->state == FONT_CACHE_ENTRY_STATE_LOADING) {
+                pthread_cond_wait (&cache->load_done, &cache->lock);
+            }
+
+            entry->waiter_count--;
+
+            /* failed entries are already out of cache, last one to leave frees it */
+            if (entry->state == FONT_CACHE_ENTRY_STATE_FAILED) {
+                if (!entry->waiter_count) {
+                    font_cache_entry_destroy (entry);
+                }
+                pthread_mutex_unlock (&cache->lock);
+                return Null;
+            }
+        } else {
+            cache->hits++;
+        }
+
+        lru_unlink (cache, entry);
+        lru_push_front (cache, entry);
+
+        OtfSharedFile* shared = otf_shared_file_ref (entry->shared);
+        pthread_mutex_unlock (&cache->lock);
+        return shared;
+    }
+
+    cache->misses++;
+
+    /* insert a placeholder so that concurrent opens of same font wait on it */
+    entry = NEW (FontCacheEntry);
+    if (entry) {
+        entry->key   = key;
+        entry->state = FONT_CACHE_ENTRY_STATE_LOADING;
+    }
+
+    if (!entry || !font_cache_insert (cache, entry)) {
+        pthread_mutex_unlock (&cache->lock);
+        if (entry) {
+            FREE (entry);
+        }
+        RETURN_VALUE_IF_REACHED (Null, ERR_OUT_OF_MEMORY);
+    }
+
+    pthread_mutex_unlock (&cache->lock);
+
+    /* decode without holding the lock */
+    OtfSharedFile* shared = otf_shared_file_open (filename);
+
+    pthread_mutex_lock (&cache->lock);
+
+    if (!shared) {
+        font_cache_remove (cache, entry);
+        entry->state = FONT_CACHE_ENTRY_STATE_FAILED;
+        pthread_cond_broadcast (&cache->load_done);
+
+        if (!entry->waiter_count) {
+            font_cache_entry_destroy (entry);
+        }
+
+        pthread_mutex_unlock (&cache->lock);
+        RETURN_VALUE_IF_REACHED (Null, "Failed to open font file \"%s\"\n", filename);
+    }
+
+    entry->shared        = shared;
+    entry->decoded_size  = otf_file_get_decoded_size ((OtfFile*)otf_shared_file_get_file (shared));
+    entry->state         = FONT_CACHE_ENTRY_STATE_READY;
+    cache->decoded_bytes += entry->decoded_size;
+
+    lru_push_front (cache, entry);
+    font_cache_evict (cache, entry);
+    pthread_cond_broadcast (&cache->load_done);
+
+    shared = otf_shared_file_ref (entry->shared);
+    pthread_mutex_unlock (&cache->lock);
+
+    return shared;
+}
+
+/**
+ * @b Change byte budget of given cache, evicting fonts if required.
+ *
+ * @param cache
+ * @param byte_budget New byte budget.
+ *
+ * @return @c cache on success.
+ * @return @c Null otherwise.
+ * */
+OtfFontCache* otf_font_cache_set_budget (OtfFontCache* cache, Size byte_budget) {
+    RETURN_VALUE_IF (!cache, Null, ERR_INVALID_ARGUMENTS);
+
+    pthread_mutex_lock (&cache->lock);
+    cache->byte_budget = byte_budget;
+    font_cache_evict (cache, Null);
+    pthread_mutex_unlock (&cache->lock);
+
+    return cache;
+}
+
+/**
+ * @b Get a consistent snapshot of cache counters.
+ *
+ * @param cache
+ * @param stats Will be filled with counters.
+ *
+ * @return @c stats on success.
+ * @return @c Null otherwise.
+ * */
+OtfFontCacheStats* otf_font_cache_get_stats (OtfFontCache* cache, OtfFontCacheStats* stats) {
+    RETURN_VALUE_IF (!cache || !stats, Null, ERR_INVALID_ARGUMENTS);
+
+    pthread_mutex_lock (&cache->lock);
+    *stats = (OtfFontCacheStats) {
+        .hits          = cache->hits,
+        .misses        = cache->misses,
+        .coalesced     = cache->coalesced,
+        .evictions     = cache->evictions,
+        .entry_count   = cache->entry_count,
+        .decoded_bytes = cache->decoded_bytes,
+        .byte_budget   = cache->byte_budget,
+    };
+    pthread_mutex_unlock (&cache->lock);
+
+    return stats;
+}
+
+/**
+ * @b Get process wide font cache. Created on first use with
+ * @c OTF_FONT_CACHE_DEFAULT_BUDGET byte budget and destroyed at exit.
+ *
+ * @return Process wide font cache on success.
+ * @return @c Null otherwise.
+ * */
+OtfFontCache* otf_font_cache_get_global() {
+    RETURN_VALUE_IF (
+        pthread_once (&global_cache_once, global_cache_create) != 0 || !global_cache,
+        Null,
+        "Failed to create global font cache\n"
+    );
+
+    return global_cache;
+}
+
+/**
+ * @b Open given font file through process wide font cache.
+ *
+ * @param filename Path of font file.
+ *
+ * @return New reference to shared font on success.
+ * @return @c Null otherwise.
+ * */
+OtfSharedFile* otf_file_open_cached (CString filename) {
+    RETURN_VALUE_IF (!filename, Null, ERR_INVALID_ARGUMENTS);
+
+    OtfFontCache* cache = otf_font_cache_get_global();
+    RETURN_VALUE_IF (!cache, Null, "Global font cache not available\n");
+
+    return otf_font_cache_open (cache, filename);
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+static inline Size font_cache_key_hash (FontCacheKey* key) {
+    Uint64 hash = key->inode * 0x9e3779b97f4a7c15ull;
+    hash       ^= key->device + 0x7f4a7c15ull + (hash << 6) + (hash >> 2);
+    hash       ^= (Uint64)key->mtime_sec + (Uint64)key->mtime_nsec + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+static inline FontCacheEntry* font_cache_find (OtfFontCache* cache, FontCacheKey* key) {
+    Size            bucket = font_cache_key_hash (key) & (cache->bucket_count - 1);
+    FontCacheEntry* entry  = cache->buckets[bucket];
+
+    while (entry && memcmp (&entry->key, key, sizeof (FontCacheKey))) {
+        entry = entry->hash_next;
+    }
+
+    return entry;
+}
+
+/**
+ * @b Insert given entry in hash table. Entry key must be set before calling this.
+ * */
+static inline FontCacheEntry* font_cache_insert (OtfFontCache* cache, FontCacheEntry* entry) {
+    if (cache->entry_count >= cache->bucket_count * 2) {
+        RETURN_VALUE_IF (!font_cache_grow (cache), Null, "Failed to grow font cache\n");
+    }
+
+    Size bucket            = font_cache_key_hash (&entry->key) & (cache->bucket_count - 1);
+    entry->hash_next       = cache->buckets[bucket];
+    cache->buckets[bucket] = entry;
+    cache->entry_count++;
+
+    return entry;
+}
+
+/**
+ * @b Remove given entry from hash table and LRU list without destroying it.
+ * */
+static inline FontCacheEntry* font_cache_remove (OtfFontCache* cache, FontCacheEntry* entry) {
+    Size             bucket = font_cache_key_hash (&entry->key) & (cache->bucket_count - 1);
+    FontCacheEntry** link   = cache->buckets + bucket;
+
+    while (*link && *link != entry) {
+        link = &(*link)->hash_next;
+    }
+
+    if (*link) {
+        *link            = entry->hash_next;
+        entry->hash_next = Null;
+        cache->entry_count--;
+    }
+
+    if (entry->state == FONT_CACHE_ENTRY_STATE_READY) {
+        lru_unlink (cache, entry);
+        cache->decoded_bytes -= entry->decoded_size;
+    }
+
+    return entry;
+}
+
+static inline OtfFontCache* font_cache_grow (OtfFontCache* cache) {
+    Size             bucket_count = cache->bucket_count * 2;
+    FontCacheEntry** buckets      = ALLOCATE (FontCacheEntry*, bucket_count);
+    RETURN_VALUE_IF (!buckets, Null, ERR_OUT_OF_MEMORY);
+
+    for (Size b = 0; b < cache->bucket_count; b++) {
+        FontCacheEntry* entry = cache->buckets[b];
+        while (entry) {
+            FontCacheEntry* next = entry->hash_next;
+            Size bucket          = font_cache_key_hash (&entry->key) & (bucket_count - 1);
+            entry->hash_next     = buckets[bucket];
+            buckets[bucket]      = entry;
+            entry                = next;
+        }
+    }
+
+    FREE (cache->buckets);
+    cache->buckets      = buckets;
+    cache->bucket_count = bucket_count;
+
+    return cache;
+}
+
+static inline FontCacheEntry* lru_push_front (OtfFontCache* cache, FontCacheEntry* entry) {
+    entry->lru_prev = Null;
+    entry->lru_next = cache->lru_head;
+
+    if (cache->lru_head) {
+        cache->lru_head->lru_prev = entry;
+    } else {
+        cache->lru_tail = entry;
+    }
+
+    cache->lru_head = entry;
+    return entry;
+}
+
+static inline FontCacheEntry* lru_unlink (OtfFontCache* cache, FontCacheEntry* entry) {
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else if (cache->lru_head == entry) {
+        cache->lru_head = entry->lru_next;
+    }
+
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else if (cache->lru_tail == entry) {
+        cache->lru_tail = entry->lru_prev;
+    }
+
+    entry->lru_prev = entry->lru_next = Null;
+    return entry;
+}
+
+/**
+ * @b Evict least recently used fonts till cache is within budget.
+ *
+ * Entries that threads are still waiting on are never evicted, since those
+ * threads still need to take a reference from them. @c keep is the entry just
+ * loaded for the caller, it's kept even if it alone exceeds the budget.
+ * */
+static inline OtfFontCache* font_cache_evict (OtfFontCache* cache, FontCacheEntry* keep) {
+    FontCacheEntry* entry = cache->lru_tail;
+
+    while (entry && cache->decoded_bytes > cache->byte_budget) {
+        FontCacheEntry* prev = entry->lru_prev;
+
+        if (entry != keep && !entry->waiter_count) {
+            font_cache_remove (cache, entry);
+            font_cache_entry_destroy (entry);
+            cache->evictions++;
+        }
+
+        entry = prev;
+    }
+
+    return cache;
+}
+
+/**
+ * @b Drop cache's reference to font and free entry. Entry must already be out of cache.
+ * */
+static inline void font_cache_entry_destroy (FontCacheEntry* entry) {
+    if (entry->shared) {
+        otf_shared_file_unref (entry->shared);
+    }
+
+    FREE (entry);
+}
+
+static inline void global_cache_create() {
+    global_cache = otf_font_cache_create (OTF_FONT_CACHE_DEFAULT_BUDGET);
+    if (global_cache) {
+        atexit (global_cache_destroy);
+    }
+}
+
+static inline void global_cache_destroy() {
+    otf_font_cache_destroy (global_cache);
+    global_cache = Null;
+}
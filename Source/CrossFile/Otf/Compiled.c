@@ -0,0 +1,942 @@
+/**
+ * @file Compiled.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/EndiannessHelpers.h>
+#include <Anvie/CrossFile/Otf/Compiled.h>
+#include <Anvie/CrossFile/Otf/Otf.h>
+
+/* libc */
+#include <errno.h>
+#include <fcntl.h>
+#include <memory.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @b Growable array of cmap groups used while compiling cmap.
+ * */
+typedef struct CmapBuilder {
+    OtfCompiledCmapGroup* groups;
+    Size                  count;
+    Size                  capacity;
+} CmapBuilder;
+
+/* private method declarations */
+
+static inline Uint32*      table_dir_checksum (CString font_path, Uint32* checksum);
+static inline CmapBuilder* cmap_builder_build (CmapBuilder* builder, OtfCmap* cmap);
+static inline CmapBuilder* cmap_builder_add_range (
+    CmapBuilder* builder,
+    Uint32       start_char_code,
+    Uint32       end_char_code,
+    Uint32       start_glyph_id
+);
+static inline CmapBuilder* cmap_builder_deinit (CmapBuilder* builder);
+static inline Int32        cmap_subtable_score (OtfCmapEncodingRecord* record);
+static inline int          cmap_group_compare (const void* a, const void* b);
+static inline FILE*        write_section (
+    FILE*               file,
+    Size*               written,
+    OtfCompiledSection* section,
+    const void*         data,
+    Size                elem_size
+);
+static inline Bool
+    section_is_valid (OtfCompiled* compiled, const OtfCompiledSection* section, Size elem_size);
+static inline Bool name_records_are_valid (OtfCompiled* compiled);
+
+#define ALIGN_SECTION(x)                                                                           \
+    (((x) + OTF_COMPILED_SECTION_ALIGNMENT - 1) & ~(Size)(OTF_COMPILED_SECTION_ALIGNMENT - 1))
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Compile given cmap into sorted array of groups, each mapping a range of
+ * consecutive char codes to consecutive glyph ids. Best unicode subtable in
+ * cmap is used.
+ *
+ * @param cmap Decoded cmap table.
+ * @param count Will contain number of groups in returned array.
+ *
+ * @return Newly allocated array of groups on success. Must be freed by caller.
+ * @return @c Null otherwise, or when cmap does not map any character.
+ * */
+OtfCompiledCmapGroup* otf_compiled_cmap_groups_create (OtfCmap* cmap, Size* count) {
+    RETURN_VALUE_IF (!cmap || !count, Null, ERR_INVALID_ARGUMENTS);
+
+    *count = 0;
+
+    CmapBuilder builder = {0};
+    if (!cmap_builder_build (&builder, cmap)) {
+        PRINT_ERR ("Failed to compile character to glyph index map\n");
+        cmap_builder_deinit (&builder);
+        return Null;
+    }
+
+    *count = builder.count;
+    return builder.groups;
+}
+
+/**
+ * @b Binary search given char code in sorted array of cmap groups.
+ *
+ * @param groups Array of groups sorted by start char code.
+ * @param count Number of groups.
+ * @param char_code Character code to be searched.
+ *
+ * @return Glyph id on success.
+ * @return @c 0 (missing glyph) if character is not mapped.
+ * */
+Uint32 otf_compiled_cmap_groups_find (
+    const OtfCompiledCmapGroup* groups,
+    Size                        count,
+    Uint32                      char_code
+) {
+    Size low  = 0;
+    Size high = groups ? count : 0;
+
+    while (low < high) {
+        Size mid = low + (high - low) / 2;
+        if (char_code < groups[mid].start_char_code) {
+            high = mid;
+        } else if (char_code > groups[mid].end_char_code) {
+            low = mid + 1;
+        } else {
+            return groups[mid].start_glyph_id + (char_code - groups[mid].start_char_code);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @b Dump given decoded font to a compiled font file.
+ *
+ * File is first written to a temporary path and then renamed, so that other
+ * processes never see a partially written compiled font.
+ *
+ * @param otf_file Decoded font to be compiled.
+ * @param font_path Path of font file @c otf_file was loaded from. Used for validation data.
+ * @param compiled_path Path of compiled font file to be created.
+ *
+ * @return @c otf_file on success.
+ * @return @c Null otherwise.
+ * */
+OtfFile* otf_compiled_write (OtfFile* otf_file, CString font_path, CString compiled_path) {
+    RETURN_VALUE_IF (!otf_file || !font_path || !compiled_path, Null, ERR_INVALID_ARGUMENTS);
+
+    struct stat font_stat;
+    RETURN_VALUE_IF (
+        stat (font_path, &font_stat) != 0,
+        Null,
+        "Failed to stat source font file : %s\n",
+        strerror (errno)
+    );
+
+    OtfCompiledHeader header = {
+        .magic             = OTF_COMPILED_MAGIC,
+        .version           = OTF_COMPILED_VERSION,
+        .header_size       = sizeof (OtfCompiledHeader),
+        .byte_order_mark   = OTF_COMPILED_BYTE_ORDER_MARK,
+        .source_size       = font_stat.st_size,
+        .source_mtime_sec  = font_stat.st_mtim.tv_sec,
+        .source_mtime_nsec = font_stat.st_mtim.tv_nsec,
+        .sfnt_version      = otf_file->table_directory.sfnt_version,
+        .num_glyphs        = otf_file->maxp.num_glyphs,
+        .units_per_em      = otf_file->head.units_per_em,
+    };
+
+    RETURN_VALUE_IF (
+        !table_dir_checksum (font_path, &header.source_checksum),
+        Null,
+        "Failed to compute checksum of source font file\n"
+    );
+
+    CmapBuilder            cmap         = {0};
+    OtfCompiledMetric*     h_metrics    = Null;
+    OtfCompiledNameRecord* name_records = Null;
+    FILE*                  file         = Null;
+    Char*                  tmp_path     = Null;
+
+    GOTO_HANDLER_IF (
+        !cmap_builder_build (&cmap, &otf_file->cmap),
+        WRITE_FAILED,
+        "Failed to compile character to glyph index map\n"
+    );
+
+    /* expand horizontal metrics for each glyph */
+    OtfHmtx* hmtx = &otf_file->hmtx;
+    if (header.num_glyphs && hmtx->num_h_metrics) {
+        GOTO_HANDLER_IF (
+            !(h_metrics = ALLOCATE (OtfCompiledMetric, header.num_glyphs)),
+            WRITE_FAILED,
+            ERR_OUT_OF_MEMORY
+        );
+
+        Uint16 last_advance_width = hmtx->h_metrics[hmtx->num_h_metrics - 1].advance_width;
+        for (Size g = 0; g < header.num_glyphs; g++) {
+            if (g < hmtx->num_h_metrics) {
+                h_metrics[g].advance_width     = hmtx->h_metrics[g].advance_width;
+                h_metrics[g].left_side_bearing = hmtx->h_metrics[g].left_side_bearing;
+            } else {
+                Size lsb_idx                   = g - hmtx->num_h_metrics;
+                h_metrics[g].advance_width     = last_advance_width;
+                h_metrics[g].left_side_bearing = lsb_idx < hmtx->num_left_side_bearings ?
+                                                     hmtx->left_side_bearings[lsb_idx] :
+                                                     0;
+            }
+        }
+    }
+
+    /* flatten name records, platform specific ids are stored raw */
+    OtfName* name = &otf_file->name;
+    if (name->num_name_records) {
+        GOTO_HANDLER_IF (
+            !(name_records = ALLOCATE (OtfCompiledNameRecord, name->num_name_records)),
+            WRITE_FAILED,
+            ERR_OUT_OF_MEMORY
+        );
+
+        for (Size r = 0; r < name->num_name_records; r++) {
+            OtfNameRecord* record         = name->name_records + r;
+            name_records[r].platform_id   = record->platform_encoding.platform;
+            name_records[r].encoding_id   = record->platform_encoding.encoding.custom;
+            name_records[r].language_id   = record->language.language.custom;
+            name_records[r].name_id       = record->name_id;
+            name_records[r].string_offset = record->string_offset;
+            name_records[r].length        = record->length;
+
+            /* strings pointing outside of storage are dropped */
+            if ((Size)record->string_offset + record->length > name->string_data_size) {
+                name_records[r].string_offset = 0;
+                name_records[r].length        = 0;
+            }
+        }
+    }
+
+    /* compute layout, each section starts at an aligned offset */
+    Size offset = ALIGN_SECTION (sizeof (OtfCompiledHeader));
+
+    header.table_records.offset = offset;
+    header.table_records.count  = otf_file->table_directory.num_tables;
+    offset += ALIGN_SECTION (sizeof (OtfTableRecord) * header.table_records.count);
+
+    header.cmap_groups.offset = offset;
+    header.cmap_groups.count  = cmap.count;
+    offset += ALIGN_SECTION (sizeof (OtfCompiledCmapGroup) * header.cmap_groups.count);
+
+    header.h_metrics.offset = offset;
+    header.h_metrics.count  = h_metrics ? header.num_glyphs : 0;
+    offset += ALIGN_SECTION (sizeof (OtfCompiledMetric) * header.h_metrics.count);
+
+    header.name_records.offset = offset;
+    header.name_records.count  = name->num_name_records;
+    offset += ALIGN_SECTION (sizeof (OtfCompiledNameRecord) * header.name_records.count);
+
+    header.name_strings.offset = offset;
+    header.name_strings.count  = name->string_data_size;
+    offset += ALIGN_SECTION (header.name_strings.count);
+
+    header.file_size = offset;
+
+    /* write everything to a temporary file and then move it in place */
+    Size tmp_path_size = strlen (compiled_path) + 32;
+    GOTO_HANDLER_IF (!(tmp_path = ALLOCATE (Char, tmp_path_size)), WRITE_FAILED, ERR_OUT_OF_MEMORY);
+    snprintf (tmp_path, tmp_path_size, "%s.%d.tmp", compiled_path, (int)getpid());
+
+    GOTO_HANDLER_IF (
+        !(file = fopen (tmp_path, "wb")),
+        WRITE_FAILED,
+        "Failed to create compiled font file : %s\n",
+        strerror (errno)
+    );
+
+    Size written = 0;
+    GOTO_HANDLER_IF (
+        fwrite (&header, sizeof (OtfCompiledHeader), 1, file) != 1,
+        WRITE_FAILED,
+        "Failed to write compiled font header : %s\n",
+        strerror (errno)
+    );
+    written += sizeof (OtfCompiledHeader);
+
+    GOTO_HANDLER_IF (
+        !write_section (
+            file,
+            &written,
+            &header.table_records,
+            otf_file->table_directory.table_records,
+            sizeof (OtfTableRecord)
+        ) ||
+            !write_section (
+                file,
+                &written,
+                &header.cmap_groups,
+                cmap.groups,
+                sizeof (OtfCompiledCmapGroup)
+            ) ||
+            !write_section (
+                file,
+                &written,
+                &header.h_metrics,
+                h_metrics,
+                sizeof (OtfCompiledMetric)
+            ) ||
+            !write_section (
+                file,
+                &written,
+                &header.name_records,
+                name_records,
+                sizeof (OtfCompiledNameRecord)
+            ) ||
+            !write_section (file, &written, &header.name_strings, name->string_data, sizeof (Char)),
+        WRITE_FAILED,
+        "Failed to write compiled font sections : %s\n",
+        strerror (errno)
+    );
+
+    /* pad file till the end of last section */
+    while (written < header.file_size) {
+        GOTO_HANDLER_IF (fputc (0, file) == EOF, WRITE_FAILED, "Failed to write padding\n");
+        written++;
+    }
+
+    /* stream is gone even if close fails, so handler must not close it again */
+    int closed = fclose (file);
+    file       = Null;
+    GOTO_HANDLER_IF (
+        closed != 0,
+        WRITE_FAILED,
+        "Failed to flush compiled font file : %s\n",
+        strerror (errno)
+    );
+
+    GOTO_HANDLER_IF (
+        rename (tmp_path, compiled_path) != 0,
+        WRITE_FAILED,
+        "Failed to move compiled font file in place : %s\n",
+        strerror (errno)
+    );
+
+    FREE (tmp_path);
+    FREE (name_records);
+    FREE (h_metrics);
+    cmap_builder_deinit (&cmap);
+
+    return otf_file;
+
+WRITE_FAILED:
+    if (file) {
+        fclose (file);
+    }
+
+    if (tmp_path) {
+        unlink (tmp_path);
+        FREE (tmp_path);
+    }
+
+    if (name_records) {
+        FREE (name_records);
+    }
+
+    if (h_metrics) {
+        FREE (h_metrics);
+    }
+
+    cmap_builder_deinit (&cmap);
+    return Null;
+}
+
+/**
+ * @b Map a compiled font file in memory after validating it against its source font.
+ *
+ * Compiled font is rejected if it's written by a different version, on a host with
+ * different byte order, or if source font's size, modification time or table directory
+ * checksum does not match what was recorded when compiled font was written.
+ *
+ * @param compiled Handle to be initialized.
+ * @param compiled_path Path of compiled font file.
+ * @param font_path Path of source font file.
+ *
+ * @return @c compiled on success.
+ * @return @c Null otherwise.
+ * */
+OtfCompiled* otf_compiled_open (OtfCompiled* compiled, CString compiled_path, CString font_path) {
+    RETURN_VALUE_IF (!compiled || !compiled_path || !font_path, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (compiled, 0, sizeof (OtfCompiled));
+
+    int fd = open (compiled_path, O_RDONLY);
+    RETURN_VALUE_IF (fd < 0, Null, "Failed to open compiled font file : %s\n", strerror (errno));
+
+    struct stat compiled_stat;
+    if (fstat (fd, &compiled_stat) != 0 ||
+        (Size)compiled_stat.st_size < sizeof (OtfCompiledHeader)) {
+        PRINT_ERR ("Compiled font file is invalid or too small\n");
+        close (fd);
+        return Null;
+    }
+
+    compiled->size = compiled_stat.st_size;
+    compiled->data = mmap (Null, compiled->size, PROT_READ, MAP_SHARED, fd, 0);
+    close (fd);
+
+    if (compiled->data == MAP_FAILED) {
+        PRINT_ERR ("Failed to map compiled font file : %s\n", strerror (errno));
+        compiled->data = Null;
+        return Null;
+    }
+
+    const OtfCompiledHeader* header = (const OtfCompiledHeader*)compiled->data;
+    compiled->header                = header;
+
+    GOTO_HANDLER_IF (
+        header->magic != OTF_COMPILED_MAGIC || header->version != OTF_COMPILED_VERSION ||
+            header->header_size != sizeof (OtfCompiledHeader) ||
+            header->byte_order_mark != OTF_COMPILED_BYTE_ORDER_MARK,
+        OPEN_FAILED,
+        "Compiled font file has invalid magic, version or byte order\n"
+    );
+
+    GOTO_HANDLER_IF (
+        header->file_size != compiled->size ||
+            !section_is_valid (compiled, &header->table_records, sizeof (OtfTableRecord)) ||
+            !section_is_valid (compiled, &header->cmap_groups, sizeof (OtfCompiledCmapGroup)) ||
+            !section_is_valid (compiled, &header->h_metrics, sizeof (OtfCompiledMetric)) ||
+            !section_is_valid (compiled, &header->name_records, sizeof (OtfCompiledNameRecord)) ||
+            !section_is_valid (compiled, &header->name_strings, sizeof (Char)) ||
+            !name_records_are_valid (compiled),
+        OPEN_FAILED,
+        "Compiled font file is truncated or corrupted\n"
+    );
+
+    /* validate against source font */
+    struct stat font_stat;
+    GOTO_HANDLER_IF (
+        stat (font_path, &font_stat) != 0,
+        OPEN_FAILED,
+        "Failed to stat source font file : %s\n",
+        strerror (errno)
+    );
+
+    GOTO_HANDLER_IF (
+        header->source_size != (Uint64)font_stat.st_size ||
+            header->source_mtime_sec != font_stat.st_mtim.tv_sec ||
+            header->source_mtime_nsec != font_stat.st_mtim.tv_nsec,
+        OPEN_FAILED,
+        "Compiled font file is stale (source font size or modification time changed)\n"
+    );
+
+    Uint32 checksum = 0;
+    GOTO_HANDLER_IF (
+        !table_dir_checksum (font_path, &checksum) || checksum != header->source_checksum,
+        OPEN_FAILED,
+        "Compiled font file is stale (source font checksum changed)\n"
+    );
+
+    compiled->table_records =
+        (const OtfTableRecord*)(compiled->data + header->table_records.offset);
+    compiled->cmap_groups =
+        (const OtfCompiledCmapGroup*)(compiled->data + header->cmap_groups.offset);
+    compiled->h_metrics = (const OtfCompiledMetric*)(compiled->data + header->h_metrics.offset);
+    compiled->name_records =
+        (const OtfCompiledNameRecord*)(compiled->data + header->name_records.offset);
+    compiled->name_strings = (const Char*)(compiled->data + header->name_strings.offset);
+
+    return compiled;
+
+OPEN_FAILED:
+    otf_compiled_close (compiled);
+    return Null;
+}
+
+/**
+ * @b Unmap given compiled font.
+ *
+ * @param compiled
+ *
+ * @return @c compiled on success.
+ * @return @c Null otherwise.
+ * */
+OtfCompiled* otf_compiled_close (OtfCompiled* compiled) {
+    RETURN_VALUE_IF (!compiled, Null, ERR_INVALID_ARGUMENTS);
+
+    if (compiled->data) {
+        munmap (compiled->data, compiled->size);
+    }
+
+    memset (compiled, 0, sizeof (OtfCompiled));
+
+    return compiled;
+}
+
+/**
+ * @b Find table record in compiled table directory.
+ *
+ * @param compiled
+ * @param table_tag Table tag of required table.
+ *
+ * @return Table record on success.
+ * @return @c Null otherwise.
+ * */
+const OtfTableRecord*
+    otf_compiled_find_table_record (OtfCompiled* compiled, OtfTableTag table_tag) {
+    RETURN_VALUE_IF (!compiled || !compiled->header, Null, ERR_INVALID_ARGUMENTS);
+
+    for (Size s = 0; s < compiled->header->table_records.count; s++) {
+        if (compiled->table_records[s].table_tag == table_tag) {
+            return compiled->table_records + s;
+        }
+    }
+
+    return Null;
+}
+
+/**
+ * @b Get glyph id for given character code using compiled cmap.
+ *
+ * @param compiled
+ * @param char_code Unicode character code.
+ *
+ * @return Glyph id on success.
+ * @return @c 0 (missing glyph) if character is not mapped.
+ * */
+Uint32 otf_compiled_get_glyph_id (OtfCompiled* compiled, Uint32 char_code) {
+    RETURN_VALUE_IF (!compiled || !compiled->header, 0, ERR_INVALID_ARGUMENTS);
+    return otf_compiled_cmap_groups_find (
+        compiled->cmap_groups,
+        compiled->header->cmap_groups.count,
+        char_code
+    );
+}
+
+/**
+ * @b Get advance width of given glyph.
+ *
+ * @return Advance width in font design units. Zero if glyph id is out of range.
+ * */
+Uint16 otf_compiled_get_advance_width (OtfCompiled* compiled, Uint32 glyph_id) {
+    RETURN_VALUE_IF (!compiled || !compiled->header, 0, ERR_INVALID_ARGUMENTS);
+    return glyph_id < compiled->header->h_metrics.count ?
+               compiled->h_metrics[glyph_id].advance_width :
+               0;
+}
+
+/**
+ * @b Get left side bearing of given glyph.
+ *
+ * @return Left side bearing in font design units. Zero if glyph id is out of range.
+ * */
+Int16 otf_compiled_get_left_side_bearing (OtfCompiled* compiled, Uint32 glyph_id) {
+    RETURN_VALUE_IF (!compiled || !compiled->header, 0, ERR_INVALID_ARGUMENTS);
+    return glyph_id < compiled->header->h_metrics.count ?
+               compiled->h_metrics[glyph_id].left_side_bearing :
+               0;
+}
+
+/**
+ * @b Get raw bytes of a string from compiled name table.
+ * Strings are stored exactly as they appear in font file (eg: UTF-16BE for Windows platform).
+ *
+ * @param compiled
+ * @param name_id Name id of required string.
+ * @param platform_id
+ * @param encoding_id
+ * @param language_id
+ * @param length Will contain length of string in bytes.
+ *
+ * @return Pointer to string bytes inside compiled font on success.
+ * @return @c Null otherwise.
+ * */
+const Char* otf_compiled_get_name (
+    OtfCompiled* compiled,
+    OtfNameId    name_id,
+    Uint16       platform_id,
+    Uint16       encoding_id,
+    Uint16       language_id,
+    Size*        length
+) {
+    RETURN_VALUE_IF (!compiled || !compiled->header || !length, Null, ERR_INVALID_ARGUMENTS);
+
+    for (Size r = 0; r < compiled->header->name_records.count; r++) {
+        const OtfCompiledNameRecord* record = compiled->name_records + r;
+        if (record->name_id == name_id && record->platform_id == platform_id &&
+            record->encoding_id == encoding_id && record->language_id == language_id) {
+            *length = record->length;
+            return compiled->name_strings + record->string_offset;
+        }
+    }
+
+    *length = 0;
+    return Null;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Compute OTF style checksum of table directory of given font file.
+ *
+ * Table directory contains checksum of every table in font, so this changes
+ * whenever any table changes, while requiring only a few hundred bytes to be read.
+ *
+ * @param font_path
+ * @param checksum Will contain computed checksum.
+ *
+ * @return @c checksum on success.
+ * @return @c Null otherwise.
+ * */
+static inline Uint32* table_dir_checksum (CString font_path, Uint32* checksum) {
+    RETURN_VALUE_IF (!font_path || !checksum, Null, ERR_INVALID_ARGUMENTS);
+
+    FILE* file = fopen (font_path, "rb");
+    RETURN_VALUE_IF (!file, Null, "Failed to open font file : %s\n", strerror (errno));
+
+    Uint8 dir_header[OTF_TABLE_DIR_DATA_SIZE];
+    if (fread (dir_header, 1, sizeof (dir_header), file) != sizeof (dir_header)) {
+        PRINT_ERR ("Failed to read table directory of font file\n");
+        fclose (file);
+        return Null;
+    }
+
+    Uint8* data       = dir_header + sizeof (Uint32);
+    Uint16 num_tables = GET_AND_ADV_U2 (data);
+
+    /* table directory size is always a multiple of 4 */
+    Size   dir_size = OTF_TABLE_DIR_DATA_SIZE + OTF_TABLE_RECORD_DATA_SIZE * num_tables;
+    Uint8* dir      = ALLOCATE (Uint8, dir_size);
+    if (!dir) {
+        PRINT_ERR (ERR_OUT_OF_MEMORY);
+        fclose (file);
+        return Null;
+    }
+
+    memcpy (dir, dir_header, sizeof (dir_header));
+    Size read_size = fread (dir + sizeof (dir_header), 1, dir_size - sizeof (dir_header), file);
+    fclose (file);
+
+    if (read_size != dir_size - sizeof (dir_header)) {
+        PRINT_ERR ("Failed to read table records of font file\n");
+        FREE (dir);
+        return Null;
+    }
+
+    Uint32 sum = 0;
+    data       = dir;
+    for (Size s = 0; s < dir_size / sizeof (Uint32); s++) {
+        sum += GET_AND_ADV_U4 (data);
+    }
+
+    FREE (dir);
+
+    *checksum = sum;
+    return checksum;
+}
+
+/**
+ * @b Build compiled cmap from best unicode subtable available in given cmap.
+ *
+ * @param builder Builder to fill groups into.
+ * @param cmap Decoded cmap table.
+ *
+ * @return @c builder on success.
+ * @return @c Null otherwise.
+ * */
+static inline CmapBuilder* cmap_builder_build (CmapBuilder* builder, OtfCmap* cmap) {
+    RETURN_VALUE_IF (!builder || !cmap, Null, ERR_INVALID_ARGUMENTS);
+
+    OtfCmapEncodingRecord* best       = Null;
+    Int32                  best_score = 0;
+    for (Size s = 0; s < cmap->num_tables; s++) {
+        Int32 score = cmap_subtable_score (cmap->encoding_records + s);
+        if (score > best_score) {
+            best       = cmap->encoding_records + s;
+            best_score = score;
+        }
+    }
+
+    /* a font without any usable cmap subtable gets an empty compiled cmap */
+    if (!best) {
+        return builder;
+    }
+
+    OtfCmapSubTable* sub_table = &best->sub_table;
+    switch (sub_table->format) {
+        case 0 : {
+            for (Uint32 c = 0; c < 256; c++) {
+                RETURN_VALUE_IF (
+                    !cmap_builder_add_range (builder, c, c, sub_table->format0->glyph_id_array[c]),
+                    Null,
+                    "Failed to add cmap group\n"
+                );
+            }
+            break;
+        }
+
+        case 4 : {
+            OtfCmapSubTableFormat4* f4 = sub_table->format4;
+            for (Size i = 0; i < f4->seg_count; i++) {
+                for (Uint32 c = f4->start_code[i]; c <= f4->end_code[i] && c != 0xffff; c++) {
+                    Uint16 glyph_id = 0;
+
+                    if (!f4->id_range_offsets[i]) {
+                        glyph_id = (c + f4->id_delta[i]) & 0xffff;
+                    } else {
+                        /* glyph index array immediately follows id range offsets array */
+                        Size idx = f4->id_range_offsets[i] / 2 + (c - f4->start_code[i]) -
+                                   (f4->seg_count - i);
+                        if (idx < f4->num_glyph_ids && f4->glyph_id_array[idx]) {
+                            glyph_id = (f4->glyph_id_array[idx] + f4->id_delta[i]) & 0xffff;
+                        }
+                    }
+
+                    RETURN_VALUE_IF (
+                        !cmap_builder_add_range (builder, c, c, glyph_id),
+                        Null,
+                        "Failed to add cmap group\n"
+                    );
+                }
+            }
+            break;
+        }
+
+        case 6 : {
+            OtfCmapSubTableFormat6* f6 = sub_table->format6;
+            for (Uint32 c = 0; c < f6->entry_count; c++) {
+                RETURN_VALUE_IF (
+                    !cmap_builder_add_range (
+                        builder,
+                        f6->first_code + c,
+                        f6->first_code + c,
+                        f6->glyph_id_array[c]
+                    ),
+                    Null,
+                    "Failed to add cmap group\n"
+                );
+            }
+            break;
+        }
+
+        case 12 : {
+            OtfCmapSubTableFormat12* f12 = sub_table->format12;
+            for (Size g = 0; g < f12->num_groups; g++) {
+                RETURN_VALUE_IF (
+                    f12->groups[g].start_char_code > f12->groups[g].end_char_code,
+                    Null,
+                    "Invalid group in cmap subtable format 12\n"
+                );
+                RETURN_VALUE_IF (
+                    !cmap_builder_add_range (
+                        builder,
+                        f12->groups[g].start_char_code,
+                        f12->groups[g].end_char_code,
+                        f12->groups[g].start_glyph_id
+                    ),
+                    Null,
+                    "Failed to add cmap group\n"
+                );
+            }
+            break;
+        }
+
+        default :
+            RETURN_VALUE_IF_REACHED (Null, "Unexpected cmap subtable format\n");
+    }
+
+    /* binary search in loader requires groups to be sorted */
+    qsort (builder->groups, builder->count, sizeof (OtfCompiledCmapGroup), cmap_group_compare);
+
+    return builder;
+}
+
+/**
+ * @b Add a range of char codes mapping to consecutive glyph ids.
+ * Extends last group when new range continues it. Char codes mapping
+ * to missing glyph (0) are never stored.
+ * */
+static inline CmapBuilder* cmap_builder_add_range (
+    CmapBuilder* builder,
+    Uint32       start_char_code,
+    Uint32       end_char_code,
+    Uint32       start_glyph_id
+) {
+    RETURN_VALUE_IF (!builder, Null, ERR_INVALID_ARGUMENTS);
+
+    if (!start_glyph_id && start_char_code == end_char_code) {
+        return builder;
+    }
+
+    if (builder->count) {
+        OtfCompiledCmapGroup* last = builder->groups + builder->count - 1;
+        if (last->end_char_code + 1 == start_char_code &&
+            last->start_glyph_id + (start_char_code - last->start_char_code) == start_glyph_id) {
+            last->end_char_code = end_char_code;
+            return builder;
+        }
+    }
+
+    if (builder->count >= builder->capacity) {
+        Size                  capacity = builder->capacity ? builder->capacity * 2 : 256;
+        OtfCompiledCmapGroup* groups =
+            REALLOCATE (builder->groups, OtfCompiledCmapGroup, capacity);
+        RETURN_VALUE_IF (!groups, Null, ERR_OUT_OF_MEMORY);
+
+        builder->groups   = groups;
+        builder->capacity = capacity;
+    }
+
+    builder->groups[builder->count++] = (OtfCompiledCmapGroup) {
+        .start_char_code = start_char_code,
+        .end_char_code   = end_char_code,
+        .start_glyph_id  = start_glyph_id,
+    };
+
+    return builder;
+}
+
+static inline CmapBuilder* cmap_builder_deinit (CmapBuilder* builder) {
+    RETURN_VALUE_IF (!builder, Null, ERR_INVALID_ARGUMENTS);
+
+    if (builder->groups) {
+        FREE (builder->groups);
+    }
+
+    memset (builder, 0, sizeof (CmapBuilder));
+
+    return builder;
+}
+
+/**
+ * @b Rank cmap subtables, higher score is preferred. Full unicode repertoire
+ * subtables are preferred over BMP only ones. Zero means unusable.
+ * */
+static inline Int32 cmap_subtable_score (OtfCmapEncodingRecord* record) {
+    if (!record) {
+        return 0;
+    }
+
+    OtfPlatform platform   = record->platform_encoding.platform;
+    Uint16      encoding   = record->platform_encoding.encoding.custom;
+    Bool        is_unicode = platform == OTF_PLATFORM_VARIOUS ||
+                      (platform == OTF_PLATFORM_WIN && (encoding == 1 || encoding == 10));
+
+    switch (record->sub_table.format) {
+        case 12 :
+            return record->sub_table.format12 ? (is_unicode ? 5 : 0) : 0;
+        case 4 :
+            return record->sub_table.format4 ? (is_unicode ? 4 : 3) : 0;
+        case 6 :
+            return record->sub_table.format6 ? 2 : 0;
+        case 0 :
+            return record->sub_table.format0 ? 1 : 0;
+        default :
+            return 0;
+    }
+}
+
+static inline int cmap_group_compare (const void* a, const void* b) {
+    Uint32 x = ((const OtfCompiledCmapGroup*)a)->start_char_code;
+    Uint32 y = ((const OtfCompiledCmapGroup*)b)->start_char_code;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+/**
+ * @b Write a single section at it's offset, padding file with zeroes before it.
+ * */
+static inline FILE* write_section (
+    FILE*               file,
+    Size*               written,
+    OtfCompiledSection* section,
+    const void*         data,
+    Size                elem_size
+) {
+    RETURN_VALUE_IF (!file || !written || !section, Null, ERR_INVALID_ARGUMENTS);
+
+    while (*written < section->offset) {
+        RETURN_VALUE_IF (fputc (0, file) == EOF, Null, "Failed to write padding\n");
+        (*written)++;
+    }
+
+    if (section->count) {
+        RETURN_VALUE_IF (
+            !data || fwrite (data, elem_size, section->count, file) != section->count,
+            Null,
+            "Failed to write section data\n"
+        );
+        *written += elem_size * section->count;
+    }
+
+    return file;
+}
+
+/**
+ * @b Check whether given section lies completely within compiled font file
+ * and starts at an aligned offset.
+ * */
+static inline Bool
+    section_is_valid (OtfCompiled* compiled, const OtfCompiledSection* section, Size elem_size) {
+    if (section->offset % OTF_COMPILED_SECTION_ALIGNMENT || section->offset > compiled->size) {
+        return False;
+    }
+
+    return section->count <= (compiled->size - section->offset) / elem_size;
+}
+
+/**
+ * @b Check whether string of every name record lies within name strings
+ * section, so names can be handed out without checking them again.
+ *
+ * Sections must already be checked to lie within compiled font file.
+ * */
+static inline Bool name_records_are_valid (OtfCompiled* compiled) {
+    const OtfCompiledHeader*     header = compiled->header;
+    const OtfCompiledNameRecord* records =
+        (const OtfCompiledNameRecord*)(compiled->data + header->name_records.offset);
+
+    for (Size r = 0; r < header->name_records.count; r++) {
+        if ((Uint64)records[r].string_offset + records[r].length > header->name_strings.count) {
+            return False;
+        }
+    }
+
+    return True;
+}
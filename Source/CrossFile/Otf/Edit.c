@@ -0,0 +1,740 @@
+/**
+ * @file Edit.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/EndiannessHelpers.h>
+#include <Anvie/CrossFile/Otf/Edit.h>
+
+/* libc */
+#include <errno.h>
+#include <memory.h>
+#include <stdio.h>
+#include <string.h>
+
+/* REF : https://learn.microsoft.com/en-us/typography/opentype/spec/otff#calculating-checksums */
+#define OTF_CHECKSUM_MAGIC                  0xB1B0AFBA
+#define OTF_HEAD_CHECKSUM_ADJUSTMENT_OFFSET 8
+
+#define ALIGN4(x) (((x) + 3) & ~(Size)3)
+
+/* private method declarations */
+
+static inline OtfEditTable*   edit_session_find_table (OtfEditSession* session, OtfTableTag tag);
+static inline Size            edit_session_slot_size (OtfEditSession* session, Size index);
+static inline FILE*           edit_session_zero_unused (
+    OtfEditSession* session,
+    FILE*           file,
+    Size            index,
+    Size            from,
+    Size            to
+);
+static inline Uint32          table_checksum (Uint8* data, Size length, Bool is_head);
+static inline void            put_u4_be (Uint8* dst, Uint32 value);
+static inline FILE*           write_at (FILE* file, Size offset, const void* data, Size size);
+static inline FILE*           write_zeros (FILE* file, Size size);
+static inline OtfEditSession* write_table_record (OtfEditSession* session, FILE* file, Size index);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Begin an edit session over given font.
+ *
+ * @param session Session to be initialized.
+ * @param otf_file Font already opened from @c filename. Decoded tables in it
+ *        are updated when session is committed.
+ * @param filename Path of font file, changes are saved back to it.
+ *
+ * @return @c session on success.
+ * @return @c Null otherwise.
+ * */
+OtfEditSession*
+    otf_edit_session_init (OtfEditSession* session, OtfFile* otf_file, CString filename) {
+    RETURN_VALUE_IF (!session || !otf_file || !filename, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (session, 0, sizeof (OtfEditSession));
+    session->otf_file = otf_file;
+
+    FILE* file = Null;
+
+    GOTO_HANDLER_IF (!(session->filename = strdup (filename)), INIT_FAILED, ERR_OUT_OF_MEMORY);
+    GOTO_HANDLER_IF (
+        !(file = fopen (filename, "rb")),
+        INIT_FAILED,
+        "Failed to open font file : %s\n",
+        strerror (errno)
+    );
+
+    fseek (file, 0, SEEK_END);
+    long file_size = ftell (file);
+    fseek (file, 0, SEEK_SET);
+    GOTO_HANDLER_IF (file_size <= 0, INIT_FAILED, "Font file is empty\n");
+
+    session->size      = file_size;
+    session->file_size = file_size;
+    GOTO_HANDLER_IF (
+        !(session->data = ALLOCATE (Uint8, session->size)),
+        INIT_FAILED,
+        ERR_OUT_OF_MEMORY
+    );
+    GOTO_HANDLER_IF (
+        fread (session->data, 1, session->size, file) != session->size,
+        INIT_FAILED,
+        "Failed to read font file : %s\n",
+        strerror (errno)
+    );
+
+    fclose (file);
+    file = Null;
+
+    OtfTableDir* dir = &otf_file->table_directory;
+    GOTO_HANDLER_IF (
+        OTF_TABLE_DIR_DATA_SIZE + OTF_TABLE_RECORD_DATA_SIZE * dir->num_tables > session->size,
+        INIT_FAILED,
+        "Font file does not match table directory of opened font\n"
+    );
+
+    GOTO_HANDLER_IF (
+        dir->num_tables && !(session->tables = ALLOCATE (OtfEditTable, dir->num_tables)),
+        INIT_FAILED,
+        ERR_OUT_OF_MEMORY
+    );
+
+    for (Size s = 0; s < dir->num_tables; s++) {
+        OtfTableRecord* record = dir->table_records + s;
+        GOTO_HANDLER_IF (
+            (Size)record->offset + record->length > session->size,
+            INIT_FAILED,
+            "Table record points outside font file\n"
+        );
+
+        session->tables[s].data   = session->data + record->offset;
+        session->tables[s].length = record->length;
+    }
+
+    return session;
+
+INIT_FAILED:
+    if (file) {
+        fclose (file);
+    }
+    otf_edit_session_deinit (session);
+    return Null;
+}
+
+/**
+ * @b End given edit session. Unsaved changes are discarded, but tables already
+ * committed to @c OtfFile stay decoded from edited data.
+ *
+ * @param session
+ *
+ * @return @c session on success.
+ * @return @c Null otherwise.
+ * */
+OtfEditSession* otf_edit_session_deinit (OtfEditSession* session) {
+    RETURN_VALUE_IF (!session, Null, ERR_INVALID_ARGUMENTS);
+
+    if (session->tables) {
+        for (Size s = 0; s < session->otf_file->table_directory.num_tables; s++) {
+            if (session->tables[s].is_owned) {
+                FREE (session->tables[s].data);
+            }
+        }
+        FREE (session->tables);
+    }
+
+    if (session->data) {
+        FREE (session->data);
+    }
+
+    if (session->filename) {
+        FREE (session->filename);
+    }
+
+    memset (session, 0, sizeof (OtfEditSession));
+    return session;
+}
+
+/**
+ * @b Get current data of a table for reading or in place modification.
+ * Call @c otf_edit_session_mark_dirty after modifying it.
+ *
+ * @param session
+ * @param tag Tag of table to get.
+ * @param size Will contain size of table data.
+ *
+ * @return Table data on success.
+ * @return @c Null otherwise.
+ * */
+Uint8* otf_edit_session_get_table (OtfEditSession* session, OtfTableTag tag, Size* size) {
+    RETURN_VALUE_IF (!session || !size, Null, ERR_INVALID_ARGUMENTS);
+
+    OtfEditTable* table = edit_session_find_table (session, tag);
+    RETURN_VALUE_IF (!table, Null, "Table not present in font file\n");
+
+    *size = table->length;
+    return table->data;
+}
+
+/**
+ * @b Mark a table as modified, so that it's re-decoded on next commit
+ * and written back on next save.
+ *
+ * @param session
+ * @param tag Tag of modified table.
+ *
+ * @return @c session on success.
+ * @return @c Null otherwise.
+ * */
+OtfEditSession* otf_edit_session_mark_dirty (OtfEditSession* session, OtfTableTag tag) {
+    RETURN_VALUE_IF (!session, Null, ERR_INVALID_ARGUMENTS);
+
+    OtfEditTable* table = edit_session_find_table (session, tag);
+    RETURN_VALUE_IF (!table, Null, "Table not present in font file\n");
+
+    table->decode_pending = True;
+    table->save_pending   = True;
+
+    return session;
+}
+
+/**
+ * @b Replace data of a table entirely. Data is copied, and table is marked dirty.
+ *
+ * @param session
+ * @param tag Tag of table to replace.
+ * @param data New table data.
+ * @param size Size of new table data.
+ *
+ * @return @c session on success.
+ * @return @c Null otherwise.
+ * */
+OtfEditSession* otf_edit_session_replace_table (
+    OtfEditSession* session,
+    OtfTableTag     tag,
+    const Uint8*    data,
+    Size            size
+) {
+    RETURN_VALUE_IF (!session || !data || !size, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (size > (Uint32)-1, Null, "Table too large for OTF table record\n");
+
+    OtfEditTable* table = edit_session_find_table (session, tag);
+    RETURN_VALUE_IF (!table, Null, "Table not present in font file\n");
+
+    Uint8* copy = ALLOCATE (Uint8, size);
+    RETURN_VALUE_IF (!copy, Null, ERR_OUT_OF_MEMORY);
+    memcpy (copy, data, size);
+
+    if (table->is_owned) {
+        FREE (table->data);
+    }
+
+    table->data     = copy;
+    table->length   = size;
+    table->is_owned = True;
+
+    return otf_edit_session_mark_dirty (session, tag);
+}
+
+/**
+ * @b Re-decode all dirty tables into @c OtfFile.
+ *
+ * Only dirty tables and tables depending on them are decoded again. Every
+ * table is decoded into a temporary first, so on failure @c OtfFile still
+ * has last successfully decoded version of each table.
+ *
+ * @param session
+ *
+ * @return @c session on success.
+ * @return @c Null otherwise.
+ * */
+OtfEditSession* otf_edit_session_commit (OtfEditSession* session) {
+    RETURN_VALUE_IF (!session, Null, ERR_INVALID_ARGUMENTS);
+
+    OtfFile*     otf_file        = session->otf_file;
+    OtfTableDir* dir             = &otf_file->table_directory;
+    Bool         redecode_hmtx   = False;
+    Bool         rebuild_kerning = False;
+
+    for (Size s = 0; s < dir->num_tables; s++) {
+        OtfEditTable* table = session->tables + s;
+        if (!table->decode_pending) {
+            continue;
+        }
+
+        switch (dir->table_records[s].table_tag) {
+            case OTF_TABLE_TAG_CMAP : {
+                OtfCmap cmap = {0};
+                RETURN_VALUE_IF (
+                    !otf_cmap_init (&cmap, table->data, table->length),
+                    Null,
+                    "Failed to re-decode edited \"cmap\" table\n"
+                );
+                otf_cmap_deinit (&otf_file->cmap);
+                otf_file->cmap = cmap;
+                break;
+            }
+
+            case OTF_TABLE_TAG_HEAD : {
+                OtfHead head = {0};
+                RETURN_VALUE_IF (
+                    !otf_head_init (&head, table->data, table->length),
+                    Null,
+                    "Failed to re-decode edited \"head\" table\n"
+                );
+                otf_file->head = head;
+                break;
+            }
+
+            case OTF_TABLE_TAG_HHEA : {
+                OtfHhea hhea = {0};
+                RETURN_VALUE_IF (
+                    !otf_hhea_init (&hhea, table->data, table->length),
+                    Null,
+                    "Failed to re-decode edited \"hhea\" table\n"
+                );
+                otf_file->hhea = hhea;
+                redecode_hmtx  = True;
+                break;
+            }
+
+            case OTF_TABLE_TAG_MAXP : {
+                OtfMaxp maxp = {0};
+                RETURN_VALUE_IF (
+                    !otf_maxp_init (&maxp, table->data, table->length),
+                    Null,
+                    "Failed to re-decode edited \"maxp\" table\n"
+                );
+                otf_file->maxp  = maxp;
+                redecode_hmtx   = True;
+                rebuild_kerning = True;
+                break;
+            }
+
+            case OTF_TABLE_TAG_HMTX : {
+                redecode_hmtx = True;
+                break;
+            }
+
+            case OTF_TABLE_TAG_NAME : {
+                OtfName name = {0};
+                RETURN_VALUE_IF (
+                    !otf_name_init (&name, table->data, table->length),
+                    Null,
+                    "Failed to re-decode edited \"name\" table\n"
+                );
+                otf_name_deinit (&otf_file->name);
+                otf_file->name = name;
+                break;
+            }
+
+            case OTF_TABLE_TAG_KERN : {
+                OtfKern kern = {0};
+                RETURN_VALUE_IF (
+                    !otf_kern_init (&kern, table->data, table->length),
+                    Null,
+                    "Failed to re-decode edited \"kern\" table\n"
+                );
+                otf_kern_deinit (&otf_file->kern);
+                otf_file->kern  = kern;
+                rebuild_kerning = True;
+                break;
+            }
+
+            case OTF_TABLE_TAG_GPOS : {
+                OtfGpos gpos = {0};
+                RETURN_VALUE_IF (
+                    !otf_gpos_init (&gpos, table->data, table->length),
+                    Null,
+                    "Failed to re-decode edited \"GPOS\" table\n"
+                );
+                otf_gpos_deinit (&otf_file->gpos);
+                otf_file->gpos  = gpos;
+                rebuild_kerning = True;
+                break;
+            }
+
+            /* tables not decoded by OtfFile only need to be saved */
+            default :
+                break;
+        }
+
+        table->decode_pending = False;
+    }
+
+    /* hmtx layout depends on hhea and maxp */
+    if (redecode_hmtx) {
+        OtfEditTable* table = edit_session_find_table (session, OTF_TABLE_TAG_HMTX);
+        RETURN_VALUE_IF (!table, Null, "hmtx table not found\n");
+
+        OtfHmtx hmtx = {0};
+        RETURN_VALUE_IF (
+            !otf_hmtx_init (&hmtx, &otf_file->hhea, &otf_file->maxp, table->data, table->length),
+            Null,
+            "Failed to re-decode horizontal metric table \"hmtx\"\n"
+        );
+        otf_hmtx_deinit (&otf_file->hmtx);
+        otf_file->hmtx = hmtx;
+    }
+
+    if (rebuild_kerning) {
+        OtfKerning kerning = {0};
+        RETURN_VALUE_IF (
+            !otf_kerning_init (
+                &kerning,
+                &otf_file->gpos,
+                &otf_file->kern,
+                otf_file->maxp.num_glyphs
+            ),
+            Null,
+            "Failed to recompile kerning pairs\n"
+        );
+        otf_kerning_deinit (&otf_file->kerning);
+        otf_file->kerning = kerning;
+    }
+
+    return session;
+}
+
+/**
+ * @b Commit pending changes and write dirty tables back to font file.
+ *
+ * A dirty table is written over its old data if it fits in old table's slot
+ * (space till next table or end of file), otherwise it's appended at end of
+ * file and its table record is relocated. Old data left behind is zeroed,
+ * except where it's shared with another table. Checksums are recomputed only for
+ * dirty tables, whole font checksum is then derived from table record
+ * checksums without reading untouched tables again.
+ *
+ * @param session
+ *
+ * @return @c session on success.
+ * @return @c Null otherwise.
+ * */
+OtfEditSession* otf_edit_session_save (OtfEditSession* session) {
+    RETURN_VALUE_IF (!session, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!otf_edit_session_commit (session), Null, "Failed to commit edited tables\n");
+
+    OtfTableDir* dir       = &session->otf_file->table_directory;
+    Bool         any_dirty = False;
+    for (Size s = 0; s < dir->num_tables; s++) {
+        any_dirty |= session->tables[s].save_pending;
+    }
+    if (!any_dirty) {
+        return session;
+    }
+
+    FILE* file = fopen (session->filename, "r+b");
+    RETURN_VALUE_IF (!file, Null, "Failed to open font file for writing : %s\n", strerror (errno));
+
+    Size head_index = dir->num_tables;
+
+    for (Size s = 0; s < dir->num_tables; s++) {
+        OtfTableRecord* record = dir->table_records + s;
+        OtfEditTable*   table  = session->tables + s;
+
+        if (record->table_tag == OTF_TABLE_TAG_HEAD) {
+            head_index = s;
+        }
+
+        if (!table->save_pending) {
+            continue;
+        }
+
+        Size padded_length = ALIGN4 (table->length);
+        Size old_length    = ALIGN4 (record->length);
+        Size offset        = record->offset;
+
+        /* relocate to end of file if table does not fit in its old slot anymore */
+        if (padded_length > edit_session_slot_size (session, s)) {
+            offset             = ALIGN4 (session->file_size);
+            session->file_size = offset + padded_length;
+            GOTO_HANDLER_IF (
+                offset > (Uint32)-1,
+                SAVE_FAILED,
+                "Font file too large to relocate table\n"
+            );
+        }
+
+        /* bytes no longer used by table are zeroed, they're still part of font checksum */
+        Size unused_from = record->offset;
+        Size unused_to   = record->offset + old_length;
+        if (offset == record->offset) {
+            unused_from = MIN (offset + padded_length, unused_to);
+        }
+
+        GOTO_HANDLER_IF (
+            !edit_session_zero_unused (session, file, s, unused_from, unused_to) ||
+                !write_at (file, offset, table->data, table->length) ||
+                !write_zeros (file, padded_length - table->length),
+            SAVE_FAILED,
+            "Failed to write table : %s\n",
+            strerror (errno)
+        );
+
+        record->offset   = offset;
+        record->length   = table->length;
+        record->checksum = table_checksum (
+            table->data,
+            table->length,
+            record->table_tag == OTF_TABLE_TAG_HEAD
+        );
+
+        GOTO_HANDLER_IF (
+            !write_table_record (session, file, s),
+            SAVE_FAILED,
+            "Failed to write table record : %s\n",
+            strerror (errno)
+        );
+
+        table->save_pending = False;
+    }
+
+    /* whole font checksum is sum of table directory and checksums of all tables */
+    if (head_index < dir->num_tables) {
+        OtfEditTable* head_table = session->tables + head_index;
+        GOTO_HANDLER_IF (
+            head_table->length < OTF_HEAD_CHECKSUM_ADJUSTMENT_OFFSET + sizeof (Uint32),
+            SAVE_FAILED,
+            "Font header table \"head\" too small\n"
+        );
+
+        Size   dir_size = OTF_TABLE_DIR_DATA_SIZE + OTF_TABLE_RECORD_DATA_SIZE * dir->num_tables;
+        Uint32 sum      = table_checksum (session->data, dir_size, False);
+        for (Size s = 0; s < dir->num_tables; s++) {
+            sum += dir->table_records[s].checksum;
+        }
+
+        Uint32 adjustment = OTF_CHECKSUM_MAGIC - sum;
+        Uint8* dst        = head_table->data + OTF_HEAD_CHECKSUM_ADJUSTMENT_OFFSET;
+        put_u4_be (dst, adjustment);
+
+        GOTO_HANDLER_IF (
+            !write_at (
+                file,
+                dir->table_records[head_index].offset + OTF_HEAD_CHECKSUM_ADJUSTMENT_OFFSET,
+                dst,
+                sizeof (Uint32)
+            ),
+            SAVE_FAILED,
+            "Failed to write font checksum adjustment : %s\n",
+            strerror (errno)
+        );
+
+        session->otf_file->head.checksum_adjustment = adjustment;
+    }
+
+    RETURN_VALUE_IF (
+        fclose (file) != 0,
+        Null,
+        "Failed to save font file : %s\n",
+        strerror (errno)
+    );
+
+    return session;
+
+SAVE_FAILED:
+    fclose (file);
+    return Null;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+static inline OtfEditTable* edit_session_find_table (OtfEditSession* session, OtfTableTag tag) {
+    OtfTableDir* dir = &session->otf_file->table_directory;
+
+    for (Size s = 0; s < dir->num_tables; s++) {
+        if (dir->table_records[s].table_tag == tag) {
+            return session->tables + s;
+        }
+    }
+
+    return Null;
+}
+
+/**
+ * @b Get number of bytes a table can grow to without overwriting another
+ * table. A table placed last in file can grow till end of file.
+ * */
+static inline Size edit_session_slot_size (OtfEditSession* session, Size index) {
+    OtfTableDir* dir   = &session->otf_file->table_directory;
+    Size         start = dir->table_records[index].offset;
+    Size         end   = session->file_size;
+
+    for (Size s = 0; s < dir->num_tables; s++) {
+        Size offset = dir->table_records[s].offset;
+        if (s != index && offset >= start && offset < end) {
+            end = offset;
+        }
+    }
+
+    /* tables sharing data with another table (offset equal) can't be overwritten in place */
+    return end > start ? end - start : 0;
+}
+
+/**
+ * @b Zero bytes of font file in range @c [from, to) that no table other than
+ * the one at given index uses. Tables may share or overlap their data, and
+ * bytes still covered by another table record are left as they are.
+ *
+ * @return @c file on success.
+ * @return @c Null otherwise.
+ * */
+static inline FILE* edit_session_zero_unused (
+    OtfEditSession* session,
+    FILE*           file,
+    Size            index,
+    Size            from,
+    Size            to
+) {
+    OtfTableDir* dir = &session->otf_file->table_directory;
+
+    while (from < to) {
+        Size covered_to = from; /* end of other tables covering from */
+        Size unused_to  = to;   /* start of next table after from */
+
+        for (Size s = 0; s < dir->num_tables; s++) {
+            Size start = dir->table_records[s].offset;
+            Size end   = start + ALIGN4 (dir->table_records[s].length);
+
+            if (s == index || start == end) {
+                continue;
+            }
+
+            if (start <= from && end > from) {
+                covered_to = MAX (covered_to, end);
+            } else if (start > from && start < unused_to) {
+                unused_to = start;
+            }
+        }
+
+        if (covered_to > from) {
+            from = covered_to;
+            continue;
+        }
+
+        RETURN_VALUE_IF (
+            fseek (file, from, SEEK_SET) != 0 || !write_zeros (file, unused_to - from),
+            Null,
+            "Failed to zero unused table data : %s\n",
+            strerror (errno)
+        );
+        from = unused_to;
+    }
+
+    return file;
+}
+
+/**
+ * @b Compute OTF checksum of given table data. Checksum adjustment field
+ * of "head" table is treated as zero.
+ * */
+static inline Uint32 table_checksum (Uint8* data, Size length, Bool is_head) {
+    Uint32 sum = 0;
+
+    for (Size s = 0; s + sizeof (Uint32) <= length; s += sizeof (Uint32)) {
+        if (is_head && s == OTF_HEAD_CHECKSUM_ADJUSTMENT_OFFSET) {
+            continue;
+        }
+        Uint8* word = data + s;
+        sum        += GET_AND_ADV_U4 (word);
+    }
+
+    /* last partial word is zero padded */
+    Size tail = length % sizeof (Uint32);
+    if (tail) {
+        Uint8 word[sizeof (Uint32)] = {0};
+        memcpy (word, data + length - tail, tail);
+        Uint8* iter = word;
+        sum        += GET_AND_ADV_U4 (iter);
+    }
+
+    return sum;
+}
+
+static inline void put_u4_be (Uint8* dst, Uint32 value) {
+    dst[0] = value >> 24;
+    dst[1] = value >> 16;
+    dst[2] = value >> 8;
+    dst[3] = value;
+}
+
+static inline FILE* write_at (FILE* file, Size offset, const void* data, Size size) {
+    RETURN_VALUE_IF (fseek (file, offset, SEEK_SET) != 0, Null, "Failed to seek in font file\n");
+    RETURN_VALUE_IF (fwrite (data, 1, size, file) != size, Null, "Failed to write font file\n");
+    return file;
+}
+
+static inline FILE* write_zeros (FILE* file, Size size) {
+    static const Uint8 zeros[256] = {0};
+
+    while (size) {
+        Size chunk = MIN (size, sizeof (zeros));
+        RETURN_VALUE_IF (
+            fwrite (zeros, 1, chunk, file) != chunk,
+            Null,
+            "Failed to write font file\n"
+        );
+        size -= chunk;
+    }
+
+    return file;
+}
+
+/**
+ * @b Write table record at given index back to table directory in file,
+ * and to session's copy of table directory used for computing font checksum.
+ * */
+static inline OtfEditSession* write_table_record (OtfEditSession* session, FILE* file, Size index) {
+    OtfTableRecord* record = session->otf_file->table_directory.table_records + index;
+    Size            offset = OTF_TABLE_DIR_DATA_SIZE + OTF_TABLE_RECORD_DATA_SIZE * index;
+    Uint8*          dst    = session->data + offset;
+
+    /* table tags are kept in file byte order */
+    memcpy (dst, &record->table_tag, sizeof (Uint32));
+    put_u4_be (dst + 4, record->checksum);
+    put_u4_be (dst + 8, record->offset);
+    put_u4_be (dst + 12, record->length);
+
+    RETURN_VALUE_IF (
+        !write_at (file, offset, dst, OTF_TABLE_RECORD_DATA_SIZE),
+        Null,
+        "Failed to write table record\n"
+    );
+    return session;
+}
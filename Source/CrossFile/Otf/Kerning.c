@@ -0,0 +1,642 @@
+/**
+ * @file Kerning.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Otf/Kerning.h>
+#include <Anvie/CrossFile/Otf/Tables/Gpos.h>
+#include <Anvie/CrossFile/Otf/Tables/Kern.h>
+
+/* libc */
+#include <memory.h>
+
+/* private method declarations */
+
+static inline OtfKerning*     pairs_reserve (OtfKerning* kerning, Size count);
+static inline OtfKerningPair* pairs_find (OtfKerning* kerning, Uint32 key);
+static inline OtfKerningPair* pairs_insert (OtfKerning* kerning, Uint32 key);
+static inline OtfKerning*     compile_gpos (OtfKerning* kerning, OtfGpos* gpos);
+static inline OtfKerning*     compile_kern (OtfKerning* kerning, OtfKern* kern);
+static inline OtfKerning*     compile_gpos_lookup (
+    OtfKerning*        kerning,
+    OtfGposPairAdjust* adjs,
+    Size               first_order,
+    Size               count
+);
+static inline OtfKerningClassTable* class_table_init (
+    OtfKerningClassTable* table,
+    OtfKerning*           kerning,
+    Uint16                table_index,
+    Uint16                order,
+    Uint16                class_lookup,
+    OtfGposPairAdjust*    adj
+);
+static inline OtfKerningClassTable* class_table_deinit (OtfKerningClassTable* table);
+static inline Int16 class_table_get (OtfKerningClassTable* table, Uint16 left_class, Uint16 right);
+static inline Int16 saturate_i16 (Int32 value);
+
+#define PAIR_KEY(left, right) (((Uint32)(left) << 16) | (Uint32)(right))
+#define PAIR_HASH(key, shift) ((Uint32)((key) * 0x9e3779b1u) >> (shift))
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Compile kerning pairs from GPOS pair adjustment subtables, or from
+ * kern table when GPOS does not have any kerning data.
+ *
+ * @param kerning Kerning object to be initialized.
+ * @param gpos Decoded GPOS table. Can be @c Null if font does not have one.
+ * @param kern Decoded kern table. Can be @c Null if font does not have one.
+ * @param num_glyphs Number of glyphs in font (from maxp table).
+ *
+ * @return @c kerning on success.
+ * @return @c Null otherwise.
+ * */
+OtfKerning*
+    otf_kerning_init (OtfKerning* kerning, OtfGpos* gpos, OtfKern* kern, Uint16 num_glyphs) {
+    RETURN_VALUE_IF (!kerning, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (kerning, 0, sizeof (OtfKerning));
+    kerning->num_glyphs = num_glyphs;
+
+    /* GPOS takes precedence over kern table, just like shaping engines do */
+    if (gpos && gpos->num_pair_adjustments) {
+        GOTO_HANDLER_IF (
+            !compile_gpos (kerning, gpos),
+            INIT_FAILED,
+            "Failed to compile GPOS pair adjustments\n"
+        );
+    } else if (kern && kern->num_tables) {
+        GOTO_HANDLER_IF (
+            !compile_kern (kerning, kern),
+            INIT_FAILED,
+            "Failed to compile kern table pairs\n"
+        );
+    }
+
+    return kerning;
+
+INIT_FAILED:
+    otf_kerning_deinit (kerning);
+    return Null;
+}
+
+/**
+ * @b De-initialize given kerning object.
+ *
+ * @param kerning
+ *
+ * @return @c kerning on success.
+ * @return @c Null otherwise.
+ * */
+OtfKerning* otf_kerning_deinit (OtfKerning* kerning) {
+    RETURN_VALUE_IF (!kerning, Null, ERR_INVALID_ARGUMENTS);
+
+    if (kerning->pairs) {
+        FREE (kerning->pairs);
+    }
+
+    if (kerning->class_tables) {
+        for (Size s = 0; s < kerning->num_class_tables; s++) {
+            class_table_deinit (kerning->class_tables + s);
+        }
+
+        FREE (kerning->class_tables);
+    }
+
+    if (kerning->left_class_table) {
+        FREE (kerning->left_class_table);
+    }
+
+    if (kerning->left_class) {
+        FREE (kerning->left_class);
+    }
+
+    memset (kerning, 0, sizeof (OtfKerning));
+
+    return kerning;
+}
+
+/**
+ * @b Get horizontal kerning value to be applied between given pair of glyphs.
+ *
+ * @param kerning
+ * @param left Glyph index of left glyph.
+ * @param right Glyph index of right glyph.
+ *
+ * @return Kerning value in font design units, zero if pair is not kerned.
+ * */
+Int16 otf_kerning_get (OtfKerning* kerning, Uint16 left, Uint16 right) {
+    RETURN_VALUE_IF (!kerning, 0, ERR_INVALID_ARGUMENTS);
+
+    OtfKerningPair* pair  = pairs_find (kerning, PAIR_KEY (left, right));
+    Int32           value = pair ? pair->value : 0;
+
+    /* glyph pair values are relative to class values, so owning class tables always add up */
+    if (left < kerning->num_glyphs) {
+        for (Size l = 0; l < kerning->num_class_lookups; l++) {
+            Size   slot        = l * kerning->num_glyphs + left;
+            Uint16 table_index = kerning->left_class_table[slot];
+
+            if (table_index != OTF_KERNING_CLASS_TABLE_NONE) {
+                value += class_table_get (
+                    kerning->class_tables + table_index,
+                    kerning->left_class[slot],
+                    right
+                );
+            }
+        }
+    }
+
+    return saturate_i16 (value);
+}
+
+OtfKerning* otf_kerning_pprint (OtfKerning* kerning, Uint8 indent_level) {
+    RETURN_VALUE_IF (!kerning, Null, ERR_INVALID_ARGUMENTS);
+
+    Char indent[indent_level + 1];
+    memset (indent, '\t', indent_level);
+    indent[indent_level] = 0;
+
+    printf (
+        "|%.*s|OTF Compiled Kerning :\n"
+        "|%s|num_glyphs = %u\n"
+        "|%s|pair_count = %zu\n"
+        "|%s|pair_capacity = %zu\n"
+        "|%s|num_class_tables = %u\n"
+        "|%s|num_class_lookups = %u\n",
+        indent_level - 1 ? indent_level - 1 : 1,
+        indent,
+        indent,
+        kerning->num_glyphs,
+        indent,
+        kerning->pair_count,
+        indent,
+        kerning->pair_capacity,
+        indent,
+        kerning->num_class_tables,
+        indent,
+        kerning->num_class_lookups
+    );
+
+    return kerning;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Allocate hash table large enough to hold given number of pairs
+ * while keeping load factor under 0.5.
+ * */
+static inline OtfKerning* pairs_reserve (OtfKerning* kerning, Size count) {
+    RETURN_VALUE_IF (!kerning, Null, ERR_INVALID_ARGUMENTS);
+
+    if (!count) {
+        return kerning;
+    }
+
+    Size  capacity = 16;
+    Uint8 shift    = 32 - 4;
+    while (capacity < count * 2) {
+        capacity <<= 1;
+        shift--;
+    }
+
+    RETURN_VALUE_IF (
+        !(kerning->pairs = ALLOCATE (OtfKerningPair, capacity)),
+        Null,
+        ERR_OUT_OF_MEMORY
+    );
+
+    for (Size s = 0; s < capacity; s++) {
+        kerning->pairs[s].key = OTF_KERNING_PAIR_EMPTY_KEY;
+    }
+
+    kerning->pair_capacity = capacity;
+    kerning->hash_shift    = shift;
+
+    return kerning;
+}
+
+static inline OtfKerningPair* pairs_find (OtfKerning* kerning, Uint32 key) {
+    if (!kerning->pairs) {
+        return Null;
+    }
+
+    Size mask = kerning->pair_capacity - 1;
+    for (Size s = PAIR_HASH (key, kerning->hash_shift);; s = (s + 1) & mask) {
+        if (kerning->pairs[s].key == key) {
+            return kerning->pairs + s;
+        }
+
+        if (kerning->pairs[s].key == OTF_KERNING_PAIR_EMPTY_KEY) {
+            return Null;
+        }
+    }
+}
+
+/**
+ * @b Find slot for given key, claiming an empty one if key is not present.
+ * Caller must check whether slot was claimed by comparing @c pair_count.
+ * Hash table must already have enough capacity.
+ * */
+static inline OtfKerningPair* pairs_insert (OtfKerning* kerning, Uint32 key) {
+    Size mask = kerning->pair_capacity - 1;
+    for (Size s = PAIR_HASH (key, kerning->hash_shift);; s = (s + 1) & mask) {
+        if (kerning->pairs[s].key == key) {
+            return kerning->pairs + s;
+        }
+
+        if (kerning->pairs[s].key == OTF_KERNING_PAIR_EMPTY_KEY) {
+            kerning->pairs[s].key = key;
+            kerning->pair_count++;
+            return kerning->pairs + s;
+        }
+    }
+}
+
+static inline OtfKerning* compile_gpos (OtfKerning* kerning, OtfGpos* gpos) {
+    RETURN_VALUE_IF (!kerning || !gpos, Null, ERR_INVALID_ARGUMENTS);
+
+    /* count pairs, class subtables and lookups having class subtables to allocate in one go */
+    Size  pair_count         = 0;
+    Size  class_adj_count    = 0;
+    Size  class_lookup_count = 0;
+    Int32 last_class_lookup  = -1;
+    for (Size s = 0; s < gpos->num_pair_adjustments; s++) {
+        OtfGposPairAdjust* adj = gpos->pair_adjustments + s;
+        if (adj->pos_format == 1) {
+            for (Size p = 0; p < adj->format1.num_pair_sets; p++) {
+                pair_count += adj->format1.pair_sets[p].num_pair_values;
+            }
+        } else {
+            class_adj_count++;
+            if (adj->lookup_index != last_class_lookup) {
+                last_class_lookup = adj->lookup_index;
+                class_lookup_count++;
+            }
+        }
+    }
+
+    RETURN_VALUE_IF (!pairs_reserve (kerning, pair_count), Null, "Failed to reserve pairs\n");
+
+    if (class_adj_count) {
+        Size num_slots = class_lookup_count * kerning->num_glyphs;
+        RETURN_VALUE_IF (
+            !(kerning->class_tables = ALLOCATE (OtfKerningClassTable, class_adj_count)) ||
+                !(kerning->left_class_table = ALLOCATE (Uint16, MAX (num_slots, 1))) ||
+                !(kerning->left_class = ALLOCATE (Uint16, MAX (num_slots, 1))),
+            Null,
+            ERR_OUT_OF_MEMORY
+        );
+
+        for (Size g = 0; g < num_slots; g++) {
+            kerning->left_class_table[g] = OTF_KERNING_CLASS_TABLE_NONE;
+        }
+    }
+
+    /* subtables are stored in lookup order, compile one lookup at a time */
+    for (Size s = 0; s < gpos->num_pair_adjustments;) {
+        Size count = 1;
+        while (s + count < gpos->num_pair_adjustments &&
+               gpos->pair_adjustments[s + count].lookup_index ==
+                   gpos->pair_adjustments[s].lookup_index) {
+            count++;
+        }
+
+        RETURN_VALUE_IF (
+            !compile_gpos_lookup (kerning, gpos->pair_adjustments + s, s, count),
+            Null,
+            "Failed to compile GPOS lookup %u\n",
+            gpos->pair_adjustments[s].lookup_index
+        );
+
+        s += count;
+    }
+
+    return kerning;
+}
+
+/**
+ * @b Compile all pair adjustment subtables of one GPOS lookup.
+ *
+ * Within a lookup only the first matching subtable applies. Class subtables are
+ * compiled first so that a glyph pair can be checked against the class subtable
+ * owning it's left glyph : pairs shadowed by an earlier class subtable are dropped,
+ * and pairs that take precedence store their value relative to the class value.
+ *
+ * @param kerning
+ * @param adjs Subtables of lookup, in application order.
+ * @param first_order Position of first subtable among all pair adjustment subtables.
+ * @param count Number of subtables in lookup.
+ *
+ * @return @c kerning on success.
+ * @return @c Null otherwise.
+ * */
+static inline OtfKerning* compile_gpos_lookup (
+    OtfKerning*        kerning,
+    OtfGposPairAdjust* adjs,
+    Size               first_order,
+    Size               count
+) {
+    RETURN_VALUE_IF (!kerning || !adjs, Null, ERR_INVALID_ARGUMENTS);
+
+    Uint16 lookup       = adjs->lookup_index;
+    Bool   has_classes  = False;
+    Uint16 class_lookup = kerning->num_class_lookups;
+
+    for (Size s = 0; s < count; s++) {
+        if (adjs[s].pos_format != 2) {
+            continue;
+        }
+
+        RETURN_VALUE_IF (
+            !class_table_init (
+                kerning->class_tables + kerning->num_class_tables,
+                kerning,
+                kerning->num_class_tables,
+                first_order + s,
+                class_lookup,
+                adjs + s
+            ),
+            Null,
+            "Failed to compile class pair adjustment subtable\n"
+        );
+        kerning->num_class_tables++;
+        has_classes = True;
+    }
+
+    if (has_classes) {
+        kerning->num_class_lookups++;
+    }
+
+    for (Size s = 0; s < count; s++) {
+        OtfGposPairAdjust* adj = adjs + s;
+        if (adj->pos_format != 1) {
+            continue;
+        }
+
+        for (Size p = 0; p < adj->format1.num_pair_sets; p++) {
+            OtfGposPairSet* set  = adj->format1.pair_sets + p;
+            Uint16          left = adj->covered_glyphs[p];
+
+            /* class subtable owning left glyph in this lookup, if any */
+            OtfKerningClassTable* owner      = Null;
+            Uint16                left_class = 0;
+            if (has_classes && left < kerning->num_glyphs) {
+                Size   slot        = (Size)class_lookup * kerning->num_glyphs + left;
+                Uint16 table_index = kerning->left_class_table[slot];
+                if (table_index != OTF_KERNING_CLASS_TABLE_NONE) {
+                    owner      = kerning->class_tables + table_index;
+                    left_class = kerning->left_class[slot];
+                }
+            }
+
+            /* an earlier class subtable always matches, rest of the pairs never apply */
+            if (owner && owner->order < first_order + s) {
+                continue;
+            }
+
+            for (Size v = 0; v < set->num_pair_values; v++) {
+                Uint16          right      = set->pair_values[v].second_glyph;
+                Size            prev_count = kerning->pair_count;
+                OtfKerningPair* pair       = pairs_insert (kerning, PAIR_KEY (left, right));
+
+                if (kerning->pair_count != prev_count) {
+                    pair->value = 0;
+                } else if (pair->lookup == lookup) {
+                    /* an earlier subtable in this lookup already matched */
+                    continue;
+                }
+
+                Int32 adjustment = set->pair_values[v].x_advance;
+                if (owner) {
+                    adjustment -= class_table_get (owner, left_class, right);
+                }
+
+                pair->value  = saturate_i16 (pair->value + adjustment);
+                pair->lookup = lookup;
+            }
+        }
+    }
+
+    return kerning;
+}
+
+static inline OtfKerning* compile_kern (OtfKerning* kerning, OtfKern* kern) {
+    RETURN_VALUE_IF (!kerning || !kern, Null, ERR_INVALID_ARGUMENTS);
+
+    Uint16 usable_mask = OTF_KERN_COVERAGE_HORIZONTAL | OTF_KERN_COVERAGE_MINIMUM |
+                         OTF_KERN_COVERAGE_CROSS_STREAM;
+
+    Size pair_count = 0;
+    for (Size s = 0; s < kern->num_tables; s++) {
+        OtfKernSubtable* subtable = kern->subtables + s;
+        if ((subtable->coverage & usable_mask) == OTF_KERN_COVERAGE_HORIZONTAL) {
+            pair_count += subtable->num_pairs;
+        }
+    }
+
+    RETURN_VALUE_IF (!pairs_reserve (kerning, pair_count), Null, "Failed to reserve pairs\n");
+
+    /* values from kern subtables accumulate unless override bit is set */
+    for (Size s = 0; s < kern->num_tables; s++) {
+        OtfKernSubtable* subtable = kern->subtables + s;
+        if ((subtable->coverage & usable_mask) != OTF_KERN_COVERAGE_HORIZONTAL) {
+            continue;
+        }
+
+        Bool does_override = subtable->coverage & OTF_KERN_COVERAGE_OVERRIDE;
+        for (Size p = 0; p < subtable->num_pairs; p++) {
+            OtfKernPair*    kp         = subtable->pairs + p;
+            Size            prev_count = kerning->pair_count;
+            OtfKerningPair* pair       = pairs_insert (kerning, PAIR_KEY (kp->left, kp->right));
+
+            if (kerning->pair_count != prev_count || does_override) {
+                pair->value = kp->value;
+            } else {
+                pair->value += kp->value;
+            }
+        }
+    }
+
+    return kerning;
+}
+
+/**
+ * @b Compile a class pair adjustment subtable and claim ownership of all covered
+ * left glyphs that are not already owned by an earlier class subtable of the same lookup.
+ *
+ * @param class_lookup Row of glyph ownership tables that belongs to subtable's lookup.
+ * */
+static inline OtfKerningClassTable* class_table_init (
+    OtfKerningClassTable* table,
+    OtfKerning*           kerning,
+    Uint16                table_index,
+    Uint16                order,
+    Uint16                class_lookup,
+    OtfGposPairAdjust*    adj
+) {
+    RETURN_VALUE_IF (!table || !kerning || !adj, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (table, 0, sizeof (OtfKerningClassTable));
+
+    table->order        = order;
+    table->class1_count = adj->format2.class1_count;
+    table->class2_count = adj->format2.class2_count;
+
+    Size matrix_size = (Size)table->class1_count * table->class2_count;
+    if (!matrix_size) {
+        return table;
+    }
+
+    RETURN_VALUE_IF (
+        !(table->matrix = ALLOCATE (Int16, matrix_size)),
+        Null,
+        ERR_OUT_OF_MEMORY
+    );
+    memcpy (table->matrix, adj->format2.x_advances, matrix_size * sizeof (Int16));
+
+    /* class of right glyph, spanning from first to last glyph in ClassDef2 */
+    OtfGposClassDef* class_def2 = &adj->format2.class_def2;
+    if (class_def2->num_ranges) {
+        Uint16 first = (Uint16)-1;
+        Uint16 last  = 0;
+        for (Size r = 0; r < class_def2->num_ranges; r++) {
+            first = MIN (first, class_def2->ranges[r].start_glyph_id);
+            last  = MAX (last, class_def2->ranges[r].end_glyph_id);
+        }
+
+        table->first_class2_glyph = first;
+        table->num_class2_glyphs  = last - first + 1;
+
+        GOTO_HANDLER_IF (
+            !(table->class2 = ALLOCATE (Uint16, (Size)last - first + 1)),
+            INIT_FAILED,
+            ERR_OUT_OF_MEMORY
+        );
+
+        for (Size r = 0; r < class_def2->num_ranges; r++) {
+            OtfGposClassRange* range = class_def2->ranges + r;
+
+            /* out of range classes can never match, treat them as class 0 */
+            if (range->class_value >= table->class2_count) {
+                continue;
+            }
+
+            for (Size g = range->start_glyph_id; g <= range->end_glyph_id; g++) {
+                table->class2[g - first] = range->class_value;
+            }
+        }
+    }
+
+    /* claim covered left glyphs, glyphs not in ClassDef1 belong to class 0 */
+    Size             row        = (Size)class_lookup * kerning->num_glyphs;
+    Uint16*          owners     = kerning->left_class_table + row;
+    Uint16*          classes    = kerning->left_class + row;
+    OtfGposClassDef* class_def1 = &adj->format2.class_def1;
+    for (Size c = 0; c < adj->num_covered_glyphs; c++) {
+        Uint16 glyph = adj->covered_glyphs[c];
+        if (glyph >= kerning->num_glyphs || owners[glyph] != OTF_KERNING_CLASS_TABLE_NONE) {
+            continue;
+        }
+
+        owners[glyph]  = table_index;
+        classes[glyph] = 0;
+    }
+
+    for (Size r = 0; r < class_def1->num_ranges; r++) {
+        OtfGposClassRange* range = class_def1->ranges + r;
+        Size               end   = MIN ((Size)range->end_glyph_id + 1, kerning->num_glyphs);
+
+        for (Size g = range->start_glyph_id; g < end; g++) {
+            if (owners[g] != table_index) {
+                continue;
+            }
+
+            /* subtable does not apply to glyphs with out of range class */
+            if (range->class_value >= table->class1_count) {
+                owners[g] = OTF_KERNING_CLASS_TABLE_NONE;
+            } else {
+                classes[g] = range->class_value;
+            }
+        }
+    }
+
+    return table;
+
+INIT_FAILED:
+    class_table_deinit (table);
+    return Null;
+}
+
+static inline OtfKerningClassTable* class_table_deinit (OtfKerningClassTable* table) {
+    RETURN_VALUE_IF (!table, Null, ERR_INVALID_ARGUMENTS);
+
+    if (table->class2) {
+        FREE (table->class2);
+    }
+
+    if (table->matrix) {
+        FREE (table->matrix);
+    }
+
+    memset (table, 0, sizeof (OtfKerningClassTable));
+
+    return table;
+}
+
+/**
+ * @b Get value from class matrix for given class of left glyph and given right glyph.
+ * */
+static inline Int16 class_table_get (OtfKerningClassTable* table, Uint16 left_class, Uint16 right) {
+    if (!table->matrix) {
+        return 0;
+    }
+
+    Uint16 right_class = 0;
+    if ((Uint16)(right - table->first_class2_glyph) < table->num_class2_glyphs) {
+        right_class = table->class2[right - table->first_class2_glyph];
+    }
+
+    return table->matrix[(Size)left_class * table->class2_count + right_class];
+}
+
+static inline Int16 saturate_i16 (Int32 value) {
+    return (Int16)MAX (MIN (value, 0x7fff), -0x8000);
+}
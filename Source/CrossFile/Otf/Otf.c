@@ -34,17 +34,29 @@
 
 /* libc */
 #include <memory.h>
+#include <string.h>
 
-#include "Anvie/CrossFile/Otf/Tables/Maxp.h"
+/* local includes */
+#include "../Stream/Stream.h"
 
 OtfFile* otf_file_open (OtfFile* otf_file, CString filename) {
     RETURN_VALUE_IF (!otf_file || !filename, Null, ERR_INVALID_ARGUMENTS);
 
-    /* read whole file */
-    RETURN_VALUE_IF (!xf_file_open (&otf_file->file, filename), Null, ERR_FILE_OPEN_FAILED);
+    memset (otf_file, 0, sizeof (OtfFile));
+
+    /* map whole file, decoded tables keep pointing into it */
+    otf_file->stream = io_stream_open_mapped_file (filename);
+    RETURN_VALUE_IF (!otf_file->stream, Null, ERR_FILE_OPEN_FAILED);
+    otf_file->data = otf_file->stream->data;
+    otf_file->size = otf_file->stream->size;
+    GOTO_HANDLER_IF (!(otf_file->file_name = strdup (filename)), INIT_FAILED, ERR_OUT_OF_MEMORY);
 
     /* load table directory */
-    otf_table_dir_init (&otf_file->table_directory, otf_file->file.data, otf_file->file.size);
+    GOTO_HANDLER_IF (
+        !otf_table_dir_init (&otf_file->table_directory, otf_file->data, otf_file->size),
+        INIT_FAILED,
+        "Failed to read table directory.\n"
+    );
 
     /* if this value is 8 in the end then we've possibly found all the required records
      * REF : https://learn.microsoft.com/en-us/typography/opentype/spec/otff#font-tables */
@@ -63,7 +75,7 @@ OtfFile* otf_file_open (OtfFile* otf_file, CString filename) {
                 GOTO_HANDLER_IF (
                     !otf_cmap_init (
                         &otf_file->cmap,
-                        otf_file->file.data + record->offset,
+                        otf_file->data + record->offset,
                         record->length
                     ),
                     INIT_FAILED,
@@ -77,7 +89,7 @@ OtfFile* otf_file_open (OtfFile* otf_file, CString filename) {
                 GOTO_HANDLER_IF (
                     !otf_head_init (
                         &otf_file->head,
-                        otf_file->file.data + record->offset,
+                        otf_file->data + record->offset,
                         record->length
                     ),
                     INIT_FAILED,
@@ -91,7 +103,7 @@ OtfFile* otf_file_open (OtfFile* otf_file, CString filename) {
                 GOTO_HANDLER_IF (
                     !otf_hhea_init (
                         &otf_file->hhea,
-                        otf_file->file.data + record->offset,
+                        otf_file->data + record->offset,
                         record->length
                     ),
                     INIT_FAILED,
@@ -102,7 +114,7 @@ OtfFile* otf_file_open (OtfFile* otf_file, CString filename) {
             }
 
             case OTF_TABLE_TAG_HMTX : {
-                hmtx_data      = otf_file->file.data + record->offset;
+                hmtx_data      = otf_file->data + record->offset;
                 hmtx_data_size = record->length;
                 break;
             }
@@ -111,7 +123,7 @@ OtfFile* otf_file_open (OtfFile* otf_file, CString filename) {
                 GOTO_HANDLER_IF (
                     !otf_name_init (
                         &otf_file->name,
-                        otf_file->file.data + record->offset,
+                        otf_file->data + record->offset,
                         record->length
                     ),
                     INIT_FAILED,
@@ -125,7 +137,7 @@ OtfFile* otf_file_open (OtfFile* otf_file, CString filename) {
                 GOTO_HANDLER_IF (
                     !otf_maxp_init (
                         &otf_file->maxp,
-                        otf_file->file.data + record->offset,
+                        otf_file->data + record->offset,
                         record->length
                     ),
                     INIT_FAILED,
@@ -135,6 +147,31 @@ OtfFile* otf_file_open (OtfFile* otf_file, CString filename) {
                 break;
             }
 
+            /* optional tables are not fatal, font is usable without kerning */
+            case OTF_TABLE_TAG_KERN : {
+                if (!otf_kern_init (
+                        &otf_file->kern,
+                        otf_file->data + record->offset,
+                        record->length
+                    )) {
+                    PRINT_ERR ("Failed to initialize kerning table \"kern\". Ignoring it.\n");
+                }
+                break;
+            }
+
+            case OTF_TABLE_TAG_GPOS : {
+                if (!otf_gpos_init (
+                        &otf_file->gpos,
+                        otf_file->data + record->offset,
+                        record->length
+                    )) {
+                    PRINT_ERR (
+                        "Failed to initialize glyph positioning table \"GPOS\". Ignoring it.\n"
+                    );
+                }
+                break;
+            }
+
             default :
                 continue;
         }
@@ -163,6 +200,18 @@ OtfFile* otf_file_open (OtfFile* otf_file, CString filename) {
         found_required_records_count++;
     }
 
+    /* kerning pairs are compiled once all tables are loaded, needs glyph count from maxp */
+    GOTO_HANDLER_IF (
+        !otf_kerning_init (
+            &otf_file->kerning,
+            &otf_file->gpos,
+            &otf_file->kern,
+            otf_file->maxp.num_glyphs
+        ),
+        INIT_FAILED,
+        "Failed to compile kerning pairs.\n"
+    );
+
     /* check whether we've found all required records */
     GOTO_HANDLER_IF (
         found_required_records_count != 6,
@@ -180,6 +229,9 @@ INIT_FAILED:
 OtfFile* otf_file_close (OtfFile* otf_file) {
     RETURN_VALUE_IF (!otf_file, Null, ERR_INVALID_ARGUMENTS);
 
+    otf_kerning_deinit (&otf_file->kerning);
+    otf_gpos_deinit (&otf_file->gpos);
+    otf_kern_deinit (&otf_file->kern);
     otf_name_deinit (&otf_file->name);
     otf_hmtx_deinit (&otf_file->hmtx);
     otf_cmap_deinit (&otf_file->cmap);
@@ -188,7 +240,13 @@ OtfFile* otf_file_close (OtfFile* otf_file) {
         FREE (otf_file->table_directory.table_records);
     }
 
-    xf_file_close (&otf_file->file);
+    if (otf_file->stream) {
+        io_stream_close (otf_file->stream);
+    }
+
+    if (otf_file->file_name) {
+        FREE (otf_file->file_name);
+    }
 
     memset (otf_file, 0, sizeof (OtfFile));
 
@@ -212,9 +270,9 @@ OtfFile* otf_file_pprint (OtfFile* otf_file, Uint8 indent_level) {
         indent_level - 1 ? indent_level - 1 : 1,
         indent,
         indent,
-        otf_file->file.name,
+        otf_file->file_name,
         indent,
-        otf_file->file.size / 1024.f
+        otf_file->size / 1024.f
     );
 
     otf_table_dir_pprint (&otf_file->table_directory, indent_level + 1);
@@ -224,6 +282,72 @@ OtfFile* otf_file_pprint (OtfFile* otf_file, Uint8 indent_level) {
     otf_hmtx_pprint (&otf_file->hmtx, indent_level + 1);
     otf_name_pprint (&otf_file->name, indent_level + 1);
     otf_maxp_pprint (&otf_file->maxp, indent_level + 1);
+    otf_kern_pprint (&otf_file->kern, indent_level + 1);
+    otf_gpos_pprint (&otf_file->gpos, indent_level + 1);
+    otf_kerning_pprint (&otf_file->kerning, indent_level + 1);
 
     return otf_file;
 }
+
+/**
+ * @b Get horizontal kerning adjustment between two glyphs.
+ *
+ * @param otf_file
+ * @param left_glyph Glyph index of left glyph.
+ * @param right_glyph Glyph index of right glyph.
+ *
+ * @return Kerning value in font design units. Zero if pair is not kerned.
+ * */
+Int16 otf_file_get_kerning (OtfFile* otf_file, Uint16 left_glyph, Uint16 right_glyph) {
+    RETURN_VALUE_IF (!otf_file, 0, ERR_INVALID_ARGUMENTS);
+    return otf_kerning_get (&otf_file->kerning, left_glyph, right_glyph);
+}
+
+/**
+ * @b Estimate number of bytes of memory held by given decoded font.
+ *
+ * Raw file stays mapped for whole lifetime of font, so it's counted in
+ * full. Decoded tables are roughly as large as their binary representation,
+ * so sizes of decoded tables from table directory are used for those.
+ * Compiled kerning data is accounted for exactly.
+ *
+ * @param otf_file
+ *
+ * @return Estimated decoded size in bytes.
+ * */
+Size otf_file_get_decoded_size (OtfFile* otf_file) {
+    RETURN_VALUE_IF (!otf_file, 0, ERR_INVALID_ARGUMENTS);
+
+    Size size = sizeof (OtfFile) + otf_file->size +
+                sizeof (OtfTableRecord) * otf_file->table_directory.num_tables;
+
+    for (Size s = 0; s < otf_file->table_directory.num_tables; s++) {
+        OtfTableRecord* record = otf_file->table_directory.table_records + s;
+        switch (record->table_tag) {
+            case OTF_TABLE_TAG_CMAP :
+            case OTF_TABLE_TAG_HMTX :
+            case OTF_TABLE_TAG_NAME :
+            case OTF_TABLE_TAG_KERN :
+            case OTF_TABLE_TAG_GPOS :
+                size += record->length;
+                break;
+            default :
+                break;
+        }
+    }
+
+    OtfKerning* kerning = &otf_file->kerning;
+    size += sizeof (OtfKerningPair) * kerning->pair_capacity;
+
+    for (Size s = 0; s < kerning->num_class_tables; s++) {
+        OtfKerningClassTable* table = kerning->class_tables + s;
+        size += sizeof (OtfKerningClassTable) + sizeof (Uint16) * table->num_class2_glyphs +
+                sizeof (Int16) * table->class1_count * table->class2_count;
+    }
+
+    if (kerning->left_class_table) {
+        size += sizeof (Uint16) * 2 * kerning->num_glyphs * kerning->num_class_lookups;
+    }
+
+    return size;
+}
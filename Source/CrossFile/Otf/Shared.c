@@ -0,0 +1,304 @@
+/**
+ * @file Shared.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Otf/Compiled.h>
+#include <Anvie/CrossFile/Otf/Otf.h>
+#include <Anvie/CrossFile/Otf/Shared.h>
+
+/* libc */
+#include <memory.h>
+#include <stdatomic.h>
+
+/**
+ * @b Lazily compiled cmap, published once per shared file.
+ * */
+typedef struct OtfSharedCmap {
+    Size                  count;
+    OtfCompiledCmapGroup* groups;
+} OtfSharedCmap;
+
+struct OtfSharedFile {
+    atomic_size_t            ref_count;
+    OtfFile                  file;
+    _Atomic (OtfSharedCmap*) cmap;
+};
+
+/* private method declarations */
+
+static inline OtfSharedCmap* shared_cmap_get (OtfSharedFile* shared);
+static inline void           shared_file_destroy (OtfSharedFile* shared);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Open and decode given font file into a new shared handle.
+ *
+ * @param filename Path of font file.
+ *
+ * @return New shared handle with a reference count of one on success.
+ * @return @c Null otherwise.
+ * */
+OtfSharedFile* otf_shared_file_open (CString filename) {
+    RETURN_VALUE_IF (!filename, Null, ERR_INVALID_ARGUMENTS);
+
+    OtfSharedFile* shared = NEW (OtfSharedFile);
+    RETURN_VALUE_IF (!shared, Null, ERR_OUT_OF_MEMORY);
+
+    if (!otf_file_open (&shared->file, filename)) {
+        PRINT_ERR ("Failed to open font file \"%s\"\n", filename);
+        FREE (shared);
+        return Null;
+    }
+
+    atomic_init (&shared->ref_count, 1);
+    atomic_init (&shared->cmap, Null);
+
+    return shared;
+}
+
+/**
+ * @b Take a new reference to given shared handle.
+ *
+ * @param shared
+ *
+ * @return @c shared on success.
+ * @return @c Null otherwise.
+ * */
+OtfSharedFile* otf_shared_file_ref (OtfSharedFile* shared) {
+    RETURN_VALUE_IF (!shared, Null, ERR_INVALID_ARGUMENTS);
+
+    /* a new reference can only be made from an existing one, so no ordering is required */
+    atomic_fetch_add_explicit (&shared->ref_count, 1, memory_order_relaxed);
+
+    return shared;
+}
+
+/**
+ * @b Drop a reference to given shared handle. Handle is destroyed when
+ * last reference is dropped.
+ *
+ * @param shared
+ * */
+void otf_shared_file_unref (OtfSharedFile* shared) {
+    RETURN_IF (!shared, ERR_INVALID_ARGUMENTS);
+
+    /* release makes all our accesses visible to the thread that destroys the handle */
+    if (atomic_fetch_sub_explicit (&shared->ref_count, 1, memory_order_release) == 1) {
+        atomic_thread_fence (memory_order_acquire);
+        shared_file_destroy (shared);
+    }
+}
+
+/**
+ * @b Get decoded font. Returned object must be treated as read-only.
+ *
+ * @param shared
+ *
+ * @return Decoded font on success.
+ * @return @c Null otherwise.
+ * */
+const OtfFile* otf_shared_file_get_file (OtfSharedFile* shared) {
+    RETURN_VALUE_IF (!shared, Null, ERR_INVALID_ARGUMENTS);
+    return &shared->file;
+}
+
+/**
+ * @b Get current number of references. Only meant for diagnostics,
+ * value may already be stale when returned.
+ * */
+Size otf_shared_file_get_ref_count (OtfSharedFile* shared) {
+    RETURN_VALUE_IF (!shared, 0, ERR_INVALID_ARGUMENTS);
+    return atomic_load_explicit (&shared->ref_count, memory_order_relaxed);
+}
+
+/**
+ * @b Get glyph id for given unicode character code.
+ * First call compiles cmap, all later calls are a binary search.
+ *
+ * @param shared
+ * @param char_code Unicode character code.
+ *
+ * @return Glyph id on success.
+ * @return @c 0 (missing glyph) if character is not mapped.
+ * */
+Uint32 otf_shared_file_get_glyph_id (OtfSharedFile* shared, Uint32 char_code) {
+    RETURN_VALUE_IF (!shared, 0, ERR_INVALID_ARGUMENTS);
+
+    OtfSharedCmap* cmap = shared_cmap_get (shared);
+    RETURN_VALUE_IF (!cmap, 0, "Failed to get compiled cmap\n");
+
+    return otf_compiled_cmap_groups_find (cmap->groups, cmap->count, char_code);
+}
+
+/**
+ * @b Get advance width of given glyph.
+ *
+ * @return Advance width in font design units. Zero if glyph id is out of range.
+ * */
+Uint16 otf_shared_file_get_advance_width (OtfSharedFile* shared, Uint32 glyph_id) {
+    RETURN_VALUE_IF (!shared, 0, ERR_INVALID_ARGUMENTS);
+
+    const OtfHmtx* hmtx = &shared->file.hmtx;
+    if (!hmtx->num_h_metrics ||
+        glyph_id >= (Size)hmtx->num_h_metrics + hmtx->num_left_side_bearings) {
+        return 0;
+    }
+
+    /* glyphs after last long metric share it's advance width */
+    return hmtx->h_metrics[MIN (glyph_id, hmtx->num_h_metrics - 1u)].advance_width;
+}
+
+/**
+ * @b Get left side bearing of given glyph.
+ *
+ * @return Left side bearing in font design units. Zero if glyph id is out of range.
+ * */
+Int16 otf_shared_file_get_left_side_bearing (OtfSharedFile* shared, Uint32 glyph_id) {
+    RETURN_VALUE_IF (!shared, 0, ERR_INVALID_ARGUMENTS);
+
+    const OtfHmtx* hmtx = &shared->file.hmtx;
+    if (glyph_id < hmtx->num_h_metrics) {
+        return hmtx->h_metrics[glyph_id].left_side_bearing;
+    }
+
+    glyph_id -= hmtx->num_h_metrics;
+    return glyph_id < hmtx->num_left_side_bearings ? hmtx->left_side_bearings[glyph_id] : 0;
+}
+
+/**
+ * @b Get horizontal kerning adjustment between two glyphs.
+ *
+ * @return Kerning value in font design units. Zero if pair is not kerned.
+ * */
+Int16 otf_shared_file_get_kerning (OtfSharedFile* shared, Uint16 left, Uint16 right) {
+    RETURN_VALUE_IF (!shared, 0, ERR_INVALID_ARGUMENTS);
+    return otf_kerning_get (&shared->file.kerning, left, right);
+}
+
+/**
+ * @b Get raw bytes of a string from name table.
+ * Strings are returned exactly as they appear in font file (eg: UTF-16BE for Windows platform).
+ *
+ * @param shared
+ * @param name_id Name id of required string.
+ * @param platform_id
+ * @param encoding_id
+ * @param language_id
+ * @param length Will contain length of string in bytes.
+ *
+ * @return Pointer to string bytes on success.
+ * @return @c Null otherwise.
+ * */
+const Char* otf_shared_file_get_name (
+    OtfSharedFile* shared,
+    OtfNameId      name_id,
+    Uint16         platform_id,
+    Uint16         encoding_id,
+    Uint16         language_id,
+    Size*          length
+) {
+    RETURN_VALUE_IF (!shared || !length, Null, ERR_INVALID_ARGUMENTS);
+
+    const OtfName* name = &shared->file.name;
+    for (Size r = 0; r < name->num_name_records; r++) {
+        const OtfNameRecord* record = name->name_records + r;
+        if (record->name_id == name_id && record->platform_encoding.platform == platform_id &&
+            record->platform_encoding.encoding.custom == encoding_id &&
+            record->language.language.custom == language_id &&
+            (Size)record->string_offset + record->length <= name->string_data_size) {
+            *length = record->length;
+            return name->string_data + record->string_offset;
+        }
+    }
+
+    *length = 0;
+    return Null;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Get compiled cmap, building and publishing it on first use.
+ *
+ * No lock is taken. Multiple threads may build the cmap at the same time,
+ * but only one of them succeeds in publishing it.
+ * */
+static inline OtfSharedCmap* shared_cmap_get (OtfSharedFile* shared) {
+    OtfSharedCmap* cmap = atomic_load_explicit (&shared->cmap, memory_order_acquire);
+    if (cmap) {
+        return cmap;
+    }
+
+    OtfSharedCmap* new_cmap = NEW (OtfSharedCmap);
+    RETURN_VALUE_IF (!new_cmap, Null, ERR_OUT_OF_MEMORY);
+
+    /* a font that does not map any character gets an empty cmap */
+    new_cmap->groups = otf_compiled_cmap_groups_create (&shared->file.cmap, &new_cmap->count);
+
+    if (!atomic_compare_exchange_strong_explicit (
+            &shared->cmap,
+            &cmap,
+            new_cmap,
+            memory_order_acq_rel,
+            memory_order_acquire
+        )) {
+        /* lost the race, cmap now contains the published one */
+        if (new_cmap->groups) {
+            FREE (new_cmap->groups);
+        }
+        FREE (new_cmap);
+        return cmap;
+    }
+
+    return new_cmap;
+}
+
+static inline void shared_file_destroy (OtfSharedFile* shared) {
+    OtfSharedCmap* cmap = atomic_load_explicit (&shared->cmap, memory_order_relaxed);
+    if (cmap) {
+        if (cmap->groups) {
+            FREE (cmap->groups);
+        }
+        FREE (cmap);
+    }
+
+    otf_file_close (&shared->file);
+    FREE (shared);
+}
@@ -52,7 +52,7 @@
  * @return @c record on success.
  * @return @c Null otherwise.
  * */
-XfOtfTableRecord* xf_otf_table_record_init (XfOtfTableRecord* record, Uint8* data, Size size) {
+OtfTableRecord* otf_table_record_init (OtfTableRecord* record, Uint8* data, Size size) {
     RETURN_VALUE_IF (!record || !data, Null, ERR_INVALID_ARGUMENTS);
     RETURN_VALUE_IF (
         size < 4 * sizeof (Uint32),
@@ -77,7 +77,7 @@ XfOtfTableRecord* xf_otf_table_record_init (XfOtfTableRecord* record, Uint8* dat
  * @return @c record on success.
  * @return @c Null otherwise.
  * */
-XfOtfTableRecord* xf_otf_table_record_pprint (XfOtfTableRecord* record, Uint8 indent_level) {
+OtfTableRecord* otf_table_record_pprint (OtfTableRecord* record, Uint8 indent_level) {
     RETURN_VALUE_IF (!record, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -120,10 +120,10 @@ XfOtfTableRecord* xf_otf_table_record_pprint (XfOtfTableRecord* record, Uint8 in
  * @return @c dir on success.
  * @return @c Null otherwise.
  * */
-XfOtfTableDir* xf_otf_table_dir_init (XfOtfTableDir* dir, Uint8* data, Size size) {
+OtfTableDir* otf_table_dir_init (OtfTableDir* dir, Uint8* data, Size size) {
     RETURN_VALUE_IF (!dir || !data, Null, ERR_INVALID_ARGUMENTS);
     RETURN_VALUE_IF (
-        size < XF_OTF_TABLE_DIR_DATA_SIZE,
+        size < OTF_TABLE_DIR_DATA_SIZE,
         Null,
         "Data buffer size not sufficient to initialize font header table.\n"
     );
@@ -143,19 +143,19 @@ XfOtfTableDir* xf_otf_table_dir_init (XfOtfTableDir* dir, Uint8* data, Size size
     dir->entry_selector = GET_AND_ADV_U2 (data);
     dir->range_shift    = GET_AND_ADV_U2 (data);
 
-    dir->table_records = ALLOCATE (XfOtfTableRecord, dir->num_tables);
+    dir->table_records = ALLOCATE (OtfTableRecord, dir->num_tables);
     RETURN_VALUE_IF (!dir->table_records, Null, ERR_OUT_OF_MEMORY);
 
-    size -= XF_OTF_TABLE_DIR_DATA_SIZE;
+    size -= OTF_TABLE_DIR_DATA_SIZE;
 
     for (Size table_idx = 0; table_idx < dir->num_tables; table_idx++) {
-        if (!xf_otf_table_record_init (dir->table_records + table_idx, data, size)) {
+        if (!otf_table_record_init (dir->table_records + table_idx, data, size)) {
             PRINT_ERR ("Failed to read a table record\n");
-            xf_otf_table_dir_deinit (dir);
+            otf_table_dir_deinit (dir);
             return Null;
         }
-        data += XF_OTF_TABLE_RECORD_DATA_SIZE;
-        size -= XF_OTF_TABLE_RECORD_DATA_SIZE;
+        data += OTF_TABLE_RECORD_DATA_SIZE;
+        size -= OTF_TABLE_RECORD_DATA_SIZE;
     }
 
     return dir;
@@ -170,14 +170,14 @@ XfOtfTableDir* xf_otf_table_dir_init (XfOtfTableDir* dir, Uint8* data, Size size
  * @return @c dir on success.
  * @return @c Null otherwise.
  * */
-XfOtfTableDir* xf_otf_table_dir_deinit (XfOtfTableDir* dir) {
+OtfTableDir* otf_table_dir_deinit (OtfTableDir* dir) {
     RETURN_VALUE_IF (!dir, Null, ERR_INVALID_ARGUMENTS);
 
     if (dir->table_records) {
         FREE (dir->table_records);
     }
 
-    memset (dir, 0, sizeof (XfOtfTableDir));
+    memset (dir, 0, sizeof (OtfTableDir));
 
     return dir;
 }
@@ -191,7 +191,7 @@ XfOtfTableDir* xf_otf_table_dir_deinit (XfOtfTableDir* dir) {
  * @return @c dir on success.
  * @return @c Null otherwise.
  * */
-XfOtfTableRecord* xf_otf_table_dir_find_record (XfOtfTableDir* dir, XfOtfTableTag table_tag) {
+OtfTableRecord* otf_table_dir_find_record (OtfTableDir* dir, OtfTableTag table_tag) {
     RETURN_VALUE_IF (!dir, Null, ERR_INVALID_ARGUMENTS);
 
     for (Size s = 0; s < dir->num_tables; s++) {
@@ -211,7 +211,7 @@ XfOtfTableRecord* xf_otf_table_dir_find_record (XfOtfTableDir* dir, XfOtfTableTa
  * @return @c record on success.
  * @return @c Null otherwise.
  * */
-XfOtfTableDir* xf_otf_table_dir_pprint (XfOtfTableDir* dir, Uint8 indent_level) {
+OtfTableDir* otf_table_dir_pprint (OtfTableDir* dir, Uint8 indent_level) {
     RETURN_VALUE_IF (!dir, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -240,7 +240,7 @@ XfOtfTableDir* xf_otf_table_dir_pprint (XfOtfTableDir* dir, Uint8 indent_level)
     );
 
     for (Size s = 0; s < dir->num_tables; s++) {
-        xf_otf_table_record_pprint (dir->table_records + s, indent_level + 1);
+        otf_table_record_pprint (dir->table_records + s, indent_level + 1);
     }
 
     return dir;
@@ -40,108 +40,108 @@
 #include <memory.h>
 
 /* fwd declarations of private methods */
-static inline XfOtfCmapEncodingRecord*
-    encoding_record_init (XfOtfCmapEncodingRecord* enc, Uint8* data, Size size);
-static inline XfOtfCmapEncodingRecord* encoding_record_deinit (XfOtfCmapEncodingRecord* enc);
-static inline XfOtfCmapEncodingRecord*
-    encoding_record_pprint (XfOtfCmapEncodingRecord* enc, Uint8 indent_level);
-
-static inline XfOtfCmapSubHeader*
-    sub_header_init (XfOtfCmapSubHeader* sub_head, Uint8* data, Size size);
-static inline XfOtfCmapSubHeader*
-    sub_header_pprint (XfOtfCmapSubHeader* sub_head, Uint8 indent_level);
-
-static inline XfOtfCmapMapGroup* map_group_init (XfOtfCmapMapGroup* group, Uint8* data, Size size);
-static inline XfOtfCmapMapGroup* map_group_pprint (XfOtfCmapMapGroup* group, Uint8 indent_level);
-
-static inline XfOtfCmapVarSelector*
-    var_selector_init (XfOtfCmapVarSelector* sel, Uint8* data, Size size);
-static inline XfOtfCmapVarSelector* var_selector_deinit (XfOtfCmapVarSelector* sel);
-static inline XfOtfCmapVarSelector*
-    var_selector_pprint (XfOtfCmapVarSelector* sel, Uint8 indent_level);
-
-static inline XfOtfCmapUnicodeRange*
-    unicode_range_init (XfOtfCmapUnicodeRange* range, Uint8* data, Size size);
-static inline XfOtfCmapUnicodeRange*
-    unicode_range_pprint (XfOtfCmapUnicodeRange* range, Uint8 indent_level);
-
-static inline XfOtfCmapDefaultUVSTable*
-    default_uvs_table_init (XfOtfCmapDefaultUVSTable* default_uvs, Uint8* data, Size size);
-static inline XfOtfCmapDefaultUVSTable* default_uvs_table_deinit (XfOtfCmapDefaultUVSTable* uvs_map
+static inline OtfCmapEncodingRecord*
+    encoding_record_init (OtfCmapEncodingRecord* enc, Uint8* data, Size size);
+static inline OtfCmapEncodingRecord* encoding_record_deinit (OtfCmapEncodingRecord* enc);
+static inline OtfCmapEncodingRecord*
+    encoding_record_pprint (OtfCmapEncodingRecord* enc, Uint8 indent_level);
+
+static inline OtfCmapSubHeader*
+    sub_header_init (OtfCmapSubHeader* sub_head, Uint8* data, Size size);
+static inline OtfCmapSubHeader*
+    sub_header_pprint (OtfCmapSubHeader* sub_head, Uint8 indent_level);
+
+static inline OtfCmapMapGroup* map_group_init (OtfCmapMapGroup* group, Uint8* data, Size size);
+static inline OtfCmapMapGroup* map_group_pprint (OtfCmapMapGroup* group, Uint8 indent_level);
+
+static inline OtfCmapVarSelector*
+    var_selector_init (OtfCmapVarSelector* sel, Uint8* data, Size size);
+static inline OtfCmapVarSelector* var_selector_deinit (OtfCmapVarSelector* sel);
+static inline OtfCmapVarSelector*
+    var_selector_pprint (OtfCmapVarSelector* sel, Uint8 indent_level);
+
+static inline OtfCmapUnicodeRange*
+    unicode_range_init (OtfCmapUnicodeRange* range, Uint8* data, Size size);
+static inline OtfCmapUnicodeRange*
+    unicode_range_pprint (OtfCmapUnicodeRange* range, Uint8 indent_level);
+
+static inline OtfCmapDefaultUVSTable*
+    default_uvs_table_init (OtfCmapDefaultUVSTable* default_uvs, Uint8* data, Size size);
+static inline OtfCmapDefaultUVSTable* default_uvs_table_deinit (OtfCmapDefaultUVSTable* uvs_map
 );
-static inline XfOtfCmapDefaultUVSTable*
-    default_uvs_table_pprint (XfOtfCmapDefaultUVSTable* uvs_map, Uint8 indent_level);
+static inline OtfCmapDefaultUVSTable*
+    default_uvs_table_pprint (OtfCmapDefaultUVSTable* uvs_map, Uint8 indent_level);
 
-static inline XfOtfCmapUVSMapping*
-    uvs_mapping_init (XfOtfCmapUVSMapping* uvs_map, Uint8* data, Size size);
-static inline XfOtfCmapUVSMapping*
-    uvs_mapping_pprint (XfOtfCmapUVSMapping* uvs_map, Uint8 indent_level);
+static inline OtfCmapUVSMapping*
+    uvs_mapping_init (OtfCmapUVSMapping* uvs_map, Uint8* data, Size size);
+static inline OtfCmapUVSMapping*
+    uvs_mapping_pprint (OtfCmapUVSMapping* uvs_map, Uint8 indent_level);
 
-static inline XfOtfCmapNonDefaultUVSTable* non_default_uvs_table_init (
-    XfOtfCmapNonDefaultUVSTable* non_default_uvs,
+static inline OtfCmapNonDefaultUVSTable* non_default_uvs_table_init (
+    OtfCmapNonDefaultUVSTable*   non_default_uvs,
     Uint8*                       data,
     Size                         size
 );
-static inline XfOtfCmapNonDefaultUVSTable* non_default_uvs_table_deinit (
-    XfOtfCmapNonDefaultUVSTable* non_default_uvs
+static inline OtfCmapNonDefaultUVSTable* non_default_uvs_table_deinit (
+    OtfCmapNonDefaultUVSTable* non_default_uvs
 );
-static inline XfOtfCmapNonDefaultUVSTable*
-    non_default_uvs_table_pprint (XfOtfCmapNonDefaultUVSTable* non_default_uvs, Uint8 indent_level);
-
-static inline XfOtfCmapSubTableFormat0*
-    sub_table_format0_init (XfOtfCmapSubTableFormat0* f0, Uint8* data, Size size);
-static inline XfOtfCmapSubTableFormat2*
-    sub_table_format2_init (XfOtfCmapSubTableFormat2* f2, Uint8* data, Size size);
-static inline XfOtfCmapSubTableFormat4*
-    sub_table_format4_init (XfOtfCmapSubTableFormat4* f4, Uint8* data, Size size);
-static inline XfOtfCmapSubTableFormat6*
-    sub_table_format6_init (XfOtfCmapSubTableFormat6* f6, Uint8* data, Size size);
-static inline XfOtfCmapSubTableFormat8*
-    sub_table_format8_init (XfOtfCmapSubTableFormat8* f8, Uint8* data, Size size);
-static inline XfOtfCmapSubTableFormat10*
-    sub_table_format10_init (XfOtfCmapSubTableFormat10* f10, Uint8* data, Size size);
-static inline XfOtfCmapSubTableFormat12*
-    sub_table_format12_init (XfOtfCmapSubTableFormat12* f12, Uint8* data, Size size);
+static inline OtfCmapNonDefaultUVSTable*
+    non_default_uvs_table_pprint (OtfCmapNonDefaultUVSTable* non_default_uvs, Uint8 indent_level);
+
+static inline OtfCmapSubTableFormat0*
+    sub_table_format0_init (OtfCmapSubTableFormat0* f0, Uint8* data, Size size);
+static inline OtfCmapSubTableFormat2*
+    sub_table_format2_init (OtfCmapSubTableFormat2* f2, Uint8* data, Size size);
+static inline OtfCmapSubTableFormat4*
+    sub_table_format4_init (OtfCmapSubTableFormat4* f4, Uint8* data, Size size);
+static inline OtfCmapSubTableFormat6*
+    sub_table_format6_init (OtfCmapSubTableFormat6* f6, Uint8* data, Size size);
+static inline OtfCmapSubTableFormat8*
+    sub_table_format8_init (OtfCmapSubTableFormat8* f8, Uint8* data, Size size);
+static inline OtfCmapSubTableFormat10*
+    sub_table_format10_init (OtfCmapSubTableFormat10* f10, Uint8* data, Size size);
+static inline OtfCmapSubTableFormat12*
+    sub_table_format12_init (OtfCmapSubTableFormat12* f12, Uint8* data, Size size);
 #define sub_table_format13_init sub_table_format12_init
-static inline XfOtfCmapSubTableFormat14*
-    sub_table_format14_init (XfOtfCmapSubTableFormat14* f14, Uint8* data, Size size);
-
-static inline XfOtfCmapSubTableFormat2*  sub_table_format2_deinit (XfOtfCmapSubTableFormat2* f2);
-static inline XfOtfCmapSubTableFormat4*  sub_table_format4_deinit (XfOtfCmapSubTableFormat4* f4);
-static inline XfOtfCmapSubTableFormat6*  sub_table_format6_deinit (XfOtfCmapSubTableFormat6* f6);
-static inline XfOtfCmapSubTableFormat8*  sub_table_format8_deinit (XfOtfCmapSubTableFormat8* f8);
-static inline XfOtfCmapSubTableFormat10* sub_table_format10_deinit (XfOtfCmapSubTableFormat10* f10);
-static inline XfOtfCmapSubTableFormat12* sub_table_format12_deinit (XfOtfCmapSubTableFormat12* f12);
+static inline OtfCmapSubTableFormat14*
+    sub_table_format14_init (OtfCmapSubTableFormat14* f14, Uint8* data, Size size);
+
+static inline OtfCmapSubTableFormat2*  sub_table_format2_deinit (OtfCmapSubTableFormat2* f2);
+static inline OtfCmapSubTableFormat4*  sub_table_format4_deinit (OtfCmapSubTableFormat4* f4);
+static inline OtfCmapSubTableFormat6*  sub_table_format6_deinit (OtfCmapSubTableFormat6* f6);
+static inline OtfCmapSubTableFormat8*  sub_table_format8_deinit (OtfCmapSubTableFormat8* f8);
+static inline OtfCmapSubTableFormat10* sub_table_format10_deinit (OtfCmapSubTableFormat10* f10);
+static inline OtfCmapSubTableFormat12* sub_table_format12_deinit (OtfCmapSubTableFormat12* f12);
 #define sub_table_format13_deinit sub_table_format12_deinit
-static inline XfOtfCmapSubTableFormat14* sub_table_format14_deinit (XfOtfCmapSubTableFormat14* f14);
-
-static inline XfOtfCmapSubTableFormat0*
-    sub_table_format0_pprint (XfOtfCmapSubTableFormat0* f0, Uint8 indent_level);
-static inline XfOtfCmapSubTableFormat2*
-    sub_table_format2_pprint (XfOtfCmapSubTableFormat2* f2, Uint8 indent_level);
-static inline XfOtfCmapSubTableFormat4*
-    sub_table_format4_pprint (XfOtfCmapSubTableFormat4* f4, Uint8 indent_level);
-static inline XfOtfCmapSubTableFormat6*
-    sub_table_format6_pprint (XfOtfCmapSubTableFormat6* f6, Uint8 indent_level);
-static inline XfOtfCmapSubTableFormat8*
-    sub_table_format8_pprint (XfOtfCmapSubTableFormat8* f8, Uint8 indent_level);
-static inline XfOtfCmapSubTableFormat10*
-    sub_table_format10_pprint (XfOtfCmapSubTableFormat10* f10, Uint8 indent_level);
-static inline XfOtfCmapSubTableFormat12*
-    sub_table_format12_pprint (XfOtfCmapSubTableFormat12* f12, Uint8 indent_level);
-static inline XfOtfCmapSubTableFormat13*
-    sub_table_format13_pprint (XfOtfCmapSubTableFormat13* f13, Uint8 indent_level);
-static inline XfOtfCmapSubTableFormat14*
-    sub_table_format14_pprint (XfOtfCmapSubTableFormat14* f14, Uint8 indent_level);
-
-static inline XfOtfCmapSubTable*
-    sub_table_init (XfOtfCmapSubTable* sub_table, Uint8* data, Size size);
-static inline XfOtfCmapSubTable* sub_table_deinit (XfOtfCmapSubTable* sub_table);
-static inline XfOtfCmapSubTable*
-    sub_table_pprint (XfOtfCmapSubTable* sub_table, Uint8 indent_level);
+static inline OtfCmapSubTableFormat14* sub_table_format14_deinit (OtfCmapSubTableFormat14* f14);
+
+static inline OtfCmapSubTableFormat0*
+    sub_table_format0_pprint (OtfCmapSubTableFormat0* f0, Uint8 indent_level);
+static inline OtfCmapSubTableFormat2*
+    sub_table_format2_pprint (OtfCmapSubTableFormat2* f2, Uint8 indent_level);
+static inline OtfCmapSubTableFormat4*
+    sub_table_format4_pprint (OtfCmapSubTableFormat4* f4, Uint8 indent_level);
+static inline OtfCmapSubTableFormat6*
+    sub_table_format6_pprint (OtfCmapSubTableFormat6* f6, Uint8 indent_level);
+static inline OtfCmapSubTableFormat8*
+    sub_table_format8_pprint (OtfCmapSubTableFormat8* f8, Uint8 indent_level);
+static inline OtfCmapSubTableFormat10*
+    sub_table_format10_pprint (OtfCmapSubTableFormat10* f10, Uint8 indent_level);
+static inline OtfCmapSubTableFormat12*
+    sub_table_format12_pprint (OtfCmapSubTableFormat12* f12, Uint8 indent_level);
+static inline OtfCmapSubTableFormat13*
+    sub_table_format13_pprint (OtfCmapSubTableFormat13* f13, Uint8 indent_level);
+static inline OtfCmapSubTableFormat14*
+    sub_table_format14_pprint (OtfCmapSubTableFormat14* f14, Uint8 indent_level);
+
+static inline OtfCmapSubTable*
+    sub_table_init (OtfCmapSubTable* sub_table, Uint8* data, Size size);
+static inline OtfCmapSubTable* sub_table_deinit (OtfCmapSubTable* sub_table);
+static inline OtfCmapSubTable*
+    sub_table_pprint (OtfCmapSubTable* sub_table, Uint8 indent_level);
 
 /* size limit definitions for error checking */
-#define ENCODING_RECORD_DATA_SIZE       (sizeof (XfOtfPlatform) + sizeof (Uint16) + sizeof (Uint32))
+#define ENCODING_RECORD_DATA_SIZE       (sizeof (Uint16) * 2 + sizeof (Uint32))
 #define CMAP_DATA_SIZE                  (sizeof (Uint16) * 2)
 #define SUB_HEADER_DATA_SIZE            (sizeof (Uint16) * 3 + sizeof (Int16))
 #define MAP_GROUP_DATA_SIZE             (sizeof (Uint32) * 3)
@@ -186,7 +186,7 @@ static inline XfOtfCmapSubTable*
 /**************************************************************************************************/
 
 /**
- * @b Initialize given @c XfOtfCmap by reading and adjusting
+ * @b Initialize given @c OtfCmap by reading and adjusting
  *    endinanness of data from given @c data buffer.
  *
  * @param cmap To be initialized.
@@ -196,7 +196,7 @@ static inline XfOtfCmapSubTable*
  * @return @c cmap on success.
  * @return @c Null otherwise.
  * */
-XfOtfCmap* xf_otf_cmap_init (XfOtfCmap* cmap, Uint8* data, Size size) {
+OtfCmap* otf_cmap_init (OtfCmap* cmap, Uint8* data, Size size) {
     RETURN_VALUE_IF (!cmap || !data, Null, ERR_INVALID_ARGUMENTS);
     RETURN_VALUE_IF (
         size < CMAP_DATA_SIZE,
@@ -215,20 +215,20 @@ XfOtfCmap* xf_otf_cmap_init (XfOtfCmap* cmap, Uint8* data, Size size) {
         return cmap;
     }
 
-    cmap->encoding_records = ALLOCATE (XfOtfCmapEncodingRecord, cmap->num_tables);
+    cmap->encoding_records = ALLOCATE (OtfCmapEncodingRecord, cmap->num_tables);
     RETURN_VALUE_IF (!cmap->encoding_records, Null, ERR_OUT_OF_MEMORY);
 
     size -= CMAP_DATA_SIZE;
 
     for (Uint16 table_idx = 0; table_idx < cmap->num_tables; table_idx++) {
-        XfOtfCmapEncodingRecord* enc = cmap->encoding_records + table_idx;
+        OtfCmapEncodingRecord* enc = cmap->encoding_records + table_idx;
 
         if (!encoding_record_init (enc, data, size)) {
             PRINT_ERR (
                 "Failed to read all encoding records in character to glyph index map "
                 "\"cmap\".\n"
             );
-            xf_otf_cmap_deinit (cmap);
+            otf_cmap_deinit (cmap);
             return Null;
         }
 
@@ -251,14 +251,14 @@ XfOtfCmap* xf_otf_cmap_init (XfOtfCmap* cmap, Uint8* data, Size size) {
 }
 
 /**
- * @b De-initialize contents of given @c XfOtfCmap struct.
+ * @b De-initialize contents of given @c OtfCmap struct.
  *
  * @param cmap To be de-initialized
  *
  * @return @c cmap on success.
  * @return @c Null otherwise.
  * */
-XfOtfCmap* xf_otf_cmap_deinit (XfOtfCmap* cmap) {
+OtfCmap* otf_cmap_deinit (OtfCmap* cmap) {
     RETURN_VALUE_IF (!cmap, Null, ERR_INVALID_ARGUMENTS);
 
     if (cmap->encoding_records) {
@@ -269,13 +269,13 @@ XfOtfCmap* xf_otf_cmap_deinit (XfOtfCmap* cmap) {
         FREE (cmap->encoding_records);
     }
 
-    memset (cmap, 0, sizeof (XfOtfCmap));
+    memset (cmap, 0, sizeof (OtfCmap));
 
     return cmap;
 }
 
 /**
- * @b Pretty print contents of given @c XfOtfCmap struct.
+ * @b Pretty print contents of given @c OtfCmap struct.
  *
  * @param cmap To be pretty-printed.
  * @param indent_level
@@ -283,7 +283,7 @@ XfOtfCmap* xf_otf_cmap_deinit (XfOtfCmap* cmap) {
  * @return @c cmap on success.
  * @return @c Null otherwise.
  * */
-XfOtfCmap* xf_otf_cmap_pprint (XfOtfCmap* cmap, Uint8 indent_level) {
+OtfCmap* otf_cmap_pprint (OtfCmap* cmap, Uint8 indent_level) {
     RETURN_VALUE_IF (!cmap, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -314,7 +314,7 @@ XfOtfCmap* xf_otf_cmap_pprint (XfOtfCmap* cmap, Uint8 indent_level) {
 /**************************************************************************************************/
 
 /**
- * @b Initialize given @c XfOtfCmapEncodingRecord by reading and adjusting
+ * @b Initialize given @c OtfCmapEncodingRecord by reading and adjusting
 *    endinanness of data from given @c data buffer.
  *
  * @param enc To be initialized.
@@ -324,8 +324,8 @@ XfOtfCmap* xf_otf_cmap_pprint (XfOtfCmap* cmap, Uint8 indent_level) {
  * @return @c enc on success.
  * @return @c Null otherwise.
  * */
-static inline XfOtfCmapEncodingRecord*
-    encoding_record_init (XfOtfCmapEncodingRecord* enc, Uint8* data, Size size) {
+static inline OtfCmapEncodingRecord*
+    encoding_record_init (OtfCmapEncodingRecord* enc, Uint8* data, Size size) {
     RETURN_VALUE_IF (!enc || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -349,7 +349,7 @@ static inline XfOtfCmapEncodingRecord*
  * @return @c enc on success.
  * @return @c Null otherwise.
  * */
-static inline XfOtfCmapEncodingRecord* encoding_record_deinit (XfOtfCmapEncodingRecord* enc) {
+static inline OtfCmapEncodingRecord* encoding_record_deinit (OtfCmapEncodingRecord* enc) {
     RETURN_VALUE_IF (!enc, Null, ERR_INVALID_ARGUMENTS);
 
     sub_table_deinit (&enc->sub_table);
@@ -358,15 +358,15 @@ static inline XfOtfCmapEncodingRecord* encoding_record_deinit (XfOtfCmapEncoding
 }
 
 /**
- * @b Pretty print contents of given @c XfOtfCmapEncodingRecord struct.
+ * @b Pretty print contents of given @c OtfCmapEncodingRecord struct.
  *
  * @param enc To be pretty-printed.
  *
  * @return @c enc on success.
  * @return @c Null otherwise.
  * */
-static inline XfOtfCmapEncodingRecord*
-    encoding_record_pprint (XfOtfCmapEncodingRecord* enc, Uint8 indent_level) {
+static inline OtfCmapEncodingRecord*
+    encoding_record_pprint (OtfCmapEncodingRecord* enc, Uint8 indent_level) {
     RETURN_VALUE_IF (!enc, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -382,10 +382,10 @@ static inline XfOtfCmapEncodingRecord*
         indent,
         indent,
         enc->platform_encoding.platform,
-        xf_otf_platform_encoding_get_platform_str (enc->platform_encoding),
+        otf_platform_encoding_get_platform_str (enc->platform_encoding),
         indent,
         enc->platform_encoding.encoding.custom,
-        xf_otf_platform_encoding_get_encoding_str (enc->platform_encoding),
+        otf_platform_encoding_get_encoding_str (enc->platform_encoding),
         indent,
         enc->sub_table_offset
     );
@@ -395,8 +395,8 @@ static inline XfOtfCmapEncodingRecord*
     return enc;
 }
 
-static inline XfOtfCmapSubHeader*
-    sub_header_init (XfOtfCmapSubHeader* sub_head, Uint8* data, Size size) {
+static inline OtfCmapSubHeader*
+    sub_header_init (OtfCmapSubHeader* sub_head, Uint8* data, Size size) {
     RETURN_VALUE_IF (!sub_head || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -413,8 +413,8 @@ static inline XfOtfCmapSubHeader*
     return sub_head;
 }
 
-static inline XfOtfCmapSubHeader*
-    sub_header_pprint (XfOtfCmapSubHeader* sub_head, Uint8 indent_level) {
+static inline OtfCmapSubHeader*
+    sub_header_pprint (OtfCmapSubHeader* sub_head, Uint8 indent_level) {
     RETURN_VALUE_IF (!sub_head, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -442,7 +442,7 @@ static inline XfOtfCmapSubHeader*
     return sub_head;
 }
 
-static inline XfOtfCmapMapGroup* map_group_init (XfOtfCmapMapGroup* group, Uint8* data, Size size) {
+static inline OtfCmapMapGroup* map_group_init (OtfCmapMapGroup* group, Uint8* data, Size size) {
     RETURN_VALUE_IF (!group || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -458,7 +458,7 @@ static inline XfOtfCmapMapGroup* map_group_init (XfOtfCmapMapGroup* group, Uint8
     return group;
 }
 
-static inline XfOtfCmapMapGroup* map_group_pprint (XfOtfCmapMapGroup* group, Uint8 indent_level) {
+static inline OtfCmapMapGroup* map_group_pprint (OtfCmapMapGroup* group, Uint8 indent_level) {
     RETURN_VALUE_IF (!group, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -483,8 +483,8 @@ static inline XfOtfCmapMapGroup* map_group_pprint (XfOtfCmapMapGroup* group, Uin
     return group;
 }
 
-static inline XfOtfCmapVarSelector*
-    var_selector_init (XfOtfCmapVarSelector* sel, Uint8* data, Size size) {
+static inline OtfCmapVarSelector*
+    var_selector_init (OtfCmapVarSelector* sel, Uint8* data, Size size) {
     RETURN_VALUE_IF (!sel || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -533,7 +533,7 @@ static inline XfOtfCmapVarSelector*
     return sel;
 }
 
-static inline XfOtfCmapVarSelector* var_selector_deinit (XfOtfCmapVarSelector* sel) {
+static inline OtfCmapVarSelector* var_selector_deinit (OtfCmapVarSelector* sel) {
     RETURN_VALUE_IF (!sel, Null, ERR_INVALID_ARGUMENTS);
 
     if (sel->default_uvs_offset) {
@@ -547,8 +547,8 @@ static inline XfOtfCmapVarSelector* var_selector_deinit (XfOtfCmapVarSelector* s
     return sel;
 }
 
-static inline XfOtfCmapVarSelector*
-    var_selector_pprint (XfOtfCmapVarSelector* sel, Uint8 indent_level) {
+static inline OtfCmapVarSelector*
+    var_selector_pprint (OtfCmapVarSelector* sel, Uint8 indent_level) {
     RETURN_VALUE_IF (!sel, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -581,8 +581,8 @@ static inline XfOtfCmapVarSelector*
     return sel;
 }
 
-static inline XfOtfCmapUnicodeRange*
-    unicode_range_init (XfOtfCmapUnicodeRange* range, Uint8* data, Size size) {
+static inline OtfCmapUnicodeRange*
+    unicode_range_init (OtfCmapUnicodeRange* range, Uint8* data, Size size) {
     RETURN_VALUE_IF (!range || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -601,8 +601,8 @@ static inline XfOtfCmapUnicodeRange*
     return range;
 }
 
-static inline XfOtfCmapUnicodeRange*
-    unicode_range_pprint (XfOtfCmapUnicodeRange* range, Uint8 indent_level) {
+static inline OtfCmapUnicodeRange*
+    unicode_range_pprint (OtfCmapUnicodeRange* range, Uint8 indent_level) {
     RETURN_VALUE_IF (!range, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -624,8 +624,8 @@ static inline XfOtfCmapUnicodeRange*
     return range;
 }
 
-static inline XfOtfCmapDefaultUVSTable*
-    default_uvs_table_init (XfOtfCmapDefaultUVSTable* default_uvs, Uint8* data, Size size) {
+static inline OtfCmapDefaultUVSTable*
+    default_uvs_table_init (OtfCmapDefaultUVSTable* default_uvs, Uint8* data, Size size) {
     RETURN_VALUE_IF (!default_uvs || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -643,7 +643,7 @@ static inline XfOtfCmapDefaultUVSTable*
         "Data buffer size not sufficient for initialization of cmap default uvs table\n"
     );
 
-    default_uvs->ranges = ALLOCATE (XfOtfCmapUnicodeRange, default_uvs->num_unicode_value_ranges);
+    default_uvs->ranges = ALLOCATE (OtfCmapUnicodeRange, default_uvs->num_unicode_value_ranges);
     RETURN_VALUE_IF (!default_uvs->ranges, Null, ERR_OUT_OF_MEMORY);
 
     for (Size range_idx = 0; range_idx < default_uvs->num_unicode_value_ranges; range_idx++) {
@@ -660,8 +660,8 @@ static inline XfOtfCmapDefaultUVSTable*
     return default_uvs;
 }
 
-static inline XfOtfCmapDefaultUVSTable* default_uvs_table_deinit (
-    XfOtfCmapDefaultUVSTable* default_uvs
+static inline OtfCmapDefaultUVSTable* default_uvs_table_deinit (
+    OtfCmapDefaultUVSTable* default_uvs
 ) {
     RETURN_VALUE_IF (!default_uvs, Null, ERR_INVALID_ARGUMENTS);
 
@@ -669,12 +669,12 @@ static inline XfOtfCmapDefaultUVSTable* default_uvs_table_deinit (
         FREE (default_uvs->ranges);
     }
 
-    memset (default_uvs, 0, sizeof (XfOtfCmapDefaultUVSTable));
+    memset (default_uvs, 0, sizeof (OtfCmapDefaultUVSTable));
     return default_uvs;
 }
 
-static inline XfOtfCmapDefaultUVSTable*
-    default_uvs_table_pprint (XfOtfCmapDefaultUVSTable* default_uvs, Uint8 indent_level) {
+static inline OtfCmapDefaultUVSTable*
+    default_uvs_table_pprint (OtfCmapDefaultUVSTable* default_uvs, Uint8 indent_level) {
     RETURN_VALUE_IF (!default_uvs, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -697,8 +697,8 @@ static inline XfOtfCmapDefaultUVSTable*
     return default_uvs;
 }
 
-static inline XfOtfCmapUVSMapping*
-    uvs_mapping_init (XfOtfCmapUVSMapping* uvs_map, Uint8* data, Size size) {
+static inline OtfCmapUVSMapping*
+    uvs_mapping_init (OtfCmapUVSMapping* uvs_map, Uint8* data, Size size) {
     RETURN_VALUE_IF (!uvs_map || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -717,8 +717,8 @@ static inline XfOtfCmapUVSMapping*
     return uvs_map;
 }
 
-static inline XfOtfCmapUVSMapping*
-    uvs_mapping_pprint (XfOtfCmapUVSMapping* uvs_map, Uint8 indent_level) {
+static inline OtfCmapUVSMapping*
+    uvs_mapping_pprint (OtfCmapUVSMapping* uvs_map, Uint8 indent_level) {
     RETURN_VALUE_IF (!uvs_map, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -740,8 +740,8 @@ static inline XfOtfCmapUVSMapping*
     return uvs_map;
 }
 
-static inline XfOtfCmapNonDefaultUVSTable* non_default_uvs_table_init (
-    XfOtfCmapNonDefaultUVSTable* non_default_uvs,
+static inline OtfCmapNonDefaultUVSTable* non_default_uvs_table_init (
+    OtfCmapNonDefaultUVSTable*   non_default_uvs,
     Uint8*                       data,
     Size                         size
 ) {
@@ -763,7 +763,7 @@ static inline XfOtfCmapNonDefaultUVSTable* non_default_uvs_table_init (
     );
 
     non_default_uvs->uvs_mappings =
-        ALLOCATE (XfOtfCmapUVSMapping, non_default_uvs->num_uvs_mappings);
+        ALLOCATE (OtfCmapUVSMapping, non_default_uvs->num_uvs_mappings);
     RETURN_VALUE_IF (!non_default_uvs->uvs_mappings, Null, ERR_OUT_OF_MEMORY);
 
     for (Size range_idx = 0; range_idx < non_default_uvs->num_uvs_mappings; range_idx++) {
@@ -780,8 +780,8 @@ static inline XfOtfCmapNonDefaultUVSTable* non_default_uvs_table_init (
     return non_default_uvs;
 }
 
-static inline XfOtfCmapNonDefaultUVSTable* non_default_uvs_table_deinit (
-    XfOtfCmapNonDefaultUVSTable* non_default_uvs
+static inline OtfCmapNonDefaultUVSTable* non_default_uvs_table_deinit (
+    OtfCmapNonDefaultUVSTable* non_default_uvs
 ) {
     RETURN_VALUE_IF (!non_default_uvs, Null, ERR_INVALID_ARGUMENTS);
 
@@ -789,12 +789,12 @@ static inline XfOtfCmapNonDefaultUVSTable* non_default_uvs_table_deinit (
         FREE (non_default_uvs->uvs_mappings);
     }
 
-    memset (non_default_uvs, 0, sizeof (XfOtfCmapNonDefaultUVSTable));
+    memset (non_default_uvs, 0, sizeof (OtfCmapNonDefaultUVSTable));
     return non_default_uvs;
 }
 
-static inline XfOtfCmapNonDefaultUVSTable* non_default_uvs_table_pprint (
-    XfOtfCmapNonDefaultUVSTable* non_default_uvs,
+static inline OtfCmapNonDefaultUVSTable* non_default_uvs_table_pprint (
+    OtfCmapNonDefaultUVSTable*   non_default_uvs,
     Uint8                        indent_level
 ) {
     RETURN_VALUE_IF (!non_default_uvs, Null, ERR_INVALID_ARGUMENTS);
@@ -819,8 +819,8 @@ static inline XfOtfCmapNonDefaultUVSTable* non_default_uvs_table_pprint (
     return non_default_uvs;
 }
 
-static inline XfOtfCmapSubTableFormat0*
-    sub_table_format0_init (XfOtfCmapSubTableFormat0* f0, Uint8* data, Size size) {
+static inline OtfCmapSubTableFormat0*
+    sub_table_format0_init (OtfCmapSubTableFormat0* f0, Uint8* data, Size size) {
     RETURN_VALUE_IF (!f0 || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -836,8 +836,8 @@ static inline XfOtfCmapSubTableFormat0*
     return f0;
 }
 
-static inline XfOtfCmapSubTableFormat0*
-    sub_table_format0_pprint (XfOtfCmapSubTableFormat0* f0, Uint8 indent_level) {
+static inline OtfCmapSubTableFormat0*
+    sub_table_format0_pprint (OtfCmapSubTableFormat0* f0, Uint8 indent_level) {
     RETURN_VALUE_IF (!f0, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -864,8 +864,8 @@ static inline XfOtfCmapSubTableFormat0*
     return f0;
 }
 
-static inline XfOtfCmapSubTableFormat2*
-    sub_table_format2_init (XfOtfCmapSubTableFormat2* f2, Uint8* data, Size size) {
+static inline OtfCmapSubTableFormat2*
+    sub_table_format2_init (OtfCmapSubTableFormat2* f2, Uint8* data, Size size) {
     RETURN_VALUE_IF (!f2 || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -899,7 +899,7 @@ static inline XfOtfCmapSubTableFormat2*
             );
 
             GOTO_HANDLER_IF (
-                !(f2->sub_headers = ALLOCATE (XfOtfCmapSubHeader, f2->num_sub_headers)),
+                !(f2->sub_headers = ALLOCATE (OtfCmapSubHeader, f2->num_sub_headers)),
                 INIT_FAILED,
                 ERR_OUT_OF_MEMORY
             );
@@ -954,7 +954,7 @@ INIT_FAILED:
     return Null;
 }
 
-static inline XfOtfCmapSubTableFormat2* sub_table_format2_deinit (XfOtfCmapSubTableFormat2* f2) {
+static inline OtfCmapSubTableFormat2* sub_table_format2_deinit (OtfCmapSubTableFormat2* f2) {
     RETURN_VALUE_IF (!f2, Null, ERR_INVALID_ARGUMENTS);
 
     if (f2->glyph_id_array) {
@@ -965,12 +965,12 @@ static inline XfOtfCmapSubTableFormat2* sub_table_format2_deinit (XfOtfCmapSubTa
         FREE (f2->sub_headers);
     }
 
-    memset (f2, 0, sizeof (XfOtfCmapSubTableFormat2));
+    memset (f2, 0, sizeof (OtfCmapSubTableFormat2));
     return f2;
 }
 
-static inline XfOtfCmapSubTableFormat2*
-    sub_table_format2_pprint (XfOtfCmapSubTableFormat2* f2, Uint8 indent_level) {
+static inline OtfCmapSubTableFormat2*
+    sub_table_format2_pprint (OtfCmapSubTableFormat2* f2, Uint8 indent_level) {
     RETURN_VALUE_IF (!f2, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -1011,8 +1011,8 @@ static inline XfOtfCmapSubTableFormat2*
     return f2;
 }
 
-static inline XfOtfCmapSubTableFormat4*
-    sub_table_format4_init (XfOtfCmapSubTableFormat4* f4, Uint8* data, Size size) {
+static inline OtfCmapSubTableFormat4*
+    sub_table_format4_init (OtfCmapSubTableFormat4* f4, Uint8* data, Size size) {
     RETURN_VALUE_IF (!f4 || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -1056,7 +1056,7 @@ static inline XfOtfCmapSubTableFormat4*
 
         GET_ARR_AND_ADV_U2 (f4->end_code, 0, f4->seg_count);
         f4->reserved_pad = GET_AND_ADV_U2 (data);
-        GET_ARR_AND_ADV_U2 (f4->end_code, 0, f4->seg_count);
+        GET_ARR_AND_ADV_U2 (f4->start_code, 0, f4->seg_count);
         GET_ARR_AND_ADV_I2 (f4->id_delta, 0, f4->seg_count);
         GET_ARR_AND_ADV_U2 (f4->id_range_offsets, 0, f4->seg_count);
         size -= required_size;
@@ -1103,7 +1103,7 @@ INIT_FAILED:
     return Null;
 }
 
-static inline XfOtfCmapSubTableFormat4* sub_table_format4_deinit (XfOtfCmapSubTableFormat4* f4) {
+static inline OtfCmapSubTableFormat4* sub_table_format4_deinit (OtfCmapSubTableFormat4* f4) {
     RETURN_VALUE_IF (!f4, Null, ERR_INVALID_ARGUMENTS);
 
     if (f4->glyph_id_array) {
@@ -1116,13 +1116,13 @@ static inline XfOtfCmapSubTableFormat4* sub_table_format4_deinit (XfOtfCmapSubTa
         FREE (f4->end_code);
     }
 
-    memset (f4, 0, sizeof (XfOtfCmapSubTableFormat4));
+    memset (f4, 0, sizeof (OtfCmapSubTableFormat4));
 
     return f4;
 }
 
-static inline XfOtfCmapSubTableFormat4*
-    sub_table_format4_pprint (XfOtfCmapSubTableFormat4* f4, Uint8 indent_level) {
+static inline OtfCmapSubTableFormat4*
+    sub_table_format4_pprint (OtfCmapSubTableFormat4* f4, Uint8 indent_level) {
     RETURN_VALUE_IF (!f4, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -1185,8 +1185,8 @@ static inline XfOtfCmapSubTableFormat4*
     return f4;
 }
 
-static inline XfOtfCmapSubTableFormat6*
-    sub_table_format6_init (XfOtfCmapSubTableFormat6* f6, Uint8* data, Size size) {
+static inline OtfCmapSubTableFormat6*
+    sub_table_format6_init (OtfCmapSubTableFormat6* f6, Uint8* data, Size size) {
     RETURN_VALUE_IF (!f6 || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -1218,7 +1218,7 @@ static inline XfOtfCmapSubTableFormat6*
     return f6;
 }
 
-static inline XfOtfCmapSubTableFormat6* sub_table_format6_deinit (XfOtfCmapSubTableFormat6* f6) {
+static inline OtfCmapSubTableFormat6* sub_table_format6_deinit (OtfCmapSubTableFormat6* f6) {
     RETURN_VALUE_IF (!f6, Null, ERR_INVALID_ARGUMENTS);
 
     if (f6->glyph_id_array) {
@@ -1229,8 +1229,8 @@ static inline XfOtfCmapSubTableFormat6* sub_table_format6_deinit (XfOtfCmapSubTa
     return f6;
 }
 
-static inline XfOtfCmapSubTableFormat6*
-    sub_table_format6_pprint (XfOtfCmapSubTableFormat6* f6, Uint8 indent_level) {
+static inline OtfCmapSubTableFormat6*
+    sub_table_format6_pprint (OtfCmapSubTableFormat6* f6, Uint8 indent_level) {
     RETURN_VALUE_IF (!f6, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -1260,8 +1260,8 @@ static inline XfOtfCmapSubTableFormat6*
     return f6;
 }
 
-static inline XfOtfCmapSubTableFormat8*
-    sub_table_format8_init (XfOtfCmapSubTableFormat8* f8, Uint8* data, Size size) {
+static inline OtfCmapSubTableFormat8*
+    sub_table_format8_init (OtfCmapSubTableFormat8* f8, Uint8* data, Size size) {
     RETURN_VALUE_IF (!f8 || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -1288,7 +1288,7 @@ static inline XfOtfCmapSubTableFormat8*
         );
 
         RETURN_VALUE_IF (
-            !(f8->groups = ALLOCATE (XfOtfCmapMapGroup, f8->num_groups)),
+            !(f8->groups = ALLOCATE (OtfCmapMapGroup, f8->num_groups)),
             Null,
             ERR_OUT_OF_MEMORY
         );
@@ -1305,7 +1305,7 @@ static inline XfOtfCmapSubTableFormat8*
     return f8;
 }
 
-static inline XfOtfCmapSubTableFormat8* sub_table_format8_deinit (XfOtfCmapSubTableFormat8* f8) {
+static inline OtfCmapSubTableFormat8* sub_table_format8_deinit (OtfCmapSubTableFormat8* f8) {
     RETURN_VALUE_IF (!f8, Null, ERR_INVALID_ARGUMENTS);
 
     if (f8->groups) {
@@ -1316,8 +1316,8 @@ static inline XfOtfCmapSubTableFormat8* sub_table_format8_deinit (XfOtfCmapSubTa
     return f8;
 }
 
-static inline XfOtfCmapSubTableFormat8*
-    sub_table_format8_pprint (XfOtfCmapSubTableFormat8* f8, Uint8 indent_level) {
+static inline OtfCmapSubTableFormat8*
+    sub_table_format8_pprint (OtfCmapSubTableFormat8* f8, Uint8 indent_level) {
     RETURN_VALUE_IF (!f8, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -1350,8 +1350,8 @@ static inline XfOtfCmapSubTableFormat8*
     return f8;
 }
 
-static inline XfOtfCmapSubTableFormat10*
-    sub_table_format10_init (XfOtfCmapSubTableFormat10* fa, Uint8* data, Size size) {
+static inline OtfCmapSubTableFormat10*
+    sub_table_format10_init (OtfCmapSubTableFormat10* fa, Uint8* data, Size size) {
     RETURN_VALUE_IF (!fa || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -1387,7 +1387,7 @@ static inline XfOtfCmapSubTableFormat10*
     return fa;
 }
 
-static inline XfOtfCmapSubTableFormat10* sub_table_format10_deinit (XfOtfCmapSubTableFormat10* fa) {
+static inline OtfCmapSubTableFormat10* sub_table_format10_deinit (OtfCmapSubTableFormat10* fa) {
     RETURN_VALUE_IF (!fa, Null, ERR_INVALID_ARGUMENTS);
 
     if (fa->glyph_id_array) {
@@ -1398,8 +1398,8 @@ static inline XfOtfCmapSubTableFormat10* sub_table_format10_deinit (XfOtfCmapSub
     return fa;
 }
 
-static inline XfOtfCmapSubTableFormat10*
-    sub_table_format10_pprint (XfOtfCmapSubTableFormat10* f10, Uint8 indent_level) {
+static inline OtfCmapSubTableFormat10*
+    sub_table_format10_pprint (OtfCmapSubTableFormat10* f10, Uint8 indent_level) {
     RETURN_VALUE_IF (!f10, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -1432,8 +1432,8 @@ static inline XfOtfCmapSubTableFormat10*
     return f10;
 }
 
-static inline XfOtfCmapSubTableFormat12*
-    sub_table_format12_init (XfOtfCmapSubTableFormat12* fc, Uint8* data, Size size) {
+static inline OtfCmapSubTableFormat12*
+    sub_table_format12_init (OtfCmapSubTableFormat12* fc, Uint8* data, Size size) {
     RETURN_VALUE_IF (!fc || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -1457,7 +1457,7 @@ static inline XfOtfCmapSubTableFormat12*
         );
 
         RETURN_VALUE_IF (
-            !(fc->groups = ALLOCATE (XfOtfCmapMapGroup, fc->num_groups)),
+            !(fc->groups = ALLOCATE (OtfCmapMapGroup, fc->num_groups)),
             Null,
             ERR_OUT_OF_MEMORY
         );
@@ -1474,7 +1474,7 @@ static inline XfOtfCmapSubTableFormat12*
     return fc;
 }
 
-static inline XfOtfCmapSubTableFormat12* sub_table_format12_deinit (XfOtfCmapSubTableFormat12* fc) {
+static inline OtfCmapSubTableFormat12* sub_table_format12_deinit (OtfCmapSubTableFormat12* fc) {
     RETURN_VALUE_IF (!fc, Null, ERR_INVALID_ARGUMENTS);
 
     if (fc->groups) {
@@ -1485,8 +1485,8 @@ static inline XfOtfCmapSubTableFormat12* sub_table_format12_deinit (XfOtfCmapSub
     return fc;
 }
 
-static inline XfOtfCmapSubTableFormat12*
-    sub_table_format12_pprint (XfOtfCmapSubTableFormat12* f12, Uint8 indent_level) {
+static inline OtfCmapSubTableFormat12*
+    sub_table_format12_pprint (OtfCmapSubTableFormat12* f12, Uint8 indent_level) {
     RETURN_VALUE_IF (!f12, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -1517,8 +1517,8 @@ static inline XfOtfCmapSubTableFormat12*
     return f12;
 }
 
-static inline XfOtfCmapSubTableFormat13*
-    sub_table_format13_pprint (XfOtfCmapSubTableFormat13* f13, Uint8 indent_level) {
+static inline OtfCmapSubTableFormat13*
+    sub_table_format13_pprint (OtfCmapSubTableFormat13* f13, Uint8 indent_level) {
     RETURN_VALUE_IF (!f13, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -1549,8 +1549,8 @@ static inline XfOtfCmapSubTableFormat13*
     return f13;
 }
 
-static inline XfOtfCmapSubTableFormat14*
-    sub_table_format14_init (XfOtfCmapSubTableFormat14* fe, Uint8* data, Size size) {
+static inline OtfCmapSubTableFormat14*
+    sub_table_format14_init (OtfCmapSubTableFormat14* fe, Uint8* data, Size size) {
     RETURN_VALUE_IF (!fe || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -1572,7 +1572,7 @@ static inline XfOtfCmapSubTableFormat14*
         );
 
         RETURN_VALUE_IF (
-            !(fe->var_selectors = ALLOCATE (XfOtfCmapVarSelector, fe->num_var_selectors)),
+            !(fe->var_selectors = ALLOCATE (OtfCmapVarSelector, fe->num_var_selectors)),
             Null,
             ERR_OUT_OF_MEMORY
         );
@@ -1589,7 +1589,7 @@ static inline XfOtfCmapSubTableFormat14*
     return fe;
 }
 
-static inline XfOtfCmapSubTableFormat14* sub_table_format14_deinit (XfOtfCmapSubTableFormat14* fe) {
+static inline OtfCmapSubTableFormat14* sub_table_format14_deinit (OtfCmapSubTableFormat14* fe) {
     RETURN_VALUE_IF (!fe, Null, ERR_INVALID_ARGUMENTS);
 
     if (fe->var_selectors) {
@@ -1600,12 +1600,12 @@ static inline XfOtfCmapSubTableFormat14* sub_table_format14_deinit (XfOtfCmapSub
         FREE (fe->var_selectors);
     }
 
-    memset (fe, 0, sizeof (XfOtfCmapSubTableFormat14));
+    memset (fe, 0, sizeof (OtfCmapSubTableFormat14));
     return fe;
 }
 
-static inline XfOtfCmapSubTableFormat14*
-    sub_table_format14_pprint (XfOtfCmapSubTableFormat14* fe, Uint8 indent_level) {
+static inline OtfCmapSubTableFormat14*
+    sub_table_format14_pprint (OtfCmapSubTableFormat14* fe, Uint8 indent_level) {
     RETURN_VALUE_IF (!fe, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -1633,8 +1633,8 @@ static inline XfOtfCmapSubTableFormat14*
     return fe;
 }
 
-static inline XfOtfCmapSubTable*
-    sub_table_init (XfOtfCmapSubTable* sub_table, Uint8* data, Size size) {
+static inline OtfCmapSubTable*
+    sub_table_init (OtfCmapSubTable* sub_table, Uint8* data, Size size) {
     RETURN_VALUE_IF (!sub_table || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -1650,7 +1650,7 @@ static inline XfOtfCmapSubTable*
 #define DEF_CASE(fmt)                                                                              \
     case fmt : {                                                                                   \
         RETURN_VALUE_IF (                                                                          \
-            !(sub_table->format##fmt = NEW (XfOtfCmapSubTableFormat##fmt)),                        \
+            !(sub_table->format##fmt = NEW (OtfCmapSubTableFormat##fmt)),                          \
             Null,                                                                                  \
             ERR_OUT_OF_MEMORY                                                                      \
         );                                                                                         \
@@ -1678,7 +1678,7 @@ static inline XfOtfCmapSubTable*
     }
 }
 
-static inline XfOtfCmapSubTable* sub_table_deinit (XfOtfCmapSubTable* sub_table) {
+static inline OtfCmapSubTable* sub_table_deinit (OtfCmapSubTable* sub_table) {
     RETURN_VALUE_IF (!sub_table, Null, ERR_INVALID_ARGUMENTS);
 
     switch (sub_table->format) {
@@ -1716,8 +1716,8 @@ static inline XfOtfCmapSubTable* sub_table_deinit (XfOtfCmapSubTable* sub_table)
     return sub_table;
 }
 
-static inline XfOtfCmapSubTable*
-    sub_table_pprint (XfOtfCmapSubTable* sub_table, Uint8 indent_level) {
+static inline OtfCmapSubTable*
+    sub_table_pprint (OtfCmapSubTable* sub_table, Uint8 indent_level) {
     RETURN_VALUE_IF (!sub_table, Null, ERR_INVALID_ARGUMENTS);
 
     switch (sub_table->format) {
@@ -100,47 +100,47 @@ static CString enc_mac_to_str_map[] = {
     "UNKNOWN"
 };
 
-static inline CString win_lang_to_full_str (XfOtfWinLanguage lang);
-static inline CString mac_lang_to_full_str (XfOtfMacLanguage lang);
+static inline CString win_lang_to_full_str (OtfWinLanguage lang);
+static inline CString mac_lang_to_full_str (OtfMacLanguage lang);
 
-CString xf_otf_platform_encoding_get_platform_str (XfOtfPlatformEncoding platform_encoding) {
-    return platform_encoding.platform < XF_OTF_PLATFORM_MAX ?
+CString otf_platform_encoding_get_platform_str (OtfPlatformEncoding platform_encoding) {
+    return platform_encoding.platform < OTF_PLATFORM_MAX ?
                platform_to_str_map[platform_encoding.platform] :
                "UNKNOWN";
 }
 
-CString xf_otf_platform_encoding_get_encoding_str (XfOtfPlatformEncoding platform_encoding) {
-    if (platform_encoding.platform <= XF_OTF_PLATFORM_MAX) {
+CString otf_platform_encoding_get_encoding_str (OtfPlatformEncoding platform_encoding) {
+    if (platform_encoding.platform <= OTF_PLATFORM_MAX) {
         switch (platform_encoding.platform) {
-            case XF_OTF_PLATFORM_VARIOUS : {
-                if (platform_encoding.encoding.various <= XF_OTF_VARIOUS_ENCODING_MAX) {
+            case OTF_PLATFORM_VARIOUS : {
+                if (platform_encoding.encoding.various <= OTF_VARIOUS_ENCODING_MAX) {
                     return enc_various_to_str_map[platform_encoding.encoding.various];
                 } else {
                     return "UNKNOWN";
                 }
             }
-            case XF_OTF_PLATFORM_MAC : {
-                if (platform_encoding.encoding.mac <= XF_OTF_MAC_ENCODING_MAX) {
+            case OTF_PLATFORM_MAC : {
+                if (platform_encoding.encoding.mac <= OTF_MAC_ENCODING_MAX) {
                     return enc_mac_to_str_map[platform_encoding.encoding.mac];
                 } else {
                     return "UNKNOWN";
                 }
             }
-            case XF_OTF_PLATFORM_ISO : {
-                if (platform_encoding.encoding.iso <= XF_OTF_ISO_ENCODING_MAX) {
+            case OTF_PLATFORM_ISO : {
+                if (platform_encoding.encoding.iso <= OTF_ISO_ENCODING_MAX) {
                     return enc_iso_to_str_map[platform_encoding.encoding.iso];
                 } else {
                     return "UNKNOWN";
                 }
             }
-            case XF_OTF_PLATFORM_WIN : {
-                if (platform_encoding.encoding.win <= XF_OTF_WIN_ENCODING_MAX) {
+            case OTF_PLATFORM_WIN : {
+                if (platform_encoding.encoding.win <= OTF_WIN_ENCODING_MAX) {
                     return enc_win_to_str_map[platform_encoding.encoding.win];
                 } else {
                     return "UNKNOWN";
                 }
             }
-            case XF_OTF_PLATFORM_CUSTOM :
+            case OTF_PLATFORM_CUSTOM :
                 return "CUSTOM";
             default :
                 return "UNKNOWN";
@@ -150,18 +150,18 @@ CString xf_otf_platform_encoding_get_encoding_str (XfOtfPlatformEncoding platfor
     }
 }
 
-CString xf_otf_language_to_str (XfOtfLanguage lang_id) {
+CString otf_language_to_str (OtfLanguage lang_id) {
     switch (lang_id.platform) {
-        case XF_OTF_PLATFORM_MAC :
+        case OTF_PLATFORM_MAC :
             return mac_lang_to_full_str (lang_id.language.mac);
-        case XF_OTF_PLATFORM_WIN :
+        case OTF_PLATFORM_WIN :
             return win_lang_to_full_str (lang_id.language.win);
         default :
             return "Unknown";
     }
 }
 
-static inline CString win_lang_to_full_str (XfOtfWinLanguage lang) {
+static inline CString win_lang_to_full_str (OtfWinLanguage lang) {
     switch (lang) {
         case 0x041C :
             return "Albanian";
@@ -576,8 +576,8 @@ static inline CString win_lang_to_full_str (XfOtfWinLanguage lang) {
     }
 }
 
-static inline CString mac_lang_to_full_str (XfOtfMacLanguage lang_id) {
-    RETURN_VALUE_IF (lang_id > XF_OTF_MAC_LANGUAGE_MAX, "Unknown", "Invalid language id\n");
+static inline CString mac_lang_to_full_str (OtfMacLanguage lang_id) {
+    RETURN_VALUE_IF (lang_id > OTF_MAC_LANGUAGE_MAX, "Unknown", "Invalid language id\n");
 
     static const CString full_language_names[] = {
         "English",
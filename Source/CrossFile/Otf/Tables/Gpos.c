@@ -0,0 +1,893 @@
+/**
+ * @file Gpos.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/EndiannessHelpers.h>
+#include <Anvie/CrossFile/Otf/Tables/Gpos.h>
+
+/* libc */
+#include <memory.h>
+
+/* private method declarations */
+
+static inline Bool* mark_kern_lookups (Bool* marks, Uint16 lookup_count, Uint8* data, Size size);
+static inline OtfGpos*
+    lookup_init (OtfGpos* gpos, Uint16 lookup_index, Uint8* data, Size size);
+static inline Uint16** coverage_init (Uint16** glyphs, Uint16* count, Uint8* data, Size size);
+static inline OtfGposClassDef* class_def_init (OtfGposClassDef* class_def, Uint8* data, Size size);
+static inline OtfGposClassDef* class_def_deinit (OtfGposClassDef* class_def);
+static inline OtfGposPairAdjust*
+    pair_adjust_init (OtfGposPairAdjust* adj, Uint16 lookup_index, Uint8* data, Size size);
+static inline OtfGposPairAdjust* pair_adjust_deinit (OtfGposPairAdjust* adj);
+static inline OtfGposPairAdjust* pair_adjust_pprint (OtfGposPairAdjust* adj, Uint8 indent_level);
+static inline Size  value_record_size (Uint16 value_format);
+static inline Int16 value_record_x_advance (Uint8* data, Uint16 value_format);
+
+#define LOOKUP_DATA_SIZE             (sizeof (Uint16) * 3)
+#define EXTENSION_POS_DATA_SIZE      (sizeof (Uint16) * 2 + sizeof (Uint32))
+#define PAIR_POS_DATA_SIZE           (sizeof (Uint16) * 4)
+#define PAIR_POS_FORMAT1_DATA_SIZE   (PAIR_POS_DATA_SIZE + sizeof (Uint16))
+#define PAIR_POS_FORMAT2_DATA_SIZE   (PAIR_POS_DATA_SIZE + sizeof (Uint16) * 4)
+#define FEATURE_RECORD_DATA_SIZE     (sizeof (Uint32) + sizeof (Uint16))
+#define COVERAGE_RANGE_DATA_SIZE     (sizeof (Uint16) * 3)
+#define CLASS_RANGE_DATA_SIZE        (sizeof (Uint16) * 3)
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Initialize given GPOS table object from given data buffer.
+ *
+ * Only the pair adjustment lookups referenced by a "kern" feature are decoded,
+ * everything else in GPOS table is skipped.
+ *
+ * @param gpos GPOS table object to be initialized.
+ * @param data Data buffer containing data to be used to initialize GPOS table.
+ * @param size Size in bytes of given data buffer.
+ *
+ * @return @c gpos on success.
+ * @return @c Null otherwise.
+ * */
+OtfGpos* otf_gpos_init (OtfGpos* gpos, Uint8* data, Size size) {
+    RETURN_VALUE_IF (!gpos || !data, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        size < OTF_GPOS_DATA_SIZE,
+        Null,
+        "Data buffer size not sufficient to initialize GPOS table\n"
+    );
+
+    memset (gpos, 0, sizeof (OtfGpos));
+
+    Uint8* table = data;
+
+    gpos->major_version  = GET_AND_ADV_U2 (data);
+    gpos->minor_version  = GET_AND_ADV_U2 (data);
+    data                += sizeof (Uint16); /* script list is not required for kerning */
+
+    Uint16 feature_list_offset = GET_AND_ADV_U2 (data);
+    Uint16 lookup_list_offset  = GET_AND_ADV_U2 (data);
+
+    RETURN_VALUE_IF (gpos->major_version != 1, Null, "Unsupported GPOS table version\n");
+
+    /* nothing to do if font does not have any features or lookups */
+    if (!feature_list_offset || !lookup_list_offset) {
+        return gpos;
+    }
+
+    RETURN_VALUE_IF (
+        feature_list_offset >= size || lookup_list_offset >= size,
+        Null,
+        "Invalid feature/lookup list offset in GPOS table\n"
+    );
+
+    Uint8* lookup_list      = table + lookup_list_offset;
+    Size   lookup_list_size = size - lookup_list_offset;
+    RETURN_VALUE_IF (
+        lookup_list_size < sizeof (Uint16),
+        Null,
+        "Data buffer size not sufficient to read GPOS lookup list\n"
+    );
+
+    Uint8* iter         = lookup_list;
+    Uint16 lookup_count = GET_AND_ADV_U2 (iter);
+    RETURN_VALUE_IF (
+        lookup_list_size < sizeof (Uint16) * (1 + (Size)lookup_count),
+        Null,
+        "Data buffer size not sufficient to read GPOS lookup offsets\n"
+    );
+
+    if (!lookup_count) {
+        return gpos;
+    }
+
+    Bool* is_kern_lookup = ALLOCATE (Bool, lookup_count);
+    RETURN_VALUE_IF (!is_kern_lookup, Null, ERR_OUT_OF_MEMORY);
+
+    GOTO_HANDLER_IF (
+        !mark_kern_lookups (
+            is_kern_lookup,
+            lookup_count,
+            table + feature_list_offset,
+            size - feature_list_offset
+        ),
+        INIT_FAILED,
+        "Failed to read GPOS feature list\n"
+    );
+
+    /* lookups are applied in lookup list order, not in feature order */
+    for (Uint16 l = 0; l < lookup_count; l++) {
+        Uint16 lookup_offset = GET_AND_ADV_U2 (iter);
+
+        if (!is_kern_lookup[l]) {
+            continue;
+        }
+
+        GOTO_HANDLER_IF (
+            lookup_offset >= lookup_list_size,
+            INIT_FAILED,
+            "Invalid lookup offset in GPOS lookup list\n"
+        );
+
+        GOTO_HANDLER_IF (
+            !lookup_init (gpos, l, lookup_list + lookup_offset, lookup_list_size - lookup_offset),
+            INIT_FAILED,
+            "Failed to read a GPOS lookup\n"
+        );
+    }
+
+    FREE (is_kern_lookup);
+    return gpos;
+
+INIT_FAILED:
+    FREE (is_kern_lookup);
+    otf_gpos_deinit (gpos);
+    return Null;
+}
+
+/**
+ * @b De-initialize the contents of given @c OtfGpos table object.
+ *
+ * @param gpos GPOS table object to be de-initialized.
+ *
+ * @return @c gpos on success.
+ * @return @c Null otherwise.
+ * */
+OtfGpos* otf_gpos_deinit (OtfGpos* gpos) {
+    RETURN_VALUE_IF (!gpos, Null, ERR_INVALID_ARGUMENTS);
+
+    if (gpos->pair_adjustments) {
+        for (Size s = 0; s < gpos->num_pair_adjustments; s++) {
+            pair_adjust_deinit (gpos->pair_adjustments + s);
+        }
+
+        FREE (gpos->pair_adjustments);
+    }
+
+    memset (gpos, 0, sizeof (OtfGpos));
+
+    return gpos;
+}
+
+OtfGpos* otf_gpos_pprint (OtfGpos* gpos, Uint8 indent_level) {
+    RETURN_VALUE_IF (!gpos, Null, ERR_INVALID_ARGUMENTS);
+
+    Char indent[indent_level + 1];
+    memset (indent, '\t', indent_level);
+    indent[indent_level] = 0;
+
+    printf (
+        "|%.*s|OTF Glyph Positioning Table (GPOS):\n"
+        "|%s|major_version = %u\n"
+        "|%s|minor_version = %u\n"
+        "|%s|num_pair_adjustments = %u\n",
+        indent_level - 1 ? indent_level - 1 : 1,
+        indent,
+        indent,
+        gpos->major_version,
+        indent,
+        gpos->minor_version,
+        indent,
+        gpos->num_pair_adjustments
+    );
+
+    for (Size s = 0; s < gpos->num_pair_adjustments; s++) {
+        pair_adjust_pprint (gpos->pair_adjustments + s, indent_level + 1);
+    }
+
+    return gpos;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Go through feature list and mark all lookups referenced by "kern" features.
+ *
+ * @param marks Array of @c lookup_count booleans.
+ * @param lookup_count Number of lookups in lookup list.
+ * @param data Data buffer starting at feature list.
+ * @param size Size of data buffer.
+ *
+ * @return @c marks on success.
+ * @return @c Null otherwise.
+ * */
+static inline Bool* mark_kern_lookups (Bool* marks, Uint16 lookup_count, Uint8* data, Size size) {
+    RETURN_VALUE_IF (!marks || !data, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (size < sizeof (Uint16), Null, "Feature list size not sufficient\n");
+
+    Uint8* iter          = data;
+    Uint16 feature_count = GET_AND_ADV_U2 (iter);
+    RETURN_VALUE_IF (
+        size < sizeof (Uint16) + FEATURE_RECORD_DATA_SIZE * feature_count,
+        Null,
+        "Feature list size not sufficient to read all feature records\n"
+    );
+
+    for (Size f = 0; f < feature_count; f++) {
+        Bool is_kern  = !memcmp (iter, "kern", 4);
+        iter         += 4;
+
+        Uint16 feature_offset = GET_AND_ADV_U2 (iter);
+        if (!is_kern) {
+            continue;
+        }
+
+        RETURN_VALUE_IF (
+            feature_offset + sizeof (Uint16) * 2 > size,
+            Null,
+            "Invalid feature offset in feature list\n"
+        );
+
+        Uint8* feature           = data + feature_offset + sizeof (Uint16); /* skip params offset */
+        Uint16 lookup_index_count = GET_AND_ADV_U2 (feature);
+        RETURN_VALUE_IF (
+            feature_offset + sizeof (Uint16) * (2 + (Size)lookup_index_count) > size,
+            Null,
+            "Feature table size not sufficient to read all lookup indices\n"
+        );
+
+        for (Size i = 0; i < lookup_index_count; i++) {
+            Uint16 lookup_index = GET_AND_ADV_U2 (feature);
+            if (lookup_index < lookup_count) {
+                marks[lookup_index] = True;
+            }
+        }
+    }
+
+    return marks;
+}
+
+/**
+ * @b Decode all pair adjustment subtables in given lookup and append them to @c gpos.
+ *
+ * @param gpos GPOS table to append decoded subtables to.
+ * @param lookup_index Index of this lookup in lookup list.
+ * @param data Data buffer starting at lookup table.
+ * @param size Size of data buffer.
+ *
+ * @return @c gpos on success.
+ * @return @c Null otherwise.
+ * */
+static inline OtfGpos* lookup_init (OtfGpos* gpos, Uint16 lookup_index, Uint8* data, Size size) {
+    RETURN_VALUE_IF (!gpos || !data, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (size < LOOKUP_DATA_SIZE, Null, "Lookup table size not sufficient\n");
+
+    Uint8* iter           = data;
+    Uint16 lookup_type    = GET_AND_ADV_U2 (iter);
+    Uint16 lookup_flag    = GET_AND_ADV_U2 (iter);
+    Uint16 subtable_count = GET_AND_ADV_U2 (iter);
+    UNUSED (lookup_flag);
+
+    if (lookup_type != OTF_GPOS_LOOKUP_TYPE_PAIR_ADJUSTMENT &&
+        lookup_type != OTF_GPOS_LOOKUP_TYPE_EXTENSION) {
+        return gpos;
+    }
+
+    RETURN_VALUE_IF (
+        size < LOOKUP_DATA_SIZE + sizeof (Uint16) * subtable_count,
+        Null,
+        "Lookup table size not sufficient to read all subtable offsets\n"
+    );
+
+    for (Size s = 0; s < subtable_count; s++) {
+        Uint16 subtable_offset = GET_AND_ADV_U2 (iter);
+        RETURN_VALUE_IF (subtable_offset >= size, Null, "Invalid subtable offset in lookup\n");
+
+        Uint8* subtable      = data + subtable_offset;
+        Size   subtable_size = size - subtable_offset;
+
+        /* extension subtables contain a 32-bit offset to actual subtable */
+        if (lookup_type == OTF_GPOS_LOOKUP_TYPE_EXTENSION) {
+            RETURN_VALUE_IF (
+                subtable_size < EXTENSION_POS_DATA_SIZE,
+                Null,
+                "Extension subtable size not sufficient\n"
+            );
+
+            Uint8* ext              = subtable;
+            Uint16 ext_format       = GET_AND_ADV_U2 (ext);
+            Uint16 ext_lookup_type  = GET_AND_ADV_U2 (ext);
+            Uint32 ext_offset       = GET_AND_ADV_U4 (ext);
+
+            if (ext_format != 1 || ext_lookup_type != OTF_GPOS_LOOKUP_TYPE_PAIR_ADJUSTMENT) {
+                continue;
+            }
+
+            RETURN_VALUE_IF (
+                ext_offset >= subtable_size,
+                Null,
+                "Invalid extension offset in extension subtable\n"
+            );
+
+            subtable      += ext_offset;
+            subtable_size -= ext_offset;
+        }
+
+        Size               new_count   = gpos->num_pair_adjustments + 1;
+        OtfGposPairAdjust* adjustments = REALLOCATE (
+            gpos->pair_adjustments,
+            OtfGposPairAdjust,
+            new_count
+        );
+        RETURN_VALUE_IF (!adjustments, Null, ERR_OUT_OF_MEMORY);
+        gpos->pair_adjustments = adjustments;
+
+        RETURN_VALUE_IF (
+            !pair_adjust_init (
+                gpos->pair_adjustments + gpos->num_pair_adjustments,
+                lookup_index,
+                subtable,
+                subtable_size
+            ),
+            Null,
+            "Failed to read a pair adjustment subtable\n"
+        );
+
+        gpos->num_pair_adjustments++;
+    }
+
+    return gpos;
+}
+
+/**
+ * @b Read a coverage table and expand it into an array of glyph ids indexed
+ * by coverage index.
+ *
+ * @param glyphs Will contain allocated array of glyph ids.
+ * @param count Will contain number of entries in glyph array.
+ * @param data Data buffer starting at coverage table.
+ * @param size Size of data buffer.
+ *
+ * @return @c glyphs on success.
+ * @return @c Null otherwise.
+ * */
+static inline Uint16** coverage_init (Uint16** glyphs, Uint16* count, Uint8* data, Size size) {
+    RETURN_VALUE_IF (!glyphs || !count || !data, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (size < sizeof (Uint16) * 2, Null, "Coverage table size not sufficient\n");
+
+    Uint16 format = GET_AND_ADV_U2 (data);
+    Uint16 num    = GET_AND_ADV_U2 (data);
+    size         -= sizeof (Uint16) * 2;
+
+    *glyphs = Null;
+    *count  = 0;
+
+    switch (format) {
+        case 1 : {
+            RETURN_VALUE_IF (
+                size < sizeof (Uint16) * num,
+                Null,
+                "Coverage table size not sufficient to read glyph array\n"
+            );
+
+            if (num) {
+                RETURN_VALUE_IF (!(*glyphs = ALLOCATE (Uint16, num)), Null, ERR_OUT_OF_MEMORY);
+                GET_ARR_AND_ADV_U2 ((*glyphs), 0, num);
+            }
+
+            *count = num;
+            return glyphs;
+        }
+
+        case 2 : {
+            RETURN_VALUE_IF (
+                size < COVERAGE_RANGE_DATA_SIZE * num,
+                Null,
+                "Coverage table size not sufficient to read range records\n"
+            );
+
+            /* first pass to get total number of covered glyphs */
+            Uint8* iter  = data;
+            Size   total = 0;
+            for (Size r = 0; r < num; r++) {
+                Uint16 start       = GET_AND_ADV_U2 (iter);
+                Uint16 end         = GET_AND_ADV_U2 (iter);
+                Uint16 start_index = GET_AND_ADV_U2 (iter);
+                RETURN_VALUE_IF (start > end, Null, "Invalid range record in coverage table\n");
+                total = MAX (total, (Size)start_index + (end - start) + 1);
+            }
+
+            RETURN_VALUE_IF (total > (Uint16)-1, Null, "Too many glyphs in coverage table\n");
+
+            if (total) {
+                RETURN_VALUE_IF (!(*glyphs = ALLOCATE (Uint16, total)), Null, ERR_OUT_OF_MEMORY);
+            }
+
+            for (Size r = 0; r < num; r++) {
+                Uint16 start       = GET_AND_ADV_U2 (data);
+                Uint16 end         = GET_AND_ADV_U2 (data);
+                Uint16 start_index = GET_AND_ADV_U2 (data);
+                for (Size g = start; g <= end; g++) {
+                    (*glyphs)[start_index + g - start] = g;
+                }
+            }
+
+            *count = total;
+            return glyphs;
+        }
+
+        default :
+            RETURN_VALUE_IF_REACHED (Null, "Invalid coverage table format %u\n", format);
+    }
+}
+
+/**
+ * @b Read a ClassDef table and normalize it into a sorted list of glyph ranges.
+ *
+ * @param class_def ClassDef object to be initialized.
+ * @param data Data buffer starting at class definition table.
+ * @param size Size of data buffer.
+ *
+ * @return @c class_def on success.
+ * @return @c Null otherwise.
+ * */
+static inline OtfGposClassDef* class_def_init (OtfGposClassDef* class_def, Uint8* data, Size size) {
+    RETURN_VALUE_IF (!class_def || !data, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (size < sizeof (Uint16) * 2, Null, "ClassDef table size not sufficient\n");
+
+    memset (class_def, 0, sizeof (OtfGposClassDef));
+
+    Uint16 format  = GET_AND_ADV_U2 (data);
+    size          -= sizeof (Uint16);
+
+    switch (format) {
+        case 1 : {
+            RETURN_VALUE_IF (
+                size < sizeof (Uint16) * 2,
+                Null,
+                "ClassDef format 1 table size not sufficient\n"
+            );
+
+            Uint16 start_glyph  = GET_AND_ADV_U2 (data);
+            Uint16 glyph_count  = GET_AND_ADV_U2 (data);
+            size               -= sizeof (Uint16) * 2;
+
+            RETURN_VALUE_IF (
+                size < sizeof (Uint16) * glyph_count,
+                Null,
+                "ClassDef format 1 table size not sufficient to read class values\n"
+            );
+            RETURN_VALUE_IF (
+                (Size)start_glyph + glyph_count > (Size)(Uint16)-1 + 1,
+                Null,
+                "Invalid glyph range in ClassDef format 1 table\n"
+            );
+
+            /* first pass to count runs of same non-zero class value */
+            Uint8* iter       = data;
+            Size   num_ranges = 0;
+            Uint16 prev_class = 0;
+            for (Size g = 0; g < glyph_count; g++) {
+                Uint16 class_value = GET_AND_ADV_U2 (iter);
+                if (class_value && class_value != prev_class) {
+                    num_ranges++;
+                }
+                prev_class = class_value;
+            }
+
+            if (!num_ranges) {
+                return class_def;
+            }
+
+            RETURN_VALUE_IF (
+                !(class_def->ranges = ALLOCATE (OtfGposClassRange, num_ranges)),
+                Null,
+                ERR_OUT_OF_MEMORY
+            );
+
+            OtfGposClassRange* range = Null;
+            prev_class               = 0;
+            for (Size g = 0; g < glyph_count; g++) {
+                Uint16 class_value = GET_AND_ADV_U2 (data);
+                if (class_value && class_value != prev_class) {
+                    range                 = class_def->ranges + class_def->num_ranges++;
+                    range->start_glyph_id = start_glyph + g;
+                    range->class_value    = class_value;
+                }
+                if (class_value) {
+                    range->end_glyph_id = start_glyph + g;
+                }
+                prev_class = class_value;
+            }
+
+            return class_def;
+        }
+
+        case 2 : {
+            RETURN_VALUE_IF (
+                size < sizeof (Uint16),
+                Null,
+                "ClassDef format 2 table size not sufficient\n"
+            );
+
+            Uint16 num_ranges  = GET_AND_ADV_U2 (data);
+            size              -= sizeof (Uint16);
+
+            RETURN_VALUE_IF (
+                size < CLASS_RANGE_DATA_SIZE * num_ranges,
+                Null,
+                "ClassDef format 2 table size not sufficient to read range records\n"
+            );
+
+            if (!num_ranges) {
+                return class_def;
+            }
+
+            RETURN_VALUE_IF (
+                !(class_def->ranges = ALLOCATE (OtfGposClassRange, num_ranges)),
+                Null,
+                ERR_OUT_OF_MEMORY
+            );
+            class_def->num_ranges = num_ranges;
+
+            for (Size r = 0; r < num_ranges; r++) {
+                class_def->ranges[r].start_glyph_id = GET_AND_ADV_U2 (data);
+                class_def->ranges[r].end_glyph_id   = GET_AND_ADV_U2 (data);
+                class_def->ranges[r].class_value    = GET_AND_ADV_U2 (data);
+
+                GOTO_HANDLER_IF (
+                    class_def->ranges[r].start_glyph_id > class_def->ranges[r].end_glyph_id,
+                    INIT_FAILED,
+                    "Invalid range record in ClassDef format 2 table\n"
+                );
+            }
+
+            return class_def;
+        }
+
+        default :
+            RETURN_VALUE_IF_REACHED (Null, "Invalid ClassDef table format %u\n", format);
+    }
+
+INIT_FAILED:
+    class_def_deinit (class_def);
+    return Null;
+}
+
+static inline OtfGposClassDef* class_def_deinit (OtfGposClassDef* class_def) {
+    RETURN_VALUE_IF (!class_def, Null, ERR_INVALID_ARGUMENTS);
+
+    if (class_def->ranges) {
+        FREE (class_def->ranges);
+    }
+
+    memset (class_def, 0, sizeof (OtfGposClassDef));
+
+    return class_def;
+}
+
+/**
+ * @b Initialize a pair adjustment positioning subtable (format 1 or 2).
+ *
+ * @param adj Pair adjustment object to be initialized.
+ * @param lookup_index Index of lookup this subtable belongs to.
+ * @param data Data buffer starting at pair adjustment subtable.
+ * @param size Size of data buffer.
+ *
+ * @return @c adj on success.
+ * @return @c Null otherwise.
+ * */
+static inline OtfGposPairAdjust*
+    pair_adjust_init (OtfGposPairAdjust* adj, Uint16 lookup_index, Uint8* data, Size size) {
+    RETURN_VALUE_IF (!adj || !data, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        size < PAIR_POS_DATA_SIZE,
+        Null,
+        "Data buffer size not sufficient to read pair adjustment subtable\n"
+    );
+
+    memset (adj, 0, sizeof (OtfGposPairAdjust));
+
+    Uint8* iter            = data;
+    Uint16 pos_format      = GET_AND_ADV_U2 (iter);
+    Uint16 coverage_offset = GET_AND_ADV_U2 (iter);
+    adj->value_format1     = GET_AND_ADV_U2 (iter);
+    adj->value_format2     = GET_AND_ADV_U2 (iter);
+    adj->lookup_index      = lookup_index;
+
+    RETURN_VALUE_IF (
+        pos_format != 1 && pos_format != 2,
+        Null,
+        "Invalid pair adjustment subtable format %u\n",
+        pos_format
+    );
+    adj->pos_format = pos_format;
+
+    RETURN_VALUE_IF (
+        coverage_offset >= size,
+        Null,
+        "Invalid coverage offset in pair adjustment subtable\n"
+    );
+    RETURN_VALUE_IF (
+        !coverage_init (
+            &adj->covered_glyphs,
+            &adj->num_covered_glyphs,
+            data + coverage_offset,
+            size - coverage_offset
+        ),
+        Null,
+        "Failed to read coverage table of pair adjustment subtable\n"
+    );
+
+    Size value1_size = value_record_size (adj->value_format1);
+    Size value2_size = value_record_size (adj->value_format2);
+
+    if (pos_format == 1) {
+        GOTO_HANDLER_IF (
+            size < PAIR_POS_FORMAT1_DATA_SIZE,
+            INIT_FAILED,
+            "Data buffer size not sufficient to read pair adjustment format 1 subtable\n"
+        );
+
+        Uint16 pair_set_count = GET_AND_ADV_U2 (iter);
+        GOTO_HANDLER_IF (
+            size < PAIR_POS_FORMAT1_DATA_SIZE + sizeof (Uint16) * pair_set_count,
+            INIT_FAILED,
+            "Data buffer size not sufficient to read pair set offsets\n"
+        );
+
+        /* one pair set per covered glyph, ignore the extra ones */
+        Uint16 num_pair_sets = MIN (pair_set_count, adj->num_covered_glyphs);
+        if (!num_pair_sets) {
+            return adj;
+        }
+
+        GOTO_HANDLER_IF (
+            !(adj->format1.pair_sets = ALLOCATE (OtfGposPairSet, num_pair_sets)),
+            INIT_FAILED,
+            ERR_OUT_OF_MEMORY
+        );
+        adj->format1.num_pair_sets = num_pair_sets;
+
+        Size pair_value_size = sizeof (Uint16) + value1_size + value2_size;
+        for (Size s = 0; s < num_pair_sets; s++) {
+            Uint16 pair_set_offset = GET_AND_ADV_U2 (iter);
+            GOTO_HANDLER_IF (
+                pair_set_offset + sizeof (Uint16) > size,
+                INIT_FAILED,
+                "Invalid pair set offset in pair adjustment subtable\n"
+            );
+
+            Uint8* pair_set         = data + pair_set_offset;
+            Uint16 pair_value_count = GET_AND_ADV_U2 (pair_set);
+            GOTO_HANDLER_IF (
+                pair_set_offset + sizeof (Uint16) + pair_value_size * pair_value_count > size,
+                INIT_FAILED,
+                "Data buffer size not sufficient to read pair value records\n"
+            );
+
+            if (!pair_value_count) {
+                continue;
+            }
+
+            OtfGposPairSet* set = adj->format1.pair_sets + s;
+            GOTO_HANDLER_IF (
+                !(set->pair_values = ALLOCATE (OtfGposPairValue, pair_value_count)),
+                INIT_FAILED,
+                ERR_OUT_OF_MEMORY
+            );
+            set->num_pair_values = pair_value_count;
+
+            for (Size v = 0; v < pair_value_count; v++) {
+                set->pair_values[v].second_glyph = GET_AND_ADV_U2 (pair_set);
+                set->pair_values[v].x_advance =
+                    value_record_x_advance (pair_set, adj->value_format1);
+                pair_set += value1_size + value2_size;
+            }
+        }
+    } else {
+        GOTO_HANDLER_IF (
+            size < PAIR_POS_FORMAT2_DATA_SIZE,
+            INIT_FAILED,
+            "Data buffer size not sufficient to read pair adjustment format 2 subtable\n"
+        );
+
+        Uint16 class_def1_offset   = GET_AND_ADV_U2 (iter);
+        Uint16 class_def2_offset   = GET_AND_ADV_U2 (iter);
+        adj->format2.class1_count  = GET_AND_ADV_U2 (iter);
+        adj->format2.class2_count  = GET_AND_ADV_U2 (iter);
+
+        Size matrix_size = (Size)adj->format2.class1_count * adj->format2.class2_count;
+        GOTO_HANDLER_IF (
+            size < PAIR_POS_FORMAT2_DATA_SIZE + matrix_size * (value1_size + value2_size),
+            INIT_FAILED,
+            "Data buffer size not sufficient to read class records\n"
+        );
+
+        GOTO_HANDLER_IF (
+            class_def1_offset >= size || class_def2_offset >= size,
+            INIT_FAILED,
+            "Invalid ClassDef offset in pair adjustment subtable\n"
+        );
+        GOTO_HANDLER_IF (
+            !class_def_init (
+                &adj->format2.class_def1,
+                data + class_def1_offset,
+                size - class_def1_offset
+            ) ||
+                !class_def_init (
+                    &adj->format2.class_def2,
+                    data + class_def2_offset,
+                    size - class_def2_offset
+                ),
+            INIT_FAILED,
+            "Failed to read ClassDef tables of pair adjustment subtable\n"
+        );
+
+        if (!matrix_size) {
+            return adj;
+        }
+
+        GOTO_HANDLER_IF (
+            !(adj->format2.x_advances = ALLOCATE (Int16, matrix_size)),
+            INIT_FAILED,
+            ERR_OUT_OF_MEMORY
+        );
+
+        for (Size s = 0; s < matrix_size; s++) {
+            adj->format2.x_advances[s]  = value_record_x_advance (iter, adj->value_format1);
+            iter                       += value1_size + value2_size;
+        }
+    }
+
+    return adj;
+
+INIT_FAILED:
+    pair_adjust_deinit (adj);
+    return Null;
+}
+
+static inline OtfGposPairAdjust* pair_adjust_deinit (OtfGposPairAdjust* adj) {
+    RETURN_VALUE_IF (!adj, Null, ERR_INVALID_ARGUMENTS);
+
+    if (adj->covered_glyphs) {
+        FREE (adj->covered_glyphs);
+    }
+
+    if (adj->pos_format == 1 && adj->format1.pair_sets) {
+        for (Size s = 0; s < adj->format1.num_pair_sets; s++) {
+            if (adj->format1.pair_sets[s].pair_values) {
+                FREE (adj->format1.pair_sets[s].pair_values);
+            }
+        }
+
+        FREE (adj->format1.pair_sets);
+    } else if (adj->pos_format == 2) {
+        class_def_deinit (&adj->format2.class_def1);
+        class_def_deinit (&adj->format2.class_def2);
+
+        if (adj->format2.x_advances) {
+            FREE (adj->format2.x_advances);
+        }
+    }
+
+    memset (adj, 0, sizeof (OtfGposPairAdjust));
+
+    return adj;
+}
+
+static inline OtfGposPairAdjust* pair_adjust_pprint (OtfGposPairAdjust* adj, Uint8 indent_level) {
+    RETURN_VALUE_IF (!adj, Null, ERR_INVALID_ARGUMENTS);
+
+    Char indent[indent_level + 1];
+    memset (indent, '\t', indent_level);
+    indent[indent_level] = 0;
+
+    printf (
+        "|%.*s|OTF GPOS Pair Adjustment Subtable :\n"
+        "|%s|pos_format = %u\n"
+        "|%s|lookup_index = %u\n"
+        "|%s|value_format1 = 0x%04x\n"
+        "|%s|value_format2 = 0x%04x\n"
+        "|%s|num_covered_glyphs = %u\n",
+        indent_level - 1 ? indent_level - 1 : 1,
+        indent,
+        indent,
+        adj->pos_format,
+        indent,
+        adj->lookup_index,
+        indent,
+        adj->value_format1,
+        indent,
+        adj->value_format2,
+        indent,
+        adj->num_covered_glyphs
+    );
+
+    if (adj->pos_format == 1) {
+        printf ("|%s|num_pair_sets = %u\n", indent, adj->format1.num_pair_sets);
+    } else {
+        printf (
+            "|%s|class1_count = %u\n"
+            "|%s|class2_count = %u\n"
+            "|%s|class_def1.num_ranges = %u\n"
+            "|%s|class_def2.num_ranges = %u\n",
+            indent,
+            adj->format2.class1_count,
+            indent,
+            adj->format2.class2_count,
+            indent,
+            adj->format2.class_def1.num_ranges,
+            indent,
+            adj->format2.class_def2.num_ranges
+        );
+    }
+
+    return adj;
+}
+
+/**
+ * @b Get size of a ValueRecord described by given value format.
+ * Each set bit in lower byte adds one 16-bit field to the record.
+ * */
+static inline Size value_record_size (Uint16 value_format) {
+    return sizeof (Uint16) * __builtin_popcount (value_format & 0xff);
+}
+
+/**
+ * @b Extract XAdvance field from ValueRecord, zero if value format does not have it.
+ * */
+static inline Int16 value_record_x_advance (Uint8* data, Uint16 value_format) {
+    if (!(value_format & OTF_GPOS_VALUE_FORMAT_X_ADVANCE)) {
+        return 0;
+    }
+
+    data += value_record_size (
+        value_format & (OTF_GPOS_VALUE_FORMAT_X_PLACEMENT | OTF_GPOS_VALUE_FORMAT_Y_PLACEMENT)
+    );
+    return GET_AND_ADV_I2 (data);
+}
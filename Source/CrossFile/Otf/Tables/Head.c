@@ -40,28 +40,28 @@
 #include <memory.h>
 #include <time.h>
 
-static inline Char* mac_style_flag_to_str (XfOtfMacStyleFlags mac_style, Char* buf, Size size);
-static inline Char* head_flags_to_str (XfOtfHeadFlags flags, Char* buf, Size size);
-static inline Char* font_direction_into_to_str (XfOtfFontDirectionHint hint, Char* buf, Size size);
+static inline Char* mac_style_flag_to_str (OtfMacStyleFlags mac_style, Char* buf, Size size);
+static inline Char* head_flags_to_str (OtfHeadFlags flags, Char* buf, Size size);
+static inline Char* font_direction_into_to_str (OtfFontDirectionHint hint, Char* buf, Size size);
 
 /**************************************************************************************************/
 /*********************************** PUBLIC METHOD DEFINITIONS ************************************/
 /**************************************************************************************************/
 
 /**
- * @b Initialize @c XfOtfHead structure with proper endianness.
+ * @b Initialize @c OtfHead structure with proper endianness.
  *
- * @param head Reference to @c XfOtfHead structure where initialization
+ * @param head Reference to @c OtfHead structure where initialization
  *        will take place.
  * @param data Reference to raw data that needs to be adjusted before loading.
  *
  * @return @c head on success.
  * @return @c Null otherwise.
  * */
-XfOtfHead* xf_otf_head_init (XfOtfHead* head, Uint8* data, Size size) {
+OtfHead* otf_head_init (OtfHead* head, Uint8* data, Size size) {
     RETURN_VALUE_IF (!head || !data, Null, ERR_INVALID_ARGUMENTS);
     RETURN_VALUE_IF (
-        size < XF_OTF_HEAD_DATA_SIZE,
+        size < OTF_HEAD_DATA_SIZE,
         Null,
         "Data buffer size not sufficient to initialize head table \"head\".\n"
     );
@@ -111,14 +111,14 @@ XfOtfHead* xf_otf_head_init (XfOtfHead* head, Uint8* data, Size size) {
 }
 
 /**
- * @b Pretty print given @c XfOtfHead structure.
+ * @b Pretty print given @c OtfHead structure.
  *
  * @param head
  *
  * @return @c head on success.
  * @return @c Null otherwise.
  * */
-XfOtfHead* xf_otf_head_pprint (XfOtfHead* head, Uint8 indent_level) {
+OtfHead* otf_head_pprint (OtfHead* head, Uint8 indent_level) {
     RETURN_VALUE_IF (!head, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -236,13 +236,13 @@ XfOtfHead* xf_otf_head_pprint (XfOtfHead* head, Uint8 indent_level) {
  * @return @c buf on success.
  * @return @c Null otherwise.
  * */
-static inline Char* mac_style_flag_to_str (XfOtfMacStyleFlags mac_style, Char* buf, Size size) {
+static inline Char* mac_style_flag_to_str (OtfMacStyleFlags mac_style, Char* buf, Size size) {
     RETURN_VALUE_IF (!buf || !size, Null, ERR_INVALID_ARGUMENTS);
 
     Bool add_pipe = False;
 
-#define XF_OTF_PPRINT_FLAG(name)                                                                   \
-    if (mac_style & XF_OTF_MAC_STYLE_FLAG_##name) {                                                \
+#define OTF_PPRINT_FLAG(name)                                                                      \
+    if (mac_style & OTF_MAC_STYLE_FLAG_##name) {                                                   \
         Size printed_size = snprintf (buf, size, "%s%s", add_pipe ? " | " : "", #name);            \
         if (!printed_size || size == printed_size) {                                               \
             return buf;                                                                            \
@@ -252,15 +252,15 @@ static inline Char* mac_style_flag_to_str (XfOtfMacStyleFlags mac_style, Char* b
         add_pipe  = True;                                                                          \
     }
 
-    XF_OTF_PPRINT_FLAG (BOLD);
-    XF_OTF_PPRINT_FLAG (ITALIC);
-    XF_OTF_PPRINT_FLAG (UNDERLINE);
-    XF_OTF_PPRINT_FLAG (OUTLINE);
-    XF_OTF_PPRINT_FLAG (SHADOW);
-    XF_OTF_PPRINT_FLAG (CONDENSED);
-    XF_OTF_PPRINT_FLAG (EXTENDED);
+    OTF_PPRINT_FLAG (BOLD);
+    OTF_PPRINT_FLAG (ITALIC);
+    OTF_PPRINT_FLAG (UNDERLINE);
+    OTF_PPRINT_FLAG (OUTLINE);
+    OTF_PPRINT_FLAG (SHADOW);
+    OTF_PPRINT_FLAG (CONDENSED);
+    OTF_PPRINT_FLAG (EXTENDED);
 
-#undef XF_OTF_PPRINT_FLAG
+#undef OTF_PPRINT_FLAG
 
     return buf;
 }
@@ -275,13 +275,13 @@ static inline Char* mac_style_flag_to_str (XfOtfMacStyleFlags mac_style, Char* b
  * @return @c buf on success.
  * @return @c Null otherwise.
  * */
-static inline Char* head_flags_to_str (XfOtfHeadFlags flags, Char* buf, Size size) {
+static inline Char* head_flags_to_str (OtfHeadFlags flags, Char* buf, Size size) {
     RETURN_VALUE_IF (!buf || !size, Null, ERR_INVALID_ARGUMENTS);
 
     Bool add_pipe = False;
 
-#define XF_OTF_PPRINT_FLAG(name)                                                                   \
-    if (flags & XF_OTF_HEAD_FLAG_##name) {                                                         \
+#define OTF_PPRINT_FLAG(name)                                                                      \
+    if (flags & OTF_HEAD_FLAG_##name) {                                                            \
         Size printed_size = snprintf (buf, size, "%s%s", add_pipe ? " | " : "", #name);            \
         if (!printed_size || size == printed_size) {                                               \
             return buf;                                                                            \
@@ -292,17 +292,17 @@ static inline Char* head_flags_to_str (XfOtfHeadFlags flags, Char* buf, Size siz
     }
 
 
-    XF_OTF_PPRINT_FLAG (FONT_BASELINE_Y_EQ_0);
-    XF_OTF_PPRINT_FLAG (FONT_LEFT_SIDEBAR_X_EQ_0);
-    XF_OTF_PPRINT_FLAG (INSNS_DEPEND_ON_POINT_SIZE);
-    XF_OTF_PPRINT_FLAG (FORCE_PPEM_TO_INT);
-    XF_OTF_PPRINT_FLAG (INSNS_ALTER_ADVANCE_WIDTH);
-    XF_OTF_PPRINT_FLAG (LOSSLESS);
-    XF_OTF_PPRINT_FLAG (CONVERTED);
-    XF_OTF_PPRINT_FLAG (FONT_OPTIMIZED_FOR_CLEAR_TYPE);
-    XF_OTF_PPRINT_FLAG (LAST_RESORT_FONT);
+    OTF_PPRINT_FLAG (FONT_BASELINE_Y_EQ_0);
+    OTF_PPRINT_FLAG (FONT_LEFT_SIDEBAR_X_EQ_0);
+    OTF_PPRINT_FLAG (INSNS_DEPEND_ON_POINT_SIZE);
+    OTF_PPRINT_FLAG (FORCE_PPEM_TO_INT);
+    OTF_PPRINT_FLAG (INSNS_ALTER_ADVANCE_WIDTH);
+    OTF_PPRINT_FLAG (LOSSLESS);
+    OTF_PPRINT_FLAG (CONVERTED);
+    OTF_PPRINT_FLAG (FONT_OPTIMIZED_FOR_CLEAR_TYPE);
+    OTF_PPRINT_FLAG (LAST_RESORT_FONT);
 
-#undef XF_OTF_PPRINT_FLAG
+#undef OTF_PPRINT_FLAG
 
     return buf;
 }
@@ -317,11 +317,11 @@ static inline Char* head_flags_to_str (XfOtfHeadFlags flags, Char* buf, Size siz
  * @return @c buf on success.
  * @return @c Null otherwise.
  * */
-static inline Char* font_direction_into_to_str (XfOtfFontDirectionHint hint, Char* buf, Size size) {
+static inline Char* font_direction_into_to_str (OtfFontDirectionHint hint, Char* buf, Size size) {
     RETURN_VALUE_IF (!buf || !size, Null, ERR_INVALID_ARGUMENTS);
 
-#define XF_OTF_PPRINT_FLAG(name)                                                                   \
-    else if (hint == XF_OTF_FONT_DIRECTION_HINT_##name) {                                          \
+#define OTF_PPRINT_FLAG(name)                                                                      \
+    else if (hint == OTF_FONT_DIRECTION_HINT_##name) {                                             \
         Size printed_size = snprintf (buf, size, #name);                                           \
         if (!printed_size || size == printed_size) {                                               \
             return buf;                                                                            \
@@ -333,11 +333,11 @@ static inline Char* font_direction_into_to_str (XfOtfFontDirectionHint hint, Cha
     /* dummy check to activate the following macros */
     if (False) {}
 
-    XF_OTF_PPRINT_FLAG (LEFT_TO_RIGHT)
-    XF_OTF_PPRINT_FLAG (LEFT_TO_RIGHT_STRONG)
-    XF_OTF_PPRINT_FLAG (FULLY_MIXED)
-    XF_OTF_PPRINT_FLAG (RIGHT_TO_LEFT)
-    XF_OTF_PPRINT_FLAG (RIGHT_TO_LEFT_STRONG)
+    OTF_PPRINT_FLAG (LEFT_TO_RIGHT)
+    OTF_PPRINT_FLAG (LEFT_TO_RIGHT_STRONG)
+    OTF_PPRINT_FLAG (FULLY_MIXED)
+    OTF_PPRINT_FLAG (RIGHT_TO_LEFT)
+    OTF_PPRINT_FLAG (RIGHT_TO_LEFT_STRONG)
 
     return buf;
 }
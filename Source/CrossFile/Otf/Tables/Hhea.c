@@ -41,7 +41,7 @@
 
 #define HHEA_DATA_SIZE (sizeof (Uint16) * 18)
 
-XfOtfHhea *xf_otf_hhea_init (XfOtfHhea *hhea, Uint8 *data, Size size) {
+OtfHhea *otf_hhea_init (OtfHhea *hhea, Uint8 *data, Size size) {
     RETURN_VALUE_IF (!hhea || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -71,7 +71,7 @@ XfOtfHhea *xf_otf_hhea_init (XfOtfHhea *hhea, Uint8 *data, Size size) {
 
     return hhea;
 }
-XfOtfHhea *xf_otf_hhea_pprint (XfOtfHhea *hhea, Uint8 indent_level) {
+OtfHhea *otf_hhea_pprint (OtfHhea *hhea, Uint8 indent_level) {
     RETURN_VALUE_IF (!hhea, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
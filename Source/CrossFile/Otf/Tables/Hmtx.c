@@ -11,10 +11,10 @@
 
 /* private method declarations */
 
-static inline XfOtfHmtxLongHorMetric *
-    long_hor_metric_init (XfOtfHmtxLongHorMetric *lhm, Uint8 *data, Size size);
-static inline XfOtfHmtxLongHorMetric *
-    long_hor_metric_pprint (XfOtfHmtxLongHorMetric *lhm, Uint8 indent_leve);
+static inline OtfHmtxLongHorMetric *
+    long_hor_metric_init (OtfHmtxLongHorMetric *lhm, Uint8 *data, Size size);
+static inline OtfHmtxLongHorMetric *
+    long_hor_metric_pprint (OtfHmtxLongHorMetric *lhm, Uint8 indent_leve);
 
 #define LONG_HOR_METRIC_DATA_SIZE (sizeof (Uint16) * 2)
 
@@ -41,8 +41,8 @@ static inline XfOtfHmtxLongHorMetric *
  * @return @c hmtx on success.
  * @return @c Null otherwise.
  * */
-XfOtfHmtx *
-    xf_otf_hmtx_init (XfOtfHmtx *hmtx, XfOtfHhea *hhea, XfOtfMaxp *maxp, Uint8 *data, Size size) {
+OtfHmtx *
+    otf_hmtx_init (OtfHmtx *hmtx, OtfHhea *hhea, OtfMaxp *maxp, Uint8 *data, Size size) {
     RETURN_VALUE_IF (!hmtx || !hhea || !maxp || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -63,7 +63,7 @@ XfOtfHmtx *
         );
 
         RETURN_VALUE_IF (
-            !(hmtx->h_metrics = ALLOCATE (XfOtfHmtxLongHorMetric, hmtx->num_h_metrics)),
+            !(hmtx->h_metrics = ALLOCATE (OtfHmtxLongHorMetric, hmtx->num_h_metrics)),
             Null,
             ERR_OUT_OF_MEMORY
         );
@@ -99,19 +99,19 @@ XfOtfHmtx *
     return hmtx;
 
 INIT_FAILED:
-    xf_otf_hmtx_deinit (hmtx);
+    otf_hmtx_deinit (hmtx);
     return Null;
 }
 
 /**
- * @b De-initialize the contents of given @c XfOtfHmtx table object.
+ * @b De-initialize the contents of given @c OtfHmtx table object.
  *
  * @param hmtx Hmtx table object to be de-initialized.
  * 
  * @return @c hmtx on success.
  * @return @c Null otherwise.
  * */
-XfOtfHmtx *xf_otf_hmtx_deinit (XfOtfHmtx *hmtx) {
+OtfHmtx *otf_hmtx_deinit (OtfHmtx *hmtx) {
     RETURN_VALUE_IF (!hmtx, Null, ERR_INVALID_ARGUMENTS);
 
     if (hmtx->left_side_bearings) {
@@ -122,12 +122,12 @@ XfOtfHmtx *xf_otf_hmtx_deinit (XfOtfHmtx *hmtx) {
         FREE (hmtx->h_metrics);
     }
 
-    memset (hmtx, 0, sizeof (XfOtfHmtx));
+    memset (hmtx, 0, sizeof (OtfHmtx));
 
     return hmtx;
 }
 
-XfOtfHmtx *xf_otf_hmtx_pprint (XfOtfHmtx *hmtx, Uint8 indent_level) {
+OtfHmtx *otf_hmtx_pprint (OtfHmtx *hmtx, Uint8 indent_level) {
     RETURN_VALUE_IF (!hmtx, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -167,8 +167,8 @@ XfOtfHmtx *xf_otf_hmtx_pprint (XfOtfHmtx *hmtx, Uint8 indent_level) {
 /*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
 /**************************************************************************************************/
 
-static inline XfOtfHmtxLongHorMetric *
-    long_hor_metric_init (XfOtfHmtxLongHorMetric *lhm, Uint8 *data, Size size) {
+static inline OtfHmtxLongHorMetric *
+    long_hor_metric_init (OtfHmtxLongHorMetric *lhm, Uint8 *data, Size size) {
     RETURN_VALUE_IF (!lhm || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -183,8 +183,8 @@ static inline XfOtfHmtxLongHorMetric *
     return lhm;
 }
 
-static inline XfOtfHmtxLongHorMetric *
-    long_hor_metric_pprint (XfOtfHmtxLongHorMetric *lhm, Uint8 indent_level) {
+static inline OtfHmtxLongHorMetric *
+    long_hor_metric_pprint (OtfHmtxLongHorMetric *lhm, Uint8 indent_level) {
     RETURN_VALUE_IF (!lhm, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -0,0 +1,302 @@
+/**
+ * @file Kern.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/EndiannessHelpers.h>
+#include <Anvie/CrossFile/Otf/Tables/Kern.h>
+
+/* libc */
+#include <memory.h>
+
+/* private method declarations */
+
+static inline OtfKernSubtable *
+    kern_subtable_init (OtfKernSubtable *subtable, Uint8 *data, Size size, Size *read_size);
+static inline OtfKernSubtable *kern_subtable_deinit (OtfKernSubtable *subtable);
+static inline OtfKernSubtable *kern_subtable_pprint (OtfKernSubtable *subtable, Uint8 indent_level);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Initialize given kern table object from given data buffer.
+ *
+ * Only the OpenType (Microsoft) version of kern table is decoded.
+ * Apple's version 1.0 kern table is recognized and left empty.
+ *
+ * @param kern Kern table object to be initialized.
+ * @param data Data buffer containing data to be used to initialize kern table.
+ * @param size Size in bytes of given data buffer.
+ *
+ * @return @c kern on success.
+ * @return @c Null otherwise.
+ * */
+OtfKern *otf_kern_init (OtfKern *kern, Uint8 *data, Size size) {
+    RETURN_VALUE_IF (!kern || !data, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        size < OTF_KERN_DATA_SIZE,
+        Null,
+        "Data buffer size not sufficient to initialize kern table\n"
+    );
+
+    memset (kern, 0, sizeof (OtfKern));
+
+    kern->version = GET_AND_ADV_U2 (data);
+    if (kern->version != 0) {
+        PRINT_ERR ("Unsupported kern table version %u. Ignoring kern table.\n", kern->version);
+        kern->version = 0;
+        return kern;
+    }
+
+    kern->num_tables  = GET_AND_ADV_U2 (data);
+    size             -= OTF_KERN_DATA_SIZE;
+
+    if (!kern->num_tables) {
+        return kern;
+    }
+
+    RETURN_VALUE_IF (
+        !(kern->subtables = ALLOCATE (OtfKernSubtable, kern->num_tables)),
+        Null,
+        ERR_OUT_OF_MEMORY
+    );
+
+    for (Size s = 0; s < kern->num_tables; s++) {
+        Size read_size = 0;
+        GOTO_HANDLER_IF (
+            !kern_subtable_init (kern->subtables + s, data, size, &read_size),
+            INIT_FAILED,
+            "Failed to read a subtable in kern table\n"
+        );
+
+        data += read_size;
+        size -= read_size;
+    }
+
+    return kern;
+
+INIT_FAILED:
+    otf_kern_deinit (kern);
+    return Null;
+}
+
+/**
+ * @b De-initialize the contents of given @c OtfKern table object.
+ *
+ * @param kern Kern table object to be de-initialized.
+ *
+ * @return @c kern on success.
+ * @return @c Null otherwise.
+ * */
+OtfKern *otf_kern_deinit (OtfKern *kern) {
+    RETURN_VALUE_IF (!kern, Null, ERR_INVALID_ARGUMENTS);
+
+    if (kern->subtables) {
+        for (Size s = 0; s < kern->num_tables; s++) {
+            kern_subtable_deinit (kern->subtables + s);
+        }
+
+        FREE (kern->subtables);
+    }
+
+    memset (kern, 0, sizeof (OtfKern));
+
+    return kern;
+}
+
+OtfKern *otf_kern_pprint (OtfKern *kern, Uint8 indent_level) {
+    RETURN_VALUE_IF (!kern, Null, ERR_INVALID_ARGUMENTS);
+
+    Char indent[indent_level + 1];
+    memset (indent, '\t', indent_level);
+    indent[indent_level] = 0;
+
+    printf (
+        "|%.*s|OTF Kerning Table (kern):\n"
+        "|%s|version = %u\n"
+        "|%s|num_tables = %u\n",
+        indent_level - 1 ? indent_level - 1 : 1,
+        indent,
+        indent,
+        kern->version,
+        indent,
+        kern->num_tables
+    );
+
+    for (Size s = 0; s < kern->num_tables; s++) {
+        kern_subtable_pprint (kern->subtables + s, indent_level + 1);
+    }
+
+    return kern;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Initialize a single kern subtable.
+ *
+ * @param subtable Subtable to be initialized.
+ * @param data Data buffer starting at subtable header.
+ * @param size Size of data buffer.
+ * @param read_size Will contain number of bytes occupied by subtable in data buffer.
+ *
+ * @return @c subtable on success.
+ * @return @c Null otherwise.
+ * */
+static inline OtfKernSubtable *
+    kern_subtable_init (OtfKernSubtable *subtable, Uint8 *data, Size size, Size *read_size) {
+    RETURN_VALUE_IF (!subtable || !data || !read_size, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        size < OTF_KERN_SUBTABLE_HEADER_DATA_SIZE,
+        Null,
+        "Data buffer size not sufficient to initialize kern subtable header\n"
+    );
+
+    subtable->version  = GET_AND_ADV_U2 (data);
+    subtable->length   = GET_AND_ADV_U2 (data);
+    subtable->coverage = GET_AND_ADV_U2 (data);
+    size              -= OTF_KERN_SUBTABLE_HEADER_DATA_SIZE;
+
+    /* only format 0 subtables are understood, skip over others using the length field */
+    if (OTF_KERN_SUBTABLE_FORMAT (subtable->coverage) != 0) {
+        RETURN_VALUE_IF (
+            subtable->length < OTF_KERN_SUBTABLE_HEADER_DATA_SIZE ||
+                subtable->length - OTF_KERN_SUBTABLE_HEADER_DATA_SIZE > size,
+            Null,
+            "Invalid kern subtable length\n"
+        );
+
+        *read_size = subtable->length;
+        return subtable;
+    }
+
+    RETURN_VALUE_IF (
+        size < OTF_KERN_SUBTABLE_FORMAT0_DATA_SIZE,
+        Null,
+        "Data buffer size not sufficient to initialize kern format 0 subtable\n"
+    );
+
+    subtable->num_pairs       = GET_AND_ADV_U2 (data);
+    subtable->search_range    = GET_AND_ADV_U2 (data);
+    subtable->entry_selector  = GET_AND_ADV_U2 (data);
+    subtable->range_shift     = GET_AND_ADV_U2 (data);
+    size                     -= OTF_KERN_SUBTABLE_FORMAT0_DATA_SIZE;
+
+    /* length field is a Uint16 and overflows for fonts with many pairs,
+     * so the subtable size is always computed from number of pairs instead */
+    RETURN_VALUE_IF (
+        size < OTF_KERN_PAIR_DATA_SIZE * subtable->num_pairs,
+        Null,
+        "Data buffer size not sufficient to read all kerning pairs\n"
+    );
+
+    if (subtable->num_pairs) {
+        RETURN_VALUE_IF (
+            !(subtable->pairs = ALLOCATE (OtfKernPair, subtable->num_pairs)),
+            Null,
+            ERR_OUT_OF_MEMORY
+        );
+
+        for (Size s = 0; s < subtable->num_pairs; s++) {
+            subtable->pairs[s].left  = GET_AND_ADV_U2 (data);
+            subtable->pairs[s].right = GET_AND_ADV_U2 (data);
+            subtable->pairs[s].value = GET_AND_ADV_I2 (data);
+        }
+    }
+
+    *read_size = OTF_KERN_SUBTABLE_HEADER_DATA_SIZE + OTF_KERN_SUBTABLE_FORMAT0_DATA_SIZE +
+                 OTF_KERN_PAIR_DATA_SIZE * subtable->num_pairs;
+
+    return subtable;
+}
+
+static inline OtfKernSubtable *kern_subtable_deinit (OtfKernSubtable *subtable) {
+    RETURN_VALUE_IF (!subtable, Null, ERR_INVALID_ARGUMENTS);
+
+    if (subtable->pairs) {
+        FREE (subtable->pairs);
+    }
+
+    memset (subtable, 0, sizeof (OtfKernSubtable));
+
+    return subtable;
+}
+
+static inline OtfKernSubtable *
+    kern_subtable_pprint (OtfKernSubtable *subtable, Uint8 indent_level) {
+    RETURN_VALUE_IF (!subtable, Null, ERR_INVALID_ARGUMENTS);
+
+    Char indent[indent_level + 1];
+    memset (indent, '\t', indent_level);
+    indent[indent_level] = 0;
+
+    printf (
+        "|%.*s|OTF Kern Subtable :\n"
+        "|%s|version = %u\n"
+        "|%s|length = %u\n"
+        "|%s|coverage = 0x%04x (format %u)\n"
+        "|%s|num_pairs = %u\n",
+        indent_level - 1 ? indent_level - 1 : 1,
+        indent,
+        indent,
+        subtable->version,
+        indent,
+        subtable->length,
+        indent,
+        subtable->coverage,
+        OTF_KERN_SUBTABLE_FORMAT (subtable->coverage),
+        indent,
+        subtable->num_pairs
+    );
+
+    for (Size s = 0; s < MIN (subtable->num_pairs, 6); s++) {
+        printf (
+            "|%s|(%u, %u) = %d\n",
+            indent,
+            subtable->pairs[s].left,
+            subtable->pairs[s].right,
+            subtable->pairs[s].value
+        );
+    }
+
+    if (subtable->num_pairs > 6) {
+        printf ("|%s|. (probably many more entries like this here)\n", indent);
+    }
+
+    return subtable;
+}
@@ -35,11 +35,11 @@
 #include <Anvie/CrossFile/Otf/Tables/Loca.h>
 #include <Anvie/CrossFile/Otf/Tables/Maxp.h>
 
-XfOtfLoca *
-    xf_otf_loca_init (XfOtfLoca *loca, XfOtfHead *head, XfOtfMaxp *maxp, Uint8 *data, Size size) {
+OtfLoca *
+    otf_loca_init (OtfLoca *loca, OtfHead *head, OtfMaxp *maxp, Uint8 *data, Size size) {
     RETURN_VALUE_IF (!loca || !head || !maxp || !data, Null, ERR_INVALID_ARGUMENTS);
     RETURN_VALUE_IF (
-        size < XF_OTF_LOCA_DATA_SIZE,
+        size < OTF_LOCA_DATA_SIZE,
         Null,
         "Data buffer size not sufficient to initialize index to location table \"loca\".\n"
     );
@@ -47,7 +47,7 @@ XfOtfLoca *
     return loca;
 }
 
-XfOtfLoca *xf_otf_loca_pprint (XfOtfLoca *loca) {
+OtfLoca *otf_loca_pprint (OtfLoca *loca) {
     RETURN_VALUE_IF (!loca, Null, ERR_INVALID_ARGUMENTS);
 
     return loca;
@@ -42,14 +42,14 @@
 #define MAXP_VERSION_10 0x00010000
 #define MAXP_VERSION_05 0x00005000
 
-XfOtfMaxp* xf_otf_maxp_init (XfOtfMaxp* max_prof, Uint8* data, Size size) {
+OtfMaxp* otf_maxp_init (OtfMaxp* max_prof, Uint8* data, Size size) {
     RETURN_VALUE_IF (!max_prof || !data, Null, ERR_INVALID_ARGUMENTS);
 
     Uint32 version = GET_AND_ADV_U4 (data);
 
     if (version == MAXP_VERSION_10) {
         RETURN_VALUE_IF (
-            size < XF_OTF_MAXP_VERSION_10_DATA_SIZE,
+            size < OTF_MAXP_VERSION_10_DATA_SIZE,
             Null,
             "Data buffer size not sufficient to initialize max profile table \"maxp\".\n"
         );
@@ -71,7 +71,7 @@ XfOtfMaxp* xf_otf_maxp_init (XfOtfMaxp* max_prof, Uint8* data, Size size) {
         max_prof->max_component_depth      = GET_AND_ADV_U2 (data);
     } else if (version == MAXP_VERSION_05) {
         RETURN_VALUE_IF (
-            size < XF_OTF_MAXP_VERSION_05_DATA_SIZE,
+            size < OTF_MAXP_VERSION_05_DATA_SIZE,
             Null,
             "Data buffer size not sufficient to initialize max profile table \"maxp\".\n"
         );
@@ -86,7 +86,7 @@ XfOtfMaxp* xf_otf_maxp_init (XfOtfMaxp* max_prof, Uint8* data, Size size) {
     return max_prof;
 }
 
-XfOtfMaxp* xf_otf_maxp_pprint (XfOtfMaxp* max_prof, Uint8 indent_level) {
+OtfMaxp* otf_maxp_pprint (OtfMaxp* max_prof, Uint8 indent_level) {
     RETURN_VALUE_IF (!max_prof, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -42,27 +42,26 @@
 #include "Anvie/CrossFile/Otf/Tables/Common.h"
 
 #define NAME_RECORD_DATA_SIZE                                                                      \
-    (XF_OTF_PLATFORM_ENCODING_DATA_SIZE + XF_OTF_LANGUAGE_DATA_SIZE + sizeof (XfOtfNameId) +       \
-     sizeof (Uint16) * 2)
+    (OTF_PLATFORM_ENCODING_DATA_SIZE + OTF_LANGUAGE_DATA_SIZE + sizeof (Uint16) * 3)
 #define LANG_TAG_RECORD_DATA_SIZE (sizeof (Uint16) * 2)
 #define NAME_DATA_SIZE            (sizeof (Uint16) * 3)
 
-static inline CString name_id_to_str (XfOtfNameId name_id);
+static inline CString name_id_to_str (OtfNameId name_id);
 
-static inline XfOtfNameRecord *name_record_init (XfOtfNameRecord *record, Uint8 *data, Size size);
-static inline XfOtfNameRecord *name_record_pprint (XfOtfNameRecord *record, Uint8 indent_level);
+static inline OtfNameRecord *name_record_init (OtfNameRecord *record, Uint8 *data, Size size);
+static inline OtfNameRecord *name_record_pprint (OtfNameRecord *record, Uint8 indent_level);
 
-static inline XfOtfLangTagRecord *
-    lang_tag_record_init (XfOtfLangTagRecord *tag, Uint8 *data, Size size);
-static inline XfOtfLangTagRecord *
-    lang_tag_record_pprint (XfOtfLangTagRecord *tag, Uint8 indent_level);
+static inline OtfLangTagRecord *
+    lang_tag_record_init (OtfLangTagRecord *tag, Uint8 *data, Size size);
+static inline OtfLangTagRecord *
+    lang_tag_record_pprint (OtfLangTagRecord *tag, Uint8 indent_level);
 
 /**************************************************************************************************/
 /*********************************** PUBLIC METHOD DEFINITIONS ************************************/
 /**************************************************************************************************/
 
 /**
- * @b Initialize given @c XfOtfName object.
+ * @b Initialize given @c OtfName object.
  *
  * @param name
  * @param data
@@ -71,7 +70,7 @@ static inline XfOtfLangTagRecord *
  * @return @c name on success.
  * @return @c Null otherwise.
  * */
-XfOtfName *xf_otf_name_init (XfOtfName *name, Uint8 *data, Size size) {
+OtfName *otf_name_init (OtfName *name, Uint8 *data, Size size) {
     RETURN_VALUE_IF (!name || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -98,7 +97,7 @@ XfOtfName *xf_otf_name_init (XfOtfName *name, Uint8 *data, Size size) {
         );
 
         RETURN_VALUE_IF (
-            !(name->name_records = ALLOCATE (XfOtfNameRecord, name->num_name_records)),
+            !(name->name_records = ALLOCATE (OtfNameRecord, name->num_name_records)),
             Null,
             ERR_OUT_OF_MEMORY
         );
@@ -131,7 +130,7 @@ XfOtfName *xf_otf_name_init (XfOtfName *name, Uint8 *data, Size size) {
             );
 
             GOTO_HANDLER_IF (
-                !(name->lang_tags = ALLOCATE (XfOtfLangTagRecord, name->num_lang_tags)),
+                !(name->lang_tags = ALLOCATE (OtfLangTagRecord, name->num_lang_tags)),
                 INIT_FAILED,
                 ERR_OUT_OF_MEMORY
             );
@@ -169,19 +168,19 @@ XfOtfName *xf_otf_name_init (XfOtfName *name, Uint8 *data, Size size) {
     return name;
 
 INIT_FAILED:
-    xf_otf_name_deinit (name);
+    otf_name_deinit (name);
     return Null;
 }
 
 /**
- * @b De-initialize given @c XfOtfName object.
+ * @b De-initialize given @c OtfName object.
  *
  * @param name
  *
  * @return @c name on success.
  * @return @c Null otherwise.
  * */
-XfOtfName *xf_otf_name_deinit (XfOtfName *name) {
+OtfName *otf_name_deinit (OtfName *name) {
     RETURN_VALUE_IF (!name, Null, ERR_INVALID_ARGUMENTS);
 
     if (name->string_data) {
@@ -196,11 +195,11 @@ XfOtfName *xf_otf_name_deinit (XfOtfName *name) {
         FREE (name->name_records);
     }
 
-    memset (name, 0, sizeof (XfOtfName));
+    memset (name, 0, sizeof (OtfName));
     return name;
 }
 
-XfOtfName *xf_otf_name_pprint (XfOtfName *name, Uint8 indent_level) {
+OtfName *otf_name_pprint (OtfName *name, Uint8 indent_level) {
     RETURN_VALUE_IF (!name, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -272,7 +271,7 @@ XfOtfName *xf_otf_name_pprint (XfOtfName *name, Uint8 indent_level) {
 /*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
 /**************************************************************************************************/
 
-static inline XfOtfNameRecord *name_record_init (XfOtfNameRecord *record, Uint8 *data, Size size) {
+static inline OtfNameRecord *name_record_init (OtfNameRecord *record, Uint8 *data, Size size) {
     RETURN_VALUE_IF (!record || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -294,7 +293,7 @@ static inline XfOtfNameRecord *name_record_init (XfOtfNameRecord *record, Uint8
     return record;
 }
 
-static inline XfOtfNameRecord *name_record_pprint (XfOtfNameRecord *record, Uint8 indent_level) {
+static inline OtfNameRecord *name_record_pprint (OtfNameRecord *record, Uint8 indent_level) {
     RETURN_VALUE_IF (!record, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -313,13 +312,13 @@ static inline XfOtfNameRecord *name_record_pprint (XfOtfNameRecord *record, Uint
         indent,
         indent,
         record->platform_encoding.platform,
-        xf_otf_platform_encoding_get_platform_str (record->platform_encoding),
+        otf_platform_encoding_get_platform_str (record->platform_encoding),
         indent,
         record->platform_encoding.encoding.custom,
-        xf_otf_platform_encoding_get_encoding_str (record->platform_encoding),
+        otf_platform_encoding_get_encoding_str (record->platform_encoding),
         indent,
         record->language.language.custom,
-        xf_otf_language_to_str (record->language),
+        otf_language_to_str (record->language),
         indent,
         record->name_id,
         name_id_to_str (record->name_id),
@@ -332,8 +331,8 @@ static inline XfOtfNameRecord *name_record_pprint (XfOtfNameRecord *record, Uint
     return record;
 }
 
-static inline XfOtfLangTagRecord *
-    lang_tag_record_init (XfOtfLangTagRecord *tag, Uint8 *data, Size size) {
+static inline OtfLangTagRecord *
+    lang_tag_record_init (OtfLangTagRecord *tag, Uint8 *data, Size size) {
     RETURN_VALUE_IF (!tag || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -348,8 +347,8 @@ static inline XfOtfLangTagRecord *
     return tag;
 }
 
-static inline XfOtfLangTagRecord *
-    lang_tag_record_pprint (XfOtfLangTagRecord *tag, Uint8 indent_level) {
+static inline OtfLangTagRecord *
+    lang_tag_record_pprint (OtfLangTagRecord *tag, Uint8 indent_level) {
     RETURN_VALUE_IF (!tag, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
@@ -371,7 +370,7 @@ static inline XfOtfLangTagRecord *
     return tag;
 }
 
-static inline CString name_id_to_str (XfOtfNameId id) {
+static inline CString name_id_to_str (OtfNameId id) {
     // Array of name ids corresponding to the enum values
     static const char *names[] = {
         "COPYRIGHT NOTICE",                 // 0
@@ -403,7 +402,7 @@ static inline CString name_id_to_str (XfOtfNameId id) {
     };
 
     // Check if the value is within the reserved range
-    if (id >= XF_OTF_NAME_ID_RESERVED_MIN) {
+    if (id >= OTF_NAME_ID_RESERVED_MIN) {
         return "RESERVED";
     }
 
@@ -52,7 +52,7 @@
 #define OS2_V5_DATA_SIZE (OS2_V4_DATA_SIZE + sizeof (Uint16) * 2)
 
 /**
- * @b Initialize @c XfOtfOs2 table with given data.
+ * @b Initialize @c OtfOs2 table with given data.
  *
  * @param os2
  * @param data Data buffer containing raw data.
@@ -61,7 +61,7 @@
  * @return @c os2 on success.
  * @return @c Null otherwise.
  * */
-XfOtfOs2 *xf_otf_os2_init (XfOtfOs2 *os2, Uint8 *data, Size size) {
+OtfOs2 *otf_os2_init (OtfOs2 *os2, Uint8 *data, Size size) {
     RETURN_VALUE_IF (!os2 || !data, Null, ERR_INVALID_ARGUMENTS);
 
     RETURN_VALUE_IF (
@@ -159,7 +159,7 @@ XfOtfOs2 *xf_otf_os2_init (XfOtfOs2 *os2, Uint8 *data, Size size) {
 }
 
 /**
- * @b Pretty Print the contents of @c XfOtfOs2 table.
+ * @b Pretty Print the contents of @c OtfOs2 table.
  *
  * @param os2
  * @param indent_level Additive indent level offset for pprinting all the fields.
@@ -167,7 +167,7 @@ XfOtfOs2 *xf_otf_os2_init (XfOtfOs2 *os2, Uint8 *data, Size size) {
  * @return @c os2 on success.
  * @return @c Null otherwise.
  * */
-XfOtfOs2 *xf_otf_os2_pprint (XfOtfOs2 *os2, Uint8 indent_level) {
+OtfOs2 *otf_os2_pprint (OtfOs2 *os2, Uint8 indent_level) {
     RETURN_VALUE_IF (!os2, Null, ERR_INVALID_ARGUMENTS);
 
     Char indent[indent_level + 1];
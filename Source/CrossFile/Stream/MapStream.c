@@ -0,0 +1,133 @@
+/**
+ * @file MapStream.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Stream.h>
+
+/* libc */
+#include <errno.h>
+#include <fcntl.h>
+#include <memory.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* local includes */
+#include "Stream.h"
+
+typedef struct MapIoStream {
+    INHERITS_IO_STREAM();
+} MapIoStream;
+
+#define MAP_STREAM(ptr) ((MapIoStream*)(ptr))
+
+/**
+ * @b Mapped file stream close implementation.
+ *
+ * @param mio.
+ * */
+PRIVATE void mio_close (MapIoStream* mio) {
+    RETURN_IF (!mio, ERR_INVALID_ARGUMENTS);
+
+    if (mio->stream.data) {
+        munmap (mio->stream.data, mio->stream.size);
+    }
+
+    memset (mio, 0, sizeof (MapIoStream));
+    FREE (mio);
+}
+
+/**
+ * @b Open a read only stream over a memory mapping of given file.
+ *
+ * File contents are not copied, pages are brought in by the kernel as they're
+ * read. Stream data stays valid and at the same address until stream is closed,
+ * so readers are free to keep pointers into it.
+ *
+ * @param filename Name of file to be mapped.
+ *
+ * @return Reference to opened @c IoStream on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC IoStream* io_stream_open_mapped_file (CString filename) {
+    RETURN_VALUE_IF (!filename, Null, ERR_INVALID_ARGUMENTS);
+
+    MapIoStream* mio = NEW (MapIoStream);
+    RETURN_VALUE_IF (!mio, Null, ERR_OUT_OF_MEMORY);
+
+    /* mapping is never resized or freed by generic stream code */
+    IoStream* io   = IO_STREAM (mio);
+    io->is_mutable = False;
+    io->is_mapped  = True;
+    io->close      = (IoStreamCloseClbk)mio_close;
+
+    int fd = open (filename, O_RDONLY);
+    GOTO_HANDLER_IF (
+        fd < 0,
+        MIO_OPEN_FAILED,
+        "Failed to open file stream : %s\n",
+        strerror (errno)
+    );
+
+    struct stat st;
+    Bool        has_size = !fstat (fd, &st) && st.st_size > 0;
+    void*       data     = MAP_FAILED;
+    int         map_err  = 0;
+    if (has_size) {
+        data    = mmap (Null, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        map_err = errno;
+    }
+
+    /* close() may overwrite errno, so the mmap error is saved above */
+    close (fd);
+
+    GOTO_HANDLER_IF (!has_size, MIO_OPEN_FAILED, "File size is zero on disk. Cannot map file\n");
+    GOTO_HANDLER_IF (
+        data == MAP_FAILED,
+        MIO_OPEN_FAILED,
+        "Failed to map file : %s\n",
+        strerror (map_err)
+    );
+
+    io->data     = data;
+    io->size     = st.st_size;
+    io->capacity = st.st_size;
+
+    return io;
+
+MIO_OPEN_FAILED:
+    mio_close (mio);
+    return Null;
+}
@@ -74,7 +74,7 @@ PUBLIC void io_stream_close (IoStream* stream) {
         "application\n"
     );
 
-    if (stream->data) {
+    if (stream->data && !stream->is_mapped) {
         memset (stream->data, 0, stream->size);
         FREE (stream->data);
     }
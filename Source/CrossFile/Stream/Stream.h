@@ -49,6 +49,7 @@ struct IoStream {
     Size   cursor;   /**< @b Points to the next byte to start reading/writing from. */
 
     Bool is_mutable; /**< @b Decides whether or not a stream is resizable. */
+    Bool is_mapped;  /**< @b Data is a file mapping, released by close method instead of freed. */
 
     /* all callbacks are optional (except close, it's recommended to provide that one) */
 
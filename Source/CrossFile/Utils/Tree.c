@@ -8,32 +8,67 @@
 
 #include <Anvie/CrossFile/Utils/Tree.h>
 
+/* libc */
+#include <pthread.h>
+
 /**
- * Static, lazily allocated vector to emulate stack.
+ * Thread local, lazily allocated vector to emulate stack.
  * This vector will contain flattened out tree. None of the items inside
  * it are owned by the vector.
+ *
+ * Each thread gets it's own vector, so traversals in different threads
+ * never overwrite each other's results.
+ * */
+static _Thread_local GenericBinTreeVec* traversal_vec = Null;
+
+/**
+ * Key used only to get a destructor callback when a thread that allocated
+ * a traversal vector exits.
+ * */
+static pthread_key_t  traversal_vec_key;
+static pthread_once_t traversal_vec_key_once = PTHREAD_ONCE_INIT;
+
+/**
+ * This method ensures that traversal_vec of a thread is destroyed when the thread exits.
  * */
-static GenericBinTreeVec* traversal_vec = Null;
+PRIVATE void traversal_vec_thread_exit_handler (void* vec) {
+    if (vec) {
+        anv_generic_bin_tree_vec_destroy ((GenericBinTreeVec*)vec);
+    }
+}
 
 /**
- * This method enusres that traversal_vec is destroyed before program exits.
+ * Key destructors are not called for the thread calling exit(), so the
+ * vector of that thread is destroyed here.
  * */
 PRIVATE void traversal_vec_atexit_handler() {
     if (traversal_vec) {
+        pthread_setspecific (traversal_vec_key, Null);
         anv_generic_bin_tree_vec_destroy (traversal_vec);
         traversal_vec = Null;
     }
 }
 
+PRIVATE void traversal_vec_key_create() {
+    pthread_key_create (&traversal_vec_key, traversal_vec_thread_exit_handler);
+    atexit (traversal_vec_atexit_handler);
+}
+
 PRIVATE GenericBinTreeVec* traversal_vec_get() {
     if (!traversal_vec) {
+        RETURN_VALUE_IF (
+            pthread_once (&traversal_vec_key_once, traversal_vec_key_create) != 0,
+            Null,
+            "Failed to create generic bin tree traversal vector key.\n"
+        );
+
         RETURN_VALUE_IF (
             !(traversal_vec = anv_generic_bin_tree_vec_create()),
             Null,
             "Failed to create generic bin tree vector.\n"
         );
 
-        atexit (traversal_vec_atexit_handler);
+        pthread_setspecific (traversal_vec_key, traversal_vec);
     }
 
     return traversal_vec;
@@ -51,7 +86,7 @@ PRIVATE GenericBinTreeVec* traversal_vec_reset() {
     );
 
     /* capacity remains same, just size is reset. */
-    memset (traversal_vec->items, 0, sizeof (GenericBinTree) * traversal_vec->size);
+    memset (traversal_vec->data, 0, sizeof (GenericBinTree) * traversal_vec->size);
     traversal_vec->size = 0;
 
     return traversal_vec;
@@ -73,7 +108,7 @@ PRIVATE GenericBinTreeVec* inorder (GenericBinTree* root, GenericBinTreeVec* vec
 
     if (root->left) {
         RETURN_VALUE_IF (
-            !anv_generic_bin_tree_init_inorder_traversal (root->left),
+            !inorder (root->left, vec),
             Null,
             "Failed to visit left subtree"
         );
@@ -87,7 +122,7 @@ PRIVATE GenericBinTreeVec* inorder (GenericBinTree* root, GenericBinTreeVec* vec
 
     if (root->right) {
         RETURN_VALUE_IF (
-            !anv_generic_bin_tree_init_inorder_traversal (root->right),
+            !inorder (root->right, vec),
             Null,
             "Failed to visit right subtree"
         );
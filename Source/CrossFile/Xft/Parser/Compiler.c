@@ -0,0 +1,3458 @@
+/**
+ * @file Compiler.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <memory.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/* crossfile */
+#include "../Vm/Insn.h"
+#include "../Vm/InsnBuilders.h"
+#include "../Vm/Jit.h"
+#include "../Vm/Packed.h"
+#include "../Vm/Peephole.h"
+#include "../Vm/Vm.h"
+
+/* local includes */
+#include "Compiler.h"
+#include "Parser.h"
+
+/* registers with fixed roles in compiled loaders, r1 to r6 are temporaries */
+#define COMPILER_REG_OFF        0    /* offset of object a called loader loads into */
+#define COMPILER_REG_BASE       7    /* stream offset of beginning of object being loaded */
+#define COMPILER_TEMP_REGS      0x7e /* bit mask of temporary registers */
+#define COMPILER_MAX_ALIAS_USE  32   /* maximum depth of aliases referring to aliases */
+#define COMPILER_MAX_SPECIALIZE 8    /* maximum number of cases of a specialized struct */
+
+typedef struct SchemaType SchemaType;
+
+typedef enum SchemaTypeKind {
+    SCHEMA_TYPE_KIND_BASIC = 0,
+    SCHEMA_TYPE_KIND_ENUM,
+    SCHEMA_TYPE_KIND_STRUCT,
+    SCHEMA_TYPE_KIND_TYPEDEF,
+} SchemaTypeKind;
+
+typedef enum SchemaLayoutState {
+    SCHEMA_LAYOUT_PENDING = 0,
+    SCHEMA_LAYOUT_RUNNING, /**< @b Being laid out, reached again only if type contains itself. */
+    SCHEMA_LAYOUT_DONE,
+} SchemaLayoutState;
+
+/**
+ * @b A field of a struct, with it's type resolved and memory laid out.
+ * */
+typedef struct SchemaField {
+    Field*           field;
+    SchemaType*      type;
+    Size             mem_off;
+    Size             mem_size;
+    Size             count;    /**< @b Number of elements of an array, 1 otherwise. */
+    ExprOpnd*        vec_size; /**< @b Number of elements of a vector, @c Null if not a vector. */
+    ExprOpnd*        type_arg; /**< @b Value selecting type of a typedef field. */
+    FieldAnnotation* addr;     /**< @b Where field is read from, @c Null if read in place. */
+    Bool             lazy;     /**< @b A @c SchemaLazy is stored instead of reading field. */
+} SchemaField;
+
+/**
+ * @b Type a typedef selects for values in range [first, last].
+ * */
+typedef struct SchemaCase {
+    Uint64      first;
+    Uint64      last;
+    SchemaType* type;
+} SchemaCase;
+
+/**
+ * @b A type known to compiler.
+ * */
+struct SchemaType {
+    SchemaTypeKind    kind;
+    CString           name;
+    TypeDecl*         decl;         /**< @b Declaration, @c Null for basic types. */
+    FieldType         basic;        /**< @b Basic type, or type enum members are stored as. */
+    Size              size;         /**< @b Memory taken by one object of this type. */
+    Size              align;        /**< @b Alignment of objects of this type in memory. */
+    Loader*           loader;       /**< @b Loader of struct, or of vector elements of basic. */
+    SchemaField*      fields;
+    Size              field_count;
+    SchemaCase*       cases;
+    Size              case_count;
+    SchemaType*       param;        /**< @b Enum case names of a typedef are looked up in first. */
+    SchemaLayoutState layout_state;
+    Bool              uses_base;    /**< @b Some field is addressed relative to struct. */
+    Bool              is_pod;       /**< @b Fixed size struct read as one block copy. */
+    Bool              is_plain;     /**< @b POD-fixed and asserts nothing, copied in place. */
+    StructLayout      pod_layout;   /**< @b Every basic value of a POD struct, in stream order. */
+    CString*          uses;         /**< @b Names looked up by type, recorded when recompiling. */
+    Size              use_count;
+    Size              use_capacity;
+    Bool              dirty;        /**< @b Must be compiled again when recompiling. */
+};
+
+/**
+ * @b Open addressing hash table from names to objects. Names are not owned.
+ * */
+typedef struct SchemaMap {
+    CString* keys;
+    void**   values;
+    Size     count;
+    Size     capacity;
+} SchemaMap;
+
+/**
+ * @b Where names in an expression are looked up.
+ * */
+typedef struct SchemaScope {
+    SchemaType* type;
+    Size        field_count; /**< @b Only fields loaded before expression are visible. */
+    Size        base_off;    /**< @b Memory offset of object of @c type in loader's memory. */
+    Size        alias_depth;
+} SchemaScope;
+
+/**
+ * @b A field path to load value of, or to compare against an array.
+ * */
+typedef struct SchemaPath {
+    SchemaScope scope; /**< @b Scope first component of path is looked up in. */
+    CString     path;  /**< @b Remaining components, separated by '.' */
+    Uint8       reg;   /**< @b Register value or result of comparison is stored in. */
+    ExprArr*    cmp;   /**< @b If not @c Null, array field is compared with this. */
+} SchemaPath;
+
+/**
+ * @b A field being loaded.
+ * */
+typedef struct SchemaLoad {
+    SchemaField* field;
+    Size         mem_off;
+    Uint8        count_reg; /**< @b Number of vector elements. */
+} SchemaLoad;
+
+/**
+ * @b Location of a jump instruction whose target is filled in later.
+ * */
+typedef struct SchemaPatch {
+    Size block;
+    Size insn;
+} SchemaPatch;
+
+/**
+ * @b Range of values a type argument is known to be in, while emitting code of one
+ * case of a specialized struct.
+ * */
+typedef struct SchemaKnown {
+    SchemaType* type;     /**< @b Struct argument is evaluated in, @c Null if nothing is known. */
+    Size        base_off; /**< @b Memory offset of object of @c type in loader's memory. */
+    CString     arg;      /**< @b Field path of type argument. */
+    Uint64      first;
+    Uint64      last;
+} SchemaKnown;
+
+/**
+ * @b Fields of a struct left to be emitted in each case of a specialized struct.
+ * */
+typedef struct SchemaFields {
+    SchemaScope* scope;
+    Size         first;
+} SchemaFields;
+
+typedef struct SchemaCompiler {
+    Schema*     schema;
+    Schema*     prev;      /**< @b Schema being recompiled, @c Null when compiling from scratch. */
+    SchemaType* types;
+    Size        type_count;
+    SchemaType  basics[FIELD_TYPE_MAX];
+    SchemaMap   type_map;
+    SchemaMap   enum_map;  /**< @b Names of all enum members to their @c EnumMember. */
+
+    Loader* loader;        /**< @b Loader code is being emitted to. */
+    Size    block;         /**< @b Block code is being emitted to. */
+    Uint8   free_regs;     /**< @b Bit mask of unused temporary registers. */
+
+    SchemaKnown known;     /**< @b Type argument with a known value in code being emitted. */
+} SchemaCompiler;
+
+/* called for each type a typedef can select, with code emitted in a block of it's own */
+typedef Bool (*SchemaCaseFn) (SchemaCompiler* c, SchemaType* type, void* data);
+
+/* private method declarations */
+PRIVATE Bool         compiler_prepare (SchemaCompiler* c);
+PRIVATE Bool         compiler_register (SchemaCompiler* c);
+PRIVATE Bool         compiler_use (SchemaCompiler* c, SchemaType* type, CString name);
+PRIVATE Bool         compiler_mark_dirty (SchemaCompiler* c);
+PRIVATE Bool         compiler_dirty_name (SchemaMap* dirty, CString name);
+PRIVATE Bool         compiler_dirty_decl (SchemaMap* dirty, TypeDecl* decl);
+PRIVATE Bool         compiler_same_order (SchemaCompiler* c);
+PRIVATE Bool         compiler_reuse (SchemaCompiler* c);
+PRIVATE Bool         compiler_drop_loader (Schema* schema, Loader* loader);
+PRIVATE void         compiler_move_msgs (Schema* to, Schema* from, Loader* loader);
+PRIVATE void         compiler_move_msg (Schema* to, Schema* from, CString msg);
+PRIVATE Bool         compiler_resolve_typedef (SchemaCompiler* c, SchemaType* type);
+PRIVATE Bool         compiler_fold_struct (SchemaCompiler* c, SchemaType* type);
+PRIVATE Bool         compiler_fold (SchemaCompiler* c, SchemaScope* scope, ExprOpnd* e);
+PRIVATE Bool         compiler_fold_id (SchemaCompiler* c, SchemaScope* scope, ExprOpnd* e);
+PRIVATE Bool         compiler_fold_value (ExprOpnd* e, Uint64 value);
+PRIVATE Bool         compiler_is_const (ExprOpnd* e);
+PRIVATE Bool         compiler_layout (SchemaCompiler* c, SchemaType* type);
+PRIVATE Bool         compiler_layout_struct (SchemaCompiler* c, SchemaType* type);
+PRIVATE Bool         compiler_pod_layout (SchemaType* type);
+PRIVATE void         compiler_pod_add (StructLayout* layout, StructLayoutField* value);
+PRIVATE Size         compiler_align (Size off, Size align);
+PRIVATE Bool         compiler_emit_struct (SchemaCompiler* c, SchemaType* type);
+PRIVATE Bool         compiler_check_terms (SchemaScope* scope, ExprOpnd* e, CheckTable* table);
+PRIVATE SchemaField* compiler_check_field (SchemaScope* scope, CString path, Size* off);
+PRIVATE Bool         compiler_emit_fields (SchemaCompiler* c, SchemaScope* scope, Size first);
+PRIVATE Bool         compiler_fields_case (SchemaCompiler* c, SchemaType* type, void* data);
+PRIVATE Bool         compiler_can_specialize (SchemaScope* scope, Size f);
+PRIVATE Bool         compiler_emit_field (SchemaCompiler* c, SchemaScope* scope, SchemaField* sf);
+PRIVATE Bool         compiler_load (SchemaCompiler* c, SchemaType* type, void* data);
+PRIVATE Bool         compiler_emit_lazy (SchemaCompiler* c, SchemaScope* scope, SchemaField* sf);
+PRIVATE Bool         compiler_lazy_case (SchemaCompiler* c, SchemaType* type, void* data);
+PRIVATE Bool         compiler_store (SchemaCompiler* c, Uint8 reg, Size mem_off);
+PRIVATE Bool         compiler_dispatch (
+    SchemaCompiler* c,
+    SchemaScope*    scope,
+    SchemaField*    sf,
+    SchemaCaseFn    case_fn,
+    void*           data
+);
+PRIVATE Bool         compiler_switch (
+    SchemaCompiler* c,
+    SchemaScope*    scope,
+    SchemaField*    sf,
+    SchemaCaseFn    case_fn,
+    void*           data,
+    Bool            specialize
+);
+PRIVATE SchemaCase*  compiler_known_case (SchemaCompiler* c, SchemaScope* scope, SchemaField* sf);
+PRIVATE Bool         compiler_add_switch (
+    SchemaCompiler* c,
+    SchemaPatch*    patch,
+    SchemaCase*     cases,
+    Size*           blocks,
+    Size            count
+);
+PRIVATE Bool         compiler_eval (SchemaCompiler* c, SchemaScope* scope, ExprOpnd* e, Uint8* reg);
+PRIVATE Bool
+    compiler_eval_id (SchemaCompiler* c, SchemaScope* scope, CString id, Uint8* reg);
+PRIVATE Bool         compiler_eval_arith (
+    SchemaCompiler* c,
+    SchemaScope*    scope,
+    ArithExpr*      e,
+    Uint8*          reg
+);
+PRIVATE Bool         compiler_eval_cond (
+    SchemaCompiler* c,
+    SchemaScope*    scope,
+    CondExpr*       e,
+    Uint8*          reg
+);
+PRIVATE Bool         compiler_path (SchemaCompiler* c, SchemaPath* path);
+PRIVATE Bool         compiler_path_case (SchemaCompiler* c, SchemaType* type, void* data);
+PRIVATE SchemaField*
+    compiler_find_field (SchemaType* type, Size field_count, CString name, Size len);
+PRIVATE Bool         compiler_bool (SchemaCompiler* c, Uint8 reg, Bool negate);
+PRIVATE Bool         compiler_alloc_reg (SchemaCompiler* c, Uint8* reg);
+PRIVATE void         compiler_free_reg (SchemaCompiler* c, Uint8 reg);
+PRIVATE Bool         compiler_emit (SchemaCompiler* c, Insn insn);
+PRIVATE Bool         compiler_emit_sized (SchemaCompiler* c, Insn insn, Size size);
+PRIVATE Bool         compiler_emit_jump (SchemaCompiler* c, Insn insn, SchemaPatch* patch);
+PRIVATE Bool         compiler_emit_goto (SchemaCompiler* c, SchemaPatch* patch);
+PRIVATE void         compiler_patch (SchemaCompiler* c, SchemaPatch* patch, Size target);
+PRIVATE Bool         compiler_new_block (SchemaCompiler* c);
+PRIVATE Bool         compiler_ref (SchemaCompiler* c, Loader* callee, Size* sel);
+PRIVATE Bool         compiler_add_layout (SchemaCompiler* c, SchemaType* type, Size* id);
+PRIVATE Bool         compiler_add_loader (SchemaCompiler* c, Loader* loader);
+PRIVATE Loader*      compiler_new_loader (SchemaCompiler* c, CString name, CString doc);
+PRIVATE Loader*      compiler_basic_loader (SchemaCompiler* c, SchemaType* type);
+PRIVATE CString      compiler_msg (SchemaCompiler* c, CString fmt, ...);
+PRIVATE Bool         compiler_reserve_msgs (Schema* schema, Size count);
+PRIVATE void         compiler_deinit (SchemaCompiler* c);
+PRIVATE Size         compiler_basic_size (FieldType type);
+PRIVATE Size         compiler_stream_size (SchemaType* type);
+PRIVATE void*        compiler_map_find (SchemaMap* map, CString key, Size len);
+PRIVATE Bool         compiler_map_insert (SchemaMap* map, CString key, void* value);
+PRIVATE void         compiler_map_deinit (SchemaMap* map);
+PRIVATE void         loader_destroy (Loader* loader);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Compile given declarations to type loaders.
+ *
+ * All names are resolved, constant expressions are folded and all types are laid out
+ * before code for any of them is generated. A struct can contain itself only through
+ * a vector.
+ *
+ * @param schema Schema to be initialized.
+ * @param decls Declarations to be compiled (Transferred Ownership), owned by schema
+ *        on success and destroyed otherwise.
+ * @param flags
+ *
+ * @return @c schema on success.
+ * @return @c Null otherwise.
+ * */
+Schema* schema_compile (Schema* schema, TO_TypeDeclList* decls, SchemaFlags flags) {
+    RETURN_VALUE_IF (!schema || !decls, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (schema, 0, sizeof (Schema));
+    schema->decls = decls;
+    schema->flags = flags;
+
+    SchemaCompiler c  = {.schema = schema};
+    Bool           ok = compiler_prepare (&c);
+
+    for (Size t = 0; ok && t < c.type_count; t++) {
+        if (c.types[t].kind == SCHEMA_TYPE_KIND_STRUCT) {
+            ok = compiler_emit_struct (&c, c.types + t);
+        }
+    }
+
+    compiler_deinit (&c);
+
+    if (!ok) {
+        schema_deinit (schema);
+        return Null;
+    }
+
+    return schema;
+}
+
+/**
+ * @b Parse and compile given xfile type description.
+ *
+ * @param schema Schema to be initialized.
+ * @param source Type description.
+ * @param source_size Size of source in bytes.
+ * @param flags
+ *
+ * @return @c schema on success.
+ * @return @c Null otherwise.
+ * */
+Schema* schema_compile_source (
+    Schema*     schema,
+    CString     source,
+    Size        source_size,
+    SchemaFlags flags
+) {
+    RETURN_VALUE_IF (!schema || !source, Null, ERR_INVALID_ARGUMENTS);
+
+    XfileParser xparser = {0};
+    RETURN_VALUE_IF (!xfile_parser_init (&xparser), Null, "Failed to initialize xfile parser\n");
+
+    TypeDeclList* decls = xfile_parser_parse (&xparser, source, source_size);
+    xfile_parser_deinit (&xparser);
+    RETURN_VALUE_IF (!decls, Null, "Failed to parse type description\n");
+
+    RETURN_VALUE_IF (
+        !schema_compile (schema, decls, flags),
+        Null,
+        "Failed to compile type description\n"
+    );
+
+    return schema;
+}
+
+/**
+ * @b Compile declarations of an edited type description again, reusing loaders of
+ * declarations that didn't change.
+ *
+ * A struct is compiled again only if it's declaration is marked changed, or if it
+ * refers to a name that was declared, removed or changed since schema was compiled,
+ * directly or through other declarations. Loaders of all other structs and basic
+ * types, and messages they print, move to recompiled schema as they are, so pointers
+ * to them stay valid.
+ *
+ * When compilation fails, schema is left as it was. Changed declarations are then
+ * remembered, and compiled by next recompilation even if they don't change again.
+ *
+ * @param schema Schema compiled from description before it was edited.
+ * @param decls Declarations of edited description (Transferred Ownership), owned by
+ *        schema afterwards.
+ *
+ * @return @c schema on success.
+ * @return @c Null otherwise.
+ * */
+Schema* schema_recompile (Schema* schema, TO_TypeDeclList* decls) {
+    RETURN_VALUE_IF (!schema || !decls, Null, ERR_INVALID_ARGUMENTS);
+
+    if (!schema->decls) {
+        return schema_compile (schema, decls, schema->flags);
+    }
+
+    /* a declaration changed before a failed recompilation isn't compiled yet */
+    if (schema->failed_decls) {
+        for (TypeDeclListItem* item = decls->head; item; item = item->next) {
+            TypeDeclListItem* failed = schema->failed_decls->head;
+            for (; failed && item->data.name && !item->data.changed; failed = failed->next) {
+                item->data.changed = failed->data.changed && failed->data.name &&
+                                     !strcmp (failed->data.name, item->data.name);
+            }
+        }
+
+        anv_type_decl_list_destroy (schema->failed_decls);
+        schema->failed_decls = Null;
+    }
+
+    Schema         next = {.decls = decls, .flags = schema->flags};
+    SchemaCompiler c    = {.schema = &next, .prev = schema};
+    Bool           ok   = compiler_prepare (&c) && compiler_mark_dirty (&c) && compiler_reuse (&c);
+
+    for (Size t = 0; ok && t < c.type_count; t++) {
+        if (c.types[t].kind == SCHEMA_TYPE_KIND_STRUCT && c.types[t].dirty) {
+            ok = compiler_emit_struct (&c, c.types + t);
+        }
+    }
+
+    /* loaders reused are shared by both schemas till here */
+    ok = ok && compiler_reserve_msgs (&next, next.msg_count + schema->msg_count);
+    if (!ok) {
+        for (Size l = 0; l < schema->loader_count; l++) {
+            compiler_drop_loader (&next, schema->loaders[l]);
+        }
+
+        compiler_deinit (&c);
+        next.decls           = Null;
+        schema->failed_decls = decls;
+        schema_deinit (&next);
+
+        PRINT_ERR ("Failed to recompile type description\n");
+        return Null;
+    }
+
+    for (Size l = 0; l < next.loader_count; l++) {
+        if (compiler_drop_loader (schema, next.loaders[l])) {
+            compiler_move_msgs (&next, schema, next.loaders[l]);
+        }
+    }
+
+    /* names of reused loaders still point to old declarations */
+    for (Size t = 0; t < c.type_count; t++) {
+        if (c.types[t].kind == SCHEMA_TYPE_KIND_STRUCT && !c.types[t].dirty) {
+            c.types[t].loader->type_name = c.types[t].name;
+            c.types[t].loader->type_doc  = c.types[t].decl->doc;
+        }
+    }
+
+    compiler_deinit (&c);
+    schema_deinit (schema);
+    *schema = next;
+    return schema;
+}
+
+/**
+ * @b De-initialize given schema, destroying all type loaders and declarations.
+ *
+ * @param schema
+ *
+ * @return @c schema on success.
+ * @return @c Null otherwise.
+ * */
+Schema* schema_deinit (Schema* schema) {
+    RETURN_VALUE_IF (!schema, Null, ERR_INVALID_ARGUMENTS);
+
+    if (schema->loaders) {
+        for (Size l = 0; l < schema->loader_count; l++) {
+            loader_destroy (schema->loaders[l]);
+        }
+        FREE (schema->loaders);
+    }
+
+    if (schema->msgs) {
+        for (Size m = 0; m < schema->msg_count; m++) {
+            FREE (schema->msgs[m]);
+        }
+        FREE (schema->msgs);
+    }
+
+    if (schema->decls) {
+        anv_type_decl_list_destroy (schema->decls);
+    }
+
+    if (schema->failed_decls) {
+        anv_type_decl_list_destroy (schema->failed_decls);
+    }
+
+    memset (schema, 0, sizeof (Schema));
+    return schema;
+}
+
+/**
+ * @b Find type loader of given type in schema.
+ *
+ * @param schema
+ * @param type_name
+ *
+ * @return Loader on success.
+ * @return @c Null otherwise.
+ * */
+Loader* schema_find_loader (Schema* schema, CString type_name) {
+    RETURN_VALUE_IF (!schema || !type_name, Null, ERR_INVALID_ARGUMENTS);
+
+    for (Size l = 0; l < schema->loader_count; l++) {
+        if (!strcmp (schema->loaders[l]->type_name, type_name)) {
+            return schema->loaders[l];
+        }
+    }
+
+    return Null;
+}
+
+/**
+ * @b Load a range of elements of a lazily loaded field. Elements are read only if
+ * their stream offset can't be computed without reading the ones before them.
+ * Stream cursor is restored afterwards.
+ *
+ * @param schema Schema loader of field was compiled from.
+ * @param vm VM elements are loaded with, owning their vectors.
+ * @param stream Stream field was loaded from.
+ * @param lazy Descriptor stored in place of field.
+ * @param first Index of first element to load.
+ * @param count Number of elements to load.
+ * @param mem Where elements are loaded, one after another. Each takes allocation
+ *        size of loader of elements.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+Bool schema_load_lazy (
+    Schema*     schema,
+    Vm*         vm,
+    IoStream*   stream,
+    SchemaLazy* lazy,
+    Size        first,
+    Size        count,
+    void*       mem
+) {
+    RETURN_VALUE_IF (!schema || !vm || !stream || !lazy, False, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        lazy->loader >= schema->loader_count || first > lazy->count ||
+            count > lazy->count - first,
+        False,
+        "Invalid lazy field, or elements [%zu, %zu) out of range\n",
+        first,
+        first + count
+    );
+
+    Loader* loader = schema->loaders[lazy->loader];
+    Size    size   = loader->alloc_size;
+    RETURN_VALUE_IF (count && size && !mem, False, ERR_INVALID_ARGUMENTS);
+
+    /* elements before first are loaded to scratch memory only to reach first */
+    Size   skip   = lazy->stride ? 0 : first;
+    Uint64 offset = lazy->offset;
+    RETURN_VALUE_IF (
+        lazy->stride && __builtin_add_overflow (offset, lazy->stride * first, &offset),
+        False,
+        "Offset of element %zu is too large\n",
+        first
+    );
+
+    Uint8* scratch = skip && size ? ALLOCATE (Uint8, size) : Null;
+    RETURN_VALUE_IF (skip && size && !scratch, False, ERR_OUT_OF_MEMORY);
+
+    Int64 cursor = io_stream_get_cursor (stream);
+    Bool  ok     = cursor >= 0 && io_stream_set_cursor (stream, offset);
+
+    for (Size e = 0; ok && e < skip + count; e++) {
+        Uint8* elem = e < skip ? scratch : (Uint8*)mem + (e - skip) * size;
+        ok          = vm_run_loader (vm, loader, stream, elem) != Null;
+    }
+
+    if (cursor >= 0) {
+        io_stream_set_cursor (stream, (Size)cursor);
+    }
+
+    if (scratch) {
+        FREE (scratch);
+    }
+
+    RETURN_VALUE_IF (!ok, False, "Failed to load lazy elements of \"%s\"\n", loader->type_name);
+    return True;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Register, fold and lay out all declarations, everything but emitting code.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_prepare (SchemaCompiler* c) {
+    Bool ok = compiler_register (c);
+
+    for (Size t = 0; ok && t < c->type_count; t++) {
+        if (c->types[t].kind == SCHEMA_TYPE_KIND_STRUCT) {
+            ok = compiler_fold_struct (c, c->types + t);
+        }
+    }
+
+    for (Size t = 0; ok && t < c->type_count; t++) {
+        ok = compiler_layout (c, c->types + t);
+    }
+
+    return ok;
+}
+
+/**
+ * @b Make all basic types and declarations known to compiler, and create a loader
+ * for every struct and file.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_register (SchemaCompiler* c) {
+    static const CString basic_names[FIELD_TYPE_MAX] = {
+        [FIELD_TYPE_UINT8]  = "Uint8",
+        [FIELD_TYPE_UINT16] = "Uint16",
+        [FIELD_TYPE_UINT32] = "Uint32",
+        [FIELD_TYPE_UINT64] = "Uint64",
+        [FIELD_TYPE_INT8]   = "Int8",
+        [FIELD_TYPE_INT16]  = "Int16",
+        [FIELD_TYPE_INT32]  = "Int32",
+        [FIELD_TYPE_INT64]  = "Int64",
+        [FIELD_TYPE_CHAR]   = "Char",
+        [FIELD_TYPE_BOOL]   = "Bool",
+    };
+
+    for (Size b = 0; b < FIELD_TYPE_MAX; b++) {
+        if (!basic_names[b]) {
+            continue;
+        }
+
+        c->basics[b] = (SchemaType) {
+            .kind         = SCHEMA_TYPE_KIND_BASIC,
+            .name         = basic_names[b],
+            .basic        = (FieldType)b,
+            .size         = compiler_basic_size ((FieldType)b),
+            .align        = compiler_basic_size ((FieldType)b),
+            .layout_state = SCHEMA_LAYOUT_DONE,
+        };
+        RETURN_VALUE_IF (
+            !compiler_map_insert (&c->type_map, basic_names[b], c->basics + b),
+            False,
+            ERR_OUT_OF_MEMORY
+        );
+    }
+    RETURN_VALUE_IF (
+        !compiler_map_insert (&c->type_map, "Size", c->basics + FIELD_TYPE_UINT64),
+        False,
+        ERR_OUT_OF_MEMORY
+    );
+
+    Size decl_count = 0;
+    for (TypeDeclListItem* item = c->schema->decls->head; item; item = item->next) {
+        decl_count++;
+    }
+
+    c->types = ALLOCATE (SchemaType, MAX (decl_count, 1));
+    RETURN_VALUE_IF (!c->types, False, ERR_OUT_OF_MEMORY);
+
+    for (TypeDeclListItem* item = c->schema->decls->head; item; item = item->next) {
+        TypeDecl*   decl = &item->data;
+        SchemaType* type = c->types + c->type_count++;
+
+        RETURN_VALUE_IF (!decl->name, False, "Declaration without a name\n");
+        RETURN_VALUE_IF (
+            compiler_map_find (&c->type_map, decl->name, strlen (decl->name)),
+            False,
+            "Redefinition of type \"%s\"\n",
+            decl->name
+        );
+
+        type->name = decl->name;
+        type->decl = decl;
+
+        switch (decl->decl_kind) {
+            case TYPE_DECL_KIND_ENUM : {
+                type->kind         = SCHEMA_TYPE_KIND_ENUM;
+                type->basic        = decl->enum_type;
+                type->size         = compiler_basic_size (decl->enum_type);
+                type->align        = type->size;
+                type->layout_state = SCHEMA_LAYOUT_DONE;
+                RETURN_VALUE_IF (
+                    !type->size,
+                    False,
+                    "Enum \"%s\" must be of an integer type\n",
+                    decl->name
+                );
+
+                /* a name in more than one enum refers to the first one */
+                for (EnumMemberListItem* m = decl->enum_members->head; m; m = m->next) {
+                    if (!compiler_map_find (&c->enum_map, m->data.name, strlen (m->data.name))) {
+                        RETURN_VALUE_IF (
+                            !compiler_map_insert (&c->enum_map, m->data.name, &m->data),
+                            False,
+                            ERR_OUT_OF_MEMORY
+                        );
+                    }
+                }
+                break;
+            }
+
+            case TYPE_DECL_KIND_FILE :
+            case TYPE_DECL_KIND_STRUCT : {
+                type->kind   = SCHEMA_TYPE_KIND_STRUCT;
+                type->loader = compiler_new_loader (c, decl->name, decl->doc);
+                RETURN_VALUE_IF (!type->loader, False, "Failed to create type loader\n");
+
+                if (decl->decl_kind == TYPE_DECL_KIND_FILE) {
+                    RETURN_VALUE_IF (
+                        c->schema->file_loader,
+                        False,
+                        "File \"%s\" declared after file \"%s\", only one is allowed\n",
+                        decl->name,
+                        c->schema->file_loader->type_name
+                    );
+                    c->schema->file_loader = type->loader;
+                }
+                break;
+            }
+
+            case TYPE_DECL_KIND_TYPEDEF :
+                type->kind = SCHEMA_TYPE_KIND_TYPEDEF;
+                break;
+
+            default :
+                RETURN_VALUE_IF_REACHED (False, "Invalid declaration \"%s\"\n", decl->name);
+        }
+
+        RETURN_VALUE_IF (
+            !compiler_map_insert (&c->type_map, type->name, type),
+            False,
+            ERR_OUT_OF_MEMORY
+        );
+    }
+
+    /* cases refer to types declared anywhere in description */
+    for (Size t = 0; t < c->type_count; t++) {
+        if (c->types[t].kind == SCHEMA_TYPE_KIND_TYPEDEF &&
+            !compiler_resolve_typedef (c, c->types + t)) {
+            return False;
+        }
+    }
+
+    return True;
+}
+
+/**
+ * @b Resolve value and type of each case of a typedef. Case names are looked up in
+ * enum that's the typedef's parameter first, and then in all enums.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_resolve_typedef (SchemaCompiler* c, SchemaType* type) {
+    TypeDecl* decl = type->decl;
+    RETURN_VALUE_IF (
+        !decl->type_params || !decl->type_params->head || decl->type_params->head->next,
+        False,
+        "Typedef \"%s\" must have exactly one parameter\n",
+        type->name
+    );
+
+    ExprOpnd* param = &decl->type_params->head->data;
+    if (param->opnd_type == EXPR_OPND_TYPE_ID) {
+        RETURN_VALUE_IF (!compiler_use (c, type, param->id), False, ERR_OUT_OF_MEMORY);
+        SchemaType* param_type = compiler_map_find (&c->type_map, param->id, strlen (param->id));
+        if (param_type && param_type->kind == SCHEMA_TYPE_KIND_ENUM) {
+            type->param = param_type;
+        }
+    }
+
+    Size case_count = 0;
+    for (TypedefCaseListItem* item = decl->cases->head; item; item = item->next) {
+        case_count++;
+    }
+
+    type->cases = ALLOCATE (SchemaCase, MAX (case_count, 1));
+    RETURN_VALUE_IF (!type->cases, False, ERR_OUT_OF_MEMORY);
+
+    for (TypedefCaseListItem* item = decl->cases->head; item; item = item->next) {
+        TypedefCase* tcase  = &item->data;
+        EnumMember*  member = Null;
+        RETURN_VALUE_IF (
+            !compiler_use (c, type, tcase->key) || !compiler_use (c, type, tcase->type_name),
+            False,
+            ERR_OUT_OF_MEMORY
+        );
+
+        if (type->param) {
+            EnumMemberListItem* m = type->param->decl->enum_members->head;
+            for (; m && !member; m = m->next) {
+                if (!strcmp (m->data.name, tcase->key)) {
+                    member = &m->data;
+                }
+            }
+        }
+
+        if (!member) {
+            member = compiler_map_find (&c->enum_map, tcase->key, strlen (tcase->key));
+        }
+
+        RETURN_VALUE_IF (
+            !member,
+            False,
+            "%s : Case \"%s\" is not an enum member\n",
+            type->name,
+            tcase->key
+        );
+
+        SchemaType* case_type =
+            compiler_map_find (&c->type_map, tcase->type_name, strlen (tcase->type_name));
+        RETURN_VALUE_IF (
+            !case_type,
+            False,
+            "%s : Unknown type \"%s\"\n",
+            type->name,
+            tcase->type_name
+        );
+        RETURN_VALUE_IF (
+            case_type->kind == SCHEMA_TYPE_KIND_TYPEDEF,
+            False,
+            "%s : Case \"%s\" can't be another typedef\n",
+            type->name,
+            tcase->key
+        );
+
+        type->cases[type->case_count++] = (SchemaCase) {
+            .first = member->first,
+            .last  = member->last,
+            .type  = case_type,
+        };
+    }
+
+    return True;
+}
+
+/**
+ * @b Remember that a type looked up given name. Only recorded when recompiling.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_use (SchemaCompiler* c, SchemaType* type, CString name) {
+    if (!c->prev) {
+        return True;
+    }
+
+    if (type->use_count >= type->use_capacity) {
+        Size     capacity = type->use_capacity ? type->use_capacity * 2 : 8;
+        CString* uses     = REALLOCATE (type->uses, CString, capacity);
+        RETURN_VALUE_IF (!uses, False, ERR_OUT_OF_MEMORY);
+
+        type->uses         = uses;
+        type->use_capacity = capacity;
+    }
+
+    type->uses[type->use_count++] = name;
+    return True;
+}
+
+/**
+ * @b Mark types whose loaders must be compiled again.
+ *
+ * Names of declarations that changed, or were added or removed since schema was
+ * compiled before, are dirty, and so are names of members of such enums. A type is
+ * dirty if it's declaration changed, or it looked up a dirty name, after which it's
+ * own name is dirty too, till nothing more changes.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_mark_dirty (SchemaCompiler* c) {
+    SchemaMap dirty = {0};
+    SchemaMap prev  = {0};
+    Bool      ok    = True;
+
+    for (TypeDeclListItem* item = c->prev->decls->head; ok && item; item = item->next) {
+        ok = compiler_map_insert (&prev, item->data.name, &item->data);
+    }
+
+    /* old members of a changed or removed enum may still be referred to */
+    for (TypeDeclListItem* item = c->prev->decls->head; ok && item; item = item->next) {
+        SchemaType* type =
+            compiler_map_find (&c->type_map, item->data.name, strlen (item->data.name));
+        if (!type || !type->decl || type->decl->changed) {
+            ok = compiler_dirty_decl (&dirty, &item->data);
+        }
+    }
+
+    for (Size t = 0; ok && t < c->type_count; t++) {
+        SchemaType* type = c->types + t;
+        type->dirty      = type->decl->changed ||
+                      !compiler_map_find (&prev, type->name, strlen (type->name));
+        ok = !type->dirty || compiler_dirty_decl (&dirty, type->decl);
+    }
+
+    /* loaders of lazy fields are stored as their index, which depends on order of loaders */
+    Bool reorder = ok && !compiler_same_order (c);
+    for (Size t = 0; reorder && t < c->type_count; t++) {
+        SchemaType* type = c->types + t;
+        for (Size f = 0; !type->dirty && f < type->field_count; f++) {
+            type->dirty = type->fields[f].lazy;
+        }
+    }
+
+    for (Bool more = ok; ok && more;) {
+        more = False;
+        for (Size t = 0; ok && t < c->type_count; t++) {
+            SchemaType* type = c->types + t;
+            for (Size u = 0; !type->dirty && u < type->use_count; u++) {
+                type->dirty = !!compiler_map_find (&dirty, type->uses[u], strlen (type->uses[u]));
+            }
+
+            if (type->dirty && !compiler_map_find (&dirty, type->name, strlen (type->name))) {
+                ok   = compiler_dirty_name (&dirty, type->name);
+                more = True;
+            }
+        }
+    }
+
+    compiler_map_deinit (&dirty);
+    compiler_map_deinit (&prev);
+    RETURN_VALUE_IF (!ok, False, ERR_OUT_OF_MEMORY);
+
+    return True;
+}
+
+/**
+ * @b Add a name to set of dirty names, if it's not there already.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_dirty_name (SchemaMap* dirty, CString name) {
+    return compiler_map_find (dirty, name, strlen (name)) ||
+           compiler_map_insert (dirty, name, (void*)name);
+}
+
+/**
+ * @b Add name of a declaration, and names of it's members if it's an enum, to set of
+ * dirty names.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_dirty_decl (SchemaMap* dirty, TypeDecl* decl) {
+    Bool ok = compiler_dirty_name (dirty, decl->name);
+
+    if (decl->decl_kind == TYPE_DECL_KIND_ENUM) {
+        for (EnumMemberListItem* m = decl->enum_members->head; ok && m; m = m->next) {
+            ok = compiler_dirty_name (dirty, m->data.name);
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * @b Whether structs are declared in same order as in schema being recompiled, so their
+ * loaders have same index in both.
+ * */
+PRIVATE Bool compiler_same_order (SchemaCompiler* c) {
+    TypeDeclListItem* item = c->prev->decls->head;
+
+    for (Size t = 0; t < c->type_count; t++) {
+        if (c->types[t].kind != SCHEMA_TYPE_KIND_STRUCT) {
+            continue;
+        }
+
+        while (item && item->data.decl_kind != TYPE_DECL_KIND_STRUCT &&
+               item->data.decl_kind != TYPE_DECL_KIND_FILE) {
+            item = item->next;
+        }
+
+        if (!item || strcmp (item->data.name, c->types[t].name)) {
+            return False;
+        }
+        item = item->next;
+    }
+
+    while (item && item->data.decl_kind != TYPE_DECL_KIND_STRUCT &&
+           item->data.decl_kind != TYPE_DECL_KIND_FILE) {
+        item = item->next;
+    }
+
+    return !item;
+}
+
+/**
+ * @b Replace new loaders of structs that aren't dirty with loaders of schema being
+ * recompiled, and take loaders of basic types from it. Basic loaders keep their
+ * order, after loaders of all structs.
+ *
+ * Reused loaders are shared by both schemas till recompilation finishes.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_reuse (SchemaCompiler* c) {
+    Schema* schema = c->schema;
+    Schema* prev   = c->prev;
+
+    for (Size t = 0; t < c->type_count; t++) {
+        SchemaType* type = c->types + t;
+        if (type->kind != SCHEMA_TYPE_KIND_STRUCT || type->dirty) {
+            continue;
+        }
+
+        Loader* loader = schema_find_loader (prev, type->name);
+        RETURN_VALUE_IF (!loader, False, "%s : No loader to reuse\n", type->name);
+
+        Size index = 0;
+        while (schema->loaders[index] != type->loader) {
+            index++;
+        }
+
+        if (schema->file_loader == type->loader) {
+            schema->file_loader = loader;
+        }
+
+        loader_destroy (type->loader);
+        schema->loaders[index] = loader;
+        type->loader           = loader;
+    }
+
+    for (Size l = 0; l < prev->loader_count; l++) {
+        for (Size b = 0; b < FIELD_TYPE_MAX; b++) {
+            SchemaType* basic = c->basics + b;
+            if (!basic->name || basic->loader ||
+                strcmp (basic->name, prev->loaders[l]->type_name)) {
+                continue;
+            }
+
+            RETURN_VALUE_IF (
+                !compiler_add_loader (c, prev->loaders[l]),
+                False,
+                "Failed to reuse type loader\n"
+            );
+            basic->loader = prev->loaders[l];
+        }
+    }
+
+    return True;
+}
+
+/**
+ * @b Remove a loader from schema without destroying it.
+ *
+ * @return @c True if schema had loader.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_drop_loader (Schema* schema, Loader* loader) {
+    for (Size l = 0; l < schema->loader_count; l++) {
+        if (schema->loaders[l] == loader) {
+            schema->loaders[l] = schema->loaders[--schema->loader_count];
+            return True;
+        }
+    }
+
+    return False;
+}
+
+/**
+ * @b Move messages printed by a loader from one schema to other. Schema messages
+ * are moved to must have space for all of them.
+ * */
+PRIVATE void compiler_move_msgs (Schema* to, Schema* from, Loader* loader) {
+    for (Size b = 0; b < loader->insn_block_count; b++) {
+        InsnBlock* block = loader->insn_blocks + b;
+        for (Size i = 0; i < block->insn_count; i++) {
+            Insn* insn = block->insns + i;
+            if (insn->insn_type >= INSN_TYPE_PINFO && insn->insn_type <= INSN_TYPE_PERR) {
+                compiler_move_msg (to, from, insn->insn.perr.msg);
+            }
+        }
+    }
+
+    for (Size t = 0; t < loader->check.term_count; t++) {
+        compiler_move_msg (to, from, loader->check.terms[t].msg);
+    }
+}
+
+/**
+ * @b Move a message from one schema to other, unless it's moved already.
+ * */
+PRIVATE void compiler_move_msg (Schema* to, Schema* from, CString msg) {
+    for (Size m = 0; msg && m < from->msg_count; m++) {
+        if (from->msgs[m] == msg) {
+            to->msgs[to->msg_count++] = from->msgs[m];
+            from->msgs[m]             = from->msgs[--from->msg_count];
+            return;
+        }
+    }
+}
+
+/**
+ * @b Fold constant parts of all expressions in given struct, so that they're
+ * computed once by compiler instead of on every load. Names of enum members and
+ * of aliases with constant values are constants too.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_fold_struct (SchemaCompiler* c, SchemaType* type) {
+    TypeDecl*   decl  = type->decl;
+    SchemaScope scope = {.type = type};
+
+    for (AliasListItem* item = decl->aliases ? decl->aliases->head : Null; item;
+         item                = item->next) {
+        if (!compiler_fold (c, &scope, &item->data.expr)) {
+            return False;
+        }
+    }
+
+    for (FieldListItem* item = decl->fields->head; item; item = item->next) {
+        FieldAnnotationList* annotations = item->data.annotation_list;
+        for (FieldAnnotationListItem* a = annotations ? annotations->head : Null; a; a = a->next) {
+            FieldAnnotation* annotation = &a->data;
+            Bool             ok         = True;
+
+            if (annotation->annotation_flag == FIELD_ANNOTATION_FLAG_VECTOR) {
+                ok = compiler_fold (c, &scope, &annotation->vec_size);
+            } else if (annotation->annotation_flag == FIELD_ANNOTATION_FLAG_ADDRESS) {
+                ok = compiler_fold (c, &scope, &annotation->addr.offset);
+            } else if (annotation->annotation_flag == FIELD_ANNOTATION_FLAG_TYPE_ARGS) {
+                ExprOpndListItem* arg = annotation->type_args->head;
+                for (; ok && arg; arg = arg->next) {
+                    ok = compiler_fold (c, &scope, &arg->data);
+                }
+            }
+
+            RETURN_VALUE_IF (
+                !ok,
+                False,
+                "%s.%s : Invalid constant expression\n",
+                type->name,
+                item->data.field_name
+            );
+        }
+    }
+
+    for (AssertionListItem* item = decl->assertions ? decl->assertions->head : Null; item;
+         item                    = item->next) {
+        if (!compiler_fold (c, &scope, &item->data.cond)) {
+            return False;
+        }
+    }
+
+    return True;
+}
+
+/**
+ * @b Replace expression with it's value if all operands are constant. Operators
+ * compute exactly what the VM instructions they'd compile to compute.
+ *
+ * @return @c True on success, whether anything was folded or not.
+ * @return @c False if a constant expression is invalid.
+ * */
+PRIVATE Bool compiler_fold (SchemaCompiler* c, SchemaScope* scope, ExprOpnd* e) {
+    switch (e->opnd_type) {
+        case EXPR_OPND_TYPE_INT :
+            return compiler_fold_value (e, (Uint64)e->signed_val);
+
+        case EXPR_OPND_TYPE_ID :
+            return compiler_fold_id (c, scope, e);
+
+        case EXPR_OPND_TYPE_ARITH_EXPR : {
+            ArithExpr* arith = e->arith_expr;
+            Bool       unary = arith->op == ARITH_EXPR_OP_INV;
+            if (!compiler_fold (c, scope, &arith->left_opnd) ||
+                (!unary && !compiler_fold (c, scope, &arith->right_opnd))) {
+                return False;
+            }
+
+            if (!compiler_is_const (&arith->left_opnd) ||
+                (!unary && !compiler_is_const (&arith->right_opnd))) {
+                return True;
+            }
+
+            Uint64 a = arith->left_opnd.unsigned_val;
+            Uint64 b = unary ? 0 : arith->right_opnd.unsigned_val;
+            RETURN_VALUE_IF (
+                (arith->op == ARITH_EXPR_OP_DIV || arith->op == ARITH_EXPR_OP_MOD) && !b,
+                False,
+                "%s : Division by zero in constant expression\n",
+                scope->type->name
+            );
+
+            switch (arith->op) {
+                case ARITH_EXPR_OP_ADD :
+                    return compiler_fold_value (e, a + b);
+                case ARITH_EXPR_OP_SUB :
+                    return compiler_fold_value (e, a - b);
+                case ARITH_EXPR_OP_MUL :
+                    return compiler_fold_value (e, a * b);
+                case ARITH_EXPR_OP_DIV :
+                    return compiler_fold_value (e, a / b);
+                case ARITH_EXPR_OP_MOD :
+                    return compiler_fold_value (e, a % b);
+                case ARITH_EXPR_OP_AND :
+                    return compiler_fold_value (e, a & b);
+                case ARITH_EXPR_OP_OR :
+                    return compiler_fold_value (e, a | b);
+                case ARITH_EXPR_OP_XOR :
+                    return compiler_fold_value (e, a ^ b);
+                case ARITH_EXPR_OP_LSHIFT :
+                    return compiler_fold_value (e, b < 64 ? a << b : 0);
+                case ARITH_EXPR_OP_RSHIFT :
+                    return compiler_fold_value (e, b < 64 ? a >> b : 0);
+                case ARITH_EXPR_OP_INV :
+                    return compiler_fold_value (e, ~a);
+                default :
+                    /* left for code generation to report */
+                    return True;
+            }
+        }
+
+        case EXPR_OPND_TYPE_COND_EXPR : {
+            CondExpr* cond  = e->cond_expr;
+            Bool      unary = cond->op == COND_EXPR_OP_NOT;
+            if (!compiler_fold (c, scope, &cond->left_opnd) ||
+                (!unary && !compiler_fold (c, scope, &cond->right_opnd))) {
+                return False;
+            }
+
+            if (!compiler_is_const (&cond->left_opnd) ||
+                (!unary && !compiler_is_const (&cond->right_opnd))) {
+                return True;
+            }
+
+            Uint64 a = cond->left_opnd.unsigned_val;
+            Uint64 b = unary ? 0 : cond->right_opnd.unsigned_val;
+            switch (cond->op) {
+                case COND_EXPR_OP_EQ :
+                    return compiler_fold_value (e, a == b);
+                case COND_EXPR_OP_NE :
+                    return compiler_fold_value (e, a != b);
+                case COND_EXPR_OP_LT :
+                    return compiler_fold_value (e, a < b);
+                case COND_EXPR_OP_LE :
+                    return compiler_fold_value (e, a <= b);
+                case COND_EXPR_OP_GT :
+                    return compiler_fold_value (e, a > b);
+                case COND_EXPR_OP_GE :
+                    return compiler_fold_value (e, a >= b);
+                case COND_EXPR_OP_AND :
+                    return compiler_fold_value (e, a && b);
+                case COND_EXPR_OP_OR :
+                    return compiler_fold_value (e, a || b);
+                case COND_EXPR_OP_NOT :
+                    return compiler_fold_value (e, !a);
+                default :
+                    return True;
+            }
+        }
+
+        default :
+            return True;
+    }
+}
+
+/**
+ * @b Replace a name with it's value if it's an alias with constant value or an enum
+ * member. Names are looked up like code generation does, so a field or an alias
+ * hides an enum member with same name.
+ *
+ * @return @c True on success, whether name was folded or not.
+ * @return @c False if name is an alias with an invalid expression.
+ * */
+PRIVATE Bool compiler_fold_id (SchemaCompiler* c, SchemaScope* scope, ExprOpnd* e) {
+    TypeDecl* decl = scope->type->decl;
+
+    for (AliasListItem* item = decl->aliases ? decl->aliases->head : Null; item;
+         item                = item->next) {
+        if (strcmp (item->data.name, e->id)) {
+            continue;
+        }
+
+        RETURN_VALUE_IF (
+            scope->alias_depth >= COMPILER_MAX_ALIAS_USE,
+            False,
+            "%s : Alias \"%s\" refers to itself\n",
+            scope->type->name,
+            e->id
+        );
+
+        scope->alias_depth++;
+        Bool ok = compiler_fold (c, scope, &item->data.expr);
+        scope->alias_depth--;
+
+        if (ok && compiler_is_const (&item->data.expr)) {
+            return compiler_fold_value (e, item->data.expr.unsigned_val);
+        }
+        return ok;
+    }
+
+    CString dot = strchr (e->id, '.');
+    Size    len = dot ? (Size)(dot - e->id) : strlen (e->id);
+    for (FieldListItem* item = decl->fields->head; item; item = item->next) {
+        if (!strncmp (item->data.field_name, e->id, len) && !item->data.field_name[len]) {
+            return True;
+        }
+    }
+
+    RETURN_VALUE_IF (!compiler_use (c, scope->type, e->id), False, ERR_OUT_OF_MEMORY);
+    EnumMember* member = compiler_map_find (&c->enum_map, e->id, strlen (e->id));
+    if (member) {
+        return compiler_fold_value (e, member->first);
+    }
+
+    return True;
+}
+
+/**
+ * @b Replace expression with a constant.
+ *
+ * @return @c True always.
+ * */
+PRIVATE Bool compiler_fold_value (ExprOpnd* e, Uint64 value) {
+    expr_opnd_deinit (e);
+
+    e->opnd_type    = EXPR_OPND_TYPE_UINT;
+    e->unsigned_val = value;
+    return True;
+}
+
+/**
+ * @b Whether expression is a constant, after folding.
+ * */
+PRIVATE Bool compiler_is_const (ExprOpnd* e) {
+    return e->opnd_type == EXPR_OPND_TYPE_UINT;
+}
+
+/**
+ * @b Compute memory size and alignment of given type, and offsets of fields if it's
+ * a struct. A typedef takes as much memory as largest of it's cases.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_layout (SchemaCompiler* c, SchemaType* type) {
+    if (type->layout_state == SCHEMA_LAYOUT_DONE) {
+        return True;
+    }
+
+    RETURN_VALUE_IF (
+        type->layout_state == SCHEMA_LAYOUT_RUNNING,
+        False,
+        "Type \"%s\" contains itself, use a vector instead\n",
+        type->name
+    );
+    type->layout_state = SCHEMA_LAYOUT_RUNNING;
+
+    if (type->kind == SCHEMA_TYPE_KIND_STRUCT) {
+        RETURN_VALUE_IF (!compiler_layout_struct (c, type), False, "Failed to lay out struct\n");
+    } else if (type->kind == SCHEMA_TYPE_KIND_TYPEDEF) {
+        for (Size k = 0; k < type->case_count; k++) {
+            if (!compiler_layout (c, type->cases[k].type)) {
+                return False;
+            }
+            type->size  = MAX (type->size, type->cases[k].type->size);
+            type->align = MAX (type->align, type->cases[k].type->align);
+        }
+
+        type->align = MAX (type->align, 1);
+        type->size  = compiler_align (type->size, type->align);
+    }
+
+    type->layout_state = SCHEMA_LAYOUT_DONE;
+    return True;
+}
+
+/**
+ * @b Resolve types of fields of a struct and lay them out in memory, one after another,
+ * each aligned like it would be in a C struct. Vectors whose size is a constant become
+ * arrays, and typedef fields with a constant type argument get the selected type.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_layout_struct (SchemaCompiler* c, SchemaType* type) {
+    Size field_count = 0;
+    for (FieldListItem* item = type->decl->fields->head; item; item = item->next) {
+        field_count++;
+    }
+
+    type->fields = ALLOCATE (SchemaField, MAX (field_count, 1));
+    RETURN_VALUE_IF (!type->fields, False, ERR_OUT_OF_MEMORY);
+
+    Size off = 0;
+    for (FieldListItem* item = type->decl->fields->head; item; item = item->next) {
+        Field*       field = &item->data;
+        SchemaField* sf    = type->fields + type->field_count++;
+
+        sf->field = field;
+        sf->count = 1;
+
+        RETURN_VALUE_IF (
+            compiler_find_field (type, type->field_count - 1, field->field_name, SIZE_MAX),
+            False,
+            "%s : Redefinition of field \"%s\"\n",
+            type->name,
+            field->field_name
+        );
+
+        if (field->field_type == FIELD_TYPE_STRUCT) {
+            RETURN_VALUE_IF (
+                !compiler_use (c, type, field->type_name),
+                False,
+                ERR_OUT_OF_MEMORY
+            );
+            sf->type =
+                compiler_map_find (&c->type_map, field->type_name, strlen (field->type_name));
+        } else if (compiler_basic_size (field->field_type)) {
+            sf->type = c->basics + field->field_type;
+        }
+
+        RETURN_VALUE_IF (
+            !sf->type,
+            False,
+            "%s.%s : Type \"%s\" is unknown or not supported yet\n",
+            type->name,
+            field->field_name,
+            field->type_name ? field->type_name : "CStr"
+        );
+
+        FieldAnnotation* annotation = Null;
+        if ((annotation = field_get_annotation (field, FIELD_ANNOTATION_FLAG_ARRAY))) {
+            sf->count = annotation->arr_size;
+        }
+
+        if ((annotation = field_get_annotation (field, FIELD_ANNOTATION_FLAG_VECTOR))) {
+            sf->vec_size = &annotation->vec_size;
+            if (compiler_is_const (sf->vec_size)) {
+                sf->count    = sf->vec_size->unsigned_val;
+                sf->vec_size = Null;
+            }
+        }
+
+        if ((annotation = field_get_annotation (field, FIELD_ANNOTATION_FLAG_TYPE_ARGS))) {
+            ExprOpndList* args = annotation->type_args;
+            RETURN_VALUE_IF (
+                sf->type->kind != SCHEMA_TYPE_KIND_TYPEDEF || !args->head || args->head->next,
+                False,
+                "%s.%s : Only typedefs take type arguments, exactly one\n",
+                type->name,
+                field->field_name
+            );
+            sf->type_arg = &args->head->data;
+        }
+
+        RETURN_VALUE_IF (
+            sf->type->kind == SCHEMA_TYPE_KIND_TYPEDEF && !sf->type_arg,
+            False,
+            "%s.%s : Typedef \"%s\" needs a type argument\n",
+            type->name,
+            field->field_name,
+            sf->type->name
+        );
+
+        if (sf->type_arg && compiler_is_const (sf->type_arg)) {
+            SchemaType* tdef = sf->type;
+            Uint64      arg  = sf->type_arg->unsigned_val;
+            for (Size k = 0; k < tdef->case_count && sf->type == tdef; k++) {
+                if (arg >= tdef->cases[k].first && arg <= tdef->cases[k].last) {
+                    sf->type = tdef->cases[k].type;
+                }
+            }
+
+            RETURN_VALUE_IF (
+                sf->type == tdef,
+                False,
+                "%s.%s : Type argument %llu matches no case of \"%s\"\n",
+                type->name,
+                field->field_name,
+                (unsigned long long)arg,
+                tdef->name
+            );
+            sf->type_arg = Null;
+        }
+
+        if ((sf->addr = field_get_annotation (field, FIELD_ANNOTATION_FLAG_ADDRESS))) {
+            type->uses_base = type->uses_base || sf->addr->addr.base == FIELD_ADDR_BASE_STRUCT;
+            sf->lazy        = !!(c->schema->flags & SCHEMA_FLAG_LAZY);
+        }
+
+        /* vectors and lazy fields don't store their elements inline, so element type can
+         * contain this one */
+        Size align = _Alignof (VmVector);
+        if (sf->lazy) {
+            sf->mem_size = sizeof (SchemaLazy);
+            align        = _Alignof (SchemaLazy);
+        } else if (sf->vec_size) {
+            sf->mem_size = sizeof (VmVector);
+        } else {
+            RETURN_VALUE_IF (
+                !compiler_layout (c, sf->type),
+                False,
+                "%s.%s : Failed to lay out field\n",
+                type->name,
+                field->field_name
+            );
+            RETURN_VALUE_IF (
+                __builtin_mul_overflow (sf->type->size, sf->count, &sf->mem_size),
+                False,
+                "%s.%s : Field is too large\n",
+                type->name,
+                field->field_name
+            );
+            align = sf->type->align;
+        }
+
+        type->align = MAX (type->align, align);
+        sf->mem_off = off = compiler_align (off, align);
+        RETURN_VALUE_IF (
+            __builtin_add_overflow (off, sf->mem_size, &off),
+            False,
+            "%s : Struct is too large\n",
+            type->name
+        );
+    }
+
+    type->align              = MAX (type->align, 1);
+    type->size               = compiler_align (off, type->align);
+    type->loader->alloc_size = type->size;
+
+    return compiler_pod_layout (type);
+}
+
+/**
+ * @b Decide whether a laid out struct is POD-fixed, and if it is, flatten it to a
+ * single struct layout. A POD-fixed struct has fixed size arrays of basic values,
+ * enums and plain structs only, all read in place, so loading it is a block copy
+ * of fixed size from stream to memory, with padding in between. Structs asserting
+ * something are loaded by their own loader, which checks them.
+ *
+ * Adjacent values of same size are merged into one field of layout, so a struct
+ * without padding ends up with a layout that's a single @c memcpy.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_pod_layout (SchemaType* type) {
+    Size value_count = 0;
+    for (Size f = 0; f < type->field_count; f++) {
+        SchemaField* sf    = type->fields + f;
+        SchemaType*  ftype = sf->type;
+
+        if (sf->vec_size || sf->addr) {
+            return True;
+        }
+
+        if (ftype->kind == SCHEMA_TYPE_KIND_BASIC || ftype->kind == SCHEMA_TYPE_KIND_ENUM) {
+            value_count++;
+        } else if (ftype->kind == SCHEMA_TYPE_KIND_STRUCT && ftype->is_plain) {
+            Size count = 0;
+            RETURN_VALUE_IF (
+                __builtin_mul_overflow (ftype->pod_layout.field_count, sf->count, &count) ||
+                    __builtin_add_overflow (value_count, count, &value_count),
+                False,
+                "%s.%s : Field is too large\n",
+                type->name,
+                sf->field->field_name
+            );
+        } else {
+            return True;
+        }
+    }
+
+    StructLayout* layout = &type->pod_layout;
+    layout->fields       = ALLOCATE (StructLayoutField, MAX (value_count, 1));
+    RETURN_VALUE_IF (!layout->fields, False, ERR_OUT_OF_MEMORY);
+
+    for (Size f = 0; f < type->field_count; f++) {
+        SchemaField* sf    = type->fields + f;
+        SchemaType*  ftype = sf->type;
+
+        if (ftype->kind != SCHEMA_TYPE_KIND_STRUCT) {
+            StructLayoutField value = {
+                .mem_off    = sf->mem_off,
+                .stream_off = layout->stream_size,
+                .size       = ftype->size,
+                .count      = sf->count
+            };
+            compiler_pod_add (layout, &value);
+            continue;
+        }
+
+        for (Size e = 0; e < sf->count; e++) {
+            Size mem_off    = sf->mem_off + e * ftype->size;
+            Size stream_off = layout->stream_size;
+            for (Size v = 0; v < ftype->pod_layout.field_count; v++) {
+                StructLayoutField value  = ftype->pod_layout.fields[v];
+                value.mem_off           += mem_off;
+                value.stream_off        += stream_off;
+                compiler_pod_add (layout, &value);
+            }
+        }
+    }
+
+    layout->mem_size = type->size;
+    layout->is_dense = True;
+    for (Size v = 0; v < layout->field_count; v++) {
+        layout->is_dense &= layout->fields[v].mem_off == layout->fields[v].stream_off;
+    }
+
+    type->is_pod   = True;
+    type->is_plain = True;
+
+    AssertionList* assertions = type->decl->assertions;
+    for (AssertionListItem* item = assertions ? assertions->head : Null; item; item = item->next) {
+        type->is_plain &= compiler_is_const (&item->data.cond) && item->data.cond.unsigned_val;
+    }
+
+    return True;
+}
+
+/**
+ * @b Append a value to a POD layout, merging it with last field if both are
+ * contiguous in memory as well as in stream, and have same element size.
+ * Layout must have space for one more field.
+ * */
+PRIVATE void compiler_pod_add (StructLayout* layout, StructLayoutField* value) {
+    StructLayoutField* last = layout->field_count ? layout->fields + layout->field_count - 1 : Null;
+
+    if (last && last->size == value->size &&
+        last->mem_off + last->size * last->count == value->mem_off &&
+        last->stream_off + last->size * last->count == value->stream_off) {
+        last->count += value->count;
+    } else {
+        layout->fields[layout->field_count++] = *value;
+    }
+
+    layout->stream_size = value->stream_off + value->size * value->count;
+}
+
+/**
+ * @b Emit code of loader of given struct. Fields are loaded in order, or all at
+ * once by a single block copy if struct is POD-fixed, followed by checking all
+ * assertions that aren't always true. Assertions only comparing values with constants
+ * go to check table of loader instead, and the rest are skipped by a @c CHECK when
+ * VM's validation level doesn't check the object.
+ *
+ * When type of more than one typedef field is selected by same field loaded before,
+ * type is selected only once, and rest of fields are emitted once for every case
+ * with all of their typedefs resolved (see @c compiler_emit_fields).
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_emit_struct (SchemaCompiler* c, SchemaType* type) {
+    c->loader    = type->loader;
+    c->block     = 0;
+    c->free_regs = COMPILER_TEMP_REGS;
+    c->known     = (SchemaKnown) {0};
+    RETURN_VALUE_IF (!compiler_new_block (c), False, "Failed to create instruction block\n");
+
+    if (type->uses_base) {
+        if (!compiler_emit (c, TELL (COMPILER_REG_BASE))) {
+            return False;
+        }
+    }
+
+    SchemaScope scope = {.type = type};
+    if (type->is_pod) {
+        Size id = 0;
+        RETURN_VALUE_IF (
+            !compiler_add_layout (c, type, &id) || !compiler_emit (c, READ_STRUCT (0, id)),
+            False,
+            "%s : Failed to compile block copy\n",
+            type->name
+        );
+    } else if (!compiler_emit_fields (c, &scope, 0)) {
+        return False;
+    }
+    scope.field_count = type->field_count;
+
+    AssertionList* assertions      = type->decl->assertions;
+    Size           assertion_count = 0;
+    for (AssertionListItem* item = assertions ? assertions->head : Null; item; item = item->next) {
+        if (!compiler_is_const (&item->data.cond)) {
+            assertion_count++;
+            continue;
+        }
+
+        RETURN_VALUE_IF (
+            !item->data.cond.unsigned_val,
+            False,
+            "%s : Assertion always fails : %s\n",
+            type->name,
+            item->data.text ? item->data.text : ""
+        );
+    }
+
+    /* a struct read by block copy and checking nothing can be loaded independently */
+    if (!assertion_count) {
+        if (type->is_pod) {
+            type->loader->fixed_status      = LOADER_FIXED_YES;
+            type->loader->fixed_stream_size = type->pod_layout.stream_size;
+        }
+        return compiler_emit (c, EXIT (SUCCESS));
+    }
+
+    /* failing assertions jump to blocks after loader's successful exit */
+    SchemaPatch* patches  = ALLOCATE (SchemaPatch, assertion_count);
+    Bool*        in_table = ALLOCATE (Bool, assertion_count);
+    Bool         ok       = patches && in_table;
+    if (!ok) {
+        PRINT_ERR (ERR_OUT_OF_MEMORY);
+    }
+
+    /* assertions only comparing values with constants are checked by caller, over all
+     * objects loaded at once */
+    CheckTable*        table      = &type->loader->check;
+    Size               code_count = 0;
+    Size               a          = 0;
+    AssertionListItem* item       = assertions->head;
+    for (; ok && item; item = item->next) {
+        if (compiler_is_const (&item->data.cond)) {
+            continue;
+        }
+
+        Size first  = table->term_count;
+        in_table[a] = compiler_check_terms (&scope, &item->data.cond, table);
+        if (!in_table[a++]) {
+            table->term_count = first;
+            code_count++;
+            continue;
+        }
+
+        CString msg = compiler_msg (
+            c,
+            "%s : Assertion failed : %s",
+            type->name,
+            item->data.text ? item->data.text : ""
+        );
+
+        ok = msg != Null;
+        for (Size t = first; ok && t < table->term_count; t++) {
+            table->terms[t].msg = msg;
+        }
+    }
+
+    if (ok && !code_count) {
+        if (type->is_pod) {
+            type->loader->fixed_status      = LOADER_FIXED_YES;
+            type->loader->fixed_stream_size = type->pod_layout.stream_size;
+        }
+        ok = compiler_emit (c, EXIT (SUCCESS));
+    }
+
+    /* rest are checked by loader itself, unless VM's validation level skips this object */
+    SchemaPatch skip = {0};
+    ok               = ok && (!code_count || compiler_emit_jump (c, CHECK (0), &skip));
+    for (a = 0, item = assertions->head; ok && code_count && item; item = item->next) {
+        if (compiler_is_const (&item->data.cond) || in_table[a++]) {
+            continue;
+        }
+
+        Uint8 reg = 0;
+        ok        = compiler_eval (c, &scope, &item->data.cond, &reg) &&
+             compiler_emit_jump (c, JZ (reg, 0), patches + a - 1);
+        compiler_free_reg (c, reg);
+    }
+
+    if (ok && code_count) {
+        ok = compiler_new_block (c);
+        compiler_patch (c, &skip, c->block);
+        ok = ok && compiler_emit (c, EXIT (SUCCESS));
+    }
+
+    for (a = 0, item = assertions->head; ok && code_count && item; item = item->next) {
+        if (compiler_is_const (&item->data.cond) || in_table[a++]) {
+            continue;
+        }
+
+        CString msg = compiler_msg (
+            c,
+            "%s : Assertion failed : %s",
+            type->name,
+            item->data.text ? item->data.text : ""
+        );
+
+        ok = msg && compiler_new_block (c);
+        if (ok) {
+            compiler_patch (c, patches + a - 1, c->block);
+            ok = compiler_emit (c, PERR (msg)) && compiler_emit (c, EXIT (FAILURE));
+        }
+    }
+
+    if (patches) {
+        FREE (patches);
+    }
+    if (in_table) {
+        FREE (in_table);
+    }
+    RETURN_VALUE_IF (!ok, False, "%s : Failed to compile assertions\n", type->name);
+
+    return True;
+}
+
+/**
+ * @b Add comparisons of an assertion to given check table, if it only compares values
+ * at fixed offsets in object with constants, joined by @c &&.
+ *
+ * @return @c True if whole assertion was added to table.
+ * @return @c False otherwise, possibly with some of it's comparisons added.
+ * */
+PRIVATE Bool compiler_check_terms (SchemaScope* scope, ExprOpnd* e, CheckTable* table) {
+    static const CheckCmp cmps[COND_EXPR_OP_MAX] = {
+        [COND_EXPR_OP_EQ] = CHECK_CMP_EQ,
+        [COND_EXPR_OP_NE] = CHECK_CMP_NE,
+        [COND_EXPR_OP_LE] = CHECK_CMP_LE,
+        [COND_EXPR_OP_LT] = CHECK_CMP_LT,
+        [COND_EXPR_OP_GE] = CHECK_CMP_GE,
+        [COND_EXPR_OP_GT] = CHECK_CMP_GT,
+    };
+
+    /* constant on left compares same as on right, with operands swapped */
+    static const CheckCmp swapped[CHECK_CMP_MAX] = {
+        [CHECK_CMP_EQ] = CHECK_CMP_EQ,
+        [CHECK_CMP_NE] = CHECK_CMP_NE,
+        [CHECK_CMP_LT] = CHECK_CMP_GT,
+        [CHECK_CMP_LE] = CHECK_CMP_GE,
+        [CHECK_CMP_GT] = CHECK_CMP_LT,
+        [CHECK_CMP_GE] = CHECK_CMP_LE,
+    };
+
+    if (e->opnd_type != EXPR_OPND_TYPE_COND_EXPR) {
+        return False;
+    }
+
+    CondExpr* cond = e->cond_expr;
+    if (cond->op == COND_EXPR_OP_AND) {
+        return compiler_check_terms (scope, &cond->left_opnd, table) &&
+               compiler_check_terms (scope, &cond->right_opnd, table);
+    }
+
+    if (cond->op < COND_EXPR_OP_EQ || cond->op > COND_EXPR_OP_GT) {
+        return False;
+    }
+
+    Bool      left  = cond->left_opnd.opnd_type == EXPR_OPND_TYPE_ID;
+    ExprOpnd* id    = left ? &cond->left_opnd : &cond->right_opnd;
+    ExprOpnd* value = left ? &cond->right_opnd : &cond->left_opnd;
+    if (id->opnd_type != EXPR_OPND_TYPE_ID) {
+        return False;
+    }
+
+    Size         off = 0;
+    SchemaField* sf  = compiler_check_field (scope, id->id, &off);
+    if (!sf) {
+        return False;
+    }
+
+    CheckTerm term = {
+        .mem_off = off,
+        .size    = (Uint8)sf->type->size,
+        .cmp     = left ? cmps[cond->op] : swapped[cmps[cond->op]]
+    };
+
+    /* an array is equal to an array literal only if all of it's elements are */
+    if (value->opnd_type == EXPR_OPND_TYPE_ARR) {
+        if (term.cmp != CHECK_CMP_EQ || sf->count != value->arr->count) {
+            return False;
+        }
+
+        for (Size v = 0; v < value->arr->count; v++) {
+            term.mem_off = off + v * sf->type->size;
+            term.value   = value->arr->values[v];
+            if (!check_table_add_term (table, &term)) {
+                return False;
+            }
+        }
+        return True;
+    }
+
+    if (sf->count != 1) {
+        return False;
+    }
+
+    if (value->opnd_type == EXPR_OPND_TYPE_UINT) {
+        term.value = value->unsigned_val;
+    } else if (value->opnd_type == EXPR_OPND_TYPE_INT) {
+        term.value = (Uint64)value->signed_val;
+    } else {
+        return False;
+    }
+
+    return check_table_add_term (table, &term) != Null;
+}
+
+/**
+ * @b Find field of a basic type or enum a field path refers to, if it's always at same
+ * offset in objects of struct, and is loaded in place. Paths through typedefs, arrays,
+ * vectors or lazily loaded fields aren't.
+ *
+ * @param scope
+ * @param path
+ * @param off Where offset of field in object is stored.
+ *
+ * @return Field if found.
+ * @return @c Null otherwise.
+ * */
+PRIVATE SchemaField* compiler_check_field (SchemaScope* scope, CString path, Size* off) {
+    AliasList* aliases = scope->type->decl ? scope->type->decl->aliases : Null;
+    for (AliasListItem* item = aliases ? aliases->head : Null; item; item = item->next) {
+        if (!strcmp (item->data.name, path)) {
+            return Null;
+        }
+    }
+
+    SchemaType* type        = scope->type;
+    Size        field_count = scope->field_count;
+    *off                    = 0;
+    for (;;) {
+        CString      dot = strchr (path, '.');
+        Size         len = dot ? (Size)(dot - path) : strlen (path);
+        SchemaField* sf  = compiler_find_field (type, field_count, path, len);
+        if (!sf || sf->lazy || sf->vec_size) {
+            return Null;
+        }
+
+        *off += sf->mem_off;
+        if (!dot) {
+            Size size = sf->type->size;
+            Bool leaf =
+                sf->type->kind == SCHEMA_TYPE_KIND_BASIC || sf->type->kind == SCHEMA_TYPE_KIND_ENUM;
+            return leaf && (size == 1 || size == 2 || size == 4 || size == 8) ? sf : Null;
+        }
+
+        if (sf->count != 1 || sf->type->kind != SCHEMA_TYPE_KIND_STRUCT) {
+            return Null;
+        }
+
+        type        = sf->type;
+        field_count = type->field_count;
+        path        = dot + 1;
+    }
+}
+
+/**
+ * @b Emit code to load fields of a struct, starting from given field.
+ *
+ * If type of atleast two of these typedef fields is selected by same field loaded before
+ * them, type is selected once by a @c SWITCH, and these fields are emitted again in each
+ * case, with value of type argument known. Each typedef field using it then loads it's
+ * type directly, and so do field paths through them, like @c header.shoff.
+ *
+ * @param c
+ * @param scope Scope of struct being emitted.
+ * @param first Index of first field to be emitted.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_emit_fields (SchemaCompiler* c, SchemaScope* scope, Size first) {
+    SchemaType* type = scope->type;
+
+    for (Size f = first; f < type->field_count; f++) {
+        scope->field_count = f;
+
+        if (!c->known.type && compiler_can_specialize (scope, f)) {
+            SchemaFields rest = {.scope = scope, .first = f};
+            return compiler_switch (c, scope, type->fields + f, compiler_fields_case, &rest, True);
+        }
+
+        RETURN_VALUE_IF (
+            !compiler_emit_field (c, scope, type->fields + f),
+            False,
+            "%s.%s : Failed to compile field\n",
+            type->name,
+            type->fields[f].field->field_name
+        );
+    }
+
+    return True;
+}
+
+/**
+ * @b Emit rest of fields of a specialized struct, for one case.
+ *
+ * @param c
+ * @param type Type selected in this case, already known to compiler.
+ * @param data @c SchemaFields to be emitted.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_fields_case (SchemaCompiler* c, SchemaType* type, void* data) {
+    SchemaFields* rest = data;
+    (void)type;
+
+    return compiler_emit_fields (c, rest->scope, rest->first);
+}
+
+/**
+ * @b Find whether type argument of given field selects type of atleast one more of
+ * the fields after it, and never changes while they're loaded. This is the case
+ * for a field path through fields loaded before it, that is not an alias.
+ *
+ * @return @c True if struct can be specialized at given field.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_can_specialize (SchemaScope* scope, Size f) {
+    SchemaType*  type = scope->type;
+    SchemaField* sf   = type->fields + f;
+
+    if (sf->type->kind != SCHEMA_TYPE_KIND_TYPEDEF ||
+        sf->type_arg->opnd_type != EXPR_OPND_TYPE_ID ||
+        sf->type->case_count > COMPILER_MAX_SPECIALIZE) {
+        return False;
+    }
+
+    CString    arg     = sf->type_arg->id;
+    AliasList* aliases = type->decl ? type->decl->aliases : Null;
+    for (AliasListItem* item = aliases ? aliases->head : Null; item; item = item->next) {
+        if (!strcmp (item->data.name, arg)) {
+            return False;
+        }
+    }
+
+    CString dot = strchr (arg, '.');
+    if (!compiler_find_field (type, f, arg, dot ? (Size)(dot - arg) : strlen (arg))) {
+        return False;
+    }
+
+    Size uses = 0;
+    for (Size g = f; g < type->field_count; g++) {
+        SchemaField* other = type->fields + g;
+        if (other->type->kind == SCHEMA_TYPE_KIND_TYPEDEF &&
+            other->type_arg->opnd_type == EXPR_OPND_TYPE_ID && !strcmp (other->type_arg->id, arg)) {
+            uses++;
+        }
+    }
+
+    return uses >= 2;
+}
+
+/**
+ * @b Emit code to load a field. Number of elements of a vector is computed first, and
+ * a field with an address is loaded from there, restoring stream cursor afterwards.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_emit_field (SchemaCompiler* c, SchemaScope* scope, SchemaField* sf) {
+    if (sf->lazy) {
+        return compiler_emit_lazy (c, scope, sf);
+    }
+
+    SchemaLoad load = {.field = sf, .mem_off = scope->base_off + sf->mem_off};
+    Uint8      rsave = 0;
+
+    if (sf->vec_size) {
+        RETURN_VALUE_IF (
+            !compiler_eval (c, scope, sf->vec_size, &load.count_reg),
+            False,
+            "Failed to compile number of vector elements\n"
+        );
+    }
+
+    if (sf->addr) {
+        Uint8 roff = 0;
+        RETURN_VALUE_IF (
+            !compiler_alloc_reg (c, &rsave) || !compiler_emit (c, TELL (rsave)) ||
+                !compiler_eval (c, scope, &sf->addr->addr.offset, &roff),
+            False,
+            "Failed to compile field address\n"
+        );
+
+        /* a saved cursor is the base for addresses relative to cursor */
+        Uint8 rbase = sf->addr->addr.base == FIELD_ADDR_BASE_CURSOR ? rsave : COMPILER_REG_BASE;
+        Insn  addr  = sf->addr->addr.backward ? SUB (roff, rbase, roff) : ADD (roff, rbase, roff);
+        RETURN_VALUE_IF (
+            !compiler_emit (c, addr) || !compiler_emit (c, SEEK_REG (roff)),
+            False,
+            "Failed to compile field address\n"
+        );
+        compiler_free_reg (c, roff);
+    }
+
+    Bool ok = sf->type->kind == SCHEMA_TYPE_KIND_TYPEDEF ?
+                  compiler_dispatch (c, scope, sf, compiler_load, &load) :
+                  compiler_load (c, sf->type, &load);
+    if (!ok) {
+        return False;
+    }
+
+    if (sf->addr) {
+        if (!compiler_emit (c, SEEK_REG (rsave))) {
+            return False;
+        }
+        compiler_free_reg (c, rsave);
+    }
+
+    if (sf->vec_size) {
+        compiler_free_reg (c, load.count_reg);
+    }
+
+    return True;
+}
+
+/**
+ * @b Emit code to load a field as given type. For typedef fields this is
+ * called for each case.
+ *
+ * @param c
+ * @param type Type field is loaded as.
+ * @param data @c SchemaLoad describing field.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_load (SchemaCompiler* c, SchemaType* type, void* data) {
+    SchemaLoad*  load = data;
+    SchemaField* sf   = load->field;
+    Size         sel  = 0;
+
+    switch (type->kind) {
+        case SCHEMA_TYPE_KIND_BASIC :
+        case SCHEMA_TYPE_KIND_ENUM : {
+            if (sf->vec_size) {
+                Loader* elem = compiler_basic_loader (c, c->basics + type->basic);
+                return elem && compiler_ref (c, elem, &sel) &&
+                       compiler_emit (c, CALL_VEC (sel, load->count_reg, load->mem_off));
+            }
+
+            if (sf->count == 1) {
+                return compiler_emit_sized (c, READ_MEM8 (load->mem_off), type->size);
+            }
+
+            return compiler_emit_sized (c, READ_ARR8 (load->mem_off, sf->count), type->size);
+        }
+
+        case SCHEMA_TYPE_KIND_STRUCT : {
+            /* plain structs are copied in place, without calling their loader */
+            if (type->is_plain && !sf->vec_size) {
+                Size id = 0;
+                if (!compiler_add_layout (c, type, &id)) {
+                    return False;
+                }
+
+                if (sf->count == 1) {
+                    return compiler_emit (c, READ_STRUCT (load->mem_off, id));
+                }
+
+                return compiler_emit (
+                    c,
+                    READ_STRUCT_ARR (load->mem_off, id, sf->count, type->size)
+                );
+            }
+
+            if (!compiler_ref (c, type->loader, &sel)) {
+                return False;
+            }
+
+            if (sf->vec_size) {
+                return compiler_emit (c, CALL_VEC (sel, load->count_reg, load->mem_off));
+            }
+
+            if (!compiler_emit (c, SET_REG (COMPILER_REG_OFF, load->mem_off))) {
+                return False;
+            }
+
+            if (sf->count == 1) {
+                return compiler_emit (c, CALL (sel));
+            }
+
+            Uint8 rcount = 0;
+            Bool  ok     = compiler_alloc_reg (c, &rcount) &&
+                      compiler_emit (c, SET_REG (rcount, sf->count)) &&
+                      compiler_emit (c, CALL_ARR (sel, rcount, type->size));
+            compiler_free_reg (c, rcount);
+            return ok;
+        }
+
+        default :
+            RETURN_VALUE_IF_REACHED (False, "Typedef \"%s\" can't be loaded directly\n", type->name);
+    }
+}
+
+/**
+ * @b Emit code to fill @c SchemaLazy of a field with an address, without reading the
+ * field. Type of a typedef field is selected now, since it's type argument may not be
+ * available when field is accessed.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_emit_lazy (SchemaCompiler* c, SchemaScope* scope, SchemaField* sf) {
+    SchemaLoad load  = {.field = sf, .mem_off = scope->base_off + sf->mem_off};
+    Uint8      rbase = COMPILER_REG_BASE;
+    Uint8      roff  = 0;
+    Uint8      rcnt  = 0;
+
+    /* current cursor is the base for addresses relative to cursor */
+    if (sf->addr->addr.base == FIELD_ADDR_BASE_CURSOR) {
+        RETURN_VALUE_IF (
+            !compiler_alloc_reg (c, &rbase) || !compiler_emit (c, TELL (rbase)),
+            False,
+            "Failed to compile field address\n"
+        );
+    }
+
+    Bool ok = compiler_eval (c, scope, &sf->addr->addr.offset, &roff) &&
+              compiler_emit (
+                  c,
+                  sf->addr->addr.backward ? SUB (roff, rbase, roff) : ADD (roff, rbase, roff)
+              ) &&
+              compiler_store (c, roff, load.mem_off + offsetof (SchemaLazy, offset));
+    compiler_free_reg (c, roff);
+    if (rbase != COMPILER_REG_BASE) {
+        compiler_free_reg (c, rbase);
+    }
+    RETURN_VALUE_IF (!ok, False, "Failed to compile field address\n");
+
+    ok = sf->vec_size ? compiler_eval (c, scope, sf->vec_size, &rcnt) :
+                        compiler_alloc_reg (c, &rcnt) &&
+                            compiler_emit (c, SET_REG (rcnt, sf->count));
+    ok = ok && compiler_store (c, rcnt, load.mem_off + offsetof (SchemaLazy, count));
+    compiler_free_reg (c, rcnt);
+    RETURN_VALUE_IF (!ok, False, "Failed to compile number of elements\n");
+
+    return sf->type->kind == SCHEMA_TYPE_KIND_TYPEDEF ?
+               compiler_dispatch (c, scope, sf, compiler_lazy_case, &load) :
+               compiler_lazy_case (c, sf->type, &load);
+}
+
+/**
+ * @b Emit code to store loader and stride of elements of a lazy field loaded as
+ * given type. For typedef fields this is called for each case.
+ *
+ * @param c
+ * @param type Type elements of field are loaded as.
+ * @param data @c SchemaLoad describing field.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_lazy_case (SchemaCompiler* c, SchemaType* type, void* data) {
+    SchemaLoad* load   = data;
+    Loader*     loader = type->kind == SCHEMA_TYPE_KIND_STRUCT ?
+                             type->loader :
+                             compiler_basic_loader (c, c->basics + type->basic);
+    if (!loader) {
+        return False;
+    }
+
+    Size index = 0;
+    while (c->schema->loaders[index] != loader) {
+        index++;
+    }
+
+    Uint8 reg = 0;
+    Bool  ok  = compiler_alloc_reg (c, &reg) &&
+              compiler_emit (c, SET_REG (reg, compiler_stream_size (type))) &&
+              compiler_store (c, reg, load->mem_off + offsetof (SchemaLazy, stride)) &&
+              compiler_emit (c, SET_REG (reg, index)) &&
+              compiler_store (c, reg, load->mem_off + offsetof (SchemaLazy, loader));
+    compiler_free_reg (c, reg);
+
+    return ok;
+}
+
+/**
+ * @b Emit code to store value of a register to memory, through the stack.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_store (SchemaCompiler* c, Uint8 reg, Size mem_off) {
+    return compiler_emit (c, PUSH_REG64 (reg)) && compiler_emit (c, POP_MEM64 (mem_off));
+}
+
+/**
+ * @b Emit code to select type of a typedef field by value of it's type argument,
+ * and to call @c case_fn for each type it can select. If value of type argument is
+ * known while compiling, only the selected type is emitted. Otherwise code of each
+ * type is emitted in it's own blocks, jumped to by a @c SWITCH, and all of them continue
+ * from a common block afterwards. If no case matches, loader fails.
+ *
+ * @param c
+ * @param scope Scope field is declared in.
+ * @param sf Typedef field.
+ * @param case_fn Emits code for each case.
+ * @param data Passed to @c case_fn.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_dispatch (
+    SchemaCompiler* c,
+    SchemaScope*    scope,
+    SchemaField*    sf,
+    SchemaCaseFn    case_fn,
+    void*           data
+) {
+    SchemaCase* known = compiler_known_case (c, scope, sf);
+    if (known) {
+        return case_fn (c, known->type, data);
+    }
+
+    return compiler_switch (c, scope, sf, case_fn, data, False);
+}
+
+/**
+ * @b Emit a @c SWITCH on type argument of a typedef field, and code of each of
+ * it's cases.
+ *
+ * Cases selecting same type share their code, unless struct is being specialized,
+ * in which case value of type argument is known to be in range of the case while
+ * it's code is emitted.
+ *
+ * @param c
+ * @param scope Scope field is declared in.
+ * @param sf Typedef field.
+ * @param case_fn Emits code for each case.
+ * @param data Passed to @c case_fn.
+ * @param specialize Whether range of each case is known while emitting it.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_switch (
+    SchemaCompiler* c,
+    SchemaScope*    scope,
+    SchemaField*    sf,
+    SchemaCaseFn    case_fn,
+    void*           data,
+    Bool            specialize
+) {
+    SchemaType* tdef = sf->type;
+    CString     msg  = compiler_msg (
+        c,
+        "%s.%s : Value of type argument matches no case of \"%s\"",
+        scope->type->name,
+        sf->field->field_name,
+        tdef->name
+    );
+    RETURN_VALUE_IF (!msg, False, ERR_OUT_OF_MEMORY);
+
+    Size         count  = MAX (tdef->case_count, 1);
+    Size*        blocks = ALLOCATE (Size, count);
+    SchemaPatch* joins  = ALLOCATE (SchemaPatch, count);
+    if (!blocks || !joins) {
+        PRINT_ERR (ERR_OUT_OF_MEMORY);
+        if (blocks) {
+            FREE (blocks);
+        }
+        if (joins) {
+            FREE (joins);
+        }
+        return False;
+    }
+
+    SchemaPatch table      = {0};
+    Size        join_count = 0;
+    Uint8       rsel       = 0;
+    Bool        ok         = compiler_eval (c, scope, sf->type_arg, &rsel) &&
+                compiler_emit_jump (c, SWITCH (rsel, 0), &table);
+    compiler_free_reg (c, rsel);
+
+    ok = ok && compiler_emit (c, PERR (msg)) && compiler_emit (c, EXIT (FAILURE));
+
+    for (Size k = 0; ok && k < tdef->case_count; k++) {
+        SchemaCase* tcase = tdef->cases + k;
+
+        Size same = 0;
+        while (!specialize && same < k && tdef->cases[same].type != tcase->type) {
+            same++;
+        }
+        if (!specialize && same < k) {
+            blocks[k] = blocks[same];
+            continue;
+        }
+
+        ok = compiler_new_block (c);
+        if (!ok) {
+            break;
+        }
+        blocks[k] = c->block;
+
+        if (specialize) {
+            c->known = (SchemaKnown) {
+                .type     = scope->type,
+                .base_off = scope->base_off,
+                .arg      = sf->type_arg->id,
+                .first    = tcase->first,
+                .last     = tcase->last,
+            };
+        }
+
+        ok = case_fn (c, tcase->type, data) && compiler_emit_goto (c, joins + join_count++);
+        c->known = (SchemaKnown) {0};
+    }
+
+    ok = ok && compiler_new_block (c);
+    for (Size j = 0; ok && j < join_count; j++) {
+        compiler_patch (c, joins + j, c->block);
+    }
+
+    ok = ok && compiler_add_switch (c, &table, tdef->cases, blocks, tdef->case_count);
+
+    FREE (blocks);
+    FREE (joins);
+    return ok;
+}
+
+/**
+ * @b Find case of typedef field, selected by value of it's type argument, if that
+ * value is known while compiling. Value is known if type argument is constant, or
+ * if it's type argument of struct being specialized.
+ *
+ * @return Case that is always selected, if there is one.
+ * @return @c Null otherwise.
+ * */
+PRIVATE SchemaCase* compiler_known_case (SchemaCompiler* c, SchemaScope* scope, SchemaField* sf) {
+    ExprOpnd* arg   = sf->type_arg;
+    Uint64    first = 0;
+    Uint64    last  = 0;
+
+    if (compiler_is_const (arg)) {
+        first = last = arg->opnd_type == EXPR_OPND_TYPE_INT ? (Uint64)arg->signed_val :
+                                                             arg->unsigned_val;
+    } else if (c->known.type && c->known.type == scope->type &&
+               c->known.base_off == scope->base_off && arg->opnd_type == EXPR_OPND_TYPE_ID &&
+               !strcmp (arg->id, c->known.arg)) {
+        first = c->known.first;
+        last  = c->known.last;
+    } else {
+        return Null;
+    }
+
+    /* first case with any value in range decides, it must cover the whole range */
+    for (Size k = 0; k < sf->type->case_count; k++) {
+        SchemaCase* tcase = sf->type->cases + k;
+        if (tcase->last < first || tcase->first > last) {
+            continue;
+        }
+
+        return tcase->first <= first && tcase->last >= last ? tcase : Null;
+    }
+
+    return Null;
+}
+
+/**
+ * @b Add jump table of a @c SWITCH emitted before to loader being emitted.
+ *
+ * @param c
+ * @param patch Location of @c SWITCH.
+ * @param cases Cases of typedef, in order of priority.
+ * @param blocks Block each case jumps to.
+ * @param count Number of cases.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_add_switch (
+    SchemaCompiler* c,
+    SchemaPatch*    patch,
+    SchemaCase*     cases,
+    Size*           blocks,
+    Size            count
+) {
+    SwitchCase* scases = ALLOCATE (SwitchCase, MAX (count, 1));
+    RETURN_VALUE_IF (!scases, False, ERR_OUT_OF_MEMORY);
+
+    for (Size k = 0; k < count; k++) {
+        scases[k] = (SwitchCase) {cases[k].first, cases[k].last, blocks[k]};
+    }
+
+    SwitchTable table = {0};
+    Size        id    = 0;
+    Bool        ok    = !!switch_table_init (&table, scases, count);
+    FREE (scases);
+
+    if (ok && !loader_add_switch_table (c->loader, &table, &id)) {
+        switch_table_deinit (&table);
+        ok = False;
+    }
+    RETURN_VALUE_IF (!ok, False, "Failed to create jump table\n");
+
+    c->loader->insn_blocks[patch->block].insns[patch->insn].insn.switch_table.table_id = id;
+    return True;
+}
+
+/**
+ * @b Emit code to evaluate an expression into a newly allocated register.
+ *
+ * @param c
+ * @param scope Scope names in expression are looked up in.
+ * @param e Expression.
+ * @param reg Register holding result, to be freed by caller.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_eval (SchemaCompiler* c, SchemaScope* scope, ExprOpnd* e, Uint8* reg) {
+    switch (e->opnd_type) {
+        case EXPR_OPND_TYPE_UINT :
+            return compiler_alloc_reg (c, reg) && compiler_emit (c, SET_REG (*reg, e->unsigned_val));
+
+        case EXPR_OPND_TYPE_INT :
+            return compiler_alloc_reg (c, reg) &&
+                   compiler_emit (c, SET_REG (*reg, (Uint64)e->signed_val));
+
+        case EXPR_OPND_TYPE_ID :
+            return compiler_eval_id (c, scope, e->id, reg);
+
+        case EXPR_OPND_TYPE_ARITH_EXPR :
+            return compiler_eval_arith (c, scope, e->arith_expr, reg);
+
+        case EXPR_OPND_TYPE_COND_EXPR :
+            return compiler_eval_cond (c, scope, e->cond_expr, reg);
+
+        case EXPR_OPND_TYPE_ARR :
+            RETURN_VALUE_IF_REACHED (False, "Arrays can only be compared with array fields\n");
+
+        default :
+            RETURN_VALUE_IF_REACHED (False, "Unsupported expression operand\n");
+    }
+}
+
+/**
+ * @b Emit code to evaluate a name. A name is an alias, a path to a field loaded
+ * before, or an enum member, looked up in that order.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool
+    compiler_eval_id (SchemaCompiler* c, SchemaScope* scope, CString id, Uint8* reg) {
+    AliasList* aliases = scope->type->decl ? scope->type->decl->aliases : Null;
+    for (AliasListItem* item = aliases ? aliases->head : Null; item; item = item->next) {
+        if (strcmp (item->data.name, id)) {
+            continue;
+        }
+
+        RETURN_VALUE_IF (
+            scope->alias_depth >= COMPILER_MAX_ALIAS_USE,
+            False,
+            "%s : Alias \"%s\" refers to itself\n",
+            scope->type->name,
+            id
+        );
+
+        scope->alias_depth++;
+        Bool ok = compiler_eval (c, scope, &item->data.expr, reg);
+        scope->alias_depth--;
+        return ok;
+    }
+
+    CString dot = strchr (id, '.');
+    Size    len = dot ? (Size)(dot - id) : strlen (id);
+    if (compiler_find_field (scope->type, scope->field_count, id, len)) {
+        if (!compiler_alloc_reg (c, reg)) {
+            return False;
+        }
+
+        SchemaPath path = {.scope = *scope, .path = id, .reg = *reg};
+        return compiler_path (c, &path);
+    }
+
+    EnumMember* member = compiler_map_find (&c->enum_map, id, strlen (id));
+    RETURN_VALUE_IF (
+        !member,
+        False,
+        "%s : \"%s\" is not an alias, a field loaded before or an enum member\n",
+        scope->type->name,
+        id
+    );
+
+    return compiler_alloc_reg (c, reg) && compiler_emit (c, SET_REG (*reg, member->first));
+}
+
+/**
+ * @b Emit code to evaluate an arithmetic or bitwise expression.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_eval_arith (
+    SchemaCompiler* c,
+    SchemaScope*    scope,
+    ArithExpr*      e,
+    Uint8*          reg
+) {
+    static const InsnType ops[ARITH_EXPR_OP_MAX] = {
+        [ARITH_EXPR_OP_ADD]    = INSN_TYPE_ADD,
+        [ARITH_EXPR_OP_SUB]    = INSN_TYPE_SUB,
+        [ARITH_EXPR_OP_MUL]    = INSN_TYPE_MUL,
+        [ARITH_EXPR_OP_DIV]    = INSN_TYPE_DIV,
+        [ARITH_EXPR_OP_MOD]    = INSN_TYPE_MOD,
+        [ARITH_EXPR_OP_AND]    = INSN_TYPE_AND,
+        [ARITH_EXPR_OP_OR]     = INSN_TYPE_OR,
+        [ARITH_EXPR_OP_XOR]    = INSN_TYPE_XOR,
+        [ARITH_EXPR_OP_LSHIFT] = INSN_TYPE_LSHIFT,
+        [ARITH_EXPR_OP_RSHIFT] = INSN_TYPE_RSHIFT,
+    };
+
+    RETURN_VALUE_IF (
+        e->op == ARITH_EXPR_OP_INVALID || e->op >= ARITH_EXPR_OP_MAX ||
+            (e->op != ARITH_EXPR_OP_INV && !ops[e->op]),
+        False,
+        "Floating point expressions are not supported yet\n"
+    );
+
+    Uint8 rhs = 0;
+    if (!compiler_eval (c, scope, &e->left_opnd, reg)) {
+        return False;
+    }
+
+    /* complement is xor with all bits set */
+    if (e->op == ARITH_EXPR_OP_INV) {
+        Bool ok = compiler_alloc_reg (c, &rhs) && compiler_emit (c, SET_REG (rhs, UINT64_MAX)) &&
+                  compiler_emit (c, XOR (*reg, *reg, rhs));
+        compiler_free_reg (c, rhs);
+        return ok;
+    }
+
+    if (!compiler_eval (c, scope, &e->right_opnd, &rhs)) {
+        return False;
+    }
+    Bool ok = compiler_emit (c, BINOP (ops[e->op], *reg, *reg, rhs));
+    compiler_free_reg (c, rhs);
+
+    return ok;
+}
+
+/**
+ * @b Emit code to evaluate a comparison or a logical expression, to 1 if it's true
+ * and 0 otherwise. An array field compared with an array literal is compared
+ * element by element.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_eval_cond (
+    SchemaCompiler* c,
+    SchemaScope*    scope,
+    CondExpr*       e,
+    Uint8*          reg
+) {
+    ExprOpnd* left  = &e->left_opnd;
+    ExprOpnd* right = &e->right_opnd;
+
+    if (left->opnd_type == EXPR_OPND_TYPE_ARR || right->opnd_type == EXPR_OPND_TYPE_ARR) {
+        ExprOpnd* arr   = left->opnd_type == EXPR_OPND_TYPE_ARR ? left : right;
+        ExprOpnd* field = arr == left ? right : left;
+        RETURN_VALUE_IF (
+            (e->op != COND_EXPR_OP_EQ && e->op != COND_EXPR_OP_NE) ||
+                field->opnd_type != EXPR_OPND_TYPE_ID,
+            False,
+            "%s : Arrays can only be compared for equality with array fields\n",
+            scope->type->name
+        );
+
+        if (!compiler_alloc_reg (c, reg)) {
+            return False;
+        }
+        SchemaPath path = {.scope = *scope, .path = field->id, .reg = *reg, .cmp = arr->arr};
+        return compiler_path (c, &path) && compiler_bool (c, *reg, e->op == COND_EXPR_OP_NE);
+    }
+
+    if (!compiler_eval (c, scope, left, reg)) {
+        return False;
+    }
+
+    if (e->op == COND_EXPR_OP_NOT) {
+        return compiler_bool (c, *reg, True);
+    }
+
+    Uint8 rhs = 0;
+    if (!compiler_eval (c, scope, right, &rhs)) {
+        return False;
+    }
+
+    Bool ok = True;
+    switch (e->op) {
+        case COND_EXPR_OP_EQ :
+            ok = compiler_emit (c, CMPEQ (*reg, *reg, rhs));
+            break;
+        case COND_EXPR_OP_NE :
+            ok = compiler_emit (c, CMPEQ (*reg, *reg, rhs)) && compiler_bool (c, *reg, True);
+            break;
+        case COND_EXPR_OP_LE :
+            ok = compiler_emit (c, CMPLE (*reg, *reg, rhs));
+            break;
+        case COND_EXPR_OP_LT :
+            ok = compiler_emit (c, CMPLT (*reg, *reg, rhs));
+            break;
+        case COND_EXPR_OP_GE :
+            ok = compiler_emit (c, CMPGE (*reg, *reg, rhs));
+            break;
+        case COND_EXPR_OP_GT :
+            ok = compiler_emit (c, CMPGT (*reg, *reg, rhs));
+            break;
+        case COND_EXPR_OP_AND :
+            ok = compiler_bool (c, *reg, False) && compiler_bool (c, rhs, False) &&
+                 compiler_emit (c, AND (*reg, *reg, rhs));
+            break;
+        case COND_EXPR_OP_OR :
+            ok = compiler_emit (c, OR (*reg, *reg, rhs)) && compiler_bool (c, *reg, False);
+            break;
+        default :
+            ok = False;
+            PRINT_ERR ("Invalid conditional expression\n");
+            break;
+    }
+
+    compiler_free_reg (c, rhs);
+    return ok;
+}
+
+/**
+ * @b Emit code to load value of a field path, or to compare an array field with an
+ * array literal. Paths through a typedef field select the case first.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_path (SchemaCompiler* c, SchemaPath* path) {
+    SchemaScope* scope = &path->scope;
+    CString      dot   = strchr (path->path, '.');
+    Size         len   = dot ? (Size)(dot - path->path) : strlen (path->path);
+    SchemaField* sf    = compiler_find_field (scope->type, scope->field_count, path->path, len);
+    RETURN_VALUE_IF (
+        !sf,
+        False,
+        "%s : No field \"%.*s\" loaded before\n",
+        scope->type->name,
+        (int)len,
+        path->path
+    );
+
+    RETURN_VALUE_IF (
+        sf->lazy,
+        False,
+        "%s.%s : Field is loaded lazily, it can't be used in expressions\n",
+        scope->type->name,
+        sf->field->field_name
+    );
+
+    Size off = scope->base_off + sf->mem_off;
+    if (dot) {
+        RETURN_VALUE_IF (
+            sf->vec_size || sf->count != 1,
+            False,
+            "%s.%s : Members of elements of arrays can't be accessed\n",
+            scope->type->name,
+            sf->field->field_name
+        );
+
+        SchemaPath next = {
+            .scope = {.type = sf->type, .base_off = off},
+            .path  = dot + 1,
+            .reg   = path->reg,
+            .cmp   = path->cmp
+        };
+
+        if (sf->type->kind == SCHEMA_TYPE_KIND_TYPEDEF) {
+            return compiler_dispatch (c, scope, sf, compiler_path_case, &next);
+        }
+
+        return compiler_path_case (c, sf->type, &next);
+    }
+
+    SchemaType* type = sf->type;
+    RETURN_VALUE_IF (
+        type->kind != SCHEMA_TYPE_KIND_BASIC && type->kind != SCHEMA_TYPE_KIND_ENUM,
+        False,
+        "%s.%s : Only values of basic types and enums can be used in expressions\n",
+        scope->type->name,
+        sf->field->field_name
+    );
+
+    if (!path->cmp) {
+        RETURN_VALUE_IF (
+            sf->vec_size || sf->count != 1,
+            False,
+            "%s.%s : Arrays can only be compared with arrays\n",
+            scope->type->name,
+            sf->field->field_name
+        );
+
+        return compiler_emit_sized (c, PUSH_MEM8 (off), type->size) &&
+               compiler_emit_sized (c, POP_REG8 (path->reg), type->size);
+    }
+
+    RETURN_VALUE_IF (
+        sf->vec_size || sf->count != path->cmp->count,
+        False,
+        "%s.%s : Field is not an array of %zu elements\n",
+        scope->type->name,
+        sf->field->field_name,
+        path->cmp->count
+    );
+
+    /* reg is 1 while all elements compared so far are equal */
+    Uint8 relem = 0;
+    Uint8 rval  = 0;
+    Bool  ok    = compiler_emit (c, SET_REG (path->reg, 1)) && compiler_alloc_reg (c, &relem) &&
+              compiler_alloc_reg (c, &rval);
+    for (Size e = 0; ok && e < path->cmp->count; e++) {
+        ok = compiler_emit_sized (c, PUSH_MEM8 (off + e * type->size), type->size) &&
+             compiler_emit_sized (c, POP_REG8 (relem), type->size) &&
+             compiler_emit (c, SET_REG (rval, path->cmp->values[e])) &&
+             compiler_emit (c, CMPEQ (relem, relem, rval)) &&
+             compiler_emit (c, AND (path->reg, path->reg, relem));
+    }
+    compiler_free_reg (c, relem);
+    compiler_free_reg (c, rval);
+
+    return ok;
+}
+
+/**
+ * @b Continue a field path inside given struct type.
+ *
+ * @param c
+ * @param type Type of field path went through.
+ * @param data @c SchemaPath with remaining path.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_path_case (SchemaCompiler* c, SchemaType* type, void* data) {
+    RETURN_VALUE_IF (
+        type->kind != SCHEMA_TYPE_KIND_STRUCT,
+        False,
+        "\"%s\" is not a struct, it has no members\n",
+        type->name
+    );
+
+    SchemaPath next        = *(SchemaPath*)data;
+    next.scope.type        = type;
+    next.scope.field_count = type->field_count;
+    next.scope.alias_depth = 0;
+
+    return compiler_path (c, &next);
+}
+
+/**
+ * @b Find one of first @c field_count fields of a struct by name.
+ *
+ * @param type
+ * @param field_count
+ * @param name
+ * @param len Length of name, @c SIZE_MAX if null terminated.
+ *
+ * @return Field if found.
+ * @return @c Null otherwise.
+ * */
+PRIVATE SchemaField*
+    compiler_find_field (SchemaType* type, Size field_count, CString name, Size len) {
+    if (len == SIZE_MAX) {
+        len = strlen (name);
+    }
+
+    for (Size f = 0; f < field_count; f++) {
+        CString field_name = type->fields[f].field->field_name;
+        if (!strncmp (field_name, name, len) && !field_name[len]) {
+            return type->fields + f;
+        }
+    }
+
+    return Null;
+}
+
+/**
+ * @b Emit code to convert value in register to 1 if it's non zero and to 0 otherwise,
+ * or the opposite when negating.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_bool (SchemaCompiler* c, Uint8 reg, Bool negate) {
+    Uint8 rzero = 0;
+    Bool  ok    = compiler_alloc_reg (c, &rzero) && compiler_emit (c, SET_REG (rzero, 0)) &&
+              compiler_emit (c, negate ? CMPEQ (reg, reg, rzero) : CMPGT (reg, reg, rzero));
+    compiler_free_reg (c, rzero);
+    return ok;
+}
+
+/**
+ * @b Allocate a temporary register.
+ *
+ * @return @c True on success.
+ * @return @c False if all registers are in use.
+ * */
+PRIVATE Bool compiler_alloc_reg (SchemaCompiler* c, Uint8* reg) {
+    RETURN_VALUE_IF (
+        !c->free_regs,
+        False,
+        "%s : Expression is too complex, ran out of registers\n",
+        c->loader->type_name
+    );
+
+    *reg          = (Uint8)__builtin_ctz (c->free_regs);
+    c->free_regs &= ~(1u << *reg);
+    return True;
+}
+
+/**
+ * @b Free a temporary register. Freeing register @c 0 does nothing, so registers
+ * that were never allocated can be freed.
+ * */
+PRIVATE void compiler_free_reg (SchemaCompiler* c, Uint8 reg) {
+    if (reg) {
+        c->free_regs |= (1u << reg) & COMPILER_TEMP_REGS;
+    }
+}
+
+/**
+ * @b Append instruction to block being emitted.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_emit (SchemaCompiler* c, Insn insn) {
+    return !!insn_block_add_insn (c->loader->insn_blocks + c->block, &insn);
+}
+
+/**
+ * @b Append variant of an 8 bit instruction for elements of given size. Variants
+ * for 8, 16, 32 and 64 bits are declared one after another.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_emit_sized (SchemaCompiler* c, Insn insn, Size size) {
+    switch (size) {
+        case 1 :
+            break;
+        case 2 :
+            insn.insn_type += 1;
+            break;
+        case 4 :
+            insn.insn_type += 2;
+            break;
+        case 8 :
+            insn.insn_type += 3;
+            break;
+        default :
+            RETURN_VALUE_IF_REACHED (False, "Invalid element size %zu\n", size);
+    }
+
+    return compiler_emit (c, insn);
+}
+
+/**
+ * @b Append a jump whose target is patched later, and start a new block after it.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_emit_jump (SchemaCompiler* c, Insn insn, SchemaPatch* patch) {
+    RETURN_VALUE_IF (!compiler_emit (c, insn), False, ERR_OUT_OF_MEMORY);
+
+    patch->block = c->block;
+    patch->insn  = c->loader->insn_blocks[c->block].insn_count - 1;
+
+    return compiler_new_block (c);
+}
+
+/**
+ * @b Append an unconditional jump whose target is patched later.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_emit_goto (SchemaCompiler* c, SchemaPatch* patch) {
+    Uint8 reg = 0;
+    Bool  ok  = compiler_alloc_reg (c, &reg) && compiler_emit (c, SET_REG (reg, 0)) &&
+              compiler_emit_jump (c, JZ (reg, 0), patch);
+    compiler_free_reg (c, reg);
+    return ok;
+}
+
+/**
+ * @b Set target of a jump emitted before.
+ * */
+PRIVATE void compiler_patch (SchemaCompiler* c, SchemaPatch* patch, Size target) {
+    Insn* insn = c->loader->insn_blocks[patch->block].insns + patch->insn;
+    if (insn->insn_type == INSN_TYPE_CHECK) {
+        insn->insn.check.block_sel = target;
+    } else {
+        insn->insn.jmp.block_sel = target;
+    }
+}
+
+/**
+ * @b Start a new block, unless block being emitted is still empty.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_new_block (SchemaCompiler* c) {
+    Loader* loader = c->loader;
+    if (loader->insn_block_count && !loader->insn_blocks[c->block].insn_count) {
+        return True;
+    }
+
+    if (loader->insn_block_count >= loader->insn_block_capacity) {
+        Size       capacity = loader->insn_block_capacity ? loader->insn_block_capacity * 2 : 8;
+        InsnBlock* blocks   = REALLOCATE (loader->insn_blocks, InsnBlock, capacity);
+        RETURN_VALUE_IF (!blocks, False, ERR_OUT_OF_MEMORY);
+
+        loader->insn_blocks         = blocks;
+        loader->insn_block_capacity = capacity;
+    }
+
+    RETURN_VALUE_IF (
+        !insn_block_init (loader->insn_blocks + loader->insn_block_count),
+        False,
+        ERR_OBJECT_INITIALIZATION_FAILED
+    );
+
+    c->block = loader->insn_block_count++;
+    return True;
+}
+
+/**
+ * @b Get selector of a loader called by loader being emitted, adding a
+ * reference to it if there isn't one.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_ref (SchemaCompiler* c, Loader* callee, Size* sel) {
+    Loader* loader = c->loader;
+    for (Size r = 0; r < loader->loader_ref_count; r++) {
+        if (loader->loader_refs[r] == callee) {
+            *sel = r;
+            return True;
+        }
+    }
+
+    if (loader->loader_ref_count >= loader->loader_ref_capacity) {
+        Size     capacity = loader->loader_ref_capacity ? loader->loader_ref_capacity * 2 : 4;
+        Loader** refs     = REALLOCATE (loader->loader_refs, Loader*, capacity);
+        RETURN_VALUE_IF (!refs, False, ERR_OUT_OF_MEMORY);
+
+        loader->loader_refs         = refs;
+        loader->loader_ref_capacity = capacity;
+    }
+
+    *sel                                          = loader->loader_ref_count;
+    loader->loader_refs[loader->loader_ref_count++] = callee;
+    return True;
+}
+
+/**
+ * @b Get id of layout of a POD-fixed struct in loader being emitted, adding a copy
+ * of it if loader doesn't have one yet.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_add_layout (SchemaCompiler* c, SchemaType* type, Size* id) {
+    Loader*       loader = c->loader;
+    StructLayout* pod    = &type->pod_layout;
+
+    for (Size l = 0; l < loader->struct_layout_count; l++) {
+        StructLayout* layout = loader->struct_layouts + l;
+        Bool          same   = layout->field_count == pod->field_count &&
+                    layout->mem_size == pod->mem_size && layout->stream_size == pod->stream_size;
+
+        for (Size f = 0; same && f < pod->field_count; f++) {
+            StructLayoutField* x = layout->fields + f;
+            StructLayoutField* y = pod->fields + f;
+            same = x->mem_off == y->mem_off && x->stream_off == y->stream_off &&
+                   x->size == y->size && x->count == y->count && x->swap == y->swap;
+        }
+
+        if (same) {
+            *id = l;
+            return True;
+        }
+    }
+
+    StructLayout copy = *pod;
+    copy.fields       = ALLOCATE (StructLayoutField, MAX (pod->field_count, 1));
+    RETURN_VALUE_IF (!copy.fields, False, ERR_OUT_OF_MEMORY);
+    memcpy (copy.fields, pod->fields, pod->field_count * sizeof (StructLayoutField));
+
+    if (!loader_add_struct_layout (loader, &copy, id)) {
+        struct_layout_deinit (&copy);
+        RETURN_VALUE_IF_REACHED (False, "Failed to add struct layout\n");
+    }
+
+    return True;
+}
+
+/**
+ * @b Add a loader to schema, after all loaders added before.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_add_loader (SchemaCompiler* c, Loader* loader) {
+    Schema* schema = c->schema;
+    if (schema->loader_count >= schema->loader_capacity) {
+        Size     capacity = schema->loader_capacity ? schema->loader_capacity * 2 : 16;
+        Loader** loaders  = REALLOCATE (schema->loaders, Loader*, capacity);
+        RETURN_VALUE_IF (!loaders, False, ERR_OUT_OF_MEMORY);
+
+        schema->loaders         = loaders;
+        schema->loader_capacity = capacity;
+    }
+
+    schema->loaders[schema->loader_count++] = loader;
+    return True;
+}
+
+/**
+ * @b Create a new empty loader owned by schema.
+ *
+ * @return Loader on success.
+ * @return @c Null otherwise.
+ * */
+PRIVATE Loader* compiler_new_loader (SchemaCompiler* c, CString name, CString doc) {
+    Loader* loader = NEW (Loader);
+    RETURN_VALUE_IF (!loader, Null, ERR_OUT_OF_MEMORY);
+
+    loader->type_name = name;
+    loader->type_doc  = doc;
+    if (!compiler_add_loader (c, loader)) {
+        FREE (loader);
+        return Null;
+    }
+
+    return loader;
+}
+
+/**
+ * @b Get loader of a single element of a basic type, for vectors of that type.
+ * Loader is created when it's first needed.
+ *
+ * @return Loader on success.
+ * @return @c Null otherwise.
+ * */
+PRIVATE Loader* compiler_basic_loader (SchemaCompiler* c, SchemaType* type) {
+    if (type->loader) {
+        return type->loader;
+    }
+
+    Loader* loader = compiler_new_loader (c, type->name, Null);
+    RETURN_VALUE_IF (!loader, Null, "Failed to create type loader\n");
+    loader->alloc_size = type->size;
+
+    /* emit to new loader, and then continue with the one being emitted */
+    Loader* caller = c->loader;
+    Size    block  = c->block;
+
+    c->loader = loader;
+    Bool ok   = compiler_new_block (c) && compiler_emit_sized (c, READ_MEM8 (0), type->size) &&
+              compiler_emit (c, EXIT (SUCCESS));
+
+    c->loader = caller;
+    c->block  = block;
+    RETURN_VALUE_IF (!ok, Null, "Failed to compile loader of \"%s\"\n", type->name);
+
+    type->loader = loader;
+    return loader;
+}
+
+/**
+ * @b Format a message printed by a compiled loader. Message is owned by schema.
+ *
+ * @return Message on success.
+ * @return @c Null otherwise.
+ * */
+PRIVATE CString compiler_msg (SchemaCompiler* c, CString fmt, ...) {
+    Schema* schema = c->schema;
+    if (!compiler_reserve_msgs (schema, schema->msg_count + 1)) {
+        return Null;
+    }
+
+    va_list args;
+    va_start (args, fmt);
+    int len = vsnprintf (Null, 0, fmt, args);
+    va_end (args);
+    RETURN_VALUE_IF (len < 0, Null, "Failed to format message\n");
+
+    Char* msg = ALLOCATE (Char, (Size)len + 1);
+    RETURN_VALUE_IF (!msg, Null, ERR_OUT_OF_MEMORY);
+
+    va_start (args, fmt);
+    vsnprintf (msg, (Size)len + 1, fmt, args);
+    va_end (args);
+
+    schema->msgs[schema->msg_count++] = msg;
+    return msg;
+}
+
+/**
+ * @b Make space for atleast given number of messages in schema.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_reserve_msgs (Schema* schema, Size count) {
+    if (count <= schema->msg_capacity) {
+        return True;
+    }
+
+    Size   capacity = MAX (schema->msg_capacity ? schema->msg_capacity * 2 : 16, count);
+    Char** msgs     = REALLOCATE (schema->msgs, Char*, capacity);
+    RETURN_VALUE_IF (!msgs, False, ERR_OUT_OF_MEMORY);
+
+    schema->msgs         = msgs;
+    schema->msg_capacity = capacity;
+    return True;
+}
+
+/**
+ * @b Destroy everything compiler created for it's own use, compiled loaders are
+ * owned by schema.
+ * */
+PRIVATE void compiler_deinit (SchemaCompiler* c) {
+    if (c->types) {
+        for (Size t = 0; t < c->type_count; t++) {
+            if (c->types[t].fields) {
+                FREE (c->types[t].fields);
+            }
+
+            if (c->types[t].cases) {
+                FREE (c->types[t].cases);
+            }
+
+            if (c->types[t].pod_layout.fields) {
+                struct_layout_deinit (&c->types[t].pod_layout);
+            }
+
+            if (c->types[t].uses) {
+                FREE (c->types[t].uses);
+            }
+        }
+        FREE (c->types);
+    }
+
+    compiler_map_deinit (&c->type_map);
+    compiler_map_deinit (&c->enum_map);
+
+    memset (c, 0, sizeof (SchemaCompiler));
+}
+
+/**
+ * @b Size of a basic type in bytes.
+ *
+ * @return Size for integer types, @c Char and @c Bool.
+ * @return @c 0 otherwise.
+ * */
+PRIVATE Size compiler_basic_size (FieldType type) {
+    switch (type) {
+        case FIELD_TYPE_UINT8 :
+        case FIELD_TYPE_INT8 :
+        case FIELD_TYPE_CHAR :
+        case FIELD_TYPE_BOOL :
+            return 1;
+        case FIELD_TYPE_UINT16 :
+        case FIELD_TYPE_INT16 :
+            return 2;
+        case FIELD_TYPE_UINT32 :
+        case FIELD_TYPE_INT32 :
+            return 4;
+        case FIELD_TYPE_UINT64 :
+        case FIELD_TYPE_INT64 :
+            return 8;
+        default :
+            return 0;
+    }
+}
+
+/**
+ * @b Number of bytes every object of a laid out type takes in stream.
+ *
+ * @return Size if it's same for every object.
+ * @return @c 0 otherwise.
+ * */
+PRIVATE Size compiler_stream_size (SchemaType* type) {
+    switch (type->kind) {
+        case SCHEMA_TYPE_KIND_BASIC :
+        case SCHEMA_TYPE_KIND_ENUM :
+            return type->size;
+        case SCHEMA_TYPE_KIND_STRUCT :
+            return type->is_pod ? type->pod_layout.stream_size : 0;
+        default :
+            return 0;
+    }
+}
+
+/**
+ * @b Round offset up to a multiple of alignment.
+ * */
+PRIVATE Size compiler_align (Size off, Size align) {
+    return (off + align - 1) / align * align;
+}
+
+/**
+ * @b Find value of a name in map.
+ *
+ * @param map
+ * @param key Name, need not be null terminated.
+ * @param len Length of name.
+ *
+ * @return Value if found.
+ * @return @c Null otherwise.
+ * */
+PRIVATE void* compiler_map_find (SchemaMap* map, CString key, Size len) {
+    if (!map->capacity) {
+        return Null;
+    }
+
+    /* FNV-1a */
+    Uint64 hash = 0xcbf29ce484222325;
+    for (Size k = 0; k < len; k++) {
+        hash = (hash ^ (Uint8)key[k]) * 0x100000001b3;
+    }
+
+    for (Size i = hash & (map->capacity - 1); map->keys[i]; i = (i + 1) & (map->capacity - 1)) {
+        if (!strncmp (map->keys[i], key, len) && !map->keys[i][len]) {
+            return map->values[i];
+        }
+    }
+
+    return Null;
+}
+
+/**
+ * @b Insert a name not already present in map.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool compiler_map_insert (SchemaMap* map, CString key, void* value) {
+    /* keep atleast half of the slots empty, so probes stay short */
+    if ((map->count + 1) * 2 > map->capacity) {
+        SchemaMap grown = {.capacity = map->capacity ? map->capacity * 2 : 64};
+        grown.keys      = ALLOCATE (CString, grown.capacity);
+        grown.values    = ALLOCATE (void*, grown.capacity);
+        if (!grown.keys || !grown.values) {
+            compiler_map_deinit (&grown);
+            RETURN_VALUE_IF_REACHED (False, ERR_OUT_OF_MEMORY);
+        }
+
+        for (Size i = 0; i < map->capacity; i++) {
+            if (map->keys[i]) {
+                compiler_map_insert (&grown, map->keys[i], map->values[i]);
+            }
+        }
+
+        compiler_map_deinit (map);
+        *map = grown;
+    }
+
+    Uint64 hash = 0xcbf29ce484222325;
+    for (CString k = key; *k; k++) {
+        hash = (hash ^ (Uint8)*k) * 0x100000001b3;
+    }
+
+    Size i = hash & (map->capacity - 1);
+    while (map->keys[i]) {
+        i = (i + 1) & (map->capacity - 1);
+    }
+
+    map->keys[i]   = key;
+    map->values[i] = value;
+    map->count++;
+
+    return True;
+}
+
+/**
+ * @b Destroy tables of map, names and values are not owned by it.
+ * */
+PRIVATE void compiler_map_deinit (SchemaMap* map) {
+    if (map->keys) {
+        FREE (map->keys);
+    }
+
+    if (map->values) {
+        FREE (map->values);
+    }
+
+    memset (map, 0, sizeof (SchemaMap));
+}
+
+/**
+ * @b Destroy a loader created by compiler, along with everything created for
+ * it when it was executed.
+ * */
+PRIVATE void loader_destroy (Loader* loader) {
+    jit_release_loader (loader);
+    packed_code_deinit (&loader->packed_code);
+
+    if (loader->insn_blocks) {
+        for (Size b = 0; b < loader->insn_block_count; b++) {
+            insn_block_deinit (loader->insn_blocks + b);
+        }
+        FREE (loader->insn_blocks);
+    }
+
+    if (loader->loader_refs) {
+        FREE (loader->loader_refs);
+    }
+
+    if (loader->struct_layouts) {
+        for (Size l = 0; l < loader->struct_layout_count; l++) {
+            struct_layout_deinit (loader->struct_layouts + l);
+        }
+        FREE (loader->struct_layouts);
+    }
+
+    if (loader->switch_tables) {
+        for (Size t = 0; t < loader->switch_table_count; t++) {
+            switch_table_deinit (loader->switch_tables + t);
+        }
+        FREE (loader->switch_tables);
+    }
+
+    check_table_deinit (&loader->check);
+    FREE (loader);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file Compiler.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_PARSER_COMPILER_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_PARSER_COMPILER_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* crossfile */
+#include <Anvie/CrossFile/Stream.h>
+
+#include "../Vm/Loader.h"
+#include "../Vm/Vm.h"
+
+/* local includes */
+#include "Field.h"
+
+/**
+ * @b Type loaders compiled from an xfile type description.
+ *
+ * There's one type loader for every struct and file declaration, and one for every
+ * basic type that's an element of a vector. Enums are loaded as their basic type,
+ * and fields of a typedef type call loader of type selected by value of type argument.
+ *
+ * Fields are laid out in memory in order of declaration, aligned like members of a C
+ * struct. Arrays are stored inline, and vectors are stored as a @c VmVector, with
+ * elements allocated by the VM loading them. A field with an address is read from that offset in stream,
+ * and the stream cursor is restored after reading it.
+ *
+ * When compiled with @c SCHEMA_FLAG_LAZY, fields with an address are not read at all.
+ * A @c SchemaLazy describing where elements of field are is stored in their place,
+ * and @c schema_load_lazy loads any range of elements from it on demand.
+ *
+ * Loaders, their names and messages are owned by schema and live till it's
+ * de-initialized.
+ *
+ * After an edit of description, @c schema_recompile compiles again only loaders of
+ * declarations marked changed by parser, and loaders that refer to them. Every other
+ * loader is kept as it is.
+ * */
+typedef enum SchemaFlags {
+    SCHEMA_FLAG_NONE = 0,
+    SCHEMA_FLAG_LAZY = 1 << 0, /**< @b Fields with an address are loaded on first access. */
+} SchemaFlags;
+
+/**
+ * @b Stored in place of a field loaded lazily. Elements of field are @c count objects
+ * of type loaded by @c loader, starting from @c offset in stream.
+ * */
+typedef struct SchemaLazy {
+    Uint64 offset; /**< @b Stream offset of first element. */
+    Uint64 count;  /**< @b Number of elements. */
+    Uint64 stride; /**< @b Bytes each element takes in stream, 0 if it can vary. */
+    Uint64 loader; /**< @b Index of loader of elements in @c Schema::loaders. */
+} SchemaLazy;
+
+typedef struct Schema {
+    TypeDeclList* decls;           /**< @b Declarations loaders were compiled from. */
+    SchemaFlags   flags;           /**< @b Flags loaders were compiled with. */
+
+    Loader** loaders;              /**< @b All compiled type loaders. */
+    Size     loader_count;
+    Size     loader_capacity;
+    Loader*  file_loader;          /**< @b Loader of file declaration, if there's one. */
+
+    Char** msgs;                   /**< @b Messages printed by compiled loaders. */
+    Size   msg_count;
+    Size   msg_capacity;
+
+    TypeDeclList* failed_decls;    /**< @b Declarations of last recompilation, if it failed. */
+} Schema;
+
+Schema* schema_compile (Schema* schema, TO_TypeDeclList* decls, SchemaFlags flags);
+Schema* schema_compile_source (
+    Schema*     schema,
+    CString     source,
+    Size        source_size,
+    SchemaFlags flags
+);
+Schema* schema_recompile (Schema* schema, TO_TypeDeclList* decls);
+Schema* schema_deinit (Schema* schema);
+Loader* schema_find_loader (Schema* schema, CString type_name);
+Bool    schema_load_lazy (
+    Schema*     schema,
+    Vm*         vm,
+    IoStream*   stream,
+    SchemaLazy* lazy,
+    Size        first,
+    Size        count,
+    void*       mem
+);
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_PARSER_COMPILER_H
@@ -38,8 +38,6 @@
 /* libc */
 #include <memory.h>
 
-PRIVATE ExprOpnd* expr_opnd_deinit (ExprOpnd* opnd);
-
 /**
  * @b Create a new arithmetic expression object.
  *
@@ -124,10 +122,16 @@ void cond_expr_destroy (TO_CondExpr* expr) {
  * @return @c opnd on success.
  * @return @c Null otherwise.
  * */
-PRIVATE TO_ExprOpnd* expr_opnd_deinit (TO_ExprOpnd* opnd) {
+TO_ExprOpnd* expr_opnd_deinit (TO_ExprOpnd* opnd) {
     RETURN_VALUE_IF (!opnd, Null, ERR_INVALID_ARGUMENTS);
 
     switch (opnd->opnd_type) {
+        case EXPR_OPND_TYPE_INVALID :
+        case EXPR_OPND_TYPE_INT :
+        case EXPR_OPND_TYPE_UINT :
+        case EXPR_OPND_TYPE_FLOAT :
+            break;
+
         case EXPR_OPND_TYPE_ARITH_EXPR : {
             if (opnd->arith_expr) {
                 arith_expr_destroy (opnd->arith_expr);
@@ -142,6 +146,23 @@ PRIVATE TO_ExprOpnd* expr_opnd_deinit (TO_ExprOpnd* opnd) {
             break;
         }
 
+        case EXPR_OPND_TYPE_ID : {
+            if (opnd->id) {
+                FREE (opnd->id);
+            }
+            break;
+        }
+
+        case EXPR_OPND_TYPE_ARR : {
+            if (opnd->arr) {
+                if (opnd->arr->values) {
+                    FREE (opnd->arr->values);
+                }
+                FREE (opnd->arr);
+            }
+            break;
+        }
+
         default :
             RETURN_VALUE_IF_REACHED (Null, "Invalid expression operand type.\n");
             break;
@@ -150,3 +171,232 @@ PRIVATE TO_ExprOpnd* expr_opnd_deinit (TO_ExprOpnd* opnd) {
     memset (opnd, 0, sizeof (ExprOpnd));
     return opnd;
 }
+
+/**
+ * @b Destroy contents of given field annotation.
+ *
+ * @param annotation
+ *
+ * @return @c annotation on success.
+ * @return @c Null otherwise.
+ * */
+FieldAnnotation* field_annotation_deinit (FieldAnnotation* annotation) {
+    RETURN_VALUE_IF (!annotation, Null, ERR_INVALID_ARGUMENTS);
+
+    switch (annotation->annotation_flag) {
+        case FIELD_ANNOTATION_FLAG_DOC_STR :
+            if (annotation->doc_str) {
+                FREE (annotation->doc_str);
+            }
+            break;
+
+        case FIELD_ANNOTATION_FLAG_VECTOR :
+            expr_opnd_deinit (&annotation->vec_size);
+            break;
+
+        case FIELD_ANNOTATION_FLAG_EXISTENCE_COND :
+            expr_opnd_deinit (&annotation->existence_cond);
+            break;
+
+        case FIELD_ANNOTATION_FLAG_ADDRESS :
+            expr_opnd_deinit (&annotation->addr.offset);
+            break;
+
+        case FIELD_ANNOTATION_FLAG_TYPE_ARGS :
+            if (annotation->type_args) {
+                anv_expr_opnd_list_destroy (annotation->type_args);
+            }
+            break;
+
+        default :
+            break;
+    }
+
+    memset (annotation, 0, sizeof (FieldAnnotation));
+    return annotation;
+}
+
+/**
+ * @b Find annotation of given kind in annotations of a field.
+ *
+ * @param field
+ * @param flag Kind of annotation.
+ *
+ * @return Annotation if field has one.
+ * @return @c Null otherwise.
+ * */
+FieldAnnotation* field_get_annotation (Field* field, FieldAnnotationFlagBits flag) {
+    RETURN_VALUE_IF (!field, Null, ERR_INVALID_ARGUMENTS);
+
+    if (!(field->annotation_flags & flag) || !field->annotation_list) {
+        return Null;
+    }
+
+    for (FieldAnnotationListItem* item = field->annotation_list->head; item; item = item->next) {
+        if (item->data.annotation_flag == flag) {
+            return &item->data;
+        }
+    }
+
+    return Null;
+}
+
+/**
+ * @b Destroy contents of given field, including all it's annotations.
+ *
+ * @param field
+ *
+ * @return @c field on success.
+ * @return @c Null otherwise.
+ * */
+Field* field_deinit (Field* field) {
+    RETURN_VALUE_IF (!field, Null, ERR_INVALID_ARGUMENTS);
+
+    if (field->type_name) {
+        FREE (field->type_name);
+    }
+
+    if (field->field_name) {
+        FREE (field->field_name);
+    }
+
+    if (field->annotation_list) {
+        anv_field_annotation_list_destroy (field->annotation_list);
+    }
+
+    memset (field, 0, sizeof (Field));
+    return field;
+}
+
+/**
+ * @b Destroy contents of given enum member.
+ *
+ * @param member
+ *
+ * @return @c member on success.
+ * @return @c Null otherwise.
+ * */
+EnumMember* enum_member_deinit (EnumMember* member) {
+    RETURN_VALUE_IF (!member, Null, ERR_INVALID_ARGUMENTS);
+
+    if (member->name) {
+        FREE (member->name);
+    }
+
+    if (member->doc) {
+        FREE (member->doc);
+    }
+
+    memset (member, 0, sizeof (EnumMember));
+    return member;
+}
+
+/**
+ * @b Destroy contents of given alias.
+ *
+ * @param alias
+ *
+ * @return @c alias on success.
+ * @return @c Null otherwise.
+ * */
+Alias* alias_deinit (Alias* alias) {
+    RETURN_VALUE_IF (!alias, Null, ERR_INVALID_ARGUMENTS);
+
+    if (alias->name) {
+        FREE (alias->name);
+    }
+    expr_opnd_deinit (&alias->expr);
+
+    memset (alias, 0, sizeof (Alias));
+    return alias;
+}
+
+/**
+ * @b Destroy contents of given assertion.
+ *
+ * @param assertion
+ *
+ * @return @c assertion on success.
+ * @return @c Null otherwise.
+ * */
+Assertion* assertion_deinit (Assertion* assertion) {
+    RETURN_VALUE_IF (!assertion, Null, ERR_INVALID_ARGUMENTS);
+
+    expr_opnd_deinit (&assertion->cond);
+    if (assertion->text) {
+        FREE (assertion->text);
+    }
+
+    memset (assertion, 0, sizeof (Assertion));
+    return assertion;
+}
+
+/**
+ * @b Destroy contents of given typedef case.
+ *
+ * @param tcase
+ *
+ * @return @c tcase on success.
+ * @return @c Null otherwise.
+ * */
+TypedefCase* typedef_case_deinit (TypedefCase* tcase) {
+    RETURN_VALUE_IF (!tcase, Null, ERR_INVALID_ARGUMENTS);
+
+    if (tcase->key) {
+        FREE (tcase->key);
+    }
+
+    if (tcase->type_name) {
+        FREE (tcase->type_name);
+    }
+
+    memset (tcase, 0, sizeof (TypedefCase));
+    return tcase;
+}
+
+/**
+ * @b Destroy contents of given declaration, including all lists it owns.
+ *
+ * @param decl
+ *
+ * @return @c decl on success.
+ * @return @c Null otherwise.
+ * */
+TypeDecl* type_decl_deinit (TypeDecl* decl) {
+    RETURN_VALUE_IF (!decl, Null, ERR_INVALID_ARGUMENTS);
+
+    if (decl->name) {
+        FREE (decl->name);
+    }
+
+    if (decl->doc) {
+        FREE (decl->doc);
+    }
+
+    if (decl->enum_members) {
+        anv_enum_member_list_destroy (decl->enum_members);
+    }
+
+    if (decl->fields) {
+        anv_field_list_destroy (decl->fields);
+    }
+
+    if (decl->aliases) {
+        anv_alias_list_destroy (decl->aliases);
+    }
+
+    if (decl->assertions) {
+        anv_assertion_list_destroy (decl->assertions);
+    }
+
+    if (decl->type_params) {
+        anv_expr_opnd_list_destroy (decl->type_params);
+    }
+
+    if (decl->cases) {
+        anv_typedef_case_list_destroy (decl->cases);
+    }
+
+    memset (decl, 0, sizeof (TypeDecl));
+    return decl;
+}
@@ -51,10 +51,12 @@
  * */
 
 typedef struct ExprOpnd        ExprOpnd, TO_ExprOpnd;
+typedef struct ExprArr         ExprArr, TO_ExprArr;
 typedef struct ArithExpr       ArithExpr, TO_ArithExpr;
 typedef struct CondExpr        CondExpr, TO_CondExpr;
 typedef struct Field           Field, TO_Field;
 typedef struct FieldAnnotation FieldAnnotation, TO_FieldAnnotation;
+typedef struct TypeDecl        TypeDecl, TO_TypeDecl;
 
 /**
  * Conditional or Arithmetic operand type.
@@ -66,6 +68,8 @@ typedef enum ExprOpndType {
     EXPR_OPND_TYPE_FLOAT,      /**< @b Floating point number. */
     EXPR_OPND_TYPE_ARITH_EXPR, /**< @b Arithmetic expression */
     EXPR_OPND_TYPE_COND_EXPR,  /**< @b Conditional expression */
+    EXPR_OPND_TYPE_ID,         /**< @b Field, alias or enum member name, fields joined by '.' */
+    EXPR_OPND_TYPE_ARR,        /**< @b Array of unsigned integers */
     EXPR_OPND_TYPE_MAX
 } ExprOpndType;
 
@@ -81,9 +85,24 @@ struct ExprOpnd {
         Float64    float_val;
         ArithExpr* arith_expr;
         CondExpr*  cond_expr;
+        CString    id;
+        ExprArr*   arr;
     };
 };
 
+/**
+ * @b Array literal, for comparing array fields.
+ * */
+struct ExprArr {
+    Uint64* values;
+    Size    count;
+};
+
+TO_ExprOpnd* expr_opnd_deinit (TO_ExprOpnd* opnd);
+
+/* create a new list type for ExprOpnd, that owns it's operands. */
+ANV_MAKE_LIST (ExprOpndList, expr_opnd, ExprOpnd, Null, expr_opnd_deinit);
+
 /**
  * @b Arithmetic Expression Types.
  * */
@@ -93,6 +112,7 @@ typedef enum ArithExprOp {
     ARITH_EXPR_OP_SUB,    /**< @b Integer subtraction*/
     ARITH_EXPR_OP_MUL,    /**< @b Integer multiplication */
     ARITH_EXPR_OP_DIV,    /**< @b Integer division */
+    ARITH_EXPR_OP_MOD,    /**< @b Integer remainder */
     ARITH_EXPR_OP_FADD,   /**< @b Float addition */
     ARITH_EXPR_OP_FSUB,   /**< @b Float subtraction*/
     ARITH_EXPR_OP_FMUL,   /**< @b Float multiplication */
@@ -108,6 +128,7 @@ typedef enum ArithExprOp {
 
 /**
  * @b AST to represent language of arithmetic expressions.
+ * Right operand of unary operations is left invalid.
  * */
 struct ArithExpr {
     ExprOpnd    left_opnd;
@@ -124,12 +145,14 @@ void          arith_expr_destroy (TO_ArithExpr* expr);
 typedef enum CondExprOp {
     COND_EXPR_OP_INVALID = 0,
     COND_EXPR_OP_EQ,  /**< @b Equality check. */
+    COND_EXPR_OP_NE,  /**< @b Inequality check. */
     COND_EXPR_OP_LE,  /**< @b Less than or equal to check. */
     COND_EXPR_OP_LT,  /**< @b Less than check. */
     COND_EXPR_OP_GE,  /**< @b Greater than or equal to check. */
     COND_EXPR_OP_GT,  /**< @b Greater than check. */
     COND_EXPR_OP_AND, /**< @b Logical AND operation. */
     COND_EXPR_OP_OR,  /**< @b Logical OR operation. */
+    COND_EXPR_OP_NOT, /**< @b Logical NOT operation, with only left operand. */
     COND_EXPR_OP_MAX
 } CondExprOp;
 
@@ -162,8 +185,9 @@ typedef enum FieldType {
     FIELD_TYPE_INT32,
     FIELD_TYPE_INT64,
     FIELD_TYPE_CHAR,
+    FIELD_TYPE_BOOL,
     FIELD_TYPE_CSTRING,
-    FIELD_TYPE_STRUCT,
+    FIELD_TYPE_STRUCT, /**< @b Struct, enum or typedef, resolved by name when compiling. */
     FIELD_TYPE_UNION,
     FIELD_TYPE_MAX
 } FieldType;
@@ -177,26 +201,55 @@ typedef enum FieldAnnotationFlagBits {
     FIELD_ANNOTATION_FLAG_ARRAY   = 1 << 1, /**< @b If exists then field is an array. */
     FIELD_ANNOTATION_FLAG_DOC_STR = 1 << 2, /**< @b Doc string provided as annotation to field. */
     FIELD_ANNOTATION_FLAG_EXISTENCE_COND = 1 << 3, /**< @b Condition based on which field exists. */
+    FIELD_ANNOTATION_FLAG_ADDRESS        = 1 << 4, /**< @b Offset in stream field is read from. */
+    FIELD_ANNOTATION_FLAG_TYPE_ARGS      = 1 << 5, /**< @b Arguments to a dependent type. */
     FIELD_ANNOTATION_FLAG_MAX
 } FieldAnnotationFlagBits;
 typedef Uint32 FieldAnnotationFlags;
 
+/**
+ * @b What offset of a field with an address is relative to.
+ * */
+typedef enum FieldAddrBase {
+    FIELD_ADDR_BASE_STRUCT = 0, /**< @b Beginning of struct containing the field. */
+    FIELD_ADDR_BASE_CURSOR,     /**< @b Current position in stream ('$'). */
+} FieldAddrBase;
+
 /**
  * @b Field annotation information.
+ *
+ * A vector is an array with number of elements computed at runtime, and an
+ * array has a known number of elements.
  * */
 struct FieldAnnotation {
     FieldAnnotationFlagBits annotation_flag;
 
     union {
-        CString    doc_str;
-        ArithExpr* vec_size;
-        Size       arr_size;
-        CondExpr*  existence_cond;
+        CString  doc_str;
+        ExprOpnd vec_size;
+        Size     arr_size;
+        ExprOpnd existence_cond;
+
+        struct {
+            FieldAddrBase base;
+            Bool          backward; /**< @b Offset is subtracted from base. */
+            ExprOpnd      offset;
+        } addr;
+
+        ExprOpndList* type_args;
     };
 };
 
-/* create a new list type for FieldAnnotation without cloning capability. */
-ANV_MAKE_LIST (FieldAnnotationList, field_annotation, FieldAnnotation, Null, Null);
+FieldAnnotation* field_annotation_deinit (FieldAnnotation* annotation);
+
+/* create a new list type for FieldAnnotation, that owns it's annotations. */
+ANV_MAKE_LIST (
+    FieldAnnotationList,
+    field_annotation,
+    FieldAnnotation,
+    Null,
+    field_annotation_deinit
+);
 
 /**
  * @b Represents a field in a union or a struct.
@@ -228,7 +281,99 @@ struct Field {
     FieldAnnotationList* annotation_list;
 };
 
-/* create a new list for Field without cloning capability. */
-ANV_MAKE_LIST (FieldList, field, Field, Null, Null);
+FieldAnnotation* field_get_annotation (Field* field, FieldAnnotationFlagBits flag);
+Field*           field_deinit (Field* field);
+
+/* create a new list for Field, that owns it's fields. */
+ANV_MAKE_LIST (FieldList, field, Field, Null, field_deinit);
+
+/**
+ * @b Kind of a top level declaration.
+ * */
+typedef enum TypeDeclKind {
+    TYPE_DECL_KIND_INVALID = 0,
+    TYPE_DECL_KIND_ENUM,    /**< @b Named constants of a basic type. */
+    TYPE_DECL_KIND_STRUCT,  /**< @b Fields read one after another. */
+    TYPE_DECL_KIND_FILE,    /**< @b A struct describing whole file. */
+    TYPE_DECL_KIND_TYPEDEF, /**< @b Type selected by value of it's argument. */
+    TYPE_DECL_KIND_MAX
+} TypeDeclKind;
+
+/**
+ * @b A named constant, or an inclusive range of constants, of an enum.
+ * */
+typedef struct EnumMember {
+    CString name;
+    Uint64  first;
+    Uint64  last;
+    CString doc;
+} EnumMember;
+
+EnumMember* enum_member_deinit (EnumMember* member);
+
+ANV_MAKE_LIST (EnumMemberList, enum_member, EnumMember, Null, enum_member_deinit);
+
+/**
+ * @b A name that stands for an expression inside a struct.
+ * */
+typedef struct Alias {
+    CString  name;
+    ExprOpnd expr;
+} Alias;
+
+Alias* alias_deinit (Alias* alias);
+
+ANV_MAKE_LIST (AliasList, alias, Alias, Null, alias_deinit);
+
+/**
+ * @b A condition loaded data must satisfy.
+ * */
+typedef struct Assertion {
+    ExprOpnd cond;
+    CString  text; /**< @b Condition as written in description, for error messages. */
+} Assertion;
+
+Assertion* assertion_deinit (Assertion* assertion);
+
+ANV_MAKE_LIST (AssertionList, assertion, Assertion, Null, assertion_deinit);
+
+/**
+ * @b Type selected by a dependent type when it's argument has value @c key.
+ * */
+typedef struct TypedefCase {
+    CString key;       /**< @b Name of enum member. */
+    CString type_name; /**< @b Type used for this value. */
+} TypedefCase;
+
+TypedefCase* typedef_case_deinit (TypedefCase* tcase);
+
+ANV_MAKE_LIST (TypedefCaseList, typedef_case, TypedefCase, Null, typedef_case_deinit);
+
+/**
+ * @b A top level declaration in a type description.
+ * Only members for @c decl_kind are used, rest are @c Null.
+ * */
+struct TypeDecl {
+    TypeDeclKind decl_kind;
+    CString      name;
+    CString      doc;
+
+    FieldType       enum_type;    /**< @b Basic type enum members are stored as. */
+    EnumMemberList* enum_members;
+
+    FieldList*     fields;        /**< @b Fields of struct or file. */
+    AliasList*     aliases;
+    AssertionList* assertions;
+
+    ExprOpndList*    type_params; /**< @b Parameters of typedef, types of it's arguments. */
+    TypedefCaseList* cases;
+
+    Bool changed; /**< @b Source of declaration changed since it was last parsed. */
+};
+
+TypeDecl* type_decl_deinit (TypeDecl* decl);
+
+/* create a new list for TypeDecl, that owns it's declarations. */
+ANV_MAKE_LIST (TypeDeclList, type_decl, TypeDecl, Null, type_decl_deinit);
 
 #endif
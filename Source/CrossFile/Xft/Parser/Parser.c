@@ -0,0 +1,1259 @@
+/**
+ * @file Parser.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <memory.h>
+#include <string.h>
+
+/* tree-sitter */
+#include <tree-sitter-xfile.h>
+
+/* local includes */
+#include "Parser.h"
+
+/* line and column of a node, for error messages */
+#define PARSER_POS(node) ts_node_start_point (node).row + 1, ts_node_start_point (node).column + 1
+
+/* private method declarations */
+PRIVATE TypeDeclList* parser_decls (XfileParser* xp);
+PRIVATE Bool          parser_is_changed (XfileParser* xp, TSNode node);
+PRIVATE Bool          parser_add_change (XfileParser* xp, Uint32 begin, Uint32 end);
+PRIVATE Uint32        parser_move (Uint32 pos, const TSInputEdit* edit);
+PRIVATE Bool          parser_decl (XfileParser* xp, TSNode node, TypeDecl* decl);
+PRIVATE Bool          parser_enum_decl (XfileParser* xp, TSNode node, TypeDecl* decl);
+PRIVATE Bool          parser_enum_member (XfileParser* xp, TSNode node, EnumMemberList* members);
+PRIVATE Bool          parser_struct_decl (XfileParser* xp, TSNode node, TypeDecl* decl);
+PRIVATE Bool          parser_struct_member (XfileParser* xp, TSNode node, Field* field);
+PRIVATE Bool          parser_typedef_decl (XfileParser* xp, TSNode node, TypeDecl* decl);
+PRIVATE Bool          parser_type (XfileParser* xp, TSNode node, Field* field);
+PRIVATE Bool          parser_basic_type (XfileParser* xp, TSNode node, FieldType* type);
+PRIVATE Bool          parser_expr_list (XfileParser* xp, TSNode node, ExprOpndList** list);
+PRIVATE Bool          parser_alias (XfileParser* xp, TSNode node, AliasList* aliases);
+PRIVATE Bool          parser_assert (XfileParser* xp, TSNode node, AssertionList* assertions);
+PRIVATE Bool          parser_expr (XfileParser* xp, TSNode node, ExprOpnd* opnd);
+PRIVATE Bool          parser_arr (XfileParser* xp, TSNode node, ExprOpnd* opnd);
+PRIVATE Bool          parser_num (XfileParser* xp, TSNode node, Uint64* value);
+PRIVATE Bool          parser_add_annotation (Field* field, FieldAnnotation* annotation);
+PRIVATE TSNode        parser_unwrap (XfileParser* xp, TSNode node);
+PRIVATE TSNode        parser_find_error (TSNode node);
+PRIVATE Char*         parser_text (XfileParser* xp, TSNode node);
+PRIVATE Char*         parser_doc (XfileParser* xp, TSNode node);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Initialize given xfile parser.
+ *
+ * @param xparser Parser to be initialized.
+ *
+ * @return @c xparser on success.
+ * @return @c Null otherwise.
+ * */
+XfileParser* xfile_parser_init (XfileParser* xparser) {
+    RETURN_VALUE_IF (!xparser, Null, ERR_INVALID_ARGUMENTS);
+
+    static const CString sym_names[XFILE_SYM_MAX] = {
+        [XFILE_SYM_ENUM_DECL]     = "enum_decl",
+        [XFILE_SYM_ENUM_MEMBER]   = "enum_member",
+        [XFILE_SYM_STRUCT_DECL]   = "struct_decl",
+        [XFILE_SYM_STRUCT_MEMBER] = "struct_member",
+        [XFILE_SYM_FILE_DECL]     = "file_decl",
+        [XFILE_SYM_TYPEDEF_DECL]  = "typedef_decl",
+        [XFILE_SYM_TYPEARGS]      = "typeargs",
+        [XFILE_SYM_TYPE]          = "type",
+        [XFILE_SYM_BASIC_TYPE]    = "basic_type",
+        [XFILE_SYM_CUSTOM_TYPE]   = "custom_type",
+        [XFILE_SYM_PTR_TYPE]      = "ptr_type",
+        [XFILE_SYM_ASSERT]        = "assert",
+        [XFILE_SYM_ALIAS]         = "alias",
+        [XFILE_SYM_EXPR]          = "expr",
+        [XFILE_SYM_ARITH_EXPR]    = "arith_expr",
+        [XFILE_SYM_BITWISE_EXPR]  = "bitwise_expr",
+        [XFILE_SYM_BOOL_EXPR]     = "bool_expr",
+        [XFILE_SYM_ARR]           = "arr",
+        [XFILE_SYM_RANGE]         = "range",
+        [XFILE_SYM_ID]            = "id",
+        [XFILE_SYM_CHAR]          = "char",
+        [XFILE_SYM_NUM]           = "num",
+        [XFILE_SYM_STR]           = "str",
+        [XFILE_SYM_COMMENT]       = "comment",
+    };
+
+    static const CString field_names[XFILE_FIELD_MAX] = {
+        [XFILE_FIELD_DOC]         = "doc",
+        [XFILE_FIELD_NAME]        = "name",
+        [XFILE_FIELD_TYPE]        = "type",
+        [XFILE_FIELD_BODY]        = "body",
+        [XFILE_FIELD_ALIAS]       = "alias",
+        [XFILE_FIELD_ASSERT]      = "assert",
+        [XFILE_FIELD_VALUE]       = "value",
+        [XFILE_FIELD_ARRAY_SIZE]  = "array_size",
+        [XFILE_FIELD_ADDR]        = "addr",
+        [XFILE_FIELD_TYPEARGS]    = "typeargs",
+        [XFILE_FIELD_RANGE_BEGIN] = "range_begin",
+        [XFILE_FIELD_RANGE_END]   = "range_end",
+    };
+
+    memset (xparser, 0, sizeof (XfileParser));
+
+    xparser->parser = ts_parser_new();
+    RETURN_VALUE_IF (!xparser->parser, Null, ERR_OUT_OF_MEMORY);
+
+    const TSLanguage* lang = tree_sitter_xfile();
+    GOTO_HANDLER_IF (
+        !ts_parser_set_language (xparser->parser, lang),
+        INIT_FAILED,
+        "tree-sitter-xfile language version is not supported by tree-sitter\n"
+    );
+
+    for (Size s = 0; s < XFILE_SYM_MAX; s++) {
+        xparser->syms[s] =
+            ts_language_symbol_for_name (lang, sym_names[s], strlen (sym_names[s]), True);
+        GOTO_HANDLER_IF (
+            !xparser->syms[s],
+            INIT_FAILED,
+            "Node \"%s\" not found in xfile grammar\n",
+            sym_names[s]
+        );
+    }
+
+    for (Size f = 0; f < XFILE_FIELD_MAX; f++) {
+        xparser->fields[f] =
+            ts_language_field_id_for_name (lang, field_names[f], strlen (field_names[f]));
+        GOTO_HANDLER_IF (
+            !xparser->fields[f],
+            INIT_FAILED,
+            "Field \"%s\" not found in xfile grammar\n",
+            field_names[f]
+        );
+    }
+
+    return xparser;
+
+INIT_FAILED:
+    xfile_parser_deinit (xparser);
+    return Null;
+}
+
+/**
+ * @b De-initialize given xfile parser.
+ *
+ * @param xparser
+ *
+ * @return @c xparser on success.
+ * @return @c Null otherwise.
+ * */
+XfileParser* xfile_parser_deinit (XfileParser* xparser) {
+    RETURN_VALUE_IF (!xparser, Null, ERR_INVALID_ARGUMENTS);
+
+    if (xparser->tree) {
+        ts_tree_delete (xparser->tree);
+    }
+
+    if (xparser->parser) {
+        ts_parser_delete (xparser->parser);
+    }
+
+    if (xparser->changed) {
+        FREE (xparser->changed);
+    }
+
+    memset (xparser, 0, sizeof (XfileParser));
+    return xparser;
+}
+
+/**
+ * @b Parse given xfile type description to a list of declarations. Every declaration
+ * is marked changed.
+ *
+ * Source must stay alive until next parse, because syntax tree refers to it.
+ *
+ * @param xparser
+ * @param source Type description.
+ * @param source_size Size of source in bytes.
+ *
+ * @return @c TypeDeclList* on success, owned by caller.
+ * @return @c Null otherwise.
+ * */
+TypeDeclList* xfile_parser_parse (XfileParser* xparser, CString source, Size source_size) {
+    RETURN_VALUE_IF (!xparser || !xparser->parser || !source, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (source_size > UINT32_MAX, Null, "Type description is too large\n");
+
+    if (xparser->tree) {
+        ts_tree_delete (xparser->tree);
+        xparser->tree = Null;
+    }
+
+    /* nothing is known about source without a syntax tree */
+    xparser->changed_count = 0;
+    RETURN_VALUE_IF (!parser_add_change (xparser, 0, UINT32_MAX), Null, ERR_OUT_OF_MEMORY);
+
+    xparser->source      = source;
+    xparser->source_size = source_size;
+    xparser->tree = ts_parser_parse_string (xparser->parser, Null, source, (Uint32)source_size);
+    RETURN_VALUE_IF (!xparser->tree, Null, "Failed to parse type description\n");
+
+    return parser_decls (xparser);
+}
+
+/**
+ * @b Parse given xfile type description again after editing source parsed before.
+ * Syntax tree of last parse is reused, so only edited parts of source are parsed again.
+ * Only declarations overlapping an edit, or whose syntax tree changed because of an
+ * edit, are marked changed.
+ *
+ * Source must stay alive until next parse, because syntax tree refers to it.
+ *
+ * @param xparser
+ * @param source Type description after edits.
+ * @param source_size Size of source in bytes.
+ * @param edits Edits made to source since last parse, in order they were made.
+ * @param edit_count
+ *
+ * @return @c TypeDeclList* on success, owned by caller.
+ * @return @c Null otherwise.
+ * */
+TypeDeclList* xfile_parser_reparse (
+    XfileParser*       xparser,
+    CString            source,
+    Size               source_size,
+    const TSInputEdit* edits,
+    Size               edit_count
+) {
+    RETURN_VALUE_IF (
+        !xparser || !xparser->parser || !source || (edit_count && !edits),
+        Null,
+        ERR_INVALID_ARGUMENTS
+    );
+    RETURN_VALUE_IF (source_size > UINT32_MAX, Null, "Type description is too large\n");
+
+    if (!xparser->tree) {
+        return xfile_parser_parse (xparser, source, source_size);
+    }
+
+    Bool ok = True;
+    for (Size e = 0; ok && e < edit_count; e++) {
+        ts_tree_edit (xparser->tree, edits + e);
+
+        /* ranges changed before an edit move with text around them */
+        for (Size r = 0; r < xparser->changed_count; r++) {
+            xparser->changed[r].begin = parser_move (xparser->changed[r].begin, edits + e);
+            xparser->changed[r].end   = parser_move (xparser->changed[r].end, edits + e);
+        }
+        ok = parser_add_change (xparser, edits[e].start_byte, edits[e].new_end_byte);
+    }
+
+    TSTree* tree =
+        ok ? ts_parser_parse_string (xparser->parser, xparser->tree, source, (Uint32)source_size) :
+             Null;
+
+    /* an edit can change syntax tree of text outside of it */
+    if (tree) {
+        Uint32   range_count = 0;
+        TSRange* ranges      = ts_tree_get_changed_ranges (xparser->tree, tree, &range_count);
+        for (Uint32 r = 0; ok && r < range_count; r++) {
+            ok = parser_add_change (xparser, ranges[r].start_byte, ranges[r].end_byte);
+        }
+
+        if (ranges) {
+            FREE (ranges);
+        }
+    }
+
+    ts_tree_delete (xparser->tree);
+    xparser->tree        = tree;
+    xparser->source      = source;
+    xparser->source_size = source_size;
+
+    /* without all changes, next parse must start over */
+    if (!ok && tree) {
+        ts_tree_delete (tree);
+        xparser->tree = Null;
+    }
+    RETURN_VALUE_IF (!ok || !tree, Null, "Failed to parse type description\n");
+
+    return parser_decls (xparser);
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Convert syntax tree of last parsed source to declarations. Ranges changed are
+ * forgotten on success.
+ *
+ * @return @c TypeDeclList* on success, owned by caller.
+ * @return @c Null otherwise.
+ * */
+PRIVATE TypeDeclList* parser_decls (XfileParser* xp) {
+    TSNode root = ts_tree_root_node (xp->tree);
+    if (ts_node_has_error (root)) {
+        TSNode err = parser_find_error (root);
+        if (ts_node_is_missing (err)) {
+            PRINT_ERR (
+                "%u:%u : Syntax error, missing \"%s\"\n",
+                PARSER_POS (err),
+                ts_node_type (err)
+            );
+        } else {
+            PRINT_ERR (
+                "%u:%u : Syntax error near \"%.*s\"\n",
+                PARSER_POS (err),
+                (int)MIN (ts_node_end_byte (err) - ts_node_start_byte (err), 32),
+                xp->source + ts_node_start_byte (err)
+            );
+        }
+        return Null;
+    }
+
+    TypeDeclList* decls = anv_type_decl_list_create();
+    RETURN_VALUE_IF (!decls, Null, ERR_OUT_OF_MEMORY);
+
+    Bool         ok     = True;
+    TSTreeCursor cursor = ts_tree_cursor_new (root);
+    if (ts_tree_cursor_goto_first_child (&cursor)) {
+        do {
+            TSNode node = ts_tree_cursor_current_node (&cursor);
+            if (!ts_node_is_named (node)) {
+                continue;
+            }
+
+            TypeDecl decl = {.changed = parser_is_changed (xp, node)};
+            if (!parser_decl (xp, node, &decl) || !anv_type_decl_list_append (decls, &decl)) {
+                type_decl_deinit (&decl);
+                ok = False;
+                break;
+            }
+        } while (ts_tree_cursor_goto_next_sibling (&cursor));
+    }
+    ts_tree_cursor_delete (&cursor);
+
+    if (!ok) {
+        anv_type_decl_list_destroy (decls);
+        return Null;
+    }
+
+    xp->changed_count = 0;
+    return decls;
+}
+
+/**
+ * @b Whether a top level node overlaps any range changed since last successful parse.
+ * */
+PRIVATE Bool parser_is_changed (XfileParser* xp, TSNode node) {
+    Uint32 begin = ts_node_start_byte (node);
+    Uint32 end   = ts_node_end_byte (node);
+
+    for (Size r = 0; r < xp->changed_count; r++) {
+        if (xp->changed[r].begin <= end && begin <= xp->changed[r].end) {
+            return True;
+        }
+    }
+
+    return False;
+}
+
+/**
+ * @b Remember a range of source as changed.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_add_change (XfileParser* xp, Uint32 begin, Uint32 end) {
+    if (xp->changed_count >= xp->changed_capacity) {
+        Size        capacity = xp->changed_capacity ? xp->changed_capacity * 2 : 8;
+        XfileRange* changed  = REALLOCATE (xp->changed, XfileRange, capacity);
+        RETURN_VALUE_IF (!changed, False, ERR_OUT_OF_MEMORY);
+
+        xp->changed          = changed;
+        xp->changed_capacity = capacity;
+    }
+
+    xp->changed[xp->changed_count++] = (XfileRange) {.begin = begin, .end = end};
+    return True;
+}
+
+/**
+ * @b Offset of a byte of source after an edit. Bytes removed by edit move to it's end.
+ * */
+PRIVATE Uint32 parser_move (Uint32 pos, const TSInputEdit* edit) {
+    if (pos < edit->start_byte) {
+        return pos;
+    }
+
+    if (pos < edit->old_end_byte) {
+        return edit->new_end_byte;
+    }
+
+    Uint64 moved = (Uint64)pos - edit->old_end_byte + edit->new_end_byte;
+    return (Uint32)MIN (moved, UINT32_MAX);
+}
+
+/**
+ * @b Convert a top level declaration node.
+ *
+ * @param xp
+ * @param node Declaration node.
+ * @param decl Where declaration is stored. Contents must be de-initialized by caller
+ *        even on failure.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_decl (XfileParser* xp, TSNode node, TypeDecl* decl) {
+    TSSymbol sym = ts_node_symbol (node);
+
+    if (sym == xp->syms[XFILE_SYM_ENUM_DECL]) {
+        decl->decl_kind = TYPE_DECL_KIND_ENUM;
+        return parser_enum_decl (xp, node, decl);
+    }
+
+    if (sym == xp->syms[XFILE_SYM_STRUCT_DECL]) {
+        decl->decl_kind = TYPE_DECL_KIND_STRUCT;
+        return parser_struct_decl (xp, node, decl);
+    }
+
+    if (sym == xp->syms[XFILE_SYM_FILE_DECL]) {
+        decl->decl_kind = TYPE_DECL_KIND_FILE;
+        return parser_struct_decl (xp, node, decl);
+    }
+
+    if (sym == xp->syms[XFILE_SYM_TYPEDEF_DECL]) {
+        decl->decl_kind = TYPE_DECL_KIND_TYPEDEF;
+        return parser_typedef_decl (xp, node, decl);
+    }
+
+    RETURN_VALUE_IF_REACHED (
+        False,
+        "%u:%u : Unexpected \"%s\" at top level\n",
+        PARSER_POS (node),
+        ts_node_type (node)
+    );
+}
+
+/**
+ * @b Convert an enum declaration.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_enum_decl (XfileParser* xp, TSNode node, TypeDecl* decl) {
+    decl->enum_members = anv_enum_member_list_create();
+    RETURN_VALUE_IF (!decl->enum_members, False, ERR_OUT_OF_MEMORY);
+
+    Bool         ok     = True;
+    TSTreeCursor cursor = ts_tree_cursor_new (node);
+    if (ts_tree_cursor_goto_first_child (&cursor)) {
+        do {
+            TSNode    child = ts_tree_cursor_current_node (&cursor);
+            TSFieldId field = ts_tree_cursor_current_field_id (&cursor);
+
+            if (!ts_node_is_named (child)) {
+                continue;
+            } else if (field == xp->fields[XFILE_FIELD_DOC]) {
+                ok = !!(decl->doc = parser_doc (xp, child));
+            } else if (field == xp->fields[XFILE_FIELD_NAME]) {
+                ok = !!(decl->name = parser_text (xp, child));
+            } else if (field == xp->fields[XFILE_FIELD_TYPE]) {
+                Field type = {0};
+                ok         = parser_type (xp, child, &type);
+                if (ok && type.field_type == FIELD_TYPE_STRUCT) {
+                    PRINT_ERR ("%u:%u : Enums must be of a basic type\n", PARSER_POS (child));
+                    ok = False;
+                }
+                decl->enum_type = type.field_type;
+                field_deinit (&type);
+            } else if (field == xp->fields[XFILE_FIELD_BODY]) {
+                ok = parser_enum_member (xp, child, decl->enum_members);
+            }
+        } while (ok && ts_tree_cursor_goto_next_sibling (&cursor));
+    }
+    ts_tree_cursor_delete (&cursor);
+
+    return ok;
+}
+
+/**
+ * @b Convert an enum member, which can give same value multiple names.
+ * One @c EnumMember is added for each name.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_enum_member (XfileParser* xp, TSNode node, EnumMemberList* members) {
+    Uint64 first = 0;
+    Uint64 last  = 0;
+
+    TSNode value = ts_node_child_by_field_id (node, xp->fields[XFILE_FIELD_VALUE]);
+    RETURN_VALUE_IF (
+        ts_node_is_null (value),
+        False,
+        "%u:%u : Enum member without value\n",
+        PARSER_POS (node)
+    );
+
+    if (ts_node_symbol (value) == xp->syms[XFILE_SYM_RANGE]) {
+        TSNode begin = ts_node_child_by_field_id (value, xp->fields[XFILE_FIELD_RANGE_BEGIN]);
+        TSNode end   = ts_node_child_by_field_id (value, xp->fields[XFILE_FIELD_RANGE_END]);
+        RETURN_VALUE_IF (
+            !parser_num (xp, begin, &first) || !parser_num (xp, end, &last),
+            False,
+            "%u:%u : Invalid range\n",
+            PARSER_POS (value)
+        );
+        RETURN_VALUE_IF (
+            first > last,
+            False,
+            "%u:%u : Range begins after it ends\n",
+            PARSER_POS (value)
+        );
+    } else {
+        RETURN_VALUE_IF (!parser_num (xp, value, &first), False, "Invalid enum member value\n");
+        last = first;
+    }
+
+    TSNode doc = ts_node_child_by_field_id (node, xp->fields[XFILE_FIELD_DOC]);
+
+    Bool         ok     = True;
+    TSTreeCursor cursor = ts_tree_cursor_new (node);
+    if (ts_tree_cursor_goto_first_child (&cursor)) {
+        do {
+            TSNode child = ts_tree_cursor_current_node (&cursor);
+            if (ts_tree_cursor_current_field_id (&cursor) != xp->fields[XFILE_FIELD_NAME] ||
+                ts_node_symbol (child) != xp->syms[XFILE_SYM_ID]) {
+                continue;
+            }
+
+            EnumMember member = {.first = first, .last = last};
+            member.name       = parser_text (xp, child);
+            if (!ts_node_is_null (doc)) {
+                member.doc = parser_doc (xp, doc);
+            }
+
+            ok = member.name && (ts_node_is_null (doc) || member.doc) &&
+                 anv_enum_member_list_append (members, &member);
+            if (!ok) {
+                enum_member_deinit (&member);
+            }
+        } while (ok && ts_tree_cursor_goto_next_sibling (&cursor));
+    }
+    ts_tree_cursor_delete (&cursor);
+
+    return ok;
+}
+
+/**
+ * @b Convert a struct or file declaration.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_struct_decl (XfileParser* xp, TSNode node, TypeDecl* decl) {
+    decl->fields     = anv_field_list_create();
+    decl->aliases    = anv_alias_list_create();
+    decl->assertions = anv_assertion_list_create();
+    RETURN_VALUE_IF (
+        !decl->fields || !decl->aliases || !decl->assertions,
+        False,
+        ERR_OUT_OF_MEMORY
+    );
+
+    Bool         ok     = True;
+    TSTreeCursor cursor = ts_tree_cursor_new (node);
+    if (ts_tree_cursor_goto_first_child (&cursor)) {
+        do {
+            TSNode    child = ts_tree_cursor_current_node (&cursor);
+            TSFieldId field = ts_tree_cursor_current_field_id (&cursor);
+
+            if (!ts_node_is_named (child)) {
+                continue;
+            } else if (field == xp->fields[XFILE_FIELD_DOC]) {
+                ok = !!(decl->doc = parser_doc (xp, child));
+            } else if (field == xp->fields[XFILE_FIELD_ALIAS]) {
+                ok = parser_alias (xp, child, decl->aliases);
+            } else if (field == xp->fields[XFILE_FIELD_ASSERT]) {
+                ok = parser_assert (xp, child, decl->assertions);
+            } else if (field == xp->fields[XFILE_FIELD_BODY]) {
+                Field member = {0};
+                ok = parser_struct_member (xp, child, &member) &&
+                     anv_field_list_append (decl->fields, &member);
+                if (!ok) {
+                    field_deinit (&member);
+                }
+            } else if (ts_node_symbol (child) == xp->syms[XFILE_SYM_ID]) {
+                /* name of a file declaration is not a field */
+                ok = !!(decl->name = parser_text (xp, child));
+            }
+        } while (ok && ts_tree_cursor_goto_next_sibling (&cursor));
+    }
+    ts_tree_cursor_delete (&cursor);
+
+    return ok;
+}
+
+/**
+ * @b Convert a struct member to a field.
+ *
+ * An array size that's a number makes an array, any other expression makes a vector.
+ *
+ * @param xp
+ * @param node Struct member node.
+ * @param field Where field is stored. Contents must be de-initialized by caller
+ *        even on failure.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_struct_member (XfileParser* xp, TSNode node, Field* field) {
+    FieldAnnotation addr   = {.annotation_flag = FIELD_ANNOTATION_FLAG_NONE};
+    Bool            ok     = True;
+    TSTreeCursor    cursor = ts_tree_cursor_new (node);
+    if (ts_tree_cursor_goto_first_child (&cursor)) {
+        do {
+            TSNode    child = ts_tree_cursor_current_node (&cursor);
+            TSFieldId fid   = ts_tree_cursor_current_field_id (&cursor);
+
+            if (fid == xp->fields[XFILE_FIELD_ADDR]) {
+                addr.annotation_flag = FIELD_ANNOTATION_FLAG_ADDRESS;
+                if (ts_node_is_named (child)) {
+                    ok = parser_expr (xp, child, &addr.addr.offset);
+                } else if (!strcmp (ts_node_type (child), "$")) {
+                    addr.addr.base = FIELD_ADDR_BASE_CURSOR;
+                } else if (!strcmp (ts_node_type (child), "-")) {
+                    addr.addr.backward = True;
+                }
+            } else if (!ts_node_is_named (child)) {
+                continue;
+            } else if (fid == xp->fields[XFILE_FIELD_TYPE]) {
+                ok = parser_type (xp, child, field);
+            } else if (fid == xp->fields[XFILE_FIELD_NAME]) {
+                ok = !!(field->field_name = parser_text (xp, child));
+            } else if (fid == xp->fields[XFILE_FIELD_ARRAY_SIZE]) {
+                TSNode          size = parser_unwrap (xp, child);
+                FieldAnnotation arr  = {0};
+                if (ts_node_symbol (size) == xp->syms[XFILE_SYM_NUM]) {
+                    Uint64 count        = 0;
+                    arr.annotation_flag = FIELD_ANNOTATION_FLAG_ARRAY;
+                    ok                  = parser_num (xp, size, &count);
+                    arr.arr_size        = count;
+                } else {
+                    arr.annotation_flag = FIELD_ANNOTATION_FLAG_VECTOR;
+                    ok                  = parser_expr (xp, size, &arr.vec_size);
+                }
+                ok = ok && parser_add_annotation (field, &arr);
+            } else if (fid == xp->fields[XFILE_FIELD_DOC]) {
+                FieldAnnotation doc = {.annotation_flag = FIELD_ANNOTATION_FLAG_DOC_STR};
+                ok = (doc.doc_str = parser_doc (xp, child)) && parser_add_annotation (field, &doc);
+            }
+        } while (ok && ts_tree_cursor_goto_next_sibling (&cursor));
+    }
+    ts_tree_cursor_delete (&cursor);
+
+    if (addr.annotation_flag) {
+        ok = ok && parser_add_annotation (field, &addr);
+        if (!ok) {
+            field_annotation_deinit (&addr);
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * @b Convert a typedef declaration, where type of each case is selected by
+ * the value of it's argument.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_typedef_decl (XfileParser* xp, TSNode node, TypeDecl* decl) {
+    decl->cases = anv_typedef_case_list_create();
+    RETURN_VALUE_IF (!decl->cases, False, ERR_OUT_OF_MEMORY);
+
+    TypedefCase  tcase  = {0};
+    Bool         ok     = True;
+    TSTreeCursor cursor = ts_tree_cursor_new (node);
+    if (ts_tree_cursor_goto_first_child (&cursor)) {
+        do {
+            TSNode    child = ts_tree_cursor_current_node (&cursor);
+            TSFieldId field = ts_tree_cursor_current_field_id (&cursor);
+
+            if (!ts_node_is_named (child)) {
+                continue;
+            } else if (field == xp->fields[XFILE_FIELD_DOC]) {
+                ok = !!(decl->doc = parser_doc (xp, child));
+            } else if (field == xp->fields[XFILE_FIELD_NAME]) {
+                ok = !!(decl->name = parser_text (xp, child));
+            } else if (field == xp->fields[XFILE_FIELD_TYPEARGS]) {
+                ok = parser_expr_list (xp, child, &decl->type_params);
+            } else if (ts_node_symbol (child) == xp->syms[XFILE_SYM_ID]) {
+                /* cases are pairs of ids, "key : type" */
+                if (!tcase.key) {
+                    ok = !!(tcase.key = parser_text (xp, child));
+                } else {
+                    ok = (tcase.type_name = parser_text (xp, child)) &&
+                         anv_typedef_case_list_append (decl->cases, &tcase);
+                    if (ok) {
+                        memset (&tcase, 0, sizeof (TypedefCase));
+                    }
+                }
+            }
+        } while (ok && ts_tree_cursor_goto_next_sibling (&cursor));
+    }
+    ts_tree_cursor_delete (&cursor);
+
+    typedef_case_deinit (&tcase);
+    return ok;
+}
+
+/**
+ * @b Convert a type node to type of a field. Custom types also set type name and
+ * type arguments of field.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_type (XfileParser* xp, TSNode node, Field* field) {
+    if (ts_node_symbol (node) == xp->syms[XFILE_SYM_TYPE]) {
+        node = ts_node_named_child (node, 0);
+    }
+
+    TSSymbol sym = ts_node_symbol (node);
+    if (sym == xp->syms[XFILE_SYM_BASIC_TYPE]) {
+        return parser_basic_type (xp, node, &field->field_type);
+    }
+
+    RETURN_VALUE_IF (
+        sym == xp->syms[XFILE_SYM_PTR_TYPE],
+        False,
+        "%u:%u : Pointer types are not supported yet\n",
+        PARSER_POS (node)
+    );
+    RETURN_VALUE_IF (
+        sym != xp->syms[XFILE_SYM_CUSTOM_TYPE],
+        False,
+        "%u:%u : Expected a type, got \"%s\"\n",
+        PARSER_POS (node),
+        ts_node_type (node)
+    );
+
+    field->field_type = FIELD_TYPE_STRUCT;
+
+    TSNode name = ts_node_child_by_field_id (node, xp->fields[XFILE_FIELD_NAME]);
+    RETURN_VALUE_IF (!(field->type_name = parser_text (xp, name)), False, ERR_OUT_OF_MEMORY);
+
+    TSNode args = ts_node_child_by_field_id (node, xp->fields[XFILE_FIELD_TYPEARGS]);
+    if (ts_node_is_null (args)) {
+        return True;
+    }
+
+    FieldAnnotation annotation = {.annotation_flag = FIELD_ANNOTATION_FLAG_TYPE_ARGS};
+    if (!parser_expr_list (xp, args, &annotation.type_args) ||
+        !parser_add_annotation (field, &annotation)) {
+        field_annotation_deinit (&annotation);
+        return False;
+    }
+
+    return True;
+}
+
+/**
+ * @b Convert name of a basic type.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_basic_type (XfileParser* xp, TSNode node, FieldType* type) {
+    static const struct {
+        CString   name;
+        FieldType type;
+    } basic_types[] = {
+        {  "Bool",    FIELD_TYPE_BOOL},
+        {  "Char",    FIELD_TYPE_CHAR},
+        { "Uint8",   FIELD_TYPE_UINT8},
+        {"Uint16",  FIELD_TYPE_UINT16},
+        {"Uint32",  FIELD_TYPE_UINT32},
+        {"Uint64",  FIELD_TYPE_UINT64},
+        {  "Int8",    FIELD_TYPE_INT8},
+        { "Int16",   FIELD_TYPE_INT16},
+        { "Int32",   FIELD_TYPE_INT32},
+        { "Int64",   FIELD_TYPE_INT64},
+        {  "Size",  FIELD_TYPE_UINT64},
+        {  "CStr", FIELD_TYPE_CSTRING},
+    };
+
+    CString text = xp->source + ts_node_start_byte (node);
+    Size    len  = ts_node_end_byte (node) - ts_node_start_byte (node);
+
+    for (Size t = 0; t < ARRAY_SIZE (basic_types); t++) {
+        if (strlen (basic_types[t].name) == len && !memcmp (basic_types[t].name, text, len)) {
+            *type = basic_types[t].type;
+            return True;
+        }
+    }
+
+    RETURN_VALUE_IF_REACHED (
+        False,
+        "%u:%u : Unknown basic type \"%.*s\"\n",
+        PARSER_POS (node),
+        (int)len,
+        text
+    );
+}
+
+/**
+ * @b Convert all expressions inside given node (type arguments) to a new list.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_expr_list (XfileParser* xp, TSNode node, ExprOpndList** list) {
+    *list = anv_expr_opnd_list_create();
+    RETURN_VALUE_IF (!*list, False, ERR_OUT_OF_MEMORY);
+
+    Bool         ok     = True;
+    TSTreeCursor cursor = ts_tree_cursor_new (node);
+    if (ts_tree_cursor_goto_first_child (&cursor)) {
+        do {
+            TSNode child = ts_tree_cursor_current_node (&cursor);
+            if (!ts_node_is_named (child)) {
+                continue;
+            }
+
+            ExprOpnd opnd = {0};
+            ok = parser_expr (xp, child, &opnd) && anv_expr_opnd_list_append (*list, &opnd);
+            if (!ok) {
+                expr_opnd_deinit (&opnd);
+            }
+        } while (ok && ts_tree_cursor_goto_next_sibling (&cursor));
+    }
+    ts_tree_cursor_delete (&cursor);
+
+    return ok;
+}
+
+/**
+ * @b Convert an alias block, made of "name : expr" pairs.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_alias (XfileParser* xp, TSNode node, AliasList* aliases) {
+    Alias        alias  = {0};
+    Bool         ok     = True;
+    TSTreeCursor cursor = ts_tree_cursor_new (node);
+    if (ts_tree_cursor_goto_first_child (&cursor)) {
+        do {
+            TSNode child = ts_tree_cursor_current_node (&cursor);
+            if (!ts_node_is_named (child)) {
+                continue;
+            }
+
+            if (!alias.name) {
+                ok = !!(alias.name = parser_text (xp, child));
+            } else {
+                ok = parser_expr (xp, child, &alias.expr) &&
+                     anv_alias_list_append (aliases, &alias);
+                if (ok) {
+                    memset (&alias, 0, sizeof (Alias));
+                }
+            }
+        } while (ok && ts_tree_cursor_goto_next_sibling (&cursor));
+    }
+    ts_tree_cursor_delete (&cursor);
+
+    alias_deinit (&alias);
+    return ok;
+}
+
+/**
+ * @b Convert an assert block, made of conditions.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_assert (XfileParser* xp, TSNode node, AssertionList* assertions) {
+    Bool         ok     = True;
+    TSTreeCursor cursor = ts_tree_cursor_new (node);
+    if (ts_tree_cursor_goto_first_child (&cursor)) {
+        do {
+            TSNode child = ts_tree_cursor_current_node (&cursor);
+            if (!ts_node_is_named (child)) {
+                continue;
+            }
+
+            Assertion assertion = {0};
+            ok = (assertion.text = parser_text (xp, child)) &&
+                 parser_expr (xp, child, &assertion.cond) &&
+                 anv_assertion_list_append (assertions, &assertion);
+            if (!ok) {
+                assertion_deinit (&assertion);
+            }
+        } while (ok && ts_tree_cursor_goto_next_sibling (&cursor));
+    }
+    ts_tree_cursor_delete (&cursor);
+
+    return ok;
+}
+
+/**
+ * @b Convert an expression node to an expression operand.
+ *
+ * @param xp
+ * @param node Expression node.
+ * @param opnd Where operand is stored. Contents must be de-initialized by caller
+ *        even on failure.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_expr (XfileParser* xp, TSNode node, ExprOpnd* opnd) {
+    static const struct {
+        CString     name;
+        ArithExprOp arith_op;
+        CondExprOp  cond_op;
+    } ops[] = {
+        { "+",    ARITH_EXPR_OP_ADD,                 0},
+        { "-",    ARITH_EXPR_OP_SUB,                 0},
+        { "*",    ARITH_EXPR_OP_MUL,                 0},
+        { "/",    ARITH_EXPR_OP_DIV,                 0},
+        { "%",    ARITH_EXPR_OP_MOD,                 0},
+        { "&",    ARITH_EXPR_OP_AND,                 0},
+        { "|",     ARITH_EXPR_OP_OR,                 0},
+        { "^",    ARITH_EXPR_OP_XOR,                 0},
+        {"<<", ARITH_EXPR_OP_LSHIFT,                 0},
+        {">>", ARITH_EXPR_OP_RSHIFT,                 0},
+        { "~",    ARITH_EXPR_OP_INV,                 0},
+        {"&&",                    0, COND_EXPR_OP_AND},
+        {"||",                    0,  COND_EXPR_OP_OR},
+        {"==",                    0,  COND_EXPR_OP_EQ},
+        {"!=",                    0,  COND_EXPR_OP_NE},
+        { "<",                    0,  COND_EXPR_OP_LT},
+        { ">",                    0,  COND_EXPR_OP_GT},
+        {"<=",                    0,  COND_EXPR_OP_LE},
+        {">=",                    0,  COND_EXPR_OP_GE},
+        { "!",                    0, COND_EXPR_OP_NOT},
+    };
+
+    node         = parser_unwrap (xp, node);
+    TSSymbol sym = ts_node_symbol (node);
+
+    if (sym == xp->syms[XFILE_SYM_NUM]) {
+        opnd->opnd_type = EXPR_OPND_TYPE_UINT;
+        return parser_num (xp, node, &opnd->unsigned_val);
+    }
+
+    if (sym == xp->syms[XFILE_SYM_ID]) {
+        opnd->opnd_type = EXPR_OPND_TYPE_ID;
+        return !!(opnd->id = parser_text (xp, node));
+    }
+
+    if (sym == xp->syms[XFILE_SYM_ARR]) {
+        return parser_arr (xp, node, opnd);
+    }
+
+    RETURN_VALUE_IF (
+        sym != xp->syms[XFILE_SYM_ARITH_EXPR] && sym != xp->syms[XFILE_SYM_BITWISE_EXPR] &&
+            sym != xp->syms[XFILE_SYM_BOOL_EXPR],
+        False,
+        "%u:%u : Expected an expression, got \"%s\"\n",
+        PARSER_POS (node),
+        ts_node_type (node)
+    );
+
+    /* operator is the only anonymous child besides parentheses */
+    TSNode opnd_nodes[2] = {0};
+    Size   opnd_count    = 0;
+    Size   op            = ARRAY_SIZE (ops);
+    Uint32 child_count   = ts_node_child_count (node);
+    for (Uint32 c = 0; c < child_count; c++) {
+        TSNode child = ts_node_child (node, c);
+        if (ts_node_is_named (child)) {
+            RETURN_VALUE_IF (
+                opnd_count == 2,
+                False,
+                "%u:%u : Too many operands\n",
+                PARSER_POS (child)
+            );
+            opnd_nodes[opnd_count++] = child;
+            continue;
+        }
+
+        CString type = ts_node_type (child);
+        for (Size o = 0; op == ARRAY_SIZE (ops) && o < ARRAY_SIZE (ops); o++) {
+            if (!strcmp (ops[o].name, type)) {
+                op = o;
+            }
+        }
+    }
+
+    RETURN_VALUE_IF (
+        op == ARRAY_SIZE (ops) || !opnd_count,
+        False,
+        "%u:%u : Invalid expression\n",
+        PARSER_POS (node)
+    );
+
+    ExprOpnd left  = {0};
+    ExprOpnd right = {0};
+    if (!parser_expr (xp, opnd_nodes[0], &left) ||
+        (opnd_count == 2 && !parser_expr (xp, opnd_nodes[1], &right))) {
+        expr_opnd_deinit (&left);
+        expr_opnd_deinit (&right);
+        return False;
+    }
+
+    if (ops[op].arith_op) {
+        opnd->opnd_type  = EXPR_OPND_TYPE_ARITH_EXPR;
+        opnd->arith_expr = arith_expr_create (&left, ops[op].arith_op, &right);
+        if (opnd->arith_expr) {
+            return True;
+        }
+    } else {
+        opnd->opnd_type = EXPR_OPND_TYPE_COND_EXPR;
+        opnd->cond_expr = cond_expr_create (&left, ops[op].cond_op, &right);
+        if (opnd->cond_expr) {
+            return True;
+        }
+    }
+
+    expr_opnd_deinit (&left);
+    expr_opnd_deinit (&right);
+    return False;
+}
+
+/**
+ * @b Convert an array literal. Numbers and characters become one element each,
+ * and strings become one element for each of their characters.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_arr (XfileParser* xp, TSNode node, ExprOpnd* opnd) {
+    opnd->opnd_type = EXPR_OPND_TYPE_ARR;
+    opnd->arr       = NEW (ExprArr);
+    RETURN_VALUE_IF (!opnd->arr, False, ERR_OUT_OF_MEMORY);
+
+    /* there can never be more elements than bytes in literal */
+    Size len          = ts_node_end_byte (node) - ts_node_start_byte (node);
+    opnd->arr->values = ALLOCATE (Uint64, MAX (len, 1));
+    RETURN_VALUE_IF (!opnd->arr->values, False, ERR_OUT_OF_MEMORY);
+
+    Bool         ok     = True;
+    TSTreeCursor cursor = ts_tree_cursor_new (node);
+    if (ts_tree_cursor_goto_first_child (&cursor)) {
+        do {
+            TSNode child = ts_tree_cursor_current_node (&cursor);
+            if (!ts_node_is_named (child)) {
+                continue;
+            }
+
+            TSSymbol sym  = ts_node_symbol (child);
+            CString  text = xp->source + ts_node_start_byte (child);
+            Size     size = ts_node_end_byte (child) - ts_node_start_byte (child);
+
+            if (sym == xp->syms[XFILE_SYM_NUM]) {
+                ok = parser_num (xp, child, opnd->arr->values + opnd->arr->count++);
+            } else if (sym == xp->syms[XFILE_SYM_CHAR]) {
+                opnd->arr->values[opnd->arr->count++] = (Uint8)text[0];
+            } else if (sym == xp->syms[XFILE_SYM_STR]) {
+                /* skip quotes */
+                for (Size c = 1; c + 1 < size; c++) {
+                    opnd->arr->values[opnd->arr->count++] = (Uint8)text[c];
+                }
+            }
+        } while (ok && ts_tree_cursor_goto_next_sibling (&cursor));
+    }
+    ts_tree_cursor_delete (&cursor);
+
+    return ok;
+}
+
+/**
+ * @b Convert a decimal or hexadecimal (0x prefixed) number.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool parser_num (XfileParser* xp, TSNode node, Uint64* value) {
+    RETURN_VALUE_IF (ts_node_is_null (node), False, "Expected a number\n");
+
+    CString text = xp->source + ts_node_start_byte (node);
+    Size    len  = ts_node_end_byte (node) - ts_node_start_byte (node);
+    Uint64  base = 10;
+    Uint64  val  = 0;
+
+    if (len > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        base  = 16;
+        text += 2;
+        len  -= 2;
+    }
+
+    RETURN_VALUE_IF (!len, False, "%u:%u : Expected a number\n", PARSER_POS (node));
+
+    for (Size c = 0; c < len; c++) {
+        Char   ch    = text[c];
+        Uint64 digit = 0;
+        if (ch >= '0' && ch <= '9') {
+            digit = ch - '0';
+        } else if (base == 16 && ch >= 'a' && ch <= 'f') {
+            digit = ch - 'a' + 10;
+        } else if (base == 16 && ch >= 'A' && ch <= 'F') {
+            digit = ch - 'A' + 10;
+        } else {
+            RETURN_VALUE_IF_REACHED (False, "%u:%u : Invalid number\n", PARSER_POS (node));
+        }
+
+        RETURN_VALUE_IF (
+            __builtin_mul_overflow (val, base, &val) || __builtin_add_overflow (val, digit, &val),
+            False,
+            "%u:%u : Number too large\n",
+            PARSER_POS (node)
+        );
+    }
+
+    *value = val;
+    return True;
+}
+
+/**
+ * @b Add annotation to a field, taking ownership of it's contents.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise, annotation is still owned by caller.
+ * */
+PRIVATE Bool parser_add_annotation (Field* field, FieldAnnotation* annotation) {
+    if (!field->annotation_list) {
+        field->annotation_list = anv_field_annotation_list_create();
+        RETURN_VALUE_IF (!field->annotation_list, False, ERR_OUT_OF_MEMORY);
+    }
+
+    RETURN_VALUE_IF (
+        !anv_field_annotation_list_append (field->annotation_list, annotation),
+        False,
+        ERR_OUT_OF_MEMORY
+    );
+
+    field->annotation_flags |= annotation->annotation_flag;
+    return True;
+}
+
+/**
+ * @b Skip expression wrappers and parentheses around an expression.
+ *
+ * @return Innermost node that's an actual expression.
+ * */
+PRIVATE TSNode parser_unwrap (XfileParser* xp, TSNode node) {
+    while (!ts_node_is_null (node)) {
+        TSSymbol sym = ts_node_symbol (node);
+        if (sym == xp->syms[XFILE_SYM_NUM] || sym == xp->syms[XFILE_SYM_ID] ||
+            sym == xp->syms[XFILE_SYM_ARR] || sym == xp->syms[XFILE_SYM_ARITH_EXPR] ||
+            sym == xp->syms[XFILE_SYM_BITWISE_EXPR] || sym == xp->syms[XFILE_SYM_BOOL_EXPR] ||
+            ts_node_named_child_count (node) != 1) {
+            break;
+        }
+
+        node = ts_node_named_child (node, 0);
+    }
+
+    return node;
+}
+
+/**
+ * @b Find first error or missing node in a tree with errors.
+ *
+ * @return Error node if found.
+ * @return @c node otherwise.
+ * */
+PRIVATE TSNode parser_find_error (TSNode node) {
+    if (ts_node_symbol (node) == ts_builtin_sym_error || ts_node_is_missing (node)) {
+        return node;
+    }
+
+    Uint32 child_count = ts_node_child_count (node);
+    for (Uint32 c = 0; c < child_count; c++) {
+        TSNode child = ts_node_child (node, c);
+        if (ts_node_has_error (child)) {
+            return parser_find_error (child);
+        }
+    }
+
+    return node;
+}
+
+/**
+ * @b Copy source text of given node.
+ *
+ * @return New string on success.
+ * @return @c Null otherwise.
+ * */
+PRIVATE Char* parser_text (XfileParser* xp, TSNode node) {
+    RETURN_VALUE_IF (ts_node_is_null (node), Null, ERR_INVALID_ARGUMENTS);
+
+    Char* text = strndup (
+        xp->source + ts_node_start_byte (node),
+        ts_node_end_byte (node) - ts_node_start_byte (node)
+    );
+    RETURN_VALUE_IF (!text, Null, ERR_OUT_OF_MEMORY);
+
+    return text;
+}
+
+/**
+ * @b Copy text of a comment, without comment markers and surrounding spaces.
+ *
+ * @return New string on success.
+ * @return @c Null otherwise.
+ * */
+PRIVATE Char* parser_doc (XfileParser* xp, TSNode node) {
+    CString begin = xp->source + ts_node_start_byte (node) + 2;
+    CString end   = xp->source + ts_node_end_byte (node) - 2;
+
+    while (begin < end && strchr (" \t\r\n*", *begin)) {
+        begin++;
+    }
+
+    while (end > begin && strchr (" \t\r\n*", end[-1])) {
+        end--;
+    }
+
+    Char* doc = strndup (begin, end - begin);
+    RETURN_VALUE_IF (!doc, Null, ERR_OUT_OF_MEMORY);
+
+    return doc;
+}
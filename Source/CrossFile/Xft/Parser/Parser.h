@@ -0,0 +1,141 @@
+/**
+ * @file Parser.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_PARSER_PARSER_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_PARSER_PARSER_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* tree-sitter */
+#include <tree_sitter/api.h>
+
+/* local includes */
+#include "Field.h"
+
+/**
+ * @b Named nodes of xfile grammar the parser looks at.
+ * */
+typedef enum XfileSym {
+    XFILE_SYM_ENUM_DECL = 0,
+    XFILE_SYM_ENUM_MEMBER,
+    XFILE_SYM_STRUCT_DECL,
+    XFILE_SYM_STRUCT_MEMBER,
+    XFILE_SYM_FILE_DECL,
+    XFILE_SYM_TYPEDEF_DECL,
+    XFILE_SYM_TYPEARGS,
+    XFILE_SYM_TYPE,
+    XFILE_SYM_BASIC_TYPE,
+    XFILE_SYM_CUSTOM_TYPE,
+    XFILE_SYM_PTR_TYPE,
+    XFILE_SYM_ASSERT,
+    XFILE_SYM_ALIAS,
+    XFILE_SYM_EXPR,
+    XFILE_SYM_ARITH_EXPR,
+    XFILE_SYM_BITWISE_EXPR,
+    XFILE_SYM_BOOL_EXPR,
+    XFILE_SYM_ARR,
+    XFILE_SYM_RANGE,
+    XFILE_SYM_ID,
+    XFILE_SYM_CHAR,
+    XFILE_SYM_NUM,
+    XFILE_SYM_STR,
+    XFILE_SYM_COMMENT,
+    XFILE_SYM_MAX
+} XfileSym;
+
+/**
+ * @b Field names of xfile grammar the parser looks at.
+ * */
+typedef enum XfileField {
+    XFILE_FIELD_DOC = 0,
+    XFILE_FIELD_NAME,
+    XFILE_FIELD_TYPE,
+    XFILE_FIELD_BODY,
+    XFILE_FIELD_ALIAS,
+    XFILE_FIELD_ASSERT,
+    XFILE_FIELD_VALUE,
+    XFILE_FIELD_ARRAY_SIZE,
+    XFILE_FIELD_ADDR,
+    XFILE_FIELD_TYPEARGS,
+    XFILE_FIELD_RANGE_BEGIN,
+    XFILE_FIELD_RANGE_END,
+    XFILE_FIELD_MAX
+} XfileField;
+
+/**
+ * @b Range of bytes [begin, end] of source that changed.
+ * */
+typedef struct XfileRange {
+    Uint32 begin;
+    Uint32 end;
+} XfileRange;
+
+/**
+ * @b Converts xfile type descriptions to declarations (@c TypeDecl) that
+ * can be compiled to type loaders.
+ *
+ * Symbol and field ids are looked up once when parser is initialized, so walking the
+ * syntax tree only compares integers. Syntax tree of last parsed source is kept, and
+ * reused when source is parsed again after an edit.
+ *
+ * Every declaration that overlaps a range of source changed since last successful
+ * parse is marked @c TypeDecl::changed. Ranges of a parse that failed are kept, and
+ * moved along by later edits, till source parses again.
+ * */
+typedef struct XfileParser {
+    TSParser* parser;
+    TSTree*   tree;        /**< @b Syntax tree of last parsed source. */
+    CString   source;      /**< @b Last parsed source, not owned by parser. */
+    Size      source_size;
+
+    XfileRange* changed;   /**< @b Ranges changed since last successful parse. */
+    Size        changed_count;
+    Size        changed_capacity;
+
+    TSSymbol  syms[XFILE_SYM_MAX];
+    TSFieldId fields[XFILE_FIELD_MAX];
+} XfileParser;
+
+XfileParser*  xfile_parser_init (XfileParser* xparser);
+XfileParser*  xfile_parser_deinit (XfileParser* xparser);
+TypeDeclList* xfile_parser_parse (XfileParser* xparser, CString source, Size source_size);
+TypeDeclList* xfile_parser_reparse (
+    XfileParser*       xparser,
+    CString            source,
+    Size               source_size,
+    const TSInputEdit* edits,
+    Size               edit_count
+);
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_PARSER_PARSER_H
@@ -0,0 +1,319 @@
+/**
+ * @file Registry.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* local includes */
+#include "Registry.h"
+
+/* private method declarations */
+PRIVATE SchemaEntry* registry_add (SchemaRegistry* registry, CString name, Uint64 hash);
+PRIVATE void         registry_entry_destroy (SchemaEntry* entry);
+PRIVATE Uint64       registry_hash (CString source, Size source_size);
+PRIVATE Char*        registry_cache_path (SchemaRegistry* registry, Uint64 hash);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Initialize given schema registry.
+ *
+ * @param registry
+ * @param cache_dir Directory where schemas compiled at runtime are cached, created
+ *        if it doesn't exist. @c Null if they must not be cached.
+ *
+ * @return @c registry on success.
+ * @return @c Null otherwise.
+ * */
+SchemaRegistry* schema_registry_init (SchemaRegistry* registry, CString cache_dir) {
+    RETURN_VALUE_IF (!registry, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (registry, 0, sizeof (SchemaRegistry));
+
+    if (cache_dir) {
+        registry->cache_dir = strdup (cache_dir);
+        RETURN_VALUE_IF (!registry->cache_dir, Null, ERR_OUT_OF_MEMORY);
+    }
+
+    return registry;
+}
+
+/**
+ * @b De-initialize given schema registry, destroying all it's entries and their loaders.
+ *
+ * @param registry
+ *
+ * @return @c registry on success.
+ * @return @c Null otherwise.
+ * */
+SchemaRegistry* schema_registry_deinit (SchemaRegistry* registry) {
+    RETURN_VALUE_IF (!registry, Null, ERR_INVALID_ARGUMENTS);
+
+    if (registry->entries) {
+        for (Size e = 0; e < registry->entry_count; e++) {
+            registry_entry_destroy (registry->entries[e]);
+        }
+        FREE (registry->entries);
+    }
+
+    if (registry->cache_dir) {
+        FREE (registry->cache_dir);
+    }
+
+    memset (registry, 0, sizeof (SchemaRegistry));
+    return registry;
+}
+
+/**
+ * @b Find a schema by name, among schemas registered before and schemas bundled
+ * with CrossFile. Bundled schemas are loaded from their embedded xfb image on first
+ * use, without parsing or compiling anything.
+ *
+ * @param registry
+ * @param name
+ *
+ * @return Entry of schema if found.
+ * @return @c Null otherwise.
+ * */
+SchemaEntry* schema_registry_find (SchemaRegistry* registry, CString name) {
+    RETURN_VALUE_IF (!registry || !name, Null, ERR_INVALID_ARGUMENTS);
+
+    for (Size e = 0; e < registry->entry_count; e++) {
+        if (!strcmp (registry->entries[e]->name, name)) {
+            return registry->entries[e];
+        }
+    }
+
+    const SchemaBlob* blob = Null;
+    for (Size b = 0; b < schema_blob_count; b++) {
+        if (!strcmp (schema_blobs[b].name, name)) {
+            blob = schema_blobs + b;
+            break;
+        }
+    }
+
+    if (!blob) {
+        return Null;
+    }
+
+    SchemaEntry* entry = registry_add (registry, name, 0);
+    if (!entry) {
+        return Null;
+    }
+
+    if (!xfb_open_memory (&entry->xfb, blob->data, blob->size)) {
+        registry_entry_destroy (registry->entries[--registry->entry_count]);
+        RETURN_VALUE_IF_REACHED (Null, "Bundled schema \"%s\" is invalid\n", name);
+    }
+
+    entry->file_loader  = entry->xfb.file_loader;
+    entry->loader_count = entry->xfb.loader_count;
+    return entry;
+}
+
+/**
+ * @b Get loaders of a type description, compiling it only if same source wasn't
+ * registered with same name before, and isn't in cache directory of registry either.
+ * Source is compiled with @c SCHEMA_FLAG_NONE, and written to cache directory
+ * afterwards. Failing to write cache is not an error.
+ *
+ * @param registry
+ * @param name Name entry is registered with.
+ * @param source Type description.
+ * @param source_size Size of type description.
+ *
+ * @return Entry of schema on success.
+ * @return @c Null otherwise.
+ * */
+SchemaEntry* schema_registry_compile (
+    SchemaRegistry* registry,
+    CString         name,
+    CString         source,
+    Size            source_size
+) {
+    RETURN_VALUE_IF (!registry || !name || !source, Null, ERR_INVALID_ARGUMENTS);
+
+    Uint64 hash = registry_hash (source, source_size);
+    for (Size e = 0; e < registry->entry_count; e++) {
+        if (registry->entries[e]->hash == hash && !strcmp (registry->entries[e]->name, name)) {
+            return registry->entries[e];
+        }
+    }
+
+    SchemaEntry* entry = registry_add (registry, name, hash);
+    if (!entry) {
+        return Null;
+    }
+
+    Char* path = registry_cache_path (registry, hash);
+    if (path && !access (path, R_OK) && xfb_open (&entry->xfb, path)) {
+        entry->file_loader  = entry->xfb.file_loader;
+        entry->loader_count = entry->xfb.loader_count;
+        FREE (path);
+        return entry;
+    }
+
+    if (!schema_compile_source (&entry->schema, source, source_size, SCHEMA_FLAG_NONE)) {
+        if (path) {
+            FREE (path);
+        }
+        registry_entry_destroy (registry->entries[--registry->entry_count]);
+        RETURN_VALUE_IF_REACHED (Null, "Failed to compile schema \"%s\"\n", name);
+    }
+
+    entry->file_loader  = entry->schema.file_loader;
+    entry->loader_count = entry->schema.loader_count;
+
+    if (path) {
+        if (mkdir (registry->cache_dir, 0755) && errno != EEXIST) {
+            PRINT_ERR ("Failed to create schema cache : %s\n", strerror (errno));
+        } else if (!xfb_write (
+                       entry->schema.loaders,
+                       entry->schema.loader_count,
+                       entry->file_loader,
+                       path
+                   )) {
+            PRINT_ERR ("Failed to cache schema \"%s\"\n", name);
+        }
+        FREE (path);
+    }
+
+    return entry;
+}
+
+/**
+ * @b Find type loader of given type in a schema entry.
+ *
+ * @param entry
+ * @param type_name
+ *
+ * @return Loader on success.
+ * @return @c Null otherwise.
+ * */
+Loader* schema_entry_find_loader (SchemaEntry* entry, CString type_name) {
+    RETURN_VALUE_IF (!entry || !type_name, Null, ERR_INVALID_ARGUMENTS);
+
+    if (entry->xfb.data) {
+        return xfb_find_loader (&entry->xfb, type_name);
+    }
+
+    return schema_find_loader (&entry->schema, type_name);
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Add a new empty entry to registry. Entry is last one in registry, till another
+ * one is added.
+ *
+ * @return New entry on success.
+ * @return @c Null otherwise.
+ * */
+PRIVATE SchemaEntry* registry_add (SchemaRegistry* registry, CString name, Uint64 hash) {
+    if (registry->entry_count >= registry->entry_capacity) {
+        Size          capacity = registry->entry_capacity ? registry->entry_capacity * 2 : 4;
+        SchemaEntry** entries  = REALLOCATE (registry->entries, SchemaEntry*, capacity);
+        RETURN_VALUE_IF (!entries, Null, ERR_OUT_OF_MEMORY);
+
+        registry->entries        = entries;
+        registry->entry_capacity = capacity;
+    }
+
+    SchemaEntry* entry = ALLOCATE (SchemaEntry, 1);
+    RETURN_VALUE_IF (!entry, Null, ERR_OUT_OF_MEMORY);
+
+    entry->name = strdup (name);
+    entry->hash = hash;
+    if (!entry->name) {
+        FREE (entry);
+        RETURN_VALUE_IF_REACHED (Null, ERR_OUT_OF_MEMORY);
+    }
+
+    registry->entries[registry->entry_count++] = entry;
+    return entry;
+}
+
+/**
+ * @b Destroy an entry and whichever loaders it holds.
+ * */
+PRIVATE void registry_entry_destroy (SchemaEntry* entry) {
+    if (entry->xfb.data) {
+        xfb_close (&entry->xfb);
+    }
+
+    schema_deinit (&entry->schema);
+    FREE (entry->name);
+    FREE (entry);
+}
+
+/**
+ * @b FNV-1a hash of a type description, cached schemas are named by it.
+ * */
+PRIVATE Uint64 registry_hash (CString source, Size source_size) {
+    Uint64 hash = 0xcbf29ce484222325ull;
+    for (Size b = 0; b < source_size; b++) {
+        hash ^= (Uint8)source[b];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+/**
+ * @b Path schema with given hash is cached at.
+ *
+ * @return Path owned by caller, if registry has a cache directory.
+ * @return @c Null otherwise.
+ * */
+PRIVATE Char* registry_cache_path (SchemaRegistry* registry, Uint64 hash) {
+    if (!registry->cache_dir) {
+        return Null;
+    }
+
+    Size  size = strlen (registry->cache_dir) + 32;
+    Char* path = ALLOCATE (Char, size);
+    RETURN_VALUE_IF (!path, Null, ERR_OUT_OF_MEMORY);
+
+    snprintf (path, size, "%s/%016llx.xfb", registry->cache_dir, (unsigned long long)hash);
+    return path;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file Registry.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_PARSER_REGISTRY_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_PARSER_REGISTRY_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* crossfile */
+#include "../Vm/Loader.h"
+#include "../Vm/Xfb.h"
+
+/* local includes */
+#include "Compiler.h"
+
+/**
+ * @b A type description bundled with CrossFile, compiled to an xfb image at build time.
+ * */
+typedef struct SchemaBlob {
+    CString      name; /**< @b Name schema is looked up by, like "Elf". */
+    const Uint8* data; /**< @b Xfb image, aligned to @c XFB_SECTION_ALIGNMENT. */
+    Size         size;
+} SchemaBlob;
+
+/* defined in source generated by xft_schema_embed (see CMake/XftSchemaEmbed.cmake) */
+extern const SchemaBlob schema_blobs[];
+extern const Size       schema_blob_count;
+
+/**
+ * @b Type loaders of a schema known to registry, executed either from a precompiled
+ * xfb image, or from a schema compiled by this process.
+ * */
+typedef struct SchemaEntry {
+    Char*   name;         /**< @b Name schema was registered with. */
+    Uint64  hash;         /**< @b Hash of source compiled, 0 for bundled schemas. */
+    XfbFile xfb;          /**< @b Loaders of a bundled or cached schema. */
+    Schema  schema;       /**< @b Loaders compiled at runtime, if schema wasn't cached. */
+    Loader* file_loader;  /**< @b Loader of file declaration, @c Null if none. */
+    Size    loader_count;
+} SchemaEntry;
+
+/**
+ * @b Schemas looked up by name, or compiled from source only if they're not known.
+ *
+ * Schemas bundled with CrossFile are embedded as xfb images, and looking them up
+ * parses nothing. Any other type description is compiled once, and when registry has
+ * a cache directory, it's written there as an xfb file named by hash of it's source,
+ * so that other processes compiling same source load it from there instead.
+ *
+ * Entries live till registry is de-initialized. Registry is not thread safe.
+ * */
+typedef struct SchemaRegistry {
+    Char*         cache_dir; /**< @b Where compiled schemas are cached, @c Null if not cached. */
+    SchemaEntry** entries;
+    Size          entry_count;
+    Size          entry_capacity;
+} SchemaRegistry;
+
+SchemaRegistry* schema_registry_init (SchemaRegistry* registry, CString cache_dir);
+SchemaRegistry* schema_registry_deinit (SchemaRegistry* registry);
+SchemaEntry*    schema_registry_find (SchemaRegistry* registry, CString name);
+SchemaEntry*    schema_registry_compile (
+    SchemaRegistry* registry,
+    CString         name,
+    CString         source,
+    Size            source_size
+);
+Loader*         schema_entry_find_loader (SchemaEntry* entry, CString type_name);
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_PARSER_REGISTRY_H
@@ -0,0 +1,1347 @@
+/**
+ * @file Aot.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <ctype.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+/* crossfile */
+#include "../../Stream/Stream.h"
+
+/* local includes */
+#include "Aot.h"
+#include "Insn.h"
+#include "Loader.h"
+#include "Packed.h"
+#include "Peephole.h"
+#include "Verify.h"
+#include "Vm.h"
+
+/**
+ * @b State shared by all emit methods while generating a single source file.
+ * */
+typedef struct AotEmitter {
+    FILE*    out;
+    CString  prefix;
+    Loader** loaders;
+    Size     loader_count;
+} AotEmitter;
+
+/* private method declarations */
+
+static inline Loader* aot_loader_prepare (Loader* loader);
+static inline Bool    aot_loader_is_fixed (Loader* loader);
+static inline Size    aot_elem_size (InsnType insn_type);
+static inline Size    aot_ordered_elem_size (InsnType insn_type);
+static inline Size    aot_find_loader (AotEmitter* e, Loader* loader);
+static inline void    aot_put_ident (FILE* out, CString name);
+static inline void    aot_put_string (FILE* out, CString str);
+static inline void    aot_put_entry_name (AotEmitter* e, Size l);
+static inline void    aot_emit_prelude (AotEmitter* e);
+static inline void    aot_emit_layout (AotEmitter* e, Size l, Size id);
+static inline Bool    aot_emit_insn (AotEmitter* e, Size l, Insn* insn, Bool uses_flags);
+static inline void    aot_emit_check (AotEmitter* e, Size l);
+static inline Bool    aot_emit_loader (AotEmitter* e, Size l);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Generate C source for given set of type loaders.
+ *
+ * Loaders that were never executed are optimized, encoded and verified first.
+ * Only loaders that pass verification can be compiled, and all loaders called
+ * by a loader in the set must also be part of the set.
+ *
+ * @param loaders Loaders to compile.
+ * @param loader_count Number of loaders.
+ * @param prefix Prefix of all generated symbols. Must be a valid C identifier.
+ * @param out Where generated source is written.
+ *
+ * @return @c loaders on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader** aot_emit_source (Loader** loaders, Size loader_count, CString prefix, FILE* out) {
+    RETURN_VALUE_IF (!loaders || !prefix || !out, Null, ERR_INVALID_ARGUMENTS);
+
+    for (Size l = 0; l < loader_count; l++) {
+        RETURN_VALUE_IF (
+            !loaders[l] || !aot_loader_prepare (loaders[l]),
+            Null,
+            "Type loader %zu can't be compiled ahead of time\n",
+            l
+        );
+    }
+
+    AotEmitter e = {.out = out, .prefix = prefix, .loaders = loaders, .loader_count = loader_count};
+
+    aot_emit_prelude (&e);
+
+    /* loaders call each other in any order */
+    for (Size l = 0; l < loader_count; l++) {
+        fprintf (
+            out,
+            "static int %s_loader_%zu (const uint8_t* data, size_t size, size_t* cursor_io, "
+            "uint8_t* mem, uint64_t* regs_io, size_t depth, void** vectors);\n",
+            prefix,
+            l
+        );
+    }
+    fprintf (out, "\n");
+
+    for (Size l = 0; l < loader_count; l++) {
+        RETURN_VALUE_IF (
+            !aot_emit_loader (&e, l),
+            Null,
+            "Failed to compile type loader \"%s\"\n",
+            loaders[l]->type_name ? loaders[l]->type_name : "<unnamed>"
+        );
+    }
+
+    /* public entry points start with zeroed registers, like a top level VM run */
+    for (Size l = 0; l < loader_count; l++) {
+        fprintf (out, "int ");
+        aot_put_entry_name (&e, l);
+        fprintf (
+            out,
+            " (const uint8_t* data, size_t size, size_t* cursor, void* mem, void** vectors) {\n"
+        );
+        fprintf (out, "    uint64_t regs[%d] = {0};\n", VM_REG_COUNT);
+        fprintf (out, "    if (!data || !cursor || *cursor > size || !vectors) {\n");
+        fprintf (out, "        return 0;\n");
+        fprintf (out, "    }\n");
+        fprintf (
+            out,
+            "    return %s_loader_%zu (data, size, cursor, (uint8_t*)mem, regs, 0, vectors);\n",
+            prefix,
+            l
+        );
+        fprintf (out, "}\n\n");
+    }
+
+    fprintf (out, "void %s_free_vectors (void* vectors) {\n", prefix);
+    fprintf (out, "    while (vectors) {\n");
+    fprintf (out, "        void* next = ((%s_vector_link*)vectors)->next;\n", prefix);
+    fprintf (out, "        free (vectors);\n");
+    fprintf (out, "        vectors = next;\n");
+    fprintf (out, "    }\n");
+    fprintf (out, "}\n\n");
+
+    fprintf (out, "#undef XFT_AOT_NEED\n");
+
+    return ferror (out) ? Null : loaders;
+}
+
+/**
+ * @b Generate C header declaring entry points of source generated for same loaders.
+ *
+ * @param loaders Loaders to declare.
+ * @param loader_count Number of loaders.
+ * @param prefix Prefix used when generating source.
+ * @param out Where generated header is written.
+ *
+ * @return @c loaders on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader** aot_emit_header (Loader** loaders, Size loader_count, CString prefix, FILE* out) {
+    RETURN_VALUE_IF (!loaders || !prefix || !out, Null, ERR_INVALID_ARGUMENTS);
+
+    AotEmitter e = {.out = out, .prefix = prefix, .loaders = loaders, .loader_count = loader_count};
+
+    fprintf (out, "/*\n");
+    fprintf (out, " * Type loaders compiled ahead of time from Xft bytecode.\n");
+    fprintf (out, " * Generated by xftaot, do not edit.\n");
+    fprintf (out, " * */\n\n");
+    fprintf (out, "#ifndef XFT_AOT_");
+    aot_put_ident (out, prefix);
+    fprintf (out, "_H\n#define XFT_AOT_");
+    aot_put_ident (out, prefix);
+    fprintf (out, "_H\n\n");
+    fprintf (out, "#include <stddef.h>\n#include <stdint.h>\n\n");
+
+    for (Size l = 0; l < loader_count; l++) {
+        RETURN_VALUE_IF (!loaders[l], Null, ERR_INVALID_ARGUMENTS);
+
+        if (loaders[l]->type_doc) {
+            fprintf (out, "/* ");
+            for (CString c = loaders[l]->type_doc; *c; c++) {
+                /* never let documentation close the comment */
+                fputc (*c == '\n' ? ' ' : (*c == '*' && c[1] == '/') ? '.' : *c, out);
+            }
+            fprintf (out, " */\n");
+        }
+
+        fprintf (out, "int ");
+        aot_put_entry_name (&e, l);
+        fprintf (
+            out,
+            " (const uint8_t* data, size_t size, size_t* cursor, void* mem, void** vectors);\n"
+        );
+    }
+
+    fprintf (out, "\n/* release memory of all vectors chained to list by load calls */\n");
+    fprintf (out, "void %s_free_vectors (void* vectors);\n", prefix);
+    fprintf (out, "\n#endif\n");
+
+    return ferror (out) ? Null : loaders;
+}
+
+/**
+ * @b Generate C source and header for given set of type loaders.
+ *
+ * @param loaders Loaders to compile.
+ * @param loader_count Number of loaders.
+ * @param prefix Prefix of all generated symbols.
+ * @param source_path Path of generated source file.
+ * @param header_path Path of generated header file. Can be @c Null.
+ *
+ * @return @c loaders on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader** aot_write (
+    Loader** loaders,
+    Size     loader_count,
+    CString  prefix,
+    CString  source_path,
+    CString  header_path
+) {
+    RETURN_VALUE_IF (!loaders || !prefix || !source_path, Null, ERR_INVALID_ARGUMENTS);
+
+    FILE* source = Null;
+    FILE* header = Null;
+
+    GOTO_HANDLER_IF (
+        !(source = fopen (source_path, "w")),
+        WRITE_FAILED,
+        "Failed to create \"%s\" : %s\n",
+        source_path,
+        strerror (errno)
+    );
+    GOTO_HANDLER_IF (
+        !aot_emit_source (loaders, loader_count, prefix, source),
+        WRITE_FAILED,
+        "Failed to generate type loader source\n"
+    );
+    /* streams are gone even if close fails, so handler must not close them again */
+    int closed = fclose (source);
+    source     = Null;
+    GOTO_HANDLER_IF (closed != 0, WRITE_FAILED, "Failed to flush \"%s\"\n", source_path);
+
+    if (header_path) {
+        GOTO_HANDLER_IF (
+            !(header = fopen (header_path, "w")),
+            WRITE_FAILED,
+            "Failed to create \"%s\" : %s\n",
+            header_path,
+            strerror (errno)
+        );
+        GOTO_HANDLER_IF (
+            !aot_emit_header (loaders, loader_count, prefix, header),
+            WRITE_FAILED,
+            "Failed to generate type loader header\n"
+        );
+        closed = fclose (header);
+        header = Null;
+        GOTO_HANDLER_IF (closed != 0, WRITE_FAILED, "Failed to flush \"%s\"\n", header_path);
+    }
+
+    return loaders;
+
+WRITE_FAILED:
+    /* never leave partially generated files behind for build system to pick up */
+    if (source) {
+        fclose (source);
+    }
+    if (header) {
+        fclose (header);
+    }
+
+    unlink (source_path);
+    if (header_path) {
+        unlink (header_path);
+    }
+
+    return Null;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Make sure given loader has verified packed code.
+ * */
+static inline Loader* aot_loader_prepare (Loader* loader) {
+    if (!loader->packed_code.code) {
+        RETURN_VALUE_IF (
+            !peephole_optimize_loader (loader, Null) ||
+                !packed_code_encode (
+                    &loader->packed_code,
+                    loader->insn_blocks,
+                    loader->insn_block_count
+                ),
+            Null,
+            "Failed to encode type loader\n"
+        );
+    }
+
+    if (loader->verify_status == LOADER_VERIFY_PENDING) {
+        loader_verify (loader);
+    }
+
+    return loader->verify_status == LOADER_VERIFY_PASSED ? loader : Null;
+}
+
+/**
+ * @b Whether every execution of given loader reads same number of bytes, analyzing
+ * it and loaders it calls on first use, like VM does before loading a vector.
+ * */
+static inline Bool aot_loader_is_fixed (Loader* loader) {
+    if (loader->fixed_status == LOADER_FIXED_PENDING) {
+        loader->fixed_status = LOADER_FIXED_ANALYZING;
+
+        Bool prepared = True;
+        for (Size r = 0; r < loader->loader_ref_count && prepared; r++) {
+            Loader* ref = loader->loader_refs[r];
+            if (ref) {
+                prepared = !!aot_loader_prepare (ref);
+                aot_loader_is_fixed (ref);
+            }
+        }
+
+        /* sets status to either yes or no, also breaking any recursion */
+        if (!prepared || !loader_analyze_fixed (loader)) {
+            loader->fixed_status = LOADER_FIXED_NO;
+        }
+    }
+
+    return loader->fixed_status == LOADER_FIXED_YES;
+}
+
+/**
+ * @b Element size of register, memory and array read/push/pop instructions,
+ * laid out in groups of four from @c INSN_TYPE_READ_R8 to @c INSN_TYPE_POP_A64.
+ * */
+static inline Size aot_elem_size (InsnType insn_type) {
+    return (Size)1 << ((insn_type - INSN_TYPE_READ_R8) & 3);
+}
+
+/**
+ * @b Element size of byte order specific array reads, laid out in groups of
+ * three from @c INSN_TYPE_READ_A16_LE to @c INSN_TYPE_READ_A64_BE.
+ * */
+static inline Size aot_ordered_elem_size (InsnType insn_type) {
+    return (Size)2 << ((insn_type - INSN_TYPE_READ_A16_LE) % 3);
+}
+
+/**
+ * @b Index of given loader in set being compiled.
+ *
+ * @return Index of loader if found.
+ * @return @c loader_count otherwise.
+ * */
+static inline Size aot_find_loader (AotEmitter* e, Loader* loader) {
+    for (Size l = 0; l < e->loader_count; l++) {
+        if (e->loaders[l] == loader) {
+            return l;
+        }
+    }
+
+    return e->loader_count;
+}
+
+/**
+ * @b Write given name as a C identifier, replacing everything else with underscores.
+ * */
+static inline void aot_put_ident (FILE* out, CString name) {
+    for (CString c = name; *c; c++) {
+        fputc (isalnum ((unsigned char)*c) ? *c : '_', out);
+    }
+}
+
+/**
+ * @b Write given string as a C string literal.
+ * */
+static inline void aot_put_string (FILE* out, CString str) {
+    fputc ('"', out);
+    for (CString c = str ? str : ""; *c; c++) {
+        unsigned char ch = (unsigned char)*c;
+        if (ch == '"' || ch == '\\') {
+            fprintf (out, "\\%c", ch);
+        } else if (ch == '\n') {
+            fprintf (out, "\\n");
+        } else if (isprint (ch)) {
+            fputc (ch, out);
+        } else {
+            /* always three digits, so following characters are never part of escape */
+            fprintf (out, "\\%03o", ch);
+        }
+    }
+    fputc ('"', out);
+}
+
+/**
+ * @b Write name of public entry point of a loader. Loaders without name, or with
+ * a name used by an earlier loader in set, get their index as suffix.
+ * */
+static inline void aot_put_entry_name (AotEmitter* e, Size l) {
+    CString name   = e->loaders[l]->type_name;
+    Bool    unique = name && *name;
+
+    for (Size p = 0; unique && p < l; p++) {
+        CString other = e->loaders[p]->type_name;
+        if (!other || strlen (other) != strlen (name)) {
+            continue;
+        }
+
+        /* names are compared as identifiers, since that's what ends up in source */
+        Bool same = True;
+        for (Size c = 0; same && name[c]; c++) {
+            same = (isalnum ((unsigned char)name[c]) ? name[c] : '_') ==
+                   (isalnum ((unsigned char)other[c]) ? other[c] : '_');
+        }
+        unique = !same;
+    }
+
+    fprintf (e->out, "%s_load_", e->prefix);
+    if (name && *name) {
+        aot_put_ident (e->out, name);
+    }
+    if (!unique) {
+        fprintf (e->out, "%s%zu", name && *name ? "_" : "", l);
+    }
+}
+
+/**
+ * @b Write includes and helpers used by generated loaders.
+ * */
+static inline void aot_emit_prelude (AotEmitter* e) {
+    FILE*   out = e->out;
+    CString p   = e->prefix;
+
+    fprintf (out, "/*\n");
+    fprintf (out, " * Type loaders compiled ahead of time from Xft bytecode.\n");
+    fprintf (out, " * Generated by xftaot, do not edit.\n");
+    fprintf (out, " * */\n\n");
+    fprintf (out, "#include <stddef.h>\n#include <stdint.h>\n#include <stdio.h>\n");
+    fprintf (out, "#include <stdlib.h>\n#include <string.h>\n\n");
+
+    /* swap decisions are baked in, so generated code must run on a host of same byte order */
+    fprintf (
+        out,
+        "#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != %s\n",
+        HOST_BYTE_ORDER_IS_LSB ? "__ORDER_LITTLE_ENDIAN__" : "__ORDER_BIG_ENDIAN__"
+    );
+    fprintf (
+        out,
+        "#    error \"type loaders were generated for a %s endian host\"\n",
+        HOST_BYTE_ORDER_IS_LSB ? "little" : "big"
+    );
+    fprintf (out, "#endif\n\n");
+
+    /* elements of a vector follow its link in one allocation, aligned for any type */
+    fprintf (out, "typedef union %s_vector_link {\n", p);
+    fprintf (out, "    void*       next;\n");
+    fprintf (out, "    max_align_t align;\n");
+    fprintf (out, "} %s_vector_link;\n\n", p);
+
+    fprintf (out, "/* fail if stream does not have n more bytes */\n");
+    fprintf (out, "#define XFT_AOT_NEED(n)                                                         \\\n");
+    fprintf (out, "    if ((size_t)(n) > size - cur) {                                             \\\n");
+    fprintf (out, "        return 0;                                                               \\\n");
+    fprintf (out, "    }\n\n");
+
+    static const struct {
+        int     bits;
+        CString bswap;
+    } swaps[] = {
+        {16, "__builtin_bswap16"},
+        {32, "__builtin_bswap32"},
+        {64, "__builtin_bswap64"},
+    };
+    for (Size s = 0; s < sizeof (swaps) / sizeof (swaps[0]); s++) {
+        int bits  = swaps[s].bits;
+        int bytes = bits >> 3;
+        fprintf (
+            out,
+            "static inline void %s_swap%d (uint8_t* dst, const uint8_t* src, size_t count) {\n",
+            p,
+            bits
+        );
+        fprintf (out, "    for (size_t i = 0; i < count; i++) {\n");
+        fprintf (out, "        uint%d_t v;\n", bits);
+        fprintf (out, "        memcpy (&v, src + %d * i, %d);\n", bytes, bytes);
+        fprintf (out, "        v = %s (v);\n", swaps[s].bswap);
+        fprintf (out, "        memcpy (dst + %d * i, &v, %d);\n", bytes, bytes);
+        fprintf (out, "    }\n");
+        fprintf (out, "}\n\n");
+    }
+
+    fprintf (out, "static inline uint64_t %s_pow (uint64_t base, uint64_t exp) {\n", p);
+    fprintf (out, "    uint64_t res = 1;\n");
+    fprintf (out, "    for (; exp; exp >>= 1, base *= base) {\n");
+    fprintf (out, "        res *= exp & 1 ? base : 1;\n");
+    fprintf (out, "    }\n");
+    fprintf (out, "    return res;\n");
+    fprintf (out, "}\n\n");
+
+    fprintf (out, "static inline uint64_t %s_isqrt (uint64_t x) {\n", p);
+    fprintf (out, "    uint64_t res = 0;\n");
+    fprintf (out, "    for (uint64_t bit = (uint64_t)1 << 62; bit; bit >>= 2) {\n");
+    fprintf (out, "        if (x >= res + bit) {\n");
+    fprintf (out, "            x   -= res + bit;\n");
+    fprintf (out, "            res  = (res >> 1) + bit;\n");
+    fprintf (out, "        } else {\n");
+    fprintf (out, "            res >>= 1;\n");
+    fprintf (out, "        }\n");
+    fprintf (out, "    }\n");
+    fprintf (out, "    return res;\n");
+    fprintf (out, "}\n\n");
+}
+
+/**
+ * @b Write a function reading one record of given struct layout, with all
+ * offsets and sizes as constants.
+ * */
+static inline void aot_emit_layout (AotEmitter* e, Size l, Size id) {
+    FILE*         out    = e->out;
+    StructLayout* layout = e->loaders[l]->struct_layouts + id;
+
+    fprintf (
+        out,
+        "static inline void %s_layout_%zu_%zu (uint8_t* dst, const uint8_t* src) {\n",
+        e->prefix,
+        l,
+        id
+    );
+
+    if (layout->is_dense && !layout->needs_swap) {
+        fprintf (out, "    memcpy (dst, src, %zu);\n", layout->stream_size);
+    } else {
+        for (Size f = 0; f < layout->field_count; f++) {
+            StructLayoutField* field = layout->fields + f;
+            if (field->swap && field->size > 1) {
+                fprintf (
+                    out,
+                    "    %s_swap%zu (dst + %zu, src + %zu, %zu);\n",
+                    e->prefix,
+                    field->size * 8,
+                    field->mem_off,
+                    field->stream_off,
+                    field->count
+                );
+            } else {
+                fprintf (
+                    out,
+                    "    memcpy (dst + %zu, src + %zu, %zu);\n",
+                    field->mem_off,
+                    field->stream_off,
+                    field->size * field->count
+                );
+            }
+        }
+    }
+
+    fprintf (out, "}\n\n");
+}
+
+/**
+ * @b Write C statements equivalent to a single instruction. Instruction must be
+ * part of a verified loader, so register, memory and stack operands are trusted.
+ * */
+static inline Bool aot_emit_insn (AotEmitter* e, Size l, Insn* insn, Bool uses_flags) {
+    FILE*   out    = e->out;
+    CString p      = e->prefix;
+    Loader* loader = e->loaders[l];
+
+    switch (insn->insn_type) {
+        case INSN_TYPE_SET_REG :
+            fprintf (
+                out,
+                "    r%u = %lluull;\n",
+                insn->insn.set_reg.reg,
+                (unsigned long long)insn->insn.set_reg.imm
+            );
+            return True;
+
+        case INSN_TYPE_READ_R8 ... INSN_TYPE_READ_R64 : {
+            Size n = aot_elem_size (insn->insn_type);
+            fprintf (out, "    XFT_AOT_NEED (%zu);\n", n);
+            fprintf (out, "    {\n");
+            fprintf (out, "        uint%zu_t v;\n", n * 8);
+            fprintf (out, "        memcpy (&v, data + cur, %zu);\n", n);
+            fprintf (out, "        r%u  = v;\n", insn->insn.read_reg.reg);
+            fprintf (out, "        cur += %zu;\n", n);
+            fprintf (out, "    }\n");
+            return True;
+        }
+
+        case INSN_TYPE_READ_M8 ... INSN_TYPE_READ_M64 : {
+            Size n = aot_elem_size (insn->insn_type);
+            fprintf (out, "    XFT_AOT_NEED (%zu);\n", n);
+            fprintf (
+                out,
+                "    memcpy (mem + %llu, data + cur, %zu);\n",
+                (unsigned long long)insn->insn.read_mem.mem_off,
+                n
+            );
+            fprintf (out, "    cur += %zu;\n", n);
+            return True;
+        }
+
+        case INSN_TYPE_READ_A8 ... INSN_TYPE_READ_A64 :
+        case INSN_TYPE_READ_A16_LE ... INSN_TYPE_READ_A64_BE : {
+            Bool ordered = insn->insn_type >= INSN_TYPE_READ_A16_LE;
+            Size esize   = ordered ? aot_ordered_elem_size (insn->insn_type) :
+                                     aot_elem_size (insn->insn_type);
+            Size count   = insn->insn.read_arr.elem_count;
+            Bool swap    = ordered && (insn->insn_type <= INSN_TYPE_READ_A64_LE ?
+                                           HOST_BYTE_ORDER_IS_MSB :
+                                           HOST_BYTE_ORDER_IS_LSB);
+
+            /* verifier made sure array fits in memory, so size does not overflow */
+            fprintf (out, "    XFT_AOT_NEED (%zu);\n", esize * count);
+            if (swap) {
+                fprintf (
+                    out,
+                    "    %s_swap%zu (mem + %llu, data + cur, %zu);\n",
+                    p,
+                    esize * 8,
+                    (unsigned long long)insn->insn.read_arr.mem_off,
+                    count
+                );
+            } else {
+                fprintf (
+                    out,
+                    "    memcpy (mem + %llu, data + cur, %zu);\n",
+                    (unsigned long long)insn->insn.read_arr.mem_off,
+                    esize * count
+                );
+            }
+            fprintf (out, "    cur += %zu;\n", esize * count);
+            return True;
+        }
+
+        case INSN_TYPE_PUSH_R8 ... INSN_TYPE_PUSH_R64 : {
+            Size n = aot_elem_size (insn->insn_type);
+            fprintf (out, "    {\n");
+            fprintf (out, "        uint%zu_t v = (uint%zu_t)r%u;\n", n * 8, n * 8, insn->insn.push_reg.reg);
+            fprintf (out, "        memcpy (stk + sp, &v, %zu);\n", n);
+            fprintf (out, "        sp += %zu;\n", n);
+            fprintf (out, "    }\n");
+            return True;
+        }
+
+        case INSN_TYPE_POP_R8 ... INSN_TYPE_POP_R64 : {
+            Size n = aot_elem_size (insn->insn_type);
+            fprintf (out, "    {\n");
+            fprintf (out, "        uint%zu_t v;\n", n * 8);
+            fprintf (out, "        sp -= %zu;\n", n);
+            fprintf (out, "        memcpy (&v, stk + sp, %zu);\n", n);
+            fprintf (out, "        r%u = v;\n", insn->insn.pop_reg.reg);
+            fprintf (out, "    }\n");
+            return True;
+        }
+
+        case INSN_TYPE_PUSH_M8 ... INSN_TYPE_PUSH_M64 :
+        case INSN_TYPE_PUSH_A8 ... INSN_TYPE_PUSH_A64 : {
+            Bool is_arr = insn->insn_type >= INSN_TYPE_PUSH_A8;
+            Size n      = aot_elem_size (insn->insn_type) *
+                     (is_arr ? insn->insn.push_arr.elem_count : 1);
+            fprintf (
+                out,
+                "    memcpy (stk + sp, mem + %llu, %zu);\n",
+                (unsigned long long)insn->insn.push_mem.mem_off,
+                n
+            );
+            fprintf (out, "    sp += %zu;\n", n);
+            return True;
+        }
+
+        case INSN_TYPE_POP_M8 ... INSN_TYPE_POP_M64 :
+        case INSN_TYPE_POP_A8 ... INSN_TYPE_POP_A64 : {
+            Bool is_arr = insn->insn_type >= INSN_TYPE_POP_A8;
+            Size n      = aot_elem_size (insn->insn_type) *
+                     (is_arr ? insn->insn.pop_arr.elem_count : 1);
+            fprintf (out, "    sp -= %zu;\n", n);
+            fprintf (
+                out,
+                "    memcpy (mem + %llu, stk + sp, %zu);\n",
+                (unsigned long long)insn->insn.pop_mem.mem_off,
+                n
+            );
+            return True;
+        }
+
+        case INSN_TYPE_READ_STRUCT : {
+            Size          id     = insn->insn.read_struct.layout_id;
+            StructLayout* layout = loader->struct_layouts + id;
+            fprintf (out, "    XFT_AOT_NEED (%zu);\n", layout->stream_size);
+            fprintf (
+                out,
+                "    %s_layout_%zu_%zu (mem + %llu, data + cur);\n",
+                p,
+                l,
+                id,
+                (unsigned long long)insn->insn.read_struct.mem_off
+            );
+            fprintf (out, "    cur += %zu;\n", layout->stream_size);
+            return True;
+        }
+
+        case INSN_TYPE_READ_STRUCT_A : {
+            Size          id     = insn->insn.read_struct_arr.layout_id;
+            Size          count  = insn->insn.read_struct_arr.elem_count;
+            Size          stride = insn->insn.read_struct_arr.mem_stride;
+            Uint64        off    = insn->insn.read_struct_arr.mem_off;
+            StructLayout* layout = loader->struct_layouts + id;
+            Size          nbytes = count * layout->stream_size;
+
+            if (!count) {
+                return True;
+            }
+
+            fprintf (out, "    XFT_AOT_NEED (%zu);\n", nbytes);
+            if (layout->is_dense && !layout->needs_swap && stride == layout->stream_size) {
+                fprintf (
+                    out,
+                    "    memcpy (mem + %llu, data + cur, %zu);\n",
+                    (unsigned long long)off,
+                    nbytes
+                );
+            } else {
+                fprintf (out, "    for (size_t i = 0; i < %zu; i++) {\n", count);
+                fprintf (
+                    out,
+                    "        %s_layout_%zu_%zu (mem + %llu + i * %zu, data + cur + i * %zu);\n",
+                    p,
+                    l,
+                    id,
+                    (unsigned long long)off,
+                    stride,
+                    layout->stream_size
+                );
+                fprintf (out, "    }\n");
+            }
+            fprintf (out, "    cur += %zu;\n", nbytes);
+            return True;
+        }
+
+        case INSN_TYPE_SEEK_FWD :
+            fprintf (out, "    XFT_AOT_NEED (%zu);\n", insn->insn.seek.num_bytes);
+            fprintf (out, "    cur += %zu;\n", insn->insn.seek.num_bytes);
+            return True;
+
+        case INSN_TYPE_SEEK_BAK :
+            fprintf (out, "    if (%zu > cur) {\n", insn->insn.seek.num_bytes);
+            fprintf (out, "        return 0;\n");
+            fprintf (out, "    }\n");
+            fprintf (out, "    cur -= %zu;\n", insn->insn.seek.num_bytes);
+            return True;
+
+        case INSN_TYPE_SEEK_R :
+            fprintf (out, "    if (r%u > size) {\n", insn->insn.seek_reg.reg);
+            fprintf (out, "        return 0;\n");
+            fprintf (out, "    }\n");
+            fprintf (out, "    cur = r%u;\n", insn->insn.seek_reg.reg);
+            return True;
+
+        case INSN_TYPE_TELL :
+            fprintf (out, "    r%u = cur;\n", insn->insn.tell.reg);
+            return True;
+
+        case INSN_TYPE_ADD :
+        case INSN_TYPE_SUB :
+        case INSN_TYPE_MUL : {
+            CString op   = insn->insn_type == INSN_TYPE_ADD ? "add" :
+                           insn->insn_type == INSN_TYPE_SUB ? "sub" :
+                                                              "mul";
+            Uint8   rres = insn->insn.binop.rres;
+            Uint8   r1   = insn->insn.binop.r1;
+            Uint8   r2   = insn->insn.binop.r2;
+
+            /* flags are only computed when some jump tests them */
+            if (uses_flags) {
+                fprintf (out, "    {\n");
+                fprintf (out, "        uint64_t a = r%u, b = r%u;\n", r1, r2);
+                fprintf (out, "        int64_t  s;\n");
+                fprintf (out, "        carry    = __builtin_%s_overflow (a, b, &r%u);\n", op, rres);
+                fprintf (
+                    out,
+                    "        overflow = __builtin_%s_overflow ((int64_t)a, (int64_t)b, &s);\n",
+                    op
+                );
+                fprintf (out, "    }\n");
+            } else {
+                CString sym = insn->insn_type == INSN_TYPE_ADD ? "+" :
+                              insn->insn_type == INSN_TYPE_SUB ? "-" :
+                                                                 "*";
+                fprintf (out, "    r%u = r%u %s r%u;\n", rres, r1, sym, r2);
+            }
+            return True;
+        }
+
+        case INSN_TYPE_DIV :
+        case INSN_TYPE_MOD :
+            fprintf (out, "    if (!r%u) {\n", insn->insn.binop.r2);
+            fprintf (out, "        return 0;\n");
+            fprintf (out, "    }\n");
+            fprintf (
+                out,
+                "    r%u = r%u %c r%u;\n",
+                insn->insn.binop.rres,
+                insn->insn.binop.r1,
+                insn->insn_type == INSN_TYPE_DIV ? '/' : '%',
+                insn->insn.binop.r2
+            );
+            return True;
+
+        case INSN_TYPE_POW :
+            fprintf (
+                out,
+                "    r%u = %s_pow (r%u, r%u);\n",
+                insn->insn.binop.rres,
+                p,
+                insn->insn.binop.r1,
+                insn->insn.binop.r2
+            );
+            return True;
+
+        case INSN_TYPE_SQRT :
+            fprintf (out, "    r%u = %s_isqrt (r%u);\n", insn->insn.unop.rres, p, insn->insn.unop.r1);
+            return True;
+
+        case INSN_TYPE_ABS :
+            fprintf (
+                out,
+                "    r%u = (int64_t)r%u < 0 ? -r%u : r%u;\n",
+                insn->insn.unop.rres,
+                insn->insn.unop.r1,
+                insn->insn.unop.r1,
+                insn->insn.unop.r1
+            );
+            return True;
+
+        case INSN_TYPE_NOT :
+            fprintf (out, "    r%u = ~r%u;\n", insn->insn.unop.rres, insn->insn.unop.r1);
+            return True;
+
+        case INSN_TYPE_AND ... INSN_TYPE_XNOR :
+        case INSN_TYPE_LSHIFT ... INSN_TYPE_CMPGT : {
+            static const CString exprs[INSN_TYPE_MAX] = {
+                [INSN_TYPE_AND]    = "a & b",
+                [INSN_TYPE_OR]     = "a | b",
+                [INSN_TYPE_XOR]    = "a ^ b",
+                [INSN_TYPE_NAND]   = "~(a & b)",
+                [INSN_TYPE_NOR]    = "~(a | b)",
+                [INSN_TYPE_XNOR]   = "~(a ^ b)",
+                [INSN_TYPE_LSHIFT] = "b < 64 ? a << b : 0",
+                [INSN_TYPE_RSHIFT] = "b < 64 ? a >> b : 0",
+                [INSN_TYPE_ROL]    = "(a << (b & 63)) | (a >> ((64 - (b & 63)) & 63))",
+                [INSN_TYPE_ROR]    = "(a >> (b & 63)) | (a << ((64 - (b & 63)) & 63))",
+                [INSN_TYPE_CMPEQ]  = "a == b",
+                [INSN_TYPE_CMPLE]  = "a <= b",
+                [INSN_TYPE_CMPLT]  = "a < b",
+                [INSN_TYPE_CMPGE]  = "a >= b",
+                [INSN_TYPE_CMPGT]  = "a > b",
+            };
+            fprintf (out, "    {\n");
+            fprintf (
+                out,
+                "        uint64_t a = r%u, b = r%u;\n",
+                insn->insn.binop.r1,
+                insn->insn.binop.r2
+            );
+            fprintf (out, "        r%u = %s;\n", insn->insn.binop.rres, exprs[insn->insn_type]);
+            fprintf (out, "    }\n");
+            return True;
+        }
+
+        case INSN_TYPE_JA ... INSN_TYPE_JC : {
+            Uint8   r    = insn->insn.jmp.reg;
+            Char    cond[32];
+            CString test = cond;
+            switch (insn->insn_type) {
+                case INSN_TYPE_JA :
+                    snprintf (cond, sizeof (cond), "(int64_t)r%u > 0", r);
+                    break;
+                case INSN_TYPE_JB :
+                    snprintf (cond, sizeof (cond), "(int64_t)r%u < 0", r);
+                    break;
+                case INSN_TYPE_JZ :
+                    snprintf (cond, sizeof (cond), "!r%u", r);
+                    break;
+                case INSN_TYPE_JO :
+                    test = "overflow";
+                    break;
+                default :
+                    test = "carry";
+                    break;
+            }
+            fprintf (out, "    if (%s) {\n", test);
+            fprintf (out, "        goto block_%zu;\n", insn->insn.jmp.block_sel);
+            fprintf (out, "    }\n");
+            return True;
+        }
+
+        case INSN_TYPE_CALL_TYPE_LOADER : {
+            Loader* callee = loader->loader_refs[insn->insn.call_type_loader.type_load_sel];
+            Size    c      = aot_find_loader (e, callee);
+            RETURN_VALUE_IF (
+                c >= e->loader_count,
+                False,
+                "Type loader \"%s\" is called but not compiled\n",
+                callee->type_name ? callee->type_name : "<unnamed>"
+            );
+
+            fprintf (out, "    if (r0 > %zu || %zu > %zu - r0) {\n", loader->alloc_size, callee->alloc_size, loader->alloc_size);
+            fprintf (out, "        return 0;\n");
+            fprintf (out, "    }\n");
+            fprintf (out, "    {\n");
+            fprintf (out, "        uint64_t args[%d] = {r0, r1, r2, r3, r4, r5, r6, r7};\n", VM_REG_COUNT);
+            fprintf (
+                out,
+                "        if (!%s_loader_%zu (data, size, &cur, mem + r0, args, depth + 1, "
+                "vectors)) {\n",
+                p,
+                c
+            );
+            fprintf (out, "            return 0;\n");
+            fprintf (out, "        }\n");
+            fprintf (out, "        r0 = args[0];\n");
+            fprintf (out, "    }\n");
+            return True;
+        }
+
+        case INSN_TYPE_CALL_TYPE_LOADER_A : {
+            Loader* callee = loader->loader_refs[insn->insn.call_type_loader_arr.type_load_sel];
+            Size    stride = insn->insn.call_type_loader_arr.mem_stride;
+            Size    c      = aot_find_loader (e, callee);
+            RETURN_VALUE_IF (
+                c >= e->loader_count,
+                False,
+                "Type loader \"%s\" is called but not compiled\n",
+                callee->type_name ? callee->type_name : "<unnamed>"
+            );
+
+            /* generated code loads elements sequentially, same as VM without a pool */
+            fprintf (
+                out,
+                "    for (uint64_t i = 0, n = r%u; i < n; i++) {\n",
+                insn->insn.call_type_loader_arr.count_reg
+            );
+            fprintf (out, "        uint64_t off = 0;\n");
+            fprintf (
+                out,
+                "        if (__builtin_mul_overflow (i, (uint64_t)%zu, &off) ||\n",
+                stride
+            );
+            fprintf (out, "            __builtin_add_overflow (off, r0, &off) ||\n");
+            fprintf (
+                out,
+                "            off > %zu || %zu > %zu - off) {\n",
+                loader->alloc_size,
+                callee->alloc_size,
+                loader->alloc_size
+            );
+            fprintf (out, "            return 0;\n");
+            fprintf (out, "        }\n");
+            fprintf (
+                out,
+                "        uint64_t args[%d] = {off, r1, r2, r3, r4, r5, r6, r7};\n",
+                VM_REG_COUNT
+            );
+            fprintf (
+                out,
+                "        if (!%s_loader_%zu (data, size, &cur, mem + off, args, depth + 1, "
+                "vectors)) {\n",
+                p,
+                c
+            );
+            fprintf (out, "            return 0;\n");
+            fprintf (out, "        }\n");
+            fprintf (out, "    }\n");
+            return True;
+        }
+
+        /* memory of elements is chained to caller's vector list, which owns it like a VM does */
+        case INSN_TYPE_CALL_TYPE_LOADER_V : {
+            Loader* callee = loader->loader_refs[insn->insn.call_type_loader_vec.type_load_sel];
+            Uint64  off    = insn->insn.call_type_loader_vec.mem_off;
+            Size    c      = aot_find_loader (e, callee);
+            RETURN_VALUE_IF (
+                c >= e->loader_count,
+                False,
+                "Type loader \"%s\" is called but not compiled\n",
+                callee->type_name ? callee->type_name : "<unnamed>"
+            );
+            RETURN_VALUE_IF (
+                off > loader->alloc_size || sizeof (VmVector) > loader->alloc_size - off,
+                False,
+                "Vector of type loader \"%s\" is out of bounds of its object\n",
+                loader->type_name ? loader->type_name : "<unnamed>"
+            );
+
+            fprintf (out, "    {\n");
+            fprintf (
+                out,
+                "        struct {\n            void*    data;\n            uint64_t count;\n"
+                "        } vec = {NULL, r%u};\n",
+                insn->insn.call_type_loader_vec.count_reg
+            );
+            fprintf (out, "        uint64_t nbytes = 0;\n");
+            fprintf (
+                out,
+                "        if (__builtin_mul_overflow (vec.count, (uint64_t)%zu, &nbytes) ||\n",
+                callee->alloc_size
+            );
+            fprintf (out, "            nbytes > SIZE_MAX - sizeof (%s_vector_link)) {\n", p);
+            fprintf (out, "            return 0;\n");
+            fprintf (out, "        }\n");
+
+            /* don't trust a corrupt count to allocate more elements than stream can fill */
+            if (aot_loader_is_fixed (callee) && callee->fixed_stream_size) {
+                fprintf (
+                    out,
+                    "        if (vec.count > (size - cur) / %zu) {\n",
+                    callee->fixed_stream_size
+                );
+                fprintf (out, "            return 0;\n");
+                fprintf (out, "        }\n");
+            }
+
+            fprintf (out, "        if (vec.count) {\n");
+            fprintf (
+                out,
+                "            %s_vector_link* link = calloc (1, sizeof (*link) + nbytes);\n",
+                p
+            );
+            fprintf (out, "            if (!link) {\n");
+            fprintf (out, "                return 0;\n");
+            fprintf (out, "            }\n");
+            fprintf (out, "            link->next = *vectors;\n");
+            fprintf (out, "            *vectors   = link;\n");
+            fprintf (out, "            vec.data   = link + 1;\n");
+            fprintf (out, "        }\n");
+
+            /* elements start from caller's registers, with r0 as their offset in vector */
+            fprintf (out, "        for (uint64_t i = 0; i < vec.count; i++) {\n");
+            fprintf (
+                out,
+                "            uint64_t args[%d] = {i * %zu, r1, r2, r3, r4, r5, r6, r7};\n",
+                VM_REG_COUNT,
+                callee->alloc_size
+            );
+            fprintf (
+                out,
+                "            uint8_t* elem = (uint8_t*)vec.data + args[0];\n"
+                "            if (!%s_loader_%zu (data, size, &cur, elem, args, depth + 1, vectors)) {\n",
+                p,
+                c
+            );
+            fprintf (out, "                return 0;\n");
+            fprintf (out, "            }\n");
+            fprintf (out, "        }\n");
+            fprintf (
+                out,
+                "        memcpy (mem + %llu, &vec, sizeof (vec));\n",
+                (unsigned long long)off
+            );
+            fprintf (out, "    }\n");
+            return True;
+        }
+
+        case INSN_TYPE_PINFO :
+        case INSN_TYPE_PDBG :
+        case INSN_TYPE_PERR :
+            fprintf (
+                out,
+                "    fprintf (%s, \"[XFT VM %s] %%s\\n\", ",
+                insn->insn_type == INSN_TYPE_PERR ? "stderr" : "stdout",
+                insn->insn_type == INSN_TYPE_PINFO ? "INFO" :
+                insn->insn_type == INSN_TYPE_PDBG  ? "DEBUG" :
+                                                     "ERROR"
+            );
+            aot_put_string (out, insn->insn.print.msg);
+            fprintf (out, ");\n");
+            return True;
+
+        case INSN_TYPE_EXIT_SUCCESS :
+            fprintf (out, "    goto done;\n");
+            return True;
+
+        case INSN_TYPE_EXIT_FAILURE :
+            fprintf (out, "    return 0;\n");
+            return True;
+
+        case INSN_TYPE_JCMP : {
+            static const CString ops[INSN_TYPE_MAX] = {
+                [INSN_TYPE_CMPEQ] = "==",
+                [INSN_TYPE_CMPLE] = "<=",
+                [INSN_TYPE_CMPLT] = "<",
+                [INSN_TYPE_CMPGE] = ">=",
+                [INSN_TYPE_CMPGT] = ">",
+            };
+            fprintf (out, "    {\n");
+            fprintf (out, "        uint64_t a = r%u;\n", insn->insn.jcmp.r1);
+            fprintf (
+                out,
+                "        r%u = %lluull;\n",
+                insn->insn.jcmp.rimm,
+                (unsigned long long)insn->insn.jcmp.imm
+            );
+            fprintf (
+                out,
+                "        r%u = a %s %lluull;\n",
+                insn->insn.jcmp.rres,
+                ops[insn->insn.jcmp.cmp],
+                (unsigned long long)insn->insn.jcmp.imm
+            );
+            fprintf (out, "        if (r%u == %d) {\n", insn->insn.jcmp.rres, insn->insn.jcmp.jump_if ? 1 : 0);
+            fprintf (out, "            goto block_%zu;\n", insn->insn.jcmp.block_sel);
+            fprintf (out, "        }\n");
+            fprintf (out, "    }\n");
+            return True;
+        }
+
+        /* dense tables become a C switch for the host compiler to turn into a jump table */
+        case INSN_TYPE_SWITCH : {
+            SwitchTable* table = loader->switch_tables + insn->insn.switch_table.table_id;
+            Uint8        r     = insn->insn.switch_table.reg;
+            if (table->dense) {
+                fprintf (out, "    switch (r%u) {\n", r);
+                for (Size v = 0; v < table->dense_count; v++) {
+                    if (table->dense[v] != SWITCH_NO_BLOCK) {
+                        fprintf (
+                            out,
+                            "        case %lluull :\n            goto block_%zu;\n",
+                            (unsigned long long)(table->cases[0].first + v),
+                            table->dense[v]
+                        );
+                    }
+                }
+                fprintf (out, "        default :\n            break;\n");
+                fprintf (out, "    }\n");
+            } else {
+                for (Size c = 0; c < table->case_count; c++) {
+                    fprintf (
+                        out,
+                        "    if (r%u >= %lluull && r%u <= %lluull) {\n",
+                        r,
+                        (unsigned long long)table->cases[c].first,
+                        r,
+                        (unsigned long long)table->cases[c].last
+                    );
+                    fprintf (out, "        goto block_%zu;\n", table->cases[c].block_sel);
+                    fprintf (out, "    }\n");
+                }
+            }
+            return True;
+        }
+
+        /* generated code has no validation level, and checks every object */
+        case INSN_TYPE_CHECK :
+            return True;
+
+        default :
+            RETURN_VALUE_IF_REACHED (False, "Instruction %d can't be compiled\n", insn->insn_type);
+    }
+}
+
+/**
+ * @b Write tests of terms in check table of a loader. Where VM checks these once over all
+ * objects loaded by a call, generated code checks every object right after it's loaded.
+ * */
+static inline void aot_emit_check (AotEmitter* e, Size l) {
+    static const CString ops[CHECK_CMP_MAX] = {
+        [CHECK_CMP_EQ] = "==",
+        [CHECK_CMP_NE] = "!=",
+        [CHECK_CMP_LT] = "<",
+        [CHECK_CMP_LE] = "<=",
+        [CHECK_CMP_GT] = ">",
+        [CHECK_CMP_GE] = ">=",
+    };
+
+    FILE*       out   = e->out;
+    CheckTable* check = &e->loaders[l]->check;
+
+    for (Size t = 0; t < check->term_count; t++) {
+        CheckTerm* term = check->terms + t;
+        fprintf (out, "    {\n");
+        fprintf (out, "        uint%u_t v;\n", term->size * 8);
+        fprintf (out, "        memcpy (&v, mem + %zu, %u);\n", term->mem_off, term->size);
+        fprintf (
+            out,
+            "        if (!((uint64_t)v %s %lluull)) {\n",
+            ops[term->cmp],
+            (unsigned long long)term->value
+        );
+        fprintf (out, "            fprintf (stderr, \"[XFT VM ERROR] %%s\\n\", ");
+        aot_put_string (out, term->msg ? term->msg : "Assertion failed");
+        fprintf (out, ");\n");
+        fprintf (out, "            return 0;\n");
+        fprintf (out, "        }\n");
+        fprintf (out, "    }\n");
+    }
+}
+
+/**
+ * @b Write function executing given loader, along with functions for it's struct layouts.
+ * */
+static inline Bool aot_emit_loader (AotEmitter* e, Size l) {
+    FILE*   out    = e->out;
+    CString p      = e->prefix;
+    Loader* loader = e->loaders[l];
+
+    Size       block_count = 0;
+    InsnBlock* blocks      = packed_code_decode (&loader->packed_code, &block_count);
+    RETURN_VALUE_IF (!blocks, False, "Failed to decode type loader\n");
+
+    /* labels are only emitted for blocks that are jumped to, flags only if they're tested */
+    Bool* is_target  = ALLOCATE (Bool, block_count + 1);
+    Bool  uses_flags = False;
+    Bool  uses_done  = False;
+    GOTO_HANDLER_IF (!is_target, EMIT_FAILED, ERR_OUT_OF_MEMORY);
+
+    for (Size b = 0; b < block_count; b++) {
+        for (Size i = 0; i < blocks[b].insn_count; i++) {
+            Insn* insn = blocks[b].insns + i;
+            switch (insn->insn_type) {
+                case INSN_TYPE_JA ... INSN_TYPE_JC :
+                    is_target[insn->insn.jmp.block_sel] = True;
+                    uses_flags |= insn->insn_type == INSN_TYPE_JO ||
+                                  insn->insn_type == INSN_TYPE_JC;
+                    break;
+                case INSN_TYPE_JCMP :
+                    is_target[insn->insn.jcmp.block_sel] = True;
+                    break;
+                case INSN_TYPE_SWITCH : {
+                    SwitchTable* table = loader->switch_tables + insn->insn.switch_table.table_id;
+                    for (Size c = 0; c < table->case_count; c++) {
+                        is_target[table->cases[c].block_sel] = True;
+                    }
+                    break;
+                }
+                case INSN_TYPE_EXIT_SUCCESS :
+                    uses_done = True;
+                    break;
+                default :
+                    break;
+            }
+        }
+    }
+
+    for (Size id = 0; id < loader->struct_layout_count; id++) {
+        aot_emit_layout (e, l, id);
+    }
+
+    fprintf (out, "/* type loader \"");
+    aot_put_ident (out, loader->type_name ? loader->type_name : "<unnamed>");
+    fprintf (out, "\", %zu bytes */\n", loader->alloc_size);
+    fprintf (
+        out,
+        "static int %s_loader_%zu (const uint8_t* data, size_t size, size_t* cursor_io, "
+        "uint8_t* mem, uint64_t* regs_io, size_t depth, void** vectors) {\n",
+        p,
+        l
+    );
+    fprintf (out, "    if (depth >= %d) {\n", VM_MAX_CALL_DEPTH);
+    fprintf (out, "        return 0;\n");
+    fprintf (out, "    }\n\n");
+    fprintf (out, "    size_t cur = *cursor_io;\n");
+    for (Size r = 0; r < VM_REG_COUNT; r++) {
+        fprintf (out, "    uint64_t r%zu = regs_io[%zu];\n", r, r);
+    }
+    if (loader->max_stack_size) {
+        fprintf (out, "    uint8_t  stk[%zu];\n", loader->max_stack_size);
+        fprintf (out, "    size_t   sp = 0;\n");
+    }
+    if (uses_flags) {
+        fprintf (out, "    _Bool    carry = 0, overflow = 0;\n");
+        fprintf (out, "    (void)carry;\n    (void)overflow;\n");
+    }
+    fprintf (out, "    (void)data;\n    (void)size;\n    (void)mem;\n    (void)vectors;\n");
+    for (Size r = 1; r < VM_REG_COUNT; r++) {
+        fprintf (out, "    (void)r%zu;\n", r);
+    }
+    fprintf (out, "\n");
+
+    for (Size b = 0; b < block_count; b++) {
+        if (is_target[b]) {
+            fprintf (out, "block_%zu:\n", b);
+        }
+        for (Size i = 0; i < blocks[b].insn_count; i++) {
+            GOTO_HANDLER_IF (
+                !aot_emit_insn (e, l, blocks[b].insns + i, uses_flags),
+                EMIT_FAILED,
+                "Failed to compile instruction %zu of block %zu\n",
+                i,
+                b
+            );
+        }
+    }
+
+    /* falling off the end of last block is a successful exit */
+    if (uses_done) {
+        fprintf (out, "done:\n");
+    }
+    aot_emit_check (e, l);
+    fprintf (out, "    *cursor_io = cur;\n");
+    fprintf (out, "    regs_io[0] = r0;\n");
+    fprintf (out, "    return 1;\n");
+    fprintf (out, "}\n\n");
+
+    for (Size b = 0; b < block_count; b++) {
+        insn_block_deinit (blocks + b);
+    }
+    FREE (blocks);
+    FREE (is_target);
+
+    return True;
+
+EMIT_FAILED:
+    for (Size b = 0; b < block_count; b++) {
+        insn_block_deinit (blocks + b);
+    }
+    FREE (blocks);
+    if (is_target) {
+        FREE (is_target);
+    }
+
+    return False;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file Aot.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_VM_AOT_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_VM_AOT_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* libc */
+#include <stdio.h>
+
+/* local includes */
+#include "Loader.h"
+
+/**
+ * Ahead of time backend for type loaders. A set of verified loaders is translated
+ * to plain C, one function per loader :
+ * - blocks become labels, and jumps become gotos,
+ * - registers and stream cursor become locals,
+ * - struct layouts become straight line memcpy and byte swaps with constant sizes,
+ * - every check the verifier proved redundant is left out.
+ *
+ * For every loader, generated source has a public entry point
+ *
+ *     int <prefix>_load_<type_name> (
+ *         const uint8_t* data, size_t size, size_t* cursor, void* mem, void** vectors
+ *     );
+ *
+ * that returns 1 on success and 0 otherwise, just like running the loader in VM
+ * on a byte stream. Elements of vectors are allocated by generated code and chained
+ * to @c *vectors, which must be @c NULL initially, and is released with
+ * @c <prefix>_free_vectors whether load succeeds or not. Generated code only depends
+ * on libc, and only builds for hosts with same byte order as the one that generated it.
+ * */
+
+PUBLIC Loader** aot_emit_source (Loader** loaders, Size loader_count, CString prefix, FILE* out);
+PUBLIC Loader** aot_emit_header (Loader** loaders, Size loader_count, CString prefix, FILE* out);
+PUBLIC Loader** aot_write (
+    Loader** loaders,
+    Size     loader_count,
+    CString  prefix,
+    CString  source_path,
+    CString  header_path
+);
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_VM_AOT_H
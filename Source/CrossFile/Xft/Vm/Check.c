@@ -0,0 +1,182 @@
+/**
+ * @file Check.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <memory.h>
+
+/* local includes */
+#include "Check.h"
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Free all terms of given check table.
+ *
+ * @return @c table on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC CheckTable* check_table_deinit (CheckTable* table) {
+    RETURN_VALUE_IF (!table, Null, ERR_INVALID_ARGUMENTS);
+
+    if (table->terms) {
+        FREE (table->terms);
+    }
+
+    memset (table, 0, sizeof (CheckTable));
+    return table;
+}
+
+/**
+ * @b Append a term to given check table.
+ *
+ * @return @c table on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC CheckTable* check_table_add_term (CheckTable* table, const CheckTerm* term) {
+    RETURN_VALUE_IF (!table || !term, Null, ERR_INVALID_ARGUMENTS);
+
+    if (table->term_count >= table->term_capacity) {
+        Size       new_capacity = table->term_capacity ? table->term_capacity * 2 : 4;
+        CheckTerm* terms        = REALLOCATE (table->terms, CheckTerm, new_capacity);
+        RETURN_VALUE_IF (!terms, Null, ERR_OUT_OF_MEMORY);
+
+        table->terms         = terms;
+        table->term_capacity = new_capacity;
+    }
+
+    table->terms[table->term_count++] = *term;
+    return table;
+}
+
+/**
+ * @b Check whether every term of given table compares a value that lies inside an
+ * object of given size.
+ * */
+PUBLIC Bool check_table_is_valid (const CheckTable* table, Size alloc_size) {
+    if (!table || (table->term_count && !table->terms)) {
+        return False;
+    }
+
+    for (Size t = 0; t < table->term_count; t++) {
+        const CheckTerm* term = table->terms + t;
+        Size             size = term->size;
+        if ((size != 1 && size != 2 && size != 4 && size != 8) || term->cmp >= CHECK_CMP_MAX ||
+            term->mem_off > alloc_size || size > alloc_size - term->mem_off) {
+            return False;
+        }
+    }
+
+    return True;
+}
+
+/* test one term over all objects, without branching on any value */
+#define CHECK_TERM_LOOP(type, op)                                                                  \
+    do {                                                                                           \
+        const Uint8* value = objects + term->mem_off;                                              \
+        Bool         ok    = True;                                                                 \
+        for (Size i = 0; i < count; i++, value += stride) {                                        \
+            type v;                                                                                \
+            memcpy (&v, value, sizeof (v));                                                        \
+            ok &= (Uint64)v op term->value;                                                        \
+        }                                                                                          \
+        if (!ok) {                                                                                 \
+            return term;                                                                           \
+        }                                                                                          \
+    } while (0)
+
+#define CHECK_TERM_CMP(type)                                                                       \
+    switch (term->cmp) {                                                                           \
+        case CHECK_CMP_EQ :                                                                        \
+            CHECK_TERM_LOOP (type, ==);                                                            \
+            break;                                                                                 \
+        case CHECK_CMP_NE :                                                                        \
+            CHECK_TERM_LOOP (type, !=);                                                            \
+            break;                                                                                 \
+        case CHECK_CMP_LT :                                                                        \
+            CHECK_TERM_LOOP (type, <);                                                             \
+            break;                                                                                 \
+        case CHECK_CMP_LE :                                                                        \
+            CHECK_TERM_LOOP (type, <=);                                                            \
+            break;                                                                                 \
+        case CHECK_CMP_GT :                                                                        \
+            CHECK_TERM_LOOP (type, >);                                                             \
+            break;                                                                                 \
+        default :                                                                                  \
+            CHECK_TERM_LOOP (type, >=);                                                            \
+            break;                                                                                 \
+    }
+
+/**
+ * @b Check terms of a valid table over an array of objects.
+ *
+ * Terms are tested one at a time over all objects, so each test is a single loop of
+ * fixed size loads and comparisions the compiler can vectorize, and every value is
+ * visited once, no matter how many objects there are.
+ *
+ * @param table
+ * @param objects First object.
+ * @param count Number of objects.
+ * @param stride Distance between objects.
+ *
+ * @return First term that fails for atleast one object.
+ * @return @c Null if all objects are valid.
+ * */
+PUBLIC const CheckTerm*
+    check_table_run (const CheckTable* table, const Uint8* objects, Size count, Size stride) {
+    for (Size t = 0; t < table->term_count; t++) {
+        const CheckTerm* term = table->terms + t;
+        switch (term->size) {
+            case 1 :
+                CHECK_TERM_CMP (Uint8);
+                break;
+            case 2 :
+                CHECK_TERM_CMP (Uint16);
+                break;
+            case 4 :
+                CHECK_TERM_CMP (Uint32);
+                break;
+            default :
+                CHECK_TERM_CMP (Uint64);
+                break;
+        }
+    }
+
+    return Null;
+}
+
+#undef CHECK_TERM_CMP
+#undef CHECK_TERM_LOOP
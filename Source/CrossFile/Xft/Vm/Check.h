@@ -0,0 +1,86 @@
+/**
+ * @file Check.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_VM_CHECK_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_VM_CHECK_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/**
+ * @b Comparision of a @c CheckTerm, with loaded value on the left.
+ * */
+typedef enum CheckCmp : Uint8 {
+    CHECK_CMP_EQ = 0,
+    CHECK_CMP_NE,
+    CHECK_CMP_LT,
+    CHECK_CMP_LE,
+    CHECK_CMP_GT,
+    CHECK_CMP_GE,
+    CHECK_CMP_MAX
+} CheckCmp;
+
+/**
+ * @b Comparision of a single value of a loaded object against a constant. Value is
+ * zero extended, and compared unsigned, same as in registers of VM.
+ * */
+typedef struct CheckTerm {
+    Size     mem_off; /**< @b Offset of value in object. */
+    Uint64   value;   /**< @b Constant value is compared against. */
+    CString  msg;     /**< @b Message printed when comparision fails, @c Null if none. */
+    Uint8    size;    /**< @b Size of value (1, 2, 4 or 8). */
+    CheckCmp cmp;
+} CheckTerm;
+
+/**
+ * @b Assertions of a type that only compare it's values against constants. An
+ * object is valid when all terms hold. Instead of the loader of each object, VM
+ * checks these once over all objects loaded by a call, one term at a time.
+ * */
+typedef struct CheckTable {
+    CheckTerm* terms;
+    Size       term_count;
+    Size       term_capacity;
+} CheckTable;
+
+PUBLIC CheckTable*      check_table_deinit (CheckTable* table);
+PUBLIC CheckTable*      check_table_add_term (CheckTable* table, const CheckTerm* term);
+PUBLIC Bool             check_table_is_valid (const CheckTable* table, Size alloc_size);
+PUBLIC const CheckTerm* check_table_run (
+    const CheckTable* table,
+    const Uint8*      objects,
+    Size              count,
+    Size              stride
+);
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_VM_CHECK_H
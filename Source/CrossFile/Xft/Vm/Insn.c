@@ -0,0 +1,104 @@
+/**
+ * @file Insn.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+
+/* local includes */
+#include "Insn.h"
+
+/**
+ * @b Initialize an empty instruction block.
+ *
+ * @param[out] iblock
+ *
+ * @return @c iblock on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC InsnBlock* insn_block_init (InsnBlock* iblock) {
+    RETURN_VALUE_IF (!iblock, Null, ERR_INVALID_ARGUMENTS);
+
+    iblock->insns = ALLOCATE (Insn, 8);
+    RETURN_VALUE_IF (!iblock->insns, Null, ERR_OUT_OF_MEMORY);
+
+    iblock->insn_count    = 0;
+    iblock->insn_capacity = 8;
+
+    return iblock;
+}
+
+/**
+ * @b De-initialize given instruction block.
+ *
+ * @param[out] iblock
+ *
+ * @return @c iblock on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC InsnBlock* insn_block_deinit (InsnBlock* iblock) {
+    RETURN_VALUE_IF (!iblock, Null, ERR_INVALID_ARGUMENTS);
+
+    if (iblock->insns) {
+        FREE (iblock->insns);
+    }
+
+    memset (iblock, 0, sizeof (InsnBlock));
+
+    return iblock;
+}
+
+/**
+ * @b Append a copy of given instruction to instruction block.
+ *
+ * @param iblock
+ * @param insn
+ *
+ * @return @c iblock on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC InsnBlock* insn_block_add_insn (InsnBlock* iblock, Insn* insn) {
+    RETURN_VALUE_IF (!iblock || !insn, Null, ERR_INVALID_ARGUMENTS);
+
+    if (iblock->insn_count >= iblock->insn_capacity) {
+        Size  new_capacity = iblock->insn_capacity ? iblock->insn_capacity * 2 : 8;
+        Insn* insns        = REALLOCATE (iblock->insns, Insn, new_capacity);
+        RETURN_VALUE_IF (!insns, Null, ERR_OUT_OF_MEMORY);
+
+        iblock->insns         = insns;
+        iblock->insn_capacity = new_capacity;
+    }
+
+    iblock->insns[iblock->insn_count++] = *insn;
+
+    return iblock;
+}
@@ -97,9 +97,22 @@ typedef enum InsnType : Uint8 {
     INSN_TYPE_POP_A32, /* popa32 mem_off, pop_elem_count */
     INSN_TYPE_POP_A64, /* popa64 mem_off, pop_elem_count */
 
+    /* read an array of elements stored in given byte order, swapped if host order differs */
+    INSN_TYPE_READ_A16_LE, /* ra16le mem_off, read_elem_count */
+    INSN_TYPE_READ_A32_LE, /* ra32le mem_off, read_elem_count */
+    INSN_TYPE_READ_A64_LE, /* ra64le mem_off, read_elem_count */
+    INSN_TYPE_READ_A16_BE, /* ra16be mem_off, read_elem_count */
+    INSN_TYPE_READ_A32_BE, /* ra32be mem_off, read_elem_count */
+    INSN_TYPE_READ_A64_BE, /* ra64be mem_off, read_elem_count */
+
+    /* read an array of records, each record read using a struct layout */
+    INSN_TYPE_READ_STRUCT_A, /* rdsta mem_off, layout_id, elem_count, mem_stride */
+
     /* seek instructions inside the file stream */
     INSN_TYPE_SEEK_FWD, /* seekf num_bytes */
     INSN_TYPE_SEEK_BAK, /* seekb num_bytes */
+    INSN_TYPE_SEEK_R,   /* seekr reg : seek to offset in reg from beginning of stream */
+    INSN_TYPE_TELL,     /* tell reg : store current offset in stream to reg */
 
     /* operations on registers */
     /* arithmetic operators */
@@ -133,13 +146,15 @@ typedef enum InsnType : Uint8 {
 
     /* control flow instructions */
     /* jumps happen by selecting the block from an array of blocks that the VM has */
-    INSN_TYPE_JA,               /* ja reg, sel : jump if above */
-    INSN_TYPE_JB,               /* jb reg, sel : jump if below */
-    INSN_TYPE_JZ,               /* jz reg, sel : jump if zero */
-    INSN_TYPE_JO,               /* jo reg, sel : jump if overflow */
-    INSN_TYPE_JC,               /* jc reg, sel : jump if carry */
+    INSN_TYPE_JA,                 /* ja reg, sel : jump if above */
+    INSN_TYPE_JB,                 /* jb reg, sel : jump if below */
+    INSN_TYPE_JZ,                 /* jz reg, sel : jump if zero */
+    INSN_TYPE_JO,                 /* jo reg, sel : jump if overflow */
+    INSN_TYPE_JC,                 /* jc reg, sel : jump if carry */
 
-    INSN_TYPE_CALL_TYPE_LOADER, /* typeload typesel: Call loader method */
+    INSN_TYPE_CALL_TYPE_LOADER,   /* typeload typesel: Call loader method */
+    INSN_TYPE_CALL_TYPE_LOADER_A, /* typeloada typesel, rcount, stride : Call for each element */
+    INSN_TYPE_CALL_TYPE_LOADER_V, /* typeloadv typesel, rcount, mem_off : Load a vector */
 
     /* printing and debugging infos */
     INSN_TYPE_PINFO,        /* pinfo, str : Just some informative message */
@@ -148,6 +163,16 @@ typedef enum InsnType : Uint8 {
     INSN_TYPE_EXIT_SUCCESS, /* exit_success */
     INSN_TYPE_EXIT_FAILURE, /* exit_failure*/
 
+    /* superinstructions, never generated directly, only by peephole optimizer */
+    INSN_TYPE_READ_STRUCT, /* rdst mem_off, layout_id : fused run of fixed size reads */
+    INSN_TYPE_JCMP,        /* jcmp cmp, rres, r1, rimm, imm, sel : fused setr, cmpxx, jz/ja */
+
+    /* multiway jump through a jump table of loader, continues with next insn if no case matches */
+    INSN_TYPE_SWITCH, /* switch reg, table_id */
+
+    /* jump over assertions of object being loaded, unless VM's validation level checks them */
+    INSN_TYPE_CHECK, /* check sel */
+
     INSN_TYPE_MAX
 } InsnType;
 
@@ -162,7 +187,7 @@ typedef struct Insn {
 
         struct {
             Uint8 reg;
-        } read_reg, push_reg, pop_reg;
+        } read_reg, push_reg, pop_reg, seek_reg, tell;
 
         struct {
             Uint64 mem_off;
@@ -197,6 +222,53 @@ typedef struct Insn {
         struct {
             Size type_load_sel; /**< @b Index of type loader to be called. */
         } call_type_loader;
+
+        struct {
+            Size  type_load_sel; /**< @b Index of type loader to be called for each element. */
+            Uint8 count_reg;     /**< @b Register containing number of elements. */
+            Size  mem_stride;    /**< @b Distance between elements in memory. */
+        } call_type_loader_arr;
+
+        struct {
+            Size   type_load_sel; /**< @b Index of type loader to be called for each element. */
+            Uint8  count_reg;     /**< @b Register containing number of elements. */
+            Uint64 mem_off;       /**< @b Offset of @c VmVector describing loaded elements. */
+        } call_type_loader_vec;
+
+        struct {
+            CString msg; /**< @b Message to be printed. */
+        } pinfo, pdbg, perr, print;
+
+        struct {
+            Uint64 mem_off;   /**< @b Memory offset of first field in layout. */
+            Size   layout_id; /**< @b Index of struct layout in loader's layout table. */
+        } read_struct;
+
+        struct {
+            Uint64 mem_off;    /**< @b Memory offset of first record. */
+            Size   layout_id;  /**< @b Index of struct layout of each record. */
+            Size   elem_count; /**< @b Number of records. */
+            Size   mem_stride; /**< @b Distance between records in memory. */
+        } read_struct_arr;
+
+        struct {
+            InsnType cmp;       /**< @b Comparision performed, with r1 on the left. */
+            Bool     jump_if;   /**< @b Jump taken when comparision result equals this. */
+            Uint8    rres;      /**< @b Register where comparision result is stored. */
+            Uint8    r1;        /**< @b Register compared against immediate. */
+            Uint8    rimm;      /**< @b Register where immediate is stored. */
+            Uint64   imm;       /**< @b Immediate value compared against. */
+            Size     block_sel; /**< @b Index of block to jump to. */
+        } jcmp;
+
+        struct {
+            Uint8 reg;      /**< @b Register containing value to be matched. */
+            Size  table_id; /**< @b Index of switch table in loader's switch tables. */
+        } switch_table;
+
+        struct {
+            Size block_sel; /**< @b Index of block right after assertions. */
+        } check;
     } insn;
 } Insn;
 
@@ -92,6 +92,20 @@
 #define READ_ARR32(mem_off, elem_count) READ_ARR (32, mem_off, elem_count)
 #define READ_ARR64(mem_off, elem_count) READ_ARR (64, mem_off, elem_count)
 
+#define READ_ARR_ORDER(b, order, mem_off, elem_count)                                              \
+    ((Insn) {.insn_type = INSN_TYPE_READ_A##b##_##order,                                           \
+             .insn      = {.read_arr = {mem_off, elem_count}}})
+#define READ_ARR16_LE(mem_off, elem_count) READ_ARR_ORDER (16, LE, mem_off, elem_count)
+#define READ_ARR32_LE(mem_off, elem_count) READ_ARR_ORDER (32, LE, mem_off, elem_count)
+#define READ_ARR64_LE(mem_off, elem_count) READ_ARR_ORDER (64, LE, mem_off, elem_count)
+#define READ_ARR16_BE(mem_off, elem_count) READ_ARR_ORDER (16, BE, mem_off, elem_count)
+#define READ_ARR32_BE(mem_off, elem_count) READ_ARR_ORDER (32, BE, mem_off, elem_count)
+#define READ_ARR64_BE(mem_off, elem_count) READ_ARR_ORDER (64, BE, mem_off, elem_count)
+
+#define READ_STRUCT_ARR(mem_off, layout_id, elem_count, mem_stride)                                \
+    ((Insn) {.insn_type = INSN_TYPE_READ_STRUCT_A,                                                 \
+             .insn      = {.read_struct_arr = {mem_off, layout_id, elem_count, mem_stride}}})
+
 #define PUSH_ARR(b, mem_off, elem_count)                                                           \
     ((Insn) {.insn_type = INSN_TYPE_PUSH_A##b, .insn = {.push_arr = {mem_off, elem_count}}})
 #define PUSH_ARR8(mem_off, elem_count)  PUSH_ARR (8, mem_off, elem_count)
@@ -112,6 +126,8 @@
 #define SEEK(dir, numb) ((Insn) {.insn_type = INSN_TYPE_SEEK_##dir, .insn = {.seek = {numb}}})
 #define SEEK_FWD(numb)  SEEK (FWD, numb)
 #define SEEK_BAK(numb)  SEEK (BAK, numb)
+#define SEEK_REG(reg)   ((Insn) {.insn_type = INSN_TYPE_SEEK_R, .insn = {.seek_reg = {reg}}})
+#define TELL(reg)       ((Insn) {.insn_type = INSN_TYPE_TELL, .insn = {.tell = {reg}}})
 
 
 
@@ -163,4 +179,38 @@
 #define CALL(sel)                                                                                  \
     ((Insn) {.insn_type = INSN_TYPE_CALL_TYPE_LOADER, .insn = {.call_type_loader = {sel}}})
 
+#define CALL_ARR(sel, rcount, stride)                                                              \
+    ((Insn) {.insn_type = INSN_TYPE_CALL_TYPE_LOADER_A,                                            \
+             .insn      = {.call_type_loader_arr = {sel, rcount, stride}}})
+
+#define CALL_VEC(sel, rcount, mem_off)                                                             \
+    ((Insn) {.insn_type = INSN_TYPE_CALL_TYPE_LOADER_V,                                            \
+             .insn      = {.call_type_loader_vec = {sel, rcount, mem_off}}})
+
+
+
+
+#define PRINT(type, msg) ((Insn) {.insn_type = INSN_TYPE_##type, .insn = {.print = {msg}}})
+#define PINFO(msg)       PRINT (PINFO, msg)
+#define PDBG(msg)        PRINT (PDBG, msg)
+#define PERR(msg)        PRINT (PERR, msg)
+
+/* EXIT (SUCCESS) or EXIT (FAILURE), not named EXIT_SUCCESS to not clash with libc */
+#define EXIT(status) ((Insn) {.insn_type = INSN_TYPE_EXIT_##status})
+
+
+
+
+#define READ_STRUCT(mem_off, layout_id)                                                            \
+    ((Insn) {.insn_type = INSN_TYPE_READ_STRUCT, .insn = {.read_struct = {mem_off, layout_id}}})
+
+#define JCMP(cmp, jump_if, rres, r1, rimm, imm, sel)                                               \
+    ((Insn) {.insn_type = INSN_TYPE_JCMP,                                                          \
+             .insn      = {.jcmp = {INSN_TYPE_CMP##cmp, jump_if, rres, r1, rimm, imm, sel}}})
+
+#define SWITCH(reg, table_id)                                                                      \
+    ((Insn) {.insn_type = INSN_TYPE_SWITCH, .insn = {.switch_table = {reg, table_id}}})
+
+#define CHECK(sel) ((Insn) {.insn_type = INSN_TYPE_CHECK, .insn = {.check = {sel}}})
+
 #endif // ANVIE_SOURCE_CROSSFILE_INSN_BUILDERS_H
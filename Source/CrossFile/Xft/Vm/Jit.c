@@ -0,0 +1,862 @@
+/**
+ * @file Jit.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* crossfile */
+#include "../../Stream/Stream.h"
+
+/* local includes */
+#include "Insn.h"
+#include "Jit.h"
+#include "Loader.h"
+#include "Packed.h"
+
+#if VM_JIT_ENABLED
+
+/*
+ * Code generated for a loader is a plain concatenation of one machine code template per
+ * instruction, blocks laid out in order. Register allocation is fixed :
+ *
+ *   rbx -> JitFrame    r12 -> stream data    r13 -> stream size
+ *   r14 -> cursor      r15 -> object memory  rax, rcx, rdx, rsi, rdi -> scratch
+ *
+ * VM registers always live in the frame. Only loaders that passed verification are
+ * compiled, so registers, memory offsets and jump targets are trusted, and only
+ * stream bounds, division by zero and calls are checked. Any failing check bails out
+ * to the interpreter, which executes the loader again and reports the error.
+ */
+
+/* offsets of frame fields, addressed as [rbx + disp8] by generated code */
+#define JIT_FRAME_REG(r)   ((Uint8)offsetof (JitFrame, regs) + 8 * (r))
+#define JIT_FRAME_DATA     ((Uint8)offsetof (JitFrame, data))
+#define JIT_FRAME_SIZE     ((Uint8)offsetof (JitFrame, size))
+#define JIT_FRAME_CURSOR   ((Uint8)offsetof (JitFrame, cursor))
+#define JIT_FRAME_MEM      ((Uint8)offsetof (JitFrame, mem))
+
+/* swapped fields and arrays are unrolled, larger ones are left to the interpreter */
+#define JIT_MAX_UNROLL 16
+
+/* labels after the last block */
+#define JIT_LABEL_DONE(e)   ((e)->block_count)
+#define JIT_LABEL_BAIL(e)   ((e)->block_count + 1)
+#define JIT_LABEL_FAILED(e) ((e)->block_count + 2)
+
+/* x86 condition codes, as used in low nibble of jcc and setcc opcodes */
+typedef enum JitCond {
+    JIT_COND_B  = 0x2,
+    JIT_COND_AE = 0x3,
+    JIT_COND_E  = 0x4,
+    JIT_COND_NE = 0x5,
+    JIT_COND_BE = 0x6,
+    JIT_COND_A  = 0x7,
+    JIT_COND_S  = 0x8,
+    JIT_COND_LE = 0xe,
+    JIT_COND_G  = 0xf,
+} JitCond;
+
+/**
+ * @b A rel32 that must be patched with address of a label once all blocks are emitted.
+ * */
+typedef struct JitFixup {
+    Size at;    /**< @b Offset of rel32 in code. */
+    Size label; /**< @b Block index, or one of JIT_LABEL_*. */
+} JitFixup;
+
+/**
+ * @b Code buffer and labels of loader being compiled.
+ * */
+typedef struct JitEmitter {
+    Uint8* code;
+    Size   size;
+    Size   capacity;
+
+    Size* labels;      /**< @b Offset of each block, followed by done, bail and failed labels. */
+    Size  block_count;
+
+    JitFixup* fixups;
+    Size      fixup_count;
+    Size      fixup_capacity;
+
+    Bool oom;          /**< @b Set when any allocation fails, checked once at the end. */
+} JitEmitter;
+
+/* emit given bytes as is */
+#define JIT_EMIT(e, ...)                                                                           \
+    jit_emit_bytes (e, (const Uint8[]) {__VA_ARGS__}, sizeof ((const Uint8[]) {__VA_ARGS__}))
+
+/* private method declarations */
+
+static inline void jit_emit_bytes (JitEmitter* e, const Uint8* bytes, Size n);
+static inline void jit_emit_u32 (JitEmitter* e, Uint32 v);
+static inline void jit_emit_u64 (JitEmitter* e, Uint64 v);
+static inline void jit_emit_jump (JitEmitter* e, Int32 cond, Size label);
+static inline void jit_emit_load_reg (JitEmitter* e, Uint8 x86_reg, Uint8 vm_reg);
+static inline void jit_emit_store_reg (JitEmitter* e, Uint8 vm_reg, Uint8 x86_reg);
+static inline void jit_emit_need (JitEmitter* e, Size nbytes);
+static inline void jit_emit_stream_load (JitEmitter* e, Size nbytes, Uint32 disp);
+static inline void jit_emit_mem_store (JitEmitter* e, Size nbytes, Uint32 disp);
+static inline void jit_emit_bswap (JitEmitter* e, Size nbytes);
+static inline void jit_emit_copy (JitEmitter* e, Uint32 mem_off, Uint32 stream_off, Size nbytes);
+static inline void jit_emit_advance (JitEmitter* e, Size nbytes);
+static inline Bool jit_emit_elems (
+    JitEmitter* e,
+    Uint64      mem_off,
+    Size        stream_off,
+    Size        elem_size,
+    Size        count,
+    Bool        swap
+);
+static inline Bool jit_emit_insn (JitEmitter* e, Loader* loader, Insn* insn, JitCallFn call_fn);
+
+#endif
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Compile given type loader to native code.
+ *
+ * Loader must have passed verification. If it uses any instruction that has no
+ * native template, it's marked @c LOADER_JIT_UNSUPPORTED and keeps being interpreted.
+ *
+ * @param loader Loader to compile.
+ * @param call_fn Called by native code to execute other type loaders.
+ *
+ * @return @c loader on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader* jit_compile_loader (Loader* loader, JitCallFn call_fn) {
+    RETURN_VALUE_IF (!loader || !call_fn, Null, ERR_INVALID_ARGUMENTS);
+
+    if (loader->jit_status == LOADER_JIT_COMPILED) {
+        return loader;
+    }
+
+#if VM_JIT_ENABLED
+    RETURN_VALUE_IF (
+        loader->verify_status != LOADER_VERIFY_PASSED || !loader->packed_code.code,
+        Null,
+        "Only verified type loaders can be compiled\n"
+    );
+
+    Size       block_count = 0;
+    InsnBlock* blocks      = packed_code_decode (&loader->packed_code, &block_count);
+    RETURN_VALUE_IF (!blocks, Null, "Failed to decode type loader\n");
+
+    JitEmitter e = {.block_count = block_count};
+    e.labels     = ALLOCATE (Size, block_count + 3);
+    e.oom        = !e.labels;
+
+    Bool  supported = True;
+    void* map       = MAP_FAILED;
+    Size  map_size  = 0;
+
+    /* push rbx, r12, r13, r14, r15 ; keeps stack 16 byte aligned for calls */
+    JIT_EMIT (&e, 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57);
+    /* mov rbx, rdi */
+    JIT_EMIT (&e, 0x48, 0x89, 0xfb);
+    /* mov r12, [rbx + data] ; mov r13, [rbx + size] ; mov r14, [rbx + cursor] ; mov r15, [rbx + mem] */
+    JIT_EMIT (&e, 0x4c, 0x8b, 0x63, JIT_FRAME_DATA);
+    JIT_EMIT (&e, 0x4c, 0x8b, 0x6b, JIT_FRAME_SIZE);
+    JIT_EMIT (&e, 0x4c, 0x8b, 0x73, JIT_FRAME_CURSOR);
+    JIT_EMIT (&e, 0x4c, 0x8b, 0x7b, JIT_FRAME_MEM);
+
+    for (Size b = 0; supported && !e.oom && b < block_count; b++) {
+        e.labels[b] = e.size;
+        for (Size i = 0; supported && i < blocks[b].insn_count; i++) {
+            supported = jit_emit_insn (&e, loader, blocks[b].insns + i, call_fn);
+        }
+    }
+
+    if (supported && !e.oom) {
+        Size ret = 0;
+
+        /* falling off the last block is a successful exit */
+        e.labels[JIT_LABEL_DONE (&e)] = e.size;
+        /* mov [rbx + cursor], r14 ; mov eax, 1 */
+        JIT_EMIT (&e, 0x4c, 0x89, 0x73, JIT_FRAME_CURSOR);
+        JIT_EMIT (&e, 0xb8, 0x01, 0x00, 0x00, 0x00);
+
+        /* pop r15, r14, r13, r12, rbx ; ret */
+        ret = e.size;
+        JIT_EMIT (&e, 0x41, 0x5f, 0x41, 0x5e, 0x41, 0x5d, 0x41, 0x5c, 0x5b, 0xc3);
+
+        /* xor eax, eax ; jmp ret */
+        e.labels[JIT_LABEL_BAIL (&e)] = e.size;
+        JIT_EMIT (&e, 0x31, 0xc0, 0xe9);
+        jit_emit_u32 (&e, (Uint32)(ret - (e.size + 4)));
+
+        /* mov eax, -1 ; jmp ret */
+        e.labels[JIT_LABEL_FAILED (&e)] = e.size;
+        JIT_EMIT (&e, 0xb8, 0xff, 0xff, 0xff, 0xff, 0xe9);
+        jit_emit_u32 (&e, (Uint32)(ret - (e.size + 4)));
+    }
+
+    GOTO_HANDLER_IF (e.oom, COMPILE_FAILED, ERR_OUT_OF_MEMORY);
+
+    if (!supported) {
+        loader->jit_status = LOADER_JIT_UNSUPPORTED;
+        goto COMPILE_FAILED;
+    }
+
+    for (Size f = 0; f < e.fixup_count; f++) {
+        Int32 rel = (Int32)(e.labels[e.fixups[f].label] - (e.fixups[f].at + 4));
+        memcpy (e.code + e.fixups[f].at, &rel, 4);
+    }
+
+    /* code is never writable and executable at the same time */
+    Size page = (Size)sysconf (_SC_PAGESIZE);
+    map_size  = (e.size + page - 1) & ~(page - 1);
+    map       = mmap (Null, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    GOTO_HANDLER_IF (map == MAP_FAILED, COMPILE_FAILED, "Failed to map memory for native code\n");
+
+    memcpy (map, e.code, e.size);
+    GOTO_HANDLER_IF (
+        mprotect (map, map_size, PROT_READ | PROT_EXEC) != 0,
+        COMPILE_FAILED,
+        "Failed to make native code executable\n"
+    );
+
+    loader->jit_code      = map;
+    loader->jit_code_size = map_size;
+    loader->jit_status    = LOADER_JIT_COMPILED;
+
+    for (Size b = 0; b < block_count; b++) {
+        insn_block_deinit (blocks + b);
+    }
+    FREE (blocks);
+    FREE (e.code);
+    FREE (e.labels);
+    if (e.fixups) {
+        FREE (e.fixups);
+    }
+
+    return loader;
+
+COMPILE_FAILED:
+    if (map != MAP_FAILED) {
+        munmap (map, map_size);
+    }
+    for (Size b = 0; b < block_count; b++) {
+        insn_block_deinit (blocks + b);
+    }
+    FREE (blocks);
+    if (e.code) {
+        FREE (e.code);
+    }
+    if (e.labels) {
+        FREE (e.labels);
+    }
+    if (e.fixups) {
+        FREE (e.fixups);
+    }
+
+    return Null;
+#else
+    loader->jit_status = LOADER_JIT_UNSUPPORTED;
+    return Null;
+#endif
+}
+
+/**
+ * @b Release native code of given loader. Loader goes back to being interpreted,
+ * and can be compiled again later.
+ *
+ * @param loader
+ *
+ * @return @c loader on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader* jit_release_loader (Loader* loader) {
+    RETURN_VALUE_IF (!loader, Null, ERR_INVALID_ARGUMENTS);
+
+    if (loader->jit_code) {
+        munmap (loader->jit_code, loader->jit_code_size);
+    }
+
+    loader->jit_code       = Null;
+    loader->jit_code_size  = 0;
+    loader->jit_exec_count = 0;
+    loader->jit_status     = LOADER_JIT_PENDING;
+
+    return loader;
+}
+
+#if VM_JIT_ENABLED
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+static inline void jit_emit_bytes (JitEmitter* e, const Uint8* bytes, Size n) {
+    if (e->oom) {
+        return;
+    }
+
+    if (e->size + n > e->capacity) {
+        Size capacity = e->capacity ? e->capacity * 2 : 4096;
+        while (capacity < e->size + n) {
+            capacity *= 2;
+        }
+        Uint8* code = REALLOCATE (e->code, Uint8, capacity);
+        if (!code) {
+            e->oom = True;
+            return;
+        }
+        e->code     = code;
+        e->capacity = capacity;
+    }
+
+    memcpy (e->code + e->size, bytes, n);
+    e->size += n;
+}
+
+static inline void jit_emit_u32 (JitEmitter* e, Uint32 v) {
+    jit_emit_bytes (e, (const Uint8*)&v, 4);
+}
+
+static inline void jit_emit_u64 (JitEmitter* e, Uint64 v) {
+    jit_emit_bytes (e, (const Uint8*)&v, 8);
+}
+
+/**
+ * @b Emit a jump to given label, conditional unless @c cond is negative.
+ * */
+static inline void jit_emit_jump (JitEmitter* e, Int32 cond, Size label) {
+    if (cond < 0) {
+        JIT_EMIT (e, 0xe9);
+    } else {
+        JIT_EMIT (e, 0x0f, (Uint8)(0x80 | cond));
+    }
+
+    if (e->fixup_count >= e->fixup_capacity) {
+        Size      capacity = e->fixup_capacity ? e->fixup_capacity * 2 : 16;
+        JitFixup* fixups   = REALLOCATE (e->fixups, JitFixup, capacity);
+        if (!fixups) {
+            e->oom = True;
+            return;
+        }
+        e->fixups         = fixups;
+        e->fixup_capacity = capacity;
+    }
+
+    e->fixups[e->fixup_count++] = (JitFixup) {.at = e->size, .label = label};
+    jit_emit_u32 (e, 0);
+}
+
+/**
+ * @b mov x86_reg, [rbx + regs[vm_reg]]
+ * */
+static inline void jit_emit_load_reg (JitEmitter* e, Uint8 x86_reg, Uint8 vm_reg) {
+    JIT_EMIT (e, 0x48, 0x8b, (Uint8)(0x43 | (x86_reg << 3)), JIT_FRAME_REG (vm_reg));
+}
+
+/**
+ * @b mov [rbx + regs[vm_reg]], x86_reg
+ * */
+static inline void jit_emit_store_reg (JitEmitter* e, Uint8 vm_reg, Uint8 x86_reg) {
+    JIT_EMIT (e, 0x48, 0x89, (Uint8)(0x43 | (x86_reg << 3)), JIT_FRAME_REG (vm_reg));
+}
+
+/**
+ * @b Bail out if stream does not have @c nbytes more bytes. Caller makes sure
+ * @c nbytes fits in a signed 32 bit immediate.
+ * */
+static inline void jit_emit_need (JitEmitter* e, Size nbytes) {
+    /* mov rax, r13 ; sub rax, r14 ; cmp rax, imm32 ; jb bail */
+    JIT_EMIT (e, 0x4c, 0x89, 0xe8, 0x4c, 0x29, 0xf0, 0x48, 0x3d);
+    jit_emit_u32 (e, (Uint32)nbytes);
+    jit_emit_jump (e, JIT_COND_B, JIT_LABEL_BAIL (e));
+}
+
+/**
+ * @b Zero extending load of @c nbytes from [r12 + r14 + disp] into rax.
+ * */
+static inline void jit_emit_stream_load (JitEmitter* e, Size nbytes, Uint32 disp) {
+    switch (nbytes) {
+        case 1 :
+            JIT_EMIT (e, 0x43, 0x0f, 0xb6, 0x84, 0x34);
+            break;
+        case 2 :
+            JIT_EMIT (e, 0x43, 0x0f, 0xb7, 0x84, 0x34);
+            break;
+        case 4 :
+            JIT_EMIT (e, 0x43, 0x8b, 0x84, 0x34);
+            break;
+        default :
+            JIT_EMIT (e, 0x4b, 0x8b, 0x84, 0x34);
+            break;
+    }
+    jit_emit_u32 (e, disp);
+}
+
+/**
+ * @b Store low @c nbytes of rax to [r15 + disp].
+ * */
+static inline void jit_emit_mem_store (JitEmitter* e, Size nbytes, Uint32 disp) {
+    switch (nbytes) {
+        case 1 :
+            JIT_EMIT (e, 0x41, 0x88, 0x87);
+            break;
+        case 2 :
+            JIT_EMIT (e, 0x66, 0x41, 0x89, 0x87);
+            break;
+        case 4 :
+            JIT_EMIT (e, 0x41, 0x89, 0x87);
+            break;
+        default :
+            JIT_EMIT (e, 0x49, 0x89, 0x87);
+            break;
+    }
+    jit_emit_u32 (e, disp);
+}
+
+/**
+ * @b Invert byte order of low @c nbytes of rax.
+ * */
+static inline void jit_emit_bswap (JitEmitter* e, Size nbytes) {
+    switch (nbytes) {
+        case 2 :
+            /* rol ax, 8 */
+            JIT_EMIT (e, 0x66, 0xc1, 0xc0, 0x08);
+            break;
+        case 4 :
+            /* bswap eax */
+            JIT_EMIT (e, 0x0f, 0xc8);
+            break;
+        case 8 :
+            /* bswap rax */
+            JIT_EMIT (e, 0x48, 0x0f, 0xc8);
+            break;
+        default :
+            break;
+    }
+}
+
+/**
+ * @b Copy @c nbytes from [r12 + r14 + stream_off] to [r15 + mem_off] using rep movsb.
+ * */
+static inline void jit_emit_copy (JitEmitter* e, Uint32 mem_off, Uint32 stream_off, Size nbytes) {
+    /* lea rdi, [r15 + mem_off] ; lea rsi, [r12 + r14 + stream_off] ; mov rcx, nbytes ; rep movsb */
+    JIT_EMIT (e, 0x49, 0x8d, 0xbf);
+    jit_emit_u32 (e, mem_off);
+    JIT_EMIT (e, 0x4b, 0x8d, 0xb4, 0x34);
+    jit_emit_u32 (e, stream_off);
+    JIT_EMIT (e, 0x48, 0xc7, 0xc1);
+    jit_emit_u32 (e, (Uint32)nbytes);
+    JIT_EMIT (e, 0xf3, 0xa4);
+}
+
+/**
+ * @b add r14, nbytes
+ * */
+static inline void jit_emit_advance (JitEmitter* e, Size nbytes) {
+    JIT_EMIT (e, 0x49, 0x81, 0xc6);
+    jit_emit_u32 (e, (Uint32)nbytes);
+}
+
+/**
+ * @b Copy an array of elements from stream to memory, inverting byte order of each
+ * element if required. Stream cursor is not advanced.
+ *
+ * @return @c False if array is too large to be compiled.
+ * */
+static inline Bool jit_emit_elems (
+    JitEmitter* e,
+    Uint64      mem_off,
+    Size        stream_off,
+    Size        elem_size,
+    Size        count,
+    Bool        swap
+) {
+    Size nbytes = elem_size * count;
+    if (mem_off + nbytes > INT32_MAX || stream_off + nbytes > INT32_MAX) {
+        return False;
+    }
+
+    if (!swap || elem_size == 1) {
+        if (nbytes <= 8 && count == 1) {
+            jit_emit_stream_load (e, elem_size, (Uint32)stream_off);
+            jit_emit_mem_store (e, elem_size, (Uint32)mem_off);
+        } else if (nbytes) {
+            jit_emit_copy (e, (Uint32)mem_off, (Uint32)stream_off, nbytes);
+        }
+        return True;
+    }
+
+    if (count > JIT_MAX_UNROLL) {
+        return False;
+    }
+
+    for (Size i = 0; i < count; i++) {
+        jit_emit_stream_load (e, elem_size, (Uint32)(stream_off + i * elem_size));
+        jit_emit_bswap (e, elem_size);
+        jit_emit_mem_store (e, elem_size, (Uint32)(mem_off + i * elem_size));
+    }
+
+    return True;
+}
+
+/**
+ * @b Emit native template of a single instruction.
+ *
+ * @return @c False if instruction has no template.
+ * */
+static inline Bool jit_emit_insn (JitEmitter* e, Loader* loader, Insn* insn, JitCallFn call_fn) {
+    /* setcc condition of each comparision, all unsigned */
+    static const Uint8 cmp_conds[INSN_TYPE_MAX] = {
+        [INSN_TYPE_CMPEQ] = JIT_COND_E,
+        [INSN_TYPE_CMPLE] = JIT_COND_BE,
+        [INSN_TYPE_CMPLT] = JIT_COND_B,
+        [INSN_TYPE_CMPGE] = JIT_COND_AE,
+        [INSN_TYPE_CMPGT] = JIT_COND_A,
+    };
+
+    switch (insn->insn_type) {
+        case INSN_TYPE_SET_REG :
+            /* mov rax, imm64 */
+            JIT_EMIT (e, 0x48, 0xb8);
+            jit_emit_u64 (e, insn->insn.set_reg.imm);
+            jit_emit_store_reg (e, insn->insn.set_reg.reg, 0);
+            return True;
+
+        case INSN_TYPE_READ_R8 ... INSN_TYPE_READ_R64 : {
+            Size n = (Size)1 << (insn->insn_type - INSN_TYPE_READ_R8);
+            jit_emit_need (e, n);
+            jit_emit_stream_load (e, n, 0);
+            jit_emit_store_reg (e, insn->insn.read_reg.reg, 0);
+            jit_emit_advance (e, n);
+            return True;
+        }
+
+        case INSN_TYPE_READ_M8 ... INSN_TYPE_READ_M64 : {
+            Size n = (Size)1 << (insn->insn_type - INSN_TYPE_READ_M8);
+            jit_emit_need (e, n);
+            if (!jit_emit_elems (e, insn->insn.read_mem.mem_off, 0, n, 1, False)) {
+                return False;
+            }
+            jit_emit_advance (e, n);
+            return True;
+        }
+
+        case INSN_TYPE_READ_A8 ... INSN_TYPE_READ_A64 :
+        case INSN_TYPE_READ_A16_LE ... INSN_TYPE_READ_A64_BE : {
+            Bool ordered = insn->insn_type >= INSN_TYPE_READ_A16_LE;
+            Size esize   = ordered ? (Size)2 << ((insn->insn_type - INSN_TYPE_READ_A16_LE) % 3) :
+                                     (Size)1 << (insn->insn_type - INSN_TYPE_READ_A8);
+            Bool swap    = ordered && (insn->insn_type <= INSN_TYPE_READ_A64_LE ?
+                                           HOST_BYTE_ORDER_IS_MSB :
+                                           HOST_BYTE_ORDER_IS_LSB);
+            Size count   = insn->insn.read_arr.elem_count;
+            if (esize * count > INT32_MAX) {
+                return False;
+            }
+
+            jit_emit_need (e, esize * count);
+            if (!jit_emit_elems (e, insn->insn.read_arr.mem_off, 0, esize, count, swap)) {
+                return False;
+            }
+            jit_emit_advance (e, esize * count);
+            return True;
+        }
+
+        case INSN_TYPE_READ_STRUCT : {
+            StructLayout* layout = loader->struct_layouts + insn->insn.read_struct.layout_id;
+            Uint64        off    = insn->insn.read_struct.mem_off;
+            if (layout->stream_size > INT32_MAX) {
+                return False;
+            }
+
+            jit_emit_need (e, layout->stream_size);
+            if (layout->is_dense && !layout->needs_swap) {
+                if (!jit_emit_elems (e, off, 0, layout->stream_size, 1, False)) {
+                    return False;
+                }
+            } else {
+                for (Size f = 0; f < layout->field_count; f++) {
+                    StructLayoutField* field = layout->fields + f;
+                    if (!jit_emit_elems (
+                            e,
+                            off + field->mem_off,
+                            field->stream_off,
+                            field->size,
+                            field->count,
+                            field->swap
+                        )) {
+                        return False;
+                    }
+                }
+            }
+            jit_emit_advance (e, layout->stream_size);
+            return True;
+        }
+
+        case INSN_TYPE_READ_STRUCT_A : {
+            StructLayout* layout = loader->struct_layouts + insn->insn.read_struct_arr.layout_id;
+            Size          count  = insn->insn.read_struct_arr.elem_count;
+            Size          nbytes = count * layout->stream_size;
+
+            /* only tables that are a single block copy have a template */
+            if (!layout->is_dense || layout->needs_swap ||
+                insn->insn.read_struct_arr.mem_stride != layout->stream_size ||
+                nbytes > INT32_MAX) {
+                return False;
+            }
+
+            jit_emit_need (e, nbytes);
+            if (!jit_emit_elems (e, insn->insn.read_struct_arr.mem_off, 0, nbytes, 1, False)) {
+                return False;
+            }
+            jit_emit_advance (e, nbytes);
+            return True;
+        }
+
+        case INSN_TYPE_SEEK_FWD :
+            if (insn->insn.seek.num_bytes > INT32_MAX) {
+                return False;
+            }
+            jit_emit_need (e, insn->insn.seek.num_bytes);
+            jit_emit_advance (e, insn->insn.seek.num_bytes);
+            return True;
+
+        case INSN_TYPE_SEEK_BAK :
+            if (insn->insn.seek.num_bytes > INT32_MAX) {
+                return False;
+            }
+            /* cmp r14, imm32 ; jb bail ; sub r14, imm32 */
+            JIT_EMIT (e, 0x49, 0x81, 0xfe);
+            jit_emit_u32 (e, (Uint32)insn->insn.seek.num_bytes);
+            jit_emit_jump (e, JIT_COND_B, JIT_LABEL_BAIL (e));
+            JIT_EMIT (e, 0x49, 0x81, 0xee);
+            jit_emit_u32 (e, (Uint32)insn->insn.seek.num_bytes);
+            return True;
+
+        /* flags are only needed by JO and JC, which have no template */
+        case INSN_TYPE_ADD :
+        case INSN_TYPE_SUB :
+        case INSN_TYPE_MUL :
+        case INSN_TYPE_AND ... INSN_TYPE_XNOR :
+        case INSN_TYPE_LSHIFT ... INSN_TYPE_ROR : {
+            jit_emit_load_reg (e, 0, insn->insn.binop.r1);
+            jit_emit_load_reg (e, 1, insn->insn.binop.r2);
+
+            switch (insn->insn_type) {
+                case INSN_TYPE_ADD :
+                    JIT_EMIT (e, 0x48, 0x01, 0xc8);
+                    break;
+                case INSN_TYPE_SUB :
+                    JIT_EMIT (e, 0x48, 0x29, 0xc8);
+                    break;
+                case INSN_TYPE_MUL :
+                    JIT_EMIT (e, 0x48, 0x0f, 0xaf, 0xc1);
+                    break;
+                case INSN_TYPE_AND :
+                case INSN_TYPE_NAND :
+                    JIT_EMIT (e, 0x48, 0x21, 0xc8);
+                    break;
+                case INSN_TYPE_OR :
+                case INSN_TYPE_NOR :
+                    JIT_EMIT (e, 0x48, 0x09, 0xc8);
+                    break;
+                case INSN_TYPE_XOR :
+                case INSN_TYPE_XNOR :
+                    JIT_EMIT (e, 0x48, 0x31, 0xc8);
+                    break;
+                case INSN_TYPE_LSHIFT :
+                case INSN_TYPE_RSHIFT :
+                    /* shl/shr rax, cl ; xor edx, edx ; cmp rcx, 64 ; cmovae rax, rdx */
+                    JIT_EMIT (e, 0x48, 0xd3, insn->insn_type == INSN_TYPE_LSHIFT ? 0xe0 : 0xe8);
+                    JIT_EMIT (e, 0x31, 0xd2, 0x48, 0x83, 0xf9, 0x40, 0x48, 0x0f, 0x43, 0xc2);
+                    break;
+                case INSN_TYPE_ROL :
+                    JIT_EMIT (e, 0x48, 0xd3, 0xc0);
+                    break;
+                default :
+                    JIT_EMIT (e, 0x48, 0xd3, 0xc8);
+                    break;
+            }
+
+            if (insn->insn_type >= INSN_TYPE_NAND && insn->insn_type <= INSN_TYPE_XNOR) {
+                /* not rax */
+                JIT_EMIT (e, 0x48, 0xf7, 0xd0);
+            }
+
+            jit_emit_store_reg (e, insn->insn.binop.rres, 0);
+            return True;
+        }
+
+        case INSN_TYPE_DIV :
+        case INSN_TYPE_MOD :
+            jit_emit_load_reg (e, 0, insn->insn.binop.r1);
+            jit_emit_load_reg (e, 1, insn->insn.binop.r2);
+            /* test rcx, rcx ; jz bail ; xor edx, edx ; div rcx */
+            JIT_EMIT (e, 0x48, 0x85, 0xc9);
+            jit_emit_jump (e, JIT_COND_E, JIT_LABEL_BAIL (e));
+            JIT_EMIT (e, 0x31, 0xd2, 0x48, 0xf7, 0xf1);
+            jit_emit_store_reg (e, insn->insn.binop.rres, insn->insn_type == INSN_TYPE_DIV ? 0 : 2);
+            return True;
+
+        case INSN_TYPE_NOT :
+            jit_emit_load_reg (e, 0, insn->insn.unop.r1);
+            JIT_EMIT (e, 0x48, 0xf7, 0xd0);
+            jit_emit_store_reg (e, insn->insn.unop.rres, 0);
+            return True;
+
+        case INSN_TYPE_ABS :
+            jit_emit_load_reg (e, 0, insn->insn.unop.r1);
+            /* mov rcx, rax ; neg rax ; cmovs rax, rcx */
+            JIT_EMIT (e, 0x48, 0x89, 0xc1, 0x48, 0xf7, 0xd8, 0x48, 0x0f, 0x48, 0xc1);
+            jit_emit_store_reg (e, insn->insn.unop.rres, 0);
+            return True;
+
+        case INSN_TYPE_CMPEQ ... INSN_TYPE_CMPGT :
+            jit_emit_load_reg (e, 0, insn->insn.binop.r1);
+            jit_emit_load_reg (e, 1, insn->insn.binop.r2);
+            /* xor edx, edx ; cmp rax, rcx ; setcc dl */
+            JIT_EMIT (e, 0x31, 0xd2, 0x48, 0x39, 0xc8);
+            JIT_EMIT (e, 0x0f, (Uint8)(0x90 | cmp_conds[insn->insn_type]), 0xc2);
+            jit_emit_store_reg (e, insn->insn.binop.rres, 2);
+            return True;
+
+        case INSN_TYPE_JA :
+        case INSN_TYPE_JB :
+        case INSN_TYPE_JZ :
+            jit_emit_load_reg (e, 0, insn->insn.jmp.reg);
+            /* test rax, rax */
+            JIT_EMIT (e, 0x48, 0x85, 0xc0);
+            jit_emit_jump (
+                e,
+                insn->insn_type == INSN_TYPE_JA ? JIT_COND_G :
+                insn->insn_type == INSN_TYPE_JB ? JIT_COND_S :
+                                                  JIT_COND_E,
+                insn->insn.jmp.block_sel
+            );
+            return True;
+
+        /* a range check for every case, in order of values */
+        case INSN_TYPE_SWITCH : {
+            SwitchTable* table = loader->switch_tables + insn->insn.switch_table.table_id;
+            jit_emit_load_reg (e, 0, insn->insn.switch_table.reg);
+            for (Size c = 0; c < table->case_count; c++) {
+                /* mov rdx, rax ; mov rcx, first ; sub rdx, rcx */
+                JIT_EMIT (e, 0x48, 0x89, 0xc2, 0x48, 0xb9);
+                jit_emit_u64 (e, table->cases[c].first);
+                JIT_EMIT (e, 0x48, 0x29, 0xca);
+                /* mov rcx, last - first ; cmp rdx, rcx */
+                JIT_EMIT (e, 0x48, 0xb9);
+                jit_emit_u64 (e, table->cases[c].last - table->cases[c].first);
+                JIT_EMIT (e, 0x48, 0x39, 0xca);
+                jit_emit_jump (e, JIT_COND_BE, table->cases[c].block_sel);
+            }
+            return True;
+        }
+
+        case INSN_TYPE_JCMP :
+            jit_emit_load_reg (e, 0, insn->insn.jcmp.r1);
+            /* mov rcx, imm64 */
+            JIT_EMIT (e, 0x48, 0xb9);
+            jit_emit_u64 (e, insn->insn.jcmp.imm);
+            jit_emit_store_reg (e, insn->insn.jcmp.rimm, 1);
+            /* xor edx, edx ; cmp rax, rcx ; setcc dl */
+            JIT_EMIT (e, 0x31, 0xd2, 0x48, 0x39, 0xc8);
+            JIT_EMIT (e, 0x0f, (Uint8)(0x90 | cmp_conds[insn->insn.jcmp.cmp]), 0xc2);
+            jit_emit_store_reg (e, insn->insn.jcmp.rres, 2);
+            /* test edx, edx */
+            JIT_EMIT (e, 0x85, 0xd2);
+            jit_emit_jump (
+                e,
+                insn->insn.jcmp.jump_if ? JIT_COND_NE : JIT_COND_E,
+                insn->insn.jcmp.block_sel
+            );
+            return True;
+
+        case INSN_TYPE_CALL_TYPE_LOADER : {
+            Size    sel    = insn->insn.call_type_loader.type_load_sel;
+            Loader* callee = loader->loader_refs[sel];
+            if (sel > INT32_MAX) {
+                return False;
+            }
+
+            /* callee must fit in caller's memory at r0, interpreter reports it otherwise */
+            if (callee->alloc_size > loader->alloc_size) {
+                jit_emit_jump (e, -1, JIT_LABEL_BAIL (e));
+                return True;
+            }
+            jit_emit_load_reg (e, 0, 0);
+            JIT_EMIT (e, 0x48, 0xb9);
+            jit_emit_u64 (e, loader->alloc_size - callee->alloc_size);
+            /* cmp rax, rcx ; ja bail */
+            JIT_EMIT (e, 0x48, 0x39, 0xc8);
+            jit_emit_jump (e, JIT_COND_A, JIT_LABEL_BAIL (e));
+
+            /* mov [rbx + cursor], r14 ; mov rdi, rbx ; mov esi, sel ; mov rax, call_fn ; call rax */
+            JIT_EMIT (e, 0x4c, 0x89, 0x73, JIT_FRAME_CURSOR);
+            JIT_EMIT (e, 0x48, 0x89, 0xdf, 0xbe);
+            jit_emit_u32 (e, (Uint32)sel);
+            JIT_EMIT (e, 0x48, 0xb8);
+            jit_emit_u64 (e, (Uint64)(Size)call_fn);
+            JIT_EMIT (e, 0xff, 0xd0);
+
+            /* callee has reported it's own failure : test eax, eax ; jle failed */
+            JIT_EMIT (e, 0x85, 0xc0);
+            jit_emit_jump (e, JIT_COND_LE, JIT_LABEL_FAILED (e));
+
+            /* mov r14, [rbx + cursor] */
+            JIT_EMIT (e, 0x4c, 0x8b, 0x73, JIT_FRAME_CURSOR);
+            return True;
+        }
+
+        case INSN_TYPE_EXIT_SUCCESS :
+            jit_emit_jump (e, -1, JIT_LABEL_DONE (e));
+            return True;
+
+        case INSN_TYPE_EXIT_FAILURE :
+            /* interpreter reports the failure */
+            jit_emit_jump (e, -1, JIT_LABEL_BAIL (e));
+            return True;
+
+        /* stack, flags, prints, pow, sqrt, tell, seekr, vectors and checks are interpreted */
+        default :
+            return False;
+    }
+}
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file Jit.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_VM_JIT_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_VM_JIT_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* local includes */
+#include "Loader.h"
+
+/* JIT is opt-in, and only available for x86-64 Linux */
+#if defined(VM_ENABLE_JIT) && defined(__x86_64__) && defined(__linux__)
+#    define VM_JIT_ENABLED 1
+#else
+#    define VM_JIT_ENABLED 0
+#endif
+
+/* number of interpreted executions after which a verified loader is compiled */
+#ifndef VM_JIT_THRESHOLD
+#    define VM_JIT_THRESHOLD 16
+#endif
+
+/**
+ * @b State of one execution of compiled type loader, shared between native code
+ * and the VM. Native code addresses fields by fixed offsets, so order of fields
+ * must not change.
+ * */
+typedef struct JitFrame {
+    Uint64       regs[8]; /**< @b VM registers, only ever kept here. */
+    const Uint8* data;    /**< @b Data of stream being loaded from. */
+    Size         size;    /**< @b Size of stream data. */
+    Size         cursor;  /**< @b Stream cursor, synced on exit and around calls. */
+    Uint8*       mem;     /**< @b Memory of object being loaded. */
+    void*        vm;      /**< @b Executing VM, opaque to native code. */
+    Loader*      loader;  /**< @b Loader being executed. */
+    Size         depth;   /**< @b Call depth of loader being executed. */
+} JitFrame;
+
+/**
+ * @b Return values of compiled loaders and of @c JitCallFn.
+ * */
+typedef enum JitResult {
+    JIT_RESULT_FAILED = -1, /**< @b Execution failed, and error has already been reported. */
+    JIT_RESULT_BAIL   = 0,  /**< @b Execution must be redone by interpreter, nothing reported. */
+    JIT_RESULT_DONE   = 1,  /**< @b Loader executed successfully. */
+} JitResult;
+
+/**
+ * @b Compiled type loader. Takes the frame in, and returns a @c JitResult.
+ * */
+typedef Int32 (*JitLoaderFn) (JitFrame* frame);
+
+/**
+ * @b Called by compiled code to execute @c loader_refs[sel] of frame's loader.
+ * Callee loads at @c mem + @c regs[0] and returns it's @c r0 in @c regs[0].
+ * Must return either @c JIT_RESULT_DONE or @c JIT_RESULT_FAILED.
+ * */
+typedef Int32 (*JitCallFn) (JitFrame* frame, Size sel);
+
+PUBLIC Loader* jit_compile_loader (Loader* loader, JitCallFn call_fn);
+PUBLIC Loader* jit_release_loader (Loader* loader);
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_VM_JIT_H
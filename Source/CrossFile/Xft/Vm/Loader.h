@@ -36,13 +36,70 @@
 #include <Anvie/Common.h>
 #include <Anvie/Types.h>
 
+/* local includes */
+#include "Check.h"
+#include "Packed.h"
+#include "Switch.h"
+
+/**
+ * @b A single field of a @c StructLayout. Field is an array of @c count
+ * elements, each @c size bytes large.
+ * */
+typedef struct StructLayoutField {
+    Size mem_off;    /**< @b Offset of field in memory, relative to first field. */
+    Size stream_off; /**< @b Offset of field in stream, relative to first field. */
+    Size size;       /**< @b Size of a single element (1, 2, 4 or 8). */
+    Size count;      /**< @b Number of elements. */
+    Bool swap;       /**< @b Whether byte order of elements is to be inverted. */
+} StructLayoutField;
+
+/**
+ * @b Describes a run of fixed size reads fused into a single
+ * @c INSN_TYPE_READ_STRUCT. Fields are read from stream back to back.
+ * */
+typedef struct StructLayout {
+    StructLayoutField* fields;
+    Size               field_count;
+    Size               mem_size;    /**< @b Memory spanned by all fields. */
+    Size               stream_size; /**< @b Number of bytes read from stream. */
+    Bool               is_dense;    /**< @b Stream bytes map 1:1 to memory, single memcpy. */
+    Bool               needs_swap;  /**< @b Atleast one field needs byte swapping. */
+} StructLayout;
+
+/**
+ * @b Result of static verification of a type loader.
+ * */
+typedef enum LoaderVerifyStatus {
+    LOADER_VERIFY_PENDING = 0, /**< @b Not verified yet. */
+    LOADER_VERIFY_PASSED,      /**< @b Verified, can be executed without runtime checks. */
+    LOADER_VERIFY_FAILED       /**< @b Rejected by verifier, must be executed with checks. */
+} LoaderVerifyStatus;
+
+/**
+ * @b Whether a type loader has been compiled to native code.
+ * */
+typedef enum LoaderJitStatus {
+    LOADER_JIT_PENDING = 0, /**< @b Not compiled yet, still counting executions. */
+    LOADER_JIT_COMPILED,    /**< @b Native code is available in @c jit_code. */
+    LOADER_JIT_UNSUPPORTED  /**< @b Loader uses instructions JIT can't compile, always interpreted. */
+} LoaderJitStatus;
+
+/**
+ * @b Whether every execution of a type loader reads same number of bytes and does
+ * nothing besides writing it's own object. Elements of an array of such a type can be
+ * loaded independent of each other.
+ * */
+typedef enum LoaderFixedStatus {
+    LOADER_FIXED_PENDING = 0, /**< @b Not analyzed yet. */
+    LOADER_FIXED_ANALYZING,   /**< @b Being analyzed, reached again only through recursion. */
+    LOADER_FIXED_YES,         /**< @b Reads @c fixed_stream_size bytes on every execution. */
+    LOADER_FIXED_NO           /**< @b Reads data dependent number of bytes, or has side effects. */
+} LoaderFixedStatus;
+
 /* proper renaming to make this compatible with public opaque declarations */
 typedef struct XftLoader XftLoader;
 typedef XftLoader        Loader;
 
-/* this is never exposed locally so can be typedef-ed directly like this. */
-typedef struct InsnBlock InsnBlock;
-
 /**
  * @b Type loaders are like methods that get called when VM wants to load
  * another type.
@@ -63,6 +120,29 @@ struct XftLoader {
     Loader **loader_refs;           /**< @b References to all type loaders this loader can call. */
     Size     loader_ref_count;      /**< @b Number of references in the references array */
     Size     loader_ref_capacity;   /**< @b Capacity of references array */
+
+    StructLayout *struct_layouts;         /**< @b Layouts referred to by READ_STRUCT(_A) insns. */
+    Size          struct_layout_count;    /**< @b Number of layouts. */
+    Size          struct_layout_capacity; /**< @b Capacity of layouts array. */
+
+    SwitchTable *switch_tables;         /**< @b Jump tables referred to by SWITCH insns. */
+    Size         switch_table_count;    /**< @b Number of switch tables. */
+    Size         switch_table_capacity; /**< @b Capacity of switch tables array. */
+
+    CheckTable check;               /**< @b Assertions checked by caller over all loaded objects. */
+
+    PackedCode packed_code;         /**< @b Executable form of insn_blocks, encoded on first run. */
+
+    LoaderVerifyStatus verify_status;  /**< @b Result of verifying packed code. */
+    Size               max_stack_size; /**< @b Maximum stack size in bytes, if verified. */
+
+    LoaderJitStatus jit_status;     /**< @b Whether loader has been compiled to native code. */
+    Uint32          jit_exec_count; /**< @b Number of interpreted executions before compiling. */
+    void*           jit_code;       /**< @b Executable mapping holding native code, if compiled. */
+    Size            jit_code_size;  /**< @b Size of executable mapping. */
+
+    LoaderFixedStatus fixed_status;      /**< @b Whether elements can be loaded independently. */
+    Size              fixed_stream_size; /**< @b Bytes read by every execution, if fixed. */
 };
 
 #endif                              // ANVIE_SOURCE_CROSSFILE_XFT_LOADER_H
@@ -0,0 +1,562 @@
+/**
+ * @file Packed.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+
+/* local includes */
+#include "Packed.h"
+#include "Vm.h"
+
+/**
+ * @b Growable byte buffer used while encoding.
+ * */
+typedef struct CodeBuf {
+    Uint8* data;
+    Size   size;
+    Size   capacity;
+} CodeBuf;
+
+/* private method declarations */
+
+static inline CodeBuf*    code_buf_reserve (CodeBuf* buf, Size nb);
+static inline CodeBuf*    code_buf_put_uleb (CodeBuf* buf, Uint64 val);
+static inline Bool        reg_is_valid (Uint8 reg);
+static inline PackedCode* packed_code_add_msg (PackedCode* packed, CString msg, Size* index);
+static inline PackedCode* packed_insn_encode (PackedCode* packed, CodeBuf* buf, Insn* insn);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Encode given instruction blocks into packed form.
+ *
+ * Register operands are validated against @c VM_REG_COUNT while encoding.
+ *
+ * @param[out] packed Will contain encoded code. Any previous contents are
+ *        not freed, use @c packed_code_deinit before re-encoding.
+ * @param blocks Instruction blocks to encode.
+ * @param block_count Number of blocks.
+ *
+ * @return @c packed on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC PackedCode* packed_code_encode (PackedCode* packed, InsnBlock* blocks, Size block_count) {
+    RETURN_VALUE_IF (!packed || (!blocks && block_count), Null, ERR_INVALID_ARGUMENTS);
+
+    memset (packed, 0, sizeof (PackedCode));
+    CodeBuf buf = {0};
+
+    if (block_count) {
+        GOTO_HANDLER_IF (
+            !(packed->block_offsets = ALLOCATE (Size, block_count)),
+            ENCODE_FAILED,
+            ERR_OUT_OF_MEMORY
+        );
+    }
+    packed->block_count = block_count;
+
+    for (Size b = 0; b < block_count; b++) {
+        packed->block_offsets[b] = buf.size;
+
+        for (Size i = 0; i < blocks[b].insn_count; i++) {
+            GOTO_HANDLER_IF (
+                !packed_insn_encode (packed, &buf, blocks[b].insns + i),
+                ENCODE_FAILED,
+                "Failed to encode instruction %zu of block %zu\n",
+                i,
+                b
+            );
+            packed->insn_count++;
+        }
+    }
+
+    /* terminator, and padding to make sure LEB128 decoding never runs off the end */
+    GOTO_HANDLER_IF (
+        !code_buf_reserve (&buf, 1 + PACKED_CODE_PADDING),
+        ENCODE_FAILED,
+        ERR_OUT_OF_MEMORY
+    );
+    buf.data[buf.size++] = INSN_TYPE_EXIT_SUCCESS;
+    memset (buf.data + buf.size, 0, PACKED_CODE_PADDING);
+    buf.size += PACKED_CODE_PADDING;
+
+    packed->code      = buf.data;
+    packed->code_size = buf.size;
+
+    return packed;
+
+ENCODE_FAILED:
+    if (buf.data) {
+        FREE (buf.data);
+    }
+    packed_code_deinit (packed);
+    return Null;
+}
+
+/**
+ * @b De-initialize packed code.
+ *
+ * @param[out] packed
+ *
+ * @return @c packed on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC PackedCode* packed_code_deinit (PackedCode* packed) {
+    RETURN_VALUE_IF (!packed, Null, ERR_INVALID_ARGUMENTS);
+
+    if (packed->code) {
+        FREE (packed->code);
+    }
+
+    if (packed->block_offsets) {
+        FREE (packed->block_offsets);
+    }
+
+    if (packed->msgs) {
+        FREE (packed->msgs);
+    }
+
+    memset (packed, 0, sizeof (PackedCode));
+
+    return packed;
+}
+
+/**
+ * @b Decode packed code back into instruction blocks.
+ *
+ * @param packed
+ * @param[out] block_count Will contain number of decoded blocks.
+ *
+ * @return Array of @c block_count instruction blocks on success. Each block and
+ *         the array itself must be released by caller.
+ * @return @c Null otherwise.
+ * */
+PUBLIC InsnBlock* packed_code_decode (PackedCode* packed, Size* block_count) {
+    RETURN_VALUE_IF (!packed || !packed->code || !block_count, Null, ERR_INVALID_ARGUMENTS);
+
+    InsnBlock* blocks = ALLOCATE (InsnBlock, packed->block_count ? packed->block_count : 1);
+    RETURN_VALUE_IF (!blocks, Null, ERR_OUT_OF_MEMORY);
+
+    for (Size b = 0; b < packed->block_count; b++) {
+        GOTO_HANDLER_IF (!insn_block_init (blocks + b), DECODE_FAILED, ERR_OUT_OF_MEMORY);
+
+        /* last block ends at terminator */
+        Size end = b + 1 < packed->block_count ?
+                       packed->block_offsets[b + 1] :
+                       packed->code_size - PACKED_CODE_PADDING - 1;
+
+        const Uint8* ip = packed->code + packed->block_offsets[b];
+        while (ip < packed->code + end) {
+            Insn insn = {0};
+            GOTO_HANDLER_IF (
+                !(ip = packed_insn_decode (packed, ip, &insn)),
+                DECODE_FAILED,
+                "Failed to decode instruction in block %zu\n",
+                b
+            );
+            GOTO_HANDLER_IF (
+                !insn_block_add_insn (blocks + b, &insn),
+                DECODE_FAILED,
+                ERR_OUT_OF_MEMORY
+            );
+        }
+    }
+
+    *block_count = packed->block_count;
+    return blocks;
+
+DECODE_FAILED:
+    for (Size b = 0; b < packed->block_count; b++) {
+        insn_block_deinit (blocks + b);
+    }
+    FREE (blocks);
+    return Null;
+}
+
+/**
+ * @b Decode a single packed instruction.
+ *
+ * @param packed Code containing the instruction, used to resolve messages.
+ * @param ip Pointer to opcode of instruction.
+ * @param[out] insn Will contain decoded instruction.
+ *
+ * @return Pointer to next instruction on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC const Uint8* packed_insn_decode (PackedCode* packed, const Uint8* ip, Insn* insn) {
+    RETURN_VALUE_IF (!packed || !ip || !insn, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (insn, 0, sizeof (Insn));
+    insn->insn_type = *ip++;
+
+    switch (insn->insn_type) {
+        case INSN_TYPE_SET_REG :
+            insn->insn.set_reg.reg = *ip++;
+            PACKED_READ_ULEB (ip, insn->insn.set_reg.imm);
+            break;
+
+        case INSN_TYPE_READ_R8 ... INSN_TYPE_READ_R64 :
+        case INSN_TYPE_PUSH_R8 ... INSN_TYPE_PUSH_R64 :
+        case INSN_TYPE_POP_R8 ... INSN_TYPE_POP_R64 :
+        case INSN_TYPE_SEEK_R :
+        case INSN_TYPE_TELL :
+            insn->insn.read_reg.reg = *ip++;
+            break;
+
+        case INSN_TYPE_READ_M8 ... INSN_TYPE_READ_M64 :
+        case INSN_TYPE_PUSH_M8 ... INSN_TYPE_PUSH_M64 :
+        case INSN_TYPE_POP_M8 ... INSN_TYPE_POP_M64 :
+            PACKED_READ_ULEB (ip, insn->insn.read_mem.mem_off);
+            break;
+
+        case INSN_TYPE_READ_A8 ... INSN_TYPE_POP_A64 :
+        case INSN_TYPE_READ_A16_LE ... INSN_TYPE_READ_A64_BE :
+            PACKED_READ_ULEB (ip, insn->insn.read_arr.mem_off);
+            PACKED_READ_ULEB (ip, insn->insn.read_arr.elem_count);
+            break;
+
+        case INSN_TYPE_SEEK_FWD :
+        case INSN_TYPE_SEEK_BAK :
+            PACKED_READ_ULEB (ip, insn->insn.seek.num_bytes);
+            break;
+
+        case INSN_TYPE_SQRT :
+        case INSN_TYPE_ABS :
+        case INSN_TYPE_NOT :
+            insn->insn.unop.rres = *ip & 0xf;
+            insn->insn.unop.r1   = *ip++ >> 4;
+            break;
+
+        case INSN_TYPE_ADD ... INSN_TYPE_POW :
+        case INSN_TYPE_AND ... INSN_TYPE_XNOR :
+        case INSN_TYPE_LSHIFT ... INSN_TYPE_CMPGT :
+            insn->insn.binop.rres = *ip & 0xf;
+            insn->insn.binop.r1   = *ip++ >> 4;
+            insn->insn.binop.r2   = *ip++;
+            break;
+
+        case INSN_TYPE_JA ... INSN_TYPE_JC :
+            insn->insn.jmp.reg = *ip++;
+            PACKED_READ_ULEB (ip, insn->insn.jmp.block_sel);
+            break;
+
+        case INSN_TYPE_CALL_TYPE_LOADER :
+            PACKED_READ_ULEB (ip, insn->insn.call_type_loader.type_load_sel);
+            break;
+
+        case INSN_TYPE_CALL_TYPE_LOADER_A :
+            PACKED_READ_ULEB (ip, insn->insn.call_type_loader_arr.type_load_sel);
+            insn->insn.call_type_loader_arr.count_reg = *ip++;
+            PACKED_READ_ULEB (ip, insn->insn.call_type_loader_arr.mem_stride);
+            break;
+
+        case INSN_TYPE_CALL_TYPE_LOADER_V :
+            PACKED_READ_ULEB (ip, insn->insn.call_type_loader_vec.type_load_sel);
+            insn->insn.call_type_loader_vec.count_reg = *ip++;
+            PACKED_READ_ULEB (ip, insn->insn.call_type_loader_vec.mem_off);
+            break;
+
+        case INSN_TYPE_PINFO ... INSN_TYPE_PERR : {
+            Size index;
+            PACKED_READ_ULEB (ip, index);
+            RETURN_VALUE_IF (index >= packed->msg_count, Null, "Invalid message index\n");
+            insn->insn.print.msg = packed->msgs[index];
+            break;
+        }
+
+        case INSN_TYPE_EXIT_SUCCESS :
+        case INSN_TYPE_EXIT_FAILURE :
+            break;
+
+        case INSN_TYPE_READ_STRUCT :
+            PACKED_READ_ULEB (ip, insn->insn.read_struct.mem_off);
+            PACKED_READ_ULEB (ip, insn->insn.read_struct.layout_id);
+            break;
+
+        case INSN_TYPE_READ_STRUCT_A :
+            PACKED_READ_ULEB (ip, insn->insn.read_struct_arr.mem_off);
+            PACKED_READ_ULEB (ip, insn->insn.read_struct_arr.layout_id);
+            PACKED_READ_ULEB (ip, insn->insn.read_struct_arr.elem_count);
+            PACKED_READ_ULEB (ip, insn->insn.read_struct_arr.mem_stride);
+            break;
+
+        case INSN_TYPE_JCMP : {
+            Uint8 cond = *ip++;
+            RETURN_VALUE_IF (
+                (cond & ~PACKED_JCMP_JUMP_IF) > INSN_TYPE_CMPGT - INSN_TYPE_CMPEQ,
+                Null,
+                "Invalid comparision in jcmp\n"
+            );
+            insn->insn.jcmp.cmp     = INSN_TYPE_CMPEQ + (cond & ~PACKED_JCMP_JUMP_IF);
+            insn->insn.jcmp.jump_if = !!(cond & PACKED_JCMP_JUMP_IF);
+            insn->insn.jcmp.rres    = *ip & 0xf;
+            insn->insn.jcmp.r1      = *ip++ >> 4;
+            insn->insn.jcmp.rimm    = *ip++;
+            PACKED_READ_ULEB (ip, insn->insn.jcmp.imm);
+            PACKED_READ_ULEB (ip, insn->insn.jcmp.block_sel);
+            break;
+        }
+
+        case INSN_TYPE_SWITCH :
+            insn->insn.switch_table.reg = *ip++;
+            PACKED_READ_ULEB (ip, insn->insn.switch_table.table_id);
+            break;
+
+        case INSN_TYPE_CHECK :
+            PACKED_READ_ULEB (ip, insn->insn.check.block_sel);
+            break;
+
+        default :
+            RETURN_VALUE_IF_REACHED (Null, "Invalid opcode %u\n", insn->insn_type);
+    }
+
+    return ip;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+static inline CodeBuf* code_buf_reserve (CodeBuf* buf, Size nb) {
+    if (buf->size + nb > buf->capacity) {
+        Size   new_capacity = MAX (buf->capacity * 2, buf->size + nb + 64);
+        Uint8* data         = REALLOCATE (buf->data, Uint8, new_capacity);
+        RETURN_VALUE_IF (!data, Null, ERR_OUT_OF_MEMORY);
+
+        buf->data     = data;
+        buf->capacity = new_capacity;
+    }
+
+    return buf;
+}
+
+/* space must already be reserved for atleast 10 bytes */
+static inline CodeBuf* code_buf_put_uleb (CodeBuf* buf, Uint64 val) {
+    do {
+        Uint8 byte   = val & 0x7f;
+        val        >>= 7;
+        buf->data[buf->size++] = byte | (val ? 0x80 : 0);
+    } while (val);
+
+    return buf;
+}
+
+static inline Bool reg_is_valid (Uint8 reg) {
+    return reg < VM_REG_COUNT;
+}
+
+/**
+ * @b Get index of given message in message table, adding it if not present.
+ * */
+static inline PackedCode* packed_code_add_msg (PackedCode* packed, CString msg, Size* index) {
+    for (Size s = 0; s < packed->msg_count; s++) {
+        if (packed->msgs[s] == msg) {
+            *index = s;
+            return packed;
+        }
+    }
+
+    Size     msg_count = packed->msg_count + 1;
+    CString* msgs      = REALLOCATE (packed->msgs, CString, msg_count);
+    RETURN_VALUE_IF (!msgs, Null, ERR_OUT_OF_MEMORY);
+
+    msgs[packed->msg_count] = msg;
+    packed->msgs            = msgs;
+    *index                  = packed->msg_count++;
+
+    return packed;
+}
+
+static inline PackedCode* packed_insn_encode (PackedCode* packed, CodeBuf* buf, Insn* insn) {
+    RETURN_VALUE_IF (!code_buf_reserve (buf, PACKED_INSN_MAX_SIZE), Null, ERR_OUT_OF_MEMORY);
+
+    buf->data[buf->size++] = insn->insn_type;
+
+    switch (insn->insn_type) {
+        case INSN_TYPE_SET_REG :
+            RETURN_VALUE_IF (!reg_is_valid (insn->insn.set_reg.reg), Null, "Invalid register\n");
+            buf->data[buf->size++] = insn->insn.set_reg.reg;
+            code_buf_put_uleb (buf, insn->insn.set_reg.imm);
+            break;
+
+        case INSN_TYPE_READ_R8 ... INSN_TYPE_READ_R64 :
+        case INSN_TYPE_PUSH_R8 ... INSN_TYPE_PUSH_R64 :
+        case INSN_TYPE_POP_R8 ... INSN_TYPE_POP_R64 :
+        case INSN_TYPE_SEEK_R :
+        case INSN_TYPE_TELL :
+            RETURN_VALUE_IF (!reg_is_valid (insn->insn.read_reg.reg), Null, "Invalid register\n");
+            buf->data[buf->size++] = insn->insn.read_reg.reg;
+            break;
+
+        case INSN_TYPE_READ_M8 ... INSN_TYPE_READ_M64 :
+        case INSN_TYPE_PUSH_M8 ... INSN_TYPE_PUSH_M64 :
+        case INSN_TYPE_POP_M8 ... INSN_TYPE_POP_M64 :
+            code_buf_put_uleb (buf, insn->insn.read_mem.mem_off);
+            break;
+
+        case INSN_TYPE_READ_A8 ... INSN_TYPE_POP_A64 :
+        case INSN_TYPE_READ_A16_LE ... INSN_TYPE_READ_A64_BE :
+            code_buf_put_uleb (buf, insn->insn.read_arr.mem_off);
+            code_buf_put_uleb (buf, insn->insn.read_arr.elem_count);
+            break;
+
+        case INSN_TYPE_SEEK_FWD :
+        case INSN_TYPE_SEEK_BAK :
+            code_buf_put_uleb (buf, insn->insn.seek.num_bytes);
+            break;
+
+        case INSN_TYPE_SQRT :
+        case INSN_TYPE_ABS :
+        case INSN_TYPE_NOT :
+            RETURN_VALUE_IF (
+                !reg_is_valid (insn->insn.unop.rres) || !reg_is_valid (insn->insn.unop.r1),
+                Null,
+                "Invalid register\n"
+            );
+            buf->data[buf->size++] = insn->insn.unop.rres | (insn->insn.unop.r1 << 4);
+            break;
+
+        case INSN_TYPE_ADD ... INSN_TYPE_POW :
+        case INSN_TYPE_AND ... INSN_TYPE_XNOR :
+        case INSN_TYPE_LSHIFT ... INSN_TYPE_CMPGT :
+            RETURN_VALUE_IF (
+                !reg_is_valid (insn->insn.binop.rres) || !reg_is_valid (insn->insn.binop.r1) ||
+                    !reg_is_valid (insn->insn.binop.r2),
+                Null,
+                "Invalid register\n"
+            );
+            buf->data[buf->size++] = insn->insn.binop.rres | (insn->insn.binop.r1 << 4);
+            buf->data[buf->size++] = insn->insn.binop.r2;
+            break;
+
+        case INSN_TYPE_JA ... INSN_TYPE_JC :
+            RETURN_VALUE_IF (!reg_is_valid (insn->insn.jmp.reg), Null, "Invalid register\n");
+            buf->data[buf->size++] = insn->insn.jmp.reg;
+            code_buf_put_uleb (buf, insn->insn.jmp.block_sel);
+            break;
+
+        case INSN_TYPE_CALL_TYPE_LOADER :
+            code_buf_put_uleb (buf, insn->insn.call_type_loader.type_load_sel);
+            break;
+
+        case INSN_TYPE_CALL_TYPE_LOADER_A :
+            RETURN_VALUE_IF (
+                !reg_is_valid (insn->insn.call_type_loader_arr.count_reg),
+                Null,
+                "Invalid register\n"
+            );
+            code_buf_put_uleb (buf, insn->insn.call_type_loader_arr.type_load_sel);
+            buf->data[buf->size++] = insn->insn.call_type_loader_arr.count_reg;
+            code_buf_put_uleb (buf, insn->insn.call_type_loader_arr.mem_stride);
+            break;
+
+        case INSN_TYPE_CALL_TYPE_LOADER_V :
+            RETURN_VALUE_IF (
+                !reg_is_valid (insn->insn.call_type_loader_vec.count_reg),
+                Null,
+                "Invalid register\n"
+            );
+            code_buf_put_uleb (buf, insn->insn.call_type_loader_vec.type_load_sel);
+            buf->data[buf->size++] = insn->insn.call_type_loader_vec.count_reg;
+            code_buf_put_uleb (buf, insn->insn.call_type_loader_vec.mem_off);
+            break;
+
+        case INSN_TYPE_PINFO ... INSN_TYPE_PERR : {
+            Size index = 0;
+            RETURN_VALUE_IF (
+                !packed_code_add_msg (packed, insn->insn.print.msg, &index),
+                Null,
+                ERR_OUT_OF_MEMORY
+            );
+            code_buf_put_uleb (buf, index);
+            break;
+        }
+
+        case INSN_TYPE_EXIT_SUCCESS :
+        case INSN_TYPE_EXIT_FAILURE :
+            break;
+
+        case INSN_TYPE_READ_STRUCT :
+            code_buf_put_uleb (buf, insn->insn.read_struct.mem_off);
+            code_buf_put_uleb (buf, insn->insn.read_struct.layout_id);
+            break;
+
+        case INSN_TYPE_READ_STRUCT_A :
+            code_buf_put_uleb (buf, insn->insn.read_struct_arr.mem_off);
+            code_buf_put_uleb (buf, insn->insn.read_struct_arr.layout_id);
+            code_buf_put_uleb (buf, insn->insn.read_struct_arr.elem_count);
+            code_buf_put_uleb (buf, insn->insn.read_struct_arr.mem_stride);
+            break;
+
+        case INSN_TYPE_JCMP :
+            RETURN_VALUE_IF (
+                insn->insn.jcmp.cmp < INSN_TYPE_CMPEQ || insn->insn.jcmp.cmp > INSN_TYPE_CMPGT,
+                Null,
+                "Invalid comparision in jcmp\n"
+            );
+            RETURN_VALUE_IF (
+                !reg_is_valid (insn->insn.jcmp.rres) || !reg_is_valid (insn->insn.jcmp.r1) ||
+                    !reg_is_valid (insn->insn.jcmp.rimm),
+                Null,
+                "Invalid register\n"
+            );
+            buf->data[buf->size++] = (insn->insn.jcmp.cmp - INSN_TYPE_CMPEQ) |
+                                     (insn->insn.jcmp.jump_if ? PACKED_JCMP_JUMP_IF : 0);
+            buf->data[buf->size++] = insn->insn.jcmp.rres | (insn->insn.jcmp.r1 << 4);
+            buf->data[buf->size++] = insn->insn.jcmp.rimm;
+            code_buf_put_uleb (buf, insn->insn.jcmp.imm);
+            code_buf_put_uleb (buf, insn->insn.jcmp.block_sel);
+            break;
+
+        case INSN_TYPE_SWITCH :
+            RETURN_VALUE_IF (
+                !reg_is_valid (insn->insn.switch_table.reg),
+                Null,
+                "Invalid register\n"
+            );
+            buf->data[buf->size++] = insn->insn.switch_table.reg;
+            code_buf_put_uleb (buf, insn->insn.switch_table.table_id);
+            break;
+
+        case INSN_TYPE_CHECK :
+            code_buf_put_uleb (buf, insn->insn.check.block_sel);
+            break;
+
+        default :
+            RETURN_VALUE_IF_REACHED (Null, "Invalid instruction type %u\n", insn->insn_type);
+    }
+
+    return packed;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file Packed.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_VM_PACKED_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_VM_PACKED_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* local includes */
+#include "Insn.h"
+
+/**
+ * @b Variable length encoding of all instruction blocks of a type loader,
+ * laid out contiguously in the order of blocks. This is the form in which
+ * the VM executes instructions.
+ *
+ * Every instruction starts with a 1 byte opcode (@c InsnType) followed by it's
+ * operands :
+ * - register operands take a single byte, two registers share one byte
+ *   (low nibble first) for binary and unary ops, so two bytes for binops,
+ * - memory offsets, element counts, seek sizes, immediates, block and
+ *   loader selectors are unsigned LEB128,
+ * - messages are stored as LEB128 index into @c msgs,
+ * - @c INSN_TYPE_JCMP stores it's comparision as offset from @c INSN_TYPE_CMPEQ
+ *   in a single byte, with @c PACKED_JCMP_JUMP_IF set when jump is taken on
+ *   a true comparision,
+ * - @c INSN_TYPE_SWITCH stores it's register in a single byte, followed by
+ *   LEB128 index of jump table in loader.
+ *
+ * Since blocks are contiguous, falling off the end of a block continues with
+ * the next block. An @c INSN_TYPE_EXIT_SUCCESS is appended after last block,
+ * followed by zero padding so that a decoder can never run past end of code.
+ * */
+typedef struct PackedCode {
+    Uint8* code;          /**< @b Encoded instructions of all blocks. */
+    Size   code_size;     /**< @b Size of code including terminator and padding. */
+    Size*  block_offsets; /**< @b Offset of first instruction of each block in code. */
+    Size   block_count;
+    CString* msgs;        /**< @b Messages referred to by print instructions. */
+    Size     msg_count;
+    Size     insn_count;  /**< @b Number of encoded instructions (excluding terminator). */
+} PackedCode;
+
+/* zero bytes after terminator, more than the longest LEB128 operand */
+#define PACKED_CODE_PADDING 16
+
+/* maximum length of a single encoded instruction (rdsta) */
+#define PACKED_INSN_MAX_SIZE (1 + 4 * 10)
+
+/* set in comparision byte of jcmp when jump is taken if comparision is true */
+#define PACKED_JCMP_JUMP_IF 0x80
+
+PUBLIC PackedCode*  packed_code_encode (PackedCode* packed, InsnBlock* blocks, Size block_count);
+PUBLIC PackedCode*  packed_code_deinit (PackedCode* packed);
+PUBLIC InsnBlock*   packed_code_decode (PackedCode* packed, Size* block_count);
+PUBLIC const Uint8* packed_insn_decode (PackedCode* packed, const Uint8* ip, Insn* insn);
+
+/**
+ * @b Decode an unsigned LEB128 value, advancing @c ip. Single byte values
+ * (the common case) are decoded inline.
+ * */
+#define PACKED_READ_ULEB(ip, dst)                                                                  \
+    do {                                                                                           \
+        Uint64 uleb_val_ = *(ip)++;                                                                \
+        if (uleb_val_ & 0x80) {                                                                    \
+            uleb_val_ = packed_read_uleb_slow (&(ip), uleb_val_);                                  \
+        }                                                                                          \
+        (dst) = uleb_val_;                                                                         \
+    } while (0)
+
+/**
+ * @b Continue decoding a multi byte LEB128 value whose first byte was @c first.
+ * Stops after 10 bytes, the maximum needed for 64 bit values.
+ * */
+PRIVATE Uint64 packed_read_uleb_slow (const Uint8** ip, Uint64 first) {
+    Uint64       val   = first & 0x7f;
+    const Uint8* iter  = *ip;
+    Uint32       shift = 7;
+
+    for (Uint32 s = 1; s < 10; s++, shift += 7) {
+        Uint8 byte  = *iter++;
+        val        |= (Uint64)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+
+    *ip = iter;
+    return val;
+}
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_VM_PACKED_H
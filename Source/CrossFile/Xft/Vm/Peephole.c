@@ -0,0 +1,412 @@
+/**
+ * @file Peephole.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+
+/* local includes */
+#include "../../Stream/Stream.h"
+#include "Insn.h"
+#include "Loader.h"
+#include "Peephole.h"
+
+/* private method declarations */
+
+static inline Size    fixed_read_elem_size (Insn* insn);
+static inline Bool    fixed_read_needs_swap (Insn* insn);
+static inline Size    peephole_fuse_reads (Loader* loader, Insn* insns, Size count, Insn* fused);
+static inline Bool    peephole_fold_jcmp (Insn* insns, Size count, Insn* folded);
+static inline Bool    struct_layout_is_equal (StructLayout* a, StructLayout* b);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Optimize instructions of given loader in place.
+ *
+ * Following patterns are replaced with superinstructions :
+ * - runs of two or more consecutive @c READ_Mx and @c READ_Ax instructions
+ *   (including byte order specific ones) become a single @c READ_STRUCT, with
+ *   layout of the run added to loader's struct layout table,
+ * - @c SET_REG followed by a @c CMPxx using that register and a @c JZ or @c JA
+ *   on comparision result becomes a single @c JCMP.
+ *
+ * Optimization never changes number or order of blocks, so block selectors
+ * stay valid. Must be called before loader is first executed, because packed
+ * code is not re-encoded afterwards.
+ *
+ * @param loader Loader to optimize.
+ * @param[out] stats Instruction counts before and after optimization. Can be @c Null.
+ *
+ * @return @c loader on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader* peephole_optimize_loader (Loader* loader, PeepholeStats* stats) {
+    RETURN_VALUE_IF (
+        !loader || (!loader->insn_blocks && loader->insn_block_count),
+        Null,
+        ERR_INVALID_ARGUMENTS
+    );
+
+    PeepholeStats s = {0};
+
+    for (Size b = 0; b < loader->insn_block_count; b++) {
+        InsnBlock* block = loader->insn_blocks + b;
+        Insn*      insns = block->insns;
+        Size       count = block->insn_count;
+
+        s.insn_count_before += count;
+
+        /* optimized code is never longer, so it's written over the original */
+        Size w = 0;
+        for (Size r = 0; r < count;) {
+            Insn super    = {0};
+            Size consumed = 0;
+
+            if (peephole_fold_jcmp (insns + r, count - r, &super)) {
+                consumed = 3;
+                s.jumps_folded++;
+            } else if ((consumed = peephole_fuse_reads (loader, insns + r, count - r, &super))) {
+                s.reads_fused += consumed;
+            }
+
+            if (consumed) {
+                insns[w++]  = super;
+                r          += consumed;
+            } else {
+                insns[w++] = insns[r++];
+            }
+        }
+
+        block->insn_count   = w;
+        s.insn_count_after += w;
+    }
+
+    if (stats) {
+        *stats = s;
+    }
+
+    return loader;
+}
+
+/**
+ * @b De-initialize given struct layout.
+ *
+ * @param[out] layout
+ *
+ * @return @c layout on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC StructLayout* struct_layout_deinit (StructLayout* layout) {
+    RETURN_VALUE_IF (!layout, Null, ERR_INVALID_ARGUMENTS);
+
+    if (layout->fields) {
+        FREE (layout->fields);
+    }
+
+    memset (layout, 0, sizeof (StructLayout));
+
+    return layout;
+}
+
+/**
+ * @b Add given layout to loader's layout table, taking ownership of it's
+ * fields. If an equal layout already exists, it's reused and given layout
+ * is de-initialized.
+ *
+ * Code generators use this to get layout id for @c READ_STRUCT_A.
+ *
+ * @param loader
+ * @param layout Layout to add, fields must be allocated using @c ALLOCATE.
+ * @param[out] id Index of layout in loader's layout table.
+ *
+ * @return @c loader on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader* loader_add_struct_layout (Loader* loader, StructLayout* layout, Size* id) {
+    RETURN_VALUE_IF (!loader || !layout || !id, Null, ERR_INVALID_ARGUMENTS);
+
+    for (Size l = 0; l < loader->struct_layout_count; l++) {
+        if (struct_layout_is_equal (loader->struct_layouts + l, layout)) {
+            struct_layout_deinit (layout);
+            *id = l;
+            return loader;
+        }
+    }
+
+    if (loader->struct_layout_count >= loader->struct_layout_capacity) {
+        Size new_capacity = loader->struct_layout_capacity ? loader->struct_layout_capacity * 2 : 4;
+        StructLayout* layouts = REALLOCATE (loader->struct_layouts, StructLayout, new_capacity);
+        RETURN_VALUE_IF (!layouts, Null, ERR_OUT_OF_MEMORY);
+
+        loader->struct_layouts         = layouts;
+        loader->struct_layout_capacity = new_capacity;
+    }
+
+    *id                         = loader->struct_layout_count;
+    loader->struct_layouts[*id] = *layout;
+    loader->struct_layout_count++;
+
+    return loader;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Get element size of a read instruction that reads a fixed number of
+ * bytes from stream into memory.
+ *
+ * @return Element size in bytes if instruction is such a read.
+ * @return 0 otherwise.
+ * */
+static inline Size fixed_read_elem_size (Insn* insn) {
+    switch (insn->insn_type) {
+        case INSN_TYPE_READ_M8 :
+        case INSN_TYPE_READ_A8 :
+            return 1;
+        case INSN_TYPE_READ_M16 :
+        case INSN_TYPE_READ_A16 :
+            return 2;
+        case INSN_TYPE_READ_M32 :
+        case INSN_TYPE_READ_A32 :
+            return 4;
+        case INSN_TYPE_READ_M64 :
+        case INSN_TYPE_READ_A64 :
+            return 8;
+        case INSN_TYPE_READ_A16_LE :
+        case INSN_TYPE_READ_A16_BE :
+            return 2;
+        case INSN_TYPE_READ_A32_LE :
+        case INSN_TYPE_READ_A32_BE :
+            return 4;
+        case INSN_TYPE_READ_A64_LE :
+        case INSN_TYPE_READ_A64_BE :
+            return 8;
+        default :
+            return 0;
+    }
+}
+
+/**
+ * @b Whether elements read by a fixed size read are stored in a byte order
+ * different from host.
+ * */
+static inline Bool fixed_read_needs_swap (Insn* insn) {
+    switch (insn->insn_type) {
+        case INSN_TYPE_READ_A16_LE ... INSN_TYPE_READ_A64_LE :
+            return HOST_BYTE_ORDER_IS_MSB;
+        case INSN_TYPE_READ_A16_BE ... INSN_TYPE_READ_A64_BE :
+            return HOST_BYTE_ORDER_IS_LSB;
+        default :
+            return False;
+    }
+}
+
+/**
+ * @b Fuse run of fixed size reads at start of given instructions.
+ *
+ * @param loader Loader where layout of fused run will be added.
+ * @param insns
+ * @param count Number of instructions available in @c insns.
+ * @param[out] fused Will contain READ_STRUCT instruction.
+ *
+ * @return Number of instructions fused, 0 if nothing was fused.
+ * */
+static inline Size peephole_fuse_reads (Loader* loader, Insn* insns, Size count, Insn* fused) {
+    Size run = 0;
+    while (run < count && fixed_read_elem_size (insns + run)) {
+        run++;
+    }
+
+    if (run < 2) {
+        return 0;
+    }
+
+    StructLayout layout = {0};
+    layout.fields       = ALLOCATE (StructLayoutField, run);
+    RETURN_VALUE_IF (!layout.fields, 0, ERR_OUT_OF_MEMORY);
+
+    /* fields store absolute offsets till base of memory range is known */
+    Size base    = (Size)-1;
+    Size mem_end = 0;
+    for (Size i = 0; i < run; i++) {
+        Insn*              insn  = insns + i;
+        StructLayoutField* field = layout.fields + i;
+
+        InsnType type   = insn->insn_type;
+        Bool     is_arr = (type >= INSN_TYPE_READ_A8 && type <= INSN_TYPE_READ_A64) ||
+                          (type >= INSN_TYPE_READ_A16_LE && type <= INSN_TYPE_READ_A64_BE);
+        field->size       = fixed_read_elem_size (insn);
+        field->count      = is_arr ? insn->insn.read_arr.elem_count : 1;
+        field->swap       = fixed_read_needs_swap (insn);
+        field->mem_off    = insn->insn.read_mem.mem_off;
+        field->stream_off = layout.stream_size;
+
+        /* sizes that overflow are left for VM to report at runtime, stop the run here */
+        Size nbytes, field_end, stream_end;
+        if (__builtin_mul_overflow (field->size, field->count, &nbytes) ||
+            __builtin_add_overflow (field->mem_off, nbytes, &field_end) ||
+            __builtin_add_overflow (layout.stream_size, nbytes, &stream_end)) {
+            break;
+        }
+
+        base               = MIN (base, field->mem_off);
+        mem_end            = MAX (mem_end, field_end);
+        layout.stream_size = stream_end;
+        layout.field_count++;
+    }
+
+    if (layout.field_count < 2) {
+        struct_layout_deinit (&layout);
+        return 0;
+    }
+
+    layout.mem_size = mem_end - base;
+    layout.is_dense = True;
+    for (Size f = 0; f < layout.field_count; f++) {
+        layout.fields[f].mem_off -= base;
+        layout.is_dense          &= layout.fields[f].mem_off == layout.fields[f].stream_off;
+        layout.needs_swap        |= layout.fields[f].swap;
+    }
+
+    Size id          = 0;
+    Size fused_count = layout.field_count;
+    if (!loader_add_struct_layout (loader, &layout, &id)) {
+        struct_layout_deinit (&layout);
+        return 0;
+    }
+
+    *fused = (Insn) {
+        .insn_type = INSN_TYPE_READ_STRUCT,
+        .insn      = {.read_struct = {.mem_off = base, .layout_id = id}}
+    };
+
+    return fused_count;
+}
+
+/**
+ * @b Fold a @c SET_REG, @c CMPxx, @c JZ/JA triple at start of given instructions.
+ *
+ * Folded instruction still writes both the immediate and the comparision
+ * result to their registers, so the fold is valid without knowing whether
+ * these registers are used later.
+ *
+ * @param insns
+ * @param count Number of instructions available in @c insns.
+ * @param[out] folded Will contain JCMP instruction.
+ *
+ * @return @c True if a triple was folded.
+ * @return @c False otherwise.
+ * */
+static inline Bool peephole_fold_jcmp (Insn* insns, Size count, Insn* folded) {
+    if (count < 3) {
+        return False;
+    }
+
+    Insn* set = insns;
+    Insn* cmp = insns + 1;
+    Insn* jmp = insns + 2;
+
+    if (set->insn_type != INSN_TYPE_SET_REG || cmp->insn_type < INSN_TYPE_CMPEQ ||
+        cmp->insn_type > INSN_TYPE_CMPGT ||
+        (jmp->insn_type != INSN_TYPE_JZ && jmp->insn_type != INSN_TYPE_JA) ||
+        jmp->insn.jmp.reg != cmp->insn.binop.rres) {
+        return False;
+    }
+
+    Uint8    rimm = set->insn.set_reg.reg;
+    Uint8    r1   = 0;
+    InsnType op   = cmp->insn_type;
+
+    if (cmp->insn.binop.r2 == rimm && cmp->insn.binop.r1 != rimm) {
+        r1 = cmp->insn.binop.r1;
+    } else if (cmp->insn.binop.r1 == rimm && cmp->insn.binop.r2 != rimm) {
+        /* immediate is on the left, mirror comparision to keep register on left */
+        r1 = cmp->insn.binop.r2;
+        switch (op) {
+            case INSN_TYPE_CMPLE :
+                op = INSN_TYPE_CMPGE;
+                break;
+            case INSN_TYPE_CMPLT :
+                op = INSN_TYPE_CMPGT;
+                break;
+            case INSN_TYPE_CMPGE :
+                op = INSN_TYPE_CMPLE;
+                break;
+            case INSN_TYPE_CMPGT :
+                op = INSN_TYPE_CMPLT;
+                break;
+            default :
+                break;
+        }
+    } else {
+        return False;
+    }
+
+    /* comparisions give 0 or 1, so ja jumps on true and jz on false */
+    *folded = (Insn) {
+        .insn_type = INSN_TYPE_JCMP,
+        .insn      = {.jcmp = {
+                          .cmp       = op,
+                          .jump_if   = jmp->insn_type == INSN_TYPE_JA,
+                          .rres      = cmp->insn.binop.rres,
+                          .r1        = r1,
+                          .rimm      = rimm,
+                          .imm       = set->insn.set_reg.imm,
+                          .block_sel = jmp->insn.jmp.block_sel,
+                      }}
+    };
+
+    return True;
+}
+
+static inline Bool struct_layout_is_equal (StructLayout* a, StructLayout* b) {
+    if (a->field_count != b->field_count || a->mem_size != b->mem_size ||
+        a->stream_size != b->stream_size) {
+        return False;
+    }
+
+    for (Size f = 0; f < a->field_count; f++) {
+        StructLayoutField* fa = a->fields + f;
+        StructLayoutField* fb = b->fields + f;
+        if (fa->mem_off != fb->mem_off || fa->stream_off != fb->stream_off ||
+            fa->size != fb->size || fa->count != fb->count || fa->swap != fb->swap) {
+            return False;
+        }
+    }
+
+    return True;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file Peephole.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_VM_PEEPHOLE_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_VM_PEEPHOLE_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* local includes */
+#include "Loader.h"
+
+/**
+ * @b Instruction counts reported by peephole optimizer.
+ * */
+typedef struct PeepholeStats {
+    Size insn_count_before; /**< @b Number of instructions before optimization. */
+    Size insn_count_after;  /**< @b Number of instructions after optimization. */
+    Size reads_fused;       /**< @b Number of read instructions fused into READ_STRUCT. */
+    Size jumps_folded;      /**< @b Number of setr, cmpxx, jz/ja triples folded into JCMP. */
+} PeepholeStats;
+
+PUBLIC Loader*       peephole_optimize_loader (Loader* loader, PeepholeStats* stats);
+PUBLIC StructLayout* struct_layout_deinit (StructLayout* layout);
+PUBLIC Loader*       loader_add_struct_layout (Loader* loader, StructLayout* layout, Size* id);
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_VM_PEEPHOLE_H
@@ -0,0 +1,301 @@
+/**
+ * @file Pool.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <memory.h>
+#include <unistd.h>
+
+/* local includes */
+#include "Pool.h"
+
+/* private method declarations */
+
+static inline void* vm_pool_thread (void* arg);
+static inline void  vm_pool_work (VmPool* pool, VmPoolWorker* self);
+static inline Bool  vm_pool_take (VmPool* pool, VmPoolWorker* self, Size* begin, Size* end);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Initialize given pool and start it's threads.
+ *
+ * @param pool Pool to be initialized.
+ * @param thread_count Number of threads working on a task, including the one that
+ *        runs it. Pass @c 0 to use one thread per online processor.
+ *
+ * @return @c pool on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC VmPool* vm_pool_init (VmPool* pool, Size thread_count) {
+    RETURN_VALUE_IF (!pool, Null, ERR_INVALID_ARGUMENTS);
+
+    if (!thread_count) {
+        long ncpu    = sysconf (_SC_NPROCESSORS_ONLN);
+        thread_count = ncpu > 0 ? (Size)ncpu : 1;
+    }
+
+    memset (pool, 0, sizeof (VmPool));
+    pool->workers = ALLOCATE (VmPoolWorker, thread_count);
+    RETURN_VALUE_IF (!pool->workers, Null, ERR_OUT_OF_MEMORY);
+
+    pthread_mutex_init (&pool->run_lock, Null);
+    pthread_mutex_init (&pool->lock, Null);
+    pthread_cond_init (&pool->task_ready, Null);
+    pthread_cond_init (&pool->task_done, Null);
+
+    /* worker count only includes workers that have been started, for deinit */
+    for (Size w = 0; w < thread_count; w++) {
+        VmPoolWorker* worker = pool->workers + w;
+        worker->pool         = pool;
+        worker->id           = w;
+        pthread_mutex_init (&worker->lock, Null);
+
+        if (w && pthread_create (&worker->thread, Null, vm_pool_thread, worker)) {
+            pthread_mutex_destroy (&worker->lock);
+            PRINT_ERR ("Failed to start thread %zu of VM pool\n", w);
+            vm_pool_deinit (pool);
+            return Null;
+        }
+
+        pool->worker_count++;
+    }
+
+    return pool;
+}
+
+/**
+ * @b Stop all threads of given pool, and de-initialize it.
+ *
+ * @param pool
+ *
+ * @return @c pool on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC VmPool* vm_pool_deinit (VmPool* pool) {
+    RETURN_VALUE_IF (!pool, Null, ERR_INVALID_ARGUMENTS);
+
+    pthread_mutex_lock (&pool->lock);
+    pool->stopping = True;
+    pthread_cond_broadcast (&pool->task_ready);
+    pthread_mutex_unlock (&pool->lock);
+
+    for (Size w = 0; w < pool->worker_count; w++) {
+        if (w) {
+            pthread_join (pool->workers[w].thread, Null);
+        }
+        pthread_mutex_destroy (&pool->workers[w].lock);
+    }
+
+    if (pool->workers) {
+        FREE (pool->workers);
+    }
+
+    pthread_cond_destroy (&pool->task_done);
+    pthread_cond_destroy (&pool->task_ready);
+    pthread_mutex_destroy (&pool->lock);
+    pthread_mutex_destroy (&pool->run_lock);
+
+    memset (pool, 0, sizeof (VmPool));
+
+    return pool;
+}
+
+/**
+ * @b Execute all items @c [0, count) of a task on all workers of given pool.
+ *
+ * Items are split into one contiguous range per worker. A worker executes it's
+ * range @c grain items at a time, and once it's out of items, steals half of
+ * what's left of another worker's range. Calling thread works as worker 0 and
+ * returns once every item has been executed, or once any range fails.
+ *
+ * @param pool Initialized pool.
+ * @param count Number of items.
+ * @param grain Maximum number of items executed in a single call of @c task.
+ * @param task Called for ranges of items, from multiple threads at once.
+ * @param data Passed to @c task.
+ *
+ * @return @c True if all items were executed successfully.
+ * @return @c False otherwise.
+ * */
+PUBLIC Bool vm_pool_run (VmPool* pool, Size count, Size grain, VmPoolTaskFn task, void* data) {
+    RETURN_VALUE_IF (!pool || !pool->worker_count || !task, False, ERR_INVALID_ARGUMENTS);
+
+    if (!count) {
+        return True;
+    }
+
+    pthread_mutex_lock (&pool->run_lock);
+
+    Size n     = pool->worker_count;
+    Size per   = count / n;
+    Size extra = count % n;
+    for (Size w = 0; w < n; w++) {
+        VmPoolWorker* worker = pool->workers + w;
+        pthread_mutex_lock (&worker->lock);
+        worker->begin = w * per + MIN (w, extra);
+        worker->end   = worker->begin + per + (w < extra);
+        pthread_mutex_unlock (&worker->lock);
+    }
+
+    pthread_mutex_lock (&pool->lock);
+    pool->task       = task;
+    pool->task_data  = data;
+    pool->grain      = MAX (grain, 1);
+    pool->failed     = False;
+    pool->busy_count = n - 1;
+    pool->task_id++;
+    pthread_cond_broadcast (&pool->task_ready);
+    pthread_mutex_unlock (&pool->lock);
+
+    vm_pool_work (pool, pool->workers);
+
+    pthread_mutex_lock (&pool->lock);
+    while (pool->busy_count) {
+        pthread_cond_wait (&pool->task_done, &pool->lock);
+    }
+    Bool res = !pool->failed;
+    pthread_mutex_unlock (&pool->lock);
+
+    pthread_mutex_unlock (&pool->run_lock);
+
+    return res;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Entry point of every thread of pool except worker 0. Works on each task once,
+ * till pool is stopped.
+ * */
+static inline void* vm_pool_thread (void* arg) {
+    VmPoolWorker* self = arg;
+    VmPool*       pool = self->pool;
+    Uint64        seen = 0;
+
+    pthread_mutex_lock (&pool->lock);
+    for (;;) {
+        while (!pool->stopping && pool->task_id == seen) {
+            pthread_cond_wait (&pool->task_ready, &pool->lock);
+        }
+        if (pool->stopping) {
+            break;
+        }
+
+        seen = pool->task_id;
+        pthread_mutex_unlock (&pool->lock);
+
+        vm_pool_work (pool, self);
+
+        pthread_mutex_lock (&pool->lock);
+        if (!--pool->busy_count) {
+            pthread_cond_signal (&pool->task_done);
+        }
+    }
+    pthread_mutex_unlock (&pool->lock);
+
+    return Null;
+}
+
+/**
+ * @b Execute ranges of current task till there's nothing left to take or steal,
+ * or some range has failed.
+ * */
+static inline void vm_pool_work (VmPool* pool, VmPoolWorker* self) {
+    Size begin = 0;
+    Size end   = 0;
+
+    while (!__atomic_load_n (&pool->failed, __ATOMIC_RELAXED) &&
+           vm_pool_take (pool, self, &begin, &end)) {
+        if (!pool->task (pool->task_data, self->id, begin, end)) {
+            __atomic_store_n (&pool->failed, True, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * @b Take next range of items to be executed by given worker, first from it's own
+ * range, then from other workers' ranges.
+ *
+ * A stolen range becomes worker's own range, so what it doesn't execute right away
+ * can be stolen again.
+ *
+ * @return @c True if a range was taken.
+ * @return @c False if no items are left anywhere.
+ * */
+static inline Bool vm_pool_take (VmPool* pool, VmPoolWorker* self, Size* begin, Size* end) {
+    Size grain = pool->grain;
+
+    pthread_mutex_lock (&self->lock);
+    if (self->begin < self->end) {
+        *begin      = self->begin;
+        *end        = *begin + MIN (grain, self->end - *begin);
+        self->begin = *end;
+        pthread_mutex_unlock (&self->lock);
+        return True;
+    }
+    pthread_mutex_unlock (&self->lock);
+
+    for (Size k = 1; k < pool->worker_count; k++) {
+        VmPoolWorker* victim = pool->workers + (self->id + k) % pool->worker_count;
+
+        pthread_mutex_lock (&victim->lock);
+        Size left = victim->end - victim->begin;
+        if (!left) {
+            pthread_mutex_unlock (&victim->lock);
+            continue;
+        }
+
+        /* rounded up, so a single item left can be stolen as well */
+        Size stolen_end   = victim->end;
+        Size stolen_begin = stolen_end - (left + 1) / 2;
+        victim->end       = stolen_begin;
+        pthread_mutex_unlock (&victim->lock);
+
+        *begin = stolen_begin;
+        *end   = stolen_begin + MIN (grain, stolen_end - stolen_begin);
+
+        pthread_mutex_lock (&self->lock);
+        self->begin = *end;
+        self->end   = stolen_end;
+        pthread_mutex_unlock (&self->lock);
+        return True;
+    }
+
+    return False;
+}
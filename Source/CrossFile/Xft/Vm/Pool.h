@@ -0,0 +1,96 @@
+/**
+ * @file Pool.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_VM_POOL_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_VM_POOL_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* libc */
+#include <pthread.h>
+
+/**
+ * @b Executes a range @c [begin, end) of items of a task.
+ *
+ * @param task_data Data passed to @c vm_pool_run.
+ * @param worker Index of worker executing the range, less than @c VmPool::worker_count.
+ *
+ * @return @c True on success.
+ * @return @c False to stop the whole task.
+ * */
+typedef Bool (*VmPoolTaskFn) (void* task_data, Size worker, Size begin, Size end);
+
+typedef struct VmPool VmPool;
+
+/**
+ * @b Items of a task not yet taken by a worker. Owner takes items from the front,
+ * while other workers steal half of what's left from the back.
+ * */
+typedef struct VmPoolWorker {
+    pthread_mutex_t lock;
+    Size            begin;
+    Size            end;
+
+    VmPool*   pool;
+    Size      id;
+    pthread_t thread; /**< @b Not started for worker 0, which is the thread running task. */
+} VmPoolWorker;
+
+/**
+ * @b A fixed set of threads executing ranges of items of one task at a time,
+ * balanced by work stealing. Thread that runs a task works as worker 0.
+ * */
+struct VmPool {
+    VmPoolWorker* workers;
+    Size          worker_count;
+
+    pthread_mutex_t run_lock;  /**< @b Held while a task is running, tasks never overlap. */
+    pthread_mutex_t lock;      /**< @b Protects everything below. */
+    pthread_cond_t  task_ready;
+    pthread_cond_t  task_done;
+
+    VmPoolTaskFn task;
+    void*        task_data;
+    Size         grain;        /**< @b Number of items a worker takes from it's range at a time. */
+    Uint64       task_id;      /**< @b Incremented for every task, threads wait for it to change. */
+    Size         busy_count;   /**< @b Threads still working on current task. */
+    Bool         failed;       /**< @b Set once any range of current task fails. */
+    Bool         stopping;
+};
+
+PUBLIC VmPool* vm_pool_init (VmPool* pool, Size thread_count);
+PUBLIC VmPool* vm_pool_deinit (VmPool* pool);
+PUBLIC Bool    vm_pool_run (VmPool* pool, Size count, Size grain, VmPoolTaskFn task, void* data);
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_VM_POOL_H
@@ -0,0 +1,477 @@
+/**
+ * @file Profile.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <string.h>
+
+/* local includes */
+#include "Profile.h"
+
+/* names of instructions as used in summary */
+static const CString insn_type_names[INSN_TYPE_MAX] = {
+    [INSN_TYPE_UNKNOWN]            = "unknown",
+    [INSN_TYPE_SET_REG]            = "setr",
+    [INSN_TYPE_READ_R8]            = "rdr8",
+    [INSN_TYPE_READ_R16]           = "rdr16",
+    [INSN_TYPE_READ_R32]           = "rdr32",
+    [INSN_TYPE_READ_R64]           = "rdr64",
+    [INSN_TYPE_READ_M8]            = "rdm8",
+    [INSN_TYPE_READ_M16]           = "rdm16",
+    [INSN_TYPE_READ_M32]           = "rdm32",
+    [INSN_TYPE_READ_M64]           = "rdm64",
+    [INSN_TYPE_PUSH_R8]            = "pushr8",
+    [INSN_TYPE_PUSH_R16]           = "pushr16",
+    [INSN_TYPE_PUSH_R32]           = "pushr32",
+    [INSN_TYPE_PUSH_R64]           = "pushr64",
+    [INSN_TYPE_PUSH_M8]            = "pushm8",
+    [INSN_TYPE_PUSH_M16]           = "pushm16",
+    [INSN_TYPE_PUSH_M32]           = "pushm32",
+    [INSN_TYPE_PUSH_M64]           = "pushm64",
+    [INSN_TYPE_POP_R8]             = "popr8",
+    [INSN_TYPE_POP_R16]            = "popr16",
+    [INSN_TYPE_POP_R32]            = "popr32",
+    [INSN_TYPE_POP_R64]            = "popr64",
+    [INSN_TYPE_POP_M8]             = "popm8",
+    [INSN_TYPE_POP_M16]            = "popm16",
+    [INSN_TYPE_POP_M32]            = "popm32",
+    [INSN_TYPE_POP_M64]            = "popm64",
+    [INSN_TYPE_READ_A8]            = "rda8",
+    [INSN_TYPE_READ_A16]           = "rda16",
+    [INSN_TYPE_READ_A32]           = "rda32",
+    [INSN_TYPE_READ_A64]           = "rda64",
+    [INSN_TYPE_PUSH_A8]            = "pusha8",
+    [INSN_TYPE_PUSH_A16]           = "pusha16",
+    [INSN_TYPE_PUSH_A32]           = "pusha32",
+    [INSN_TYPE_PUSH_A64]           = "pusha64",
+    [INSN_TYPE_POP_A8]             = "popa8",
+    [INSN_TYPE_POP_A16]            = "popa16",
+    [INSN_TYPE_POP_A32]            = "popa32",
+    [INSN_TYPE_POP_A64]            = "popa64",
+    [INSN_TYPE_READ_A16_LE]        = "rda16le",
+    [INSN_TYPE_READ_A32_LE]        = "rda32le",
+    [INSN_TYPE_READ_A64_LE]        = "rda64le",
+    [INSN_TYPE_READ_A16_BE]        = "rda16be",
+    [INSN_TYPE_READ_A32_BE]        = "rda32be",
+    [INSN_TYPE_READ_A64_BE]        = "rda64be",
+    [INSN_TYPE_READ_STRUCT_A]      = "rdstructa",
+    [INSN_TYPE_SEEK_FWD]           = "seekf",
+    [INSN_TYPE_SEEK_BAK]           = "seekb",
+    [INSN_TYPE_SEEK_R]             = "seekr",
+    [INSN_TYPE_TELL]               = "tell",
+    [INSN_TYPE_ADD]                = "add",
+    [INSN_TYPE_SUB]                = "sub",
+    [INSN_TYPE_MUL]                = "mul",
+    [INSN_TYPE_DIV]                = "div",
+    [INSN_TYPE_MOD]                = "mod",
+    [INSN_TYPE_POW]                = "pow",
+    [INSN_TYPE_SQRT]               = "sqrt",
+    [INSN_TYPE_ABS]                = "abs",
+    [INSN_TYPE_AND]                = "and",
+    [INSN_TYPE_OR]                 = "or",
+    [INSN_TYPE_XOR]                = "xor",
+    [INSN_TYPE_NAND]               = "nand",
+    [INSN_TYPE_NOR]                = "nor",
+    [INSN_TYPE_XNOR]               = "xnor",
+    [INSN_TYPE_NOT]                = "not",
+    [INSN_TYPE_LSHIFT]             = "lshift",
+    [INSN_TYPE_RSHIFT]             = "rshift",
+    [INSN_TYPE_ROL]                = "rol",
+    [INSN_TYPE_ROR]                = "ror",
+    [INSN_TYPE_CMPEQ]              = "cmpeq",
+    [INSN_TYPE_CMPLE]              = "cmple",
+    [INSN_TYPE_CMPLT]              = "cmplt",
+    [INSN_TYPE_CMPGE]              = "cmpge",
+    [INSN_TYPE_CMPGT]              = "cmpgt",
+    [INSN_TYPE_JA]                 = "ja",
+    [INSN_TYPE_JB]                 = "jb",
+    [INSN_TYPE_JZ]                 = "jz",
+    [INSN_TYPE_JO]                 = "jo",
+    [INSN_TYPE_JC]                 = "jc",
+    [INSN_TYPE_CALL_TYPE_LOADER]   = "call",
+    [INSN_TYPE_CALL_TYPE_LOADER_A] = "calla",
+    [INSN_TYPE_CALL_TYPE_LOADER_V] = "callv",
+    [INSN_TYPE_PINFO]              = "pinfo",
+    [INSN_TYPE_PDBG]               = "pdbg",
+    [INSN_TYPE_PERR]               = "perr",
+    [INSN_TYPE_EXIT_SUCCESS]       = "exits",
+    [INSN_TYPE_EXIT_FAILURE]       = "exitf",
+    [INSN_TYPE_READ_STRUCT]        = "rdstruct",
+    [INSN_TYPE_JCMP]               = "jcmp",
+    [INSN_TYPE_SWITCH]             = "switch",
+    [INSN_TYPE_CHECK]              = "check",
+};
+
+/* private method declarations */
+
+static inline Size             vm_profile_hash (Loader* loader, Size capacity);
+static inline VmProfileLoader* vm_profile_insert_loader (VmProfile* profile, Loader* loader);
+static inline Size             vm_profile_child (VmProfile* profile, Size parent, Loader* loader);
+static inline void             vm_profile_put_name (FILE* out, Loader* loader);
+static inline void             vm_profile_put_path (VmProfile* profile, Size node, FILE* out);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Initialize an empty profile.
+ *
+ * @param profile
+ *
+ * @return @c profile on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC VmProfile* vm_profile_init (VmProfile* profile) {
+    RETURN_VALUE_IF (!profile, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (profile, 0, sizeof (VmProfile));
+
+    /* root of call tree */
+    profile->nodes = ALLOCATE (VmProfileNode, 16);
+    RETURN_VALUE_IF (!profile->nodes, Null, ERR_OUT_OF_MEMORY);
+    profile->node_capacity = 16;
+    profile->node_count    = 1;
+
+    return profile;
+}
+
+/**
+ * @b De-initialize given profile, freeing all it's counters.
+ *
+ * @param profile
+ *
+ * @return @c profile on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC VmProfile* vm_profile_deinit (VmProfile* profile) {
+    RETURN_VALUE_IF (!profile, Null, ERR_INVALID_ARGUMENTS);
+
+    for (Size s = 0; s < profile->loader_capacity; s++) {
+        VmProfileLoader* entry = profile->loaders[s];
+        if (!entry) {
+            continue;
+        }
+        if (entry->blocks) {
+            FREE (entry->blocks);
+        }
+        FREE (entry);
+    }
+
+    if (profile->loaders) {
+        FREE (profile->loaders);
+    }
+
+    if (profile->nodes) {
+        FREE (profile->nodes);
+    }
+
+    memset (profile, 0, sizeof (VmProfile));
+
+    return profile;
+}
+
+/**
+ * @b Record entry into given type loader, below the loader being executed.
+ *
+ * @param profile
+ * @param loader Loader being entered. Must be prepared for execution.
+ *
+ * @return Counters of @c loader on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC VmProfileLoader* vm_profile_enter (VmProfile* profile, Loader* loader) {
+    RETURN_VALUE_IF (!profile || !loader, Null, ERR_INVALID_ARGUMENTS);
+
+    VmProfileLoader* entry = vm_profile_find_loader (profile, loader);
+    if (!entry) {
+        entry = vm_profile_insert_loader (profile, loader);
+        RETURN_VALUE_IF (!entry, Null, "Failed to add type loader to profile\n");
+    }
+
+    Size node = vm_profile_child (profile, profile->current, loader);
+    RETURN_VALUE_IF (!node, Null, "Failed to add call to profile\n");
+
+    profile->nodes[node].child_cycles = 0;
+    profile->current                  = node;
+    entry->exec_count++;
+
+    return entry;
+}
+
+/**
+ * @b Record exit from loader entered last, and return to it's caller.
+ *
+ * @param profile
+ * @param cycles Time spent in loader, including called loaders.
+ *
+ * @return @c profile on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC VmProfile* vm_profile_leave (VmProfile* profile, Uint64 cycles) {
+    RETURN_VALUE_IF (!profile || !profile->current, Null, ERR_INVALID_ARGUMENTS);
+
+    VmProfileNode* node    = profile->nodes + profile->current;
+    Uint64         callees = node->child_cycles < cycles ? node->child_cycles : cycles;
+
+    node->self_cycles                          += cycles - callees;
+    profile->nodes[node->parent].child_cycles += cycles;
+    profile->current                           = node->parent;
+
+    return profile;
+}
+
+/**
+ * @b Find counters of given type loader.
+ *
+ * @return Counters of @c loader if it has been executed.
+ * @return @c Null otherwise.
+ * */
+PUBLIC VmProfileLoader* vm_profile_find_loader (VmProfile* profile, Loader* loader) {
+    RETURN_VALUE_IF (!profile || !loader, Null, ERR_INVALID_ARGUMENTS);
+
+    if (!profile->loader_capacity) {
+        return Null;
+    }
+
+    Size mask = profile->loader_capacity - 1;
+    for (Size s = vm_profile_hash (loader, profile->loader_capacity); profile->loaders[s];
+         s      = (s + 1) & mask) {
+        if (profile->loaders[s]->loader == loader) {
+            return profile->loaders[s];
+        }
+    }
+
+    return Null;
+}
+
+/**
+ * @b Write call tree in folded stack format, one line per call chain with it's
+ * self time, as consumed by flamegraph.pl and compatible tools.
+ *
+ * @param profile
+ * @param out
+ *
+ * @return @c profile on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC VmProfile* vm_profile_dump_folded (VmProfile* profile, FILE* out) {
+    RETURN_VALUE_IF (!profile || !out, Null, ERR_INVALID_ARGUMENTS);
+
+    for (Size n = 1; n < profile->node_count; n++) {
+        if (!profile->nodes[n].self_cycles) {
+            continue;
+        }
+        vm_profile_put_path (profile, n, out);
+        fprintf (out, " %llu\n", (unsigned long long)profile->nodes[n].self_cycles);
+    }
+
+    return ferror (out) ? Null : profile;
+}
+
+/**
+ * @b Write human readable summary of instruction counts, and counters of each
+ * type loader and it's blocks.
+ *
+ * @param profile
+ * @param out
+ *
+ * @return @c profile on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC VmProfile* vm_profile_dump_summary (VmProfile* profile, FILE* out) {
+    RETURN_VALUE_IF (!profile || !out, Null, ERR_INVALID_ARGUMENTS);
+
+    fprintf (out, "instructions :\n");
+    for (Size t = 0; t < INSN_TYPE_MAX; t++) {
+        if (profile->insn_counts[t]) {
+            fprintf (
+                out,
+                "    %-12s %llu\n",
+                insn_type_names[t] ? insn_type_names[t] : "?",
+                (unsigned long long)profile->insn_counts[t]
+            );
+        }
+    }
+
+    fprintf (out, "type loaders :\n");
+    for (Size s = 0; s < profile->loader_capacity; s++) {
+        VmProfileLoader* entry = profile->loaders[s];
+        if (!entry) {
+            continue;
+        }
+
+        fprintf (out, "    ");
+        vm_profile_put_name (out, entry->loader);
+        fprintf (
+            out,
+            " : execs = %llu, cycles = %llu, bytes read = %llu\n",
+            (unsigned long long)entry->exec_count,
+            (unsigned long long)entry->cycles,
+            (unsigned long long)entry->bytes_read
+        );
+
+        for (Size b = 0; b < entry->block_count; b++) {
+            fprintf (
+                out,
+                "        block %zu : execs = %llu, cycles = %llu\n",
+                b,
+                (unsigned long long)entry->blocks[b].exec_count,
+                (unsigned long long)entry->blocks[b].cycles
+            );
+        }
+    }
+
+    return ferror (out) ? Null : profile;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Slot of given loader in a table of given capacity (a power of two).
+ * */
+static inline Size vm_profile_hash (Loader* loader, Size capacity) {
+    Uint64 h = (Uint64)(Size)loader;
+    h        = (h ^ (h >> 33)) * 0xff51afd7ed558ccdull;
+    return (Size)(h ^ (h >> 33)) & (capacity - 1);
+}
+
+/**
+ * @b Add counters for a loader not in table yet, growing table to keep it atmost half full.
+ * */
+static inline VmProfileLoader* vm_profile_insert_loader (VmProfile* profile, Loader* loader) {
+    if ((profile->loader_count + 1) * 2 > profile->loader_capacity) {
+        Size              capacity = profile->loader_capacity ? profile->loader_capacity * 2 : 16;
+        VmProfileLoader** loaders  = ALLOCATE (VmProfileLoader*, capacity);
+        RETURN_VALUE_IF (!loaders, Null, ERR_OUT_OF_MEMORY);
+
+        /* entries are separately allocated, so pointers held by executing loaders stay valid */
+        for (Size s = 0; s < profile->loader_capacity; s++) {
+            VmProfileLoader* entry = profile->loaders[s];
+            if (!entry) {
+                continue;
+            }
+            Size slot = vm_profile_hash (entry->loader, capacity);
+            while (loaders[slot]) {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            loaders[slot] = entry;
+        }
+
+        if (profile->loaders) {
+            FREE (profile->loaders);
+        }
+        profile->loaders         = loaders;
+        profile->loader_capacity = capacity;
+    }
+
+    VmProfileLoader* entry = ALLOCATE (VmProfileLoader, 1);
+    RETURN_VALUE_IF (!entry, Null, ERR_OUT_OF_MEMORY);
+
+    entry->loader      = loader;
+    entry->block_count = loader->packed_code.block_count;
+    if (entry->block_count) {
+        entry->blocks = ALLOCATE (VmProfileBlock, entry->block_count);
+        if (!entry->blocks) {
+            FREE (entry);
+            RETURN_VALUE_IF_REACHED (Null, ERR_OUT_OF_MEMORY);
+        }
+    }
+
+    Size slot = vm_profile_hash (loader, profile->loader_capacity);
+    while (profile->loaders[slot]) {
+        slot = (slot + 1) & (profile->loader_capacity - 1);
+    }
+    profile->loaders[slot] = entry;
+    profile->loader_count++;
+
+    return entry;
+}
+
+/**
+ * @b Find or create node for given loader called from given parent node.
+ *
+ * @return Index of node on success.
+ * @return @c 0 otherwise.
+ * */
+static inline Size vm_profile_child (VmProfile* profile, Size parent, Loader* loader) {
+    for (Size c = profile->nodes[parent].first_child; c; c = profile->nodes[c].next_sibling) {
+        if (profile->nodes[c].loader == loader) {
+            return c;
+        }
+    }
+
+    if (profile->node_count >= profile->node_capacity) {
+        Size           capacity = profile->node_capacity * 2;
+        VmProfileNode* nodes    = REALLOCATE (profile->nodes, VmProfileNode, capacity);
+        RETURN_VALUE_IF (!nodes, 0, ERR_OUT_OF_MEMORY);
+        profile->nodes         = nodes;
+        profile->node_capacity = capacity;
+    }
+
+    Size node            = profile->node_count++;
+    profile->nodes[node] = (VmProfileNode) {
+        .loader       = loader,
+        .parent       = parent,
+        .next_sibling = profile->nodes[parent].first_child,
+    };
+    profile->nodes[parent].first_child = node;
+
+    return node;
+}
+
+/**
+ * @b Write name of loader as a frame name. Semicolons separate frames in
+ * folded format, and trailing space separates the count, so both are replaced.
+ * */
+static inline void vm_profile_put_name (FILE* out, Loader* loader) {
+    CString name = loader->type_name && *loader->type_name ? loader->type_name : "<unnamed>";
+    for (CString c = name; *c; c++) {
+        fputc (*c == ';' || *c == ' ' ? '_' : *c, out);
+    }
+}
+
+/**
+ * @b Write chain of loaders from root to given node, separated by semicolons.
+ * */
+static inline void vm_profile_put_path (VmProfile* profile, Size node, FILE* out) {
+    Size parent = profile->nodes[node].parent;
+    if (parent) {
+        vm_profile_put_path (profile, parent, out);
+        fputc (';', out);
+    }
+    vm_profile_put_name (out, profile->nodes[node].loader);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file Profile.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_VM_PROFILE_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_VM_PROFILE_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* libc */
+#include <stdio.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#endif
+
+/* local includes */
+#include "Insn.h"
+#include "Loader.h"
+
+/* profiling is opt-in, and compiles out of the interpreter completely otherwise */
+#ifdef VM_ENABLE_PROFILE
+#    define VM_PROFILE_ENABLED 1
+#else
+#    define VM_PROFILE_ENABLED 0
+#endif
+
+/**
+ * @b Execution count and time of one @c InsnBlock. Time of a block includes
+ * time of type loaders called from it.
+ * */
+typedef struct VmProfileBlock {
+    Uint64 exec_count;
+    Uint64 cycles;
+} VmProfileBlock;
+
+/**
+ * @b Counters of one type loader, over all it's executions.
+ * */
+typedef struct VmProfileLoader {
+    Loader*         loader;
+    Uint64          exec_count;
+    Uint64          cycles;      /**< @b Time including called type loaders. */
+    Uint64          bytes_read;  /**< @b Bytes read by loader itself, seeks not included. */
+    VmProfileBlock* blocks;
+    Size            block_count;
+} VmProfileLoader;
+
+/**
+ * @b A node of call tree, one for each distinct chain of type loader calls.
+ * */
+typedef struct VmProfileNode {
+    Loader* loader;       /**< @b Null for root. */
+    Size    parent;
+    Size    first_child;  /**< @b Zero if there is none, root is never a child. */
+    Size    next_sibling; /**< @b Zero if there is none. */
+    Uint64  self_cycles;  /**< @b Time spent in this call chain, excluding callees. */
+    Uint64  child_cycles; /**< @b Time of callees during current execution. */
+} VmProfileNode;
+
+/**
+ * @b Profile collected by a VM while executing type loaders.
+ *
+ * Counters of type loaders are kept in an open addressed table, keyed by loader,
+ * so that they can be found in constant time on every loader entry.
+ * */
+typedef struct VmProfile {
+    Uint64 insn_counts[INSN_TYPE_MAX];
+
+    VmProfileLoader** loaders;       /**< @b Hash table of loader counters. */
+    Size              loader_count;
+    Size              loader_capacity;
+
+    VmProfileNode* nodes;            /**< @b Call tree, first node is root. */
+    Size           node_count;
+    Size           node_capacity;
+    Size           current;          /**< @b Node of loader being executed. */
+} VmProfile;
+
+PUBLIC VmProfile*       vm_profile_init (VmProfile* profile);
+PUBLIC VmProfile*       vm_profile_deinit (VmProfile* profile);
+PUBLIC VmProfileLoader* vm_profile_enter (VmProfile* profile, Loader* loader);
+PUBLIC VmProfile*       vm_profile_leave (VmProfile* profile, Uint64 cycles);
+PUBLIC VmProfileLoader* vm_profile_find_loader (VmProfile* profile, Loader* loader);
+PUBLIC VmProfile*       vm_profile_dump_folded (VmProfile* profile, FILE* out);
+PUBLIC VmProfile*       vm_profile_dump_summary (VmProfile* profile, FILE* out);
+
+/**
+ * @b Timestamp used for profiling. TSC cycles on x86, nanoseconds elsewhere.
+ * */
+PRIVATE Uint64 vm_profile_now (void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (Uint64)ts.tv_sec * 1000000000ull + (Uint64)ts.tv_nsec;
+#endif
+}
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_VM_PROFILE_H
@@ -37,27 +37,31 @@
 #include "Stack.h"
 
 /**
- * @b Initialize type loader stack for a type loader to being execution.
+ * @b Initialize VM stack with atleast given capacity.
+ *
+ * If stack is not de-initialized and memory is already allocated then it's
+ * reused as is. Stack contents are never read before being written, so
+ * memory is not cleared.
  *
  * @param[out] stack @c XftVmStack object to be initialized.
+ * @param[in] capacity Number of bytes to preallocate.
  *
  * @return @c stack on success.
  * @return @c Null otherwise.
  * */
-PUBLIC XftVmStack* xft_vm_stack_init (XftVmStack* stack) {
-    RETURN_VALUE_IF (!stack, Null, ERR_INVALID_ARGUMENTS);
-
-    /* if stack is not de-initialized and memory is already allocated then
-     * we'll reuse it by resetting complete memory region */
+PUBLIC XftVmStack* xft_vm_stack_init (XftVmStack* stack, Size capacity) {
+    RETURN_VALUE_IF (!stack || !capacity, Null, ERR_INVALID_ARGUMENTS);
 
-    if (stack->stack_data && stack->stack_capacity) {
-        memset (stack->stack_data, 0, stack->stack_capacity);
-    } else {
-        stack->stack_data = ALLOCATE (Uint8, 64);
-        RETURN_VALUE_IF (!stack->stack_data, Null, ERR_OUT_OF_MEMORY);
-        stack->stack_capacity = 64;
+    if (!stack->stack_data) {
+        stack->stack_capacity = 0;
     }
 
+    RETURN_VALUE_IF (
+        !xft_vm_stack_resize_up (stack, capacity),
+        Null,
+        "Failed to allocate VM stack\n"
+    );
+
     stack->stack_size = 0;
 
     return stack;
@@ -75,7 +79,6 @@ PUBLIC XftVmStack* xft_vm_stack_deinit (XftVmStack* stack) {
     RETURN_VALUE_IF (!stack, Null, ERR_INVALID_ARGUMENTS);
 
     if (stack->stack_data) {
-        memset (stack->stack_data, 0, stack->stack_capacity);
         FREE (stack->stack_data);
     }
 
@@ -113,11 +116,36 @@ PUBLIC XftVmStack* xft_vm_stack_resize_up (XftVmStack* stack, Size new_size) {
     return stack;
 }
 
-#define TLSTACK_CHECK_AND_RESIZE(stack)                                                            \
-    if (stack->stack_size + 8 >= stack->stack_capacity) {                                          \
-        xft_vm_stack_resize_up (stack, stack->stack_size ? stack->stack_size * 2 : 32);            \
+/**
+ * @b Make sure atleast @c nbytes can be pushed without resizing. Capacity is
+ * grown geometrically, so that repeated reservations stay amortized constant.
+ *
+ * @param[in] stack
+ * @param[in] nbytes Number of bytes that will be pushed.
+ *
+ * @return @c stack on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC XftVmStack* xft_vm_stack_reserve (XftVmStack* stack, Size nbytes) {
+    RETURN_VALUE_IF (!stack, Null, ERR_INVALID_ARGUMENTS);
+
+    if (nbytes <= stack->stack_capacity - stack->stack_size) {
+        return stack;
     }
 
+    Size needed;
+    RETURN_VALUE_IF (
+        __builtin_add_overflow (stack->stack_size, nbytes, &needed),
+        Null,
+        "XFT VM stack size overflow\n"
+    );
+
+    return xft_vm_stack_resize_up (stack, MAX (needed, stack->stack_capacity * 2));
+}
+
+#define TLSTACK_CHECK_AND_RESIZE(stack)                                                            \
+    RETURN_VALUE_IF (!xft_vm_stack_reserve (stack, 8), Null, "Failed to resize VM stack\n");
+
 #define TLSTACK_PUSH_HELPER(n, stack, val)                                                         \
     RETURN_VALUE_IF (!stack, Null, ERR_INVALID_ARGUMENTS);                                         \
                                                                                                    \
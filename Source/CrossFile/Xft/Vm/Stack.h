@@ -38,7 +38,10 @@
 
 /**
  * @b XftVmStack is allocated and maintained by the VM.
- * Each method/function get's a separate stack.
+ *
+ * A single contiguous stack is shared by all type loaders of a VM. Each
+ * executing loader owns a frame, starting at the stack size on it's entry
+ * (frame pointer) and discarded when it returns.
  * */
 typedef struct XftVmStack {
     Uint8* stack_data;
@@ -46,9 +49,13 @@ typedef struct XftVmStack {
     Size   stack_capacity;
 } XftVmStack;
 
-PUBLIC XftVmStack* xft_vm_stack_init (XftVmStack* stack);
+/* capacity of stack preallocated by VM, enough for most nested type loads */
+#define XFT_VM_STACK_INITIAL_CAPACITY (64 * 1024)
+
+PUBLIC XftVmStack* xft_vm_stack_init (XftVmStack* stack, Size capacity);
 PUBLIC XftVmStack* xft_vm_stack_deinit (XftVmStack* stack);
-PUBLIC XftVmStack* xft_vm_stack_check_up (XftVmStack* stack, Size new_size);
+PUBLIC XftVmStack* xft_vm_stack_resize_up (XftVmStack* stack, Size new_size);
+PUBLIC XftVmStack* xft_vm_stack_reserve (XftVmStack* stack, Size nbytes);
 PUBLIC XftVmStack* xft_vm_stack_push_t8 (XftVmStack* stack, Uint8 val);
 PUBLIC XftVmStack* xft_vm_stack_push_t16 (XftVmStack* stack, Uint16 val);
 PUBLIC XftVmStack* xft_vm_stack_push_t32 (XftVmStack* stack, Uint32 val);
@@ -0,0 +1,278 @@
+/**
+ * @file Switch.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <memory.h>
+#include <stdlib.h>
+
+/* local includes */
+#include "Loader.h"
+#include "Switch.h"
+
+/* private method declarations */
+
+static inline int  switch_case_compare (const void* a, const void* b);
+static inline Bool switch_table_reserve (SwitchTable* table, Size* capacity, Size count);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Build a switch table from given cases. Cases may overlap and come in any
+ * order, a value matched by more than one case jumps to block of the first one.
+ * Empty ranges (first > last) are ignored.
+ *
+ * @param[out] table
+ * @param cases Cases in order of priority.
+ * @param count Number of cases.
+ *
+ * @return @c table on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC SwitchTable* switch_table_init (SwitchTable* table, const SwitchCase* cases, Size count) {
+    RETURN_VALUE_IF (!table || (!cases && count), Null, ERR_INVALID_ARGUMENTS);
+
+    memset (table, 0, sizeof (SwitchTable));
+    Size capacity = 0;
+
+    /* cases so far are sorted, only parts of a case not covered by them are added */
+    for (Size c = 0; c < count; c++) {
+        Uint64 cur    = cases[c].first;
+        Uint64 last   = cases[c].last;
+        Size   sorted = table->case_count;
+        Bool   done   = cur > last;
+
+        GOTO_HANDLER_IF (
+            !switch_table_reserve (table, &capacity, sorted + sorted + 1),
+            INIT_FAILED,
+            ERR_OUT_OF_MEMORY
+        );
+
+        for (Size s = 0; !done && s < sorted && table->cases[s].first <= last; s++) {
+            SwitchCase* covered = table->cases + s;
+            if (covered->last < cur) {
+                continue;
+            }
+
+            if (covered->first > cur) {
+                table->cases[table->case_count++] =
+                    (SwitchCase) {cur, covered->first - 1, cases[c].block_sel};
+            }
+
+            done = covered->last >= last;
+            cur  = covered->last + 1;
+        }
+
+        if (!done) {
+            table->cases[table->case_count++] = (SwitchCase) {cur, last, cases[c].block_sel};
+        }
+
+        qsort (table->cases, table->case_count, sizeof (SwitchCase), switch_case_compare);
+    }
+
+    /* adjacent ranges jumping to same block become one */
+    Size merged = 0;
+    for (Size c = 0; c < table->case_count; c++) {
+        SwitchCase* prev = merged ? table->cases + merged - 1 : Null;
+        if (prev && prev->block_sel == table->cases[c].block_sel &&
+            prev->last + 1 == table->cases[c].first) {
+            prev->last = table->cases[c].last;
+        } else {
+            table->cases[merged++] = table->cases[c];
+        }
+    }
+    table->case_count = merged;
+
+    if (!merged) {
+        return table;
+    }
+
+    /* direct indexing is used when atleast half of values in between have a case */
+    Uint64 span    = table->cases[merged - 1].last - table->cases[0].first;
+    Uint64 covered = 0;
+    for (Size c = 0; c < merged && span < SWITCH_DENSE_MAX; c++) {
+        covered += table->cases[c].last - table->cases[c].first + 1;
+    }
+
+    if (span < SWITCH_DENSE_MAX && 2 * covered >= span + 1) {
+        table->dense_count = span + 1;
+        table->dense       = ALLOCATE (Size, table->dense_count);
+        GOTO_HANDLER_IF (!table->dense, INIT_FAILED, ERR_OUT_OF_MEMORY);
+
+        for (Size v = 0; v < table->dense_count; v++) {
+            table->dense[v] = SWITCH_NO_BLOCK;
+        }
+
+        for (Size c = 0; c < merged; c++) {
+            Size* dense = table->dense + (table->cases[c].first - table->cases[0].first);
+            for (Uint64 v = 0; v <= table->cases[c].last - table->cases[c].first; v++) {
+                dense[v] = table->cases[c].block_sel;
+            }
+        }
+    }
+
+    return table;
+
+INIT_FAILED:
+    switch_table_deinit (table);
+    return Null;
+}
+
+/**
+ * @b De-initialize given switch table.
+ *
+ * @param[out] table
+ *
+ * @return @c table on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC SwitchTable* switch_table_deinit (SwitchTable* table) {
+    RETURN_VALUE_IF (!table, Null, ERR_INVALID_ARGUMENTS);
+
+    if (table->cases) {
+        FREE (table->cases);
+    }
+
+    if (table->dense) {
+        FREE (table->dense);
+    }
+
+    memset (table, 0, sizeof (SwitchTable));
+
+    return table;
+}
+
+/**
+ * @b Check whether cases of given table are sorted, don't overlap and jump to
+ * existing blocks, and that dense table agrees with them.
+ *
+ * @param table
+ * @param block_count Number of blocks of loader table belongs to.
+ *
+ * @return @c True if table is valid.
+ * @return @c False otherwise.
+ * */
+PUBLIC Bool switch_table_is_valid (const SwitchTable* table, Size block_count) {
+    RETURN_VALUE_IF (!table, False, ERR_INVALID_ARGUMENTS);
+
+    if (!table->cases && table->case_count) {
+        return False;
+    }
+
+    for (Size c = 0; c < table->case_count; c++) {
+        const SwitchCase* scase = table->cases + c;
+        if (scase->first > scase->last || scase->block_sel >= block_count ||
+            (c && scase->first <= table->cases[c - 1].last)) {
+            return False;
+        }
+    }
+
+    if (!table->dense) {
+        return True;
+    }
+
+    /* every value of dense table must jump where binary search would */
+    if (!table->case_count ||
+        table->dense_count - 1 != table->cases[table->case_count - 1].last - table->cases[0].first) {
+        return False;
+    }
+
+    SwitchTable sparse = {.cases = table->cases, .case_count = table->case_count};
+    for (Size v = 0; v < table->dense_count; v++) {
+        if (table->dense[v] != switch_table_find (&sparse, table->cases[0].first + v)) {
+            return False;
+        }
+    }
+
+    return True;
+}
+
+/**
+ * @b Add given table to loader's switch table, taking ownership of it's cases
+ * and dense table.
+ *
+ * @param loader
+ * @param table Table to add, arrays must be allocated using @c ALLOCATE.
+ * @param[out] id Index of table in loader's switch tables.
+ *
+ * @return @c loader on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader* loader_add_switch_table (Loader* loader, SwitchTable* table, Size* id) {
+    RETURN_VALUE_IF (!loader || !table || !id, Null, ERR_INVALID_ARGUMENTS);
+
+    if (loader->switch_table_count >= loader->switch_table_capacity) {
+        Size new_capacity = loader->switch_table_capacity ? loader->switch_table_capacity * 2 : 4;
+        SwitchTable* tables = REALLOCATE (loader->switch_tables, SwitchTable, new_capacity);
+        RETURN_VALUE_IF (!tables, Null, ERR_OUT_OF_MEMORY);
+
+        loader->switch_tables         = tables;
+        loader->switch_table_capacity = new_capacity;
+    }
+
+    *id                        = loader->switch_table_count;
+    loader->switch_tables[*id] = *table;
+    loader->switch_table_count++;
+
+    return loader;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+static inline int switch_case_compare (const void* a, const void* b) {
+    Uint64 first_a = ((const SwitchCase*)a)->first;
+    Uint64 first_b = ((const SwitchCase*)b)->first;
+    return (first_a > first_b) - (first_a < first_b);
+}
+
+/**
+ * @b Make sure cases of table being built can hold atleast @c count cases.
+ * */
+static inline Bool switch_table_reserve (SwitchTable* table, Size* capacity, Size count) {
+    if (count <= *capacity) {
+        return True;
+    }
+
+    Size        new_capacity = MAX (*capacity * 2, count);
+    SwitchCase* cases        = REALLOCATE (table->cases, SwitchCase, new_capacity);
+    RETURN_VALUE_IF (!cases, False, ERR_OUT_OF_MEMORY);
+
+    table->cases = cases;
+    *capacity    = new_capacity;
+    return True;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file Switch.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_VM_SWITCH_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_VM_SWITCH_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* block selector of values no case of a switch table matches */
+#define SWITCH_NO_BLOCK ((Size)-1)
+
+/* switch tables spanning atmost this many values are looked up by direct indexing */
+#ifndef SWITCH_DENSE_MAX
+#    define SWITCH_DENSE_MAX 256
+#endif
+
+/**
+ * @b A range of values [first, last] of operand of @c INSN_TYPE_SWITCH, and block
+ * it jumps to for these values.
+ * */
+typedef struct SwitchCase {
+    Uint64 first;
+    Uint64 last;
+    Size   block_sel; /**< @b Index of block to jump to. */
+} SwitchCase;
+
+/**
+ * @b Jump table of an @c INSN_TYPE_SWITCH. Cases are sorted and don't overlap, and
+ * are binary searched. When values between first and last case are mostly covered,
+ * block of every value is also stored in @c dense, and looked up directly.
+ * */
+typedef struct SwitchTable {
+    SwitchCase* cases;
+    Size        case_count;
+    Size*       dense;       /**< @b Block of each value from first case, @c Null if sparse. */
+    Size        dense_count; /**< @b Number of values in dense table. */
+} SwitchTable;
+
+PUBLIC SwitchTable* switch_table_init (SwitchTable* table, const SwitchCase* cases, Size count);
+PUBLIC SwitchTable* switch_table_deinit (SwitchTable* table);
+PUBLIC Bool         switch_table_is_valid (const SwitchTable* table, Size block_count);
+PUBLIC struct XftLoader*
+    loader_add_switch_table (struct XftLoader* loader, SwitchTable* table, Size* id);
+
+/**
+ * @b Find block a switch table jumps to for given value.
+ *
+ * @return Block selector if a case matches.
+ * @return @c SWITCH_NO_BLOCK otherwise.
+ * */
+PRIVATE Size switch_table_find (const SwitchTable* table, Uint64 value) {
+    if (table->dense) {
+        Uint64 index = value - table->cases[0].first;
+        return value >= table->cases[0].first && index < table->dense_count ?
+                   table->dense[index] :
+                   SWITCH_NO_BLOCK;
+    }
+
+    Size lo = 0;
+    Size hi = table->case_count;
+    while (lo < hi) {
+        Size              mid   = lo + (hi - lo) / 2;
+        const SwitchCase* scase = table->cases + mid;
+        if (value < scase->first) {
+            hi = mid;
+        } else if (value > scase->last) {
+            lo = mid + 1;
+        } else {
+            return scase->block_sel;
+        }
+    }
+
+    return SWITCH_NO_BLOCK;
+}
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_VM_SWITCH_H
@@ -0,0 +1,658 @@
+/**
+ * @file Verify.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+
+/* local includes */
+#include "Insn.h"
+#include "Loader.h"
+#include "Packed.h"
+#include "Verify.h"
+#include "Vm.h"
+
+/* entry stack height of blocks not reached yet */
+#define STACK_HEIGHT_UNKNOWN ((Size)-1)
+
+/* private method declarations */
+
+static inline Size    insn_elem_size (InsnType insn_type);
+static inline Size    insn_ordered_elem_size (InsnType insn_type);
+static inline Bool    verify_mem_range (Loader* loader, Uint64 mem_off, Size count, Size esize);
+static inline Bool    verify_insn (Loader* loader, Insn* insn);
+static inline Bool    verify_stack_effect (Insn* insn, Size* height);
+static inline Loader* verify_blocks (Loader* loader);
+static inline Loader* verify_stack (Loader* loader);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Statically verify packed code of given loader.
+ *
+ * Verification makes sure that :
+ * - every block decodes to valid instructions that end exactly at block end,
+ * - all register operands are less than @c VM_REG_COUNT,
+ * - all jump targets, loader references, layouts, switch tables and messages exist,
+ * - all memory accesses with constant offsets lie inside loaded object,
+ * - stack height at start of each block is same along all paths reaching it,
+ *   and stack never underflows. Maximum stack height is stored in loader.
+ *
+ * Result is stored in @c loader->verify_status. Verified loaders are executed
+ * by VM without per instruction checks, on a stack preallocated to
+ * @c loader->max_stack_size. Only stream bounds, memory offset of calls
+ * (computed at runtime) and division by zero are still checked.
+ *
+ * @param loader Loader with packed code.
+ *
+ * @return @c loader if loader is verified.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader* loader_verify (Loader* loader) {
+    RETURN_VALUE_IF (!loader || !loader->packed_code.code, Null, ERR_INVALID_ARGUMENTS);
+
+    loader->verify_status  = LOADER_VERIFY_FAILED;
+    loader->max_stack_size = 0;
+
+    for (Size l = 0; l < loader->struct_layout_count; l++) {
+        RETURN_VALUE_IF (
+            !struct_layout_is_valid (loader->struct_layouts + l),
+            Null,
+            "Struct layout %zu is invalid\n",
+            l
+        );
+    }
+
+    for (Size t = 0; t < loader->switch_table_count; t++) {
+        RETURN_VALUE_IF (
+            !switch_table_is_valid (loader->switch_tables + t, loader->packed_code.block_count),
+            Null,
+            "Switch table %zu is invalid\n",
+            t
+        );
+    }
+
+    RETURN_VALUE_IF (!verify_blocks (loader), Null, "Type loader has invalid instructions\n");
+    RETURN_VALUE_IF (!verify_stack (loader), Null, "Type loader has unbalanced stack\n");
+
+    loader->verify_status = LOADER_VERIFY_PASSED;
+    return loader;
+}
+
+/**
+ * @b Find whether every execution of given verified loader reads same number of bytes
+ * and has no side effects besides writing it's own object.
+ *
+ * Such loaders execute straight line code without jumps, prints or failure exits,
+ * never seek before the byte they started from, and only call other fixed loaders.
+ * Elements of an array of such a type can be loaded on separate threads, each from
+ * a stream offset known in advance. Callees must already have been analyzed.
+ *
+ * Result is stored in @c loader->fixed_status, and number of bytes read in
+ * @c loader->fixed_stream_size.
+ *
+ * @param loader Verified loader.
+ *
+ * @return @c loader if loader is fixed.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader* loader_analyze_fixed (Loader* loader) {
+    RETURN_VALUE_IF (!loader, Null, ERR_INVALID_ARGUMENTS);
+
+    loader->fixed_status      = LOADER_FIXED_NO;
+    loader->fixed_stream_size = 0;
+
+    if (loader->verify_status != LOADER_VERIFY_PASSED) {
+        return Null;
+    }
+
+    PackedCode*  packed = &loader->packed_code;
+    const Uint8* ip     = packed->code;
+    Size         nbytes = 0;
+
+    /* verified code always ends with terminator, so this loop always ends */
+    for (;;) {
+        Insn insn;
+        Size n = 0;
+        ip     = packed_insn_decode (packed, ip, &insn);
+
+        switch (insn.insn_type) {
+            case INSN_TYPE_READ_R8 ... INSN_TYPE_READ_R64 :
+            case INSN_TYPE_READ_M8 ... INSN_TYPE_READ_M64 :
+                n = insn_elem_size (insn.insn_type);
+                break;
+
+            case INSN_TYPE_READ_A8 ... INSN_TYPE_READ_A64 :
+                if (__builtin_mul_overflow (
+                        insn.insn.read_arr.elem_count,
+                        insn_elem_size (insn.insn_type),
+                        &n
+                    )) {
+                    return Null;
+                }
+                break;
+
+            case INSN_TYPE_READ_A16_LE ... INSN_TYPE_READ_A64_BE :
+                if (__builtin_mul_overflow (
+                        insn.insn.read_arr.elem_count,
+                        insn_ordered_elem_size (insn.insn_type),
+                        &n
+                    )) {
+                    return Null;
+                }
+                break;
+
+            case INSN_TYPE_READ_STRUCT :
+                n = loader->struct_layouts[insn.insn.read_struct.layout_id].stream_size;
+                break;
+
+            case INSN_TYPE_READ_STRUCT_A :
+                if (__builtin_mul_overflow (
+                        insn.insn.read_struct_arr.elem_count,
+                        loader->struct_layouts[insn.insn.read_struct_arr.layout_id].stream_size,
+                        &n
+                    )) {
+                    return Null;
+                }
+                break;
+
+            case INSN_TYPE_SEEK_FWD :
+                n = insn.insn.seek.num_bytes;
+                break;
+
+            case INSN_TYPE_SEEK_BAK :
+                if (insn.insn.seek.num_bytes > nbytes) {
+                    return Null;
+                }
+                nbytes -= insn.insn.seek.num_bytes;
+                break;
+
+            /* checking callee's assertions has effects on VM besides loading the object */
+            case INSN_TYPE_CALL_TYPE_LOADER : {
+                Loader* callee = loader->loader_refs[insn.insn.call_type_loader.type_load_sel];
+                if (callee->fixed_status != LOADER_FIXED_YES || callee->check.term_count) {
+                    return Null;
+                }
+                n = callee->fixed_stream_size;
+                break;
+            }
+
+            case INSN_TYPE_EXIT_SUCCESS :
+                loader->fixed_status      = LOADER_FIXED_YES;
+                loader->fixed_stream_size = nbytes;
+                return loader;
+
+            /* number of elements or stream offset is only known at runtime */
+            case INSN_TYPE_SEEK_R :
+            case INSN_TYPE_CALL_TYPE_LOADER_A :
+            case INSN_TYPE_CALL_TYPE_LOADER_V :
+            case INSN_TYPE_JA ... INSN_TYPE_JC :
+            case INSN_TYPE_JCMP :
+            case INSN_TYPE_SWITCH :
+            case INSN_TYPE_CHECK :
+            case INSN_TYPE_PINFO ... INSN_TYPE_PERR :
+            case INSN_TYPE_EXIT_FAILURE :
+                return Null;
+
+            default :
+                break;
+        }
+
+        if (__builtin_add_overflow (nbytes, n, &nbytes)) {
+            return Null;
+        }
+    }
+}
+
+/**
+ * @b Check whether all fields of given layout lie inside it's memory and stream
+ * ranges, so that READ_STRUCT only needs to check the whole range.
+ *
+ * @param layout
+ *
+ * @return @c True if layout is valid.
+ * @return @c False otherwise.
+ * */
+PUBLIC Bool struct_layout_is_valid (const StructLayout* layout) {
+    RETURN_VALUE_IF (!layout, False, ERR_INVALID_ARGUMENTS);
+
+    if ((layout->field_count && !layout->fields) ||
+        (layout->is_dense && layout->stream_size > layout->mem_size)) {
+        return False;
+    }
+
+    for (Size f = 0; f < layout->field_count; f++) {
+        const StructLayoutField* field = layout->fields + f;
+
+        Size nbytes;
+        if ((field->size != 1 && field->size != 2 && field->size != 4 && field->size != 8) ||
+            __builtin_mul_overflow (field->size, field->count, &nbytes) ||
+            field->mem_off > layout->mem_size || nbytes > layout->mem_size - field->mem_off ||
+            field->stream_off > layout->stream_size ||
+            nbytes > layout->stream_size - field->stream_off) {
+            return False;
+        }
+    }
+
+    return True;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Element size of register, memory and array read/push/pop instructions.
+ *
+ * These are laid out in groups of four (8, 16, 32 and 64 bit variants), from
+ * @c INSN_TYPE_READ_R8 to @c INSN_TYPE_POP_A64.
+ * */
+static inline Size insn_elem_size (InsnType insn_type) {
+    return (Size)1 << ((insn_type - INSN_TYPE_READ_R8) & 3);
+}
+
+/**
+ * @b Element size of byte order specific array reads, laid out in two groups of
+ * three (16, 32 and 64 bit variants), from @c INSN_TYPE_READ_A16_LE to
+ * @c INSN_TYPE_READ_A64_BE.
+ * */
+static inline Size insn_ordered_elem_size (InsnType insn_type) {
+    return (Size)2 << ((insn_type - INSN_TYPE_READ_A16_LE) % 3);
+}
+
+static inline Bool verify_mem_range (Loader* loader, Uint64 mem_off, Size count, Size esize) {
+    Size nbytes;
+    if (__builtin_mul_overflow (count, esize, &nbytes)) {
+        return False;
+    }
+
+    return mem_off <= loader->alloc_size && nbytes <= loader->alloc_size - mem_off;
+}
+
+/**
+ * @b Validate operands of a single decoded instruction.
+ * */
+static inline Bool verify_insn (Loader* loader, Insn* insn) {
+    Size block_count = loader->packed_code.block_count;
+
+    switch (insn->insn_type) {
+        case INSN_TYPE_SET_REG :
+            return insn->insn.set_reg.reg < VM_REG_COUNT;
+
+        case INSN_TYPE_READ_R8 ... INSN_TYPE_READ_R64 :
+        case INSN_TYPE_PUSH_R8 ... INSN_TYPE_PUSH_R64 :
+        case INSN_TYPE_POP_R8 ... INSN_TYPE_POP_R64 :
+        case INSN_TYPE_SEEK_R :
+        case INSN_TYPE_TELL :
+            return insn->insn.read_reg.reg < VM_REG_COUNT;
+
+        case INSN_TYPE_READ_M8 ... INSN_TYPE_READ_M64 :
+        case INSN_TYPE_PUSH_M8 ... INSN_TYPE_PUSH_M64 :
+        case INSN_TYPE_POP_M8 ... INSN_TYPE_POP_M64 :
+            return verify_mem_range (
+                loader,
+                insn->insn.read_mem.mem_off,
+                1,
+                insn_elem_size (insn->insn_type)
+            );
+
+        case INSN_TYPE_READ_A8 ... INSN_TYPE_POP_A64 :
+            return verify_mem_range (
+                loader,
+                insn->insn.read_arr.mem_off,
+                insn->insn.read_arr.elem_count,
+                insn_elem_size (insn->insn_type)
+            );
+
+        case INSN_TYPE_READ_A16_LE ... INSN_TYPE_READ_A64_BE :
+            return verify_mem_range (
+                loader,
+                insn->insn.read_arr.mem_off,
+                insn->insn.read_arr.elem_count,
+                insn_ordered_elem_size (insn->insn_type)
+            );
+
+        case INSN_TYPE_READ_STRUCT_A : {
+            Size id     = insn->insn.read_struct_arr.layout_id;
+            Size count  = insn->insn.read_struct_arr.elem_count;
+            Size stride = insn->insn.read_struct_arr.mem_stride;
+            if (id >= loader->struct_layout_count) {
+                return False;
+            }
+
+            /* last record starts at (count - 1) * stride and stream size must not overflow */
+            StructLayout* layout = loader->struct_layouts + id;
+            Size          last_off, stream_size;
+            return !count || (!__builtin_mul_overflow (count - 1, stride, &last_off) &&
+                              !__builtin_mul_overflow (count, layout->stream_size, &stream_size) &&
+                              verify_mem_range (
+                                  loader,
+                                  insn->insn.read_struct_arr.mem_off,
+                                  1,
+                                  layout->mem_size
+                              ) &&
+                              verify_mem_range (
+                                  loader,
+                                  insn->insn.read_struct_arr.mem_off + layout->mem_size,
+                                  1,
+                                  last_off
+                              ));
+        }
+
+        case INSN_TYPE_SEEK_FWD :
+        case INSN_TYPE_SEEK_BAK :
+        case INSN_TYPE_PINFO ... INSN_TYPE_PERR :
+        case INSN_TYPE_EXIT_SUCCESS :
+        case INSN_TYPE_EXIT_FAILURE :
+            return True;
+
+        case INSN_TYPE_SQRT :
+        case INSN_TYPE_ABS :
+        case INSN_TYPE_NOT :
+            return insn->insn.unop.rres < VM_REG_COUNT && insn->insn.unop.r1 < VM_REG_COUNT;
+
+        case INSN_TYPE_ADD ... INSN_TYPE_POW :
+        case INSN_TYPE_AND ... INSN_TYPE_XNOR :
+        case INSN_TYPE_LSHIFT ... INSN_TYPE_CMPGT :
+            return insn->insn.binop.rres < VM_REG_COUNT && insn->insn.binop.r1 < VM_REG_COUNT &&
+                   insn->insn.binop.r2 < VM_REG_COUNT;
+
+        case INSN_TYPE_JA ... INSN_TYPE_JC :
+            return insn->insn.jmp.reg < VM_REG_COUNT && insn->insn.jmp.block_sel < block_count;
+
+        case INSN_TYPE_CALL_TYPE_LOADER : {
+            Size sel = insn->insn.call_type_loader.type_load_sel;
+            return sel < loader->loader_ref_count && loader->loader_refs[sel];
+        }
+
+        /* memory range depends on element count, and is always checked at runtime */
+        case INSN_TYPE_CALL_TYPE_LOADER_A : {
+            Size sel = insn->insn.call_type_loader_arr.type_load_sel;
+            return insn->insn.call_type_loader_arr.count_reg < VM_REG_COUNT &&
+                   sel < loader->loader_ref_count && loader->loader_refs[sel];
+        }
+
+        case INSN_TYPE_CALL_TYPE_LOADER_V : {
+            Size sel = insn->insn.call_type_loader_vec.type_load_sel;
+            return insn->insn.call_type_loader_vec.count_reg < VM_REG_COUNT &&
+                   sel < loader->loader_ref_count && loader->loader_refs[sel] &&
+                   verify_mem_range (
+                       loader,
+                       insn->insn.call_type_loader_vec.mem_off,
+                       1,
+                       sizeof (VmVector)
+                   );
+        }
+
+        case INSN_TYPE_READ_STRUCT : {
+            Size id = insn->insn.read_struct.layout_id;
+            return id < loader->struct_layout_count &&
+                   verify_mem_range (
+                       loader,
+                       insn->insn.read_struct.mem_off,
+                       loader->struct_layouts[id].mem_size,
+                       1
+                   );
+        }
+
+        case INSN_TYPE_JCMP :
+            return insn->insn.jcmp.rres < VM_REG_COUNT && insn->insn.jcmp.r1 < VM_REG_COUNT &&
+                   insn->insn.jcmp.rimm < VM_REG_COUNT && insn->insn.jcmp.block_sel < block_count;
+
+        /* cases of switch tables are checked against block count by loader_verify */
+        case INSN_TYPE_SWITCH :
+            return insn->insn.switch_table.reg < VM_REG_COUNT &&
+                   insn->insn.switch_table.table_id < loader->switch_table_count;
+
+        case INSN_TYPE_CHECK :
+            return insn->insn.check.block_sel < block_count;
+
+        default :
+            return False;
+    }
+}
+
+/**
+ * @b Apply stack effect of given instruction to abstract stack height.
+ *
+ * @return @c False on underflow, or if height exceeds @c VERIFY_MAX_STACK_SIZE.
+ * @return @c True otherwise.
+ * */
+static inline Bool verify_stack_effect (Insn* insn, Size* height) {
+    Size nbytes = 0;
+    Bool push   = False;
+
+    switch (insn->insn_type) {
+        case INSN_TYPE_PUSH_R8 ... INSN_TYPE_PUSH_M64 :
+            push = True;
+            /* fall through */
+        case INSN_TYPE_POP_R8 ... INSN_TYPE_POP_M64 :
+            nbytes = insn_elem_size (insn->insn_type);
+            break;
+
+        case INSN_TYPE_PUSH_A8 ... INSN_TYPE_PUSH_A64 :
+            push = True;
+            /* fall through */
+        case INSN_TYPE_POP_A8 ... INSN_TYPE_POP_A64 :
+            if (__builtin_mul_overflow (
+                    insn->insn.push_arr.elem_count,
+                    insn_elem_size (insn->insn_type),
+                    &nbytes
+                )) {
+                return False;
+            }
+            break;
+
+        default :
+            return True;
+    }
+
+    if (push) {
+        if (nbytes > VERIFY_MAX_STACK_SIZE - *height) {
+            return False;
+        }
+        *height += nbytes;
+    } else {
+        if (nbytes > *height) {
+            return False;
+        }
+        *height -= nbytes;
+    }
+
+    return True;
+}
+
+/**
+ * @b Check block layout of packed code, and decode and validate every instruction.
+ * */
+static inline Loader* verify_blocks (Loader* loader) {
+    PackedCode* packed = &loader->packed_code;
+
+    /* code must end with terminator and padding */
+    RETURN_VALUE_IF (packed->code_size < PACKED_CODE_PADDING + 1, Null, "Code is truncated\n");
+    Size code_end = packed->code_size - PACKED_CODE_PADDING - 1;
+    RETURN_VALUE_IF (
+        packed->code[code_end] != INSN_TYPE_EXIT_SUCCESS,
+        Null,
+        "Code does not end with terminator\n"
+    );
+
+    for (Size b = 0; b < packed->block_count; b++) {
+        Size begin = packed->block_offsets[b];
+        Size end   = b + 1 < packed->block_count ? packed->block_offsets[b + 1] : code_end;
+        RETURN_VALUE_IF (begin > end || end > code_end, Null, "Invalid offset of block %zu\n", b);
+
+        const Uint8* ip = packed->code + begin;
+        while (ip < packed->code + end) {
+            Insn insn;
+            RETURN_VALUE_IF (
+                !(ip = packed_insn_decode (packed, ip, &insn)),
+                Null,
+                "Failed to decode instruction in block %zu\n",
+                b
+            );
+            RETURN_VALUE_IF (
+                !verify_insn (loader, &insn),
+                Null,
+                "Invalid operands at offset %zu of block %zu\n",
+                (Size)(ip - packed->code) - begin,
+                b
+            );
+        }
+
+        RETURN_VALUE_IF (
+            ip != packed->code + end,
+            Null,
+            "Last instruction crosses end of block %zu\n",
+            b
+        );
+    }
+
+    return loader;
+}
+
+/**
+ * @b Compute stack height at entry of each reachable block by abstract
+ * interpretation, and maximum height reached anywhere.
+ *
+ * Blocks are visited once. A block reached again with a different height
+ * means the stack grows or shrinks in a loop, such loaders are rejected.
+ * Instructions are already validated by @c verify_blocks.
+ * */
+static inline Loader* verify_stack (Loader* loader) {
+    PackedCode* packed      = &loader->packed_code;
+    Size        block_count = packed->block_count;
+    Size        code_end    = packed->code_size - PACKED_CODE_PADDING - 1;
+
+    if (!block_count) {
+        return loader;
+    }
+
+    Size* entry_height = ALLOCATE (Size, block_count);
+    Size* worklist     = ALLOCATE (Size, block_count);
+    if (!entry_height || !worklist) {
+        PRINT_ERR (ERR_OUT_OF_MEMORY);
+        goto VERIFY_FAILED;
+    }
+
+    for (Size b = 0; b < block_count; b++) {
+        entry_height[b] = STACK_HEIGHT_UNKNOWN;
+    }
+
+    Size max_height = 0;
+    Size work_count = 0;
+
+    entry_height[0]        = 0;
+    worklist[work_count++] = 0;
+
+/* record height at entry of block, and queue it if not reached before */
+#define VERIFY_REACH(target, h)                                                                    \
+    do {                                                                                           \
+        if (entry_height[target] == STACK_HEIGHT_UNKNOWN) {                                        \
+            entry_height[target]   = (h);                                                          \
+            worklist[work_count++] = (target);                                                     \
+        } else if (entry_height[target] != (h)) {                                                  \
+            PRINT_ERR ("Block %zu is reached with different stack heights\n", (Size)(target));     \
+            goto VERIFY_FAILED;                                                                    \
+        }                                                                                          \
+    } while (0)
+
+    while (work_count) {
+        Size b      = worklist[--work_count];
+        Size height = entry_height[b];
+        Bool exits  = False;
+
+        Size         end = b + 1 < block_count ? packed->block_offsets[b + 1] : code_end;
+        const Uint8* ip  = packed->code + packed->block_offsets[b];
+        while (!exits && ip < packed->code + end) {
+            Insn insn;
+            ip = packed_insn_decode (packed, ip, &insn);
+
+            if (!verify_stack_effect (&insn, &height)) {
+                PRINT_ERR ("Stack underflow or overflow in block %zu\n", b);
+                goto VERIFY_FAILED;
+            }
+            max_height = MAX (max_height, height);
+
+            switch (insn.insn_type) {
+                case INSN_TYPE_JA ... INSN_TYPE_JC :
+                    VERIFY_REACH (insn.insn.jmp.block_sel, height);
+                    break;
+                case INSN_TYPE_JCMP :
+                    VERIFY_REACH (insn.insn.jcmp.block_sel, height);
+                    break;
+                case INSN_TYPE_SWITCH : {
+                    SwitchTable* table = loader->switch_tables + insn.insn.switch_table.table_id;
+                    for (Size c = 0; c < table->case_count; c++) {
+                        VERIFY_REACH (table->cases[c].block_sel, height);
+                    }
+                    break;
+                }
+                case INSN_TYPE_CHECK :
+                    VERIFY_REACH (insn.insn.check.block_sel, height);
+                    break;
+                case INSN_TYPE_EXIT_SUCCESS :
+                case INSN_TYPE_EXIT_FAILURE :
+                    exits = True;
+                    break;
+                default :
+                    break;
+            }
+        }
+
+        /* blocks are contiguous, so execution falls through to next block */
+        if (!exits && b + 1 < block_count) {
+            VERIFY_REACH (b + 1, height);
+        }
+    }
+
+#undef VERIFY_REACH
+
+    loader->max_stack_size = max_height;
+
+    FREE (entry_height);
+    FREE (worklist);
+    return loader;
+
+VERIFY_FAILED:
+    if (entry_height) {
+        FREE (entry_height);
+    }
+
+    if (worklist) {
+        FREE (worklist);
+    }
+
+    return Null;
+}
@@ -43,11 +43,81 @@
 /* libc */
 #include <memory.h>
 
+/* crossfile */
+#include <Anvie/CrossFile/Stream.h>
+
 /* local includes */
+#include "../../Stream/Stream.h"
+#include "Insn.h"
 #include "InsnBuilders.h"
-#include "TypeLoaderStack.h"
+#include "Jit.h"
+#include "Loader.h"
+#include "Packed.h"
+#include "Peephole.h"
+#include "Pool.h"
+#include "Stack.h"
+#include "Verify.h"
 #include "Vm.h"
 
+/* computed goto (labels as values) is a GNU extension, fallback to switch otherwise */
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(VM_NO_COMPUTED_GOTO)
+#    define VM_USE_COMPUTED_GOTO 1
+#else
+#    define VM_USE_COMPUTED_GOTO 0
+#endif
+
+#define VM_UNLIKELY(x) __builtin_expect (!!(x), 0)
+
+PRIVATE Vm* vm_init (Vm* vm);
+PRIVATE Vm* vm_exec_loader (Vm* vm, Loader* loader, Uint8* mem, Size depth, Uint64* regs_io);
+PRIVATE Vm*
+    vm_exec_loader_checked (Vm* vm, Loader* loader, Uint8* mem, Size depth, Uint64* regs_io);
+PRIVATE Vm*
+    vm_exec_loader_unchecked (Vm* vm, Loader* loader, Uint8* mem, Size depth, Uint64* regs_io);
+PRIVATE Bool
+    vm_exec_loader_jit (Vm* vm, Loader* loader, Uint8* mem, Size depth, Uint64* regs_io, Vm** res);
+PRIVATE Int32
+    vm_jit_run (Vm* vm, Loader* loader, Uint8* mem, Size depth, Uint64* regs, JitFrame* frame);
+PRIVATE Int32 vm_jit_call (JitFrame* frame, Size sel);
+#ifdef VM_JIT_DIFFERENTIAL
+PRIVATE Bool vm_jit_check_differential (
+    Vm*     vm,
+    Loader* loader,
+    Uint8*  mem,
+    Size    depth,
+    Uint64* regs_io,
+    Vm**    res
+);
+#endif
+PRIVATE Vm*         vm_exec_loader_array (
+    Vm*     vm,
+    Loader* loader,
+    Uint8*  mem,
+    Size    count,
+    Size    stride,
+    Size    depth,
+    Uint64* regs
+);
+PRIVATE Bool vm_exec_loader_array_parallel (
+    Vm*     vm,
+    Loader* loader,
+    Uint8*  mem,
+    Size    count,
+    Size    stride,
+    Size    depth,
+    Uint64* regs
+);
+PRIVATE Bool    vm_exec_loader_array_range (void* data, Size worker, Size begin, Size end);
+PRIVATE Bool    vm_loader_is_fixed (Loader* loader);
+PRIVATE Vm*     vm_init_workers (Vm* vm);
+PRIVATE void    vm_deinit_workers (Vm* vm);
+PRIVATE Loader* vm_prepare_loader (Loader* loader);
+PRIVATE Size    vm_validate (Vm* vm, Size count, Size* first);
+PRIVATE Bool vm_check_objects (Vm* vm, Loader* loader, const Uint8* mem, Size count, Size stride);
+PRIVATE void*   vm_alloc_vector (Vm* vm, Size nbytes);
+PRIVATE void        vm_copy_swap_elems (Uint8* dst, const Uint8* src, Size elem_size, Size count);
+PRIVATE void        vm_read_struct (Uint8* dst, const Uint8* src, const StructLayout* layout);
+
 /**
  * @b Initialize VM for execution.
  *
@@ -64,39 +134,808 @@ PRIVATE Vm* vm_init (Vm* vm) {
     RETURN_VALUE_IF (!vm, Null, ERR_INVALID_ARGUMENTS);
 
     /* if init is being called on vm again with previous stack not deinitialized
-     * then we can re-use the already allocated stacks. */
+     * then we can re-use the already allocated stack. */
 
-    if (!vm->loader_stacks || !vm->loader_stack_capacity) {
-        vm->loader_stacks = ALLOCATE (TypeLoaderStack, 32);
-        RETURN_VALUE_IF (!vm->loader_stack_capacity, Null, ERR_OUT_OF_MEMORY);
-        vm->loader_stack_capacity = 32;
-    }
+    RETURN_VALUE_IF (
+        !xft_vm_stack_init (&vm->stack, XFT_VM_STACK_INITIAL_CAPACITY),
+        Null,
+        "Failed to allocate VM stack\n"
+    );
 
-    vm->loader_stack_count = 0;
+    vm->frame = 0;
 
     return vm;
 }
 
 /**
- * @b De-initialize given @c Vm object.
+ * @b De-initialize given @c Vm object. This also frees elements of all vectors
+ * loaded by this VM.
  *
  * @param[out] vm @c Vm object to be de-initialized.
  *
  * @return @c vm on success.
  * @return @c Null otherwise.
  * */
-PRIVATE Vm* vm_deinit (Vm* vm) {
+PUBLIC Vm* vm_deinit (Vm* vm) {
     RETURN_VALUE_IF (!vm, Null, ERR_INVALID_ARGUMENTS);
 
-    if (vm->loader_stacks) {
-        for (Size s = 0; s < vm->loader_stack_count; s++) {
-            type_loader_stack_deinit (vm->loader_stacks + s);
-        }
+    xft_vm_stack_deinit (&vm->stack);
+    vm_deinit_workers (vm);
 
-        FREE (vm->loader_stacks);
+    if (vm->vectors) {
+        for (Size v = 0; v < vm->vector_count; v++) {
+            FREE (vm->vectors[v]);
+        }
+        FREE (vm->vectors);
     }
 
     memset (vm, 0, sizeof (Vm));
 
     return vm;
 }
+
+/**
+ * @b Execute given type loader, loading one object of loader's type from stream.
+ *
+ * Stream is read from it's current cursor, and cursor is left right after the
+ * last byte read by loader (and the loaders it calls).
+ *
+ * @param vm Initialized @c Vm object.
+ * @param loader Type loader to execute.
+ * @param stream Stream to load data from.
+ * @param mem Memory where loaded object will be stored. Must be atleast
+ *        @c loader->alloc_size bytes large.
+ *
+ * @return @c vm on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Vm* vm_run_loader (Vm* vm, Loader* loader, IoStream* stream, void* mem) {
+    RETURN_VALUE_IF (!vm || !loader || !stream, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (loader->alloc_size && !mem, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!vm->stack.stack_data && !vm_init (vm), Null, "Failed to initialize VM\n");
+    RETURN_VALUE_IF (!vm_prepare_loader (loader), Null, "Failed to prepare type loader\n");
+
+    vm->stream           = stream;
+    vm->frame            = 0;
+    vm->stack.stack_size = 0;
+
+    Uint64 regs[VM_REG_COUNT] = {0};
+    Vm*    res                = vm_exec_loader (vm, loader, mem, 0, regs);
+    if (res && !vm_check_objects (vm, loader, mem, 1, loader->alloc_size)) {
+        res = Null;
+    }
+
+    vm->stream = Null;
+    return res;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Make sure given loader has it's executable packed form. Loaders are
+ * optimized, encoded and verified once, on their first execution, and reuse
+ * it afterwards.
+ *
+ * A loader that fails verification is not an error, it just keeps running
+ * in checked mode.
+ * */
+PRIVATE Loader* vm_prepare_loader (Loader* loader) {
+    if (!loader->packed_code.code) {
+        RETURN_VALUE_IF (
+            !peephole_optimize_loader (loader, Null),
+            Null,
+            "Failed to optimize type loader\n"
+        );
+
+        RETURN_VALUE_IF (
+            !packed_code_encode (
+                &loader->packed_code,
+                loader->insn_blocks,
+                loader->insn_block_count
+            ),
+            Null,
+            "Failed to encode type loader \"%s\"\n",
+            loader->type_name ? loader->type_name : "<unnamed>"
+        );
+    }
+
+    if (loader->verify_status == LOADER_VERIFY_PENDING) {
+        /* check table is used by VM itself, and is never executed unchecked */
+        RETURN_VALUE_IF (
+            !check_table_is_valid (&loader->check, loader->alloc_size),
+            Null,
+            "Type loader \"%s\" has invalid check table\n",
+            loader->type_name ? loader->type_name : "<unnamed>"
+        );
+        loader_verify (loader);
+    }
+
+    return loader;
+}
+
+/**
+ * @b Select which of @c count objects loaded next have their assertions checked, as
+ * given by validation level of VM, and count them as checked or skipped. Selected objects
+ * are either all objects, or every @c VM_VALIDATION_SAMPLE_INTERVAL th object starting
+ * from @c first.
+ *
+ * @param vm
+ * @param count Number of objects.
+ * @param first Where index of first selected object is stored.
+ *
+ * @return Number of selected objects.
+ * */
+PRIVATE Size vm_validate (Vm* vm, Size count, Size* first) {
+    Size selected = 0;
+    *first        = 0;
+
+    switch (vm->validation) {
+        case VM_VALIDATION_SAMPLED : {
+            /* sampling continues from where last check left it */
+            Size seen = (vm->checks_run + vm->checks_skipped) % VM_VALIDATION_SAMPLE_INTERVAL;
+            *first    = seen ? VM_VALIDATION_SAMPLE_INTERVAL - seen : 0;
+            selected  = *first < count ? (count - *first - 1) / VM_VALIDATION_SAMPLE_INTERVAL + 1 :
+                                         0;
+            break;
+        }
+        case VM_VALIDATION_OFF :
+            break;
+        default :
+            selected = count;
+            break;
+    }
+
+    vm->checks_run     += selected;
+    vm->checks_skipped += count - selected;
+    return selected;
+}
+
+/**
+ * @b Check assertions in check table of given loader over objects it just loaded.
+ * Each term is tested over all objects selected by validation level at once.
+ *
+ * @param vm
+ * @param loader Loader that loaded the objects.
+ * @param mem First object.
+ * @param count Number of objects.
+ * @param stride Distance between objects.
+ *
+ * @return @c True if all selected objects are valid.
+ * @return @c False otherwise.
+ * */
+PRIVATE Bool vm_check_objects (Vm* vm, Loader* loader, const Uint8* mem, Size count, Size stride) {
+    if (!loader->check.term_count || !count) {
+        return True;
+    }
+
+    Size first    = 0;
+    Size selected = vm_validate (vm, count, &first);
+    Size step     = vm->validation == VM_VALIDATION_SAMPLED ? VM_VALIDATION_SAMPLE_INTERVAL : 1;
+    if (!selected) {
+        return True;
+    }
+
+    const CheckTerm* term =
+        check_table_run (&loader->check, mem + first * stride, selected, stride * step);
+    if (term) {
+        PRINT_ERR ("[XFT VM ERROR] %s\n", term->msg ? term->msg : "Assertion failed");
+        PRINT_ERR (
+            "XFT VM objects loaded by type loader \"%s\" failed their assertions\n",
+            loader->type_name ? loader->type_name : "<unnamed>"
+        );
+        return False;
+    }
+
+    return True;
+}
+
+/**
+ * @b Allocate zeroed memory for elements of a vector, owned by given VM.
+ *
+ * @return Allocated memory on success.
+ * @return @c Null otherwise.
+ * */
+PRIVATE void* vm_alloc_vector (Vm* vm, Size nbytes) {
+    if (vm->vector_count >= vm->vector_capacity) {
+        Size   new_capacity = vm->vector_capacity ? vm->vector_capacity * 2 : 8;
+        void** vectors      = REALLOCATE (vm->vectors, void*, new_capacity);
+        RETURN_VALUE_IF (!vectors, Null, ERR_OUT_OF_MEMORY);
+
+        vm->vectors         = vectors;
+        vm->vector_capacity = new_capacity;
+    }
+
+    void* data = ALLOCATE (Uint8, MAX (nbytes, 1));
+    RETURN_VALUE_IF (!data, Null, ERR_OUT_OF_MEMORY);
+
+    vm->vectors[vm->vector_count++] = data;
+    return data;
+}
+
+/* byte lanes of one 16 byte vector, swapped in one shuffle */
+typedef Uint8 VmSwapVec __attribute__ ((vector_size (16)));
+
+#if defined(__clang__)
+#    define VM_SHUFFLE_VEC(v, ...) __builtin_shufflevector (v, v, __VA_ARGS__)
+#else
+#    define VM_SHUFFLE_VEC(v, ...) __builtin_shuffle (v, (VmSwapVec) {__VA_ARGS__})
+#endif
+
+/* swap elements of given size, one whole vector at a time */
+#define VM_SWAP_VEC_LOOP(...)                                                                      \
+    for (; i + sizeof (VmSwapVec) <= nbytes; i += sizeof (VmSwapVec)) {                            \
+        VmSwapVec v;                                                                               \
+        memcpy (&v, src + i, sizeof (v));                                                          \
+        v = VM_SHUFFLE_VEC (v, __VA_ARGS__);                                                       \
+        memcpy (dst + i, &v, sizeof (v));                                                          \
+    }
+
+/**
+ * @b Copy an array of elements, inverting byte order of each element.
+ *
+ * Sixteen bytes are swapped at a time using a single vector shuffle, and remaining
+ * tail elements are swapped one by one. Source and destination must not overlap.
+ *
+ * @param dst Where swapped elements will be written.
+ * @param src Elements to be swapped.
+ * @param elem_size Size of each element, one of 2, 4 or 8. Other sizes are copied as is.
+ * @param count Number of elements.
+ * */
+PRIVATE void vm_copy_swap_elems (Uint8* dst, const Uint8* src, Size elem_size, Size count) {
+    Size nbytes = elem_size * count;
+    Size i      = 0;
+
+    switch (elem_size) {
+        case 2 :
+            VM_SWAP_VEC_LOOP (1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+            for (; i < nbytes; i += 2) {
+                Uint16 v;
+                memcpy (&v, src + i, 2);
+                v = INVERT_BYTE_ORDER_U16 (v);
+                memcpy (dst + i, &v, 2);
+            }
+            break;
+        case 4 :
+            VM_SWAP_VEC_LOOP (3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+            for (; i < nbytes; i += 4) {
+                Uint32 v;
+                memcpy (&v, src + i, 4);
+                v = INVERT_BYTE_ORDER_U32 (v);
+                memcpy (dst + i, &v, 4);
+            }
+            break;
+        case 8 :
+            VM_SWAP_VEC_LOOP (7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+            for (; i < nbytes; i += 8) {
+                Uint64 v;
+                memcpy (&v, src + i, 8);
+                v = INVERT_BYTE_ORDER_U64 (v);
+                memcpy (dst + i, &v, 8);
+            }
+            break;
+        default :
+            memcpy (dst, src, nbytes);
+            break;
+    }
+}
+
+#undef VM_SWAP_VEC_LOOP
+#undef VM_SHUFFLE_VEC
+
+/**
+ * @b Read a single record from @c src to @c dst using given struct layout.
+ * Caller must check that both memory and stream ranges of layout are valid.
+ * */
+PRIVATE void vm_read_struct (Uint8* dst, const Uint8* src, const StructLayout* layout) {
+    if (layout->is_dense && !layout->needs_swap) {
+        memcpy (dst, src, layout->stream_size);
+        return;
+    }
+
+    for (Size f = 0; f < layout->field_count; f++) {
+        const StructLayoutField* field = layout->fields + f;
+        if (field->swap) {
+            vm_copy_swap_elems (
+                dst + field->mem_off,
+                src + field->stream_off,
+                field->size,
+                field->count
+            );
+        } else {
+            memcpy (dst + field->mem_off, src + field->stream_off, field->size * field->count);
+        }
+    }
+}
+
+#define VM_EXEC_FN      vm_exec_loader_checked
+#define VM_EXEC_CHECKED 1
+#include "VmExec.h"
+
+#define VM_EXEC_FN      vm_exec_loader_unchecked
+#define VM_EXEC_CHECKED 0
+#include "VmExec.h"
+
+/**
+ * @b Execute given loader with the fastest execution mode it's allowed to use.
+ * */
+PRIVATE Vm* vm_exec_loader (Vm* vm, Loader* loader, Uint8* mem, Size depth, Uint64* regs_io) {
+    if (loader->verify_status == LOADER_VERIFY_PASSED) {
+#if VM_JIT_ENABLED
+        Vm* res = Null;
+        if (vm_exec_loader_jit (vm, loader, mem, depth, regs_io, &res)) {
+            return res;
+        }
+#endif
+        return vm_exec_loader_unchecked (vm, loader, mem, depth, regs_io);
+    }
+
+    return vm_exec_loader_checked (vm, loader, mem, depth, regs_io);
+}
+
+/**
+ * @b Array of elements loaded by one of pool workers.
+ * */
+typedef struct VmArrayTask {
+    Vm*     vm;     /**< @b VM that executes the array call. */
+    Loader* loader; /**< @b Fixed loader of each element. */
+    Uint8*  mem;    /**< @b Caller's memory. */
+    Size    stride;
+    Size    depth;
+    Uint64* regs;   /**< @b Caller's registers. */
+    Size    cursor; /**< @b Stream cursor first element is loaded from. */
+} VmArrayTask;
+
+/**
+ * @b Execute given loader once for each element of an array, as an
+ * @c INSN_TYPE_CALL_TYPE_LOADER_A does.
+ *
+ * Element @c i is loaded at offset @c regs[0] + i * stride in caller's memory, starting
+ * from a copy of caller's registers with @c r0 set to that offset. Caller's registers are
+ * not changed. Caller must make sure all elements lie inside it's memory.
+ *
+ * Arrays of fixed loaders that don't overlap in memory are split between workers of
+ * @c vm->pool when large enough, and are loaded one element after another otherwise.
+ * Assertions in loader's check table are checked once all elements are loaded.
+ *
+ * @return @c vm on success.
+ * @return @c Null otherwise.
+ * */
+PRIVATE Vm* vm_exec_loader_array (
+    Vm*     vm,
+    Loader* loader,
+    Uint8*  mem,
+    Size    count,
+    Size    stride,
+    Size    depth,
+    Uint64* regs
+) {
+    if (!vm_exec_loader_array_parallel (vm, loader, mem, count, stride, depth, regs)) {
+        Uint64 elem_regs[VM_REG_COUNT];
+        for (Size i = 0; i < count; i++) {
+            memcpy (elem_regs, regs, sizeof (elem_regs));
+            elem_regs[0] = regs[0] + i * stride;
+            if (!vm_exec_loader (vm, loader, mem + elem_regs[0], depth, elem_regs)) {
+                return Null;
+            }
+        }
+    }
+
+    return vm_check_objects (vm, loader, mem + regs[0], count, stride) ? vm : Null;
+}
+
+/**
+ * @b Load elements of an array on workers of @c vm->pool, each worker executing it's
+ * own VM with it's own registers and stack, over a disjoint range of elements.
+ *
+ * Every element of a fixed loader reads same number of bytes, so stream offset of each
+ * element is known in advance, and elements can be loaded in any order. If loading any
+ * element fails, stream cursor is left as is, and array must be loaded sequentially,
+ * which then reports the error.
+ *
+ * @return @c True if all elements were loaded.
+ * @return @c False if array must be loaded sequentially.
+ * */
+PRIVATE Bool vm_exec_loader_array_parallel (
+    Vm*     vm,
+    Loader* loader,
+    Uint8*  mem,
+    Size    count,
+    Size    stride,
+    Size    depth,
+    Uint64* regs
+) {
+    IoStream* io     = vm->stream;
+    Size      nbytes = 0;
+
+    /* overlapping elements must be written in order */
+    if (!vm->pool || vm->pool->worker_count < 2 || count < 2 || stride < loader->alloc_size) {
+        return False;
+    }
+
+#if VM_PROFILE_ENABLED
+    /* profile is recorded by calling thread only */
+    if (vm->profile) {
+        return False;
+    }
+#endif
+
+    if (!vm_loader_is_fixed (loader) ||
+        __builtin_mul_overflow (count, loader->fixed_stream_size, &nbytes) ||
+        nbytes < VM_PARALLEL_MIN_BYTES || nbytes > io->size - io->cursor || !vm_init_workers (vm)) {
+        return False;
+    }
+
+    VmArrayTask task = {
+        .vm     = vm,
+        .loader = loader,
+        .mem    = mem,
+        .stride = stride,
+        .depth  = depth,
+        .regs   = regs,
+        .cursor = io->cursor,
+    };
+
+    if (!vm_pool_run (
+            vm->pool,
+            count,
+            VM_PARALLEL_GRAIN_BYTES / MAX (loader->fixed_stream_size, 1),
+            vm_exec_loader_array_range,
+            &task
+        )) {
+        return False;
+    }
+
+    io->cursor += nbytes;
+    return True;
+}
+
+/**
+ * @b Load a range of elements of a @c VmArrayTask, on worker VM of given worker.
+ * Worker reads through it's own copy of stream, so only it's cursor moves.
+ * */
+PRIVATE Bool vm_exec_loader_array_range (void* data, Size worker, Size begin, Size end) {
+    VmArrayTask* task   = data;
+    Vm*          wvm    = task->vm->workers + worker;
+    IoStream     stream = *task->vm->stream;
+    Bool         res    = True;
+
+    Uint64 elem_regs[VM_REG_COUNT];
+
+    wvm->stream           = &stream;
+    wvm->frame            = 0;
+    wvm->stack.stack_size = 0;
+
+    for (Size i = begin; res && i < end; i++) {
+        memcpy (elem_regs, task->regs, sizeof (elem_regs));
+        elem_regs[0]  = task->regs[0] + i * task->stride;
+        stream.cursor = task->cursor + i * task->loader->fixed_stream_size;
+
+        Uint8* elem = task->mem + elem_regs[0];
+        res         = !!vm_exec_loader (wvm, task->loader, elem, task->depth, elem_regs);
+    }
+
+    wvm->stream = Null;
+    return res;
+}
+
+/**
+ * @b Check whether given prepared loader is fixed, analyzing it, and every loader it
+ * refers to, on first use. Loaders are prepared before being analyzed, so pool workers
+ * never modify loaders while executing them.
+ * */
+PRIVATE Bool vm_loader_is_fixed (Loader* loader) {
+    if (loader->fixed_status == LOADER_FIXED_PENDING) {
+        loader->fixed_status = LOADER_FIXED_ANALYZING;
+
+        Bool prepared = True;
+        for (Size r = 0; r < loader->loader_ref_count; r++) {
+            Loader* ref = loader->loader_refs[r];
+            if (!ref) {
+                continue;
+            }
+            if (!vm_prepare_loader (ref)) {
+                prepared = False;
+                break;
+            }
+            vm_loader_is_fixed (ref);
+        }
+
+        /* sets status to either yes or no, also breaking any recursion */
+        if (!prepared || !loader_analyze_fixed (loader)) {
+            loader->fixed_status = LOADER_FIXED_NO;
+        }
+    }
+
+    return loader->fixed_status == LOADER_FIXED_YES;
+}
+
+/**
+ * @b Create one VM for each worker of @c vm->pool, unless already created.
+ *
+ * @return @c vm on success.
+ * @return @c Null otherwise.
+ * */
+PRIVATE Vm* vm_init_workers (Vm* vm) {
+    if (vm->workers && vm->worker_count == vm->pool->worker_count) {
+        return vm;
+    }
+
+    vm_deinit_workers (vm);
+
+    Vm* workers = ALLOCATE (Vm, vm->pool->worker_count);
+    RETURN_VALUE_IF (!workers, Null, ERR_OUT_OF_MEMORY);
+    vm->workers = workers;
+
+    for (Size w = 0; w < vm->pool->worker_count; w++) {
+        if (!vm_init (workers + w)) {
+            vm_deinit_workers (vm);
+            return Null;
+        }
+        workers[w].parent = vm;
+        vm->worker_count++;
+    }
+
+    return vm;
+}
+
+/**
+ * @b Destroy VMs of pool workers of given VM, if any.
+ * */
+PRIVATE void vm_deinit_workers (Vm* vm) {
+    for (Size w = 0; w < vm->worker_count; w++) {
+        vm_deinit (vm->workers + w);
+    }
+
+    if (vm->workers) {
+        FREE (vm->workers);
+    }
+
+    vm->workers      = Null;
+    vm->worker_count = 0;
+}
+
+/**
+ * @b Execute given verified loader through it's native code, compiling it once it
+ * has been interpreted @c VM_JIT_THRESHOLD times.
+ *
+ * When native code bails out, stream cursor is restored and loader must be executed
+ * again by interpreter, which then reports the error. Loaders only depend on stream
+ * and registers, so this redoes exactly the same work.
+ *
+ * Building with @c VM_JIT_DIFFERENTIAL executes every natively executed loader
+ * through the interpreter as well, and fails on any difference in loaded memory,
+ * returned register or stream cursor.
+ *
+ * @param res Where result of execution is stored, if native code handled it.
+ *
+ * @return @c True if native code handled the execution.
+ * @return @c False if loader must be interpreted.
+ * */
+PRIVATE Bool
+    vm_exec_loader_jit (Vm* vm, Loader* loader, Uint8* mem, Size depth, Uint64* regs_io, Vm** res) {
+    if (loader->jit_status == LOADER_JIT_UNSUPPORTED || depth >= VM_MAX_CALL_DEPTH) {
+        return False;
+    }
+
+#if VM_PROFILE_ENABLED
+    /* native code is not instrumented, so profiled executions are always interpreted */
+    if (vm->profile) {
+        return False;
+    }
+#endif
+
+    if (loader->jit_status == LOADER_JIT_PENDING) {
+        /* pool workers run in parallel, so only calling thread counts and compiles */
+        if (vm->parent) {
+            return False;
+        }
+        if (loader->jit_exec_count < VM_JIT_THRESHOLD) {
+            loader->jit_exec_count++;
+            return False;
+        }
+        if (!jit_compile_loader (loader, vm_jit_call)) {
+            /* a loader that can't be compiled once won't be tried again */
+            loader->jit_status = LOADER_JIT_UNSUPPORTED;
+            return False;
+        }
+    }
+
+#ifdef VM_JIT_DIFFERENTIAL
+    return vm_jit_check_differential (vm, loader, mem, depth, regs_io, res);
+#else
+    JitFrame frame;
+    Int32    result = vm_jit_run (vm, loader, mem, depth, regs_io, &frame);
+
+    if (result == JIT_RESULT_BAIL) {
+        return False;
+    }
+
+    if (result == JIT_RESULT_FAILED) {
+        *res = Null;
+        return True;
+    }
+
+    vm->stream->cursor = frame.cursor;
+    regs_io[0]         = frame.regs[0];
+    if (!depth) {
+        memcpy (vm->regs, frame.regs, sizeof (frame.regs));
+        vm->loader = loader;
+    }
+
+    *res = vm;
+    return True;
+#endif
+}
+
+/**
+ * @b Execute native code of given loader once, from current stream cursor.
+ *
+ * When native code bails out, stream cursor is restored, since callees may
+ * have moved it before that. Otherwise cursor is left as is, and @c frame has
+ * cursor and registers native code finished with.
+ *
+ * @param regs Registers to execute loader with, not modified.
+ * @param frame Frame to execute loader in.
+ *
+ * @return A @c JitResult.
+ * */
+PRIVATE Int32
+    vm_jit_run (Vm* vm, Loader* loader, Uint8* mem, Size depth, Uint64* regs, JitFrame* frame) {
+    IoStream* io = vm->stream;
+
+    *frame = (JitFrame) {
+        .data   = io->data,
+        .size   = io->size,
+        .cursor = io->cursor,
+        .mem    = mem,
+        .vm     = vm,
+        .loader = loader,
+        .depth  = depth,
+    };
+    memcpy (frame->regs, regs, sizeof (frame->regs));
+
+    Size  cursor = io->cursor;
+    Int32 result = ((JitLoaderFn)loader->jit_code) (frame);
+
+    if (result == JIT_RESULT_BAIL) {
+        io->cursor = cursor;
+    }
+
+    return result;
+}
+
+/**
+ * @b Called by native code to execute a type loader referenced by frame's loader.
+ * Callee is executed the same way as @c INSN_TYPE_CALL_TYPE_LOADER in interpreter.
+ * */
+PRIVATE Int32 vm_jit_call (JitFrame* frame, Size sel) {
+    Vm*       vm     = frame->vm;
+    Loader*   callee = frame->loader->loader_refs[sel];
+    IoStream* io     = vm->stream;
+
+    if (!vm_prepare_loader (callee)) {
+        PRINT_ERR ("XFT VM call to invalid type loader\n");
+        return JIT_RESULT_FAILED;
+    }
+
+    Uint8* mem = frame->mem + frame->regs[0];
+    io->cursor = frame->cursor;
+    if (!vm_exec_loader (vm, callee, mem, frame->depth + 1, frame->regs) ||
+        !vm_check_objects (vm, callee, mem, 1, callee->alloc_size)) {
+        return JIT_RESULT_FAILED;
+    }
+
+    frame->cursor = io->cursor;
+    return JIT_RESULT_DONE;
+}
+
+#ifdef VM_JIT_DIFFERENTIAL
+
+/* memory of a loader is filled with this before each execution being compared */
+#    define VM_JIT_POISON_BYTE 0xa5
+
+/**
+ * @b Execute a loader through native code, then through interpreter, and compare
+ * both results.
+ *
+ * Both executions start from memory filled with @c VM_JIT_POISON_BYTE, so that a
+ * field written by only one of them is not hidden by what the other one left in
+ * memory. Loaders don't write every byte of their memory (padding, fields that are
+ * not present), so loaded object itself is produced by a third execution, through
+ * interpreter, from memory as caller gave it. Only that execution is counted in
+ * validation counters of VM.
+ *
+ * @param regs_io Registers to execute loader with, @c r0 is replaced by result.
+ * @param res Where result of execution is stored, if native code handled it.
+ *
+ * @return @c True if native code handled the execution.
+ * @return @c False if loader must be interpreted.
+ * */
+PRIVATE Bool vm_jit_check_differential (
+    Vm*     vm,
+    Loader* loader,
+    Uint8*  mem,
+    Size    depth,
+    Uint64* regs_io,
+    Vm**    res
+) {
+    IoStream* io     = vm->stream;
+    Size      cursor = io->cursor;
+    Size      size   = loader->alloc_size;
+
+    /* memory as caller gave it, followed by memory as native code loaded it */
+    Uint8* saved = Null;
+    if (size) {
+        saved = ALLOCATE (Uint8, size * 2);
+        if (!saved) {
+            PRINT_ERR (ERR_OUT_OF_MEMORY);
+            *res = Null;
+            return True;
+        }
+        memcpy (saved, mem, size);
+        memset (mem, VM_JIT_POISON_BYTE, size);
+    }
+
+    Size checks_run     = vm->checks_run;
+    Size checks_skipped = vm->checks_skipped;
+
+    JitFrame frame;
+    Int32    result = vm_jit_run (vm, loader, mem, depth, regs_io, &frame);
+
+    Bool same = True;
+    if (result == JIT_RESULT_DONE) {
+        Uint64 regs[VM_REG_COUNT];
+        memcpy (regs, regs_io, sizeof (regs));
+
+        if (size) {
+            memcpy (saved + size, mem, size);
+            memset (mem, VM_JIT_POISON_BYTE, size);
+        }
+        io->cursor         = cursor;
+        vm->checks_run     = checks_run;
+        vm->checks_skipped = checks_skipped;
+
+        if (!vm_exec_loader_unchecked (vm, loader, mem, depth, regs)) {
+            PRINT_ERR (
+                "XFT VM native code of type loader \"%s\" succeeded where interpreter failed\n",
+                loader->type_name ? loader->type_name : "<unnamed>"
+            );
+            same = False;
+        } else if (io->cursor != frame.cursor || regs[0] != frame.regs[0] ||
+                   (!depth && memcmp (vm->regs, frame.regs, sizeof (frame.regs))) ||
+                   (size && memcmp (saved + size, mem, size))) {
+            PRINT_ERR (
+                "XFT VM native code of type loader \"%s\" differs from interpreter\n",
+                loader->type_name ? loader->type_name : "<unnamed>"
+            );
+            same = False;
+        }
+    }
+
+    /* a bailed out execution is redone by caller, so memory must be as caller gave it */
+    if (size) {
+        memcpy (mem, saved, size);
+        FREE (saved);
+    }
+
+    if (result == JIT_RESULT_BAIL) {
+        return False;
+    }
+
+    if (result == JIT_RESULT_FAILED || !same) {
+        *res = Null;
+        return True;
+    }
+
+    io->cursor         = cursor;
+    vm->checks_run     = checks_run;
+    vm->checks_skipped = checks_skipped;
+    *res               = vm_exec_loader_unchecked (vm, loader, mem, depth, regs_io);
+    return True;
+}
+
+#    undef VM_JIT_POISON_BYTE
+
+#endif
@@ -47,30 +47,110 @@
 #include <Anvie/Common.h>
 #include <Anvie/Types.h>
 
+/* crossfile */
+#include <Anvie/CrossFile/Stream.h>
+
+/* local includes */
+#include "Loader.h"
+#include "Pool.h"
+#include "Profile.h"
+#include "Stack.h"
+
 /* proper renaming to make sure this is comptible with public opaque declaration */
 typedef struct XftVm XftVm;
 typedef XftVm        Vm;
 
-/* this is never exposed publicly so we can direcly typedef it */
-typedef struct TypeLoaderStack TypeLoaderStack;
-
 /* number of registers in crossfile type vm */
 #define VM_REG_COUNT 8
 
+/* maximum depth of nested type loader calls */
+#define VM_MAX_CALL_DEPTH 256
+
+/* arrays of fixed type loaders reading less than this many bytes are always loaded sequentially */
+#ifndef VM_PARALLEL_MIN_BYTES
+#    define VM_PARALLEL_MIN_BYTES (1 << 16)
+#endif
+
+/* approximate number of bytes read by elements a pool worker takes at a time */
+#ifndef VM_PARALLEL_GRAIN_BYTES
+#    define VM_PARALLEL_GRAIN_BYTES (1 << 12)
+#endif
+
+/* one out of these many loaded objects has it's assertions checked when validation is sampled */
+#ifndef VM_VALIDATION_SAMPLE_INTERVAL
+#    define VM_VALIDATION_SAMPLE_INTERVAL 64
+#endif
+
+/**
+ * @b Which loaded objects have their assertions checked.
+ * */
+typedef enum VmValidation {
+    VM_VALIDATION_FULL = 0, /**< @b Every object is checked. */
+    VM_VALIDATION_SAMPLED,  /**< @b Every @c VM_VALIDATION_SAMPLE_INTERVAL th object is checked. */
+    VM_VALIDATION_OFF       /**< @b Input is trusted, no object is checked. */
+} VmValidation;
+
+/**
+ * @b Elements of an array whose size is only known at runtime. VM allocates memory for
+ * elements, and stores this in loaded object in place of the array.
+ * */
+typedef struct VmVector {
+    void*  data;  /**< @b Elements, each as large as allocation size of element's loader. */
+    Uint64 count; /**< @b Number of elements. */
+} VmVector;
+
 /**
  * @b The CrossFile Type VM.
+ *
+ * Registers and program counter are kept in locals while a loader executes,
+ * these fields only contain their values at the time execution stopped. Program
+ * counter is the byte offset of instruction in packed code of it's block.
+ *
+ * Calling convention : a called type loader starts with a copy of caller's
+ * registers, with @c r0 holding offset of callee's object in caller's memory,
+ * and returns it's result in caller's @c r0. Nothing is passed on stack, so
+ * callee's frame starts empty at caller's stack top. An array call starts every
+ * element from a copy of caller's registers, and leaves them unchanged.
+ *
+ * Memory of all vectors loaded by a VM is owned by the VM, and lives till it's
+ * de-initialized.
+ *
+ * Assertions in @c check table of a loader are checked by VM once the call loading
+ * objects of that loader returns, over all these objects at once. Loaders check rest of
+ * their assertions themselves, after an @c INSN_TYPE_CHECK. Objects whose assertions are
+ * checked, either way, are selected by @c validation.
  * */
 struct XftVm {
     Uint64 regs[VM_REG_COUNT];
 
     Uint64 pc;                              /**< Program counter. */
+    Size   block;                           /**< Index of block being executed. */
+
+    IoStream* stream;                       /**< @b Stream being loaded from. */
+    Loader*   loader;                       /**< @b Loader being executed. */
+
+    XftVmStack stack;                       /**< @b Stack shared by frames of all type loaders. */
+    Size       frame;                       /**< @b Base of frame of loader being executed. */
+
+    VmPool* pool;                           /**< @b Pool arrays of fixed types load on, if any. */
+    Vm*     workers;                        /**< @b One VM for each worker of pool. */
+    Size    worker_count;                   /**< @b Number of VMs in workers. */
+    Vm*     parent;                         /**< @b VM this one loads array elements for, if any. */
+
+    void** vectors;                         /**< @b Memory allocated for elements of vectors. */
+    Size   vector_count;                    /**< @b Number of allocations in vectors. */
+    Size   vector_capacity;                 /**< @b Capacity of vectors array. */
+
+    VmValidation validation;                /**< @b Which objects have their assertions checked. */
+    Size         checks_run;                /**< @b Number of objects checked. */
+    Size         checks_skipped;            /**< @b Number of objects not checked. */
 
-    TypeLoaderStack* loader_stacks;         /**< @b A vector of stacks for type loaders */
-    Size             loader_stack_count;    /**< @b Number of stacks. */
-    Size             loader_stack_capacity; /**< @b Capacity of stacks vector */
+#if VM_PROFILE_ENABLED
+    VmProfile* profile;                     /**< @b Profile execution is recorded in, if any. */
+#endif
 };
 
-PRIVATE Vm* vm_init (Vm* vm);
-PRIVATE Vm* vm_deinit (Vm* vm);
+PUBLIC Vm* vm_deinit (Vm* vm);
+PUBLIC Vm* vm_run_loader (Vm* vm, Loader* loader, IoStream* stream, void* mem);
 
 #endif // ANVIE_SOURCE_CROSSFILE_XFT_H
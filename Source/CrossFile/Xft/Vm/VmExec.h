@@ -0,0 +1,1134 @@
+/**
+ * @file VmExec.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/*
+ * Interpreter loop, included by Vm.c once for every execution mode. Before
+ * including, define :
+ * - VM_EXEC_FN      : name of generated method,
+ * - VM_EXEC_CHECKED : 1 to check operands at runtime, 0 for verified loaders.
+ *
+ * Intentionally without an include guard.
+ * */
+
+#if !defined(VM_EXEC_FN) || !defined(VM_EXEC_CHECKED)
+#    error "VM_EXEC_FN and VM_EXEC_CHECKED must be defined before including VmExec.h"
+#endif
+
+/* operand decoders and checks used by instruction handlers below */
+
+/* memory offsets computed at runtime are always checked */
+#define VM_CHECK_MEM_ALWAYS(off, nbytes)                                                           \
+    if (VM_UNLIKELY ((off) > alloc_size || (nbytes) > alloc_size - (off))) {                       \
+        goto MEMORY_OUT_OF_BOUNDS;                                                                 \
+    }
+
+/* everything checked by verifier is only checked at runtime for unverified loaders */
+#if VM_EXEC_CHECKED
+#    define VM_CHECK_REG(r)                                                                        \
+        if (VM_UNLIKELY ((r) >= VM_REG_COUNT)) {                                                   \
+            goto INVALID_REGISTER;                                                                 \
+        }
+#    define VM_CHECK_SEL(sel, count, label)                                                        \
+        if (VM_UNLIKELY ((sel) >= (count))) {                                                      \
+            goto label;                                                                            \
+        }
+#    define VM_CHECK_MEM(off, nbytes) VM_CHECK_MEM_ALWAYS (off, nbytes)
+/* element count of array instructions is checked against memory size before multiplying */
+#    define VM_CHECK_ARR(off, count, esize)                                                        \
+        if (VM_UNLIKELY ((count) > alloc_size / (esize))) {                                        \
+            goto MEMORY_OUT_OF_BOUNDS;                                                             \
+        }                                                                                          \
+        VM_CHECK_MEM (off, (count) * (esize))
+#    define VM_CHECK_OPCODE(op)                                                                    \
+        if (VM_UNLIKELY ((op) >= INSN_TYPE_MAX)) {                                                 \
+            goto INVALID_INSN;                                                                     \
+        }
+#else
+#    define VM_CHECK_REG(r)
+#    define VM_CHECK_SEL(sel, count, label) ((void)(sel), (void)(count))
+#    define VM_CHECK_MEM(off, nbytes)
+#    define VM_CHECK_ARR(off, count, esize)
+#    define VM_CHECK_OPCODE(op)
+#endif
+
+/* single register operand */
+#define VM_FETCH_REG(r)                                                                            \
+    Uint8 r = *ip++;                                                                               \
+    VM_CHECK_REG (r)
+
+/* two register operands packed in nibbles of one byte */
+#define VM_FETCH_REG_PAIR(lo, hi)                                                                  \
+    Uint8 lo = *ip & 0xf;                                                                          \
+    Uint8 hi = *ip++ >> 4;                                                                         \
+    VM_CHECK_REG (lo);                                                                             \
+    VM_CHECK_REG (hi)
+
+#define VM_FETCH_ULEB(v)                                                                           \
+    Uint64 v;                                                                                      \
+    PACKED_READ_ULEB (ip, v)
+
+/* every read checks it's size first, so bytes read are counted here */
+#define VM_CHECK_STREAM(nbytes)                                                                    \
+    if (VM_UNLIKELY ((nbytes) > stream_size - cursor)) {                                           \
+        goto STREAM_UNDERFLOW;                                                                     \
+    }                                                                                              \
+    VM_PROFILE_BYTES (nbytes)
+
+/* profiling hooks, compiled out completely unless VM_ENABLE_PROFILE is defined */
+#if VM_PROFILE_ENABLED
+#    define VM_PROFILE_BEGIN()                                                                     \
+        VmProfile*       profile          = vm->profile;                                           \
+        VmProfileLoader* prof             = profile ? vm_profile_enter (profile, loader) : Null;   \
+        Uint64           prof_start       = prof ? vm_profile_now() : 0;                           \
+        Uint64           prof_block_start = prof_start;                                            \
+        Uint64           prof_bytes       = 0;                                                     \
+        Size             prof_block       = 0;                                                     \
+        Size             prof_block_end   = block_count > 1 ? block_offsets[1] : SIZE_MAX;         \
+        if (prof && prof->block_count) {                                                           \
+            prof->blocks[0].exec_count++;                                                          \
+        }
+/* time till now goes to block being left */
+#    define VM_PROFILE_ENTER_BLOCK(b)                                                              \
+        do {                                                                                       \
+            Uint64 now_                      = vm_profile_now();                                   \
+            prof->blocks[prof_block].cycles += now_ - prof_block_start;                            \
+            prof_block_start                 = now_;                                               \
+            prof_block                       = (b);                                                \
+            prof_block_end                   = prof_block + 1 < block_count ?                      \
+                                                   block_offsets[prof_block + 1] :                 \
+                                                   SIZE_MAX;                                       \
+            prof->blocks[prof_block].exec_count++;                                                 \
+        } while (0)
+/* blocks are also left by falling through to next one, noticed when crossing block's end */
+#    define VM_PROFILE_INSN()                                                                      \
+        if (prof) {                                                                                \
+            profile->insn_counts[op < INSN_TYPE_MAX ? op : INSN_TYPE_UNKNOWN]++;                   \
+            while ((Size)(insn - code) >= prof_block_end) {                                        \
+                VM_PROFILE_ENTER_BLOCK (prof_block + 1);                                           \
+            }                                                                                      \
+        }
+#    define VM_PROFILE_JUMP(sel)                                                                   \
+        if (prof) {                                                                                \
+            VM_PROFILE_ENTER_BLOCK (sel);                                                          \
+        }
+#    define VM_PROFILE_BYTES(nbytes) prof_bytes += (nbytes)
+#    define VM_PROFILE_END()                                                                       \
+        if (prof) {                                                                                \
+            Uint64 now_ = vm_profile_now();                                                        \
+            if (prof->block_count) {                                                               \
+                prof->blocks[prof_block].cycles += now_ - prof_block_start;                        \
+            }                                                                                      \
+            prof->cycles     += now_ - prof_start;                                                 \
+            prof->bytes_read += prof_bytes;                                                        \
+            vm_profile_leave (profile, now_ - prof_start);                                         \
+        }
+#else
+#    define VM_PROFILE_BEGIN()
+#    define VM_PROFILE_INSN()
+#    define VM_PROFILE_JUMP(sel)
+#    define VM_PROFILE_BYTES(nbytes)
+#    define VM_PROFILE_END()
+#endif
+
+/* verified loaders reserve their maximum stack size on entry and never pop below their frame */
+#if VM_EXEC_CHECKED
+#    define VM_STACK_RESERVE(nbytes)                                                               \
+        if (VM_UNLIKELY ((nbytes) > stack->stack_capacity - stack->stack_size) &&                  \
+            !xft_vm_stack_reserve (stack, nbytes)) {                                               \
+            goto STACK_ERROR;                                                                      \
+        }
+#    define VM_STACK_CHECK_POP(nbytes)                                                             \
+        if (VM_UNLIKELY ((nbytes) > stack->stack_size - frame)) {                                  \
+            goto STACK_ERROR;                                                                      \
+        }
+#else
+#    define VM_STACK_RESERVE(nbytes)
+#    define VM_STACK_CHECK_POP(nbytes)
+#endif
+
+#define VM_STACK_PUSH(n, val)                                                                      \
+    do {                                                                                           \
+        Uint##n pushed_ = (val);                                                                   \
+        VM_STACK_RESERVE (n >> 3);                                                                 \
+        memcpy (stack->stack_data + stack->stack_size, &pushed_, n >> 3);                          \
+        stack->stack_size += n >> 3;                                                               \
+    } while (0)
+
+#define VM_STACK_POP(n, pval)                                                                      \
+    do {                                                                                           \
+        VM_STACK_CHECK_POP (n >> 3);                                                               \
+        stack->stack_size -= n >> 3;                                                               \
+        memcpy ((pval), stack->stack_data + stack->stack_size, n >> 3);                            \
+    } while (0)
+
+#define VM_JUMP_TO_BLOCK(sel)                                                                      \
+    VM_CHECK_SEL (sel, block_count, INVALID_JUMP);                                                 \
+    VM_PROFILE_JUMP (sel);                                                                         \
+    ip = code + block_offsets[sel]
+
+/* code always ends with an exit, so dispatching never needs to check for end of code */
+#if VM_USE_COMPUTED_GOTO
+#    define VM_HANDLER(name) HANDLER_##name:
+#    define VM_DISPATCH()                                                                          \
+        do {                                                                                       \
+            insn = ip;                                                                             \
+            op   = *ip++;                                                                          \
+            VM_CHECK_OPCODE (op);                                                                  \
+            VM_PROFILE_INSN();                                                                     \
+            goto* dispatch_table[op];                                                              \
+        } while (0)
+#    define VM_DISPATCH_BEGIN() VM_DISPATCH();
+#    define VM_DISPATCH_END()
+#else
+#    define VM_HANDLER(name) case INSN_TYPE_##name:
+#    define VM_DISPATCH()    goto DISPATCH
+#    define VM_DISPATCH_BEGIN()                                                                    \
+    DISPATCH:                                                                                      \
+        insn = ip;                                                                                 \
+        op   = *ip++;                                                                              \
+        VM_PROFILE_INSN();                                                                         \
+        switch (op) {
+#    define VM_DISPATCH_END()                                                                      \
+        default :                                                                                  \
+            goto INVALID_INSN;                                                                     \
+            }
+#endif
+
+/* instruction handlers that differ only in operand size are generated using these */
+
+#define VM_READ_REG_HANDLER(n)                                                                     \
+    VM_HANDLER (READ_R##n) {                                                                       \
+        VM_FETCH_REG (r);                                                                          \
+        VM_CHECK_STREAM (n >> 3);                                                                  \
+        Uint##n v;                                                                                 \
+        memcpy (&v, stream_data + cursor, n >> 3);                                                 \
+        cursor  += n >> 3;                                                                         \
+        regs[r]  = v;                                                                              \
+        VM_DISPATCH();                                                                             \
+    }
+
+#define VM_READ_MEM_HANDLER(n)                                                                     \
+    VM_HANDLER (READ_M##n) {                                                                       \
+        VM_FETCH_ULEB (off);                                                                       \
+        VM_CHECK_MEM (off, n >> 3);                                                                \
+        VM_CHECK_STREAM (n >> 3);                                                                  \
+        memcpy (mem + off, stream_data + cursor, n >> 3);                                          \
+        cursor += n >> 3;                                                                          \
+        VM_DISPATCH();                                                                             \
+    }
+
+#define VM_READ_ARR_HANDLER(n)                                                                     \
+    VM_HANDLER (READ_A##n) {                                                                       \
+        VM_FETCH_ULEB (off);                                                                       \
+        VM_FETCH_ULEB (count);                                                                     \
+        VM_CHECK_ARR (off, count, n >> 3);                                                         \
+        VM_CHECK_STREAM (count * (n >> 3));                                                        \
+        memcpy (mem + off, stream_data + cursor, count * (n >> 3));                                \
+        cursor += count * (n >> 3);                                                                \
+        VM_DISPATCH();                                                                             \
+    }
+
+/* one bounds check for whole array, elements swapped while copying if byte order differs */
+#define VM_READ_ARR_ORDER_HANDLER(n, order, swap)                                                  \
+    VM_HANDLER (READ_A##n##_##order) {                                                             \
+        VM_FETCH_ULEB (off);                                                                       \
+        VM_FETCH_ULEB (count);                                                                     \
+        VM_CHECK_ARR (off, count, n >> 3);                                                         \
+        VM_CHECK_STREAM (count * (n >> 3));                                                        \
+        if (swap) {                                                                                \
+            vm_copy_swap_elems (mem + off, stream_data + cursor, n >> 3, count);                   \
+        } else {                                                                                   \
+            memcpy (mem + off, stream_data + cursor, count * (n >> 3));                            \
+        }                                                                                          \
+        cursor += count * (n >> 3);                                                                \
+        VM_DISPATCH();                                                                             \
+    }
+
+#define VM_PUSH_REG_HANDLER(n)                                                                     \
+    VM_HANDLER (PUSH_R##n) {                                                                       \
+        VM_FETCH_REG (r);                                                                          \
+        VM_STACK_PUSH (n, (Uint##n)regs[r]);                                                       \
+        VM_DISPATCH();                                                                             \
+    }
+
+#define VM_POP_REG_HANDLER(n)                                                                      \
+    VM_HANDLER (POP_R##n) {                                                                        \
+        VM_FETCH_REG (r);                                                                          \
+        Uint##n v;                                                                                 \
+        VM_STACK_POP (n, &v);                                                                      \
+        regs[r] = v;                                                                               \
+        VM_DISPATCH();                                                                             \
+    }
+
+#define VM_PUSH_MEM_HANDLER(n)                                                                     \
+    VM_HANDLER (PUSH_M##n) {                                                                       \
+        VM_FETCH_ULEB (off);                                                                       \
+        VM_CHECK_MEM (off, n >> 3);                                                                \
+        Uint##n v;                                                                                 \
+        memcpy (&v, mem + off, n >> 3);                                                            \
+        VM_STACK_PUSH (n, v);                                                                      \
+        VM_DISPATCH();                                                                             \
+    }
+
+#define VM_POP_MEM_HANDLER(n)                                                                      \
+    VM_HANDLER (POP_M##n) {                                                                        \
+        VM_FETCH_ULEB (off);                                                                       \
+        VM_CHECK_MEM (off, n >> 3);                                                                \
+        Uint##n v;                                                                                 \
+        VM_STACK_POP (n, &v);                                                                      \
+        memcpy (mem + off, &v, n >> 3);                                                            \
+        VM_DISPATCH();                                                                             \
+    }
+
+/* arrays are moved as a whole, so popping an array gives back elements in pushed order */
+#define VM_PUSH_ARR_HANDLER(n)                                                                     \
+    VM_HANDLER (PUSH_A##n) {                                                                       \
+        VM_FETCH_ULEB (off);                                                                       \
+        VM_FETCH_ULEB (count);                                                                     \
+        VM_CHECK_ARR (off, count, n >> 3);                                                         \
+        Size nbytes = count * (n >> 3);                                                            \
+        VM_STACK_RESERVE (nbytes);                                                                 \
+        memcpy (stack->stack_data + stack->stack_size, mem + off, nbytes);                         \
+        stack->stack_size += nbytes;                                                               \
+        VM_DISPATCH();                                                                             \
+    }
+
+#define VM_POP_ARR_HANDLER(n)                                                                      \
+    VM_HANDLER (POP_A##n) {                                                                        \
+        VM_FETCH_ULEB (off);                                                                       \
+        VM_FETCH_ULEB (count);                                                                     \
+        VM_CHECK_ARR (off, count, n >> 3);                                                         \
+        Size nbytes = count * (n >> 3);                                                            \
+        VM_STACK_CHECK_POP (nbytes);                                                               \
+        stack->stack_size -= nbytes;                                                               \
+        memcpy (mem + off, stack->stack_data + stack->stack_size, nbytes);                         \
+        VM_DISPATCH();                                                                             \
+    }
+
+#define VM_BINOP_HANDLER(name, expr)                                                               \
+    VM_HANDLER (name) {                                                                            \
+        VM_FETCH_REG_PAIR (rres, r1);                                                              \
+        VM_FETCH_REG (r2);                                                                         \
+        Uint64 a   = regs[r1];                                                                     \
+        Uint64 b   = regs[r2];                                                                     \
+        regs[rres] = (expr);                                                                       \
+        UNUSED (a);                                                                                \
+        UNUSED (b);                                                                                \
+        VM_DISPATCH();                                                                             \
+    }
+
+/* ADD, SUB and MUL update carry (unsigned overflow) and overflow (signed overflow) flags */
+#define VM_FLAGS_BINOP_HANDLER(name, op)                                                           \
+    VM_HANDLER (name) {                                                                            \
+        VM_FETCH_REG_PAIR (rres, r1);                                                              \
+        VM_FETCH_REG (r2);                                                                         \
+        Uint64 a = regs[r1];                                                                       \
+        Uint64 b = regs[r2];                                                                       \
+        Int64  sres;                                                                               \
+        carry    = __builtin_##op##_overflow (a, b, &regs[rres]);                                  \
+        overflow = __builtin_##op##_overflow ((Int64)a, (Int64)b, &sres);                          \
+        VM_DISPATCH();                                                                             \
+    }
+
+/* conditional jumps test a register and select the block to continue from */
+#define VM_JMP_HANDLER(name, cond)                                                                 \
+    VM_HANDLER (name) {                                                                            \
+        VM_FETCH_REG (r);                                                                          \
+        VM_FETCH_ULEB (sel);                                                                       \
+        Uint64 v = regs[r];                                                                        \
+        UNUSED (v);                                                                                \
+        if (cond) {                                                                                \
+            VM_JUMP_TO_BLOCK (sel);                                                                \
+        }                                                                                          \
+        VM_DISPATCH();                                                                             \
+    }
+
+#define VM_PRINT_HANDLER(name, ...)                                                                \
+    VM_HANDLER (name) {                                                                            \
+        VM_FETCH_ULEB (index);                                                                     \
+        VM_CHECK_SEL (index, packed->msg_count, INVALID_INSN);                                     \
+        CString msg = packed->msgs[index] ? packed->msgs[index] : "";                              \
+        __VA_ARGS__;                                                                               \
+        VM_DISPATCH();                                                                             \
+    }
+
+/**
+ * @b Execute given loader. Registers, instruction pointer and stream cursor
+ * live in locals for the whole execution and are synced back to the VM only
+ * when execution leaves this method (calls, exits and errors).
+ *
+ * Checked variant validates every operand at runtime. Unchecked variant is
+ * only used for loaders that passed @c loader_verify.
+ *
+ * @param vm
+ * @param loader Loader to execute. Must already be prepared.
+ * @param mem Memory where loaded object is stored.
+ * @param depth Call depth of this loader.
+ * @param regs_io Registers passed by caller. Callee starts with a copy of
+ *        caller's registers and returns it's @c r0 in caller's @c r0.
+ *
+ * @return @c vm on success.
+ * @return @c Null otherwise.
+ * */
+PRIVATE Vm* VM_EXEC_FN (Vm* vm, Loader* loader, Uint8* mem, Size depth, Uint64* regs_io) {
+    RETURN_VALUE_IF (depth >= VM_MAX_CALL_DEPTH, Null, "XFT VM call depth limit exceeded\n");
+
+    /* frame starts at caller's stack top, stack only grows if it can't hold the frame */
+    XftVmStack* stack = &vm->stack;
+    Size        frame = stack->stack_size;
+
+#if !VM_EXEC_CHECKED
+    RETURN_VALUE_IF (
+        !xft_vm_stack_reserve (stack, loader->max_stack_size),
+        Null,
+        "Failed to grow stack for type loader\n"
+    );
+#endif
+
+    /* everything the dispatch loop touches is kept in locals */
+    Uint64 regs[VM_REG_COUNT];
+    memcpy (regs, regs_io, sizeof (regs));
+
+    IoStream*    io          = vm->stream;
+    const Uint8* stream_data = io->data;
+    Size         stream_size = io->size;
+    Size         cursor      = io->cursor;
+    Size         alloc_size  = loader->alloc_size;
+
+    const StructLayout* layouts      = loader->struct_layouts;
+    Size                layout_count = loader->struct_layout_count;
+
+    const SwitchTable* switch_tables      = loader->switch_tables;
+    Size               switch_table_count = loader->switch_table_count;
+
+    PackedCode*  packed        = &loader->packed_code;
+    const Uint8* code          = packed->code;
+    const Size*  block_offsets = packed->block_offsets;
+    Size         block_count   = packed->block_count;
+    const Uint8* ip            = code;
+    const Uint8* insn          = code; /* start of instruction being executed */
+    Uint8        op            = 0;
+
+    /* flags set by ADD, SUB and MUL, tested by JO and JC */
+    Bool carry    = False;
+    Bool overflow = False;
+
+    VM_PROFILE_BEGIN();
+
+#if VM_USE_COMPUTED_GOTO
+    static const void* dispatch_table[INSN_TYPE_MAX] = {
+        [INSN_TYPE_UNKNOWN]            = &&INVALID_INSN,
+        [INSN_TYPE_SET_REG]            = &&HANDLER_SET_REG,
+        [INSN_TYPE_READ_R8]            = &&HANDLER_READ_R8,
+        [INSN_TYPE_READ_R16]           = &&HANDLER_READ_R16,
+        [INSN_TYPE_READ_R32]           = &&HANDLER_READ_R32,
+        [INSN_TYPE_READ_R64]           = &&HANDLER_READ_R64,
+        [INSN_TYPE_READ_M8]            = &&HANDLER_READ_M8,
+        [INSN_TYPE_READ_M16]           = &&HANDLER_READ_M16,
+        [INSN_TYPE_READ_M32]           = &&HANDLER_READ_M32,
+        [INSN_TYPE_READ_M64]           = &&HANDLER_READ_M64,
+        [INSN_TYPE_PUSH_R8]            = &&HANDLER_PUSH_R8,
+        [INSN_TYPE_PUSH_R16]           = &&HANDLER_PUSH_R16,
+        [INSN_TYPE_PUSH_R32]           = &&HANDLER_PUSH_R32,
+        [INSN_TYPE_PUSH_R64]           = &&HANDLER_PUSH_R64,
+        [INSN_TYPE_PUSH_M8]            = &&HANDLER_PUSH_M8,
+        [INSN_TYPE_PUSH_M16]           = &&HANDLER_PUSH_M16,
+        [INSN_TYPE_PUSH_M32]           = &&HANDLER_PUSH_M32,
+        [INSN_TYPE_PUSH_M64]           = &&HANDLER_PUSH_M64,
+        [INSN_TYPE_POP_R8]             = &&HANDLER_POP_R8,
+        [INSN_TYPE_POP_R16]            = &&HANDLER_POP_R16,
+        [INSN_TYPE_POP_R32]            = &&HANDLER_POP_R32,
+        [INSN_TYPE_POP_R64]            = &&HANDLER_POP_R64,
+        [INSN_TYPE_POP_M8]             = &&HANDLER_POP_M8,
+        [INSN_TYPE_POP_M16]            = &&HANDLER_POP_M16,
+        [INSN_TYPE_POP_M32]            = &&HANDLER_POP_M32,
+        [INSN_TYPE_POP_M64]            = &&HANDLER_POP_M64,
+        [INSN_TYPE_READ_A8]            = &&HANDLER_READ_A8,
+        [INSN_TYPE_READ_A16]           = &&HANDLER_READ_A16,
+        [INSN_TYPE_READ_A32]           = &&HANDLER_READ_A32,
+        [INSN_TYPE_READ_A64]           = &&HANDLER_READ_A64,
+        [INSN_TYPE_PUSH_A8]            = &&HANDLER_PUSH_A8,
+        [INSN_TYPE_PUSH_A16]           = &&HANDLER_PUSH_A16,
+        [INSN_TYPE_PUSH_A32]           = &&HANDLER_PUSH_A32,
+        [INSN_TYPE_PUSH_A64]           = &&HANDLER_PUSH_A64,
+        [INSN_TYPE_POP_A8]             = &&HANDLER_POP_A8,
+        [INSN_TYPE_POP_A16]            = &&HANDLER_POP_A16,
+        [INSN_TYPE_POP_A32]            = &&HANDLER_POP_A32,
+        [INSN_TYPE_POP_A64]            = &&HANDLER_POP_A64,
+        [INSN_TYPE_READ_A16_LE]        = &&HANDLER_READ_A16_LE,
+        [INSN_TYPE_READ_A32_LE]        = &&HANDLER_READ_A32_LE,
+        [INSN_TYPE_READ_A64_LE]        = &&HANDLER_READ_A64_LE,
+        [INSN_TYPE_READ_A16_BE]        = &&HANDLER_READ_A16_BE,
+        [INSN_TYPE_READ_A32_BE]        = &&HANDLER_READ_A32_BE,
+        [INSN_TYPE_READ_A64_BE]        = &&HANDLER_READ_A64_BE,
+        [INSN_TYPE_READ_STRUCT_A]      = &&HANDLER_READ_STRUCT_A,
+        [INSN_TYPE_SEEK_FWD]           = &&HANDLER_SEEK_FWD,
+        [INSN_TYPE_SEEK_BAK]           = &&HANDLER_SEEK_BAK,
+        [INSN_TYPE_SEEK_R]             = &&HANDLER_SEEK_R,
+        [INSN_TYPE_TELL]               = &&HANDLER_TELL,
+        [INSN_TYPE_ADD]                = &&HANDLER_ADD,
+        [INSN_TYPE_SUB]                = &&HANDLER_SUB,
+        [INSN_TYPE_MUL]                = &&HANDLER_MUL,
+        [INSN_TYPE_DIV]                = &&HANDLER_DIV,
+        [INSN_TYPE_MOD]                = &&HANDLER_MOD,
+        [INSN_TYPE_POW]                = &&HANDLER_POW,
+        [INSN_TYPE_SQRT]               = &&HANDLER_SQRT,
+        [INSN_TYPE_ABS]                = &&HANDLER_ABS,
+        [INSN_TYPE_AND]                = &&HANDLER_AND,
+        [INSN_TYPE_OR]                 = &&HANDLER_OR,
+        [INSN_TYPE_XOR]                = &&HANDLER_XOR,
+        [INSN_TYPE_NAND]               = &&HANDLER_NAND,
+        [INSN_TYPE_NOR]                = &&HANDLER_NOR,
+        [INSN_TYPE_XNOR]               = &&HANDLER_XNOR,
+        [INSN_TYPE_NOT]                = &&HANDLER_NOT,
+        [INSN_TYPE_LSHIFT]             = &&HANDLER_LSHIFT,
+        [INSN_TYPE_RSHIFT]             = &&HANDLER_RSHIFT,
+        [INSN_TYPE_ROL]                = &&HANDLER_ROL,
+        [INSN_TYPE_ROR]                = &&HANDLER_ROR,
+        [INSN_TYPE_CMPEQ]              = &&HANDLER_CMPEQ,
+        [INSN_TYPE_CMPLE]              = &&HANDLER_CMPLE,
+        [INSN_TYPE_CMPLT]              = &&HANDLER_CMPLT,
+        [INSN_TYPE_CMPGE]              = &&HANDLER_CMPGE,
+        [INSN_TYPE_CMPGT]              = &&HANDLER_CMPGT,
+        [INSN_TYPE_JA]                 = &&HANDLER_JA,
+        [INSN_TYPE_JB]                 = &&HANDLER_JB,
+        [INSN_TYPE_JZ]                 = &&HANDLER_JZ,
+        [INSN_TYPE_JO]                 = &&HANDLER_JO,
+        [INSN_TYPE_JC]                 = &&HANDLER_JC,
+        [INSN_TYPE_CALL_TYPE_LOADER]   = &&HANDLER_CALL_TYPE_LOADER,
+        [INSN_TYPE_CALL_TYPE_LOADER_A] = &&HANDLER_CALL_TYPE_LOADER_A,
+        [INSN_TYPE_CALL_TYPE_LOADER_V] = &&HANDLER_CALL_TYPE_LOADER_V,
+        [INSN_TYPE_PINFO]              = &&HANDLER_PINFO,
+        [INSN_TYPE_PDBG]               = &&HANDLER_PDBG,
+        [INSN_TYPE_PERR]               = &&HANDLER_PERR,
+        [INSN_TYPE_EXIT_SUCCESS]       = &&HANDLER_EXIT_SUCCESS,
+        [INSN_TYPE_EXIT_FAILURE]       = &&HANDLER_EXIT_FAILURE,
+        [INSN_TYPE_READ_STRUCT]        = &&HANDLER_READ_STRUCT,
+        [INSN_TYPE_JCMP]               = &&HANDLER_JCMP,
+        [INSN_TYPE_SWITCH]             = &&HANDLER_SWITCH,
+        [INSN_TYPE_CHECK]              = &&HANDLER_CHECK,
+    };
+#endif
+
+    VM_DISPATCH_BEGIN()
+
+    VM_HANDLER (SET_REG) {
+        VM_FETCH_REG (r);
+        VM_FETCH_ULEB (imm);
+        regs[r] = imm;
+        VM_DISPATCH();
+    }
+
+    VM_READ_REG_HANDLER (8)
+    VM_READ_REG_HANDLER (16)
+    VM_READ_REG_HANDLER (32)
+    VM_READ_REG_HANDLER (64)
+
+    VM_READ_MEM_HANDLER (8)
+    VM_READ_MEM_HANDLER (16)
+    VM_READ_MEM_HANDLER (32)
+    VM_READ_MEM_HANDLER (64)
+
+    VM_PUSH_REG_HANDLER (8)
+    VM_PUSH_REG_HANDLER (16)
+    VM_PUSH_REG_HANDLER (32)
+    VM_PUSH_REG_HANDLER (64)
+
+    VM_PUSH_MEM_HANDLER (8)
+    VM_PUSH_MEM_HANDLER (16)
+    VM_PUSH_MEM_HANDLER (32)
+    VM_PUSH_MEM_HANDLER (64)
+
+    VM_POP_REG_HANDLER (8)
+    VM_POP_REG_HANDLER (16)
+    VM_POP_REG_HANDLER (32)
+    VM_POP_REG_HANDLER (64)
+
+    VM_POP_MEM_HANDLER (8)
+    VM_POP_MEM_HANDLER (16)
+    VM_POP_MEM_HANDLER (32)
+    VM_POP_MEM_HANDLER (64)
+
+    VM_READ_ARR_HANDLER (8)
+    VM_READ_ARR_HANDLER (16)
+    VM_READ_ARR_HANDLER (32)
+    VM_READ_ARR_HANDLER (64)
+
+    VM_PUSH_ARR_HANDLER (8)
+    VM_PUSH_ARR_HANDLER (16)
+    VM_PUSH_ARR_HANDLER (32)
+    VM_PUSH_ARR_HANDLER (64)
+
+    VM_POP_ARR_HANDLER (8)
+    VM_POP_ARR_HANDLER (16)
+    VM_POP_ARR_HANDLER (32)
+    VM_POP_ARR_HANDLER (64)
+
+    VM_READ_ARR_ORDER_HANDLER (16, LE, HOST_BYTE_ORDER_IS_MSB)
+    VM_READ_ARR_ORDER_HANDLER (32, LE, HOST_BYTE_ORDER_IS_MSB)
+    VM_READ_ARR_ORDER_HANDLER (64, LE, HOST_BYTE_ORDER_IS_MSB)
+    VM_READ_ARR_ORDER_HANDLER (16, BE, HOST_BYTE_ORDER_IS_LSB)
+    VM_READ_ARR_ORDER_HANDLER (32, BE, HOST_BYTE_ORDER_IS_LSB)
+    VM_READ_ARR_ORDER_HANDLER (64, BE, HOST_BYTE_ORDER_IS_LSB)
+
+    /* all records are checked once, and a table of dense records is copied with a single memcpy */
+    VM_HANDLER (READ_STRUCT_A) {
+        VM_FETCH_ULEB (off);
+        VM_FETCH_ULEB (id);
+        VM_FETCH_ULEB (count);
+        VM_FETCH_ULEB (stride);
+        VM_CHECK_SEL (id, layout_count, INVALID_INSN);
+
+        const StructLayout* layout = layouts + id;
+        if (VM_UNLIKELY (!count)) {
+            VM_DISPATCH();
+        }
+
+        Size table_size = 0;
+        Size last_off   = 0;
+#if VM_EXEC_CHECKED
+        if (VM_UNLIKELY (__builtin_mul_overflow (count - 1, stride, &last_off))) {
+            goto MEMORY_OUT_OF_BOUNDS;
+        }
+        VM_CHECK_MEM (off, layout->mem_size);
+        VM_CHECK_MEM (off + layout->mem_size, last_off);
+        if (VM_UNLIKELY (__builtin_mul_overflow (count, layout->stream_size, &table_size))) {
+            goto STREAM_UNDERFLOW;
+        }
+#else
+        /* verifier made sure none of these overflow */
+        last_off   = (count - 1) * stride;
+        table_size = count * layout->stream_size;
+#endif
+        VM_CHECK_STREAM (table_size);
+        UNUSED (last_off);
+
+        if (layout->is_dense && !layout->needs_swap && stride == layout->stream_size) {
+            memcpy (mem + off, stream_data + cursor, table_size);
+        } else {
+            Uint8*       dst = mem + off;
+            const Uint8* src = stream_data + cursor;
+            for (Size r = 0; r < count; r++, dst += stride, src += layout->stream_size) {
+                vm_read_struct (dst, src, layout);
+            }
+        }
+
+        cursor += table_size;
+        VM_DISPATCH();
+    }
+
+    /* bounds checked without VM_CHECK_STREAM, skipped bytes are not read */
+    VM_HANDLER (SEEK_FWD) {
+        VM_FETCH_ULEB (nbytes);
+        if (VM_UNLIKELY (nbytes > stream_size - cursor)) {
+            goto STREAM_UNDERFLOW;
+        }
+        cursor += nbytes;
+        VM_DISPATCH();
+    }
+
+    VM_HANDLER (SEEK_BAK) {
+        VM_FETCH_ULEB (nbytes);
+        if (VM_UNLIKELY (nbytes > cursor)) {
+            goto STREAM_UNDERFLOW;
+        }
+        cursor -= nbytes;
+        VM_DISPATCH();
+    }
+
+    /* seeking to end of stream is allowed, next read will fail instead */
+    VM_HANDLER (SEEK_R) {
+        VM_FETCH_REG (r);
+        if (VM_UNLIKELY (regs[r] > stream_size)) {
+            goto STREAM_UNDERFLOW;
+        }
+        cursor = regs[r];
+        VM_DISPATCH();
+    }
+
+    VM_HANDLER (TELL) {
+        VM_FETCH_REG (r);
+        regs[r] = cursor;
+        VM_DISPATCH();
+    }
+
+    VM_FLAGS_BINOP_HANDLER (ADD, add)
+    VM_FLAGS_BINOP_HANDLER (SUB, sub)
+    VM_FLAGS_BINOP_HANDLER (MUL, mul)
+
+    VM_HANDLER (DIV) {
+        VM_FETCH_REG_PAIR (rres, r1);
+        VM_FETCH_REG (r2);
+        if (VM_UNLIKELY (!regs[r2])) {
+            goto DIVIDE_BY_ZERO;
+        }
+        regs[rres] = regs[r1] / regs[r2];
+        VM_DISPATCH();
+    }
+
+    VM_HANDLER (MOD) {
+        VM_FETCH_REG_PAIR (rres, r1);
+        VM_FETCH_REG (r2);
+        if (VM_UNLIKELY (!regs[r2])) {
+            goto DIVIDE_BY_ZERO;
+        }
+        regs[rres] = regs[r1] % regs[r2];
+        VM_DISPATCH();
+    }
+
+    /* integer power by squaring, wraps around on overflow */
+    VM_HANDLER (POW) {
+        VM_FETCH_REG_PAIR (rres, r1);
+        VM_FETCH_REG (r2);
+        Uint64 base = regs[r1];
+        Uint64 exp  = regs[r2];
+        Uint64 res  = 1;
+        while (exp) {
+            if (exp & 1) {
+                res *= base;
+            }
+            base  *= base;
+            exp  >>= 1;
+        }
+        regs[rres] = res;
+        VM_DISPATCH();
+    }
+
+    /* integer square root, rounded down */
+    VM_HANDLER (SQRT) {
+        VM_FETCH_REG_PAIR (rres, r1);
+        Uint64 x   = regs[r1];
+        Uint64 res = 0;
+        for (Uint64 bit = (Uint64)1 << 62; bit; bit >>= 2) {
+            if (x >= res + bit) {
+                x   -= res + bit;
+                res  = (res >> 1) + bit;
+            } else {
+                res >>= 1;
+            }
+        }
+        regs[rres] = res;
+        VM_DISPATCH();
+    }
+
+    VM_HANDLER (ABS) {
+        VM_FETCH_REG_PAIR (rres, r1);
+        Int64 x    = (Int64)regs[r1];
+        regs[rres] = x < 0 ? -(Uint64)x : (Uint64)x;
+        VM_DISPATCH();
+    }
+
+    VM_BINOP_HANDLER (AND, a & b)
+    VM_BINOP_HANDLER (OR, a | b)
+    VM_BINOP_HANDLER (XOR, a ^ b)
+    VM_BINOP_HANDLER (NAND, ~(a & b))
+    VM_BINOP_HANDLER (NOR, ~(a | b))
+    VM_BINOP_HANDLER (XNOR, ~(a ^ b))
+
+    VM_HANDLER (NOT) {
+        VM_FETCH_REG_PAIR (rres, r1);
+        regs[rres] = ~regs[r1];
+        VM_DISPATCH();
+    }
+
+    /* shifting by 64 or more clears the register instead of being undefined */
+    VM_BINOP_HANDLER (LSHIFT, b < 64 ? a << b : 0)
+    VM_BINOP_HANDLER (RSHIFT, b < 64 ? a >> b : 0)
+    VM_BINOP_HANDLER (ROL, (a << (b & 63)) | (a >> ((64 - (b & 63)) & 63)))
+    VM_BINOP_HANDLER (ROR, (a >> (b & 63)) | (a << ((64 - (b & 63)) & 63)))
+
+    /* comparisons are unsigned and store 1 if true, 0 otherwise */
+    VM_BINOP_HANDLER (CMPEQ, a == b)
+    VM_BINOP_HANDLER (CMPLE, a <= b)
+    VM_BINOP_HANDLER (CMPLT, a < b)
+    VM_BINOP_HANDLER (CMPGE, a >= b)
+    VM_BINOP_HANDLER (CMPGT, a > b)
+
+    /* above and below treat register as signed, overflow and carry test flags */
+    VM_JMP_HANDLER (JA, (Int64)v > 0)
+    VM_JMP_HANDLER (JB, (Int64)v < 0)
+    VM_JMP_HANDLER (JZ, !v)
+    VM_JMP_HANDLER (JO, overflow)
+    VM_JMP_HANDLER (JC, carry)
+
+    /* callee loads into caller's memory at offset in r0, and returns it's r0 in r0 */
+    VM_HANDLER (CALL_TYPE_LOADER) {
+        VM_FETCH_ULEB (sel);
+        VM_CHECK_SEL (sel, loader->loader_ref_count, INVALID_CALL);
+
+        Loader* callee = loader->loader_refs[sel];
+#if VM_EXEC_CHECKED
+        if (VM_UNLIKELY (!callee)) {
+            goto INVALID_CALL;
+        }
+#endif
+        VM_CHECK_MEM_ALWAYS (regs[0], callee->alloc_size);
+        if (VM_UNLIKELY (!vm_prepare_loader (callee))) {
+            goto INVALID_CALL;
+        }
+
+        Uint8* obj = mem + regs[0];
+        io->cursor = cursor;
+        if (VM_UNLIKELY (!vm_exec_loader (vm, callee, obj, depth + 1, regs))) {
+            /* callee has already reported the error and synced VM state */
+            VM_PROFILE_END();
+            return Null;
+        }
+
+        cursor = io->cursor;
+        if (VM_UNLIKELY (!vm_check_objects (vm, callee, obj, 1, callee->alloc_size))) {
+            goto EXEC_FAILED;
+        }
+        VM_DISPATCH();
+    }
+
+    /* element i is loaded at offset r0 + i * stride, caller's registers are left as they are */
+    VM_HANDLER (CALL_TYPE_LOADER_A) {
+        VM_FETCH_ULEB (sel);
+        VM_FETCH_REG (rcount);
+        VM_FETCH_ULEB (stride);
+        VM_CHECK_SEL (sel, loader->loader_ref_count, INVALID_CALL);
+
+        Loader* callee = loader->loader_refs[sel];
+#if VM_EXEC_CHECKED
+        if (VM_UNLIKELY (!callee)) {
+            goto INVALID_CALL;
+        }
+#endif
+        Uint64 count = regs[rcount];
+        if (VM_UNLIKELY (!count)) {
+            VM_DISPATCH();
+        }
+
+        Size last_off = 0;
+        if (VM_UNLIKELY (__builtin_mul_overflow (count - 1, stride, &last_off))) {
+            goto MEMORY_OUT_OF_BOUNDS;
+        }
+        VM_CHECK_MEM_ALWAYS (regs[0], last_off);
+        VM_CHECK_MEM_ALWAYS (regs[0] + last_off, callee->alloc_size);
+        if (VM_UNLIKELY (!vm_prepare_loader (callee))) {
+            goto INVALID_CALL;
+        }
+
+        io->cursor = cursor;
+        if (VM_UNLIKELY (!vm_exec_loader_array (vm, callee, mem, count, stride, depth + 1, regs))) {
+            VM_PROFILE_END();
+            return Null;
+        }
+
+        cursor = io->cursor;
+        VM_DISPATCH();
+    }
+
+    /* elements are loaded into memory allocated by VM, described by a VmVector at mem_off */
+    VM_HANDLER (CALL_TYPE_LOADER_V) {
+        VM_FETCH_ULEB (sel);
+        VM_FETCH_REG (rcount);
+        VM_FETCH_ULEB (off);
+        VM_CHECK_SEL (sel, loader->loader_ref_count, INVALID_CALL);
+        VM_CHECK_MEM (off, sizeof (VmVector));
+
+        Loader* callee = loader->loader_refs[sel];
+#if VM_EXEC_CHECKED
+        if (VM_UNLIKELY (!callee)) {
+            goto INVALID_CALL;
+        }
+#endif
+        if (VM_UNLIKELY (!vm_prepare_loader (callee))) {
+            goto INVALID_CALL;
+        }
+
+        VmVector vec    = {.data = Null, .count = regs[rcount]};
+        Size     nbytes = 0;
+        if (VM_UNLIKELY (__builtin_mul_overflow (vec.count, callee->alloc_size, &nbytes))) {
+            goto MEMORY_OUT_OF_BOUNDS;
+        }
+
+        /* don't trust a corrupt count to allocate more elements than stream can fill */
+        if (VM_UNLIKELY (
+                vm_loader_is_fixed (callee) && callee->fixed_stream_size &&
+                vec.count > (stream_size - cursor) / callee->fixed_stream_size
+            )) {
+            goto STREAM_UNDERFLOW;
+        }
+
+        if (vec.count) {
+            vec.data = vm_alloc_vector (vm, nbytes);
+            if (VM_UNLIKELY (!vec.data)) {
+                goto ALLOCATION_FAILED;
+            }
+
+            Uint64 elem_regs[VM_REG_COUNT];
+            memcpy (elem_regs, regs, sizeof (elem_regs));
+            elem_regs[0] = 0;
+
+            io->cursor = cursor;
+            if (VM_UNLIKELY (!vm_exec_loader_array (
+                    vm,
+                    callee,
+                    vec.data,
+                    vec.count,
+                    callee->alloc_size,
+                    depth + 1,
+                    elem_regs
+                ))) {
+                VM_PROFILE_END();
+                return Null;
+            }
+            cursor = io->cursor;
+        }
+
+        memcpy (mem + off, &vec, sizeof (vec));
+        VM_DISPATCH();
+    }
+
+    VM_PRINT_HANDLER (PINFO, printf ("[XFT VM INFO] %s\n", msg))
+    VM_PRINT_HANDLER (PDBG, printf ("[XFT VM DEBUG] %s\n", msg))
+    VM_PRINT_HANDLER (PERR, PRINT_ERR ("[XFT VM ERROR] %s\n", msg))
+
+    VM_HANDLER (EXIT_SUCCESS) {
+        goto LOADER_DONE;
+    }
+
+    VM_HANDLER (EXIT_FAILURE) {
+        PRINT_ERR ("XFT VM type loader \"%s\" exited with failure\n", loader->type_name);
+        goto EXEC_FAILED;
+    }
+
+    /* whole run of reads is checked once, and copied with a single memcpy when possible */
+    VM_HANDLER (READ_STRUCT) {
+        VM_FETCH_ULEB (off);
+        VM_FETCH_ULEB (id);
+        VM_CHECK_SEL (id, layout_count, INVALID_INSN);
+
+        const StructLayout* layout = layouts + id;
+        VM_CHECK_MEM (off, layout->mem_size);
+        VM_CHECK_STREAM (layout->stream_size);
+
+        vm_read_struct (mem + off, stream_data + cursor, layout);
+        cursor += layout->stream_size;
+        VM_DISPATCH();
+    }
+
+    /* writes both registers of folded setr and cmpxx before deciding the jump */
+    VM_HANDLER (JCMP) {
+        Uint8 cond = *ip++;
+        VM_FETCH_REG_PAIR (rres, r1);
+        VM_FETCH_REG (rimm);
+        VM_FETCH_ULEB (imm);
+        VM_FETCH_ULEB (sel);
+
+        Uint64 a = regs[r1];
+        Bool   res;
+        switch (cond & ~PACKED_JCMP_JUMP_IF) {
+            case INSN_TYPE_CMPEQ - INSN_TYPE_CMPEQ :
+                res = a == imm;
+                break;
+            case INSN_TYPE_CMPLE - INSN_TYPE_CMPEQ :
+                res = a <= imm;
+                break;
+            case INSN_TYPE_CMPLT - INSN_TYPE_CMPEQ :
+                res = a < imm;
+                break;
+            case INSN_TYPE_CMPGE - INSN_TYPE_CMPEQ :
+                res = a >= imm;
+                break;
+            case INSN_TYPE_CMPGT - INSN_TYPE_CMPEQ :
+                res = a > imm;
+                break;
+            default :
+                goto INVALID_INSN;
+        }
+
+        regs[rimm] = imm;
+        regs[rres] = res;
+        if (res == !!(cond & PACKED_JCMP_JUMP_IF)) {
+            VM_JUMP_TO_BLOCK (sel);
+        }
+        VM_DISPATCH();
+    }
+
+    /* direct index into dense tables, binary search over sorted case ranges otherwise */
+    VM_HANDLER (SWITCH) {
+        VM_FETCH_REG (r);
+        VM_FETCH_ULEB (id);
+        VM_CHECK_SEL (id, switch_table_count, INVALID_INSN);
+
+        Size sel = switch_table_find (switch_tables + id, regs[r]);
+        if (sel != SWITCH_NO_BLOCK) {
+            VM_JUMP_TO_BLOCK (sel);
+        }
+        VM_DISPATCH();
+    }
+
+    /* object being loaded is counted here, whether it's assertions are checked or not */
+    VM_HANDLER (CHECK) {
+        VM_FETCH_ULEB (sel);
+        Size first = 0;
+        if (!vm_validate (vm, 1, &first)) {
+            VM_JUMP_TO_BLOCK (sel);
+        }
+        VM_DISPATCH();
+    }
+
+    VM_DISPATCH_END()
+
+LOADER_DONE:
+    VM_PROFILE_END();
+
+    /* discard whatever loader left on it's frame */
+    stack->stack_size = frame;
+    io->cursor        = cursor;
+    memcpy (regs_io, regs, sizeof (Uint64));
+    if (!depth) {
+        memcpy (vm->regs, regs, sizeof (regs));
+        vm->pc     = ip - code;
+        vm->loader = loader;
+    }
+    return vm;
+
+    /* not all errors can occur in unchecked variant */
+INVALID_INSN:
+    __attribute__ ((unused));
+    PRINT_ERR ("XFT VM encountered invalid instruction\n");
+    goto EXEC_FAILED;
+
+INVALID_REGISTER:
+    __attribute__ ((unused));
+    PRINT_ERR ("XFT VM instruction refers to invalid register\n");
+    goto EXEC_FAILED;
+
+INVALID_JUMP:
+    __attribute__ ((unused));
+    PRINT_ERR ("XFT VM jump to invalid block\n");
+    goto EXEC_FAILED;
+
+INVALID_CALL:
+    __attribute__ ((unused));
+    PRINT_ERR ("XFT VM call to invalid type loader\n");
+    goto EXEC_FAILED;
+
+MEMORY_OUT_OF_BOUNDS:
+    __attribute__ ((unused));
+    PRINT_ERR ("XFT VM memory access out of bounds of loaded object\n");
+    goto EXEC_FAILED;
+
+STREAM_UNDERFLOW:
+    __attribute__ ((unused));
+    PRINT_ERR ("XFT VM not enough data left in data stream\n");
+    goto EXEC_FAILED;
+
+STACK_ERROR:
+    __attribute__ ((unused));
+    PRINT_ERR ("XFT VM stack underflow or allocation failure\n");
+    goto EXEC_FAILED;
+
+DIVIDE_BY_ZERO:
+    __attribute__ ((unused));
+    PRINT_ERR ("XFT VM division by zero\n");
+    goto EXEC_FAILED;
+
+ALLOCATION_FAILED:
+    __attribute__ ((unused));
+    PRINT_ERR ("XFT VM failed to allocate memory for vector elements\n");
+    goto EXEC_FAILED;
+
+EXEC_FAILED: {
+    VM_PROFILE_END();
+
+    /* keep VM state at failure point for inspection, pc is offset of failing insn in it's block */
+    Size offset = insn - code;
+    Size block  = 0;
+    while (block + 1 < block_count && block_offsets[block + 1] <= offset) {
+        block++;
+    }
+
+    io->cursor = cursor;
+    memcpy (vm->regs, regs, sizeof (regs));
+    vm->frame  = frame;
+    vm->block  = block;
+    vm->pc     = block_count ? offset - block_offsets[block] : offset;
+    vm->loader = loader;
+    PRINT_ERR (
+        "XFT VM failed in type loader \"%s\" (block = %zu, pc = %zu)\n",
+        loader->type_name ? loader->type_name : "<unnamed>",
+        block,
+        (Size)vm->pc
+    );
+    UNUSED (op);
+    return Null;
+}
+}
+
+#undef VM_CHECK_MEM_ALWAYS
+#undef VM_CHECK_REG
+#undef VM_CHECK_SEL
+#undef VM_CHECK_OPCODE
+#undef VM_STACK_PUSH
+#undef VM_STACK_POP
+#undef VM_STACK_RESERVE
+#undef VM_STACK_CHECK_POP
+#undef VM_FETCH_REG
+#undef VM_FETCH_REG_PAIR
+#undef VM_FETCH_ULEB
+#undef VM_CHECK_MEM
+#undef VM_CHECK_STREAM
+#undef VM_CHECK_ARR
+#undef VM_PROFILE_BEGIN
+#undef VM_PROFILE_ENTER_BLOCK
+#undef VM_PROFILE_INSN
+#undef VM_PROFILE_JUMP
+#undef VM_PROFILE_BYTES
+#undef VM_PROFILE_END
+#undef VM_JUMP_TO_BLOCK
+#undef VM_HANDLER
+#undef VM_DISPATCH
+#undef VM_DISPATCH_BEGIN
+#undef VM_DISPATCH_END
+#undef VM_READ_REG_HANDLER
+#undef VM_READ_MEM_HANDLER
+#undef VM_READ_ARR_HANDLER
+#undef VM_READ_ARR_ORDER_HANDLER
+#undef VM_PUSH_REG_HANDLER
+#undef VM_POP_REG_HANDLER
+#undef VM_PUSH_MEM_HANDLER
+#undef VM_POP_MEM_HANDLER
+#undef VM_PUSH_ARR_HANDLER
+#undef VM_POP_ARR_HANDLER
+#undef VM_BINOP_HANDLER
+#undef VM_FLAGS_BINOP_HANDLER
+#undef VM_JMP_HANDLER
+#undef VM_PRINT_HANDLER
+
+#undef VM_EXEC_FN
+#undef VM_EXEC_CHECKED
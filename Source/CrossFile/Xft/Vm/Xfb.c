@@ -0,0 +1,962 @@
+/**
+ * @file Xfb.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <errno.h>
+#include <fcntl.h>
+#include <memory.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* local includes */
+#include "Jit.h"
+#include "Loader.h"
+#include "Packed.h"
+#include "Peephole.h"
+#include "Verify.h"
+#include "Xfb.h"
+
+#define ALIGN_SECTION(x) (((x) + XFB_SECTION_ALIGNMENT - 1) & ~(Size)(XFB_SECTION_ALIGNMENT - 1))
+
+/**
+ * @b Growable buffer holding contents of a single section while writing.
+ * */
+typedef struct XfbBuf {
+    Uint8* data;
+    Size   size;
+    Size   capacity;
+} XfbBuf;
+
+/* sections in the order they're laid out in file */
+typedef enum XfbSectionId {
+    XFB_SECTION_LOADERS = 0,
+    XFB_SECTION_LOADER_REFS,
+    XFB_SECTION_BLOCK_OFFSETS,
+    XFB_SECTION_CODE,
+    XFB_SECTION_STRUCT_LAYOUTS,
+    XFB_SECTION_LAYOUT_FIELDS,
+    XFB_SECTION_SWITCH_TABLES,
+    XFB_SECTION_SWITCH_CASES,
+    XFB_SECTION_SWITCH_DENSE,
+    XFB_SECTION_CHECK_TERMS,
+    XFB_SECTION_MSGS,
+    XFB_SECTION_STRINGS,
+    XFB_SECTION_MAX
+} XfbSectionId;
+
+static const Size xfb_section_elem_size[XFB_SECTION_MAX] = {
+    [XFB_SECTION_LOADERS]        = sizeof (XfbLoader),
+    [XFB_SECTION_LOADER_REFS]    = sizeof (Uint64),
+    [XFB_SECTION_BLOCK_OFFSETS]  = sizeof (Uint64),
+    [XFB_SECTION_CODE]           = sizeof (Uint8),
+    [XFB_SECTION_STRUCT_LAYOUTS] = sizeof (XfbStructLayout),
+    [XFB_SECTION_LAYOUT_FIELDS]  = sizeof (StructLayoutField),
+    [XFB_SECTION_SWITCH_TABLES]  = sizeof (XfbSwitchTable),
+    [XFB_SECTION_SWITCH_CASES]   = sizeof (SwitchCase),
+    [XFB_SECTION_SWITCH_DENSE]   = sizeof (Size),
+    [XFB_SECTION_CHECK_TERMS]    = sizeof (XfbCheckTerm),
+    [XFB_SECTION_MSGS]           = sizeof (Uint64),
+    [XFB_SECTION_STRINGS]        = sizeof (Char),
+};
+
+/* private method declarations */
+
+static inline XfbBuf* xfb_buf_append (XfbBuf* buf, const void* data, Size nb);
+static inline XfbBuf* xfb_buf_add_u64 (XfbBuf* buf, Uint64 val);
+static inline XfbBuf* xfb_buf_add_string (XfbBuf* strings, CString str, Uint64* offset);
+static inline Loader* xfb_loader_prepare (Loader* loader);
+static inline Bool    xfb_loader_serialize (
+    Loader*    loader,
+    Loader**   loaders,
+    Size       loader_count,
+    XfbBuf*    sections,
+    XfbLoader* xloader
+);
+static inline Uint64   xfb_checksum (const Uint8* data, Size size);
+static inline Bool     xfb_section_is_valid (XfbFile* xfb, const XfbSection* section, Size esize);
+static inline Bool     xfb_range_is_valid (const XfbRange* range, Uint64 count);
+static inline CString  xfb_get_string (XfbFile* xfb, Uint64 offset);
+static inline XfbFile* xfb_init (XfbFile* xfb);
+static inline XfbFile* xfb_init_loaders (XfbFile* xfb);
+
+/**************************************************************************************************/
+/*********************************** PUBLIC METHOD DEFINITIONS ************************************/
+/**************************************************************************************************/
+
+/**
+ * @b Write given set of type loaders to an xfb file.
+ *
+ * Loaders that were never executed are optimized and encoded to their
+ * packed form first. All loaders referred to by a loader in the set must
+ * also be part of the set.
+ *
+ * File is first written to a temporary path and then renamed, so that other
+ * processes never see a partially written file.
+ *
+ * @param loaders Array of loaders to be written. Order is preserved in type table.
+ * @param loader_count Number of loaders.
+ * @param file_loader Loader of file declaration, one of @c loaders, or @c Null if none.
+ * @param xfb_path Path of xfb file to be created.
+ *
+ * @return @c loaders on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader** xfb_write (
+    Loader** loaders,
+    Size     loader_count,
+    Loader*  file_loader,
+    CString  xfb_path
+) {
+    RETURN_VALUE_IF (!loaders || !xfb_path, Null, ERR_INVALID_ARGUMENTS);
+
+    Uint64 file_index = XFB_NO_LOADER;
+    for (Size l = 0; file_loader && l < loader_count; l++) {
+        if (loaders[l] == file_loader) {
+            file_index = l;
+            break;
+        }
+    }
+    RETURN_VALUE_IF (
+        file_loader && file_index == XFB_NO_LOADER,
+        Null,
+        "File loader is not one of loaders being written\n"
+    );
+
+    XfbBuf sections[XFB_SECTION_MAX] = {0};
+    Uint8* image                     = Null;
+    FILE*  file                      = Null;
+    Char*  tmp_path                  = Null;
+
+    for (Size l = 0; l < loader_count; l++) {
+        XfbLoader xloader = {0};
+        GOTO_HANDLER_IF (
+            !loaders[l] || !xfb_loader_prepare (loaders[l]) ||
+                !xfb_loader_serialize (loaders[l], loaders, loader_count, sections, &xloader) ||
+                !xfb_buf_append (sections + XFB_SECTION_LOADERS, &xloader, sizeof (XfbLoader)),
+            WRITE_FAILED,
+            "Failed to serialize type loader %zu\n",
+            l
+        );
+    }
+
+    XfbHeader header = {
+        .magic           = XFB_MAGIC,
+        .version         = XFB_VERSION,
+        .header_size     = sizeof (XfbHeader),
+        .byte_order_mark = XFB_BYTE_ORDER_MARK,
+        .size_width      = sizeof (Size),
+        .file_loader     = file_index,
+    };
+
+    /* section descriptors are in same order as section ids */
+    XfbSection* header_sections = &header.loaders;
+
+    Size offset = ALIGN_SECTION (sizeof (XfbHeader));
+    for (Size s = 0; s < XFB_SECTION_MAX; s++) {
+        header_sections[s].offset  = offset;
+        header_sections[s].count   = sections[s].size / xfb_section_elem_size[s];
+        offset                    += ALIGN_SECTION (sections[s].size);
+    }
+    header.file_size = offset;
+
+    /* whole file is built in memory to compute checksum before writing */
+    GOTO_HANDLER_IF (
+        !(image = ALLOCATE (Uint8, header.file_size)),
+        WRITE_FAILED,
+        ERR_OUT_OF_MEMORY
+    );
+    for (Size s = 0; s < XFB_SECTION_MAX; s++) {
+        if (sections[s].size) {
+            memcpy (image + header_sections[s].offset, sections[s].data, sections[s].size);
+        }
+    }
+    memcpy (image, &header, sizeof (XfbHeader));
+
+    header.checksum = xfb_checksum (image, header.file_size);
+    memcpy (image, &header, sizeof (XfbHeader));
+
+    /* write everything to a temporary file and then move it in place */
+    Size tmp_path_size = strlen (xfb_path) + 32;
+    GOTO_HANDLER_IF (!(tmp_path = ALLOCATE (Char, tmp_path_size)), WRITE_FAILED, ERR_OUT_OF_MEMORY);
+    snprintf (tmp_path, tmp_path_size, "%s.%d.tmp", xfb_path, (int)getpid());
+
+    GOTO_HANDLER_IF (
+        !(file = fopen (tmp_path, "wb")),
+        WRITE_FAILED,
+        "Failed to create xfb file : %s\n",
+        strerror (errno)
+    );
+
+    GOTO_HANDLER_IF (
+        fwrite (image, 1, header.file_size, file) != header.file_size,
+        WRITE_FAILED,
+        "Failed to write xfb file : %s\n",
+        strerror (errno)
+    );
+
+    /* stream is gone even if close fails, so handler must not close it again */
+    int closed = fclose (file);
+    file       = Null;
+    GOTO_HANDLER_IF (
+        closed != 0,
+        WRITE_FAILED,
+        "Failed to flush xfb file : %s\n",
+        strerror (errno)
+    );
+
+    GOTO_HANDLER_IF (
+        rename (tmp_path, xfb_path) != 0,
+        WRITE_FAILED,
+        "Failed to move xfb file in place : %s\n",
+        strerror (errno)
+    );
+
+    FREE (tmp_path);
+    FREE (image);
+    for (Size s = 0; s < XFB_SECTION_MAX; s++) {
+        if (sections[s].data) {
+            FREE (sections[s].data);
+        }
+    }
+
+    return loaders;
+
+WRITE_FAILED:
+    if (file) {
+        fclose (file);
+    }
+
+    if (tmp_path) {
+        unlink (tmp_path);
+        FREE (tmp_path);
+    }
+
+    if (image) {
+        FREE (image);
+    }
+
+    for (Size s = 0; s < XFB_SECTION_MAX; s++) {
+        if (sections[s].data) {
+            FREE (sections[s].data);
+        }
+    }
+
+    return Null;
+}
+
+/**
+ * @b Map an xfb file in memory and create type loaders that execute from it.
+ *
+ * File is rejected if it's written by a different version, on a host with different
+ * byte order or size width, if checksum does not match, or if any index or range
+ * stored in it is out of bounds.
+ *
+ * @param xfb Handle to be initialized.
+ * @param xfb_path Path of xfb file.
+ *
+ * @return @c xfb on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC XfbFile* xfb_open (XfbFile* xfb, CString xfb_path) {
+    RETURN_VALUE_IF (!xfb || !xfb_path, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (xfb, 0, sizeof (XfbFile));
+
+    int fd = open (xfb_path, O_RDONLY);
+    RETURN_VALUE_IF (fd < 0, Null, "Failed to open xfb file : %s\n", strerror (errno));
+
+    struct stat xfb_stat;
+    if (fstat (fd, &xfb_stat) != 0 || (Size)xfb_stat.st_size < sizeof (XfbHeader)) {
+        PRINT_ERR ("Xfb file is invalid or too small\n");
+        close (fd);
+        return Null;
+    }
+
+    xfb->size = xfb_stat.st_size;
+    xfb->data = mmap (Null, xfb->size, PROT_READ, MAP_SHARED, fd, 0);
+    close (fd);
+
+    if (xfb->data == MAP_FAILED) {
+        PRINT_ERR ("Failed to map xfb file : %s\n", strerror (errno));
+        xfb->data = Null;
+        return Null;
+    }
+
+    xfb->is_mapped = True;
+
+    if (!xfb_init (xfb)) {
+        xfb_close (xfb);
+        return Null;
+    }
+
+    return xfb;
+}
+
+/**
+ * @b Create type loaders that execute from an xfb image already in memory, like one
+ * embedded in an executable. Image is validated same as an xfb file, and is used in
+ * place, without copying it.
+ *
+ * @param xfb Handle to be initialized.
+ * @param data Contents of xfb file, aligned to @c XFB_SECTION_ALIGNMENT. Must stay
+ *        valid and unchanged till handle is closed.
+ * @param size Size of image in bytes.
+ *
+ * @return @c xfb on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC XfbFile* xfb_open_memory (XfbFile* xfb, const Uint8* data, Size size) {
+    RETURN_VALUE_IF (!xfb || !data, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        size < sizeof (XfbHeader) || (Size)data % XFB_SECTION_ALIGNMENT,
+        Null,
+        "Xfb image is too small or not aligned\n"
+    );
+
+    memset (xfb, 0, sizeof (XfbFile));
+
+    /* loaders never write to code or tables they execute from */
+    xfb->data = (Uint8*)data;
+    xfb->size = size;
+
+    if (!xfb_init (xfb)) {
+        xfb_close (xfb);
+        return Null;
+    }
+
+    return xfb;
+}
+
+/**
+ * @b Unmap given xfb file, and destroy it's loaders.
+ *
+ * @param xfb
+ *
+ * @return @c xfb on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC XfbFile* xfb_close (XfbFile* xfb) {
+    RETURN_VALUE_IF (!xfb, Null, ERR_INVALID_ARGUMENTS);
+
+    /* loaders only point into mapped file and these tables, besides their native code */
+    if (xfb->loaders) {
+        for (Size l = 0; l < xfb->loader_count; l++) {
+            jit_release_loader (xfb->loaders + l);
+        }
+        FREE (xfb->loaders);
+    }
+
+    if (xfb->loader_refs) {
+        FREE (xfb->loader_refs);
+    }
+
+    if (xfb->struct_layouts) {
+        FREE (xfb->struct_layouts);
+    }
+
+    if (xfb->switch_tables) {
+        FREE (xfb->switch_tables);
+    }
+
+    if (xfb->check_terms) {
+        FREE (xfb->check_terms);
+    }
+
+    if (xfb->msgs) {
+        FREE (xfb->msgs);
+    }
+
+    if (xfb->data && xfb->is_mapped) {
+        munmap (xfb->data, xfb->size);
+    }
+
+    memset (xfb, 0, sizeof (XfbFile));
+
+    return xfb;
+}
+
+/**
+ * @b Find type loader with given type name in xfb file.
+ *
+ * @param xfb
+ * @param type_name
+ *
+ * @return Loader on success.
+ * @return @c Null otherwise.
+ * */
+PUBLIC Loader* xfb_find_loader (XfbFile* xfb, CString type_name) {
+    RETURN_VALUE_IF (!xfb || !type_name, Null, ERR_INVALID_ARGUMENTS);
+
+    for (Size l = 0; l < xfb->loader_count; l++) {
+        if (xfb->loaders[l].type_name && !strcmp (xfb->loaders[l].type_name, type_name)) {
+            return xfb->loaders + l;
+        }
+    }
+
+    return Null;
+}
+
+/**************************************************************************************************/
+/*********************************** PRIVATE METHOD DEFINITIONS ***********************************/
+/**************************************************************************************************/
+
+/**
+ * @b Append given data to buffer, or zeroes if @c data is @c Null.
+ * */
+static inline XfbBuf* xfb_buf_append (XfbBuf* buf, const void* data, Size nb) {
+    if (buf->size + nb > buf->capacity) {
+        Size   new_capacity = MAX (buf->capacity * 2, buf->size + nb + 256);
+        Uint8* new_data     = REALLOCATE (buf->data, Uint8, new_capacity);
+        RETURN_VALUE_IF (!new_data, Null, ERR_OUT_OF_MEMORY);
+
+        buf->data     = new_data;
+        buf->capacity = new_capacity;
+    }
+
+    if (data) {
+        memcpy (buf->data + buf->size, data, nb);
+    } else {
+        memset (buf->data + buf->size, 0, nb);
+    }
+    buf->size += nb;
+
+    return buf;
+}
+
+static inline XfbBuf* xfb_buf_add_u64 (XfbBuf* buf, Uint64 val) {
+    return xfb_buf_append (buf, &val, sizeof (Uint64));
+}
+
+/**
+ * @b Add string to string pool, reusing an already added equal string.
+ * */
+static inline XfbBuf* xfb_buf_add_string (XfbBuf* strings, CString str, Uint64* offset) {
+    if (!str) {
+        *offset = XFB_NO_STRING;
+        return strings;
+    }
+
+    Size len = strlen (str);
+    for (Size s = 0; s < strings->size; s += strlen ((CString)strings->data + s) + 1) {
+        if (!strcmp ((CString)strings->data + s, str)) {
+            *offset = s;
+            return strings;
+        }
+    }
+
+    *offset = strings->size;
+    return xfb_buf_append (strings, str, len + 1);
+}
+
+/**
+ * @b Make sure loader has it's packed form, same as VM does before first execution.
+ * */
+static inline Loader* xfb_loader_prepare (Loader* loader) {
+    if (loader->packed_code.code) {
+        return loader;
+    }
+
+    RETURN_VALUE_IF (
+        !peephole_optimize_loader (loader, Null) ||
+            !packed_code_encode (
+                &loader->packed_code,
+                loader->insn_blocks,
+                loader->insn_block_count
+            ),
+        Null,
+        "Failed to encode type loader\n"
+    );
+
+    return loader;
+}
+
+/**
+ * @b Append everything owned by given loader to sections, and fill it's type table entry.
+ * */
+static inline Bool xfb_loader_serialize (
+    Loader*    loader,
+    Loader**   loaders,
+    Size       loader_count,
+    XfbBuf*    sections,
+    XfbLoader* xloader
+) {
+    PackedCode* packed  = &loader->packed_code;
+    XfbBuf*     strings = sections + XFB_SECTION_STRINGS;
+
+    RETURN_VALUE_IF (
+        !xfb_buf_add_string (strings, loader->type_name, &xloader->type_name) ||
+            !xfb_buf_add_string (strings, loader->type_doc, &xloader->type_doc),
+        False,
+        ERR_OUT_OF_MEMORY
+    );
+
+    xloader->alloc_size = loader->alloc_size;
+    xloader->insn_count = packed->insn_count;
+
+    /* references are stored as index of referred loader in type table */
+    xloader->loader_refs.first = sections[XFB_SECTION_LOADER_REFS].size / sizeof (Uint64);
+    xloader->loader_refs.count = loader->loader_ref_count;
+    for (Size r = 0; r < loader->loader_ref_count; r++) {
+        Size index = 0;
+        while (index < loader_count && loaders[index] != loader->loader_refs[r]) {
+            index++;
+        }
+
+        RETURN_VALUE_IF (
+            index == loader_count,
+            False,
+            "Type loader refers to a loader that is not being written\n"
+        );
+        RETURN_VALUE_IF (
+            !xfb_buf_add_u64 (sections + XFB_SECTION_LOADER_REFS, index),
+            False,
+            ERR_OUT_OF_MEMORY
+        );
+    }
+
+    xloader->blocks.first = sections[XFB_SECTION_BLOCK_OFFSETS].size / sizeof (Uint64);
+    xloader->blocks.count = packed->block_count;
+    for (Size b = 0; b < packed->block_count; b++) {
+        RETURN_VALUE_IF (
+            !xfb_buf_add_u64 (sections + XFB_SECTION_BLOCK_OFFSETS, packed->block_offsets[b]),
+            False,
+            ERR_OUT_OF_MEMORY
+        );
+    }
+
+    xloader->code.first = sections[XFB_SECTION_CODE].size;
+    xloader->code.count = packed->code_size;
+    RETURN_VALUE_IF (
+        !xfb_buf_append (sections + XFB_SECTION_CODE, packed->code, packed->code_size),
+        False,
+        ERR_OUT_OF_MEMORY
+    );
+
+    xloader->struct_layouts.first =
+        sections[XFB_SECTION_STRUCT_LAYOUTS].size / sizeof (XfbStructLayout);
+    xloader->struct_layouts.count = loader->struct_layout_count;
+    for (Size l = 0; l < loader->struct_layout_count; l++) {
+        StructLayout*   layout  = loader->struct_layouts + l;
+        XfbStructLayout xlayout = {
+            .fields      = {sections[XFB_SECTION_LAYOUT_FIELDS].size / sizeof (StructLayoutField),
+                            layout->field_count},
+            .mem_size    = layout->mem_size,
+            .stream_size = layout->stream_size,
+            .is_dense    = layout->is_dense,
+            .needs_swap  = layout->needs_swap,
+        };
+
+        for (Size f = 0; f < layout->field_count; f++) {
+            /* copied field by field so that struct padding is always zero */
+            StructLayoutField field;
+            memset (&field, 0, sizeof (StructLayoutField));
+            field.mem_off    = layout->fields[f].mem_off;
+            field.stream_off = layout->fields[f].stream_off;
+            field.size       = layout->fields[f].size;
+            field.count      = layout->fields[f].count;
+            field.swap       = layout->fields[f].swap;
+
+            RETURN_VALUE_IF (
+                !xfb_buf_append (sections + XFB_SECTION_LAYOUT_FIELDS, &field, sizeof (field)),
+                False,
+                ERR_OUT_OF_MEMORY
+            );
+        }
+
+        RETURN_VALUE_IF (
+            !xfb_buf_append (sections + XFB_SECTION_STRUCT_LAYOUTS, &xlayout, sizeof (xlayout)),
+            False,
+            ERR_OUT_OF_MEMORY
+        );
+    }
+
+    xloader->switch_tables.first =
+        sections[XFB_SECTION_SWITCH_TABLES].size / sizeof (XfbSwitchTable);
+    xloader->switch_tables.count = loader->switch_table_count;
+    for (Size t = 0; t < loader->switch_table_count; t++) {
+        SwitchTable*   table  = loader->switch_tables + t;
+        XfbSwitchTable xtable = {
+            .cases = {sections[XFB_SECTION_SWITCH_CASES].size / sizeof (SwitchCase),
+                      table->case_count},
+            .dense = {sections[XFB_SECTION_SWITCH_DENSE].size / sizeof (Size),
+                      table->dense ? table->dense_count : 0},
+        };
+
+        for (Size c = 0; c < table->case_count; c++) {
+            /* copied case by case so that struct padding is always zero */
+            SwitchCase scase;
+            memset (&scase, 0, sizeof (SwitchCase));
+            scase.first     = table->cases[c].first;
+            scase.last      = table->cases[c].last;
+            scase.block_sel = table->cases[c].block_sel;
+
+            RETURN_VALUE_IF (
+                !xfb_buf_append (sections + XFB_SECTION_SWITCH_CASES, &scase, sizeof (scase)),
+                False,
+                ERR_OUT_OF_MEMORY
+            );
+        }
+
+        RETURN_VALUE_IF (
+            (xtable.dense.count && !xfb_buf_append (
+                                       sections + XFB_SECTION_SWITCH_DENSE,
+                                       table->dense,
+                                       table->dense_count * sizeof (Size)
+                                   )) ||
+                !xfb_buf_append (sections + XFB_SECTION_SWITCH_TABLES, &xtable, sizeof (xtable)),
+            False,
+            ERR_OUT_OF_MEMORY
+        );
+    }
+
+    xloader->check_terms.first = sections[XFB_SECTION_CHECK_TERMS].size / sizeof (XfbCheckTerm);
+    xloader->check_terms.count = loader->check.term_count;
+    for (Size t = 0; t < loader->check.term_count; t++) {
+        CheckTerm*   term  = loader->check.terms + t;
+        XfbCheckTerm xterm = {
+            .mem_off = term->mem_off,
+            .value   = term->value,
+            .size    = term->size,
+            .cmp     = term->cmp,
+        };
+
+        RETURN_VALUE_IF (
+            !xfb_buf_add_string (strings, term->msg, &xterm.msg) ||
+                !xfb_buf_append (sections + XFB_SECTION_CHECK_TERMS, &xterm, sizeof (xterm)),
+            False,
+            ERR_OUT_OF_MEMORY
+        );
+    }
+
+    xloader->msgs.first = sections[XFB_SECTION_MSGS].size / sizeof (Uint64);
+    xloader->msgs.count = packed->msg_count;
+    for (Size m = 0; m < packed->msg_count; m++) {
+        Uint64 offset = 0;
+        RETURN_VALUE_IF (
+            !xfb_buf_add_string (strings, packed->msgs[m], &offset) ||
+                !xfb_buf_add_u64 (sections + XFB_SECTION_MSGS, offset),
+            False,
+            ERR_OUT_OF_MEMORY
+        );
+    }
+
+    return True;
+}
+
+/**
+ * @b FNV-1a hash of given file contents, with checksum field in header
+ * taken as zero.
+ * */
+static inline Uint64 xfb_checksum (const Uint8* data, Size size) {
+    Size checksum_begin = OFFSET_OF (XfbHeader, checksum);
+    Size checksum_end   = checksum_begin + sizeof (Uint64);
+
+    Uint64 hash = 0xcbf29ce484222325ull;
+    for (Size b = 0; b < size; b++) {
+        Uint8 byte  = b >= checksum_begin && b < checksum_end ? 0 : data[b];
+        hash       ^= byte;
+        hash       *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+/**
+ * @b Check whether given section lies completely within xfb file
+ * and starts at an aligned offset.
+ * */
+static inline Bool xfb_section_is_valid (XfbFile* xfb, const XfbSection* section, Size esize) {
+    if (section->offset % XFB_SECTION_ALIGNMENT || section->offset > xfb->size) {
+        return False;
+    }
+
+    return section->count <= (xfb->size - section->offset) / esize;
+}
+
+static inline Bool xfb_range_is_valid (const XfbRange* range, Uint64 count) {
+    return range->first <= count && range->count <= count - range->first;
+}
+
+static inline CString xfb_get_string (XfbFile* xfb, Uint64 offset) {
+    if (offset == XFB_NO_STRING || offset >= xfb->header->strings.count) {
+        return Null;
+    }
+
+    return (CString)(xfb->data + xfb->header->strings.offset + offset);
+}
+
+/**
+ * @b Validate header, sections and type table of an xfb image mapped or placed in
+ * @c xfb->data, and create loaders executing from it.
+ *
+ * File is rejected if it's written by a different version, on a host with different
+ * byte order or size width, if checksum does not match, or if any index or range
+ * stored in it is out of bounds.
+ * */
+static inline XfbFile* xfb_init (XfbFile* xfb) {
+    const XfbHeader* header = (const XfbHeader*)xfb->data;
+    xfb->header             = header;
+
+    RETURN_VALUE_IF (
+        header->magic != XFB_MAGIC || header->version != XFB_VERSION ||
+            header->header_size != sizeof (XfbHeader) ||
+            header->byte_order_mark != XFB_BYTE_ORDER_MARK || header->size_width != sizeof (Size),
+        Null,
+        "Xfb file has invalid magic, version, byte order or size width\n"
+    );
+
+    RETURN_VALUE_IF (
+        header->file_size != xfb->size || header->checksum != xfb_checksum (xfb->data, xfb->size),
+        Null,
+        "Xfb file is truncated or corrupted (checksum mismatch)\n"
+    );
+
+    const XfbSection* header_sections = &header->loaders;
+    for (Size s = 0; s < XFB_SECTION_MAX; s++) {
+        RETURN_VALUE_IF (
+            !xfb_section_is_valid (xfb, header_sections + s, xfb_section_elem_size[s]),
+            Null,
+            "Xfb file has invalid section %zu\n",
+            s
+        );
+    }
+
+    /* all strings end inside string pool, if last byte of pool is a terminator */
+    RETURN_VALUE_IF (
+        header->strings.count && xfb->data[header->strings.offset + header->strings.count - 1],
+        Null,
+        "Xfb file string pool is not terminated\n"
+    );
+
+    RETURN_VALUE_IF (!xfb_init_loaders (xfb), Null, "Xfb file contains invalid loaders\n");
+
+    RETURN_VALUE_IF (
+        header->file_loader != XFB_NO_LOADER && header->file_loader >= xfb->loader_count,
+        Null,
+        "Xfb file has invalid file loader\n"
+    );
+    if (header->file_loader != XFB_NO_LOADER) {
+        xfb->file_loader = xfb->loaders + header->file_loader;
+    }
+
+    return xfb;
+}
+
+/**
+ * @b Validate type table of opened file and create loaders executing from it.
+ * */
+static inline XfbFile* xfb_init_loaders (XfbFile* xfb) {
+    const XfbHeader* header = xfb->header;
+
+    Uint8*             data     = xfb->data;
+    const XfbLoader*   xloaders = (const XfbLoader*)(data + header->loaders.offset);
+    const Uint64*      refs     = (const Uint64*)(data + header->loader_refs.offset);
+    Size*              offsets  = (Size*)(data + header->block_offsets.offset);
+    Uint8*             code     = data + header->code.offset;
+    StructLayoutField* fields   = (StructLayoutField*)(data + header->layout_fields.offset);
+    SwitchCase*        cases    = (SwitchCase*)(data + header->switch_cases.offset);
+    Size*              dense    = (Size*)(data + header->switch_dense.offset);
+    const Uint64*      msgs     = (const Uint64*)(data + header->msgs.offset);
+    const XfbStructLayout* layouts =
+        (const XfbStructLayout*)(data + header->struct_layouts.offset);
+    const XfbSwitchTable* tables = (const XfbSwitchTable*)(data + header->switch_tables.offset);
+    const XfbCheckTerm*   terms  = (const XfbCheckTerm*)(data + header->check_terms.offset);
+
+    /* one extra element so that empty tables still get a valid allocation */
+    xfb->loader_count   = header->loaders.count;
+    xfb->loaders        = ALLOCATE (Loader, header->loaders.count + 1);
+    xfb->loader_refs    = ALLOCATE (Loader*, header->loader_refs.count + 1);
+    xfb->struct_layouts = ALLOCATE (StructLayout, header->struct_layouts.count + 1);
+    xfb->switch_tables  = ALLOCATE (SwitchTable, header->switch_tables.count + 1);
+    xfb->check_terms    = ALLOCATE (CheckTerm, header->check_terms.count + 1);
+    xfb->msgs           = ALLOCATE (CString, header->msgs.count + 1);
+    RETURN_VALUE_IF (
+        !xfb->loaders || !xfb->loader_refs || !xfb->struct_layouts || !xfb->switch_tables ||
+            !xfb->check_terms || !xfb->msgs,
+        Null,
+        ERR_OUT_OF_MEMORY
+    );
+
+    for (Size r = 0; r < header->loader_refs.count; r++) {
+        RETURN_VALUE_IF (refs[r] >= xfb->loader_count, Null, "Invalid loader reference\n");
+        xfb->loader_refs[r] = xfb->loaders + refs[r];
+    }
+
+    for (Size l = 0; l < header->struct_layouts.count; l++) {
+        const XfbStructLayout* xlayout = layouts + l;
+        RETURN_VALUE_IF (
+            !xfb_range_is_valid (&xlayout->fields, header->layout_fields.count),
+            Null,
+            "Invalid struct layout fields range\n"
+        );
+
+        xfb->struct_layouts[l] = (StructLayout) {
+            .fields      = fields + xlayout->fields.first,
+            .field_count = xlayout->fields.count,
+            .mem_size    = xlayout->mem_size,
+            .stream_size = xlayout->stream_size,
+            .is_dense    = xlayout->is_dense,
+            .needs_swap  = xlayout->needs_swap,
+        };
+        RETURN_VALUE_IF (
+            !struct_layout_is_valid (xfb->struct_layouts + l),
+            Null,
+            "Invalid struct layout %zu\n",
+            l
+        );
+    }
+
+    /* cases are checked against block count of each loader using the table */
+    for (Size t = 0; t < header->switch_tables.count; t++) {
+        const XfbSwitchTable* xtable = tables + t;
+        RETURN_VALUE_IF (
+            !xfb_range_is_valid (&xtable->cases, header->switch_cases.count) ||
+                !xfb_range_is_valid (&xtable->dense, header->switch_dense.count),
+            Null,
+            "Invalid switch table cases or dense range\n"
+        );
+
+        xfb->switch_tables[t] = (SwitchTable) {
+            .cases       = cases + xtable->cases.first,
+            .case_count  = xtable->cases.count,
+            .dense       = xtable->dense.count ? dense + xtable->dense.first : Null,
+            .dense_count = xtable->dense.count,
+        };
+    }
+
+    /* terms hold their message, so they can't be used from the mapped file */
+    for (Size t = 0; t < header->check_terms.count; t++) {
+        xfb->check_terms[t] = (CheckTerm) {
+            .mem_off = terms[t].mem_off,
+            .value   = terms[t].value,
+            .msg     = xfb_get_string (xfb, terms[t].msg),
+            .size    = terms[t].size,
+            .cmp     = terms[t].cmp,
+        };
+    }
+
+    for (Size m = 0; m < header->msgs.count; m++) {
+        xfb->msgs[m] = xfb_get_string (xfb, msgs[m]);
+    }
+
+    for (Size l = 0; l < xfb->loader_count; l++) {
+        const XfbLoader* xloader = xloaders + l;
+        Loader*          loader  = xfb->loaders + l;
+
+        RETURN_VALUE_IF (
+            !xfb_range_is_valid (&xloader->loader_refs, header->loader_refs.count) ||
+                !xfb_range_is_valid (&xloader->blocks, header->block_offsets.count) ||
+                !xfb_range_is_valid (&xloader->code, header->code.count) ||
+                !xfb_range_is_valid (&xloader->struct_layouts, header->struct_layouts.count) ||
+                !xfb_range_is_valid (&xloader->switch_tables, header->switch_tables.count) ||
+                !xfb_range_is_valid (&xloader->check_terms, header->check_terms.count) ||
+                !xfb_range_is_valid (&xloader->msgs, header->msgs.count),
+            Null,
+            "Invalid range in type loader %zu\n",
+            l
+        );
+
+        /* code must end with terminator and padding, so decoding never leaves it */
+        const Uint8* loader_code = code + xloader->code.first;
+        RETURN_VALUE_IF (
+            xloader->code.count < PACKED_CODE_PADDING + 1,
+            Null,
+            "Type loader %zu has truncated code\n",
+            l
+        );
+        for (Size p = xloader->code.count - PACKED_CODE_PADDING; p < xloader->code.count; p++) {
+            RETURN_VALUE_IF (loader_code[p], Null, "Type loader %zu has invalid padding\n", l);
+        }
+
+        for (Size b = 0; b < xloader->blocks.count; b++) {
+            RETURN_VALUE_IF (
+                offsets[xloader->blocks.first + b] >= xloader->code.count - PACKED_CODE_PADDING,
+                Null,
+                "Type loader %zu has invalid block offset\n",
+                l
+            );
+        }
+
+        loader->type_name  = xfb_get_string (xfb, xloader->type_name);
+        loader->type_doc   = xfb_get_string (xfb, xloader->type_doc);
+        loader->alloc_size = xloader->alloc_size;
+
+        /* only packed form exists, use packed_code_decode to get instruction blocks back */
+        loader->loader_refs      = xfb->loader_refs + xloader->loader_refs.first;
+        loader->loader_ref_count = xloader->loader_refs.count;
+
+        loader->struct_layouts      = xfb->struct_layouts + xloader->struct_layouts.first;
+        loader->struct_layout_count = xloader->struct_layouts.count;
+
+        loader->switch_tables      = xfb->switch_tables + xloader->switch_tables.first;
+        loader->switch_table_count = xloader->switch_tables.count;
+        for (Size t = 0; t < loader->switch_table_count; t++) {
+            RETURN_VALUE_IF (
+                !switch_table_is_valid (loader->switch_tables + t, xloader->blocks.count),
+                Null,
+                "Type loader %zu has invalid switch table %zu\n",
+                l,
+                t
+            );
+        }
+
+        loader->check = (CheckTable) {
+            .terms      = xfb->check_terms + xloader->check_terms.first,
+            .term_count = xloader->check_terms.count,
+        };
+        RETURN_VALUE_IF (
+            !check_table_is_valid (&loader->check, loader->alloc_size),
+            Null,
+            "Type loader %zu has invalid check table\n",
+            l
+        );
+
+        loader->packed_code = (PackedCode) {
+            .code          = code + xloader->code.first,
+            .code_size     = xloader->code.count,
+            .block_offsets = offsets + xloader->blocks.first,
+            .block_count   = xloader->blocks.count,
+            .msgs          = xfb->msgs + xloader->msgs.first,
+            .msg_count     = xloader->msgs.count,
+            .insn_count    = xloader->insn_count,
+        };
+    }
+
+    return xfb;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file Xfb.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_SOURCE_CROSSFILE_XFT_VM_XFB_H
+#define ANVIE_SOURCE_CROSSFILE_XFT_VM_XFB_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* local includes */
+#include "Loader.h"
+
+/**
+ * An xfb file is a precompiled set of type loaders, so loaders don't have to be
+ * compiled from their sources on every startup. Every section is addressed by an
+ * offset relative to beginning of file and all references between loaders, blocks,
+ * layouts, switch tables and strings are indices, so the file can be mmapped and
+ * executed in place.
+ *
+ * Loaders are stored in their executable (packed) form. Data is stored in host byte
+ * order, a file written on a host with different byte order or size width is rejected
+ * by loader.
+ *
+ * Layout :
+ *   XfbHeader
+ *   XfbLoader         [header.loaders.count]        (type table)
+ *   Uint64            [header.loader_refs.count]    (indices into type table)
+ *   Uint64            [header.block_offsets.count]  (relative to code of each loader)
+ *   Uint8             [header.code.count]           (packed code of all loaders)
+ *   XfbStructLayout   [header.struct_layouts.count]
+ *   StructLayoutField [header.layout_fields.count]
+ *   XfbSwitchTable    [header.switch_tables.count]
+ *   SwitchCase        [header.switch_cases.count]
+ *   Uint64            [header.switch_dense.count]   (block of each value of dense tables)
+ *   XfbCheckTerm      [header.check_terms.count]
+ *   Uint64            [header.msgs.count]           (offsets into string pool)
+ *   Char              [header.strings.count]        (NUL terminated strings)
+ *
+ * Each section begins at an offset aligned to @c XFB_SECTION_ALIGNMENT. Checksum is
+ * FNV-1a of whole file, computed with checksum field set to zero. Header also stores
+ * index of loader of file declaration in type table, if there's one.
+ * */
+
+#define XFB_MAGIC             0x30424658 /* XFB0 */
+#define XFB_VERSION           7
+#define XFB_BYTE_ORDER_MARK   0x01020304
+#define XFB_SECTION_ALIGNMENT 8
+
+/* string offset used for absent (Null) strings */
+#define XFB_NO_STRING ((Uint64)-1)
+
+/* loader index used when there's no file loader */
+#define XFB_NO_LOADER ((Uint64)-1)
+
+typedef struct XfbSection {
+    Uint64 offset; /**< @b Offset from beginning of file. */
+    Uint64 count;  /**< @b Number of elements (not bytes) in this section. */
+} XfbSection;
+
+/**
+ * @b A range of elements inside a section, owned by a single loader or layout.
+ * */
+typedef struct XfbRange {
+    Uint64 first;
+    Uint64 count;
+} XfbRange;
+
+typedef struct XfbLoader {
+    Uint64   type_name;  /**< @b Offset of type name in string pool. */
+    Uint64   type_doc;   /**< @b Offset of type documentation in string pool. */
+    Uint64   alloc_size;
+    Uint64   insn_count; /**< @b Number of instructions in packed code. */
+    XfbRange loader_refs;
+    XfbRange blocks;     /**< @b Range of block offsets. */
+    XfbRange code;       /**< @b Range of bytes in code, including terminator and padding. */
+    XfbRange struct_layouts;
+    XfbRange switch_tables;
+    XfbRange check_terms;
+    XfbRange msgs;
+} XfbLoader;
+
+typedef struct XfbStructLayout {
+    XfbRange fields;
+    Uint64   mem_size;
+    Uint64   stream_size;
+    Uint8    is_dense;
+    Uint8    needs_swap;
+    Uint8    reserved[6];
+} XfbStructLayout;
+
+typedef struct XfbSwitchTable {
+    XfbRange cases;
+    XfbRange dense; /**< @b Empty if table is sparse. */
+} XfbSwitchTable;
+
+typedef struct XfbCheckTerm {
+    Uint64 mem_off;
+    Uint64 value;
+    Uint64 msg; /**< @b Offset of message in string pool. */
+    Uint8  size;
+    Uint8  cmp;
+    Uint8  reserved[6];
+} XfbCheckTerm;
+
+typedef struct XfbHeader {
+    Uint32 magic;
+    Uint16 version;
+    Uint16 header_size;
+    Uint32 byte_order_mark;
+    Uint32 size_width; /**< @b sizeof (Size) on host that wrote the file. */
+
+    Uint64 checksum;
+    Uint64 file_size;   /**< @b Total size of file. */
+    Uint64 file_loader; /**< @b Index of file loader in type table, @c XFB_NO_LOADER if none. */
+
+    XfbSection loaders;
+    XfbSection loader_refs;
+    XfbSection block_offsets;
+    XfbSection code;
+    XfbSection struct_layouts;
+    XfbSection layout_fields;
+    XfbSection switch_tables;
+    XfbSection switch_cases;
+    XfbSection switch_dense;
+    XfbSection check_terms;
+    XfbSection msgs;
+    XfbSection strings;
+} XfbHeader;
+
+/**
+ * @b Handle to a mmapped xfb file, or to an xfb image already in memory.
+ *
+ * Code, block offsets, layout fields, switch cases and strings are used directly
+ * from the mapped file. Only the loader objects, and the pointer tables the VM expects
+ * (loader references, layouts, switch tables, check terms and messages) are created when
+ * opening, no data is copied or relocated. Loaders are owned by the file and live till it's closed.
+ * */
+typedef struct XfbFile {
+    Uint8*           data;
+    Size             size;
+    Bool             is_mapped; /**< @b Data is mapped by handle, and unmapped on close. */
+    const XfbHeader* header;
+
+    Loader*       loaders;
+    Size          loader_count;
+    Loader*       file_loader; /**< @b Loader of file declaration, @c Null if none. */
+    Loader**      loader_refs;
+    StructLayout* struct_layouts;
+    SwitchTable*  switch_tables;
+    CheckTerm*    check_terms;
+    CString*      msgs;
+} XfbFile;
+
+PUBLIC Loader** xfb_write (
+    Loader** loaders,
+    Size     loader_count,
+    Loader*  file_loader,
+    CString  xfb_path
+);
+PUBLIC XfbFile* xfb_open (XfbFile* xfb, CString xfb_path);
+PUBLIC XfbFile* xfb_open_memory (XfbFile* xfb, const Uint8* data, Size size);
+PUBLIC XfbFile* xfb_close (XfbFile* xfb);
+PUBLIC Loader*  xfb_find_loader (XfbFile* xfb, CString type_name);
+
+#endif // ANVIE_SOURCE_CROSSFILE_XFT_VM_XFB_H
@@ -2,23 +2,115 @@
 #include <Anvie/CrossFile/Stream.h>
 #include <Anvie/Types.h>
 
-#include <tree-sitter-xfile.h>
-#include <tree_sitter/api.h>
+/* libc */
+#include <stdio.h>
+#include <stdlib.h>
 
-int main (int argc, char** argv) {
-    RETURN_VALUE_IF (argc != 2 || !argv[1], EXIT_FAILURE, "USAGE: %s <file.xf>", argv[0]);
+/* crossfile */
+#include "CrossFile/Xft/Parser/Registry.h"
+#include "CrossFile/Xft/Vm/Vm.h"
+
+static Char* read_schema (CString filename, Size* size);
 
-    IoStream* stream = io_stream_open_file (argv[1], False);
+/* schemas compiled at runtime are cached in directory named by XFT_CACHE_DIR, if it's set */
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (
+        argc != 3 || !argv[1] || !argv[2],
+        EXIT_FAILURE,
+        "USAGE: %s <file.xf | bundled schema name> <file>\n",
+        argv[0]
+    );
 
-    Uint32 magic = 0;
+    SchemaRegistry registry = {0};
     RETURN_VALUE_IF (
-        !io_stream_read_be_u32 (stream, &magic),
+        !schema_registry_init (&registry, getenv ("XFT_CACHE_DIR")),
         EXIT_FAILURE,
-        "Failed to read magic bytes from Elf file.\n"
+        "Failed to initialize schema registry\n"
     );
-    PRINT_ERR ("%x\n", magic);
 
-    io_stream_close (stream);
+    Char*        source = Null;
+    SchemaEntry* entry  = schema_registry_find (&registry, argv[1]);
+    IoStream*    stream = Null;
+    void*        mem    = Null;
+    Vm           vm     = {0};
+    int          status = EXIT_FAILURE;
+
+    if (!entry) {
+        Size source_size = 0;
+        source           = read_schema (argv[1], &source_size);
+        GOTO_HANDLER_IF (!source, CLEANUP, "Failed to read type description\n");
+
+        entry = schema_registry_compile (&registry, argv[1], source, source_size);
+        GOTO_HANDLER_IF (!entry, CLEANUP, "Failed to compile type description\n");
+    }
+    GOTO_HANDLER_IF (!entry->file_loader, CLEANUP, "Type description declares no file\n");
+
+    stream = io_stream_open_file (argv[2], False);
+    GOTO_HANDLER_IF (!stream, CLEANUP, "Failed to open file \"%s\"\n", argv[2]);
+
+    mem = ALLOCATE (Uint8, MAX (entry->file_loader->alloc_size, 1));
+    GOTO_HANDLER_IF (!mem, CLEANUP, ERR_OUT_OF_MEMORY);
+
+    GOTO_HANDLER_IF (
+        !vm_run_loader (&vm, entry->file_loader, stream, mem),
+        CLEANUP,
+        "Failed to load \"%s\" as \"%s\"\n",
+        argv[2],
+        entry->file_loader->type_name
+    );
+
+    printf (
+        "Loaded \"%s\" as \"%s\" : %zu bytes read, %zu type loaders\n",
+        argv[2],
+        entry->file_loader->type_name,
+        (Size)io_stream_get_cursor (stream),
+        entry->loader_count
+    );
+    status = EXIT_SUCCESS;
+
+CLEANUP:
+    vm_deinit (&vm);
+    if (mem) {
+        FREE (mem);
+    }
+    if (stream) {
+        io_stream_close (stream);
+    }
+    schema_registry_deinit (&registry);
+    if (source) {
+        FREE (source);
+    }
+
+    return status;
+}
+
+/**
+ * @b Read whole type description file.
+ *
+ * @param filename
+ * @param size Where size of description is stored.
+ *
+ * @return Contents of file on success, owned by caller.
+ * @return @c Null otherwise.
+ * */
+static Char* read_schema (CString filename, Size* size) {
+    FILE* file = fopen (filename, "rb");
+    RETURN_VALUE_IF (!file, Null, "Failed to open \"%s\"\n", filename);
+
+    Char* source = Null;
+    long  len    = -1;
+    if (!fseek (file, 0, SEEK_END) && (len = ftell (file)) >= 0 && !fseek (file, 0, SEEK_SET)) {
+        source = ALLOCATE (Char, (Size)len + 1);
+    }
+
+    if (source && fread (source, 1, (Size)len, file) != (Size)len) {
+        FREE (source);
+        source = Null;
+    }
+    fclose (file);
+
+    RETURN_VALUE_IF (!source, Null, "Failed to read \"%s\"\n", filename);
 
-    return EXIT_SUCCESS;
+    *size = (Size)len;
+    return source;
 }
@@ -0,0 +1,88 @@
+/**
+ * @file XftAot.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <stdlib.h>
+
+/* crossfile */
+#include "../CrossFile/Xft/Vm/Aot.h"
+#include "../CrossFile/Xft/Vm/Xfb.h"
+
+/**
+ * @b Compile all type loaders in a precompiled .xfb file to C source.
+ *
+ * USAGE : xftaot <input.xfb> <prefix> <output.c> <output.h>
+ * */
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (
+        argc != 5,
+        EXIT_FAILURE,
+        "USAGE: %s <input.xfb> <prefix> <output.c> <output.h>\n",
+        argv[0]
+    );
+
+    XfbFile  xfb     = {0};
+    Loader** loaders = Null;
+
+    GOTO_HANDLER_IF (!xfb_open (&xfb, argv[1]), AOT_FAILED, "Failed to open \"%s\"\n", argv[1]);
+
+    loaders = ALLOCATE (Loader*, xfb.loader_count + 1);
+    GOTO_HANDLER_IF (!loaders, AOT_FAILED, ERR_OUT_OF_MEMORY);
+    for (Size l = 0; l < xfb.loader_count; l++) {
+        loaders[l] = xfb.loaders + l;
+    }
+
+    GOTO_HANDLER_IF (
+        !aot_write (loaders, xfb.loader_count, argv[2], argv[3], argv[4]),
+        AOT_FAILED,
+        "Failed to compile type loaders in \"%s\"\n",
+        argv[1]
+    );
+
+    FREE (loaders);
+    xfb_close (&xfb);
+
+    return EXIT_SUCCESS;
+
+AOT_FAILED:
+    if (loaders) {
+        FREE (loaders);
+    }
+    if (xfb.data) {
+        xfb_close (&xfb);
+    }
+
+    return EXIT_FAILURE;
+}
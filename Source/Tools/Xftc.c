@@ -0,0 +1,317 @@
+/**
+ * @file Xftc.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* libc */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* crossfile */
+#include "../CrossFile/Xft/Parser/Compiler.h"
+#include "../CrossFile/Xft/Vm/Peephole.h"
+#include "../CrossFile/Xft/Vm/Xfb.h"
+
+static Uint8* read_file (CString filename, Size* size);
+static Bool   compile_schema (CString xf_path, CString xfb_path);
+static Bool   print_schema_stats (CString xf_path);
+static Bool   embed_schema (FILE* out, Size index, CString name, CString xf_path, CString xfb_path);
+
+/**
+ * @b Compile xfile type descriptions to xfb images, and write them to C source as
+ * table of schemas bundled with CrossFile (see @c SchemaBlob in Registry.h).
+ *
+ * With @c -o a single type description is compiled to an xfb file instead, for tools
+ * that consume xfb files directly, like xftaot. With @c -s nothing is written, and
+ * instruction counts of every type loader before and after peephole optimization are
+ * printed instead.
+ *
+ * USAGE : xftc <output.c> [<name> <file.xf>]...
+ *         xftc -o <output.xfb> <file.xf>
+ *         xftc -s <file.xf>
+ * */
+int main (int argc, char** argv) {
+    if (argc == 4 && !strcmp (argv[1], "-o")) {
+        return compile_schema (argv[3], argv[2]) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (argc == 3 && !strcmp (argv[1], "-s")) {
+        return print_schema_stats (argv[2]) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    RETURN_VALUE_IF (
+        argc < 2 || argc % 2,
+        EXIT_FAILURE,
+        "USAGE: %s <output.c> [<name> <file.xf>]...\n"
+        "       %s -o <output.xfb> <file.xf>\n"
+        "       %s -s <file.xf>\n",
+        argv[0],
+        argv[0],
+        argv[0]
+    );
+
+    Size  count    = (Size)(argc - 2) / 2;
+    Size  tmp_size = strlen (argv[1]) + 32;
+    Char* xfb_path = ALLOCATE (Char, tmp_size);
+    FILE* out      = Null;
+    RETURN_VALUE_IF (!xfb_path, EXIT_FAILURE, ERR_OUT_OF_MEMORY);
+    snprintf (xfb_path, tmp_size, "%s.%d.xfb", argv[1], (int)getpid());
+
+    out = fopen (argv[1], "w");
+    GOTO_HANDLER_IF (!out, EMBED_FAILED, "Failed to create \"%s\"\n", argv[1]);
+
+    fprintf (out, "/* generated by xftc, do not edit */\n\n");
+    fprintf (out, "#include \"CrossFile/Xft/Parser/Registry.h\"\n");
+
+    for (Size s = 0; s < count; s++) {
+        GOTO_HANDLER_IF (
+            !embed_schema (out, s, argv[2 + 2 * s], argv[3 + 2 * s], xfb_path),
+            EMBED_FAILED,
+            "Failed to embed schema \"%s\"\n",
+            argv[2 + 2 * s]
+        );
+    }
+
+    /* an empty initializer list is not valid C, keep one zeroed element instead */
+    fprintf (out, "\nconst SchemaBlob schema_blobs[] = {\n");
+    for (Size s = 0; s < count; s++) {
+        fprintf (
+            out,
+            "    {\"%s\", schema_blob_%zu, sizeof (schema_blob_%zu)},\n",
+            argv[2 + 2 * s],
+            s,
+            s
+        );
+    }
+    fprintf (out, count ? "};\n" : "    {0},\n};\n");
+    fprintf (out, "const Size schema_blob_count = %zu;\n", count);
+
+    GOTO_HANDLER_IF (fclose (out) != 0, EMBED_FAILED, "Failed to write \"%s\"\n", argv[1]);
+    FREE (xfb_path);
+
+    return EXIT_SUCCESS;
+
+EMBED_FAILED:
+    if (out) {
+        fclose (out);
+    }
+    remove (argv[1]);
+    FREE (xfb_path);
+
+    return EXIT_FAILURE;
+}
+
+/**
+ * @b Compile a type description, and write it's type loaders to an xfb file.
+ *
+ * @param xf_path Path of type description.
+ * @param xfb_path Where xfb file is written to.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+static Bool compile_schema (CString xf_path, CString xfb_path) {
+    Size   source_size = 0;
+    Uint8* source      = read_file (xf_path, &source_size);
+    Schema schema      = {0};
+    Bool   res         = False;
+
+    RETURN_VALUE_IF (!source, False, "Failed to read type description\n");
+
+    if (!schema_compile_source (&schema, (CString)source, source_size, SCHEMA_FLAG_NONE)) {
+        PRINT_ERR ("Failed to compile \"%s\"\n", xf_path);
+    } else if (!xfb_write (schema.loaders, schema.loader_count, schema.file_loader, xfb_path)) {
+        PRINT_ERR ("Failed to write type loaders of \"%s\"\n", xf_path);
+    } else {
+        res = True;
+    }
+
+    schema_deinit (&schema);
+    FREE (source);
+
+    return res;
+}
+
+/**
+ * @b Compile a type description, optimize it's type loaders like VM does before their
+ * first execution, and print instruction counts of each, followed by totals.
+ *
+ * @param xf_path Path of type description.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+static Bool print_schema_stats (CString xf_path) {
+    Size          source_size = 0;
+    Uint8*        source      = read_file (xf_path, &source_size);
+    Schema        schema      = {0};
+    PeepholeStats total       = {0};
+    Bool          res         = False;
+
+    RETURN_VALUE_IF (!source, False, "Failed to read type description\n");
+
+    GOTO_HANDLER_IF (
+        !schema_compile_source (&schema, (CString)source, source_size, SCHEMA_FLAG_NONE),
+        STATS_DONE,
+        "Failed to compile \"%s\"\n",
+        xf_path
+    );
+
+    printf (
+        "%-32s %8s %8s %12s %13s\n",
+        "loader",
+        "before",
+        "after",
+        "reads fused",
+        "jumps folded"
+    );
+    for (Size l = 0; l < schema.loader_count; l++) {
+        Loader*       loader = schema.loaders[l];
+        PeepholeStats stats  = {0};
+        GOTO_HANDLER_IF (
+            !peephole_optimize_loader (loader, &stats),
+            STATS_DONE,
+            "Failed to optimize type loaders of \"%s\"\n",
+            xf_path
+        );
+
+        printf (
+            "%-32s %8zu %8zu %12zu %13zu\n",
+            loader->type_name ? loader->type_name : "<unnamed>",
+            stats.insn_count_before,
+            stats.insn_count_after,
+            stats.reads_fused,
+            stats.jumps_folded
+        );
+
+        total.insn_count_before += stats.insn_count_before;
+        total.insn_count_after  += stats.insn_count_after;
+        total.reads_fused       += stats.reads_fused;
+        total.jumps_folded      += stats.jumps_folded;
+    }
+    printf (
+        "%-32s %8zu %8zu %12zu %13zu\n",
+        "total",
+        total.insn_count_before,
+        total.insn_count_after,
+        total.reads_fused,
+        total.jumps_folded
+    );
+    res = True;
+
+STATS_DONE:
+    schema_deinit (&schema);
+    FREE (source);
+
+    return res;
+}
+
+/**
+ * @b Compile a type description, and write it's xfb image to output as an array
+ * named @c schema_blob_<index>.
+ *
+ * @param out Generated source.
+ * @param index Index of schema in generated table.
+ * @param name Name of schema.
+ * @param xf_path Path of type description.
+ * @param xfb_path Where xfb file is written to temporarily.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+static Bool embed_schema (FILE* out, Size index, CString name, CString xf_path, CString xfb_path) {
+    Uint8* image      = Null;
+    Size   image_size = 0;
+
+    RETURN_VALUE_IF (
+        !compile_schema (xf_path, xfb_path),
+        False,
+        "Failed to compile type loaders of \"%s\"\n",
+        name
+    );
+
+    image = read_file (xfb_path, &image_size);
+    remove (xfb_path);
+    RETURN_VALUE_IF (!image, False, "Failed to read back type loaders\n");
+
+    /* sections of image are accessed in place, so it's aligned like they are */
+    fprintf (
+        out,
+        "\n/* %s, compiled from %s */\nstatic _Alignas (%d) const Uint8 schema_blob_%zu[] = {",
+        name,
+        xf_path,
+        XFB_SECTION_ALIGNMENT,
+        index
+    );
+    for (Size b = 0; b < image_size; b++) {
+        fprintf (out, b % 16 ? " 0x%02x," : "\n    0x%02x,", image[b]);
+    }
+    fprintf (out, "\n};\n");
+
+    FREE (image);
+
+    return True;
+}
+
+/**
+ * @b Read whole file.
+ *
+ * @param filename
+ * @param size Where size of file is stored.
+ *
+ * @return Contents of file on success, owned by caller.
+ * @return @c Null otherwise.
+ * */
+static Uint8* read_file (CString filename, Size* size) {
+    FILE* file = fopen (filename, "rb");
+    RETURN_VALUE_IF (!file, Null, "Failed to open \"%s\"\n", filename);
+
+    Uint8* data = Null;
+    long   len  = -1;
+    if (!fseek (file, 0, SEEK_END) && (len = ftell (file)) >= 0 && !fseek (file, 0, SEEK_SET)) {
+        data = ALLOCATE (Uint8, (Size)len + 1);
+    }
+
+    if (data && fread (data, 1, (Size)len, file) != (Size)len) {
+        FREE (data);
+        data = Null;
+    }
+    fclose (file);
+
+    RETURN_VALUE_IF (!data, Null, "Failed to read \"%s\"\n", filename);
+
+    *size = (Size)len;
+    return data;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file AddrIndex.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/CrossFile/Elf/AddrIndex.h>
+#include <Anvie/CrossFile/Elf/Elf.h>
+
+/* libc */
+#include <memory.h>
+#include <stdio.h>
+
+/* vendored ELF definitions */
+#include <Elf/Elf.h>
+
+/* local includes */
+#include <Test.h>
+
+/* number of random addresses looked up in batch */
+#define TEST_RANDOM_COUNT 20000
+
+/**
+ * @b A global function, so test executable has a symbol of known size to look for.
+ * */
+__attribute__ ((noinline)) int elf_test_marker (int x) {
+    return x * 3 + 1;
+}
+
+/**
+ * @b Make sure addresses inside a known function resolve to it, with their offset, and
+ * address 0 resolves to no symbol.
+ * */
+static Bool test_lookup_known_symbol (CString elf_path) {
+    ElfFile      elf;
+    ElfAddrIndex index;
+    TEST_CHECK (elf_file_open (&elf, elf_path));
+
+    ElfSymbol    marker;
+    ElfAddrMatch match  = {0};
+    Bool         status = elf_addr_index_init (&index, &elf) && index.table == &elf.symtab;
+    status = status && elf_file_find_symbol (&elf, "elf_test_marker", &marker) && marker.size > 1;
+
+    status = status && elf_addr_index_lookup (&index, marker.value, &match) &&
+             match.symbol == marker.index && match.offset == 0;
+    status = status && elf_addr_index_lookup (&index, marker.value + marker.size - 1, &match) &&
+             match.symbol == marker.index && match.offset == marker.size - 1;
+    status = status && !elf_addr_index_lookup (&index, 0, &match) && !match.symbol;
+
+    elf_addr_index_deinit (&index);
+    elf_file_close (&elf);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure middle of every sized function resolves to a symbol containing it, no
+ * larger than the function itself, so nested symbols resolve to the innermost one.
+ * */
+static Bool test_lookup_functions (CString elf_path) {
+    ElfFile      elf;
+    ElfAddrIndex index;
+    TEST_CHECK (elf_file_open (&elf, elf_path));
+
+    Bool status    = elf_addr_index_init (&index, &elf) != Null;
+    Size functions = 0;
+    for (Size s = 1; status && s < index.table->count; s++) {
+        ElfSymbol symbol;
+        ElfSymbol found;
+        status = elf_symbol_table_get (&elf, index.table, s, &symbol);
+        if (!status || symbol.type != STT_FUNC || !symbol.size || symbol.shndx == SHN_UNDEF ||
+            symbol.shndx == SHN_ABS) {
+            continue;
+        }
+
+        Uint64       addr  = symbol.value + symbol.size / 2;
+        ElfAddrMatch match = {0};
+        status = elf_addr_index_lookup (&index, addr, &match) &&
+                 elf_symbol_table_get (&elf, index.table, match.symbol, &found);
+        status = status && found.value <= addr && match.offset == addr - found.value &&
+                 (!found.size || (addr - found.value < found.size && found.size <= symbol.size));
+        functions++;
+    }
+
+    elf_addr_index_deinit (&index);
+    elf_file_close (&elf);
+
+    TEST_CHECK (status && functions >= 2);
+    return True;
+}
+
+/**
+ * @b Make sure a batch of addresses in random order, inside and around all ranges,
+ * resolves same as looking each of them up alone.
+ * */
+static Bool test_batch_matches_single (CString elf_path) {
+    ElfFile      elf;
+    ElfAddrIndex index;
+    TEST_CHECK (elf_file_open (&elf, elf_path));
+
+    Uint64*       addrs   = ALLOCATE (Uint64, TEST_RANDOM_COUNT);
+    ElfAddrMatch* matches = ALLOCATE (ElfAddrMatch, TEST_RANDOM_COUNT);
+    Bool          status  = addrs && matches && elf_addr_index_init (&index, &elf) && index.count;
+
+    /* span of all ranges, with some room on both sides */
+    Uint64 first  = status ? index.starts[0] : 0;
+    Uint64 span   = status ? index.ranges[index.count - 1].end - first + 64 : 1;
+    Uint64 random = 1;
+    first         = first > 32 ? first - 32 : 0;
+
+    for (Size a = 0; status && a < TEST_RANDOM_COUNT; a++) {
+        random   = random * 6364136223846793005ULL + 1442695040888963407ULL;
+        addrs[a] = first + (random >> 16) % span;
+    }
+
+    status = status && elf_addr_index_lookup_batch (&index, addrs, TEST_RANDOM_COUNT, matches);
+    for (Size a = 0; status && a < TEST_RANDOM_COUNT; a++) {
+        ElfAddrMatch single = {0};
+        elf_addr_index_lookup (&index, addrs[a], &single);
+        status = single.symbol == matches[a].symbol && single.offset == matches[a].offset;
+    }
+
+    elf_addr_index_deinit (&index);
+    elf_file_close (&elf);
+    if (addrs) {
+        FREE (addrs);
+    }
+    if (matches) {
+        FREE (matches);
+    }
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (argc != 2, EXIT_FAILURE, "usage : %s <elf file>\n", argv[0]);
+
+    Bool status = True;
+    TEST_RUN (status, test_lookup_known_symbol (argv[1]));
+    TEST_RUN (status, test_lookup_functions (argv[1]));
+    TEST_RUN (status, test_batch_matches_single (argv[1]));
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,188 @@
+/**
+ * @file Elf.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/CrossFile/Elf/Elf.h>
+
+/* libc */
+#include <memory.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* vendored ELF definitions */
+#include <Elf/Elf.h>
+
+/* local includes */
+#include <Test.h>
+
+/**
+ * @b Global functions, so test executable has symbols of known address to look for.
+ * */
+__attribute__ ((noinline)) int elf_test_marker (int x) {
+    return x * 3 + 1;
+}
+
+__attribute__ ((noinline)) int elf_test_other_marker (int x) {
+    return x * 5 + 2;
+}
+
+/**
+ * @b Make sure every section is found by it's name, and .text holds main.
+ * */
+static Bool test_sections (CString elf_path) {
+    ElfFile elf;
+    TEST_CHECK (elf_file_open (&elf, elf_path));
+
+    Bool status = elf.is_64 == (sizeof (void*) == 8) && !elf.swap &&
+                  (elf.type == ET_EXEC || elf.type == ET_DYN) && elf.section_count > 1;
+
+    for (Size s = 1; status && s < elf.section_count; s++) {
+        ElfSection section;
+        ElfSection found;
+        status = elf_file_get_section (&elf, s, &section) && section.index == s;
+        if (status && section.name[0]) {
+            status = elf_file_find_section (&elf, section.name, &found) &&
+                     !strcmp (found.name, section.name);
+        }
+    }
+
+    ElfSection text;
+    ElfSymbol  main_sym;
+    status = status && elf_file_find_section (&elf, ".text", &text) &&
+             text.type == SHT_PROGBITS && (text.flags & SHF_EXECINSTR) && text.data;
+    status = status && elf_file_find_symbol (&elf, "main", &main_sym) &&
+             main_sym.value >= text.addr && main_sym.value < text.addr + text.size;
+
+    /* nothing past last section, or by a name no section has */
+    ElfSection missing;
+    status = status && !elf_file_get_section (&elf, elf.section_count, &missing) &&
+             !elf_file_find_section (&elf, ".no.such.section", &missing);
+
+    elf_file_close (&elf);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure symbols are found by name with the values they're loaded at, relative to
+ * each other, and every defined global of static symbol table is found through index.
+ * */
+static Bool test_symbols (CString elf_path) {
+    ElfFile elf;
+    TEST_CHECK (elf_file_open (&elf, elf_path));
+
+    ElfSymbol marker;
+    ElfSymbol other;
+    Bool      status = elf.symtab.section != 0;
+    status           = status && elf_file_find_symbol (&elf, "elf_test_marker", &marker);
+    status           = status && elf_file_find_symbol (&elf, "elf_test_other_marker", &other);
+
+    status = status && marker.type == STT_FUNC && marker.bind == STB_GLOBAL &&
+             !strcmp (marker.name, "elf_test_marker") && other.type == STT_FUNC;
+
+    /* both are moved by same load bias, if any */
+    Uint64 marker_addr = (Uint64)(uintptr_t)&elf_test_marker;
+    Uint64 other_addr  = (Uint64)(uintptr_t)&elf_test_other_marker;
+    status             = status && other.value - marker.value == other_addr - marker_addr;
+
+    Size globals = 0;
+    for (Size s = 1; status && s < elf.symtab.count; s++) {
+        ElfSymbol symbol;
+        ElfSymbol found;
+        status = elf_symbol_table_get (&elf, &elf.symtab, s, &symbol);
+        if (!status || symbol.bind != STB_GLOBAL || symbol.shndx == SHN_UNDEF || !symbol.name[0]) {
+            continue;
+        }
+
+        status = elf_symbol_table_find (&elf, &elf.symtab, symbol.name, &found) &&
+                 !strcmp (found.name, symbol.name) && found.value == symbol.value;
+        globals++;
+    }
+
+    ElfSymbol missing;
+    status = status && globals >= 2 && !elf_file_find_symbol (&elf, "no_such_symbol", &missing);
+
+    elf_file_close (&elf);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure a file cut short, or without ELF magic, is rejected.
+ * */
+static Bool test_invalid_rejected (CString elf_path, CString scratch_path) {
+    FILE* in = fopen (elf_path, "rb");
+    TEST_CHECK (in);
+
+    static Uint8 buf[1 << 16];
+    Size         size = fread (buf, 1, sizeof (buf), in);
+    fclose (in);
+    TEST_CHECK (size > 64);
+
+    ElfFile elf;
+    Bool    status = True;
+    for (Size attempt = 0; attempt < 2; attempt++) {
+        /* first half of start of file, then whole start of file with magic broken */
+        Size write_size = attempt ? size : size / 2;
+        buf[1]          = attempt ? 'X' : buf[1];
+
+        FILE* out = fopen (scratch_path, "wb");
+        TEST_CHECK (out);
+        Bool written = fwrite (buf, 1, write_size, out) == write_size;
+        fclose (out);
+        TEST_CHECK (written);
+
+        if (elf_file_open (&elf, scratch_path)) {
+            elf_file_close (&elf);
+            status = False;
+        }
+    }
+
+    remove (scratch_path);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (argc != 3, EXIT_FAILURE, "usage : %s <elf file> <scratch file>\n", argv[0]);
+
+    Bool status = True;
+    TEST_RUN (status, test_sections (argv[1]));
+    TEST_RUN (status, test_symbols (argv[1]));
+    TEST_RUN (status, test_invalid_rejected (argv[1], argv[2]));
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,102 @@
+/**
+ * @file Cache.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/CrossFile/Otf/Cache.h>
+#include <Anvie/CrossFile/Otf/Otf.h>
+
+/* libc */
+#include <sys/stat.h>
+
+/* local includes */
+#include <Test.h>
+
+static Bool test_decoded_size_counts_file (CString filename) {
+    struct stat st;
+    TEST_CHECK (!stat (filename, &st));
+
+    OtfFile font;
+    TEST_CHECK (otf_file_open (&font, filename));
+
+    /* the whole file stays mapped, so it must be part of the estimate */
+    Size decoded_size = otf_file_get_decoded_size (&font);
+    Bool counts_file  = font.size == (Size)st.st_size && decoded_size > font.size;
+
+    otf_file_close (&font);
+    TEST_CHECK (counts_file);
+    return True;
+}
+
+static Bool test_cache_hits_and_eviction (CString filename) {
+    OtfFontCache* cache = otf_font_cache_create (OTF_FONT_CACHE_DEFAULT_BUDGET);
+    TEST_CHECK (cache);
+
+    OtfSharedFile* first  = otf_font_cache_open (cache, filename);
+    OtfSharedFile* second = otf_font_cache_open (cache, filename);
+
+    OtfFontCacheStats stats;
+    otf_font_cache_get_stats (cache, &stats);
+
+    Bool same_font = first && first == second;
+    Bool counted   = stats.misses == 1 && stats.hits == 1 && stats.entry_count == 1 &&
+                   stats.decoded_bytes ==
+                       otf_file_get_decoded_size ((OtfFile*)otf_shared_file_get_file (first));
+
+    /* budget below size of one font drops the cache's reference but not ours */
+    otf_font_cache_set_budget (cache, 1);
+    otf_font_cache_get_stats (cache, &stats);
+    Bool evicted = stats.evictions == 1 && stats.entry_count == 0 && !stats.decoded_bytes &&
+                   otf_shared_file_get_ref_count (first) == 2;
+
+    if (first) {
+        otf_shared_file_unref (first);
+    }
+    if (second) {
+        otf_shared_file_unref (second);
+    }
+    otf_font_cache_destroy (cache);
+
+    TEST_CHECK (same_font);
+    TEST_CHECK (counted);
+    TEST_CHECK (evicted);
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (argc != 2, EXIT_FAILURE, "usage : %s <font file>\n", argv[0]);
+
+    Bool status = True;
+    TEST_RUN (status, test_decoded_size_counts_file (argv[1]));
+    TEST_RUN (status, test_cache_hits_and_eviction (argv[1]));
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,153 @@
+/**
+ * @file Compiled.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/CrossFile/Otf/Compiled.h>
+#include <Anvie/CrossFile/Otf/Otf.h>
+#include <Anvie/CrossFile/Otf/Shared.h>
+
+/* libc */
+#include <memory.h>
+#include <stdio.h>
+
+/* local includes */
+#include <Test.h>
+
+/* glyph ids of some letters in bundled Lato Regular */
+#define GLYPH_A 36
+#define GLYPH_V 57
+#define GLYPH_O 82
+
+static Bool test_write_and_reopen (CString font_path, CString compiled_path) {
+    OtfFile font;
+    TEST_CHECK (otf_file_open (&font, font_path));
+    OtfFile* written = otf_compiled_write (&font, font_path, compiled_path);
+    otf_file_close (&font);
+    TEST_CHECK (written);
+
+    OtfCompiled compiled;
+    TEST_CHECK (otf_compiled_open (&compiled, compiled_path, font_path));
+
+    Bool status = compiled.header->num_glyphs > 0 &&
+                  otf_compiled_find_table_record (&compiled, OTF_TABLE_TAG_CMAP) &&
+                  otf_compiled_get_glyph_id (&compiled, 'A') == GLYPH_A &&
+                  otf_compiled_get_glyph_id (&compiled, 'V') == GLYPH_V &&
+                  otf_compiled_get_glyph_id (&compiled, 'o') == GLYPH_O;
+
+    Size        length = 0;
+    const Char* family = otf_compiled_get_name (
+        &compiled,
+        OTF_NAME_ID_FONT_FAMILY_NAME,
+        3 /* windows */,
+        1 /* unicode bmp */,
+        0x409 /* en-US */,
+        &length
+    );
+    /* windows names are UTF-16BE, "Lato" */
+    status = status && family && length == 8 && !memcmp (family, "\0L\0a\0t\0o", 8);
+
+    otf_compiled_close (&compiled);
+    TEST_CHECK (status);
+    return True;
+}
+
+static Bool test_matches_decoded_font (CString font_path, CString compiled_path) {
+    OtfSharedFile* shared = otf_shared_file_open (font_path);
+    TEST_CHECK (shared);
+
+    OtfCompiled compiled;
+    if (!otf_compiled_open (&compiled, compiled_path, font_path)) {
+        otf_shared_file_unref (shared);
+        TEST_CHECK (False);
+    }
+
+    Bool status = True;
+    for (Uint32 c = 0; c < 0x3000 && status; c++) {
+        status = otf_compiled_get_glyph_id (&compiled, c) ==
+                 otf_shared_file_get_glyph_id (shared, c);
+    }
+
+    for (Uint32 g = 0; g < compiled.header->num_glyphs && status; g++) {
+        status = otf_compiled_get_advance_width (&compiled, g) ==
+                     otf_shared_file_get_advance_width (shared, g) &&
+                 otf_compiled_get_left_side_bearing (&compiled, g) ==
+                     otf_shared_file_get_left_side_bearing (shared, g);
+    }
+
+    otf_compiled_close (&compiled);
+    otf_shared_file_unref (shared);
+    TEST_CHECK (status);
+    return True;
+}
+
+static Bool test_truncated_is_rejected (CString font_path, CString compiled_path) {
+    FILE* in = fopen (compiled_path, "rb");
+    TEST_CHECK (in);
+
+    Char   buf[4096];
+    Size   size = fread (buf, 1, sizeof (buf), in);
+    fclose (in);
+    TEST_CHECK (size > sizeof (OtfCompiledHeader));
+
+    Char truncated_path[1024];
+    snprintf (truncated_path, sizeof (truncated_path), "%s.truncated", compiled_path);
+
+    FILE* out = fopen (truncated_path, "wb");
+    TEST_CHECK (out);
+    Bool written = fwrite (buf, 1, size / 2, out) == size / 2;
+    fclose (out);
+    TEST_CHECK (written);
+
+    OtfCompiled compiled;
+    Bool        rejected = !otf_compiled_open (&compiled, truncated_path, font_path);
+    remove (truncated_path);
+
+    TEST_CHECK (rejected);
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (
+        argc != 3,
+        EXIT_FAILURE,
+        "usage : %s <font file> <compiled font file>\n",
+        argv[0]
+    );
+
+    Bool status = True;
+    TEST_RUN (status, test_write_and_reopen (argv[1], argv[2]));
+    TEST_RUN (status, test_matches_decoded_font (argv[1], argv[2]));
+    TEST_RUN (status, test_truncated_is_rejected (argv[1], argv[2]));
+
+    remove (argv[2]);
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,199 @@
+/**
+ * @file Edit.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/CrossFile/Otf/Edit.h>
+#include <Anvie/CrossFile/Otf/Shared.h>
+
+/* libc */
+#include <memory.h>
+#include <stdio.h>
+
+/* local includes */
+#include <Test.h>
+
+/* glyph ids of some letters in bundled Lato Regular */
+#define GLYPH_A 36
+#define GLYPH_V 57
+
+#define EDITED_ADVANCE_WIDTH 1234
+#define NAME_TABLE_GROWTH    4096
+
+/* REF : https://learn.microsoft.com/en-us/typography/opentype/spec/otff#calculating-checksums */
+#define OTF_CHECKSUM_MAGIC 0xB1B0AFBA
+
+static Bool copy_file (CString from, CString to) {
+    FILE* in  = fopen (from, "rb");
+    FILE* out = fopen (to, "wb");
+
+    Bool  status = in && out;
+    Uint8 buf[4096];
+    Size  size;
+    while (status && (size = fread (buf, 1, sizeof (buf), in))) {
+        status = fwrite (buf, 1, size, out) == size;
+    }
+
+    if (in) {
+        fclose (in);
+    }
+    if (out) {
+        fclose (out);
+    }
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Sum of whole file as big endian Uint32 values must match checksum magic
+ * when @c checkSumAdjustment in head table is correct.
+ * */
+static Bool file_checksum_is_valid (CString filename) {
+    FILE* file = fopen (filename, "rb");
+    TEST_CHECK (file);
+
+    Uint32 sum = 0;
+    Uint8  word[4];
+    Size   size;
+    while ((size = fread (word, 1, sizeof (word), file))) {
+        memset (word + size, 0, sizeof (word) - size);
+        sum += ((Uint32)word[0] << 24) | ((Uint32)word[1] << 16) | ((Uint32)word[2] << 8) | word[3];
+    }
+    fclose (file);
+
+    TEST_CHECK (sum == OTF_CHECKSUM_MAGIC);
+    return True;
+}
+
+static Bool test_edit_commit_save (OtfFile* font, CString filename) {
+    OtfEditSession session;
+    TEST_CHECK (otf_edit_session_init (&session, font, filename));
+
+    /* in place edit of advance width of A, hmtx starts with long metrics */
+    Size   hmtx_size = 0;
+    Uint8* hmtx      = otf_edit_session_get_table (&session, OTF_TABLE_TAG_HMTX, &hmtx_size);
+    Bool   status    = hmtx && hmtx_size >= (GLYPH_A + 1) * 4 && GLYPH_A < font->hmtx.num_h_metrics;
+    if (status) {
+        hmtx[GLYPH_A * 4]     = EDITED_ADVANCE_WIDTH >> 8;
+        hmtx[GLYPH_A * 4 + 1] = EDITED_ADVANCE_WIDTH & 0xff;
+        status                = !!otf_edit_session_mark_dirty (&session, OTF_TABLE_TAG_HMTX);
+    }
+
+    /* only hmtx must be decoded again */
+    OtfNameRecord*  name_records  = font->name.name_records;
+    OtfKerningPair* kerning_pairs = font->kerning.pairs;
+
+    status = status && otf_edit_session_commit (&session) &&
+             font->hmtx.h_metrics[GLYPH_A].advance_width == EDITED_ADVANCE_WIDTH &&
+             font->name.name_records == name_records && font->kerning.pairs == kerning_pairs;
+
+    /* grow name table by trailing storage so that it no longer fits in it's slot */
+    OtfTableRecord* name_record =
+        otf_table_dir_find_record (&font->table_directory, OTF_TABLE_TAG_NAME);
+    Uint32 old_name_offset = name_record ? name_record->offset : 0;
+    Size   name_size       = 0;
+    Uint8* name            = otf_edit_session_get_table (&session, OTF_TABLE_TAG_NAME, &name_size);
+    Uint8* grown           = name ? ALLOCATE (Uint8, name_size + NAME_TABLE_GROWTH) : Null;
+
+    status = status && name_record && grown;
+    if (status) {
+        memcpy (grown, name, name_size);
+        memset (grown + name_size, 0, NAME_TABLE_GROWTH);
+        status = otf_edit_session_replace_table (
+                     &session,
+                     OTF_TABLE_TAG_NAME,
+                     grown,
+                     name_size + NAME_TABLE_GROWTH
+                 ) &&
+                 otf_edit_session_save (&session) && name_record->offset != old_name_offset &&
+                 name_record->length == name_size + NAME_TABLE_GROWTH;
+    }
+
+    if (grown) {
+        FREE (grown);
+    }
+    otf_edit_session_deinit (&session);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+static Bool test_saved_font_reopens (CString filename) {
+    TEST_CHECK (file_checksum_is_valid (filename));
+
+    OtfSharedFile* shared = otf_shared_file_open (filename);
+    TEST_CHECK (shared);
+
+    Size        length = 0;
+    const Char* family = otf_shared_file_get_name (
+        shared,
+        OTF_NAME_ID_FONT_FAMILY_NAME,
+        3 /* windows */,
+        1 /* unicode bmp */,
+        0x409 /* en-US */,
+        &length
+    );
+
+    /* edited width survives, untouched tables are still intact */
+    Bool status = otf_shared_file_get_advance_width (shared, GLYPH_A) == EDITED_ADVANCE_WIDTH &&
+                  otf_shared_file_get_glyph_id (shared, 'A') == GLYPH_A &&
+                  otf_shared_file_get_kerning (shared, GLYPH_A, GLYPH_V) == -136 && family &&
+                  length == 8 && !memcmp (family, "\0L\0a\0t\0o", 8);
+
+    otf_shared_file_unref (shared);
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (
+        argc != 3,
+        EXIT_FAILURE,
+        "usage : %s <font file> <scratch font file>\n",
+        argv[0]
+    );
+
+    /* never edit bundled font itself */
+    RETURN_VALUE_IF (!copy_file (argv[1], argv[2]), EXIT_FAILURE, "Failed to copy font\n");
+
+    OtfFile font;
+    RETURN_VALUE_IF (!otf_file_open (&font, argv[2]), EXIT_FAILURE, "Failed to open font\n");
+
+    Bool status = True;
+    TEST_RUN (status, test_edit_commit_save (&font, argv[2]));
+    otf_file_close (&font);
+
+    TEST_RUN (status, test_saved_font_reopens (argv[2]));
+
+    remove (argv[2]);
+    return TEST_EXIT_STATUS (status);
+}
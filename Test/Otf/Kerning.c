@@ -0,0 +1,199 @@
+/**
+ * @file Kerning.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/CrossFile/Otf/Otf.h>
+
+/* libc */
+#include <memory.h>
+
+/* local includes */
+#include <Test.h>
+
+/* glyph ids of some letters in bundled Lato Regular */
+#define GLYPH_A     36
+#define GLYPH_L     47
+#define GLYPH_P     51
+#define GLYPH_T     55
+#define GLYPH_V     57
+#define GLYPH_O     82
+#define GLYPH_COMMA 15
+
+static Bool test_tables_decoded (OtfFile* font) {
+    TEST_CHECK (otf_table_dir_find_record (&font->table_directory, OTF_TABLE_TAG_KERN));
+    TEST_CHECK (otf_table_dir_find_record (&font->table_directory, OTF_TABLE_TAG_GPOS));
+
+    /* Lato has one format 0 kern subtable and one pair adjustment subtable in GPOS */
+    TEST_CHECK (font->kern.num_tables == 1);
+    TEST_CHECK (font->kern.subtables[0].num_pairs == 4643);
+    TEST_CHECK (font->gpos.num_pair_adjustments == 1);
+    TEST_CHECK (font->gpos.pair_adjustments[0].num_covered_glyphs > 0);
+
+    return True;
+}
+
+static Bool test_gpos_kerning (OtfFile* font) {
+    TEST_CHECK (otf_file_get_kerning (font, GLYPH_A, GLYPH_V) == -136);
+    TEST_CHECK (otf_file_get_kerning (font, GLYPH_V, GLYPH_A) == -136);
+    TEST_CHECK (otf_file_get_kerning (font, GLYPH_T, GLYPH_O) == -210);
+    TEST_CHECK (otf_file_get_kerning (font, GLYPH_L, GLYPH_T) == -172);
+    TEST_CHECK (otf_file_get_kerning (font, GLYPH_P, GLYPH_COMMA) == -248);
+
+    /* pairs not kerned in font */
+    TEST_CHECK (otf_file_get_kerning (font, GLYPH_A, GLYPH_A) == 0);
+    TEST_CHECK (otf_file_get_kerning (font, font->maxp.num_glyphs - 1, GLYPH_A) == 0);
+
+    /* every pair in legacy kern table has same value in GPOS */
+    OtfKernSubtable* subtable = font->kern.subtables;
+    for (Size s = 0; s < subtable->num_pairs; s++) {
+        OtfKernPair* pair = subtable->pairs + s;
+        TEST_CHECK (otf_file_get_kerning (font, pair->left, pair->right) == pair->value);
+    }
+
+    return True;
+}
+
+static Bool test_kern_table_kerning (OtfFile* font) {
+    /* compile kerning from kern table only, as done for fonts without GPOS */
+    OtfGpos    no_gpos = {0};
+    OtfKerning kerning = {0};
+    TEST_CHECK (otf_kerning_init (&kerning, &no_gpos, &font->kern, font->maxp.num_glyphs));
+
+    Bool ok = otf_kerning_get (&kerning, GLYPH_A, GLYPH_V) == -136 &&
+              otf_kerning_get (&kerning, GLYPH_T, GLYPH_O) == -210 &&
+              otf_kerning_get (&kerning, GLYPH_A, GLYPH_A) == 0;
+
+    otf_kerning_deinit (&kerning);
+    TEST_CHECK (ok);
+
+    return True;
+}
+
+/* glyph ids used in hand made GPOS table */
+#define TEST_GLYPH_A     1
+#define TEST_GLYPH_V     2
+#define TEST_GLYPH_T     3
+#define TEST_GLYPH_O     4
+#define TEST_GLYPH_COUNT 10
+
+/* clang-format off */
+/**
+ * GPOS table with two "kern" lookups, each with a glyph pair and a class pair subtable.
+ *
+ * lookup 0 : (A, V) = -50, then classes {A} x {V, o} = -7 and {T} x {V, o} = -30
+ * lookup 1 : classes {A} x {V} = -5, then pairs (A, V) = -100 and (T, o) = -3
+ *
+ * (A, V) of lookup 1 is shadowed by the earlier class subtable, so
+ * (A, V) = -50 - 5, (A, o) = -7, (T, o) = -30 - 3 and (T, V) = -30.
+ * */
+static Uint8 two_lookups_gpos[] = {
+    /* header : version 1.0, no script list, feature list at 10, lookup list at 26 */
+    0, 1, 0, 0, 0, 0, 0, 10, 0, 26,
+
+    /* feature list : one "kern" feature with lookups 0 and 1 */
+    0, 1, 'k', 'e', 'r', 'n', 0, 8,
+    0, 0, 0, 2, 0, 0, 0, 1,
+
+    /* lookup list : two lookups */
+    0, 2, 0, 6, 0, 92,
+
+    /* lookup 0 : pair adjustment, two subtables */
+    0, 2, 0, 0, 0, 2, 0, 10, 0, 34,
+
+    /* lookup 0, subtable 0 : format 1, x advance only, one pair set */
+    0, 1, 0, 18, 0, 4, 0, 0, 0, 1, 0, 12,
+    0, 1, 0, TEST_GLYPH_V, 0xff, 0xce,             /* pair set A : (V, -50) */
+    0, 1, 0, 1, 0, TEST_GLYPH_A,                   /* coverage : A */
+
+    /* lookup 0, subtable 1 : format 2, 2 x 2 classes */
+    0, 2, 0, 24, 0, 4, 0, 0, 0, 32, 0, 40, 0, 2, 0, 2,
+    0, 0, 0xff, 0xf9,                              /* class1 0 : 0, -7 */
+    0, 0, 0xff, 0xe2,                              /* class1 1 : 0, -30 */
+    0, 1, 0, 2, 0, TEST_GLYPH_A, 0, TEST_GLYPH_T,  /* coverage : A, T */
+    0, 1, 0, TEST_GLYPH_T, 0, 1, 0, 1,             /* class def 1 : T = 1 */
+    0, 1, 0, TEST_GLYPH_V, 0, 3, 0, 1, 0, 0, 0, 1, /* class def 2 : V = 1, T = 0, o = 1 */
+
+    /* lookup 1 : pair adjustment, two subtables */
+    0, 2, 0, 0, 0, 2, 0, 10, 0, 48,
+
+    /* lookup 1, subtable 0 : format 2, 1 x 2 classes */
+    0, 2, 0, 20, 0, 4, 0, 0, 0, 26, 0, 30, 0, 1, 0, 2,
+    0, 0, 0xff, 0xfb,                              /* class1 0 : 0, -5 */
+    0, 1, 0, 1, 0, TEST_GLYPH_A,                   /* coverage : A */
+    0, 2, 0, 0,                                    /* class def 1 : empty */
+    0, 1, 0, TEST_GLYPH_V, 0, 1, 0, 1,             /* class def 2 : V = 1 */
+
+    /* lookup 1, subtable 1 : format 1, x advance only, two pair sets */
+    0, 1, 0, 26, 0, 4, 0, 0, 0, 2, 0, 14, 0, 20,
+    0, 1, 0, TEST_GLYPH_V, 0xff, 0x9c,             /* pair set A : (V, -100) */
+    0, 1, 0, TEST_GLYPH_O, 0xff, 0xfd,             /* pair set T : (o, -3) */
+    0, 1, 0, 2, 0, TEST_GLYPH_A, 0, TEST_GLYPH_T,  /* coverage : A, T */
+};
+/* clang-format on */
+
+static Bool test_gpos_lookups_accumulate (void) {
+    OtfGpos gpos = {0};
+    TEST_CHECK (otf_gpos_init (&gpos, two_lookups_gpos, sizeof (two_lookups_gpos)));
+    TEST_CHECK (gpos.num_pair_adjustments == 4);
+
+    OtfKerning kerning = {0};
+    Bool       ok      = !!otf_kerning_init (&kerning, &gpos, Null, TEST_GLYPH_COUNT);
+
+    ok = ok && otf_kerning_get (&kerning, TEST_GLYPH_A, TEST_GLYPH_V) == -55 &&
+         otf_kerning_get (&kerning, TEST_GLYPH_A, TEST_GLYPH_O) == -7 &&
+         otf_kerning_get (&kerning, TEST_GLYPH_T, TEST_GLYPH_O) == -33 &&
+         otf_kerning_get (&kerning, TEST_GLYPH_T, TEST_GLYPH_V) == -30 &&
+         otf_kerning_get (&kerning, TEST_GLYPH_A, TEST_GLYPH_T) == 0 &&
+         otf_kerning_get (&kerning, TEST_GLYPH_V, TEST_GLYPH_A) == 0;
+
+    otf_kerning_deinit (&kerning);
+    otf_gpos_deinit (&gpos);
+    TEST_CHECK (ok);
+
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (argc != 2, EXIT_FAILURE, "usage : %s <font file>\n", argv[0]);
+
+    OtfFile font;
+    RETURN_VALUE_IF (!otf_file_open (&font, argv[1]), EXIT_FAILURE, "Failed to open font\n");
+
+    Bool status = True;
+    TEST_RUN (status, test_tables_decoded (&font));
+    TEST_RUN (status, test_gpos_kerning (&font));
+    TEST_RUN (status, test_kern_table_kerning (&font));
+    TEST_RUN (status, test_gpos_lookups_accumulate ());
+
+    otf_file_close (&font);
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file Shared.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/CrossFile/Otf/Cache.h>
+#include <Anvie/CrossFile/Otf/Shared.h>
+
+/* libc */
+#include <pthread.h>
+
+/* local includes */
+#include <Test.h>
+
+/* threaded tests are meant to be run in a build configured with -DCROSSFILE_TSAN=ON */
+#define TEST_THREAD_COUNT 8
+#define TEST_ITERATIONS   2000
+
+/* glyph ids of some letters in bundled Lato Regular */
+#define GLYPH_A 36
+#define GLYPH_V 57
+
+typedef struct SharedTestContext {
+    pthread_barrier_t start;
+    OtfSharedFile*    shared;
+    OtfFontCache*     cache;
+    CString           filename;
+    Bool              results[TEST_THREAD_COUNT];
+    OtfSharedFile*    opened[TEST_THREAD_COUNT];
+} SharedTestContext;
+
+typedef struct SharedTestThread {
+    SharedTestContext* ctx;
+    Size               index;
+} SharedTestThread;
+
+static void* acquire_release_thread (void* arg) {
+    SharedTestThread*  thread = arg;
+    SharedTestContext* ctx    = thread->ctx;
+
+    /* release all threads at once so that they race to build compiled cmap */
+    pthread_barrier_wait (&ctx->start);
+
+    Bool status = True;
+    for (Size i = 0; i < TEST_ITERATIONS && status; i++) {
+        OtfSharedFile* shared = otf_shared_file_ref (ctx->shared);
+        status                = shared == ctx->shared &&
+                 otf_shared_file_get_glyph_id (shared, 'A') == GLYPH_A &&
+                 otf_shared_file_get_glyph_id (shared, 'V') == GLYPH_V &&
+                 otf_shared_file_get_advance_width (shared, GLYPH_A) > 0 &&
+                 otf_shared_file_get_kerning (shared, GLYPH_A, GLYPH_V) < 0;
+        otf_shared_file_unref (shared);
+    }
+
+    ctx->results[thread->index] = status;
+    return Null;
+}
+
+static void* cache_open_thread (void* arg) {
+    SharedTestThread*  thread = arg;
+    SharedTestContext* ctx    = thread->ctx;
+
+    pthread_barrier_wait (&ctx->start);
+    ctx->opened[thread->index] = otf_font_cache_open (ctx->cache, ctx->filename);
+
+    return Null;
+}
+
+static Bool run_threads (SharedTestContext* ctx, void* (*routine) (void*)) {
+    pthread_t        threads[TEST_THREAD_COUNT];
+    SharedTestThread args[TEST_THREAD_COUNT];
+
+    TEST_CHECK (!pthread_barrier_init (&ctx->start, Null, TEST_THREAD_COUNT));
+
+    Size started = 0;
+    for (; started < TEST_THREAD_COUNT; started++) {
+        args[started] = (SharedTestThread) {.ctx = ctx, .index = started};
+        if (pthread_create (threads + started, Null, routine, args + started)) {
+            break;
+        }
+    }
+
+    /* barrier would never open if a thread failed to start */
+    TEST_CHECK (started == TEST_THREAD_COUNT);
+
+    for (Size t = 0; t < started; t++) {
+        pthread_join (threads[t], Null);
+    }
+
+    pthread_barrier_destroy (&ctx->start);
+    return True;
+}
+
+static Bool test_concurrent_acquire_release (CString filename) {
+    SharedTestContext ctx = {.filename = filename};
+    ctx.shared            = otf_shared_file_open (filename);
+    TEST_CHECK (ctx.shared);
+
+    Bool status = run_threads (&ctx, acquire_release_thread);
+    for (Size t = 0; t < TEST_THREAD_COUNT; t++) {
+        status = status && ctx.results[t];
+    }
+
+    /* every thread dropped what it took */
+    status = status && otf_shared_file_get_ref_count (ctx.shared) == 1;
+
+    otf_shared_file_unref (ctx.shared);
+    TEST_CHECK (status);
+    return True;
+}
+
+static Bool test_concurrent_cache_open (CString filename) {
+    SharedTestContext ctx = {.filename = filename};
+    ctx.cache             = otf_font_cache_create (OTF_FONT_CACHE_DEFAULT_BUDGET);
+    TEST_CHECK (ctx.cache);
+
+    Bool status = run_threads (&ctx, cache_open_thread);
+
+    /* all opens must resolve to one decoded font */
+    for (Size t = 0; t < TEST_THREAD_COUNT; t++) {
+        status = status && ctx.opened[t] && ctx.opened[t] == ctx.opened[0];
+    }
+
+    OtfFontCacheStats stats;
+    otf_font_cache_get_stats (ctx.cache, &stats);
+    status = status && stats.misses == 1 && stats.hits + stats.coalesced == TEST_THREAD_COUNT - 1;
+
+    /* cache holds one reference, each thread holds another */
+    status = status && otf_shared_file_get_ref_count (ctx.opened[0]) == TEST_THREAD_COUNT + 1;
+
+    for (Size t = 0; t < TEST_THREAD_COUNT; t++) {
+        if (ctx.opened[t]) {
+            otf_shared_file_unref (ctx.opened[t]);
+        }
+    }
+    otf_font_cache_destroy (ctx.cache);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (argc != 2, EXIT_FAILURE, "usage : %s <font file>\n", argv[0]);
+
+    Bool status = True;
+    TEST_RUN (status, test_concurrent_acquire_release (argv[1]));
+    TEST_RUN (status, test_concurrent_cache_open (argv[1]));
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,62 @@
+/**
+ * @file Test.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_TEST_H
+#define ANVIE_CROSSFILE_TEST_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* libc */
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @b Fail current test case (a function returning @c Bool) when @c cond does not hold.
+ * */
+#define TEST_CHECK(cond)                                                                           \
+    RETURN_VALUE_IF (!(cond), False, "%s:%d : check failed : %s\n", __FILE__, __LINE__, #cond)
+
+/**
+ * @b Run a test case and fold it's result into @c status (a @c Bool).
+ * */
+#define TEST_RUN(status, test_case)                                                                \
+    do {                                                                                           \
+        Bool test_passed__ = test_case;                                                            \
+        fprintf (stderr, "%s : %s\n", test_passed__ ? "PASS" : "FAIL", #test_case);               \
+        status = status && test_passed__;                                                          \
+    } while (0)
+
+#define TEST_EXIT_STATUS(status) ((status) ? EXIT_SUCCESS : EXIT_FAILURE)
+
+#endif // ANVIE_CROSSFILE_TEST_H
@@ -0,0 +1,200 @@
+/**
+ * @file Aot.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+#include <stdio.h>
+
+/* crossfile */
+#include <CrossFile/Xft/Parser/Registry.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* generated from bundled "Elf" schema by xft_aot_generate */
+#include <elf_aot.h>
+
+/* local includes */
+#include <Test.h>
+
+/* memory of an object loaded by bundled "Elf" schema, from a 64-bit ELF file */
+typedef struct TestElf64 {
+    Uint8 ident[16];
+
+    struct {
+        Uint16 type;
+        Uint16 machine;
+        Uint32 version;
+        Uint64 entry;
+        Uint64 phoff;
+        Uint64 shoff;
+        Uint32 flags;
+        Uint16 ehsize;
+        Uint16 phentsize;
+        Uint16 phnum;
+        Uint16 shentsize;
+        Uint16 shnum;
+        Uint16 shstrndx;
+    } header;
+
+    VmVector sections;
+    VmVector segments;
+} TestElf64;
+
+#define TEST_ELF_SECTION_HEADER_SIZE 64
+#define TEST_ELF_PROGRAM_HEADER_SIZE 56
+
+/**
+ * @b Read whole file.
+ *
+ * @return Contents of file on success, owned by caller.
+ * @return @c Null otherwise.
+ * */
+static Uint8* read_file (CString filename, Size* size) {
+    FILE* file = fopen (filename, "rb");
+    RETURN_VALUE_IF (!file, Null, "Failed to open \"%s\"\n", filename);
+
+    Uint8* data = Null;
+    long   len  = -1;
+    if (!fseek (file, 0, SEEK_END) && (len = ftell (file)) > 0 && !fseek (file, 0, SEEK_SET)) {
+        data = ALLOCATE (Uint8, (Size)len);
+    }
+
+    if (data && fread (data, 1, (Size)len, file) != (Size)len) {
+        FREE (data);
+        data = Null;
+    }
+    fclose (file);
+
+    RETURN_VALUE_IF (!data, Null, "Failed to read \"%s\"\n", filename);
+
+    *size = (Size)len;
+    return data;
+}
+
+/**
+ * @b Load given ELF file with compiled loaders and with VM running same schema, and make
+ * sure both produce same object, vector elements included, and stop at same cursor.
+ * */
+static Bool test_aot_matches_vm (CString filename) {
+    Size   size = 0;
+    Uint8* data = read_file (filename, &size);
+    TEST_CHECK (data);
+
+    SchemaRegistry registry;
+    TEST_CHECK (schema_registry_init (&registry, Null));
+
+    SchemaEntry* entry   = schema_registry_find (&registry, "Elf");
+    IoStream*    io      = io_stream_open_file (filename, False);
+    Vm           vm      = {0};
+    TestElf64    vm_elf  = {0};
+    TestElf64    aot_elf = {0};
+    void*        vectors = Null;
+    Size         cursor  = 0;
+
+    Bool status = entry && entry->file_loader && io &&
+                  entry->file_loader->alloc_size == sizeof (TestElf64) &&
+                  vm_run_loader (&vm, entry->file_loader, io, &vm_elf) &&
+                  elf_aot_load_Elf (data, size, &cursor, &aot_elf, &vectors);
+
+    status = status && cursor == (Size)io_stream_get_cursor (io) &&
+             !memcmp (aot_elf.ident, "\x7f" "ELF", 4) && aot_elf.ident[4] == 2 &&
+             !memcmp (aot_elf.ident, vm_elf.ident, sizeof (aot_elf.ident)) &&
+             !memcmp (&aot_elf.header, &vm_elf.header, sizeof (aot_elf.header)) &&
+             aot_elf.sections.count == aot_elf.header.shnum &&
+             aot_elf.segments.count == aot_elf.header.phnum &&
+             aot_elf.sections.count == vm_elf.sections.count &&
+             aot_elf.segments.count == vm_elf.segments.count &&
+             !memcmp (
+                 aot_elf.sections.data,
+                 vm_elf.sections.data,
+                 aot_elf.sections.count * TEST_ELF_SECTION_HEADER_SIZE
+             ) &&
+             !memcmp (
+                 aot_elf.segments.data,
+                 vm_elf.segments.data,
+                 aot_elf.segments.count * TEST_ELF_PROGRAM_HEADER_SIZE
+             );
+
+    elf_aot_free_vectors (vectors);
+    vm_deinit (&vm);
+    if (io) {
+        io_stream_close (io);
+    }
+    schema_registry_deinit (&registry);
+    FREE (data);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Cut given ELF file short in header and in middle of section headers, and make sure
+ * compiled loaders reject both, and vectors loaded before failure can still be released.
+ * */
+static Bool test_aot_rejects_truncated (CString filename) {
+    Size   size = 0;
+    Uint8* data = read_file (filename, &size);
+    TEST_CHECK (data);
+
+    TestElf64 elf     = {0};
+    void*     vectors = Null;
+    Size      cursor  = 0;
+    Bool      status  = elf_aot_load_Elf (data, size, &cursor, &elf, &vectors) &&
+                  elf.header.shnum > 1 && elf.header.shoff < size;
+    Size shoff = elf.header.shoff;
+    elf_aot_free_vectors (vectors);
+
+    Size cuts[] = {16 + sizeof (elf.header) - 1, shoff + TEST_ELF_SECTION_HEADER_SIZE + 1};
+    for (Size c = 0; c < sizeof (cuts) / sizeof (cuts[0]) && status; c++) {
+        memset (&elf, 0, sizeof (elf));
+        vectors = Null;
+        cursor  = 0;
+
+        status = !elf_aot_load_Elf (data, cuts[c], &cursor, &elf, &vectors);
+        elf_aot_free_vectors (vectors);
+    }
+
+    FREE (data);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (argc != 2, EXIT_FAILURE, "usage : %s <64-bit elf file>\n", argv[0]);
+
+    Bool status = True;
+    TEST_RUN (status, test_aot_matches_vm (argv[1]));
+    TEST_RUN (status, test_aot_rejects_truncated (argv[1]));
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file Arrays.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+
+/* crossfile */
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+#include "TestLoader.h"
+
+#define TEST_DATA_SIZE 256
+
+/**
+ * @b Decode an unsigned number of given size and byte order from bytes.
+ * */
+static Uint64 test_decode (const Uint8* bytes, Size size, Bool big_endian) {
+    Uint64 value = 0;
+    for (Size b = 0; b < size; b++) {
+        value |= (Uint64)bytes[big_endian ? size - 1 - b : b] << (8 * b);
+    }
+    return value;
+}
+
+/**
+ * @b Compare an array loaded in memory, in host order, against stream it was read from.
+ * */
+static Bool test_array_matches (
+    const Uint8* mem,
+    const Uint8* stream,
+    Size         size,
+    Size         count,
+    Bool         big_endian
+) {
+    for (Size e = 0; e < count; e++) {
+        Uint64 loaded = 0;
+        memcpy ((Uint8*)&loaded + (HOST_BYTE_ORDER_IS_LSB ? 0 : 8 - size), mem + e * size, size);
+        if (loaded != test_decode (stream + e * size, size, big_endian)) {
+            return False;
+        }
+    }
+    return True;
+}
+
+/**
+ * @b Read arrays of every element size in both byte orders, long enough to need
+ * several vector swaps and a scalar tail each, and make sure every element is in host
+ * order.
+ * */
+static Bool test_ordered_arrays (void) {
+    InsnBlock blocks[] = {
+        TEST_BLOCK (READ_ARR16_BE (0, 37), SEEK_FWD (1)),
+        TEST_BLOCK (READ_ARR32_BE (74, 13), READ_ARR64_BE (126, 7), READ_ARR32_LE (182, 5)),
+    };
+    Loader loader = {
+        .type_name        = "Ordered",
+        .alloc_size       = 202,
+        .insn_blocks      = blocks,
+        .insn_block_count = 2,
+    };
+
+    Uint8 data[TEST_DATA_SIZE];
+    Uint8 mem[202] = {0};
+    for (Size b = 0; b < TEST_DATA_SIZE; b++) {
+        data[b] = (Uint8)(b * 7 + 3);
+    }
+    IoStream io = TEST_STREAM (data);
+    Vm       vm = {0};
+
+    Bool status = vm_run_loader (&vm, &loader, &io, mem) &&
+                  loader.verify_status == LOADER_VERIFY_PASSED && io.cursor == 203 &&
+                  test_array_matches (mem, data, 2, 37, True) &&
+                  test_array_matches (mem + 74, data + 75, 4, 13, True) &&
+                  test_array_matches (mem + 126, data + 127, 8, 7, True) &&
+                  test_array_matches (mem + 182, data + 183, 4, 5, False);
+
+    /* same arrays from a stream that can't fill the last one */
+    io.cursor = TEST_DATA_SIZE - 200;
+    status    = status && !vm_run_loader (&vm, &loader, &io, mem);
+
+    vm_deinit (&vm);
+    test_loader_deinit (&loader);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Read a table of records, each a big endian Uint16 followed by a byte, into memory
+ * with padding between records, and make sure an out of bounds table is rejected.
+ * */
+static Bool test_strided_records (void) {
+    Loader loader = {.type_name = "Records", .alloc_size = 40};
+    Size   id     = 0;
+
+    StructLayout layout = {.field_count = 2, .mem_size = 5, .stream_size = 3};
+    layout.fields       = ALLOCATE (StructLayoutField, 2);
+    TEST_CHECK (layout.fields);
+    layout.fields[0]  = (StructLayoutField) {.size = 2, .count = 1, .swap = HOST_BYTE_ORDER_IS_LSB};
+    layout.fields[1]  = (StructLayoutField) {.mem_off = 4, .stream_off = 2, .size = 1, .count = 1};
+    layout.needs_swap = HOST_BYTE_ORDER_IS_LSB;
+    TEST_CHECK (loader_add_struct_layout (&loader, &layout, &id));
+
+    InsnBlock blocks[]     = {TEST_BLOCK (READ_STRUCT_ARR (0, id, 5, 8))};
+    InsnBlock oob_blocks[] = {TEST_BLOCK (READ_STRUCT_ARR (0, id, 6, 8))};
+
+    loader.insn_blocks      = blocks;
+    loader.insn_block_count = 1;
+
+    Uint8 data[TEST_DATA_SIZE];
+    Uint8 mem[40] = {0};
+    for (Size b = 0; b < TEST_DATA_SIZE; b++) {
+        data[b] = (Uint8)b;
+    }
+    IoStream io = TEST_STREAM (data);
+    Vm       vm = {0};
+
+    Bool status = vm_run_loader (&vm, &loader, &io, mem) &&
+                  loader.verify_status == LOADER_VERIFY_PASSED && io.cursor == 15;
+    for (Size r = 0; status && r < 5; r++) {
+        status = test_array_matches (mem + r * 8, data + r * 3, 2, 1, True) &&
+                 mem[r * 8 + 4] == data[r * 3 + 2] && !mem[r * 8 + 2] && !mem[r * 8 + 5];
+    }
+
+    /* sixth record would be written past end of object */
+    packed_code_deinit (&loader.packed_code);
+    loader.insn_blocks   = oob_blocks;
+    loader.verify_status = LOADER_VERIFY_PENDING;
+    io.cursor            = 0;
+    status               = status && !vm_run_loader (&vm, &loader, &io, mem) &&
+                           loader.verify_status == LOADER_VERIFY_FAILED;
+
+    vm_deinit (&vm);
+    test_loader_deinit (&loader);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_ordered_arrays());
+    TEST_RUN (status, test_strided_records());
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,206 @@
+/**
+ * @file Compiler.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+#include <string.h>
+
+/* crossfile */
+#include <CrossFile/Stream/Stream.h>
+#include <CrossFile/Xft/Parser/Compiler.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+
+/**
+ * @b Compile given source.
+ *
+ * @return @c schema on success.
+ * @return @c Null otherwise.
+ * */
+static Schema* test_compile (Schema* schema, CString source) {
+    memset (schema, 0, sizeof (Schema));
+    return schema_compile_source (schema, source, strlen (source), SCHEMA_FLAG_NONE);
+}
+
+/**
+ * @b Run file loader of given schema over given bytes.
+ *
+ * @return @c True if loader succeeds, and consumes exactly @c size bytes.
+ * @return @c False otherwise.
+ * */
+static Bool test_load (Schema* schema, Vm* vm, Uint8* data, Size size, void* mem) {
+    IoStream io = {.data = data, .size = size, .capacity = size};
+    return vm_run_loader (vm, schema->file_loader, &io, mem) && io.cursor == size;
+}
+
+/**
+ * @b Compile a file with a struct array, and a vector sized by an earlier field, and make
+ * sure fields are laid out like a C struct and loaded from a packed stream, and that its
+ * assertion and end of stream are checked.
+ * */
+static Bool test_compile_struct_layout (void) {
+    static const CString source =
+        "struct P { Uint8 a Uint32 b } file F { Uint16 n P p[2] Uint8 v[n] #assert { n == 3 } }";
+
+    Schema schema = {0};
+    TEST_CHECK (test_compile (&schema, source));
+
+    /* n, padding, two 8 byte P, then vector aligned to 8 bytes */
+    Loader* file   = schema.file_loader;
+    Loader* p      = schema_find_loader (&schema, "P");
+    Bool    status = file && p && file->alloc_size == 24 + sizeof (VmVector) && p->alloc_size == 8;
+
+    Uint16 n = 3;
+    Uint32 b = 0x11223344;
+    Uint8  data[15];
+    memcpy (data, &n, 2);
+    data[2] = 7;
+    memcpy (data + 3, &b, 4);
+    data[7] = 8;
+    memcpy (data + 8, &b, 4);
+    data[12] = 9;
+    data[13] = 10;
+    data[14] = 11;
+
+    Uint8    mem[64] = {0};
+    Uint16   mem_n   = 0;
+    Uint32   mem_b   = 0;
+    VmVector vec     = {0};
+    Vm       vm      = {0};
+
+    status = status && test_load (&schema, &vm, data, sizeof (data), mem);
+    if (status) {
+        memcpy (&mem_n, mem, 2);
+        memcpy (&mem_b, mem + 16, 4);
+        memcpy (&vec, mem + 24, sizeof (vec));
+    }
+    status = status && mem_n == 3 && mem[4] == 7 && mem[12] == 8 && mem_b == b &&
+             vec.count == 3 && !memcmp (vec.data, data + 12, 3);
+
+    /* assertion fails */
+    n = 2;
+    memcpy (data, &n, 2);
+    status = status && !test_load (&schema, &vm, data, sizeof (data) - 1, mem);
+
+    /* vector runs past end of stream */
+    n = 3;
+    memcpy (data, &n, 2);
+    status = status && !test_load (&schema, &vm, data, sizeof (data) - 1, mem);
+
+    vm_deinit (&vm);
+    schema_deinit (&schema);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Compile a typedef selected by an enum field, and make sure each case loads its own
+ * struct, and a value matching no case fails.
+ * */
+static Bool test_compile_typedef_cases (void) {
+    static const CString source = "enum E : Uint8 { X = 1 Y = 2 } "
+                                  "struct P { Uint8 v } struct Q { Uint16 v } "
+                                  "typedef T<E> { X : P Y : Q } "
+                                  "file F { Uint8 t T<t> v }";
+
+    Schema schema = {0};
+    TEST_CHECK (test_compile (&schema, source));
+
+    Uint16 w      = 0x1234;
+    Uint8  x[]    = {1, 0x56};
+    Uint8  y[3]   = {2};
+    Uint8  z[]    = {3, 0, 0};
+    Uint8  mem[4] = {0};
+    Uint16 mem_w  = 0;
+    Vm     vm     = {0};
+    memcpy (y + 1, &w, 2);
+
+    /* t, padding, then a union of P and Q */
+    Bool status = schema.file_loader && schema.file_loader->alloc_size == 4;
+    status      = status && test_load (&schema, &vm, x, sizeof (x), mem);
+    status      = status && mem[0] == 1 && mem[2] == 0x56;
+    status      = status && test_load (&schema, &vm, y, sizeof (y), mem) && mem[0] == 2;
+    if (status) {
+        memcpy (&mem_w, mem + 2, 2);
+    }
+    status = status && mem_w == w;
+
+    /* no case for 3 */
+    status = status && !test_load (&schema, &vm, z, sizeof (z), mem);
+
+    vm_deinit (&vm);
+    schema_deinit (&schema);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure descriptions that can't be loaded are rejected.
+ * */
+static Bool test_compile_errors (void) {
+    static const CString sources[] = {
+        "file F { Foo x }",
+        "struct A { Uint8 a } struct A { Uint8 b }",
+        "struct A { Uint8 a Uint8 a }",
+        "struct A { A a }",
+        "file F { Uint8 a } file G { Uint8 b }",
+        "enum E : Uint8 { X = 1 } struct P { Uint8 v } typedef T<E> { Z : P }",
+        "file F { Uint8 a #assert { 1 == 2 } }",
+    };
+
+    Bool status = True;
+    for (Size s = 0; s < sizeof (sources) / sizeof (sources[0]); s++) {
+        Schema schema = {0};
+        if (test_compile (&schema, sources[s])) {
+            PRINT_ERR ("Compiled invalid description \"%s\"\n", sources[s]);
+            schema_deinit (&schema);
+            status = False;
+        }
+    }
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_compile_struct_layout());
+    TEST_RUN (status, test_compile_typedef_cases());
+    TEST_RUN (status, test_compile_errors());
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,199 @@
+/**
+ * @file Fold.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+#include <string.h>
+
+/* crossfile */
+#include <CrossFile/Stream/Stream.h>
+#include <CrossFile/Xft/Parser/Compiler.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+
+/**
+ * @b Compile given source.
+ *
+ * @return @c schema on success.
+ * @return @c Null otherwise.
+ * */
+static Schema* test_compile (Schema* schema, CString source) {
+    memset (schema, 0, sizeof (Schema));
+    return schema_compile_source (schema, source, strlen (source), SCHEMA_FLAG_NONE);
+}
+
+/**
+ * @b Whether given loader is a single @c INSN_TYPE_READ_STRUCT, followed by nothing but
+ * it's exit.
+ * */
+static Bool test_is_single_read (Loader* loader) {
+    return loader && loader->insn_block_count == 1 && loader->struct_layout_count == 1 &&
+           loader->insn_blocks[0].insn_count == 2 &&
+           loader->insn_blocks[0].insns[0].insn_type == INSN_TYPE_READ_STRUCT;
+}
+
+/**
+ * @b Make sure array sizes made of numbers, enum members and aliases are folded, so
+ * arrays are stored inline, and the whole file is read by a single precomputed layout.
+ * */
+static Bool test_fold_array_sizes (void) {
+    static const CString source = "enum E : Uint8 { N = 3 } "
+                                  "file F { #alias { k : 3 + 1 } "
+                                  "Uint8 x[N + 1] Uint8 y[k * 2] Uint8 z[(~0) >> 62] }";
+
+    Schema schema = {0};
+    TEST_CHECK (test_compile (&schema, source));
+
+    Loader* file   = schema.file_loader;
+    Bool    status = file && file->alloc_size == 15 && test_is_single_read (file);
+    status         = status && file->fixed_status == LOADER_FIXED_YES;
+    status         = status && file->fixed_stream_size == 15;
+
+    Uint8 data[15];
+    for (Size b = 0; b < sizeof (data); b++) {
+        data[b] = (Uint8)(b + 1);
+    }
+
+    Uint8    mem[15] = {0};
+    IoStream io      = {.data = data, .size = sizeof (data), .capacity = sizeof (data)};
+    Vm       vm      = {0};
+    status           = status && vm_run_loader (&vm, file, &io, mem) && io.cursor == sizeof (data);
+    status           = status && !memcmp (mem, data, sizeof (data));
+
+    vm_deinit (&vm);
+    schema_deinit (&schema);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure a plain struct gets a C layout, computed before anything is loaded, with
+ * padding skipped when it's read from a packed stream.
+ * */
+static Bool test_precompute_layout (void) {
+    static const CString source = "struct P { Uint8 a Uint32 b Uint16 c } file F { P p[2] }";
+
+    Schema schema = {0};
+    TEST_CHECK (test_compile (&schema, source));
+
+    Loader* p      = schema_find_loader (&schema, "P");
+    Bool    status = test_is_single_read (p) && p->alloc_size == 12;
+    status         = status && p->fixed_status == LOADER_FIXED_YES && p->fixed_stream_size == 7;
+
+    StructLayout* layout = status ? p->struct_layouts : Null;
+    status = status && layout->field_count == 3 && layout->mem_size == 12 &&
+             layout->stream_size == 7 && !layout->is_dense;
+    status = status && layout->fields[0].mem_off == 0 && layout->fields[0].stream_off == 0 &&
+             layout->fields[1].mem_off == 4 && layout->fields[1].stream_off == 1 &&
+             layout->fields[2].mem_off == 8 && layout->fields[2].stream_off == 5;
+
+    /* nested plain struct is read in place by it's parent */
+    Loader* file = schema.file_loader;
+    status = status && test_is_single_read (file) && file->alloc_size == 24 &&
+             file->fixed_stream_size == 14;
+
+    schema_deinit (&schema);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure a constant type argument selects a typedef case at compile time.
+ * */
+static Bool test_fold_typedef_case (void) {
+    static const CString source = "enum E : Uint8 { X = 1 Y = 2 } "
+                                  "struct P { Uint8 v } struct Q { Uint16 v } "
+                                  "typedef T<E> { X : P Y : Q } "
+                                  "file F { T<Y> t }";
+
+    Schema schema = {0};
+    TEST_CHECK (test_compile (&schema, source));
+
+    Loader* file   = schema.file_loader;
+    Bool    status = file && file->alloc_size == 2 && !file->switch_table_count;
+
+    Uint16   value  = 0x1234;
+    Uint16   mem    = 0;
+    IoStream io     = {.data = (Uint8*)&value, .size = 2, .capacity = 2};
+    Vm       vm     = {0};
+    status          = status && vm_run_loader (&vm, file, &io, &mem) && mem == value;
+
+    vm_deinit (&vm);
+    schema_deinit (&schema);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure assertions that always hold are dropped, and constant expressions that
+ * can't hold or be evaluated fail compilation.
+ * */
+static Bool test_fold_assertions (void) {
+    Schema schema = {0};
+    TEST_CHECK (test_compile (&schema, "file F { Uint8 a #assert { 1 == 1 2 > 1 } }"));
+
+    Bool status = test_is_single_read (schema.file_loader) && !schema.file_loader->check.term_count;
+    schema_deinit (&schema);
+
+    static const CString sources[] = {
+        "file F { Uint8 a #assert { 1 == 2 } }",
+        "file F { Uint8 a[4 / (2 - 2)] }",
+        "file F { #alias { k : 3 + 1 } Uint8 a[k] Uint8 b[a.x] }",
+    };
+
+    for (Size s = 0; s < sizeof (sources) / sizeof (sources[0]); s++) {
+        if (test_compile (&schema, sources[s])) {
+            PRINT_ERR ("Compiled invalid description \"%s\"\n", sources[s]);
+            schema_deinit (&schema);
+            status = False;
+        }
+    }
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_fold_array_sizes());
+    TEST_RUN (status, test_precompute_layout());
+    TEST_RUN (status, test_fold_typedef_case());
+    TEST_RUN (status, test_fold_assertions());
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,154 @@
+/**
+ * @file Jit.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* libc */
+#include <memory.h>
+
+/* crossfile */
+#include <CrossFile/Xft/Parser/Registry.h>
+#include <CrossFile/Xft/Vm/Jit.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+
+/* enough loads for element loaders to pass VM_JIT_THRESHOLD many times over */
+#define TEST_LOAD_COUNT 4
+
+/* memory of an object loaded by bundled "Elf" schema, from a 64-bit ELF file */
+typedef struct TestElf64 {
+    Uint8 ident[16];
+
+    struct {
+        Uint16 type;
+        Uint16 machine;
+        Uint32 version;
+        Uint64 entry;
+        Uint64 phoff;
+        Uint64 shoff;
+        Uint32 flags;
+        Uint16 ehsize;
+        Uint16 phentsize;
+        Uint16 phnum;
+        Uint16 shentsize;
+        Uint16 shnum;
+        Uint16 shstrndx;
+    } header;
+
+    VmVector sections;
+    VmVector segments;
+} TestElf64;
+
+#define TEST_ELF_SECTION_HEADER_SIZE 64
+#define TEST_ELF_PROGRAM_HEADER_SIZE 56
+
+/**
+ * @b Load given ELF file again and again with same VM, so that element loaders are
+ * compiled after first few loads, and make sure every load produces same object and
+ * checks same number of objects as the first, fully interpreted, one.
+ *
+ * Building with @c XFT_VM_JIT_DIFFERENTIAL additionally executes every native
+ * execution through interpreter and fails the load on any difference.
+ * */
+static Bool test_repeated_loads_match (CString filename) {
+    SchemaRegistry registry;
+    TEST_CHECK (schema_registry_init (&registry, Null));
+
+    SchemaEntry* entry = schema_registry_find (&registry, "Elf");
+    IoStream*    io    = io_stream_open_file (filename, False);
+    Vm           vm    = {0};
+    TestElf64    loaded[TEST_LOAD_COUNT];
+    Size         checked[TEST_LOAD_COUNT];
+
+    Bool status = entry && entry->file_loader && io &&
+                  entry->file_loader->alloc_size == sizeof (TestElf64);
+
+    for (Size l = 0; l < TEST_LOAD_COUNT && status; l++) {
+        Size checks = vm.checks_run + vm.checks_skipped;
+        memset (loaded + l, 0, sizeof (TestElf64));
+
+        status = io_stream_set_cursor (io, 0) &&
+                 vm_run_loader (&vm, entry->file_loader, io, loaded + l);
+        checked[l] = vm.checks_run + vm.checks_skipped - checks;
+    }
+
+    const TestElf64* first = loaded;
+    status = status && !memcmp (first->ident, "\x7f" "ELF", 4) && first->ident[4] == 2 &&
+             first->sections.count == first->header.shnum &&
+             first->segments.count == first->header.phnum;
+
+    for (Size l = 1; l < TEST_LOAD_COUNT && status; l++) {
+        const TestElf64* elf = loaded + l;
+        status = checked[l] == checked[0] && !memcmp (elf->ident, first->ident, 16) &&
+                 !memcmp (&elf->header, &first->header, sizeof (elf->header)) &&
+                 elf->sections.count == first->sections.count &&
+                 elf->segments.count == first->segments.count &&
+                 !memcmp (
+                     elf->sections.data,
+                     first->sections.data,
+                     elf->sections.count * TEST_ELF_SECTION_HEADER_SIZE
+                 ) &&
+                 !memcmp (
+                     elf->segments.data,
+                     first->segments.data,
+                     elf->segments.count * TEST_ELF_PROGRAM_HEADER_SIZE
+                 );
+    }
+
+#if VM_JIT_ENABLED
+    /* section headers are loaded once per section, far more often than threshold */
+    Loader* section_loader = entry ? schema_entry_find_loader (entry, "ElfSectionHeader64") : Null;
+    status = status && section_loader && section_loader->jit_status == LOADER_JIT_COMPILED;
+#endif
+
+    vm_deinit (&vm);
+    if (io) {
+        io_stream_close (io);
+    }
+    schema_registry_deinit (&registry);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (argc != 2, EXIT_FAILURE, "usage : %s <64-bit elf file>\n", argv[0]);
+
+    Bool status = True;
+    TEST_RUN (status, test_repeated_loads_match (argv[1]));
+
+    return TEST_EXIT_STATUS (status);
+}
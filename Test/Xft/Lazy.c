@@ -0,0 +1,183 @@
+/**
+ * @file Lazy.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+#include <string.h>
+
+/* crossfile */
+#include <CrossFile/Stream/Stream.h>
+#include <CrossFile/Xft/Parser/Compiler.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+
+/**
+ * @b Compile given source.
+ *
+ * @return @c schema on success.
+ * @return @c Null otherwise.
+ * */
+static Schema* test_compile (Schema* schema, CString source, SchemaFlags flags) {
+    memset (schema, 0, sizeof (Schema));
+    return schema_compile_source (schema, source, strlen (source), flags);
+}
+
+/**
+ * @b Load a lazy array of fixed size records, and make sure only it's descriptor is
+ * stored, and any range of it loads same as it would eagerly, without moving cursor.
+ * */
+static Bool test_lazy_fixed_stride (void) {
+    static const CString source =
+        "struct R { Uint16 a Uint16 b } file F { Uint8 n Uint8 off R r[n](+ off) }";
+
+    Schema lazy_schema  = {0};
+    Schema eager_schema = {0};
+    TEST_CHECK (test_compile (&lazy_schema, source, SCHEMA_FLAG_LAZY));
+    TEST_CHECK (test_compile (&eager_schema, source, SCHEMA_FLAG_NONE));
+
+    /* n, offset, two unused bytes, then records */
+    Uint8 data[16] = {3, 4};
+    for (Size b = 4; b < sizeof (data); b++) {
+        data[b] = (Uint8)(b * 3);
+    }
+
+    Uint8      mem[64]   = {0};
+    Uint8      elems[12] = {0};
+    SchemaLazy lazy      = {0};
+    VmVector   vec       = {0};
+    IoStream   io        = {.data = data, .size = sizeof (data), .capacity = sizeof (data)};
+    Vm         vm        = {0};
+
+    Loader* file   = lazy_schema.file_loader;
+    Bool    status = file && file->alloc_size == 8 + sizeof (SchemaLazy);
+    status         = status && vm_run_loader (&vm, file, &io, mem) && io.cursor == 2;
+    if (status) {
+        memcpy (&lazy, mem + 8, sizeof (lazy));
+    }
+    status = status && lazy.offset == 4 && lazy.count == 3 && lazy.stride == 4;
+    status = status && lazy.loader < lazy_schema.loader_count &&
+             lazy_schema.loaders[lazy.loader] == schema_find_loader (&lazy_schema, "R");
+
+    /* last two records, with cursor left where it was */
+    Size cursor = io.cursor;
+    status      = status && schema_load_lazy (&lazy_schema, &vm, &io, &lazy, 1, 2, elems);
+    status      = status && io.cursor == cursor;
+
+    /* same records loaded eagerly */
+    io.cursor = 0;
+    status    = status && vm_run_loader (&vm, eager_schema.file_loader, &io, mem);
+    if (status) {
+        memcpy (&vec, mem + 8, sizeof (vec));
+    }
+    status = status && vec.count == 3 && !memcmp ((Uint8*)vec.data + 4, elems, 8);
+
+    /* range past last element */
+    status = status && !schema_load_lazy (&lazy_schema, &vm, &io, &lazy, 2, 2, elems);
+
+    vm_deinit (&vm);
+    schema_deinit (&lazy_schema);
+    schema_deinit (&eager_schema);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Load a lazy array of records whose size depends on their contents, and make sure an
+ * element is found by reading the ones before it.
+ * */
+static Bool test_lazy_varying_stride (void) {
+    static const CString source = "struct S { Uint8 k Uint8 m[k] } file G { Uint8 a S v[3](+ 1) }";
+
+    Schema schema = {0};
+    TEST_CHECK (test_compile (&schema, source, SCHEMA_FLAG_LAZY));
+
+    Uint8 data[] = {0xff, 1, 10, 2, 20, 21, 3, 30, 31, 32};
+
+    Uint8      mem[64]  = {0};
+    Uint8      elem[64] = {0};
+    SchemaLazy lazy     = {0};
+    VmVector   vec      = {0};
+    IoStream   io       = {.data = data, .size = sizeof (data), .capacity = sizeof (data)};
+    Vm         vm       = {0};
+
+    Bool status = vm_run_loader (&vm, schema.file_loader, &io, mem) != Null;
+    if (status) {
+        memcpy (&lazy, mem + 8, sizeof (lazy));
+    }
+    status = status && mem[0] == 0xff && lazy.offset == 1 && lazy.count == 3 && !lazy.stride;
+
+    Size cursor = io.cursor;
+    status      = status && schema_load_lazy (&schema, &vm, &io, &lazy, 2, 1, elem);
+    status      = status && io.cursor == cursor && elem[0] == 3;
+    if (status) {
+        memcpy (&vec, elem + 8, sizeof (vec));
+    }
+    status = status && vec.count == 3 && !memcmp (vec.data, data + 7, 3);
+
+    /* stream ends inside last element */
+    io.size = sizeof (data) - 1;
+    status  = status && !schema_load_lazy (&schema, &vm, &io, &lazy, 2, 1, elem);
+
+    vm_deinit (&vm);
+    schema_deinit (&schema);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure a lazy field used in an expression is rejected, since it's value isn't
+ * known while loading.
+ * */
+static Bool test_lazy_field_in_expression (void) {
+    static const CString source = "file F { Uint8 n(+ 4) Uint8 v[n] }";
+
+    Schema schema = {0};
+    TEST_CHECK (test_compile (&schema, source, SCHEMA_FLAG_NONE));
+    schema_deinit (&schema);
+
+    TEST_CHECK (!test_compile (&schema, source, SCHEMA_FLAG_LAZY));
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_lazy_fixed_stride());
+    TEST_RUN (status, test_lazy_varying_stride());
+    TEST_RUN (status, test_lazy_field_in_expression());
+
+    return TEST_EXIT_STATUS (status);
+}
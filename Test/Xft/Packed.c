@@ -0,0 +1,149 @@
+/**
+ * @file Packed.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+#include <string.h>
+
+/* crossfile */
+#include <CrossFile/Xft/Vm/Packed.h>
+
+/* local includes */
+#include <Test.h>
+#include "TestLoader.h"
+
+/**
+ * @b Encode blocks with operands of every width, and make sure registers share bytes,
+ * numbers take as many LEB128 bytes as they need, and code ends with a terminator and
+ * zero padding.
+ * */
+static Bool test_encoding_is_compact (void) {
+    InsnBlock blocks[] = {
+        TEST_BLOCK (SET_REG (1, 300), READ_MEM32 (200), ADD (3, 1, 2), JZ (3, 1), PINFO ("hello")),
+        TEST_BLOCK (READ_ARR16 (4, 3), SEEK_FWD (1000), EXIT (SUCCESS)),
+    };
+
+    Uint8 want[] = {
+        INSN_TYPE_SET_REG,  1,    0xac, 0x02, /* imm 300 */
+        INSN_TYPE_READ_M32, 0xc8, 0x01,       /* mem_off 200 */
+        INSN_TYPE_ADD,      0x13, 2,          /* rres 3, r1 1 share a byte */
+        INSN_TYPE_JZ,       3,    1,          /* block 1 */
+        INSN_TYPE_PINFO,    0,                /* first message */
+        INSN_TYPE_READ_A16, 4,    3,          /* block 1 starts here */
+        INSN_TYPE_SEEK_FWD, 0xe8, 0x07,       /* 1000 bytes */
+        INSN_TYPE_EXIT_SUCCESS,
+        INSN_TYPE_EXIT_SUCCESS,               /* terminator */
+    };
+
+    PackedCode packed = {0};
+    Bool       status = !!packed_code_encode (&packed, blocks, 2);
+
+    status = status && packed.code_size == sizeof (want) + PACKED_CODE_PADDING &&
+             !memcmp (packed.code, want, sizeof (want)) && packed.block_count == 2 &&
+             packed.block_offsets[0] == 0 && packed.block_offsets[1] == 15 &&
+             packed.insn_count == 8 && packed.msg_count == 1 &&
+             !strcmp (packed.msgs[0], "hello");
+
+    for (Size p = sizeof (want); status && p < packed.code_size; p++) {
+        status = !packed.code[p];
+    }
+
+    packed_code_deinit (&packed);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Decode packed code back to blocks, and make sure encoding them again gives same code.
+ * */
+static Bool test_decode_round_trip (void) {
+    InsnBlock blocks[] = {
+        TEST_BLOCK (
+            READ_REG8 (1),
+            SET_REG (2, 1ull << 40),
+            MUL (3, 1, 2),
+            NOT (4, 3),
+            PUSH_MEM64 (1u << 20),
+            JA (4, 2),
+            PERR ("error")
+        ),
+        TEST_BLOCK (CALL_ARR (1, 2, 24), CALL_VEC (0, 1, 16), EXIT (FAILURE)),
+        TEST_BLOCK (PDBG ("debug"), POP_ARR32 (64, 5), EXIT (SUCCESS)),
+    };
+
+    PackedCode packed  = {0};
+    PackedCode again   = {0};
+    Size       count   = 0;
+    InsnBlock* decoded = Null;
+
+    Bool status = packed_code_encode (&packed, blocks, 3) &&
+                  (decoded = packed_code_decode (&packed, &count)) && count == 3;
+
+    for (Size b = 0; status && b < count; b++) {
+        status = decoded[b].insn_count == blocks[b].insn_count;
+        for (Size i = 0; status && i < decoded[b].insn_count; i++) {
+            status = decoded[b].insns[i].insn_type == blocks[b].insns[i].insn_type;
+        }
+    }
+
+    status = status && decoded[0].insns[1].insn.set_reg.imm == 1ull << 40 &&
+             decoded[0].insns[4].insn.push_mem.mem_off == 1u << 20 &&
+             decoded[1].insns[0].insn.call_type_loader_arr.mem_stride == 24 &&
+             decoded[1].insns[1].insn.call_type_loader_vec.mem_off == 16 &&
+             !strcmp (decoded[2].insns[0].insn.print.msg, "debug");
+
+    status = status && packed_code_encode (&again, decoded, count) &&
+             again.code_size == packed.code_size &&
+             !memcmp (again.code, packed.code, packed.code_size);
+
+    if (decoded) {
+        for (Size b = 0; b < count; b++) {
+            insn_block_deinit (decoded + b);
+        }
+        FREE (decoded);
+    }
+    packed_code_deinit (&again);
+    packed_code_deinit (&packed);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_encoding_is_compact());
+    TEST_RUN (status, test_decode_round_trip());
+
+    return TEST_EXIT_STATUS (status);
+}
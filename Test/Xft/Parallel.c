@@ -0,0 +1,219 @@
+/**
+ * @file Parallel.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+
+/* crossfile */
+#include <CrossFile/Xft/Vm/Pool.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+#include "TestLoader.h"
+
+#define TEST_THREAD_COUNT 4
+
+/* enough records for array to be split over pool, see VM_PARALLEL_MIN_BYTES */
+#define TEST_RECORD_COUNT  20000
+#define TEST_RECORD_STREAM 13
+#define TEST_RECORD_MEM    16
+
+/**
+ * @b Task marking every item it's given as visited.
+ * */
+static Bool test_visit_range (void* task_data, Size worker, Size begin, Size end) {
+    Uint8* visits = task_data;
+    (void)worker;
+
+    for (Size i = begin; i < end; i++) {
+        visits[i]++;
+    }
+    return True;
+}
+
+/**
+ * @b Make sure pool gives every item of a task to exactly one worker, however items are
+ * split and stolen.
+ * */
+static Bool test_pool_visits_every_item (void) {
+    static Uint8 visits[100003];
+
+    VmPool pool = {0};
+    TEST_CHECK (vm_pool_init (&pool, TEST_THREAD_COUNT));
+
+    Bool status = pool.worker_count == TEST_THREAD_COUNT;
+    for (Size grain = 1; status && grain <= 4096; grain *= 16) {
+        memset (visits, 0, sizeof (visits));
+        status = vm_pool_run (&pool, sizeof (visits), grain, test_visit_range, visits);
+        for (Size i = 0; status && i < sizeof (visits); i++) {
+            status = visits[i] == 1;
+        }
+    }
+
+    vm_pool_deinit (&pool);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Load a large array of fixed size records, each calling another fixed loader, once
+ * sequentially and once on a pool, and make sure both give same memory, cursor and
+ * registers. Then make sure a failing element, or a short stream, fail parallel load.
+ * */
+static Bool test_parallel_matches_sequential (void) {
+    InsnBlock sub_blocks[] = {TEST_BLOCK (READ_ARR32_BE (0, 1))};
+    Loader sub = {
+        .type_name        = "Sub",
+        .alloc_size       = 4,
+        .insn_blocks      = sub_blocks,
+        .insn_block_count = 1,
+    };
+    Loader* record_refs[] = {&sub};
+
+    /* 13 bytes : u32, u16, skipped u16, called u32, and a non zero divisor */
+    InsnBlock record_blocks[] = {
+        TEST_BLOCK (
+            READ_ARR32_BE (0, 1),
+            READ_MEM16 (4),
+            SEEK_FWD (2),
+            SET_REG (0, 8),
+            CALL (0),
+            READ_REG8 (2),
+            SET_REG (3, 1000),
+            DIV (4, 3, 2),
+            SEEK_BAK (1),
+            SEEK_FWD (1),
+            EXIT (SUCCESS)
+        ),
+    };
+    Loader record = {
+        .type_name        = "Record",
+        .alloc_size       = 12,
+        .insn_blocks      = record_blocks,
+        .insn_block_count = 1,
+        .loader_refs      = record_refs,
+        .loader_ref_count = 1,
+    };
+    Loader* table_refs[] = {&record};
+
+    InsnBlock table_blocks[] = {
+        TEST_BLOCK (
+            SET_REG (5, TEST_RECORD_COUNT),
+            SET_REG (0, 0),
+            CALL_ARR (0, 5, TEST_RECORD_MEM),
+            READ_REG8 (6)
+        ),
+    };
+    Loader table = {
+        .type_name        = "Table",
+        .alloc_size       = TEST_RECORD_COUNT * TEST_RECORD_MEM,
+        .insn_blocks      = table_blocks,
+        .insn_block_count = 1,
+        .loader_refs      = table_refs,
+        .loader_ref_count = 1,
+    };
+
+    Size   size   = TEST_RECORD_COUNT * TEST_RECORD_STREAM + 1;
+    Uint8* data   = ALLOCATE (Uint8, size);
+    Uint8* seq    = ALLOCATE (Uint8, table.alloc_size);
+    Uint8* par    = ALLOCATE (Uint8, table.alloc_size);
+    Uint32 random = 1;
+    VmPool pool   = {0};
+    Vm     vm     = {0};
+    Bool   status = data && seq && par && vm_pool_init (&pool, TEST_THREAD_COUNT);
+
+    for (Size b = 0; status && b < size; b++) {
+        random  = random * 1103515245 + 12345;
+        data[b] = (Uint8)(random >> 16);
+    }
+    for (Size r = 0; status && r < TEST_RECORD_COUNT; r++) {
+        data[r * TEST_RECORD_STREAM + 12] |= 1;
+    }
+
+    IoStream io = {.data = data, .size = size, .capacity = size};
+
+    status = status && vm_run_loader (&vm, &table, &io, seq) && io.cursor == size;
+    Uint64 seq_regs[VM_REG_COUNT];
+    memcpy (seq_regs, vm.regs, sizeof (seq_regs));
+
+    vm.pool   = &pool;
+    io.cursor = 0;
+    status    = status && vm_run_loader (&vm, &table, &io, par) && io.cursor == size &&
+                vm.worker_count == TEST_THREAD_COUNT && record.fixed_status == LOADER_FIXED_YES &&
+                record.fixed_stream_size == TEST_RECORD_STREAM &&
+                !memcmp (seq, par, table.alloc_size) &&
+                !memcmp (seq_regs, vm.regs, sizeof (seq_regs));
+
+    /* division by zero in middle of array */
+    if (status) {
+        data[(TEST_RECORD_COUNT / 2) * TEST_RECORD_STREAM + 12] = 0;
+    }
+    io.cursor = 0;
+    status    = status && !vm_run_loader (&vm, &table, &io, par);
+
+    /* stream ends before last record */
+    if (status) {
+        data[(TEST_RECORD_COUNT / 2) * TEST_RECORD_STREAM + 12] = 1;
+    }
+    io.cursor = 0;
+    io.size   = size - 6;
+    status    = status && !vm_run_loader (&vm, &table, &io, par);
+
+    vm_deinit (&vm);
+    vm_pool_deinit (&pool);
+    test_loader_deinit (&table);
+    test_loader_deinit (&record);
+    test_loader_deinit (&sub);
+    if (data) {
+        FREE (data);
+    }
+    if (seq) {
+        FREE (seq);
+    }
+    if (par) {
+        FREE (par);
+    }
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_pool_visits_every_item());
+    TEST_RUN (status, test_parallel_matches_sequential());
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file Peephole.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* crossfile */
+#include <CrossFile/Xft/Vm/Peephole.h>
+
+/* local includes */
+#include <Test.h>
+#include "TestLoader.h"
+
+/**
+ * @b Optimize a loader with two equal runs of reads and two foldable comparisions, and
+ * make sure reported counts match the superinstructions written in place.
+ * */
+static Bool test_stats_match_fused_code (void) {
+    InsnBlock blocks[] = {
+        /* r1 <= 5, or fail */
+        TEST_BLOCK (
+            READ_MEM16 (0),
+            READ_MEM16 (2),
+            READ_MEM32 (4),
+            SET_REG (2, 5),
+            CMPLE (3, 1, 2),
+            JZ (3, 2),
+            EXIT (SUCCESS)
+        ),
+        /* immediate on left, 3 < r1 fails, and a lone read is left as it is */
+        TEST_BLOCK (
+            READ_MEM16 (8),
+            READ_MEM16 (10),
+            READ_MEM32 (12),
+            SET_REG (4, 3),
+            CMPLT (5, 4, 1),
+            JA (5, 2),
+            READ_MEM8 (16),
+            EXIT (SUCCESS)
+        ),
+        TEST_BLOCK (EXIT (FAILURE)),
+    };
+    Loader loader = {
+        .type_name        = "Test",
+        .alloc_size       = 17,
+        .insn_blocks      = blocks,
+        .insn_block_count = 3,
+    };
+
+    PeepholeStats stats  = {0};
+    Bool          status = !!peephole_optimize_loader (&loader, &stats);
+
+    Insn* first  = blocks[0].insns;
+    Insn* second = blocks[1].insns;
+
+    status = status && stats.insn_count_before == 16 && stats.insn_count_after == 8 &&
+             stats.reads_fused == 6 && stats.jumps_folded == 2 &&
+             blocks[0].insn_count == 3 && blocks[1].insn_count == 4 &&
+             blocks[2].insn_count == 1;
+
+    /* both runs have same shape, so they share a single dense layout */
+    status = status && loader.struct_layout_count == 1 && loader.struct_layouts[0].is_dense &&
+             loader.struct_layouts[0].field_count == 3 &&
+             loader.struct_layouts[0].stream_size == 8;
+
+    status = status && first[0].insn_type == INSN_TYPE_READ_STRUCT &&
+             first[0].insn.read_struct.mem_off == 0 && first[1].insn_type == INSN_TYPE_JCMP &&
+             first[1].insn.jcmp.cmp == INSN_TYPE_CMPLE && first[1].insn.jcmp.r1 == 1 &&
+             first[1].insn.jcmp.imm == 5 && !first[1].insn.jcmp.jump_if &&
+             first[1].insn.jcmp.block_sel == 2 && first[2].insn_type == INSN_TYPE_EXIT_SUCCESS;
+
+    status = status && second[0].insn_type == INSN_TYPE_READ_STRUCT &&
+             second[0].insn.read_struct.mem_off == 8 &&
+             second[0].insn.read_struct.layout_id == 0 && second[1].insn_type == INSN_TYPE_JCMP &&
+             second[1].insn.jcmp.cmp == INSN_TYPE_CMPGT && second[1].insn.jcmp.r1 == 1 &&
+             second[1].insn.jcmp.imm == 3 && second[1].insn.jcmp.jump_if &&
+             second[2].insn_type == INSN_TYPE_READ_M8 &&
+             second[3].insn_type == INSN_TYPE_EXIT_SUCCESS;
+
+    test_loader_deinit (&loader);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Optimize a loader with nothing to fuse, and make sure it's reported unchanged.
+ * */
+static Bool test_stats_without_patterns (void) {
+    InsnBlock blocks[] = {
+        TEST_BLOCK (READ_MEM8 (0), SET_REG (2, 1), ADD (1, 1, 2), READ_MEM8 (1), EXIT (SUCCESS)),
+    };
+    Loader loader = {
+        .type_name        = "Test",
+        .alloc_size       = 2,
+        .insn_blocks      = blocks,
+        .insn_block_count = 1,
+    };
+
+    PeepholeStats stats  = {0};
+    Bool          status = !!peephole_optimize_loader (&loader, &stats);
+
+    status = status && stats.insn_count_before == 5 && stats.insn_count_after == 5 &&
+             !stats.reads_fused && !stats.jumps_folded && !loader.struct_layout_count;
+
+    test_loader_deinit (&loader);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_stats_match_fused_code());
+    TEST_RUN (status, test_stats_without_patterns());
+
+    return TEST_EXIT_STATUS (status);
+}
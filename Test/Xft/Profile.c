@@ -0,0 +1,166 @@
+/**
+ * @file Profile.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+#include <stdio.h>
+
+/* crossfile */
+#include <CrossFile/Xft/Parser/Registry.h>
+#include <CrossFile/Xft/Vm/Profile.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+
+/* memory of an object loaded by bundled "Elf" schema, from a 64-bit ELF file */
+typedef struct TestElf64 {
+    Uint8 ident[16];
+
+    struct {
+        Uint16 type;
+        Uint16 machine;
+        Uint32 version;
+        Uint64 entry;
+        Uint64 phoff;
+        Uint64 shoff;
+        Uint32 flags;
+        Uint16 ehsize;
+        Uint16 phentsize;
+        Uint16 phnum;
+        Uint16 shentsize;
+        Uint16 shnum;
+        Uint16 shstrndx;
+    } header;
+
+    VmVector sections;
+    VmVector segments;
+} TestElf64;
+
+#define TEST_ELF_SECTION_HEADER_SIZE 64
+#define TEST_ELF_PROGRAM_HEADER_SIZE 56
+
+#define TEST_FOLDED_SIZE 4096
+
+/**
+ * @b Find whether folded stack output has a line for given call chain, with a count.
+ * */
+static Bool folded_has_chain (CString folded, CString chain) {
+    Size len = strlen (chain);
+    for (CString line = folded; line && *line;) {
+        if (!strncmp (line, chain, len) && line[len] == ' ' && line[len + 1] >= '1' &&
+            line[len + 1] <= '9') {
+            return True;
+        }
+        line = strchr (line, '\n');
+        line = line ? line + 1 : Null;
+    }
+    return False;
+}
+
+/**
+ * @b Load given ELF file with profiling on, and make sure instruction counts, counters of
+ * type loaders and call tree account for every section and segment loaded.
+ * */
+static Bool test_profile_counts_elf_load (CString filename) {
+    SchemaRegistry registry;
+    TEST_CHECK (schema_registry_init (&registry, Null));
+
+    SchemaEntry* entry   = schema_registry_find (&registry, "Elf");
+    IoStream*    io      = io_stream_open_file (filename, False);
+    Vm           vm      = {0};
+    VmProfile    profile = {0};
+    TestElf64    elf     = {0};
+    FILE*        out     = tmpfile();
+    Char         folded[TEST_FOLDED_SIZE + 1] = {0};
+
+    Bool status = entry && entry->file_loader && io && out && vm_profile_init (&profile) &&
+                  entry->file_loader->alloc_size == sizeof (TestElf64);
+
+    vm.profile = &profile;
+    status     = status && vm_run_loader (&vm, entry->file_loader, io, &elf) &&
+                 elf.sections.count == elf.header.shnum && elf.segments.count == elf.header.phnum;
+
+    Size    count    = elf.sections.count + elf.segments.count;
+    Loader* file     = entry ? entry->file_loader : Null;
+    Loader* sections = entry ? schema_entry_find_loader (entry, "ElfSectionHeader64") : Null;
+    Loader* segments = entry ? schema_entry_find_loader (entry, "ElfProgramHeader64") : Null;
+
+    VmProfileLoader* file_prof    = file ? vm_profile_find_loader (&profile, file) : Null;
+    VmProfileLoader* section_prof = sections ? vm_profile_find_loader (&profile, sections) : Null;
+    VmProfileLoader* segment_prof = segments ? vm_profile_find_loader (&profile, segments) : Null;
+
+    /* every execution of every loader exits once, element loaders once per element */
+    Uint64 execs = 0;
+    for (Size l = 0; l < profile.loader_capacity; l++) {
+        execs += profile.loaders[l] ? profile.loaders[l]->exec_count : 0;
+    }
+    status = status && profile.insn_counts[INSN_TYPE_CALL_TYPE_LOADER_V] == 2 &&
+             profile.insn_counts[INSN_TYPE_EXIT_SUCCESS] == execs && execs > count;
+
+    status = status && file_prof && file_prof->exec_count == 1 && section_prof &&
+             section_prof->exec_count == elf.sections.count &&
+             section_prof->bytes_read == elf.sections.count * TEST_ELF_SECTION_HEADER_SIZE &&
+             segment_prof && segment_prof->exec_count == elf.segments.count &&
+             segment_prof->bytes_read == elf.segments.count * TEST_ELF_PROGRAM_HEADER_SIZE &&
+             section_prof->block_count && section_prof->blocks[0].exec_count == elf.sections.count;
+
+    /* every element loader is called by file loader, and spends some time on it's own */
+    status = status && vm_profile_dump_folded (&profile, out) && !fseek (out, 0, SEEK_SET) &&
+             fread (folded, 1, TEST_FOLDED_SIZE, out) > 0 &&
+             folded_has_chain (folded, "Elf;ElfSectionHeader64") &&
+             folded_has_chain (folded, "Elf;ElfProgramHeader64") &&
+             !strstr (folded, "ElfSectionHeader64;");
+
+    if (out) {
+        fclose (out);
+    }
+    vm_deinit (&vm);
+    vm_profile_deinit (&profile);
+    if (io) {
+        io_stream_close (io);
+    }
+    schema_registry_deinit (&registry);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (argc != 2, EXIT_FAILURE, "usage : %s <64-bit elf file>\n", argv[0]);
+
+    Bool status = True;
+    TEST_RUN (status, test_profile_counts_elf_load (argv[1]));
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,249 @@
+/**
+ * @file Recompile.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+#include <string.h>
+
+/* crossfile */
+#include <CrossFile/Stream/Stream.h>
+#include <CrossFile/Xft/Parser/Compiler.h>
+#include <CrossFile/Xft/Parser/Parser.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+
+/* names of loaders checked for reuse, in order of TestSnapshot::loaders */
+static const CString test_names[] = {"P", "Q", "R", "F"};
+#define TEST_NAME_COUNT (sizeof (test_names) / sizeof (test_names[0]))
+
+static const CString test_source = "enum K : Uint8 { A = 1 B = 2 }\n"
+                                   "/* structs */\n"
+                                   "struct P { Uint8 a Uint16 b }\n"
+                                   "struct Q { Uint8 k Uint8 v[2] }\n"
+                                   "struct R { K kind P p }\n"
+                                   "file F { Uint8 n Q q R r #assert { n == 1 } }\n";
+
+/**
+ * @b Loaders of a schema at some point, to find out which of them were reused.
+ * */
+typedef struct TestSnapshot {
+    Loader* loaders[TEST_NAME_COUNT];
+} TestSnapshot;
+
+/**
+ * @b Source being edited, along with parser keeping it's syntax tree.
+ * */
+typedef struct TestEditor {
+    XfileParser parser;
+    Char*       source;
+    Size        size;
+} TestEditor;
+
+/**
+ * @b Take a snapshot of loaders of given schema.
+ * */
+static TestSnapshot test_snapshot (Schema* schema) {
+    TestSnapshot snap = {0};
+    for (Size n = 0; n < TEST_NAME_COUNT; n++) {
+        snap.loaders[n] = schema_find_loader (schema, test_names[n]);
+    }
+    return snap;
+}
+
+/**
+ * @b Make sure loaders named in @c reused are same as in snapshot, and rest are new.
+ * Names are given as a string of first letters, like "PQ".
+ * */
+static Bool test_reused (Schema* schema, const TestSnapshot* snap, CString reused) {
+    TestSnapshot now = test_snapshot (schema);
+
+    Bool status = True;
+    for (Size n = 0; n < TEST_NAME_COUNT; n++) {
+        Bool same = now.loaders[n] == snap->loaders[n];
+        if (!now.loaders[n] || same != !!strchr (reused, test_names[n][0])) {
+            PRINT_ERR ("Loader \"%s\" reused = %d\n", test_names[n], same);
+            status = False;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @b Replace first occurence of @c from in source by @c to, and describe that in @c edit.
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+static Bool test_edit (TestEditor* editor, CString from, CString to, TSInputEdit* edit) {
+    Char* at = strstr (editor->source, from);
+    RETURN_VALUE_IF (!at, False, "\"%s\" not found in source\n", from);
+
+    Size off       = at - editor->source;
+    Size from_size = strlen (from);
+    Size to_size   = strlen (to);
+    Size size      = editor->size - from_size + to_size;
+
+    Char* source = ALLOCATE (Char, size + 1);
+    RETURN_VALUE_IF (!source, False, ERR_OUT_OF_MEMORY);
+
+    memcpy (source, editor->source, off);
+    memcpy (source + off, to, to_size);
+    memcpy (source + off + to_size, at + from_size, editor->size - off - from_size + 1);
+
+    FREE (editor->source);
+    editor->source = source;
+    editor->size   = size;
+
+    memset (edit, 0, sizeof (TSInputEdit));
+    edit->start_byte   = (Uint32)off;
+    edit->old_end_byte = (Uint32)(off + from_size);
+    edit->new_end_byte = (Uint32)(off + to_size);
+    return True;
+}
+
+/**
+ * @b Reparse source after given edits, and recompile schema from it.
+ *
+ * @return @c True if recompilation succeeds.
+ * @return @c False otherwise.
+ * */
+static Bool
+    test_recompile (TestEditor* editor, Schema* schema, const TSInputEdit* edits, Size count) {
+    TypeDeclList* decls =
+        xfile_parser_reparse (&editor->parser, editor->source, editor->size, edits, count);
+    return decls && schema_recompile (schema, decls);
+}
+
+/**
+ * @b Make sure given schema loads same object as a schema compiled from scratch from
+ * current source.
+ * */
+static Bool test_loads_same (TestEditor* editor, Schema* schema) {
+    /* n, q.k, q.v, r.kind, r.p.a, r.p.b */
+    Uint8 data[] = {1, 2, 3, 4, 2, 5, 6, 7};
+
+    Schema fresh = {0};
+    RETURN_VALUE_IF (
+        !schema_compile_source (&fresh, editor->source, editor->size, schema->flags),
+        False,
+        "Failed to compile edited source\n"
+    );
+
+    Uint8    mem[2][32] = {0};
+    IoStream io[2]      = {
+        {.data = data, .size = sizeof (data), .capacity = sizeof (data)},
+        {.data = data, .size = sizeof (data), .capacity = sizeof (data)},
+    };
+    Vm vm = {0};
+
+    Bool status = schema->file_loader->alloc_size == fresh.file_loader->alloc_size &&
+                  schema->file_loader->alloc_size <= sizeof (mem[0]);
+    status      = status && vm_run_loader (&vm, schema->file_loader, io, mem[0]);
+    status      = status && vm_run_loader (&vm, fresh.file_loader, io + 1, mem[1]);
+    status      = status && io[0].cursor == sizeof (data) && io[1].cursor == sizeof (data);
+    status      = status && !memcmp (mem[0], mem[1], sizeof (mem[0]));
+
+    vm_deinit (&vm);
+    schema_deinit (&fresh);
+    return status;
+}
+
+/**
+ * @b Make a series of edits, and make sure each recompiles only declarations changed and
+ * ones depending on them, keeping loaders of the rest. A failed recompilation must leave
+ * schema untouched, and it's changes must be compiled by the next one.
+ * */
+static Bool test_recompile_edits (void) {
+    TestEditor editor = {.size = strlen (test_source)};
+    editor.source     = ALLOCATE (Char, editor.size + 1);
+    TEST_CHECK (editor.source && xfile_parser_init (&editor.parser));
+    memcpy (editor.source, test_source, editor.size + 1);
+
+    Schema        schema = {0};
+    TypeDeclList* decls  = xfile_parser_parse (&editor.parser, editor.source, editor.size);
+    Bool          status = decls && schema_compile (&schema, decls, SCHEMA_FLAG_NONE);
+
+    TestSnapshot snap = test_snapshot (&schema);
+    TSInputEdit  edits[2];
+
+    /* Q changes, and F refers to it */
+    status = status && test_edit (&editor, "v[2]", "w[2]", edits);
+    status = status && test_recompile (&editor, &schema, edits, 1);
+    status = status && test_reused (&schema, &snap, "PR") && test_loads_same (&editor, &schema);
+    snap   = test_snapshot (&schema);
+
+    /* a member of K changes, R refers to it, and F to R */
+    status = status && test_edit (&editor, "B = 2", "B = 3", edits);
+    status = status && test_recompile (&editor, &schema, edits, 1);
+    status = status && test_reused (&schema, &snap, "PQ") && test_loads_same (&editor, &schema);
+    snap   = test_snapshot (&schema);
+
+    /* P changes but F refers to an unknown type, so nothing changes */
+    status = status && test_edit (&editor, "Uint16 b", "Uint16 c", edits);
+    status = status && test_edit (&editor, "Q q", "Unknown q", edits + 1);
+    status = status && !test_recompile (&editor, &schema, edits, 2);
+    status = status && test_reused (&schema, &snap, "PQRF");
+
+    /* once F is fixed, P is compiled along with it */
+    status = status && test_edit (&editor, "Unknown q", "Q q", edits);
+    status = status && test_recompile (&editor, &schema, edits, 1);
+    status = status && test_reused (&schema, &snap, "Q") && test_loads_same (&editor, &schema);
+    snap   = test_snapshot (&schema);
+
+    /* a struct nothing refers to is added in between others */
+    status = status && test_edit (&editor, "/* structs */", "struct Extra { Uint8 x }", edits);
+    status = status && test_recompile (&editor, &schema, edits, 1);
+    status = status && test_reused (&schema, &snap, "PQRF") &&
+             schema_find_loader (&schema, "Extra");
+
+    /* nothing changes */
+    status = status && test_recompile (&editor, &schema, edits, 0);
+    status = status && test_reused (&schema, &snap, "PQRF") && test_loads_same (&editor, &schema);
+
+    schema_deinit (&schema);
+    xfile_parser_deinit (&editor.parser);
+    FREE (editor.source);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_recompile_edits());
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,208 @@
+/**
+ * @file Registry.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <dirent.h>
+#include <errno.h>
+#include <memory.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* crossfile */
+#include <CrossFile/Stream/Stream.h>
+#include <CrossFile/Xft/Parser/Registry.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+
+static const CString test_source =
+    "struct P { Uint8 a Uint16 b } file F { Uint8 n P p[n] #assert { n < 4 } }";
+
+/**
+ * @b Remove every file in cache directory, creating it if it doesn't exist.
+ *
+ * @return Number of files removed, or -1 on failure.
+ * */
+static Int32 test_clear_cache (CString cache_dir) {
+    if (mkdir (cache_dir, 0755) && errno != EEXIST) {
+        return -1;
+    }
+
+    DIR* dir = opendir (cache_dir);
+    RETURN_VALUE_IF (!dir, -1, "Failed to open \"%s\"\n", cache_dir);
+
+    Int32          count = 0;
+    struct dirent* ent   = Null;
+    while ((ent = readdir (dir))) {
+        if (ent->d_name[0] == '.') {
+            continue;
+        }
+
+        Char path[4096];
+        snprintf (path, sizeof (path), "%s/%s", cache_dir, ent->d_name);
+        count = count >= 0 && !unlink (path) ? count + 1 : -1;
+    }
+
+    closedir (dir);
+    return count;
+}
+
+/**
+ * @b Load two P records through file loader of given entry.
+ *
+ * @return @c True if they load with expected values.
+ * @return @c False otherwise.
+ * */
+static Bool test_entry_loads (SchemaEntry* entry) {
+    Uint16 b       = 0x1234;
+    Uint8  data[7] = {2, 1};
+    memcpy (data + 2, &b, 2);
+    data[4] = 3;
+    memcpy (data + 5, &b, 2);
+
+    Uint8    mem[32] = {0};
+    VmVector vec     = {0};
+    Uint16   mem_b   = 0;
+    IoStream io      = {.data = data, .size = sizeof (data), .capacity = sizeof (data)};
+    Vm       vm      = {0};
+
+    Bool status = entry && entry->file_loader;
+    status      = status && vm_run_loader (&vm, entry->file_loader, &io, mem);
+    if (status) {
+        memcpy (&vec, mem + 8, sizeof (vec));
+    }
+    status = status && mem[0] == 2 && vec.count == 2;
+    if (status) {
+        memcpy (&mem_b, (Uint8*)vec.data + 6, 2);
+    }
+    status = status && ((Uint8*)vec.data)[4] == 3 && mem_b == b;
+
+    vm_deinit (&vm);
+    return status;
+}
+
+/**
+ * @b Make sure bundled schemas open from their embedded image, only once.
+ * */
+static Bool test_bundled_schema (void) {
+    SchemaRegistry registry;
+    TEST_CHECK (schema_registry_init (&registry, Null));
+
+    SchemaEntry* entry  = schema_registry_find (&registry, "Elf");
+    Bool         status = entry && entry->xfb.data && !entry->hash && entry->file_loader &&
+                  schema_entry_find_loader (entry, "ElfSectionHeader64");
+
+    status = status && schema_registry_find (&registry, "Elf") == entry &&
+             registry.entry_count == 1;
+    status = status && !schema_registry_find (&registry, "NoSuchSchema") &&
+             registry.entry_count == 1;
+
+    schema_registry_deinit (&registry);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure a compiled schema is written to cache, reopened from there by a later
+ * registry, and compiled again when cached image is unusable or source changes.
+ * */
+static Bool test_compile_cache (CString cache_dir) {
+    TEST_CHECK (test_clear_cache (cache_dir) >= 0);
+
+    Size           size = strlen (test_source);
+    SchemaRegistry first;
+    SchemaRegistry second;
+    TEST_CHECK (schema_registry_init (&first, cache_dir));
+    TEST_CHECK (schema_registry_init (&second, cache_dir));
+
+    /* compiled and cached, then found in registry by name and hash */
+    SchemaEntry* compiled = schema_registry_compile (&first, "Test", test_source, size);
+    Bool         status   = compiled && !compiled->xfb.data && compiled->hash;
+
+    status = status && schema_registry_compile (&first, "Test", test_source, size) == compiled;
+    status = status && test_entry_loads (compiled);
+
+    /* reopened from cache without compiling */
+    SchemaEntry* cached = schema_registry_compile (&second, "Test", test_source, size);
+    status              = status && cached && cached->xfb.data && cached->hash == compiled->hash;
+    status = status && test_entry_loads (cached);
+
+    Uint64 hash = compiled ? compiled->hash : 0;
+    schema_registry_deinit (&first);
+    schema_registry_deinit (&second);
+
+    /* a corrupt image is replaced by compiling again */
+    Char path[4096];
+    snprintf (path, sizeof (path), "%s/%016llx.xfb", cache_dir, (unsigned long long)hash);
+    FILE* file = status ? fopen (path, "wb") : Null;
+    status     = status && file && fputs ("not an xfb image", file) >= 0;
+    if (file) {
+        fclose (file);
+    }
+
+    TEST_CHECK (schema_registry_init (&first, cache_dir));
+    TEST_CHECK (schema_registry_init (&second, cache_dir));
+
+    compiled = schema_registry_compile (&first, "Test", test_source, size);
+    status   = status && compiled && !compiled->xfb.data && test_entry_loads (compiled);
+    cached   = schema_registry_compile (&second, "Test", test_source, size);
+    status   = status && cached && cached->xfb.data && test_entry_loads (cached);
+
+    /* changed source is another schema, and invalid source is not registered */
+    SchemaEntry* changed = schema_registry_compile (&second, "Test", "file F { Uint8 n }", 18);
+    status               = status && changed && changed != cached && !changed->xfb.data;
+    status = status && !schema_registry_compile (&second, "Bad", "file F { Foo x }", 16) &&
+             second.entry_count == 2;
+
+    schema_registry_deinit (&first);
+    schema_registry_deinit (&second);
+
+    TEST_CHECK (status);
+    TEST_CHECK (test_clear_cache (cache_dir) == 2);
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (argc != 2, EXIT_FAILURE, "usage : %s <scratch cache directory>\n", argv[0]);
+
+    Bool status = True;
+    TEST_RUN (status, test_bundled_schema());
+    TEST_RUN (status, test_compile_cache (argv[1]));
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,192 @@
+/**
+ * @file Stack.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+
+/* crossfile */
+#include <CrossFile/Xft/Vm/Stack.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+#include "TestLoader.h"
+
+/* nested loaders, each keeping a whole object on stack while it's callee runs */
+#define TEST_CHAIN_LENGTH 100
+#define TEST_CHAIN_OBJECT 1024
+
+/**
+ * @b Push and pop values of every size, past initial capacity, and make sure they come
+ * back in reverse order and an empty stack can't be popped.
+ * */
+static Bool test_push_pop (void) {
+    XftVmStack stack = {0};
+    TEST_CHECK (xft_vm_stack_init (&stack, 4));
+
+    Uint8  v8  = 0;
+    Uint16 v16 = 0;
+    Uint32 v32 = 0;
+    Uint64 v64 = 0;
+
+    Bool status = xft_vm_stack_push_t8 (&stack, 0x11) && xft_vm_stack_push_t16 (&stack, 0x2222) &&
+                  xft_vm_stack_push_t32 (&stack, 0x33333333) &&
+                  xft_vm_stack_push_t64 (&stack, 0x4444444444444444ull) && stack.stack_size == 15 &&
+                  stack.stack_capacity >= 15;
+
+    status = status && xft_vm_stack_pop_t64 (&stack, &v64) && xft_vm_stack_pop_t32 (&stack, &v32) &&
+             xft_vm_stack_pop_t16 (&stack, &v16) && xft_vm_stack_pop_t8 (&stack, &v8) &&
+             v64 == 0x4444444444444444ull && v32 == 0x33333333 && v16 == 0x2222 && v8 == 0x11 &&
+             !stack.stack_size && !xft_vm_stack_pop_t8 (&stack, &v8);
+
+    xft_vm_stack_deinit (&stack);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure callee gets a copy of caller's registers, only it's r0 is returned, and
+ * it can't pop values pushed by it's caller.
+ * */
+static Bool test_frames_isolate_calls (void) {
+    InsnBlock callee_blocks[] = {TEST_BLOCK (ADD (0, 1, 1), SET_REG (1, 99))};
+    InsnBlock thief_blocks[]  = {TEST_BLOCK (POP_REG64 (1))};
+
+    Loader callee = {.type_name = "Callee", .insn_blocks = callee_blocks, .insn_block_count = 1};
+    Loader thief  = {.type_name = "Thief", .insn_blocks = thief_blocks, .insn_block_count = 1};
+
+    Loader* refs[]    = {&callee};
+    Loader* callers[] = {&thief};
+
+    InsnBlock blocks[] = {
+        TEST_BLOCK (SET_REG (1, 7), PUSH_REG64 (1), SET_REG (0, 0), CALL (0), POP_REG64 (2)),
+    };
+    Loader caller = {
+        .type_name        = "Caller",
+        .insn_blocks      = blocks,
+        .insn_block_count = 1,
+        .loader_refs      = refs,
+        .loader_ref_count = 1,
+    };
+
+    InsnBlock victim_blocks[] = {
+        TEST_BLOCK (SET_REG (1, 7), PUSH_REG64 (1), SET_REG (0, 0), CALL (0), POP_REG64 (2)),
+    };
+    Loader victim = {
+        .type_name        = "Victim",
+        .insn_blocks      = victim_blocks,
+        .insn_block_count = 1,
+        .loader_refs      = callers,
+        .loader_ref_count = 1,
+    };
+
+    Uint8    data[1] = {0};
+    IoStream io      = TEST_STREAM (data);
+    Vm       vm      = {0};
+
+    Bool status = vm_run_loader (&vm, &caller, &io, Null) && vm.regs[0] == 14 &&
+                  vm.regs[1] == 7 && vm.regs[2] == 7;
+    status = status && !vm_run_loader (&vm, &victim, &io, Null);
+
+    vm_deinit (&vm);
+    test_loader_deinit (&caller);
+    test_loader_deinit (&callee);
+    test_loader_deinit (&victim);
+    test_loader_deinit (&thief);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Run a chain of nested loaders that together need more than preallocated stack,
+ * and make sure stack grows, every frame gets back what it pushed, and stack is empty
+ * once run is over.
+ * */
+static Bool test_nested_frames_grow_stack (void) {
+    static Insn      insns[TEST_CHAIN_LENGTH][3];
+    static InsnBlock blocks[TEST_CHAIN_LENGTH];
+    static Loader    loaders[TEST_CHAIN_LENGTH];
+    static Loader*   refs[TEST_CHAIN_LENGTH];
+    static Uint8     mem[TEST_CHAIN_OBJECT];
+
+    for (Size l = 0; l < TEST_CHAIN_LENGTH; l++) {
+        Size count = 0;
+
+        insns[l][count++] = PUSH_ARR64 (0, TEST_CHAIN_OBJECT / 8);
+        if (l + 1 < TEST_CHAIN_LENGTH) {
+            insns[l][count++] = CALL (0);
+        }
+        insns[l][count++] = POP_ARR64 (0, TEST_CHAIN_OBJECT / 8);
+
+        refs[l]    = loaders + l;
+        blocks[l]  = (InsnBlock) {.insns = insns[l], .insn_count = count};
+        loaders[l] = (Loader) {
+            .type_name        = "Chain",
+            .alloc_size       = TEST_CHAIN_OBJECT,
+            .insn_blocks      = blocks + l,
+            .insn_block_count = 1,
+            .loader_refs      = refs + (l + 1 < TEST_CHAIN_LENGTH ? l + 1 : l),
+            .loader_ref_count = 1,
+        };
+    }
+    memset (mem, 5, sizeof (mem));
+
+    Uint8    data[1] = {0};
+    IoStream io      = TEST_STREAM (data);
+    Vm       vm      = {0};
+
+    Bool status = vm_run_loader (&vm, loaders, &io, mem) &&
+                  loaders[0].verify_status == LOADER_VERIFY_PASSED &&
+                  loaders[0].max_stack_size == TEST_CHAIN_OBJECT &&
+                  vm.stack.stack_capacity >= TEST_CHAIN_LENGTH * TEST_CHAIN_OBJECT &&
+                  !vm.stack.stack_size && mem[0] == 5 && mem[TEST_CHAIN_OBJECT - 1] == 5;
+
+    vm_deinit (&vm);
+    for (Size l = 0; l < TEST_CHAIN_LENGTH; l++) {
+        test_loader_deinit (loaders + l);
+    }
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_push_pop());
+    TEST_RUN (status, test_frames_isolate_calls());
+    TEST_RUN (status, test_nested_frames_grow_stack());
+
+    return TEST_EXIT_STATUS (status);
+}
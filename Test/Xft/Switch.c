@@ -0,0 +1,210 @@
+/**
+ * @file Switch.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* crossfile */
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+#include "TestLoader.h"
+
+/**
+ * @b Make sure overlapping cases keep priority of the first one, adjacent cases of a
+ * block are merged, and values are looked up same in sparse and dense tables.
+ * */
+static Bool test_switch_table_lookup (void) {
+    SwitchCase sparse_cases[] = {
+        {  0,   9, 1},
+        {  5,  20, 2},
+        { 21,  21, 2},
+        {100, 100, 3},
+        {  3,   2, 4},
+    };
+    SwitchCase dense_cases[] = {
+        {14, 15, 1},
+        {10, 12, 0},
+    };
+
+    SwitchTable sparse = {0};
+    SwitchTable dense  = {0};
+    TEST_CHECK (switch_table_init (&sparse, sparse_cases, 5));
+    TEST_CHECK (switch_table_init (&dense, dense_cases, 2));
+
+    /* [0, 9] keeps block 1, rest of [5, 20] joins [21, 21], and empty case is dropped */
+    Bool status = sparse.case_count == 3 && !sparse.dense;
+    status      = status && sparse.cases[1].first == 10 && sparse.cases[1].last == 21;
+
+    status = status && switch_table_find (&sparse, 5) == 1 &&
+             switch_table_find (&sparse, 15) == 2 && switch_table_find (&sparse, 21) == 2 &&
+             switch_table_find (&sparse, 100) == 3;
+    status = status && switch_table_find (&sparse, 50) == SWITCH_NO_BLOCK &&
+             switch_table_find (&sparse, 101) == SWITCH_NO_BLOCK &&
+             switch_table_find (&sparse, (Uint64)-1) == SWITCH_NO_BLOCK;
+
+    status = status && dense.dense && dense.dense_count == 6 &&
+             switch_table_find (&dense, 10) == 0 && switch_table_find (&dense, 15) == 1;
+    status = status && switch_table_find (&dense, 9) == SWITCH_NO_BLOCK &&
+             switch_table_find (&dense, 13) == SWITCH_NO_BLOCK &&
+             switch_table_find (&dense, 16) == SWITCH_NO_BLOCK;
+
+    /* every block a table jumps to must exist */
+    status = status && switch_table_is_valid (&sparse, 4) && !switch_table_is_valid (&sparse, 3);
+
+    switch_table_deinit (&sparse);
+    switch_table_deinit (&dense);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Run a loader leaving a different value in @c r2 for each case of it's switch table
+ * over given values, enough times for it to be JIT compiled when that's enabled. Values
+ * no case matches fall through to a failing exit.
+ * */
+static Bool test_switch_run (const SwitchCase* cases, Size case_count) {
+    InsnBlock blocks[] = {
+        TEST_BLOCK (READ_REG8 (1), SWITCH (1, 0), EXIT (FAILURE)),
+        TEST_BLOCK (SET_REG (2, 11), SET_REG (7, 1), JA (7, 4)),
+        TEST_BLOCK (SET_REG (2, 22), SET_REG (7, 1), JA (7, 4)),
+        TEST_BLOCK (SET_REG (2, 33)),
+        TEST_BLOCK (EXIT (SUCCESS)),
+    };
+    Loader loader = {
+        .type_name        = "Switch",
+        .alloc_size       = 1,
+        .insn_blocks      = blocks,
+        .insn_block_count = 5,
+    };
+
+    SwitchTable table = {0};
+    Size        id    = 0;
+    TEST_CHECK (switch_table_init (&table, cases, case_count));
+    TEST_CHECK (loader_add_switch_table (&loader, &table, &id) && id == 0);
+
+    /* values, and r2 left for each, 0 if loader must fail */
+    Uint8 values[]   = {5, 10, 21, 100, 50, 9, 200};
+    Uint8 expected[] = {11, 22, 22, 33, 0, 11, 0};
+
+    Vm   vm     = {0};
+    Bool status = True;
+    for (Size r = 0; status && r < 2 * VM_JIT_THRESHOLD; r++) {
+        for (Size v = 0; status && v < sizeof (values); v++) {
+            IoStream io  = TEST_STREAM (values);
+            Uint8    mem = 0;
+            io.cursor    = v;
+
+            Bool ok = vm_run_loader (&vm, &loader, &io, &mem) != Null;
+            status  = expected[v] ? ok && vm.regs[2] == expected[v] : !ok;
+        }
+    }
+
+#if VM_JIT_ENABLED
+    status = status && loader.jit_status == LOADER_JIT_COMPILED;
+#endif
+
+    vm_deinit (&vm);
+    test_loader_deinit (&loader);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure loaders dispatch through sparse and dense tables.
+ * */
+static Bool test_switch_dispatch (void) {
+    SwitchCase sparse[] = {
+        {  0,   9, 1},
+        { 10,  21, 2},
+        {100, 100, 3},
+    };
+    SwitchCase dense[] = {
+        {  0,   9, 1},
+        { 10,  12, 2},
+        { 14,  21, 2},
+        { 22,  49, 3},
+        { 51,  99, 3},
+        {100, 100, 3},
+    };
+
+    Bool status = test_switch_run (sparse, 3);
+    status      = test_switch_run (dense, 6) && status;
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure a loader whose switch table jumps to a missing block isn't trusted, and
+ * fails when it's taken.
+ * */
+static Bool test_switch_invalid_block (void) {
+    InsnBlock blocks[] = {
+        TEST_BLOCK (READ_REG8 (1), SWITCH (1, 0)),
+        TEST_BLOCK (EXIT (SUCCESS)),
+    };
+    Loader loader = {
+        .type_name        = "Switch",
+        .alloc_size       = 1,
+        .insn_blocks      = blocks,
+        .insn_block_count = 2,
+    };
+
+    SwitchCase  cases[] = {{0, 1, 1}, {2, 2, 5}};
+    SwitchTable table   = {0};
+    Size        id      = 0;
+    TEST_CHECK (switch_table_init (&table, cases, 2));
+    TEST_CHECK (loader_add_switch_table (&loader, &table, &id));
+
+    Uint8    data[] = {2};
+    IoStream io     = TEST_STREAM (data);
+    Uint8    mem    = 0;
+    Vm       vm     = {0};
+    Bool     status = !vm_run_loader (&vm, &loader, &io, &mem);
+
+    vm_deinit (&vm);
+    test_loader_deinit (&loader);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_switch_table_lookup());
+    TEST_RUN (status, test_switch_dispatch());
+    TEST_RUN (status, test_switch_invalid_block());
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file TestLoader.h
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSFILE_TEST_XFT_TEST_LOADER_H
+#define ANVIE_CROSSFILE_TEST_XFT_TEST_LOADER_H
+
+#include <Anvie/Common.h>
+#include <Anvie/Types.h>
+
+/* crossfile */
+#include <CrossFile/Stream/Stream.h>
+#include <CrossFile/Xft/Vm/Check.h>
+#include <CrossFile/Xft/Vm/InsnBuilders.h>
+#include <CrossFile/Xft/Vm/Jit.h>
+#include <CrossFile/Xft/Vm/Loader.h>
+#include <CrossFile/Xft/Vm/Packed.h>
+#include <CrossFile/Xft/Vm/Peephole.h>
+#include <CrossFile/Xft/Vm/Switch.h>
+
+/**
+ * @b Initializer of an @c InsnBlock holding given instructions, for loaders built by hand.
+ * Instructions live in a compound literal, so block is only valid in enclosing scope.
+ * */
+#define TEST_BLOCK(...)                                                                            \
+    {.insns      = (Insn[]) {__VA_ARGS__},                                                         \
+     .insn_count = sizeof ((Insn[]) {__VA_ARGS__}) / sizeof (Insn)}
+
+/**
+ * @b Read only stream over a byte array, that needs no closing.
+ * */
+#define TEST_STREAM(bytes)                                                                         \
+    ((IoStream) {.data = (bytes), .size = sizeof (bytes), .capacity = sizeof (bytes)})
+
+/**
+ * @b Release everything VM and optimizer attached to a loader built by hand. Blocks and
+ * references are owned by test itself.
+ * */
+static inline void test_loader_deinit (Loader* loader) {
+    jit_release_loader (loader);
+    packed_code_deinit (&loader->packed_code);
+
+    if (loader->struct_layouts) {
+        for (Size l = 0; l < loader->struct_layout_count; l++) {
+            struct_layout_deinit (loader->struct_layouts + l);
+        }
+        FREE (loader->struct_layouts);
+    }
+
+    if (loader->switch_tables) {
+        for (Size t = 0; t < loader->switch_table_count; t++) {
+            switch_table_deinit (loader->switch_tables + t);
+        }
+        FREE (loader->switch_tables);
+    }
+
+    check_table_deinit (&loader->check);
+}
+
+#endif // ANVIE_CROSSFILE_TEST_XFT_TEST_LOADER_H
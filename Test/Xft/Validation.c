@@ -0,0 +1,169 @@
+/**
+ * @file Validation.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+#include <string.h>
+
+/* crossfile */
+#include <CrossFile/Stream/Stream.h>
+#include <CrossFile/Xft/Parser/Compiler.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+
+#define TEST_RECORD_COUNT 64
+#define TEST_DATA_SIZE    (2 * TEST_RECORD_COUNT + 2)
+
+/* 64 S checked only through their check table, then an R checked only by code */
+static const CString test_source =
+    "struct S { Uint8 k Uint8 m #assert { k == 1 && m >= 2 } } "
+    "struct R { Uint8 a Uint8 b #assert { (a + b) == 3 } } "
+    "file F { S s[64] R r #assert { r.a < 5 } }";
+
+/**
+ * @b Number of @c INSN_TYPE_CHECK instructions in given loader.
+ * */
+static Size test_count_checks (Loader* loader) {
+    Size count = 0;
+    for (Size b = 0; b < loader->insn_block_count; b++) {
+        for (Size i = 0; i < loader->insn_blocks[b].insn_count; i++) {
+            count += loader->insn_blocks[b].insns[i].insn_type == INSN_TYPE_CHECK;
+        }
+    }
+    return count;
+}
+
+/**
+ * @b Run file loader of given schema over given data, with given validation.
+ *
+ * @return @c True if load succeeds.
+ * @return @c False otherwise.
+ * */
+static Bool test_load (Schema* schema, Vm* vm, Uint8* data, VmValidation validation) {
+    Uint8    mem[TEST_DATA_SIZE * 2] = {0};
+    IoStream io = {.data = data, .size = TEST_DATA_SIZE, .capacity = TEST_DATA_SIZE};
+
+    vm_deinit (vm);
+    memset (vm, 0, sizeof (Vm));
+    vm->validation = validation;
+
+    return vm_run_loader (vm, schema->file_loader, &io, mem) != Null;
+}
+
+/**
+ * @b Make sure comparisons of fields with constants go to check tables, and only the
+ * rest of assertions is compiled to code.
+ * */
+static Bool test_check_tables (void) {
+    Schema schema = {0};
+    TEST_CHECK (schema_compile_source (&schema, test_source, strlen (test_source), 0));
+
+    Loader* s = schema_find_loader (&schema, "S");
+    Loader* r = schema_find_loader (&schema, "R");
+    Loader* f = schema.file_loader;
+
+    /* S asserts nothing in code, so arrays of it remain fixed */
+    Bool status = s && s->check.term_count == 2 && !test_count_checks (s) &&
+                  s->fixed_status == LOADER_FIXED_YES;
+
+    status = status && s->check.terms[0].mem_off == 0 && s->check.terms[0].cmp == CHECK_CMP_EQ &&
+             s->check.terms[0].value == 1;
+    status = status && s->check.terms[1].mem_off == 1 && s->check.terms[1].cmp == CHECK_CMP_GE &&
+             s->check.terms[1].value == 2;
+
+    status = status && r && !r->check.term_count && test_count_checks (r) == 1;
+    status = status && f && f->check.term_count == 1 &&
+             f->check.terms[0].mem_off == TEST_RECORD_COUNT * 2 &&
+             f->check.terms[0].cmp == CHECK_CMP_LT;
+
+    schema_deinit (&schema);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure full validation checks every object, sampled validation checks every
+ * @c VM_VALIDATION_SAMPLE_INTERVAL th object, and no validation checks none.
+ * */
+static Bool test_validation_levels (void) {
+    Schema schema = {0};
+    TEST_CHECK (schema_compile_source (&schema, test_source, strlen (test_source), 0));
+
+    Uint8 data[TEST_DATA_SIZE];
+    for (Size i = 0; i < TEST_RECORD_COUNT; i++) {
+        data[2 * i]     = 1;
+        data[2 * i + 1] = (Uint8)(2 + (i & 3));
+    }
+    data[TEST_DATA_SIZE - 2] = 1;
+    data[TEST_DATA_SIZE - 1] = 2;
+
+    /* 64 S, one R and one F */
+    Vm   vm     = {0};
+    Bool status = test_load (&schema, &vm, data, VM_VALIDATION_FULL);
+    status      = status && vm.checks_run == TEST_RECORD_COUNT + 2 && !vm.checks_skipped;
+
+    /* an S in the middle fails it's check table */
+    data[14] = 0;
+    status   = status && !test_load (&schema, &vm, data, VM_VALIDATION_FULL);
+    status   = status && test_load (&schema, &vm, data, VM_VALIDATION_OFF);
+    status   = status && !vm.checks_run && vm.checks_skipped == TEST_RECORD_COUNT + 2;
+    status   = status && test_load (&schema, &vm, data, VM_VALIDATION_SAMPLED);
+    status   = status && vm.checks_run == 2 && vm.checks_skipped == TEST_RECORD_COUNT;
+
+    /* first S is always sampled */
+    data[0] = 0;
+    status  = status && !test_load (&schema, &vm, data, VM_VALIDATION_SAMPLED);
+    data[0] = data[14] = 1;
+
+    /* R fails it's assertion compiled to code */
+    data[TEST_DATA_SIZE - 1] = 5;
+    status = status && !test_load (&schema, &vm, data, VM_VALIDATION_FULL);
+    status = status && test_load (&schema, &vm, data, VM_VALIDATION_OFF);
+
+    vm_deinit (&vm);
+    schema_deinit (&schema);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_check_tables());
+    TEST_RUN (status, test_validation_levels());
+
+    return TEST_EXIT_STATUS (status);
+}
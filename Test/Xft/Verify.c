@@ -0,0 +1,167 @@
+/**
+ * @file Verify.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* crossfile */
+#include <CrossFile/Xft/Vm/Verify.h>
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+#include "TestLoader.h"
+
+/**
+ * @b Encode blocks of given loader, and verify them without executing.
+ * */
+static Loader* test_verify (Loader* loader) {
+    PackedCode* packed = &loader->packed_code;
+    return packed_code_encode (packed, loader->insn_blocks, loader->insn_block_count) ?
+               loader_verify (loader) :
+               Null;
+}
+
+/**
+ * @b Make sure a loader with balanced stack and in bounds memory accesses is verified
+ * with it's maximum stack height, and runs unchecked with same results.
+ * */
+static Bool test_balanced_loader_verified (void) {
+    InsnBlock blocks[] = {
+        TEST_BLOCK (
+            READ_REG8 (1),
+            PUSH_REG8 (1),
+            PUSH_REG64 (1),
+            PUSH_REG16 (1),
+            POP_REG16 (2),
+            POP_REG64 (3),
+            POP_MEM8 (0)
+        ),
+    };
+    Loader loader = {
+        .type_name        = "Balanced",
+        .alloc_size       = 4,
+        .insn_blocks      = blocks,
+        .insn_block_count = 1,
+    };
+
+    Uint8    data[] = {7};
+    Uint8    mem[4] = {0};
+    IoStream io     = TEST_STREAM (data);
+    Vm       vm     = {0};
+
+    Bool status = vm_run_loader (&vm, &loader, &io, mem) &&
+                  loader.verify_status == LOADER_VERIFY_PASSED && loader.max_stack_size == 11 &&
+                  mem[0] == 7 && vm.regs[2] == 7 && vm.regs[3] == 7;
+
+    vm_deinit (&vm);
+    test_loader_deinit (&loader);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure a loop that grows stack on every iteration is rejected, but still runs
+ * correctly with runtime checks.
+ * */
+static Bool test_unbalanced_loop_runs_checked (void) {
+    InsnBlock blocks[] = {
+        TEST_BLOCK (SET_REG (1, 3), SET_REG (2, 1)),
+        TEST_BLOCK (PUSH_REG8 (1), SUB (1, 1, 2), JA (1, 1)),
+        TEST_BLOCK (POP_MEM8 (0), POP_MEM8 (1), POP_MEM8 (2)),
+    };
+    Loader loader = {
+        .type_name        = "Loop",
+        .alloc_size       = 4,
+        .insn_blocks      = blocks,
+        .insn_block_count = 3,
+    };
+
+    Uint8    data[1] = {0};
+    Uint8    mem[4]  = {0};
+    IoStream io      = TEST_STREAM (data);
+    Vm       vm      = {0};
+
+    Bool status = vm_run_loader (&vm, &loader, &io, mem) &&
+                  loader.verify_status == LOADER_VERIFY_FAILED && mem[0] == 1 && mem[1] == 2 &&
+                  mem[2] == 3;
+
+    vm_deinit (&vm);
+    test_loader_deinit (&loader);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure every kind of statically detectable error gets a loader rejected, either
+ * by encoder (registers that don't fit their operand) or by verifier.
+ * */
+static Bool test_invalid_loaders_rejected (void) {
+    InsnBlock oob_blocks[]   = {TEST_BLOCK (READ_MEM32 (2))};
+    InsnBlock jump_blocks[]  = {TEST_BLOCK (SET_REG (1, 1), JA (1, 5))};
+    InsnBlock reg_blocks[]   = {TEST_BLOCK (SET_REG (VM_REG_COUNT, 1))};
+    InsnBlock pop_blocks[]   = {TEST_BLOCK (READ_REG8 (1), POP_REG8 (2))};
+    InsnBlock call_blocks[]  = {TEST_BLOCK (CALL (0))};
+    InsnBlock merge_blocks[] = {
+        TEST_BLOCK (READ_REG8 (1), JZ (1, 2)),
+        TEST_BLOCK (PUSH_REG8 (1)),
+        TEST_BLOCK (EXIT (SUCCESS)),
+    };
+
+    Loader loaders[] = {
+        {.type_name = "Oob", .alloc_size = 4, .insn_blocks = oob_blocks, .insn_block_count = 1},
+        {.type_name = "Jump", .insn_blocks = jump_blocks, .insn_block_count = 1},
+        {.type_name = "Reg", .insn_blocks = reg_blocks, .insn_block_count = 1},
+        {.type_name = "Pop", .insn_blocks = pop_blocks, .insn_block_count = 1},
+        {.type_name = "Call", .insn_blocks = call_blocks, .insn_block_count = 1},
+        {.type_name = "Merge", .insn_blocks = merge_blocks, .insn_block_count = 3},
+    };
+
+    Bool status = True;
+    for (Size l = 0; l < sizeof (loaders) / sizeof (loaders[0]); l++) {
+        status = status && !test_verify (loaders + l) &&
+                 loaders[l].verify_status != LOADER_VERIFY_PASSED;
+        test_loader_deinit (loaders + l);
+    }
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_balanced_loader_verified());
+    TEST_RUN (status, test_unbalanced_loop_runs_checked());
+    TEST_RUN (status, test_invalid_loaders_rejected());
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,205 @@
+/**
+ * @file Vm.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+
+/* crossfile */
+#include <CrossFile/Xft/Vm/Vm.h>
+
+/* local includes */
+#include <Test.h>
+#include "TestLoader.h"
+
+/**
+ * @b Run a loop that calls another loader once per element, and make sure memory,
+ * registers returned by callee and stream cursor are what interpreter should leave.
+ * */
+static Bool test_loop_with_calls (void) {
+    /* reads two bytes, and returns twice the second one in r0 */
+    InsnBlock inner_blocks[] = {
+        TEST_BLOCK (
+            READ_MEM8 (0),
+            READ_REG8 (1),
+            PUSH_REG8 (1),
+            POP_MEM8 (1),
+            READ_REG16 (2),
+            SEEK_BAK (2),
+            SEEK_FWD (2),
+            ADD (0, 1, 1)
+        ),
+    };
+    Loader inner = {
+        .type_name        = "Inner",
+        .alloc_size       = 2,
+        .insn_blocks      = inner_blocks,
+        .insn_block_count = 1,
+    };
+    Loader* refs[] = {&inner};
+
+    /* r1 = count, r2 = sum of returned values, r3 = index */
+    InsnBlock outer_blocks[] = {
+        TEST_BLOCK (
+            READ_REG8 (1),
+            SET_REG (2, 0),
+            SET_REG (3, 0),
+            SET_REG (4, 1),
+            SET_REG (5, 2),
+            SET_REG (6, 4)
+        ),
+        TEST_BLOCK (CMPLT (7, 3, 1), JZ (7, 3)),
+        TEST_BLOCK (
+            MUL (0, 3, 5),
+            ADD (0, 0, 6),
+            CALL (0),
+            ADD (2, 2, 0),
+            ADD (3, 3, 4),
+            SET_REG (7, 1),
+            JA (7, 1)
+        ),
+        TEST_BLOCK (PUSH_REG32 (2), POP_MEM32 (0), EXIT (SUCCESS), EXIT (FAILURE)),
+    };
+    Loader outer = {
+        .type_name        = "Outer",
+        .alloc_size       = 10,
+        .insn_blocks      = outer_blocks,
+        .insn_block_count = 4,
+        .loader_refs      = refs,
+        .loader_ref_count = 1,
+    };
+
+    Uint8    data[]   = {3, 1, 2, 0, 0, 10, 20, 0, 0, 100, 50, 0, 0};
+    Uint8    mem[10]  = {0};
+    Uint8    want[10] = {0, 0, 0, 0, 1, 2, 10, 20, 100, 50};
+    IoStream io       = TEST_STREAM (data);
+    Vm       vm       = {0};
+    Uint32   sum      = 0;
+
+    Bool status = !!vm_run_loader (&vm, &outer, &io, mem);
+    memcpy (&sum, mem, sizeof (sum));
+
+    status = status && sum == 2 * (2 + 20 + 50) && !memcmp (mem + 4, want + 4, 6) &&
+             io.cursor == sizeof (data) && vm.regs[3] == 3;
+
+    /* same loaders again, on a stream that ends in middle of last element */
+    io.cursor = 0;
+    io.size   = sizeof (data) - 3;
+    status    = status && !vm_run_loader (&vm, &outer, &io, mem);
+
+    vm_deinit (&vm);
+    test_loader_deinit (&outer);
+    test_loader_deinit (&inner);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Make sure division by zero, out of bounds memory access and unbounded recursion
+ * fail the run instead of crashing.
+ * */
+static Bool test_runtime_errors (void) {
+    InsnBlock div_blocks[] = {TEST_BLOCK (SET_REG (1, 5), SET_REG (2, 0), DIV (3, 1, 2))};
+    InsnBlock oob_blocks[] = {TEST_BLOCK (READ_MEM32 (8))};
+    InsnBlock rec_blocks[] = {TEST_BLOCK (CALL (0))};
+
+    Loader  div        = {.type_name = "Div", .insn_blocks = div_blocks, .insn_block_count = 1};
+    Loader  oob        = {.type_name = "Oob", .insn_blocks = oob_blocks, .insn_block_count = 1};
+    Loader  rec        = {.type_name = "Rec", .insn_blocks = rec_blocks, .insn_block_count = 1};
+    Loader* rec_refs[] = {&rec};
+
+    oob.alloc_size       = 10;
+    rec.loader_refs      = rec_refs;
+    rec.loader_ref_count = 1;
+
+    Uint8    data[16] = {0};
+    Uint8    mem[10]  = {0};
+    IoStream io       = TEST_STREAM (data);
+    Vm       vm       = {0};
+
+    Bool status = !vm_run_loader (&vm, &div, &io, Null);
+    io.cursor   = 0;
+    status      = status && !vm_run_loader (&vm, &oob, &io, mem);
+    io.cursor   = 0;
+    status      = status && !vm_run_loader (&vm, &rec, &io, Null);
+
+    vm_deinit (&vm);
+    test_loader_deinit (&div);
+    test_loader_deinit (&oob);
+    test_loader_deinit (&rec);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Jump on carry out of an addition, then check arithmetic instructions without a
+ * compiler folding them, and that running past last block exits successfully.
+ * */
+static Bool test_flags_and_arithmetic (void) {
+    InsnBlock blocks[] = {
+        TEST_BLOCK (SET_REG (1, ~0ull), SET_REG (2, 1), ADD (3, 1, 2), JC (3, 1), EXIT (FAILURE)),
+        TEST_BLOCK (
+            SET_REG (1, 7),
+            SET_REG (2, 3),
+            POW (3, 1, 2),
+            SQRT (4, 3),
+            SET_REG (5, 61),
+            ROL (6, 2, 5),
+            ROR (6, 6, 5)
+        ),
+    };
+    Loader loader = {.type_name = "Flags", .insn_blocks = blocks, .insn_block_count = 2};
+
+    Uint8    data[1] = {0};
+    IoStream io      = TEST_STREAM (data);
+    Vm       vm      = {0};
+
+    Bool status = vm_run_loader (&vm, &loader, &io, Null) && vm.regs[3] == 343 &&
+                  vm.regs[4] == 18 && vm.regs[6] == 3;
+
+    vm_deinit (&vm);
+    test_loader_deinit (&loader);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (void) {
+    Bool status = True;
+    TEST_RUN (status, test_loop_with_calls());
+    TEST_RUN (status, test_runtime_errors());
+    TEST_RUN (status, test_flags_and_arithmetic());
+
+    return TEST_EXIT_STATUS (status);
+}
@@ -0,0 +1,206 @@
+/**
+ * @file Xfb.c
+ * @date Sun, 18th October 2026
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright 2024 Siddharth Mishra
+ * @copyright Copyright 2024 Anvie Labs
+ *
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* libc */
+#include <memory.h>
+#include <stdio.h>
+#include <string.h>
+
+/* crossfile */
+#include <CrossFile/Xft/Vm/Vm.h>
+#include <CrossFile/Xft/Vm/Xfb.h>
+
+/* local includes */
+#include <Test.h>
+#include "TestLoader.h"
+
+/**
+ * @b Read whole file.
+ *
+ * @return Contents of file on success, owned by caller.
+ * @return @c Null otherwise.
+ * */
+static Uint8* read_file (CString filename, Size* size) {
+    FILE* file = fopen (filename, "rb");
+    RETURN_VALUE_IF (!file, Null, "Failed to open \"%s\"\n", filename);
+
+    Uint8* data = Null;
+    long   len  = -1;
+    if (!fseek (file, 0, SEEK_END) && (len = ftell (file)) > 0 && !fseek (file, 0, SEEK_SET)) {
+        data = ALLOCATE (Uint8, (Size)len);
+    }
+
+    if (data && fread (data, 1, (Size)len, file) != (Size)len) {
+        FREE (data);
+        data = Null;
+    }
+    fclose (file);
+
+    RETURN_VALUE_IF (!data, Null, "Failed to read \"%s\"\n", filename);
+
+    *size = (Size)len;
+    return data;
+}
+
+/**
+ * @b Write a set of loaders calling each other to given path, open it again, and make
+ * sure loaders found by name keep their names, docs, references and layouts, and run
+ * same as the originals. Also make sure a set that misses a referenced loader can't be
+ * written.
+ * */
+static Bool test_write_and_run (CString xfb_path) {
+    /* reads two bytes, and returns twice the second one in r0 */
+    InsnBlock inner_blocks[] = {
+        TEST_BLOCK (READ_MEM8 (0), READ_REG8 (1), PUSH_REG8 (1), POP_MEM8 (1), ADD (0, 1, 1)),
+    };
+    Loader inner = {
+        .type_name        = "Inner",
+        .type_doc         = "Two bytes",
+        .alloc_size       = 2,
+        .insn_blocks      = inner_blocks,
+        .insn_block_count = 1,
+    };
+    Loader* refs[] = {&inner};
+
+    /* loads count, and that many elements, storing sum of their returned values */
+    InsnBlock outer_blocks[] = {
+        TEST_BLOCK (READ_REG8 (1), SET_REG (2, 0), SET_REG (3, 0), SET_REG (4, 1), SET_REG (5, 2)),
+        TEST_BLOCK (CMPLT (7, 3, 1), JZ (7, 3)),
+        TEST_BLOCK (
+            MUL (0, 3, 5),
+            ADD (0, 0, 5),
+            CALL (0),
+            ADD (2, 2, 0),
+            ADD (3, 3, 4),
+            SET_REG (7, 1),
+            JA (7, 1)
+        ),
+        TEST_BLOCK (PUSH_REG16 (2), POP_MEM16 (0), EXIT (SUCCESS), PERR ("unreachable")),
+    };
+    Loader outer = {
+        .type_name        = "Outer",
+        .alloc_size       = 8,
+        .insn_blocks      = outer_blocks,
+        .insn_block_count = 4,
+        .loader_refs      = refs,
+        .loader_ref_count = 1,
+    };
+
+    /* a run of reads, fused into a struct layout when written */
+    InsnBlock pod_blocks[] = {TEST_BLOCK (READ_MEM16 (0), READ_MEM16 (2), READ_MEM32 (4))};
+    Loader pod = {
+        .type_name        = "Pod",
+        .alloc_size       = 8,
+        .insn_blocks      = pod_blocks,
+        .insn_block_count = 1,
+    };
+
+    Loader* all[]     = {&outer, &inner, &pod};
+    Loader* partial[] = {&outer};
+
+    Uint8    data[]  = {3, 1, 2, 10, 20, 100, 50};
+    Uint8    mem[8]  = {0};
+    Uint8    want[6] = {1, 2, 10, 20, 100, 50};
+    Uint16   sum     = 0;
+    IoStream io      = TEST_STREAM (data);
+    Vm       vm      = {0};
+    XfbFile  xfb     = {0};
+
+    Bool status = !xfb_write (partial, 1, Null, xfb_path) &&
+                  xfb_write (all, 3, &outer, xfb_path) && xfb_open (&xfb, xfb_path);
+
+    Loader* xouter = status ? xfb_find_loader (&xfb, "Outer") : Null;
+    Loader* xinner = status ? xfb_find_loader (&xfb, "Inner") : Null;
+    Loader* xpod   = status ? xfb_find_loader (&xfb, "Pod") : Null;
+
+    status = status && xfb.loader_count == 3 && xouter && xinner && xpod &&
+             xfb.file_loader == xouter && !strcmp (xinner->type_doc, "Two bytes") &&
+             xouter->loader_ref_count == 1 && xouter->loader_refs[0] == xinner &&
+             xpod->struct_layout_count == 1 && xpod->struct_layouts[0].stream_size == 8 &&
+             !xfb_find_loader (&xfb, "Missing");
+
+    status = status && vm_run_loader (&vm, xouter, &io, mem) && io.cursor == sizeof (data);
+    memcpy (&sum, mem, sizeof (sum));
+    status = status && sum == 2 * (2 + 20 + 50) && !memcmp (mem + 2, want, sizeof (want));
+
+    vm_deinit (&vm);
+    if (xfb.header) {
+        xfb_close (&xfb);
+    }
+    test_loader_deinit (&outer);
+    test_loader_deinit (&inner);
+    test_loader_deinit (&pod);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+/**
+ * @b Open file written by previous test from memory, and make sure flipping any single
+ * byte, or cutting file short, gets the image rejected.
+ * */
+static Bool test_corrupt_image_rejected (CString xfb_path) {
+    Size   size = 0;
+    Uint8* data = read_file (xfb_path, &size);
+    TEST_CHECK (data);
+
+    XfbFile xfb    = {0};
+    Bool    status = xfb_open_memory (&xfb, data, size) && xfb.loader_count == 3;
+    if (xfb.header) {
+        xfb_close (&xfb);
+    }
+
+    for (Size b = 0; status && b < size; b += 7) {
+        data[b] ^= 0x55;
+        status   = !xfb_open_memory (&xfb, data, size);
+        data[b] ^= 0x55;
+    }
+
+    status = status && !xfb_open_memory (&xfb, data, size - XFB_SECTION_ALIGNMENT) &&
+             !xfb_open_memory (&xfb, data, sizeof (XfbHeader) - 1);
+
+    FREE (data);
+
+    TEST_CHECK (status);
+    return True;
+}
+
+int main (int argc, char** argv) {
+    RETURN_VALUE_IF (argc != 2, EXIT_FAILURE, "usage : %s <scratch xfb file>\n", argv[0]);
+
+    Bool status = True;
+    TEST_RUN (status, test_write_and_run (argv[1]));
+    TEST_RUN (status, test_corrupt_image_rejected (argv[1]));
+
+    return TEST_EXIT_STATUS (status);
+}